@@ -516,7 +516,8 @@ void ChipLinuxAppMainLoop(AppMainLoopImplementation * impl)
     }
 #endif
 
-    initParams.interfaceId = LinuxDeviceOptions::GetInstance().interfaceId;
+    initParams.interfaceId       = LinuxDeviceOptions::GetInstance().interfaceId;
+    initParams.cryptoWorkerCount = LinuxDeviceOptions::GetInstance().cryptoWorkerCount;
 
     if (LinuxDeviceOptions::GetInstance().mCSRResponseOptions.csrExistingKeyPair)
     {
@@ -106,6 +106,7 @@ enum
 #if CHIP_WITH_NLFAULTINJECTION
     kDeviceOption_FaultInjection = 0x1027,
 #endif
+    kDeviceOption_CryptoWorkers = 0x1028,
 };
 
 constexpr unsigned kAppUsageLength = 64;
@@ -171,6 +172,7 @@ OptionDef sDeviceOptionDefs[] = {
 #if CHIP_WITH_NLFAULTINJECTION
     { "faults", kArgumentRequired, kDeviceOption_FaultInjection },
 #endif
+    { "crypto-workers", kArgumentRequired, kDeviceOption_CryptoWorkers },
     {}
 };
 
@@ -306,6 +308,9 @@ const char * sDeviceOptionHelp =
     "  --faults <fault-string,...>\n"
     "       Inject specified fault(s) at runtime.\n"
 #endif
+    "  --crypto-workers <count>\n"
+    "       Run the heavy cryptographic steps of CASE and PASE session establishment on <count> worker threads\n"
+    "       instead of the event loop. Defaults to 0, which keeps them on the event loop.\n"
     "\n";
 
 bool Base64ArgToVector(const char * arg, size_t maxSize, std::vector<uint8_t> & outVector)
@@ -440,6 +445,21 @@ bool HandleOption(const char * aProgram, OptionSet * aOptions, int aIdentifier,
         break;
     }
 
+    case kDeviceOption_CryptoWorkers: {
+        errno                     = 0;
+        unsigned long workerCount = strtoul(aValue, nullptr, 0);
+        if (errno == ERANGE || workerCount > CHIP_CONFIG_CRYPTO_WORKER_MAX)
+        {
+            PrintArgError("%s: ERROR: argument %s not in range [0, %u]\n", aProgram, aName,
+                          static_cast<unsigned>(CHIP_CONFIG_CRYPTO_WORKER_MAX));
+            retval = false;
+            break;
+        }
+
+        LinuxDeviceOptions::GetInstance().cryptoWorkerCount = static_cast<uint8_t>(workerCount);
+        break;
+    }
+
     case kDeviceOption_Spake2pIterations: {
         errno              = 0;
         uint32_t iterCount = static_cast<uint32_t>(strtoul(aValue, nullptr, 0));
@@ -69,6 +69,7 @@ struct LinuxDeviceOptions
     chip::FabricId commissionerFabricId   = chip::kUndefinedFabricId;
     std::vector<std::string> traceTo;
     bool mSimulateNoInternalTime = false;
+    uint8_t cryptoWorkerCount    = 0;
 #if defined(PW_RPC_ENABLED)
     uint16_t rpcServerPort = 33000;
 #endif
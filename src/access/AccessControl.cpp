@@ -190,6 +190,7 @@ CHIP_ERROR AccessControl::Init(AccessControl::Delegate * delegate, DeviceTypeRes
     {
         mDelegate           = delegate;
         mDeviceTypeResolver = &deviceTypeResolver;
+        InvalidateCompiledEntries();
     }
 
     return retval;
@@ -201,6 +202,7 @@ void AccessControl::Finish()
     ChipLogProgress(DataManagement, "AccessControl: finishing");
     mDelegate->Finish();
     mDelegate = nullptr;
+    InvalidateCompiledEntries();
 }
 
 CHIP_ERROR AccessControl::CreateEntry(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t * index,
@@ -218,6 +220,7 @@ CHIP_ERROR AccessControl::CreateEntry(const SubjectDescriptor * subjectDescripto
     ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
 
     size_t i = 0;
+    InvalidateCompiledEntries();
     ReturnErrorOnFailure(mDelegate->CreateEntry(&i, entry, &fabric));
 
     if (index)
@@ -234,6 +237,7 @@ CHIP_ERROR AccessControl::UpdateEntry(const SubjectDescriptor * subjectDescripto
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
     ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
+    InvalidateCompiledEntries();
     ReturnErrorOnFailure(mDelegate->UpdateEntry(index, entry, &fabric));
     NotifyEntryChanged(subjectDescriptor, fabric, index, &entry, EntryListener::ChangeType::kUpdated);
     return CHIP_NO_ERROR;
@@ -248,6 +252,7 @@ CHIP_ERROR AccessControl::DeleteEntry(const SubjectDescriptor * subjectDescripto
     {
         p = &entry;
     }
+    InvalidateCompiledEntries();
     ReturnErrorOnFailure(mDelegate->DeleteEntry(index, &fabric));
     if (p && p->HasDefaultDelegate())
     {
@@ -355,6 +360,31 @@ CHIP_ERROR AccessControl::Check(const SubjectDescriptor & subjectDescriptor, con
         return CHIP_NO_ERROR;
     }
 
+    if (CompileEntries())
+    {
+        bool allowed = false;
+        if (!FindCachedDecision(subjectDescriptor, requestPath, requestPrivilege, allowed))
+        {
+            bool cacheable = true;
+            allowed        = CheckCompiledEntries(subjectDescriptor, requestPath, requestPrivilege, cacheable);
+            if (cacheable)
+            {
+                CacheDecision(subjectDescriptor, requestPath, requestPrivilege, allowed);
+            }
+        }
+
+        if (allowed)
+        {
+#if CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
+            ChipLogProgress(DataManagement, "AccessControl: allowed");
+#endif // CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
+            return CHIP_NO_ERROR;
+        }
+
+        ChipLogProgress(DataManagement, "AccessControl: denied");
+        return CHIP_ERROR_ACCESS_DENIED;
+    }
+
     EntryIterator iterator;
     ReturnErrorOnFailure(Entries(iterator, &subjectDescriptor.fabricIndex));
 
@@ -623,6 +653,207 @@ exit:
     return false;
 }
 
+bool AccessControl::CompileEntries()
+{
+    if (mCompiledState == CompiledState::kStale)
+    {
+        EntryIterator iterator;
+        CHIP_ERROR err = Entries(iterator);
+
+        Entry entry;
+        while (err == CHIP_NO_ERROR && (err = iterator.Next(entry)) == CHIP_NO_ERROR)
+        {
+            err = CompileEntry(entry);
+        }
+
+        if (err != CHIP_ERROR_SENTINEL)
+        {
+            // Iterate the entries until the next change
+            InvalidateCompiledEntries();
+            mCompiledState = CompiledState::kUnavailable;
+            return false;
+        }
+        mCompiledState = CompiledState::kCompiled;
+    }
+
+    return mCompiledState == CompiledState::kCompiled;
+}
+
+CHIP_ERROR AccessControl::CompileEntry(const Entry & entry)
+{
+    VerifyOrReturnError(mCompiledEntryCount < mCompiledEntries.size(), CHIP_ERROR_NO_MEMORY);
+
+    CompiledEntry compiled;
+    Privilege privilege = Privilege::kView;
+    size_t subjectCount = 0;
+    size_t targetCount  = 0;
+    ReturnErrorOnFailure(entry.GetFabricIndex(compiled.fabricIndex));
+    ReturnErrorOnFailure(entry.GetAuthMode(compiled.authMode));
+    ReturnErrorOnFailure(entry.GetPrivilege(privilege));
+    ReturnErrorOnFailure(entry.GetSubjectCount(subjectCount));
+    ReturnErrorOnFailure(entry.GetTargetCount(targetCount));
+
+    // Entries that checks fail on are left to the iteration of the entries, which reports the error.
+    VerifyOrReturnError(compiled.authMode == AuthMode::kCase || compiled.authMode == AuthMode::kGroup,
+                        CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(subjectCount <= mCompiledSubjects.size() - mCompiledSubjectCount, CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(targetCount <= mCompiledTargets.size() - mCompiledTargetCount, CHIP_ERROR_NO_MEMORY);
+
+    for (Privilege requestPrivilege :
+         { Privilege::kView, Privilege::kProxyView, Privilege::kOperate, Privilege::kManage, Privilege::kAdminister })
+    {
+        if (CheckRequestPrivilegeAgainstEntryPrivilege(requestPrivilege, privilege))
+        {
+            compiled.privileges = static_cast<uint8_t>(compiled.privileges | to_underlying(requestPrivilege));
+        }
+    }
+
+    compiled.firstSubject = static_cast<uint16_t>(mCompiledSubjectCount);
+    compiled.subjectCount = static_cast<uint16_t>(subjectCount);
+    for (size_t i = 0; i < subjectCount; ++i)
+    {
+        NodeId subject = kUndefinedNodeId;
+        ReturnErrorOnFailure(entry.GetSubject(i, subject));
+        if (IsOperationalNodeId(subject) || IsCASEAuthTag(subject))
+        {
+            VerifyOrReturnError(compiled.authMode == AuthMode::kCase, CHIP_ERROR_INCORRECT_STATE);
+        }
+        else
+        {
+            VerifyOrReturnError(IsGroupId(subject) && compiled.authMode == AuthMode::kGroup, CHIP_ERROR_INCORRECT_STATE);
+        }
+        mCompiledSubjects[mCompiledSubjectCount++] = subject;
+    }
+
+    compiled.firstTarget = static_cast<uint16_t>(mCompiledTargetCount);
+    compiled.targetCount = static_cast<uint16_t>(targetCount);
+    for (size_t i = 0; i < targetCount; ++i)
+    {
+        ReturnErrorOnFailure(entry.GetTarget(i, mCompiledTargets[mCompiledTargetCount++]));
+    }
+
+    mCompiledEntries[mCompiledEntryCount++] = compiled;
+    return CHIP_NO_ERROR;
+}
+
+void AccessControl::InvalidateCompiledEntries()
+{
+    mCompiledState        = CompiledState::kStale;
+    mCompiledEntryCount   = 0;
+    mCompiledSubjectCount = 0;
+    mCompiledTargetCount  = 0;
+    mCachedDecisionCount  = 0;
+    mNextCachedDecision   = 0;
+}
+
+bool AccessControl::CheckCompiledEntries(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                         Privilege requestPrivilege, bool & cacheable) const
+{
+    // Same algorithm as the iteration of the entries in Check
+    for (size_t e = 0; e < mCompiledEntryCount; ++e)
+    {
+        const CompiledEntry & entry = mCompiledEntries[e];
+        if (entry.fabricIndex != subjectDescriptor.fabricIndex || entry.authMode != subjectDescriptor.authMode ||
+            (entry.privileges & to_underlying(requestPrivilege)) == 0)
+        {
+            continue;
+        }
+
+        if (entry.subjectCount > 0)
+        {
+            bool subjectMatched = false;
+            for (size_t i = entry.firstSubject; i < entry.firstSubject + entry.subjectCount; ++i)
+            {
+                const NodeId subject = mCompiledSubjects[i];
+                if (IsCASEAuthTag(subject) ? subjectDescriptor.cats.CheckSubjectAgainstCATs(subject)
+                                           : subject == subjectDescriptor.subject)
+                {
+                    subjectMatched = true;
+                    break;
+                }
+            }
+            if (!subjectMatched)
+            {
+                continue;
+            }
+        }
+
+        if (entry.targetCount > 0)
+        {
+            bool targetMatched = false;
+            for (size_t i = entry.firstTarget; i < entry.firstTarget + entry.targetCount; ++i)
+            {
+                const Entry::Target & target = mCompiledTargets[i];
+                if ((target.flags & Entry::Target::kCluster) && target.cluster != requestPath.cluster)
+                {
+                    continue;
+                }
+                if ((target.flags & Entry::Target::kEndpoint) && target.endpoint != requestPath.endpoint)
+                {
+                    continue;
+                }
+                if (target.flags & Entry::Target::kDeviceType)
+                {
+                    // Device types on endpoints may change without the access control list changing
+                    cacheable = false;
+                    if (!mDeviceTypeResolver->IsDeviceTypeOnEndpoint(target.deviceType, requestPath.endpoint))
+                    {
+                        continue;
+                    }
+                }
+                targetMatched = true;
+                break;
+            }
+            if (!targetMatched)
+            {
+                continue;
+            }
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+bool AccessControl::FindCachedDecision(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                       Privilege requestPrivilege, bool & allowed) const
+{
+    for (const CachedDecision * decision = mCachedDecisions.data(); decision < mCachedDecisions.data() + mCachedDecisionCount;
+         ++decision)
+    {
+        if (decision->privilege == requestPrivilege && decision->requestPath.cluster == requestPath.cluster &&
+            decision->requestPath.endpoint == requestPath.endpoint &&
+            decision->subjectDescriptor.fabricIndex == subjectDescriptor.fabricIndex &&
+            decision->subjectDescriptor.authMode == subjectDescriptor.authMode &&
+            decision->subjectDescriptor.subject == subjectDescriptor.subject &&
+            decision->subjectDescriptor.cats == subjectDescriptor.cats)
+        {
+            allowed = decision->allowed;
+            return true;
+        }
+    }
+    return false;
+}
+
+void AccessControl::CacheDecision(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                  Privilege requestPrivilege, bool allowed)
+{
+    VerifyOrReturn(mCachedDecisions.size() > 0);
+
+    CachedDecision & decision = mCachedDecisions[mNextCachedDecision];
+    decision.subjectDescriptor = subjectDescriptor;
+    decision.requestPath       = requestPath;
+    decision.privilege         = requestPrivilege;
+    decision.allowed           = allowed;
+
+    mNextCachedDecision = (mNextCachedDecision + 1) % mCachedDecisions.size();
+    if (mCachedDecisionCount < mCachedDecisions.size())
+    {
+        mCachedDecisionCount++;
+    }
+}
+
 void AccessControl::NotifyEntryChanged(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t index,
                                        const Entry * entry, EntryListener::ChangeType changeType)
 {
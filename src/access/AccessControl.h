@@ -26,6 +26,8 @@
 #include <lib/core/Global.h>
 #include <lib/support/CodeUtils.h>
 
+#include <array>
+
 // Dump function for use during development only (0 for disabled, non-zero for enabled).
 #define CHIP_ACCESS_CONTROL_DUMP_ENABLED 0
 
@@ -497,6 +499,7 @@ public:
     {
         ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        InvalidateCompiledEntries();
         return mDelegate->CreateEntry(index, entry, fabricIndex);
     }
 
@@ -547,6 +550,7 @@ public:
     {
         ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        InvalidateCompiledEntries();
         return mDelegate->UpdateEntry(index, entry, fabricIndex);
     }
 
@@ -568,6 +572,7 @@ public:
     CHIP_ERROR DeleteEntry(size_t index, const FabricIndex * fabricIndex = nullptr)
     {
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        InvalidateCompiledEntries();
         return mDelegate->DeleteEntry(index, fabricIndex);
     }
 
@@ -649,12 +654,73 @@ private:
     void NotifyEntryChanged(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t index, const Entry * entry,
                             EntryListener::ChangeType changeType);
 
+    // Entries are decoded on the first check after a change to the access control list,
+    // so that checks do not iterate the entries through the delegate.
+    // Returns true if checks can use the decoded entries.
+    bool CompileEntries();
+    CHIP_ERROR CompileEntry(const Entry & entry);
+    void InvalidateCompiledEntries();
+
+    // Returns true if access is allowed by a decoded entry. Clears `cacheable` if the
+    // decision depends on device types on endpoints.
+    bool CheckCompiledEntries(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                              Privilege requestPrivilege, bool & cacheable) const;
+
+    bool FindCachedDecision(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                            Privilege requestPrivilege, bool & allowed) const;
+    void CacheDecision(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath, Privilege requestPrivilege,
+                       bool allowed);
+
+    struct CompiledEntry
+    {
+        FabricIndex fabricIndex = kUndefinedFabricIndex;
+        AuthMode authMode       = AuthMode::kNone;
+        // Request privileges (as Privilege bits) allowed by the entry privilege
+        uint8_t privileges    = 0;
+        uint16_t firstSubject = 0;
+        uint16_t subjectCount = 0;
+        uint16_t firstTarget  = 0;
+        uint16_t targetCount  = 0;
+    };
+
+    struct CachedDecision
+    {
+        SubjectDescriptor subjectDescriptor;
+        RequestPath requestPath;
+        Privilege privilege = Privilege::kView;
+        bool allowed        = false;
+    };
+
+    enum class CompiledState : uint8_t
+    {
+        kStale,      // To be decoded on the next check
+        kCompiled,   // Mirrors the access control list
+        kUnavailable // Does not fit (or failed to decode), checks iterate the entries
+    };
+
+    static_assert(CHIP_CONFIG_ACCESS_CONTROL_COMPILED_SUBJECTS <= UINT16_MAX &&
+                      CHIP_CONFIG_ACCESS_CONTROL_COMPILED_TARGETS <= UINT16_MAX,
+                  "Decoded subjects and targets must be indexable with a uint16_t");
+
 private:
     Delegate * mDelegate = nullptr;
 
     DeviceTypeResolver * mDeviceTypeResolver = nullptr;
 
     EntryListener * mEntryListener = nullptr;
+
+    CompiledState mCompiledState = CompiledState::kStale;
+    size_t mCompiledEntryCount   = 0;
+    size_t mCompiledSubjectCount = 0;
+    size_t mCompiledTargetCount  = 0;
+    std::array<CompiledEntry, CHIP_CONFIG_ACCESS_CONTROL_COMPILED_ENTRIES> mCompiledEntries;
+    std::array<NodeId, CHIP_CONFIG_ACCESS_CONTROL_COMPILED_SUBJECTS> mCompiledSubjects;
+    std::array<Entry::Target, CHIP_CONFIG_ACCESS_CONTROL_COMPILED_TARGETS> mCompiledTargets;
+
+    // Recent decisions against the decoded entries, replaced in a round-robin fashion
+    size_t mCachedDecisionCount = 0;
+    size_t mNextCachedDecision  = 0;
+    std::array<CachedDecision, CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE> mCachedDecisions;
 };
 
 /**
@@ -20,6 +20,9 @@
 #include "access/examples/ExampleAccessControlDelegate.h"
 
 #include <lib/core/CHIPCore.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <chrono>
 
 #include <gtest/gtest.h>
 
@@ -421,7 +424,9 @@ constexpr DeviceTypeId invalidDeviceTypes[] = {
 class DeviceTypeResolver : public AccessControl::DeviceTypeResolver
 {
 public:
-    bool IsDeviceTypeOnEndpoint(DeviceTypeId deviceType, EndpointId endpoint) override { return false; }
+    bool IsDeviceTypeOnEndpoint(DeviceTypeId deviceType, EndpointId endpoint) override { return deviceTypeOnEndpoint; }
+
+    bool deviceTypeOnEndpoint = false;
 } testDeviceTypeResolver;
 
 // For testing, supports one subject and target, allows any value (valid or invalid)
@@ -1755,6 +1760,121 @@ TEST_F(TestAccessControl, TestCheck)
     }
 }
 
+TEST_F(TestAccessControl, TestCheckFollowsChanges)
+{
+    const SubjectDescriptor subjectDescriptor = { .fabricIndex = 1, .authMode = AuthMode::kCase, .subject = kOperationalNodeId3 };
+    const RequestPath requestPath             = { .cluster = kOnOffCluster, .endpoint = 1 };
+
+    EntryData data = {
+        .fabricIndex = 1,
+        .privilege   = Privilege::kOperate,
+        .authMode    = AuthMode::kCase,
+        .subjects    = { kOperationalNodeId3 },
+        .targets     = { { .flags = Target::kCluster, .cluster = kOnOffCluster } },
+    };
+    EXPECT_EQ(LoadAccessControl(accessControl, &data, 1), CHIP_NO_ERROR);
+
+    // Repeated checks give the same decisions
+    for (int i = 0; i < 2; ++i)
+    {
+        EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kOperate), CHIP_NO_ERROR);
+        EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kManage), CHIP_ERROR_ACCESS_DENIED);
+    }
+
+    // Updated entries are used by the next checks
+    data.privilege = Privilege::kManage;
+    {
+        Entry entry;
+        EXPECT_EQ(accessControl.PrepareEntry(entry), CHIP_NO_ERROR);
+        EXPECT_EQ(LoadEntry(entry, data), CHIP_NO_ERROR);
+        EXPECT_EQ(accessControl.UpdateEntry(0, entry), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kManage), CHIP_NO_ERROR);
+
+    // Decisions depending on device types are made again
+    data.targets[0] = { .flags = Target::kDeviceType, .deviceType = 0x0000'0100 };
+    {
+        Entry entry;
+        EXPECT_EQ(accessControl.PrepareEntry(entry), CHIP_NO_ERROR);
+        EXPECT_EQ(LoadEntry(entry, data), CHIP_NO_ERROR);
+        EXPECT_EQ(accessControl.UpdateEntry(nullptr, 1, 0, entry), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kManage), CHIP_ERROR_ACCESS_DENIED);
+    testDeviceTypeResolver.deviceTypeOnEndpoint = true;
+    EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kManage), CHIP_NO_ERROR);
+    testDeviceTypeResolver.deviceTypeOnEndpoint = false;
+    EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kManage), CHIP_ERROR_ACCESS_DENIED);
+
+    // Deleted entries no longer allow access
+    EXPECT_EQ(accessControl.DeleteEntry(0), CHIP_NO_ERROR);
+    EXPECT_EQ(accessControl.Check(subjectDescriptor, requestPath, Privilege::kView), CHIP_ERROR_ACCESS_DENIED);
+}
+
+TEST_F(TestAccessControl, TestWildcardReadCheckBenchmark)
+{
+    constexpr FabricIndex kFabrics           = 4;
+    constexpr size_t kEntriesPerFabric       = 4;
+    constexpr EndpointId kEndpoints          = 3;
+    constexpr ClusterId kClustersPerEndpoint = 20;
+    constexpr size_t kAttributesPerCluster   = 10;
+    constexpr size_t kReads                  = 50;
+
+    // Every entry has 3 targets; the last entry of each fabric grants access to the endpoints read
+    for (FabricIndex fabric = 1; fabric <= kFabrics; ++fabric)
+    {
+        for (size_t i = 0; i < kEntriesPerFabric; ++i)
+        {
+            EntryData data;
+            data.fabricIndex = fabric;
+            data.privilege   = Privilege::kView;
+            data.authMode    = AuthMode::kCase;
+            data.AddSubject(nullptr, kOperationalNodeId0 + fabric * kEntriesPerFabric + i);
+            for (EndpointId endpoint = 1; endpoint <= kEndpoints; ++endpoint)
+            {
+                if (i == kEntriesPerFabric - 1)
+                {
+                    data.AddTarget(nullptr, { .flags = Target::kEndpoint, .endpoint = endpoint });
+                }
+                else
+                {
+                    data.AddTarget(nullptr, { .flags = Target::kCluster | Target::kEndpoint, .cluster = kOnOffCluster,
+                                              .endpoint = static_cast<EndpointId>(endpoint + kEndpoints) });
+                }
+            }
+            ASSERT_EQ(LoadAccessControl(accessControl, &data, 1), CHIP_NO_ERROR);
+        }
+    }
+
+    const SubjectDescriptor subjectDescriptor = { .fabricIndex = kFabrics,
+                                                  .authMode    = AuthMode::kCase,
+                                                  .subject     = kOperationalNodeId0 + kFabrics * kEntriesPerFabric +
+                                                      kEntriesPerFabric - 1 };
+
+    // A wildcard read checks every attribute path it expands to
+    size_t allowed   = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t read = 0; read < kReads; ++read)
+    {
+        for (EndpointId endpoint = 1; endpoint <= kEndpoints; ++endpoint)
+        {
+            for (ClusterId cluster = 0; cluster < kClustersPerEndpoint; ++cluster)
+            {
+                for (size_t attribute = 0; attribute < kAttributesPerCluster; ++attribute)
+                {
+                    const RequestPath requestPath = { .cluster = cluster, .endpoint = endpoint };
+                    allowed += (accessControl.Check(subjectDescriptor, requestPath, Privilege::kView) == CHIP_NO_ERROR) ? 1 : 0;
+                }
+            }
+        }
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    constexpr size_t kChecks = kReads * kEndpoints * kClustersPerEndpoint * kAttributesPerCluster;
+    ChipLogProgress(DataManagement, "Wildcard read: %u checks, %u ns per check", static_cast<unsigned>(kChecks),
+                    static_cast<unsigned>(elapsed.count() / static_cast<long long>(kChecks)));
+    EXPECT_EQ(allowed, kChecks);
+}
+
 TEST_F(TestAccessControl, TestCreateReadEntry)
 {
     for (size_t i = 0; i < entryData1Count; ++i)
@@ -175,6 +175,18 @@ private:
             return CHIP_NO_ERROR;
         }
 
+        // Once there is less space left than any item encoded so far took, the next item most likely does not fit.  Check the
+        // size of its value, which costs at most the space left, rather than encoding part of it only to roll it back and encode
+        // it again in the next chunk.
+        TLV::TLVWriter * writer       = mAttributeReportIBsBuilder.GetWriter();
+        const uint32_t writableLength = writer->GetWritableLength();
+        if (writableLength < mSmallestEncodedListItemSize)
+        {
+            VerifyOrReturnError(writableLength > mListItemOverhead, CHIP_ERROR_BUFFER_TOO_SMALL);
+            ReturnErrorOnFailure(CheckListItemFits(writableLength - mListItemOverhead, aArgs...));
+        }
+
+        const uint32_t lengthWrittenBefore = writer->GetLengthWritten();
         TLV::TLVWriter backup;
         mAttributeReportIBsBuilder.Checkpoint(backup);
 
@@ -182,8 +194,7 @@ private:
         if (mEncodingInitialList)
         {
             // Just encode a single item, with an anonymous tag.
-            AttributeReportBuilder builder;
-            err = builder.EncodeValue(mAttributeReportIBsBuilder, TLV::AnonymousTag(), std::forward<Ts>(aArgs)...);
+            err = EncodeValue(TLV::AnonymousTag(), std::forward<Ts>(aArgs)...);
         }
         else
         {
@@ -198,12 +209,41 @@ private:
             return err;
         }
 
+        // Items of a list are encoded the same way, so what they take beside their value does not change.
+        const uint32_t itemSize = writer->GetLengthWritten() - lengthWrittenBefore;
+        mListItemOverhead       = itemSize - mLastEncodedValueSize;
+        if (mSmallestEncodedListItemSize == 0 || itemSize < mSmallestEncodedListItemSize)
+        {
+            mSmallestEncodedListItemSize = itemSize;
+        }
+
         mCurrentEncodingListIndex++;
         mEncodeState.SetCurrentEncodingListIndex(mCurrentEncodingListIndex);
         mEncodedAtLeastOneListItem = true;
         return CHIP_NO_ERROR;
     }
 
+    /**
+     * Checks that the value of a list item is not larger than aWritableLength.  Returns CHIP_ERROR_BUFFER_TOO_SMALL if it is,
+     * without encoding anything.
+     *
+     * The value is sized with an anonymous tag, so an item whose value fits exactly may still fail to be encoded with a context
+     * tag: this only avoids encoding items that are known not to fit.
+     */
+    template <typename T, std::enable_if_t<!DataModel::IsFabricScoped<T>::value, bool> = true>
+    CHIP_ERROR CheckListItemFits(uint32_t aWritableLength, const T & aItem)
+    {
+        uint32_t size;
+        return DataModel::EncodedSize(TLV::AnonymousTag(), aItem, size, aWritableLength);
+    }
+
+    template <typename T, std::enable_if_t<DataModel::IsFabricScoped<T>::value, bool> = true>
+    CHIP_ERROR CheckListItemFits(uint32_t aWritableLength, FabricIndex aAccessingFabricIndex, const T & aItem)
+    {
+        uint32_t size;
+        return DataModel::EncodedSizeForRead(TLV::AnonymousTag(), aAccessingFabricIndex, aItem, size, aWritableLength);
+    }
+
     /**
      * Builds a single AttributeReportIB in AttributeReportIBs.  The caller is
      * responsible for setting up mPath correctly.
@@ -217,12 +257,28 @@ private:
     {
         AttributeReportBuilder builder;
         ReturnErrorOnFailure(builder.PrepareAttribute(mAttributeReportIBsBuilder, mPath, mDataVersion));
-        ReturnErrorOnFailure(builder.EncodeValue(mAttributeReportIBsBuilder, TLV::ContextTag(AttributeDataIB::Tag::kData),
-                                                 std::forward<Ts>(aArgs)...));
+        ReturnErrorOnFailure(EncodeValue(TLV::ContextTag(AttributeDataIB::Tag::kData), std::forward<Ts>(aArgs)...));
 
         return builder.FinishAttribute(mAttributeReportIBsBuilder);
     }
 
+    /**
+     * Encodes a value in the current AttributeDataIB (or the list it contains), and records the number of bytes it took in
+     * mLastEncodedValueSize.
+     */
+    template <typename... Ts>
+    CHIP_ERROR EncodeValue(TLV::Tag aTag, Ts &&... aArgs)
+    {
+        TLV::TLVWriter * writer            = mAttributeReportIBsBuilder.GetWriter();
+        const uint32_t lengthWrittenBefore = writer->GetLengthWritten();
+
+        AttributeReportBuilder builder;
+        ReturnErrorOnFailure(builder.EncodeValue(mAttributeReportIBsBuilder, aTag, std::forward<Ts>(aArgs)...));
+
+        mLastEncodedValueSize = writer->GetLengthWritten() - lengthWrittenBefore;
+        return CHIP_NO_ERROR;
+    }
+
     /**
      * EnsureListStarted sets our mCurrentEncodingListIndex to 0, and:
      *
@@ -252,6 +308,11 @@ private:
     // mEncodedAtLeastOneListItem becomes true once we successfully encode a list item.
     bool mEncodedAtLeastOneListItem     = false;
     ListIndex mCurrentEncodingListIndex = kInvalidListIndex;
+    // The number of bytes taken by the smallest list item encoded so far, 0 if none was.
+    uint32_t mSmallestEncodedListItemSize = 0;
+    // The number of bytes a list item takes beside its value (its AttributeReportIB, once chunking).
+    uint32_t mListItemOverhead     = 0;
+    uint32_t mLastEncodedValueSize = 0;
     AttributeEncodeState mEncodeState;
 };
 
@@ -68,7 +68,7 @@ CHIP_ERROR BufferedReadCallback::GenerateListTLV(TLV::ScopedBufferTLVReader & aR
     size_t totalBufSize = 0;
     for (const auto & packetBuffer : mBufferedList)
     {
-        totalBufSize += packetBuffer->TotalLength();
+        totalBufSize += packetBuffer->DataLength();
     }
 
     //
@@ -84,12 +84,22 @@ CHIP_ERROR BufferedReadCallback::GenerateListTLV(TLV::ScopedBufferTLVReader & aR
 
     for (auto & bufHandle : mBufferedList)
     {
-        System::PacketBufferTLVReader reader;
+        TLV::TLVReader reader;
+        CHIP_ERROR err;
 
-        reader.Init(std::move(bufHandle));
+        reader.Init(bufHandle->Start(), bufHandle->DataLength());
 
-        ReturnErrorOnFailure(reader.Next());
-        ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
+        while ((err = reader.Next()) == CHIP_NO_ERROR)
+        {
+            ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
+        }
+
+        VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+
+        //
+        // Release the chunk as soon as it has been copied over to keep the peak memory usage down.
+        //
+        bufHandle = System::PacketBufferHandle();
     }
 
     ReturnErrorOnFailure(writer.EndContainer(outerType));
@@ -101,34 +111,83 @@ CHIP_ERROR BufferedReadCallback::GenerateListTLV(TLV::ScopedBufferTLVReader & aR
     return CHIP_NO_ERROR;
 }
 
+bool BufferedReadCallback::ListIterator::Next()
+{
+    VerifyOrReturnValue(mStatus == CHIP_NO_ERROR, false);
+
+    while (mBufferIndex < mBufferedList.size())
+    {
+        if (!mReaderInitialized)
+        {
+            const System::PacketBufferHandle & buffer = mBufferedList[mBufferIndex];
+            mReader.Init(buffer->Start(), buffer->DataLength());
+            mReaderInitialized = true;
+        }
+
+        mStatus = mReader.Next();
+        if (mStatus == CHIP_NO_ERROR)
+        {
+            return true;
+        }
+
+        VerifyOrReturnValue(mStatus == CHIP_END_OF_TLV, false);
+
+        //
+        // Move on to the next buffer.
+        //
+        mStatus            = CHIP_NO_ERROR;
+        mReaderInitialized = false;
+        mBufferIndex++;
+    }
+
+    mStatus = CHIP_END_OF_TLV;
+    return false;
+}
+
 CHIP_ERROR BufferedReadCallback::BufferListItem(TLV::TLVReader & reader)
 {
-    System::PacketBufferTLVWriter writer;
-    System::PacketBufferHandle handle;
+    //
+    // List items are packed back to back as top-level anonymous TLV elements into the last buffered packet buffer,
+    // rather than each getting a buffer of its own: most list items are much smaller than a packet buffer, so a large list
+    // would otherwise hold on to one (right-sized, but still headed) packet buffer per item.
+    //
+    if (!mBufferedList.empty())
+    {
+        System::PacketBufferHandle & tail = mBufferedList.back();
+        TLV::TLVReader readerSnapshot;
+        TLV::TLVWriter writer;
+
+        readerSnapshot.Init(reader);
+        writer.Init(tail->Start() + tail->DataLength(), tail->AvailableDataLength());
+
+        CHIP_ERROR err = writer.CopyElement(TLV::AnonymousTag(), reader);
+        if (err == CHIP_NO_ERROR)
+        {
+            tail->SetDataLength(tail->DataLength() + writer.GetLengthWritten());
+            return CHIP_NO_ERROR;
+        }
+
+        VerifyOrReturnError(err == CHIP_ERROR_BUFFER_TOO_SMALL || err == CHIP_ERROR_NO_MEMORY, err);
+
+        //
+        // The item does not fit: rewind the reader to the item, and compact the full buffer down before starting a new one.
+        //
+        reader.Init(readerSnapshot);
+        tail.RightSize();
+    }
 
     //
     // We conservatively allocate a packet buffer as big as an IPv6 MTU (since we're buffering
-    // data received over the wire, which should always fit within that).
+    // data received over the wire, any single list item should always fit within that).
     //
-    // We could have snapshotted the reader at its current position, advanced it past the current element
-    // and computed the delta in its read point to figure out the size of the element before allocating
-    // our target buffer. However, the reader's current position is already set past the control octet
-    // and the tag. Consequently, the computed size is always going to omit the sizes of these two parts of the
-    // TLV element. Since the tag can vary in size, for now, let's just do the safe thing. In the future, if this is a problem,
-    // we can improve this.
-    //
-    handle = System::PacketBufferHandle::New(chip::app::kMaxSecureSduLengthBytes);
+    System::PacketBufferHandle handle = System::PacketBufferHandle::New(chip::app::kMaxSecureSduLengthBytes);
     VerifyOrReturnError(!handle.IsNull(), CHIP_ERROR_NO_MEMORY);
 
-    writer.Init(std::move(handle), false);
+    TLV::TLVWriter writer;
+    writer.Init(handle->Start(), handle->AvailableDataLength());
 
     ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
-    ReturnErrorOnFailure(writer.Finalize(&handle));
-
-    // Compact the buffer down to a more reasonably sized packet buffer
-    // if we can.
-    //
-    handle.RightSize();
+    handle->SetDataLength(writer.GetLengthWritten());
 
     mBufferedList.push_back(std::move(handle));
 
@@ -201,23 +260,34 @@ CHIP_ERROR BufferedReadCallback::DispatchBufferedData(const ConcreteAttributePat
         return CHIP_NO_ERROR;
     }
 
-    StatusIB statusIB;
-    TLV::ScopedBufferTLVReader reader;
-
-    ReturnErrorOnFailure(GenerateListTLV(reader));
-
     //
     // Update the list operation to now reflect the delivery of the entire list
     // i.e a replace all operation.
     //
     mBufferedPath.mListOp = ConcreteDataAttributePath::ListOperation::ReplaceAll;
 
-    //
-    // Advance the reader forward to the list itself
-    //
-    ReturnErrorOnFailure(reader.Next());
+    if (mpListCallback != nullptr)
+    {
+        //
+        // Streaming mode: hand out the list items straight out of the buffered chunks.
+        //
+        ListIterator iterator(mBufferedList);
+        mpListCallback->OnListData(mBufferedPath, iterator);
+    }
+    else
+    {
+        StatusIB statusIB;
+        TLV::ScopedBufferTLVReader reader;
+
+        ReturnErrorOnFailure(GenerateListTLV(reader));
 
-    mCallback.OnAttributeData(mBufferedPath, &reader, statusIB);
+        //
+        // Advance the reader forward to the list itself
+        //
+        ReturnErrorOnFailure(reader.Next());
+
+        mCallback.OnAttributeData(mBufferedPath, &reader, statusIB);
+    }
 
     //
     // Clear out our buffered contents to free up allocated buffers, and reset the buffered path.
@@ -40,8 +40,73 @@ namespace app {
 class BufferedReadCallback : public ReadClient::Callback
 {
 public:
+    /*
+     * Iterates over the items of a buffered list, in list order, directly out of the packet buffers they were
+     * buffered into.
+     *
+     * Usage mirrors DecodableList:
+     *
+     *     while (iterator.Next())
+     *     {
+     *         ReturnErrorOnFailure(DataModel::Decode(iterator.GetReader(), item));
+     *     }
+     *     ReturnErrorOnFailure(iterator.GetStatus());
+     *
+     * The iterator (and the reader it hands out) is only valid for the duration of ListCallback::OnListData.
+     */
+    class ListIterator
+    {
+    public:
+        /*
+         * Advance to the next list item. Returns false once all the items have been visited, or on error
+         * (which GetStatus() then returns).
+         */
+        bool Next();
+
+        /*
+         * Reader positioned on the current list item, with an anonymous tag. Only valid after Next() returned true.
+         */
+        TLV::TLVReader & GetReader() { return mReader; }
+
+        CHIP_ERROR GetStatus() const { return mStatus == CHIP_END_OF_TLV ? CHIP_NO_ERROR : mStatus; }
+
+    private:
+        friend class BufferedReadCallback;
+
+        ListIterator(const std::vector<System::PacketBufferHandle> & aBufferedList) : mBufferedList(aBufferedList) {}
+
+        const std::vector<System::PacketBufferHandle> & mBufferedList;
+        size_t mBufferIndex     = 0;
+        bool mReaderInitialized = false;
+        CHIP_ERROR mStatus      = CHIP_NO_ERROR;
+        TLV::TLVReader mReader;
+    };
+
+    /*
+     * Optional receiver of complete lists in streaming mode.
+     */
+    class ListCallback
+    {
+    public:
+        virtual ~ListCallback() = default;
+
+        /*
+         * Called instead of Callback::OnAttributeData once all the chunks of the list at aPath have been received,
+         * with aPath.mListOp set to ReplaceAll. The items are read in place out of the buffered chunks, without
+         * first reconstituting the list into a contiguous TLV array.
+         */
+        virtual void OnListData(const ConcreteDataAttributePath & aPath, ListIterator & aIterator) = 0;
+    };
+
     BufferedReadCallback(Callback & callback) : mCallback(callback) {}
 
+    /*
+     * Streaming mode: chunked (and unchunked) lists are delivered to listCallback instead of being reconstituted into
+     * a single TLV array for callback. Everything else is still delivered to callback.
+     */
+    BufferedReadCallback(Callback & callback, ListCallback & listCallback) : mCallback(callback), mpListCallback(&listCallback)
+    {}
+
 private:
     /*
      * Generates the reconsistuted TLV array from the stored individual list elements
@@ -121,8 +186,9 @@ private:
     }
 
     /*
-     * Given a reader positioned at a list element, allocate a packet buffer, copy the list item where
-     * the reader is positioned into that buffer and add it to our buffered list for tracking.
+     * Given a reader positioned at a list element, copy the list item where the reader is positioned
+     * right after the previously buffered item, allocating a new packet buffer and adding it to our buffered list
+     * for tracking if the last one is full.
      *
      * This should be called in list index order starting from the lowest index that needs to be buffered.
      *
@@ -131,6 +197,7 @@ private:
     ConcreteDataAttributePath mBufferedPath;
     std::vector<System::PacketBufferHandle> mBufferedList;
     Callback & mCallback;
+    ListCallback * mpListCallback = nullptr;
 };
 
 } // namespace app
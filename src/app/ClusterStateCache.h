@@ -24,6 +24,7 @@
 #include <app/AppConfig.h>
 #include <app/AttributePathParams.h>
 #include <app/BufferedReadCallback.h>
+#include <app/ClusterStateCacheStorage.h>
 #include <app/ReadClient.h>
 #include <app/data-model/DecodableList.h>
 #include <app/data-model/Decode.h>
@@ -61,12 +62,17 @@ namespace app {
  * through to a registered callback. In addition, it provides its own enhancements to the base ReadClient::Callback
  * to make it easier to know what has changed in the cache.
  *
+ * The Layout template parameter selects how attribute state is stored (see ClusterStateCacheLayout).  The default map
+ * layout keeps every attribute value in its own buffer.  The flat layout keeps the values of each cluster in a single
+ * slab, which uses much less memory when caching many nodes, but makes any reader into a cluster's data invalid as soon
+ * as any attribute of that cluster is updated.
+ *
  * **NOTE**
  * 1. This already includes the BufferedReadCallback, so there is no need to add that to the ReadClient callback chain.
  * 2. The same cache cannot be used by multiple subscribe/read interactions at the same time.
  *
  */
-template <bool CanEnableDataCaching>
+template <bool CanEnableDataCaching, ClusterStateCacheLayout Layout = ClusterStateCacheLayout::kMap>
 class ClusterStateCacheT : protected ReadClient::Callback
 {
 public:
@@ -143,8 +149,8 @@ public:
      *
      * For some types of attributes, the value for the attribute is directly backed by the underlying TLV buffer
      * and has pointers into that buffer. (e.g octet strings, char strings and lists).  This buffer only remains
-     * valid until the cached value for that path is updated, so it must not be held
-     * across any async call boundaries.
+     * valid until the cached value for that path (or, with the flat layout, for any path in the same cluster) is
+     * updated, so it must not be held across any async call boundaries.
      *
      * The template parameter AttributeObjectTypeT is generally expected to be a
      * ClusterName::Attributes::AttributeName::DecodableType, but any
@@ -215,8 +221,8 @@ public:
      *
      * For some types of attributes, the value for the attribute is directly backed by the underlying TLV buffer
      * and has pointers into that buffer. (e.g octet strings, char strings and lists).  This buffer only remains
-     * valid until the cached value for that path is updated, so it must not be held
-     * across any async call boundaries.
+     * valid until the cached value for that path (or, with the flat layout, for any path in the same cluster) is
+     * updated, so it must not be held across any async call boundaries.
      *
      * The template parameter ClusterObjectT is generally expected to be a
      * ClusterName::Attributes::DecodableType, but any
@@ -262,8 +268,8 @@ public:
      * Retrieve the value of an attribute by updating a in-out TLVReader to be positioned
      * right at the attribute value.
      *
-     * The underlying TLV buffer only remains valid until the cached value for that path is updated, so it must
-     * not be held across any async call boundaries.
+     * The underlying TLV buffer only remains valid until the cached value for that path (or, with the flat layout,
+     * for any path in the same cluster) is updated, so it must not be held across any async call boundaries.
      *
      * Notable return values:
      *      - If neither data nor status for the specified path exist in the cache, CHIP_ERROR_KEY_NOT_FOUND
@@ -379,13 +385,10 @@ public:
         auto clusterState = GetClusterState(endpointId, clusterId, err);
         ReturnErrorOnFailure(err);
 
-        for (auto & attributeIter : clusterState->mAttributes)
-        {
-            const ConcreteAttributePath path(endpointId, clusterId, attributeIter.first);
-            ReturnErrorOnFailure(func(path));
-        }
-
-        return CHIP_NO_ERROR;
+        return clusterState->ForEachAttribute([endpointId, clusterId, &func](AttributeId attributeId) {
+            const ConcreteAttributePath path(endpointId, clusterId, attributeId);
+            return func(path);
+        });
     }
 
     /*
@@ -404,21 +407,16 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachAttribute(ClusterId clusterId, IteratorFunc func) const
     {
-        for (auto & endpointIter : mCache)
-        {
-            for (auto & clusterIter : endpointIter.second)
+        return mCache.ForEachCluster([clusterId, &func](EndpointId endpointId, ClusterId id, const ClusterState & clusterState) {
+            if (id != clusterId)
             {
-                if (clusterIter.first == clusterId)
-                {
-                    for (auto & attributeIter : clusterIter.second.mAttributes)
-                    {
-                        const ConcreteAttributePath path(endpointIter.first, clusterId, attributeIter.first);
-                        ReturnErrorOnFailure(func(path));
-                    }
-                }
+                return CHIP_NO_ERROR;
             }
-        }
-        return CHIP_NO_ERROR;
+            return clusterState.ForEachAttribute([endpointId, clusterId, &func](AttributeId attributeId) {
+                const ConcreteAttributePath path(endpointId, clusterId, attributeId);
+                return func(path);
+            });
+        });
     }
 
     /*
@@ -437,15 +435,7 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachCluster(EndpointId endpointId, IteratorFunc func) const
     {
-        auto endpointIter = mCache.find(endpointId);
-        if (endpointIter->first == endpointId)
-        {
-            for (auto & clusterIter : endpointIter->second)
-            {
-                ReturnErrorOnFailure(func(clusterIter.first));
-            }
-        }
-        return CHIP_NO_ERROR;
+        return mCache.ForEachCluster(endpointId, [&func](ClusterId clusterId, const ClusterState &) { return func(clusterId); });
     }
 
     /*
@@ -534,33 +524,15 @@ public:
     CHIP_ERROR GetLastReportDataPath(ConcreteClusterPath & aPath);
 
 private:
-    // An attribute state can be one of three things:
-    // * If we got a path-specific error for the attribute, the corresponding
-    //   status.
-    // * If we got data for the attribute and we are storing data ourselves, the
-    //   data.
-    // * If we got data for the attribute and we are not storing data
-    //   oureselves, the size of the data, so we can still prioritize sending
-    //   DataVersions correctly.
+    // A cluster state holds the state of the attributes of a cluster, along with its data versions:
     //
-    // The data for a single attribute is not going to be gigabytes in size, so
-    // using uint32_t for the size is fine; on 64-bit systems this can save
-    // quite a bit of space.
-    using AttributeData  = Platform::ScopedMemoryBufferWithSize<uint8_t>;
-    using AttributeState = std::conditional_t<CanEnableDataCaching, Variant<StatusIB, AttributeData, uint32_t>, uint32_t>;
     // mPendingDataVersion represents a tentative data version for a cluster that we have gotten some reports for.
     //
-    // mCurrentDataVersion represents a known data version for a cluster.  In order for this to have a
+    // mCommittedDataVersion represents a known data version for a cluster.  In order for this to have a
     // value the cluster must be included in a path in mRequestPathSet that has a wildcard attribute
     // and we must not be in the middle of receiving reports for that cluster.
-    struct ClusterState
-    {
-        std::map<AttributeId, AttributeState> mAttributes;
-        Optional<DataVersion> mPendingDataVersion;
-        Optional<DataVersion> mCommittedDataVersion;
-    };
-    using EndpointState = std::map<ClusterId, ClusterState>;
-    using NodeState     = std::map<EndpointId, EndpointState>;
+    using NodeState    = ClusterStateCacheStorage::NodeState<CanEnableDataCaching, Layout>;
+    using ClusterState = typename NodeState::ClusterState;
 
     struct Comparator
     {
@@ -596,10 +568,7 @@ private:
      *        CHIP_ERROR_KEY_NOT_FOUND shall be returned.
      *
      */
-    const EndpointState * GetEndpointState(EndpointId endpointId, CHIP_ERROR & err) const;
     const ClusterState * GetClusterState(EndpointId endpointId, ClusterId clusterId, CHIP_ERROR & err) const;
-    const AttributeState * GetAttributeState(EndpointId endpointId, ClusterId clusterId, AttributeId attributeId,
-                                             CHIP_ERROR & err) const;
 
     const EventData * GetEventData(EventNumber number, CHIP_ERROR & err) const;
 
@@ -687,8 +656,10 @@ private:
     const bool mCacheData                   = CanEnableDataCaching;
 };
 
-using ClusterStateCache       = ClusterStateCacheT<true>;
-using ClusterStateCacheNoData = ClusterStateCacheT<false>;
+using ClusterStateCache           = ClusterStateCacheT<true>;
+using ClusterStateCacheNoData     = ClusterStateCacheT<false>;
+using FlatClusterStateCache       = ClusterStateCacheT<true, ClusterStateCacheLayout::kFlat>;
+using FlatClusterStateCacheNoData = ClusterStateCacheT<false, ClusterStateCacheLayout::kFlat>;
 
 };     // namespace app
 };     // namespace chip
@@ -0,0 +1,579 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Storage layouts for the attribute state held by ClusterStateCacheT.
+ *
+ *      Both layouts expose the same interface: a node state made of cluster states, indexed by endpoint and cluster
+ *      ID, each of which holds the data, status or encoded size of its attributes.
+ */
+
+#pragma once
+
+#include <app/MessageDef/StatusIB.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/core/Optional.h>
+#include <lib/core/TLVReader.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/SafeInt.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/Variant.h>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace chip {
+namespace app {
+
+/**
+ * How ClusterStateCacheT lays out the attribute state it caches.
+ */
+enum class ClusterStateCacheLayout : uint8_t
+{
+    // Nested maps indexed by endpoint, cluster and attribute ID, with a separate heap buffer for every attribute value.
+    kMap,
+    // A sorted vector of clusters, each holding a sorted vector of attributes and a single contiguous TLV slab that
+    // stores all of its attribute values.  This needs far fewer allocations and much less memory per attribute, at the
+    // price of making every attribute value reader of a cluster invalid whenever any attribute of that cluster changes.
+    kFlat,
+};
+
+namespace ClusterStateCacheStorage {
+
+// Determine how much space a StatusIB takes up on the wire.
+inline uint32_t SizeOfStatusIB(const StatusIB & aStatus)
+{
+    // 1 byte: anonymous tag control byte for struct.
+    // 1 byte: control byte for uint8 value.
+    // 1 byte: context-specific tag for uint8 value.
+    // 1 byte: the uint8 value.
+    // 1 byte: end of container.
+    uint32_t size = 5;
+
+    if (aStatus.mClusterStatus.HasValue())
+    {
+        // 1 byte: control byte for uint8 value.
+        // 1 byte: context-specific tag for uint8 value.
+        // 1 byte: the uint8 value.
+        size += 3;
+    }
+
+    return size;
+}
+
+/*
+ * Cluster state of the kMap layout.
+ *
+ * An attribute state can be one of three things:
+ * * If we got a path-specific error for the attribute, the corresponding status.
+ * * If we got data for the attribute and we are storing data ourselves, the data.
+ * * If we got data for the attribute and we are not storing data ourselves, the size of the data, so we can still
+ *   prioritize sending DataVersions correctly.
+ *
+ * The data for a single attribute is not going to be gigabytes in size, so using uint32_t for the size is fine; on
+ * 64-bit systems this can save quite a bit of space.
+ */
+template <bool CanEnableDataCaching>
+class MapClusterState
+{
+public:
+    // mPendingDataVersion represents a tentative data version for a cluster that we have gotten some reports for.
+    //
+    // mCommittedDataVersion represents a known data version for a cluster.
+    Optional<DataVersion> mPendingDataVersion;
+    Optional<DataVersion> mCommittedDataVersion;
+
+    /*
+     * Store a copy of the element the reader is positioned on, which is known to take aSize bytes once encoded.
+     */
+    CHIP_ERROR SetData(AttributeId aAttributeId, TLV::TLVReader & aData, uint32_t aSize)
+    {
+        static_assert(CanEnableDataCaching, "Attribute data is only stored when data caching is enabled");
+
+        AttributeData backingBuffer;
+        backingBuffer.Calloc(aSize);
+        VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+        TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), aSize);
+        ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), aData));
+        ReturnErrorOnFailure(writer.Finalize(backingBuffer));
+
+        mAttributes[aAttributeId].template Set<AttributeData>(std::move(backingBuffer));
+        return CHIP_NO_ERROR;
+    }
+
+    void SetStatus(AttributeId aAttributeId, const StatusIB & aStatus)
+    {
+        static_assert(CanEnableDataCaching, "Attribute statuses are only stored when data caching is enabled");
+        mAttributes[aAttributeId].template Set<StatusIB>(aStatus);
+    }
+
+    void SetSize(AttributeId aAttributeId, uint32_t aSize)
+    {
+        if constexpr (CanEnableDataCaching)
+        {
+            mAttributes[aAttributeId].template Set<uint32_t>(aSize);
+        }
+        else
+        {
+            mAttributes[aAttributeId] = aSize;
+        }
+    }
+
+    CHIP_ERROR GetData(AttributeId aAttributeId, TLV::TLVReader & aReader) const
+    {
+        static_assert(CanEnableDataCaching, "Attribute data is only stored when data caching is enabled");
+
+        auto attributeState = mAttributes.find(aAttributeId);
+        VerifyOrReturnError(attributeState != mAttributes.end(), CHIP_ERROR_KEY_NOT_FOUND);
+
+        if (attributeState->second.template Is<StatusIB>())
+        {
+            return CHIP_ERROR_IM_STATUS_CODE_RECEIVED;
+        }
+
+        if (!attributeState->second.template Is<AttributeData>())
+        {
+            return CHIP_ERROR_KEY_NOT_FOUND;
+        }
+
+        const AttributeData & data = attributeState->second.template Get<AttributeData>();
+        aReader.Init(data.Get(), data.AllocatedSize());
+        return aReader.Next();
+    }
+
+    CHIP_ERROR GetStatus(AttributeId aAttributeId, StatusIB & aStatus) const
+    {
+        static_assert(CanEnableDataCaching, "Attribute statuses are only stored when data caching is enabled");
+
+        auto attributeState = mAttributes.find(aAttributeId);
+        VerifyOrReturnError(attributeState != mAttributes.end(), CHIP_ERROR_KEY_NOT_FOUND);
+        VerifyOrReturnError(attributeState->second.template Is<StatusIB>(), CHIP_ERROR_INVALID_ARGUMENT);
+
+        aStatus = attributeState->second.template Get<StatusIB>();
+        return CHIP_NO_ERROR;
+    }
+
+    /*
+     * Total encoded size of the data and statuses of all attributes.
+     */
+    size_t GetEncodedSize() const
+    {
+        size_t size = 0;
+        for (auto const & attributeIter : mAttributes)
+        {
+            if constexpr (CanEnableDataCaching)
+            {
+                if (attributeIter.second.template Is<StatusIB>())
+                {
+                    size += SizeOfStatusIB(attributeIter.second.template Get<StatusIB>());
+                }
+                else if (attributeIter.second.template Is<uint32_t>())
+                {
+                    size += attributeIter.second.template Get<uint32_t>();
+                }
+                else
+                {
+                    VerifyOrDie(attributeIter.second.template Is<AttributeData>());
+                    size += attributeIter.second.template Get<AttributeData>().AllocatedSize();
+                }
+            }
+            else
+            {
+                size += attributeIter.second;
+            }
+        }
+        return size;
+    }
+
+    /*
+     * Call func(AttributeId) for every attribute, in increasing ID order, until it returns an error.
+     */
+    template <typename IteratorFunc>
+    CHIP_ERROR ForEachAttribute(IteratorFunc func) const
+    {
+        for (auto & attributeIter : mAttributes)
+        {
+            ReturnErrorOnFailure(func(attributeIter.first));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+private:
+    using AttributeData  = Platform::ScopedMemoryBufferWithSize<uint8_t>;
+    using AttributeState = std::conditional_t<CanEnableDataCaching, Variant<StatusIB, AttributeData, uint32_t>, uint32_t>;
+
+    std::map<AttributeId, AttributeState> mAttributes;
+};
+
+/*
+ * Node state of the kMap layout.
+ */
+template <typename ClusterStateT>
+class MapNodeState
+{
+public:
+    using ClusterState = ClusterStateT;
+
+    bool HasEndpoint(EndpointId aEndpointId) const { return mEndpoints.find(aEndpointId) != mEndpoints.end(); }
+
+    const ClusterState * FindCluster(EndpointId aEndpointId, ClusterId aClusterId) const
+    {
+        auto endpointIter = mEndpoints.find(aEndpointId);
+        if (endpointIter == mEndpoints.end())
+        {
+            return nullptr;
+        }
+
+        auto clusterIter = endpointIter->second.find(aClusterId);
+        if (clusterIter == endpointIter->second.end())
+        {
+            return nullptr;
+        }
+
+        return &clusterIter->second;
+    }
+
+    ClusterState & GetOrCreateCluster(EndpointId aEndpointId, ClusterId aClusterId) { return mEndpoints[aEndpointId][aClusterId]; }
+
+    /*
+     * Call func(EndpointId, ClusterId, const ClusterState &) for every cluster until it returns an error.
+     */
+    template <typename IteratorFunc>
+    CHIP_ERROR ForEachCluster(IteratorFunc func) const
+    {
+        for (auto & endpointIter : mEndpoints)
+        {
+            for (auto & clusterIter : endpointIter.second)
+            {
+                ReturnErrorOnFailure(func(endpointIter.first, clusterIter.first, clusterIter.second));
+            }
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    /*
+     * Call func(ClusterId, const ClusterState &) for every cluster of the given endpoint until it returns an error.
+     */
+    template <typename IteratorFunc>
+    CHIP_ERROR ForEachCluster(EndpointId aEndpointId, IteratorFunc func) const
+    {
+        auto endpointIter = mEndpoints.find(aEndpointId);
+        if (endpointIter != mEndpoints.end())
+        {
+            for (auto & clusterIter : endpointIter->second)
+            {
+                ReturnErrorOnFailure(func(clusterIter.first, clusterIter.second));
+            }
+        }
+        return CHIP_NO_ERROR;
+    }
+
+private:
+    std::map<EndpointId, std::map<ClusterId, ClusterState>> mEndpoints;
+};
+
+/*
+ * Cluster state of the kFlat layout.
+ *
+ * Attributes are kept in a vector sorted by attribute ID.  The encoded values of all the attributes of the cluster live
+ * back to back in a single slab.  A new value is always appended to the slab, leaving the bytes of the value it
+ * replaces unused; the slab is compacted once the unused bytes outweigh the live ones.  Appending to or compacting the
+ * slab can move it, so a reader returned by GetData() is only valid until the next update to the cluster.
+ */
+template <bool CanEnableDataCaching>
+class FlatClusterState
+{
+public:
+    Optional<DataVersion> mPendingDataVersion;
+    Optional<DataVersion> mCommittedDataVersion;
+
+    CHIP_ERROR SetData(AttributeId aAttributeId, TLV::TLVReader & aData, uint32_t aSize)
+    {
+        static_assert(CanEnableDataCaching, "Attribute data is only stored when data caching is enabled");
+
+        const size_t offset = mData.size();
+        VerifyOrReturnError(CanCastTo<uint32_t>(offset + aSize), CHIP_ERROR_NO_MEMORY);
+        if (mData.capacity() < offset + aSize)
+        {
+            // Grow in modest steps: clusters are filled one attribute at a time, and doubling would leave up to half of
+            // every slab unused.
+            mData.reserve(offset + aSize + (offset + aSize) / 4);
+        }
+        mData.resize(offset + aSize);
+
+        TLV::TLVWriter writer;
+        writer.Init(mData.data() + offset, aSize);
+        CHIP_ERROR err = writer.CopyElement(TLV::AnonymousTag(), aData);
+        if (err == CHIP_NO_ERROR)
+        {
+            err = writer.Finalize();
+        }
+        if (err != CHIP_NO_ERROR)
+        {
+            mData.resize(offset);
+            return err;
+        }
+
+        AttributeEntry & entry = FindOrInsert(aAttributeId);
+        Release(entry);
+        entry.mKind   = Kind::kData;
+        entry.mOffset = static_cast<uint32_t>(offset);
+        entry.mSize   = aSize;
+
+        if (mUnusedBytes > kMinCompactionBytes && mUnusedBytes > mData.size() - mUnusedBytes)
+        {
+            Compact();
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    void SetStatus(AttributeId aAttributeId, const StatusIB & aStatus)
+    {
+        static_assert(CanEnableDataCaching, "Attribute statuses are only stored when data caching is enabled");
+
+        AttributeEntry & entry = FindOrInsert(aAttributeId);
+        Release(entry);
+        entry.mKind   = Kind::kStatus;
+        entry.mStatus = aStatus;
+        entry.mSize   = SizeOfStatusIB(aStatus);
+    }
+
+    void SetSize(AttributeId aAttributeId, uint32_t aSize)
+    {
+        AttributeEntry & entry = FindOrInsert(aAttributeId);
+        Release(entry);
+        entry.mKind = Kind::kSize;
+        entry.mSize = aSize;
+    }
+
+    CHIP_ERROR GetData(AttributeId aAttributeId, TLV::TLVReader & aReader) const
+    {
+        static_assert(CanEnableDataCaching, "Attribute data is only stored when data caching is enabled");
+
+        const AttributeEntry * entry = Find(aAttributeId);
+        VerifyOrReturnError(entry != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+        VerifyOrReturnError(entry->mKind != Kind::kStatus, CHIP_ERROR_IM_STATUS_CODE_RECEIVED);
+        VerifyOrReturnError(entry->mKind == Kind::kData, CHIP_ERROR_KEY_NOT_FOUND);
+
+        aReader.Init(mData.data() + entry->mOffset, entry->mSize);
+        return aReader.Next();
+    }
+
+    CHIP_ERROR GetStatus(AttributeId aAttributeId, StatusIB & aStatus) const
+    {
+        static_assert(CanEnableDataCaching, "Attribute statuses are only stored when data caching is enabled");
+
+        const AttributeEntry * entry = Find(aAttributeId);
+        VerifyOrReturnError(entry != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+        VerifyOrReturnError(entry->mKind == Kind::kStatus, CHIP_ERROR_INVALID_ARGUMENT);
+
+        aStatus = entry->mStatus;
+        return CHIP_NO_ERROR;
+    }
+
+    size_t GetEncodedSize() const
+    {
+        size_t size = 0;
+        for (const auto & entry : mAttributes)
+        {
+            size += entry.mSize;
+        }
+        return size;
+    }
+
+    template <typename IteratorFunc>
+    CHIP_ERROR ForEachAttribute(IteratorFunc func) const
+    {
+        for (const auto & entry : mAttributes)
+        {
+            ReturnErrorOnFailure(func(entry.mAttributeId));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+private:
+    // Below this many unused bytes, a slab is never compacted.
+    static constexpr size_t kMinCompactionBytes = 64;
+
+    enum class Kind : uint8_t
+    {
+        kSize,   // Only the encoded size of the data is known.
+        kData,   // The encoded data is at mOffset in mData.
+        kStatus, // The attribute has a path-specific status.
+    };
+
+    struct AttributeEntry
+    {
+        AttributeId mAttributeId;
+        uint32_t mOffset;
+        uint32_t mSize; // Encoded size of the data or of the status.
+        StatusIB mStatus;
+        Kind mKind;
+    };
+
+    static bool Precedes(const AttributeEntry & aEntry, AttributeId aAttributeId) { return aEntry.mAttributeId < aAttributeId; }
+
+    const AttributeEntry * Find(AttributeId aAttributeId) const
+    {
+        auto iter = std::lower_bound(mAttributes.begin(), mAttributes.end(), aAttributeId, Precedes);
+        return (iter != mAttributes.end() && iter->mAttributeId == aAttributeId) ? &*iter : nullptr;
+    }
+
+    AttributeEntry & FindOrInsert(AttributeId aAttributeId)
+    {
+        auto iter = std::lower_bound(mAttributes.begin(), mAttributes.end(), aAttributeId, Precedes);
+        if (iter == mAttributes.end() || iter->mAttributeId != aAttributeId)
+        {
+            AttributeEntry entry = {};
+            entry.mAttributeId   = aAttributeId;
+            entry.mKind          = Kind::kSize;
+            iter                 = mAttributes.insert(iter, entry);
+        }
+        return *iter;
+    }
+
+    // Account for the slab bytes used by the current value of an attribute that is about to be replaced.
+    void Release(const AttributeEntry & aEntry)
+    {
+        if (aEntry.mKind == Kind::kData)
+        {
+            mUnusedBytes += aEntry.mSize;
+        }
+    }
+
+    void Compact()
+    {
+        std::vector<uint8_t> data;
+        data.reserve(mData.size() - mUnusedBytes);
+        for (auto & entry : mAttributes)
+        {
+            if (entry.mKind == Kind::kData)
+            {
+                const uint8_t * value = mData.data() + entry.mOffset;
+                entry.mOffset         = static_cast<uint32_t>(data.size());
+                data.insert(data.end(), value, value + entry.mSize);
+            }
+        }
+        mData        = std::move(data);
+        mUnusedBytes = 0;
+    }
+
+    std::vector<AttributeEntry> mAttributes;
+    std::vector<uint8_t> mData;
+    size_t mUnusedBytes = 0;
+};
+
+/*
+ * Node state of the kFlat layout: the clusters of all endpoints, in a single vector sorted by endpoint and cluster ID.
+ *
+ * Adding a cluster moves the clusters that follow it, so references returned by GetOrCreateCluster() and FindCluster()
+ * must not be held across a call to GetOrCreateCluster().
+ */
+template <typename ClusterStateT>
+class FlatNodeState
+{
+public:
+    using ClusterState = ClusterStateT;
+
+    bool HasEndpoint(EndpointId aEndpointId) const
+    {
+        auto iter = LowerBound(aEndpointId, 0);
+        return iter != mClusters.end() && iter->mEndpointId == aEndpointId;
+    }
+
+    const ClusterState * FindCluster(EndpointId aEndpointId, ClusterId aClusterId) const
+    {
+        auto iter = LowerBound(aEndpointId, aClusterId);
+        if (iter == mClusters.end() || iter->mEndpointId != aEndpointId || iter->mClusterId != aClusterId)
+        {
+            return nullptr;
+        }
+        return &iter->mState;
+    }
+
+    ClusterState & GetOrCreateCluster(EndpointId aEndpointId, ClusterId aClusterId)
+    {
+        auto iter = std::lower_bound(mClusters.begin(), mClusters.end(), Key(aEndpointId, aClusterId), Precedes);
+        if (iter == mClusters.end() || iter->mEndpointId != aEndpointId || iter->mClusterId != aClusterId)
+        {
+            ClusterEntry entry;
+            entry.mEndpointId = aEndpointId;
+            entry.mClusterId  = aClusterId;
+            iter              = mClusters.insert(iter, std::move(entry));
+        }
+        return iter->mState;
+    }
+
+    template <typename IteratorFunc>
+    CHIP_ERROR ForEachCluster(IteratorFunc func) const
+    {
+        for (const auto & entry : mClusters)
+        {
+            ReturnErrorOnFailure(func(entry.mEndpointId, entry.mClusterId, entry.mState));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    template <typename IteratorFunc>
+    CHIP_ERROR ForEachCluster(EndpointId aEndpointId, IteratorFunc func) const
+    {
+        for (auto iter = LowerBound(aEndpointId, 0); iter != mClusters.end() && iter->mEndpointId == aEndpointId; ++iter)
+        {
+            ReturnErrorOnFailure(func(iter->mClusterId, iter->mState));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+private:
+    struct ClusterEntry
+    {
+        EndpointId mEndpointId;
+        ClusterId mClusterId;
+        ClusterState mState;
+    };
+
+    static uint64_t Key(EndpointId aEndpointId, ClusterId aClusterId)
+    {
+        return (static_cast<uint64_t>(aEndpointId) << 32) | aClusterId;
+    }
+
+    static bool Precedes(const ClusterEntry & aEntry, uint64_t aKey) { return Key(aEntry.mEndpointId, aEntry.mClusterId) < aKey; }
+
+    typename std::vector<ClusterEntry>::const_iterator LowerBound(EndpointId aEndpointId, ClusterId aClusterId) const
+    {
+        return std::lower_bound(mClusters.begin(), mClusters.end(), Key(aEndpointId, aClusterId), Precedes);
+    }
+
+    std::vector<ClusterEntry> mClusters;
+};
+
+/*
+ * The node state type for a given data caching mode and layout.
+ */
+template <bool CanEnableDataCaching, ClusterStateCacheLayout Layout>
+using NodeState =
+    std::conditional_t<Layout == ClusterStateCacheLayout::kFlat, FlatNodeState<FlatClusterState<CanEnableDataCaching>>,
+                       MapNodeState<MapClusterState<CanEnableDataCaching>>>;
+
+} // namespace ClusterStateCacheStorage
+} // namespace app
+} // namespace chip
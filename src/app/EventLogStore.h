@@ -0,0 +1,85 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * @brief
+ *   Interface of a secondary, typically persistent, store for the events logged through EventManagement.
+ */
+
+#pragma once
+
+#include <app/EventLoggingTypes.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/Span.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * @brief
+ *   A store keeping a copy of every event logged through EventManagement, usually larger than the event buffers and
+ *   surviving restarts.
+ *
+ * Events are appended in increasing event number order, as they are logged, and FetchEventsSince reads them back instead
+ * of reading them from the event buffers, which may have evicted some of them.  Every event is stored as the TLV
+ * EventReportIB written in the event buffers, so that it is reported exactly as if it had been read from them.
+ *
+ * The store may drop its oldest events to bound its size.  It is only used from the Matter stack thread.
+ */
+class EventLogStore
+{
+public:
+    class Visitor
+    {
+    public:
+        virtual ~Visitor() = default;
+
+        /**
+         * Called for every event visited by ForEachEventSince, in increasing event number order.  aEntry.mOffset and
+         * aEntry.mLength are relative to the storage of the store; aEvent is only valid for the duration of the call.
+         *
+         * Returning anything but CHIP_NO_ERROR stops the iteration, and ForEachEventSince returns that error.
+         */
+        virtual CHIP_ERROR OnEvent(const EventIndexEntry & aEntry, const ByteSpan & aEvent) = 0;
+    };
+
+    virtual ~EventLogStore() = default;
+
+    /**
+     * Append an event.  aEntry describes the event; its mOffset is ignored.
+     *
+     * If aEntry.mEventNumber is not larger than the last stored event number, event numbering restarted (for example
+     * after a factory reset) and the store discards the events it holds before appending this one.
+     */
+    virtual CHIP_ERROR Append(const EventIndexEntry & aEntry, const ByteSpan & aEvent) = 0;
+
+    /**
+     * Visit the stored events, starting at the oldest one whose event number is not less than aEventNumber.
+     */
+    virtual CHIP_ERROR ForEachEventSince(EventNumber aEventNumber, Visitor & aVisitor) = 0;
+
+    /**
+     * Mark the stored events of aFabricIndex as belonging to no fabric anymore, so that they are never reported again.
+     */
+    virtual CHIP_ERROR RemoveFabric(FabricIndex aFabricIndex) = 0;
+};
+
+} // namespace app
+} // namespace chip
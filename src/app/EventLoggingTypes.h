@@ -136,6 +136,22 @@ public:
     FabricIndex mFabricIndex = kUndefinedFabricIndex;
 };
 
+/**
+ * @brief
+ *   Describes where one stored event lives, in a CircularEventBuffer or in an EventLogStore, and enough of its envelope to
+ *   decide, without decoding the event, whether a fetch may be interested in it.
+ */
+struct EventIndexEntry
+{
+    EventNumber mEventNumber = 0;
+    uint32_t mOffset         = 0; ///< Offset of the event in its storage.
+    uint32_t mLength         = 0; ///< Encoded length of the event, in bytes.
+    ClusterId mClusterId     = kInvalidClusterId;
+    EndpointId mEndpointId   = kInvalidEndpointId;
+    FabricIndex mFabricIndex = kUndefinedFabricIndex;
+    bool mHasFabricIndex     = false;
+};
+
 /**
  * @brief
  *   Structure for copying event lists on output.
@@ -149,12 +165,14 @@ struct EventLoadOutContext
     TLV::TLVWriter & mWriter;
     PriorityLevel mPriority          = PriorityLevel::Invalid;
     EventNumber mStartingEventNumber = 0;
+    EventNumber mBootEventNumber     = 0; ///< Events numbered below this one were logged before the last restart
     Timestamp mPreviousTime;
     Timestamp mCurrentTime;
     EventNumber mCurrentEventNumber                                      = 0;
     size_t mEventCount                                                   = 0;
     const SingleLinkedListNode<EventPathParams> * mpInterestedEventPaths = nullptr;
     bool mFirst                                                          = true;
+    bool mPreviousFromEarlierBoot                                        = false;
     Access::SubjectDescriptor mSubjectDescriptor;
 };
 } // namespace app
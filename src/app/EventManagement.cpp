@@ -26,8 +26,11 @@
 #include <inttypes.h>
 #include <lib/core/TLVUtilities.h>
 #include <lib/support/CodeUtils.h>
+#include <lib/support/ScopedBuffer.h>
 #include <lib/support/logging/CHIPLogging.h>
 
+#include <algorithm>
+
 using namespace chip::TLV;
 
 namespace chip {
@@ -57,6 +60,63 @@ public:
     virtual ~CircularEventReader() = default;
 };
 
+/**
+ * @brief
+ *   A read-only TLVBackingStore over a single event of a CircularEventBuffer, located through its index entry.  The event
+ *   may wrap around the end of the buffer storage.
+ */
+class IndexedEventBackingStore : public TLV::TLVBackingStore
+{
+public:
+    IndexedEventBackingStore(const CircularEventBuffer & aBuffer, const EventIndexEntry & aEntry) :
+        mpQueue(aBuffer.GetQueue()), mQueueSize(aBuffer.GetTotalDataLength()), mOffset(aEntry.mOffset), mLength(aEntry.mLength)
+    {}
+
+    CHIP_ERROR OnInit(TLVReader & aReader, const uint8_t *& aBufStart, uint32_t & aBufLen) override
+    {
+        aBufStart = mpQueue + mOffset;
+        aBufLen   = std::min(mLength, mQueueSize - mOffset);
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR GetNextBuffer(TLVReader & aReader, const uint8_t *& aBufStart, uint32_t & aBufLen) override
+    {
+        // The only thing that can be left to read is the part of the event that wrapped around to the start of the storage.
+        const uint32_t firstPartLength = mQueueSize - mOffset;
+        if (aBufStart == mpQueue + mQueueSize && mLength > firstPartLength)
+        {
+            aBufStart = mpQueue;
+            aBufLen   = mLength - firstPartLength;
+        }
+        else
+        {
+            aBufLen = 0;
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR OnInit(TLVWriter & aWriter, uint8_t *& aBufStart, uint32_t & aBufLen) override { return CHIP_ERROR_NOT_IMPLEMENTED; }
+    CHIP_ERROR GetNewBuffer(TLVWriter & aWriter, uint8_t *& aBufStart, uint32_t & aBufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+    CHIP_ERROR FinalizeBuffer(TLVWriter & aWriter, uint8_t * aBufStart, uint32_t aBufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
+private:
+    const uint8_t * mpQueue;
+    uint32_t mQueueSize;
+    uint32_t mOffset;
+    uint32_t mLength;
+};
+
+static uint32_t GetTailOffset(const CircularEventBuffer & aBuffer)
+{
+    return static_cast<uint32_t>(aBuffer.QueueTail() - aBuffer.GetQueue());
+}
+
 EventManagement & EventManagement::GetInstance()
 {
     return sInstance;
@@ -109,6 +169,7 @@ void EventManagement::Init(Messaging::ExchangeManager * apExchangeManager, uint3
         current = &apCircularEventBuffer[bufferIndex];
         current->Init(apLogStorageResources[bufferIndex].mpBuffer, apLogStorageResources[bufferIndex].mBufferSize, prev, next,
                       apLogStorageResources[bufferIndex].mPriority);
+        current->GetIndex().Init(apLogStorageResources[bufferIndex].mpIndex, apLogStorageResources[bufferIndex].mIndexSize);
 
         prev = current;
 
@@ -118,6 +179,7 @@ void EventManagement::Init(Messaging::ExchangeManager * apExchangeManager, uint3
 
     mpEventNumberCounter = apEventNumberCounter;
     mLastEventNumber     = mpEventNumberCounter->GetValue();
+    mBootEventNumber     = mLastEventNumber;
 
     mpEventBuffer = apCircularEventBuffer;
     mState        = EventManagementStates::Idle;
@@ -137,6 +199,7 @@ CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer
         return CHIP_ERROR_INVALID_ARGUMENT;
     }
     CircularEventBuffer backup = *nextBuffer;
+    uint32_t offset            = GetTailOffset(*nextBuffer);
 
     // Set up the next buffer s.t. it fails if needs to evict an element
     nextBuffer->mProcessEvictedElement = AlwaysFail;
@@ -155,6 +218,18 @@ CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer
     err = writer.Finalize();
     SuccessOrExit(err);
 
+    // The event is copied verbatim, so only its location changes in the index.
+    if (apEventBuffer->GetIndex().Count() != 0)
+    {
+        EventIndexEntry entry = apEventBuffer->GetIndex()[0];
+        entry.mOffset         = offset;
+        nextBuffer->GetIndex().PushBack(entry);
+    }
+    else
+    {
+        nextBuffer->GetIndex().MarkOutOfSync();
+    }
+
     ChipLogDetail(EventLogging, "Copy Event to next buffer with priority %u", static_cast<unsigned>(nextBuffer->GetPriority()));
 exit:
     if (err != CHIP_NO_ERROR)
@@ -188,11 +263,11 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
     VerifyOrExit(eventBuffer != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
 
     // check whether we actually need to do anything, exit if we don't
-    VerifyOrExit(requiredSpace > eventBuffer->AvailableDataLength(), err = CHIP_NO_ERROR);
+    VerifyOrExit(!eventBuffer->HasSpaceFor(requiredSpace), err = CHIP_NO_ERROR);
 
     while (true)
     {
-        if (requiredSpace > eventBuffer->AvailableDataLength())
+        if (!eventBuffer->HasSpaceFor(requiredSpace))
         {
             ctx.mpEventBuffer             = eventBuffer;
             ctx.mSpaceNeededForMovedEvent = 0;
@@ -200,6 +275,11 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
             eventBuffer->mProcessEvictedElement = EvictEvent;
             eventBuffer->mAppData               = &ctx;
             err                                 = eventBuffer->EvictHead();
+            if (err == CHIP_NO_ERROR)
+            {
+                // The head event was dropped.
+                eventBuffer->GetIndex().PopFront();
+            }
 
             // one of two things happened: either the element was evicted immediately if the head's priority is same as current
             // buffer(final one), or we figured out how much space we need to evict it into the next buffer, the check happens in
@@ -209,7 +289,7 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
             {
                 VerifyOrExit(ctx.mSpaceNeededForMovedEvent != 0, /* no-op, return err */);
                 VerifyOrExit(eventBuffer->GetNextCircularEventBuffer() != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
-                if (ctx.mSpaceNeededForMovedEvent <= eventBuffer->GetNextCircularEventBuffer()->AvailableDataLength())
+                if (eventBuffer->GetNextCircularEventBuffer()->HasSpaceFor(ctx.mSpaceNeededForMovedEvent))
                 {
                     // we can copy the event outright.  copy event and
                     // subsequently evict head s.t. evicting the head
@@ -228,6 +308,7 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
                     // caller know that we could not honor the
                     // request
                     SuccessOrExit(err);
+                    eventBuffer->GetIndex().PopFront();
                     continue;
                 }
                 // we cannot copy event outright. We remember the
@@ -353,9 +434,10 @@ void EventManagement::CreateEventManagement(Messaging::ExchangeManager * apExcha
  */
 void EventManagement::DestroyEventManagement()
 {
-    sInstance.mState        = EventManagementStates::Shutdown;
-    sInstance.mpEventBuffer = nullptr;
-    sInstance.mpExchangeMgr = nullptr;
+    sInstance.mState          = EventManagementStates::Shutdown;
+    sInstance.mpEventBuffer   = nullptr;
+    sInstance.mpExchangeMgr   = nullptr;
+    sInstance.mpEventLogStore = nullptr;
 }
 
 CircularEventBuffer * EventManagement::GetPriorityBuffer(PriorityLevel aPriority) const
@@ -424,10 +506,12 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, c
     CircularTLVWriter writer;
     CHIP_ERROR err               = CHIP_NO_ERROR;
     uint32_t requestSize         = 0;
+    uint32_t eventOffset         = 0;
     aEventNumber                 = 0;
     CircularTLVWriter checkpoint = writer;
     EventLoadOutContext ctxt     = EventLoadOutContext(writer, aEventOptions.mPriority, mLastEventNumber);
     EventOptions opts;
+    EventIndexEntry entry;
 
     Timestamp timestamp;
 #if CHIP_DEVICE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
@@ -465,11 +549,21 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, c
     err = EnsureSpaceInCircularBuffer(requestSize, aEventOptions.mPriority);
     SuccessOrExit(err);
 
-    err = ConstructEvent(&ctxt, apDelegate, &opts);
+    eventOffset = GetTailOffset(*mpEventBuffer);
+    err         = ConstructEvent(&ctxt, apDelegate, &opts);
     SuccessOrExit(err);
 
     mBytesWritten += writer.GetLengthWritten();
 
+    entry.mEventNumber    = ctxt.mCurrentEventNumber;
+    entry.mOffset         = eventOffset;
+    entry.mLength         = writer.GetLengthWritten();
+    entry.mClusterId      = opts.mPath.mClusterId;
+    entry.mEndpointId     = opts.mPath.mEndpointId;
+    entry.mFabricIndex    = opts.mFabricIndex;
+    entry.mHasFabricIndex = (opts.mFabricIndex != kUndefinedFabricIndex);
+    mpEventBuffer->GetIndex().PushBack(entry);
+
 exit:
     if (err != CHIP_NO_ERROR)
     {
@@ -481,6 +575,7 @@ exit:
         aEventNumber = mLastEventNumber;
         VendEventNumber();
         mLastEventTimestamp = timestamp;
+        AppendToEventLogStore(entry);
 #if CHIP_CONFIG_EVENT_LOGGING_VERBOSE_DEBUG_LOGS
         ChipLogDetail(EventLogging,
                       "LogEvent event number: 0x" ChipLogFormatX64 " priority: %u, endpoint id:  0x%x"
@@ -496,6 +591,49 @@ exit:
     return err;
 }
 
+void EventManagement::AppendToEventLogStore(const EventIndexEntry & aEntry)
+{
+    VerifyOrReturn(mpEventLogStore != nullptr);
+
+    // The event was just written to the debug buffer.  Hand it to the store in place, unless it wraps around the end of the
+    // buffer storage, in which case it has to be made contiguous first.
+    const uint8_t * queue    = mpEventBuffer->GetQueue();
+    const uint32_t queueSize = mpEventBuffer->GetTotalDataLength();
+    CHIP_ERROR err           = CHIP_NO_ERROR;
+    if (aEntry.mOffset + aEntry.mLength <= queueSize)
+    {
+        err = mpEventLogStore->Append(aEntry, ByteSpan(queue + aEntry.mOffset, aEntry.mLength));
+    }
+    else
+    {
+        Platform::ScopedMemoryBuffer<uint8_t> event;
+        if (event.Alloc(aEntry.mLength))
+        {
+            const uint32_t firstPartLength = queueSize - aEntry.mOffset;
+            memcpy(event.Get(), queue + aEntry.mOffset, firstPartLength);
+            memcpy(event.Get() + firstPartLength, queue, aEntry.mLength - firstPartLength);
+            err = mpEventLogStore->Append(aEntry, ByteSpan(event.Get(), aEntry.mLength));
+        }
+        else
+        {
+            err = CHIP_ERROR_NO_MEMORY;
+        }
+    }
+
+    // The event stays available from the event buffers, so failing to store it is not a failure to log it.  Remember that the
+    // store misses it, so that FetchStoredEventsSince does not skip it.
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(EventLogging, "Failed to store event 0x" ChipLogFormatX64 ": %" CHIP_ERROR_FORMAT,
+                     ChipLogValueX64(aEntry.mEventNumber), err.Format());
+        if (!mFirstUnstoredEventNumber.HasValue())
+        {
+            mFirstUnstoredEventNumber.SetValue(aEntry.mEventNumber);
+        }
+        mLastUnstoredEventNumber = aEntry.mEventNumber;
+    }
+}
+
 CHIP_ERROR EventManagement::CopyEvent(const TLVReader & aReader, TLVWriter & aWriter, EventLoadOutContext * apContext)
 {
     TLVReader reader;
@@ -617,6 +755,18 @@ CHIP_ERROR EventManagement::CopyEventsSince(const TLVReader & aReader, size_t aD
     CHIP_ERROR err = EventIterator(aReader, aDepth, loadOutContext, &event);
     if (err == CHIP_EVENT_ID_FOUND)
     {
+        // Events read back from the EventLogStore may have been logged before the last restart. Their system timestamps
+        // count from a boot that is gone, so skip them, and never write a delta timestamp across the boot boundary.
+        const bool fromEarlierBoot = loadOutContext->mCurrentEventNumber < loadOutContext->mBootEventNumber;
+        if (fromEarlierBoot && loadOutContext->mCurrentTime.IsSystem())
+        {
+            return CHIP_NO_ERROR;
+        }
+        if (fromEarlierBoot != loadOutContext->mPreviousFromEarlierBoot)
+        {
+            loadOutContext->mFirst = true;
+        }
+
         // checkpoint the writer
         TLV::TLVWriter checkpoint = loadOutContext->mWriter;
 
@@ -632,8 +782,9 @@ CHIP_ERROR EventManagement::CopyEventsSince(const TLVReader & aReader, size_t aD
             return err;
         }
 
-        loadOutContext->mPreviousTime.mValue = loadOutContext->mCurrentTime.mValue;
-        loadOutContext->mFirst               = false;
+        loadOutContext->mPreviousTime.mValue     = loadOutContext->mCurrentTime.mValue;
+        loadOutContext->mFirst                   = false;
+        loadOutContext->mPreviousFromEarlierBoot = fromEarlierBoot;
         loadOutContext->mEventCount++;
     }
     return err;
@@ -643,7 +794,6 @@ CHIP_ERROR EventManagement::FetchEventsSince(TLVWriter & aWriter, const SingleLi
                                              EventNumber & aEventMin, size_t & aEventCount,
                                              const Access::SubjectDescriptor & aSubjectDescriptor)
 {
-    // TODO: Add particular set of event Paths in FetchEventsSince so that we can filter the interested paths
     CHIP_ERROR err     = CHIP_NO_ERROR;
     const bool recurse = false;
     TLVReader reader;
@@ -652,13 +802,29 @@ CHIP_ERROR EventManagement::FetchEventsSince(TLVWriter & aWriter, const SingleLi
 
     context.mSubjectDescriptor     = aSubjectDescriptor;
     context.mpInterestedEventPaths = apEventPathList;
-    err                            = GetEventReader(reader, PriorityLevel::Critical, &bufWrapper);
-    SuccessOrExit(err);
+    context.mBootEventNumber       = mBootEventNumber;
 
-    err = TLV::Utilities::Iterate(reader, CopyEventsSince, &context, recurse);
-    if (err == CHIP_END_OF_TLV)
+    if (mpEventLogStore != nullptr)
     {
-        err = CHIP_NO_ERROR;
+        err = FetchStoredEventsSince(context);
+        SuccessOrExit(err);
+    }
+
+    if (IsEventIndexUsable())
+    {
+        err = FetchIndexedEventsSince(context);
+        SuccessOrExit(err);
+    }
+    else
+    {
+        err = GetEventReader(reader, PriorityLevel::Critical, &bufWrapper);
+        SuccessOrExit(err);
+
+        err = TLV::Utilities::Iterate(reader, CopyEventsSince, &context, recurse);
+        if (err == CHIP_END_OF_TLV)
+        {
+            err = CHIP_NO_ERROR;
+        }
     }
 
 exit:
@@ -676,6 +842,127 @@ exit:
     return err;
 }
 
+bool EventManagement::IsEventIndexUsable() const
+{
+    VerifyOrReturnValue(mpEventBuffer != nullptr, false);
+    for (CircularEventBuffer * buffer = mpEventBuffer; buffer != nullptr; buffer = buffer->GetNextCircularEventBuffer())
+    {
+        VerifyOrReturnValue(buffer->GetIndex().IsUsable(), false);
+    }
+    return true;
+}
+
+bool EventManagement::MayMatchIndexedEvent(const EventLoadOutContext & aContext, const EventIndexEntry & aEntry)
+{
+    if (aEntry.mHasFabricIndex &&
+        (aEntry.mFabricIndex == kUndefinedFabricIndex || aEntry.mFabricIndex != aContext.mSubjectDescriptor.fabricIndex))
+    {
+        return false;
+    }
+
+    for (auto * interestedPath = aContext.mpInterestedEventPaths; interestedPath != nullptr;
+         interestedPath        = interestedPath->mpNext)
+    {
+        if ((interestedPath->mValue.HasWildcardEndpointId() || interestedPath->mValue.mEndpointId == aEntry.mEndpointId) &&
+            (interestedPath->mValue.HasWildcardClusterId() || interestedPath->mValue.mClusterId == aEntry.mClusterId))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+CHIP_ERROR EventManagement::FetchIndexedEventsSince(EventLoadOutContext & aContext) const
+{
+    // The most critical buffer holds the oldest events and the debug one the newest, and every buffer keeps its events in
+    // increasing event number order, so this visits the events in the same order as the reader from GetEventReader.
+    for (CircularEventBuffer * buffer = GetPriorityBuffer(PriorityLevel::Critical); buffer != nullptr;
+         buffer                       = buffer->GetPreviousCircularEventBuffer())
+    {
+        const EventIndex & index = buffer->GetIndex();
+        if (index.Count() == 0)
+        {
+            continue;
+        }
+
+        if (index[index.Count() - 1].mEventNumber < aContext.mStartingEventNumber)
+        {
+            // Everything in this buffer was fetched already.
+            aContext.mCurrentEventNumber = index[index.Count() - 1].mEventNumber;
+            continue;
+        }
+
+        for (uint32_t i = index.LowerBound(aContext.mStartingEventNumber); i < index.Count(); i++)
+        {
+            const EventIndexEntry & entry = index[i];
+            aContext.mCurrentEventNumber  = entry.mEventNumber;
+            if (!MayMatchIndexedEvent(aContext, entry))
+            {
+                continue;
+            }
+
+            IndexedEventBackingStore backingStore(*buffer, entry);
+            TLVReader reader;
+            ReturnErrorOnFailure(reader.Init(backingStore, entry.mLength));
+            ReturnErrorOnFailure(reader.Next());
+            ReturnErrorOnFailure(CopyEventsSince(reader, 0, &aContext));
+        }
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EventManagement::FetchStoredEventsSince(EventLoadOutContext & aContext)
+{
+    class CatchUpVisitor : public EventLogStore::Visitor
+    {
+    public:
+        CatchUpVisitor(EventLoadOutContext & aContext, const Optional<EventNumber> & aFirstUnstoredEventNumber,
+                       EventNumber aLastUnstoredEventNumber) :
+            mContext(aContext),
+            mFirstUnstoredEventNumber(aFirstUnstoredEventNumber), mLastUnstoredEventNumber(aLastUnstoredEventNumber)
+        {}
+
+        CHIP_ERROR OnEvent(const EventIndexEntry & aEntry, const ByteSpan & aEvent) override
+        {
+            // Stop at the first gap that may hold an event the store failed to append: that event, and every event after
+            // it, is then fetched from the event buffers instead.
+            const EventNumber nextEventNumber =
+                mLastEventNumber.HasValue() ? mLastEventNumber.Value() + 1 : mContext.mStartingEventNumber;
+            VerifyOrReturnError(aEntry.mEventNumber <= nextEventNumber || !mFirstUnstoredEventNumber.HasValue() ||
+                                    mFirstUnstoredEventNumber.Value() >= aEntry.mEventNumber ||
+                                    mLastUnstoredEventNumber < nextEventNumber,
+                                CHIP_ERROR_SENTINEL);
+
+            mContext.mCurrentEventNumber = aEntry.mEventNumber;
+            mLastEventNumber.SetValue(aEntry.mEventNumber);
+            VerifyOrReturnError(MayMatchIndexedEvent(mContext, aEntry), CHIP_NO_ERROR);
+
+            TLVReader reader;
+            reader.Init(aEvent);
+            ReturnErrorOnFailure(reader.Next());
+            return CopyEventsSince(reader, 0, &mContext);
+        }
+
+        EventLoadOutContext & mContext;
+        const Optional<EventNumber> mFirstUnstoredEventNumber;
+        const EventNumber mLastUnstoredEventNumber;
+        Optional<EventNumber> mLastEventNumber;
+    };
+
+    CatchUpVisitor visitor(aContext, mFirstUnstoredEventNumber, mLastUnstoredEventNumber);
+    CHIP_ERROR err = mpEventLogStore->ForEachEventSince(aContext.mStartingEventNumber, visitor);
+    VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_ERROR_SENTINEL, err);
+
+    // The store holds a contiguous run of the events logged up to there, while lower priority events may have been evicted
+    // from the event buffers even though older events are still buffered: only fetch from the buffers the events newer than
+    // the ones read from the store.
+    if (visitor.mLastEventNumber.HasValue())
+    {
+        aContext.mStartingEventNumber = visitor.mLastEventNumber.Value() + 1;
+    }
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR EventManagement::FabricRemovedCB(const TLV::TLVReader & aReader, size_t aDepth, void * apContext)
 {
     // the function does not actually remove the event, instead, it sets the fabric index to an invalid value.
@@ -732,6 +1019,27 @@ CHIP_ERROR EventManagement::FabricRemoved(FabricIndex aFabricIndex)
     {
         err = CHIP_NO_ERROR;
     }
+
+    for (CircularEventBuffer * buffer = mpEventBuffer; buffer != nullptr; buffer = buffer->GetNextCircularEventBuffer())
+    {
+        EventIndex & index = buffer->GetIndex();
+        for (uint32_t i = 0; i < index.Count(); i++)
+        {
+            if (index[i].mHasFabricIndex && index[i].mFabricIndex == aFabricIndex)
+            {
+                index[i].mFabricIndex = kUndefinedFabricIndex;
+            }
+        }
+    }
+
+    if (mpEventLogStore != nullptr)
+    {
+        CHIP_ERROR storeErr = mpEventLogStore->RemoveFabric(aFabricIndex);
+        if (err == CHIP_NO_ERROR)
+        {
+            err = storeErr;
+        }
+    }
     return err;
 }
 
@@ -850,6 +1158,50 @@ void EventManagement::SetScheduledEventInfo(EventNumber & aEventNumber, uint32_t
     aInitialWrittenEventBytes = mBytesWritten;
 }
 
+void EventIndex::PushBack(const EventIndexEntry & aEntry)
+{
+    VerifyOrReturn(IsEnabled());
+    if (mCount == mCapacity)
+    {
+        MarkOutOfSync();
+        return;
+    }
+    mpEntries[(mHead + mCount) % mCapacity] = aEntry;
+    mCount++;
+}
+
+void EventIndex::PopFront()
+{
+    VerifyOrReturn(IsEnabled());
+    if (mCount == 0)
+    {
+        MarkOutOfSync();
+        return;
+    }
+    mHead = (mHead + 1) % mCapacity;
+    mCount--;
+}
+
+uint32_t EventIndex::LowerBound(EventNumber aEventNumber) const
+{
+    uint32_t first = 0;
+    uint32_t count = mCount;
+    while (count > 0)
+    {
+        uint32_t step = count / 2;
+        if ((*this)[first + step].mEventNumber < aEventNumber)
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+    return first;
+}
+
 void CircularEventBuffer::Init(uint8_t * apBuffer, uint32_t aBufferLength, CircularEventBuffer * apPrev,
                                CircularEventBuffer * apNext, PriorityLevel aPriorityLevel)
 {
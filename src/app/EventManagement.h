@@ -28,10 +28,12 @@
 
 #include "EventLoggingDelegate.h"
 #include <access/SubjectDescriptor.h>
+#include <app/EventLogStore.h>
 #include <app/EventLoggingTypes.h>
 #include <app/MessageDef/EventDataIB.h>
 #include <app/MessageDef/StatusIB.h>
 #include <app/util/basic-types.h>
+#include <lib/core/Optional.h>
 #include <lib/core/TLVCircularBuffer.h>
 #include <lib/support/CHIPCounter.h>
 #include <lib/support/LinkedList.h>
@@ -76,6 +78,51 @@ inline constexpr size_t kMaxEventSizeReserve            = 512;
 constexpr uint16_t kRequiredEventField =
     (1 << to_underlying(EventDataIB::Tag::kPriority)) | (1 << to_underlying(EventDataIB::Tag::kPath));
 
+/**
+ * @brief
+ *   A ring of EventIndexEntry, in the same order as the events stored in the CircularEventBuffer that owns it.
+ *
+ * The storage is provided by the application through LogStorageResources.  The index is kept in lockstep with the buffer:
+ * an entry is pushed for every event written into the buffer and popped for every event evicted from it.  Should the two
+ * ever disagree, the index marks itself out of sync and EventManagement falls back to scanning the buffer.
+ */
+class EventIndex
+{
+public:
+    void Init(EventIndexEntry * apEntries, uint32_t aCapacity)
+    {
+        mpEntries  = apEntries;
+        mCapacity  = (apEntries != nullptr) ? aCapacity : 0;
+        mHead      = 0;
+        mCount     = 0;
+        mOutOfSync = false;
+    }
+
+    bool IsEnabled() const { return mCapacity != 0; }
+    bool IsUsable() const { return IsEnabled() && !mOutOfSync; }
+    bool IsFull() const { return IsEnabled() && mCount == mCapacity; }
+    uint32_t Count() const { return mCount; }
+
+    EventIndexEntry & operator[](uint32_t aIndex) { return mpEntries[(mHead + aIndex) % mCapacity]; }
+    const EventIndexEntry & operator[](uint32_t aIndex) const { return mpEntries[(mHead + aIndex) % mCapacity]; }
+
+    void PushBack(const EventIndexEntry & aEntry);
+    void PopFront();
+    void MarkOutOfSync() { mOutOfSync = IsEnabled(); }
+
+    /**
+     * Returns the position of the first entry whose event number is not less than aEventNumber, or Count() if there is none.
+     */
+    uint32_t LowerBound(EventNumber aEventNumber) const;
+
+private:
+    EventIndexEntry * mpEntries = nullptr;
+    uint32_t mCapacity          = 0;
+    uint32_t mHead              = 0;
+    uint32_t mCount             = 0;
+    bool mOutOfSync             = false;
+};
+
 /**
  * @brief
  *   Internal event buffer, built around the TLV::TLVCircularBuffer
@@ -128,6 +175,15 @@ public:
     void SetRequiredSpaceforEvicted(size_t aRequiredSpace) { mRequiredSpaceForEvicted = aRequiredSpace; }
     size_t GetRequiredSpaceforEvicted() const { return mRequiredSpaceForEvicted; }
 
+    EventIndex & GetIndex() { return mIndex; }
+    const EventIndex & GetIndex() const { return mIndex; }
+
+    /**
+     * @brief
+     *   Whether an event of aRequiredSpace bytes can be added without evicting anything, both in the buffer and in its index.
+     */
+    bool HasSpaceFor(size_t aRequiredSpace) const { return aRequiredSpace <= AvailableDataLength() && !mIndex.IsFull(); }
+
     ~CircularEventBuffer() override = default;
 
 private:
@@ -139,6 +195,8 @@ private:
 
     size_t mRequiredSpaceForEvicted = 0; ///< Required space for previous buffer to evict event to new buffer
 
+    EventIndex mIndex; ///< Index of the events stored in this buffer; disabled unless storage is provided for it
+
     CHIP_ERROR OnInit(TLV::TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override;
 };
 
@@ -187,6 +245,10 @@ struct LogStorageResources
     uint32_t mBufferSize = 0; ///< The size, in bytes, of the `mBuffer`.
     PriorityLevel mPriority =
         PriorityLevel::Invalid; // Log priority level associated with the resources provided in this structure.
+    EventIndexEntry * mpIndex = nullptr; ///< Optional storage for the index of the events stored in `mpBuffer`.  The
+                                         ///< index lets FetchEventsSince skip events without decoding them; it is only
+                                         ///< used when every priority level provides one.
+    uint32_t mIndexSize = 0; ///< The number of entries in `mpIndex`, i.e. the maximum number of events kept in `mpBuffer`.
 };
 
 /**
@@ -387,6 +449,24 @@ public:
      */
     void SetScheduledEventInfo(EventNumber & aEventNumber, uint32_t & aInitialWrittenEventBytes) const;
 
+    /**
+     * @brief
+     *   Set an EventLogStore keeping a copy of every event logged from now on, or nullptr to stop using one.
+     *
+     * FetchEventsSince then reads the events held by the store from it, and only the newer ones from the event buffers, so
+     * that readers that fell behind, or that start reading after a restart, can catch up on more events than the buffers
+     * hold.
+     * Events the store kept from before the last restart are only reported when they carry an epoch timestamp: a system
+     * timestamp counts from the boot that logged the event, and means nothing once that boot is gone.
+     * The store must outlive its use by EventManagement.
+     */
+    void SetEventLogStore(EventLogStore * apEventLogStore)
+    {
+        mpEventLogStore = apEventLogStore;
+        mFirstUnstoredEventNumber.ClearValue();
+        mLastUnstoredEventNumber = 0;
+    }
+
 private:
     /**
      * @brief
@@ -535,6 +615,42 @@ private:
      */
     static CHIP_ERROR CopyEvent(const TLV::TLVReader & aReader, TLV::TLVWriter & aWriter, EventLoadOutContext * apContext);
 
+    /**
+     * @brief Whether every event buffer has a usable index, in which case FetchEventsSince does not need to scan the buffers.
+     */
+    bool IsEventIndexUsable() const;
+
+    /**
+     * @brief
+     *   Internal API used to implement #FetchEventsSince when the event index is usable.
+     *
+     * Seeks straight to the first event not older than the starting event number in every buffer, and only decodes the
+     * events whose indexed path and fabric may be of interest to the context.  Returns the same errors as
+     * #CopyEventsSince.
+     */
+    CHIP_ERROR FetchIndexedEventsSince(EventLoadOutContext & aContext) const;
+
+    /**
+     * @brief Check the indexed envelope of an event against the fabric and the paths of the context.  This is a
+     * conservative check: CheckEventContext still runs on every event accepted by it.
+     */
+    static bool MayMatchIndexedEvent(const EventLoadOutContext & aContext, const EventIndexEntry & aEntry);
+
+    /**
+     * @brief Append the event just logged and described by aEntry to the EventLogStore, if any.  Errors are only logged, and
+     * the number of the event recorded as missing from the store.
+     */
+    void AppendToEventLogStore(const EventIndexEntry & aEntry);
+
+    /**
+     * @brief
+     *   Internal API used by #FetchEventsSince to read the events held by the EventLogStore, after which the context only
+     *   lets the events newer than those be fetched from the event buffers.  Reading from the store stops before the first
+     *   event it failed to append, so that this event is fetched from the buffers.  Returns the same errors as
+     *   #CopyEventsSince.
+     */
+    CHIP_ERROR FetchStoredEventsSince(EventLoadOutContext & aContext);
+
     /**
      * @brief
      *   A function to get the circular buffer for particular priority
@@ -550,11 +666,17 @@ private:
     Messaging::ExchangeManager * mpExchangeMgr = nullptr;
     EventManagementStates mState               = EventManagementStates::Shutdown;
     uint32_t mBytesWritten                     = 0;
+    EventLogStore * mpEventLogStore            = nullptr;
 
     // The counter we're going to use for event numbers.
     MonotonicallyIncreasingCounter<EventNumber> * mpEventNumberCounter = nullptr;
 
     EventNumber mLastEventNumber = 0; ///< Last event Number vended
+    EventNumber mBootEventNumber = 0; ///< First event Number vended since Init
+
+    // The first and the last events that the EventLogStore failed to append, if any.
+    Optional<EventNumber> mFirstUnstoredEventNumber;
+    EventNumber mLastUnstoredEventNumber = 0;
     Timestamp mLastEventTimestamp;    ///< The timestamp of the last event in this buffer
 
     System::Clock::Milliseconds64 mMonotonicStartupTime;
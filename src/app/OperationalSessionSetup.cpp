@@ -461,6 +461,12 @@ void OperationalSessionSetup::OnSessionEstablishmentError(CHIP_ERROR error, Sess
     // member instead of having a boolean
     // mTryingNextResultDueToSessionEstablishmentError, so we can recover the
     // error in UpdateDeviceData.
+    if (CHIP_ERROR_TIMEOUT == error)
+    {
+        // Make sure further attempts look up the peer again.
+        InvalidateCachedPeerAddress();
+    }
+
     if (CHIP_ERROR_TIMEOUT == error || CHIP_ERROR_BUSY == error)
     {
 #if CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
@@ -633,6 +639,14 @@ CHIP_ERROR OperationalSessionSetup::LookupPeerAddress()
     return Resolver::Instance().LookupNode(request, mAddressLookupHandle);
 }
 
+void OperationalSessionSetup::InvalidateCachedPeerAddress()
+{
+    auto const * fabricInfo = mInitParams.fabricTable->FindFabricWithIndex(mPeerId.GetFabricIndex());
+    VerifyOrReturn(fabricInfo != nullptr);
+
+    Resolver::Instance().InvalidateCachedResults(PeerId(fabricInfo->GetCompressedFabricId(), mPeerId.GetNodeId()));
+}
+
 void OperationalSessionSetup::PerformAddressUpdate()
 {
     if (mPerformingAddressUpdate)
@@ -647,7 +661,10 @@ void OperationalSessionSetup::PerformAddressUpdate()
     VerifyOrDie(mState == State::NeedsAddress);
 
     // We are doing an address lookup whether we have an active session for this peer or not.
+    // Address updates are requested when the peer stopped responding at its current address,
+    // so the lookup must not be served from cached results.
     mPerformingAddressUpdate = true;
+    InvalidateCachedPeerAddress();
     MoveToState(State::ResolvingAddress);
     CHIP_ERROR err = LookupPeerAddress();
     if (err != CHIP_NO_ERROR)
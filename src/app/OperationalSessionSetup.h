@@ -418,6 +418,11 @@ private:
      */
     CHIP_ERROR LookupPeerAddress();
 
+    /**
+     * Drops any cached address lookup result for the peer, because it is stale: messages to that address went unanswered.
+     */
+    void InvalidateCachedPeerAddress();
+
     /**
      * This function will set new IP address, port and MRP retransmission intervals of the device.
      */
@@ -132,6 +132,8 @@ void ReadHandler::OnSubscriptionResumed(const SessionHandle & sessionHandle,
     // Notify the observer that a subscription has been resumed
     mObserver->OnSubscriptionEstablished(this);
 
+    mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().AddReadHandlerInterest(*this);
+
     MoveToState(HandlerState::CanStartReporting);
 
     SingleLinkedListNode<AttributePathParams> * attributePath = mpAttributePathList;
@@ -158,6 +160,7 @@ ReadHandler::~ReadHandler()
     {
         mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().OnReportConfirm();
     }
+    mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().RemoveReadHandlerInterest(*this);
     mManagementCallback.GetInteractionModelEngine()->ReleaseAttributePathList(mpAttributePathList);
     mManagementCallback.GetInteractionModelEngine()->ReleaseEventPathList(mpEventPathList);
     mManagementCallback.GetInteractionModelEngine()->ReleaseDataVersionFilterList(mpDataVersionFilterList);
@@ -509,6 +512,7 @@ CHIP_ERROR ReadHandler::ProcessAttributePaths(AttributePathIBs::Parser & aAttrib
     if (CHIP_END_OF_TLV == err)
     {
         mManagementCallback.GetInteractionModelEngine()->RemoveDuplicateConcreteAttributePath(mpAttributePathList);
+        mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().AddReadHandlerInterest(*this);
         mAttributePathExpandIterator = AttributePathExpandIterator(mpAttributePathList);
         err                          = CHIP_NO_ERROR;
     }
@@ -253,6 +253,39 @@ CHIP_ERROR EncodeForRead(TLV::TLVWriter & writer, TLV::Tag tag, FabricIndex acce
 #pragma GCC diagnostic pop
 }
 
+/*
+ * @brief
+ *
+ * Computes the size of the encoding of a value, without encoding it.
+ *
+ * The value is sized as a top-level element, so the tag must be one that is valid there (e.g. TLV::AnonymousTag()).  When the
+ * encoding is larger than maxSize, CHIP_ERROR_BUFFER_TOO_SMALL is returned as soon as this is known, so checking whether a value
+ * fits in the space left in a buffer costs no more than the bytes available.
+ */
+template <typename X>
+CHIP_ERROR EncodedSize(TLV::Tag tag, const X & x, uint32_t & size, uint32_t maxSize = UINT32_MAX)
+{
+    TLV::SizeCalculator calculator(maxSize);
+    ReturnErrorOnFailure(Encode(calculator, tag, x));
+    size = calculator.GetEncodedSize();
+    return CHIP_NO_ERROR;
+}
+
+/*
+ * @brief
+ *
+ * Computes the size of the encoding of a fabric-scoped value for a read, without encoding it.  See EncodedSize().
+ */
+template <typename X>
+CHIP_ERROR EncodedSizeForRead(TLV::Tag tag, FabricIndex accessingFabricIndex, const X & x, uint32_t & size,
+                              uint32_t maxSize = UINT32_MAX)
+{
+    TLV::SizeCalculator calculator(maxSize);
+    ReturnErrorOnFailure(EncodeForRead(calculator, tag, accessingFabricIndex, x));
+    size = calculator.GetEncodedSize();
+    return CHIP_NO_ERROR;
+}
+
 } // namespace DataModel
 } // namespace app
 } // namespace chip
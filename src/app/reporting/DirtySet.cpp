@@ -0,0 +1,371 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/DirtySet.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+#include <new>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+uint8_t DirtySet::ShapeOf(const AttributePathParams & aPath)
+{
+    uint8_t shape = 0;
+    if (aPath.HasWildcardEndpointId())
+    {
+        shape |= kWildcardEndpoint;
+    }
+    if (aPath.HasWildcardClusterId())
+    {
+        shape |= kWildcardCluster;
+    }
+    if (aPath.HasWildcardAttributeId())
+    {
+        shape |= kWildcardAttribute;
+    }
+    return shape;
+}
+
+AttributePathParams DirtySet::WithShape(const AttributePathParams & aPath, uint8_t aShape)
+{
+    AttributePathParams path(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId);
+    if (aShape & kWildcardEndpoint)
+    {
+        path.SetWildcardEndpointId();
+    }
+    if (aShape & kWildcardCluster)
+    {
+        path.SetWildcardClusterId();
+    }
+    if (aShape & kWildcardAttribute)
+    {
+        path.SetWildcardAttributeId();
+    }
+    return path;
+}
+
+size_t DirtySet::HomeSlot(const AttributePathParams & aPath) const
+{
+    uint32_t hash = static_cast<uint32_t>(aPath.mEndpointId) * 0x85EBCA6Bu;
+    hash ^= aPath.mClusterId * 0x9E3779B1u;
+    hash = (hash ^ (hash >> 15)) * 0x2C1B3C6Du;
+    hash ^= aPath.mAttributeId * 0xC2B2AE35u;
+    hash ^= hash >> 16;
+    return hash & (mSlotCount - 1);
+}
+
+const DirtySet::Slot * DirtySet::Find(const AttributePathParams & aPath) const
+{
+    // The table is never more than half full, so there is always a free slot to end the probe.
+    for (size_t index = HomeSlot(aPath); !mSlots[index].IsFree(); index = (index + 1) & (mSlotCount - 1))
+    {
+        if (mSlots[index].mPath == aPath)
+        {
+            return &mSlots[index];
+        }
+    }
+    return nullptr;
+}
+
+DirtySet::Slot * DirtySet::Find(const AttributePathParams & aPath)
+{
+    return const_cast<Slot *>(static_cast<const DirtySet *>(this)->Find(aPath));
+}
+
+DirtySet::Slot * DirtySet::FindCovering(const AttributePathParams & aPath)
+{
+    const uint8_t shape = ShapeOf(aPath);
+    for (uint8_t candidate = 0; candidate < kShapeCount; candidate++)
+    {
+        if ((candidate & shape) != shape || mShapeCount[candidate] == 0)
+        {
+            continue;
+        }
+        Slot * slot = Find(WithShape(aPath, candidate));
+        if (slot != nullptr)
+        {
+            return slot;
+        }
+    }
+    return nullptr;
+}
+
+void DirtySet::Store(const AttributePathParams & aPath, uint64_t aGeneration)
+{
+    size_t index = HomeSlot(aPath);
+    while (!mSlots[index].IsFree())
+    {
+        index = (index + 1) & (mSlotCount - 1);
+    }
+    mSlots[index].mPath       = aPath;
+    mSlots[index].mGeneration = aGeneration;
+
+    mShapeCount[ShapeOf(aPath)]++;
+    if (++mCount > mStats.mHighWaterMark)
+    {
+        mStats.mHighWaterMark = mCount;
+    }
+}
+
+void DirtySet::Erase(size_t aSlotIndex)
+{
+    mShapeCount[ShapeOf(mSlots[aSlotIndex].mPath)]--;
+    mCount--;
+
+    // Backward-shift deletion: move later entries of the probe sequence into the hole, so lookups never need tombstones.
+    size_t hole = aSlotIndex;
+    size_t next = aSlotIndex;
+    mSlots[hole].mGeneration = 0;
+    while (true)
+    {
+        next = (next + 1) & (mSlotCount - 1);
+        if (mSlots[next].IsFree())
+        {
+            return;
+        }
+
+        // The entry can only move into the hole if its home slot is not cyclically within (hole, next].
+        size_t home      = HomeSlot(mSlots[next].mPath);
+        bool homeBetween = (hole <= next) ? (hole < home && home <= next) : (hole < home || home <= next);
+        if (homeBetween)
+        {
+            continue;
+        }
+
+        mSlots[hole]             = mSlots[next];
+        mSlots[next].mGeneration = 0;
+        hole                     = next;
+    }
+}
+
+bool DirtySet::Grow()
+{
+    VerifyOrReturnValue(mMem != ObjectPoolMem::kInline, false);
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    const size_t slotCount = 2 * mSlotCount;
+    auto * slots           = static_cast<Slot *>(Platform::MemoryAlloc(slotCount * sizeof(Slot)));
+    VerifyOrReturnValue(slots != nullptr, false);
+    for (size_t index = 0; index < slotCount; index++)
+    {
+        new (&slots[index]) Slot();
+    }
+
+    Slot * oldSlots           = mSlots;
+    const size_t oldSlotCount = mSlotCount;
+    mSlots                    = slots;
+    mSlotCount                = slotCount;
+    mCount                    = 0;
+    for (auto & count : mShapeCount)
+    {
+        count = 0;
+    }
+    for (size_t index = 0; index < oldSlotCount; index++)
+    {
+        if (!oldSlots[index].IsFree())
+        {
+            Store(oldSlots[index].mPath, oldSlots[index].mGeneration);
+        }
+    }
+    if (oldSlots != mInlineSlots)
+    {
+        Platform::MemoryFree(oldSlots);
+    }
+    return true;
+#else
+    return false;
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+}
+
+size_t DirtySet::DropPathsCoveredBy(const AttributePathParams & aPath)
+{
+    size_t dropped = 0;
+    size_t index   = 0;
+    while (index < mSlotCount)
+    {
+        if (!mSlots[index].IsFree() && aPath.IsAttributePathSupersetOf(mSlots[index].mPath))
+        {
+            // Erasing shifts a later entry into this slot, look at it again.
+            Erase(index);
+            dropped++;
+            continue;
+        }
+        index++;
+    }
+    return dropped;
+}
+
+bool DirtySet::CoalesceUnder(uint8_t aWildcardBits)
+{
+    bool merged  = false;
+    size_t index = 0;
+    while (index < mSlotCount)
+    {
+        const Slot & slot = mSlots[index];
+        if (slot.IsFree())
+        {
+            index++;
+            continue;
+        }
+
+        const AttributePathParams group = WithShape(slot.mPath, static_cast<uint8_t>(ShapeOf(slot.mPath) | aWildcardBits));
+        if (group == slot.mPath)
+        {
+            index++;
+            continue;
+        }
+
+        if (Find(group) == nullptr)
+        {
+            // Only widen the path if another path falls into the same group, otherwise nothing is saved.
+            bool hasSibling = false;
+            for (size_t other = 0; other < mSlotCount && !hasSibling; other++)
+            {
+                hasSibling = other != index && !mSlots[other].IsFree() &&
+                    WithShape(mSlots[other].mPath, static_cast<uint8_t>(ShapeOf(mSlots[other].mPath) | aWildcardBits)) == group;
+            }
+            if (!hasSibling)
+            {
+                index++;
+                continue;
+            }
+        }
+
+        // Erasing shifts a later entry into this slot, so look at it again, and may move the group path: find it again.
+        const uint64_t generation = slot.mGeneration;
+        Erase(index);
+        Slot * groupSlot = Find(group);
+        if (groupSlot == nullptr)
+        {
+            Store(group, generation);
+        }
+        else if (groupSlot->mGeneration < generation)
+        {
+            groupSlot->mGeneration = generation;
+        }
+        merged = true;
+    }
+    return merged;
+}
+
+bool DirtySet::Merge(const AttributePathParams & aPath, uint64_t aGeneration)
+{
+    const AttributePathParams path = WithShape(aPath, ShapeOf(aPath));
+
+    Slot * covering = FindCovering(path);
+    if (covering != nullptr)
+    {
+        covering->mGeneration = std::max(covering->mGeneration, aGeneration);
+        mStats.mDedupCount++;
+        return true;
+    }
+
+    VerifyOrReturnValue(path.IsWildcardPath(), false);
+    const size_t dropped = DropPathsCoveredBy(path);
+    VerifyOrReturnValue(dropped > 0, false);
+    mStats.mSubsumedCount += static_cast<uint32_t>(dropped);
+    Store(path, aGeneration);
+    return true;
+}
+
+CHIP_ERROR DirtySet::Insert(const AttributePathParams & aPath, uint64_t aGeneration)
+{
+    VerifyOrReturnError(aGeneration != 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(!Merge(aPath, aGeneration), CHIP_NO_ERROR);
+
+    const AttributePathParams path = WithShape(aPath, ShapeOf(aPath));
+    if (Exhausted() && !Grow())
+    {
+        if (CoalesceUnder(kWildcardAttribute))
+        {
+            mStats.mClusterMergeCount++;
+        }
+        else if (CoalesceUnder(kWildcardCluster | kWildcardAttribute))
+        {
+            mStats.mEndpointMergeCount++;
+        }
+        else
+        {
+            ChipLogDetail(DataManagement, "Global dirty set pool exhausted, merge all paths.");
+            uint64_t newestGeneration = aGeneration;
+            ForEachPath([&newestGeneration](const AttributePathParams &, uint64_t generation) {
+                newestGeneration = std::max(newestGeneration, generation);
+                return Loop::Continue;
+            });
+            ReleaseAll();
+            Store(AttributePathParams(), newestGeneration);
+            mStats.mFullMergeCount++;
+        }
+
+        Slot * covering = FindCovering(path);
+        if (covering != nullptr)
+        {
+            covering->mGeneration = std::max(covering->mGeneration, aGeneration);
+            return CHIP_NO_ERROR;
+        }
+    }
+
+    Store(path, aGeneration);
+    return CHIP_NO_ERROR;
+}
+
+bool DirtySet::IsDirtySince(const ConcreteAttributePath & aPath, uint64_t aGeneration) const
+{
+    const AttributePathParams path(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId);
+    for (uint8_t shape = 0; shape < kShapeCount; shape++)
+    {
+        if (mShapeCount[shape] == 0)
+        {
+            continue;
+        }
+        const Slot * slot = Find(WithShape(path, shape));
+        if (slot != nullptr && slot->mGeneration > aGeneration)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void DirtySet::ReleaseAll()
+{
+    if (mSlots != mInlineSlots)
+    {
+        Platform::MemoryFree(mSlots);
+        mSlots     = mInlineSlots;
+        mSlotCount = kSlotCount;
+    }
+    for (auto & slot : mInlineSlots)
+    {
+        slot.mGeneration = 0;
+    }
+    for (auto & count : mShapeCount)
+    {
+        count = 0;
+    }
+    mCount = 0;
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
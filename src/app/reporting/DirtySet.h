@@ -0,0 +1,204 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the set of attribute paths marked dirty for reporting.
+ *
+ */
+
+#pragma once
+
+#include <app/AttributePathParams.h>
+#include <app/ConcreteAttributePath.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/Iterators.h>
+#include <lib/support/Pool.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+namespace internal {
+// Smallest power of two keeping the load factor of a full dirty set at or below 1/2.
+constexpr size_t DirtySetSlotCount(size_t aCapacity, size_t aCount = 2)
+{
+    return aCount >= 2 * aCapacity ? aCount : DirtySetSlotCount(aCapacity, aCount * 2);
+}
+} // namespace internal
+
+/**
+ *  @class DirtySet
+ *
+ *  @brief The set of attribute paths marked dirty since the read handlers last reported them.
+ *
+ *  Paths live in a small open-addressed hash table keyed by (endpoint, cluster, attribute), where any of the three
+ *  may be a wildcard. The number of paths of each wildcard "shape" is tracked, so that checking whether a path is
+ *  already covered by a wider one, or whether a concrete path is dirty, only probes the shapes that are present:
+ *  at most 8 probes regardless of the number of dirty paths.
+ *
+ *  Inserting a wildcard path drops the paths it covers. Like ObjectPool, the set either holds at most
+ *  CHIP_IM_SERVER_MAX_NUM_DIRTY_SET paths inline (ObjectPoolMem::kInline), or grows its table on the heap
+ *  (ObjectPoolMem::kHeap). When the set is full and cannot grow, paths are coalesced hierarchically: first every
+ *  cluster holding several dirty attributes is replaced by a cluster wildcard, then every endpoint holding several
+ *  dirty paths by an endpoint wildcard, and as a last resort the whole set by a single wildcard path. These
+ *  coalescing passes are quadratic in the number of paths, but only run when the set is full.
+ *
+ *  List indices are not tracked: a dirty list item marks the whole attribute dirty, which is what gets reported.
+ */
+class DirtySet
+{
+public:
+    struct Stats
+    {
+        /// Largest number of paths held at once.
+        size_t mHighWaterMark = 0;
+        /// Number of inserted paths which were already covered by a path in the set.
+        uint32_t mDedupCount = 0;
+        /// Number of paths dropped because a newly inserted wildcard path covered them.
+        uint32_t mSubsumedCount = 0;
+        /// Number of times a full set was coalesced into cluster wildcards.
+        uint32_t mClusterMergeCount = 0;
+        /// Number of times a full set was coalesced into endpoint wildcards.
+        uint32_t mEndpointMergeCount = 0;
+        /// Number of times a full set was replaced by a single wildcard path.
+        uint32_t mFullMergeCount = 0;
+    };
+
+    explicit DirtySet(ObjectPoolMem aMem = ObjectPoolMem::kDefault) : mMem(aMem) {}
+    ~DirtySet() { ReleaseAll(); }
+
+    DirtySet(const DirtySet &)             = delete;
+    DirtySet & operator=(const DirtySet &) = delete;
+
+    /**
+     * Mark aPath dirty at aGeneration. aGeneration must not be 0.
+     *
+     * @retval #CHIP_NO_ERROR On success, including when the path was merged into a wider path.
+     * @retval #CHIP_ERROR_INVALID_ARGUMENT If aGeneration is 0.
+     */
+    CHIP_ERROR Insert(const AttributePathParams & aPath, uint64_t aGeneration);
+
+    /**
+     * Mark aPath dirty at aGeneration only if it overlaps a path of the set: if a path of the set covers aPath, that path
+     * is marked dirty at aGeneration, and if aPath covers paths of the set, aPath replaces them.
+     *
+     * Returns whether aPath was merged. aGeneration must not be 0.
+     */
+    bool Merge(const AttributePathParams & aPath, uint64_t aGeneration);
+
+    /**
+     * Returns whether a path in the set covering aPath has been marked dirty after aGeneration.
+     */
+    bool IsDirtySince(const ConcreteAttributePath & aPath, uint64_t aGeneration) const;
+
+    /**
+     * Remove every path, and release the heap storage of the set, if any.
+     */
+    void ReleaseAll();
+
+    size_t Allocated() const { return mCount; }
+    bool Exhausted() const { return mCount >= Capacity(); }
+
+    /**
+     * Invoke aFunction(const AttributePathParams &, uint64_t aGeneration) for every path in the set.
+     */
+    template <typename Function>
+    Loop ForEachPath(Function && aFunction) const
+    {
+        for (size_t index = 0; index < mSlotCount; index++)
+        {
+            const Slot & slot = mSlots[index];
+            if (slot.IsFree())
+            {
+                continue;
+            }
+            if (aFunction(slot.mPath, slot.mGeneration) == Loop::Break)
+            {
+                return Loop::Break;
+            }
+        }
+        return Loop::Finish;
+    }
+
+    const Stats & GetStats() const { return mStats; }
+
+    /**
+     * Clear the counters, and restart the high-water mark from the current size.
+     */
+    void ResetStats()
+    {
+        mStats                = Stats();
+        mStats.mHighWaterMark = mCount;
+    }
+
+private:
+    static constexpr size_t kCapacity = CHIP_IM_SERVER_MAX_NUM_DIRTY_SET;
+    static_assert(kCapacity > 0, "CHIP_IM_SERVER_MAX_NUM_DIRTY_SET must not be 0");
+
+    static constexpr size_t kSlotCount = internal::DirtySetSlotCount(kCapacity);
+
+    // Bits of a path shape: which of endpoint, cluster and attribute are wildcards.
+    static constexpr uint8_t kWildcardEndpoint  = 0x1;
+    static constexpr uint8_t kWildcardCluster   = 0x2;
+    static constexpr uint8_t kWildcardAttribute = 0x4;
+    static constexpr uint8_t kShapeCount        = 8;
+
+    struct Slot
+    {
+        AttributePathParams mPath;
+        // Generations start at 1, 0 marks a free slot.
+        uint64_t mGeneration = 0;
+
+        bool IsFree() const { return mGeneration == 0; }
+    };
+
+    static uint8_t ShapeOf(const AttributePathParams & aPath);
+    static AttributePathParams WithShape(const AttributePathParams & aPath, uint8_t aShape);
+
+    // The number of paths the current table holds at or below its load factor of 1/2.
+    size_t Capacity() const { return (mSlots == mInlineSlots) ? kCapacity : mSlotCount / 2; }
+    bool Grow();
+
+    size_t HomeSlot(const AttributePathParams & aPath) const;
+
+    Slot * Find(const AttributePathParams & aPath);
+    const Slot * Find(const AttributePathParams & aPath) const;
+    Slot * FindCovering(const AttributePathParams & aPath);
+    void Store(const AttributePathParams & aPath, uint64_t aGeneration);
+    void Erase(size_t aSlotIndex);
+
+    size_t DropPathsCoveredBy(const AttributePathParams & aPath);
+    bool CoalesceUnder(uint8_t aWildcardBits);
+
+    Slot mInlineSlots[kSlotCount];
+    Slot * mSlots                   = mInlineSlots;
+    size_t mSlotCount               = kSlotCount;
+    const ObjectPoolMem mMem;
+    size_t mCount                   = 0;
+    size_t mShapeCount[kShapeCount] = {};
+    Stats mStats;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
@@ -27,6 +27,8 @@
 #include <access/AccessControl.h>
 #include <app/MessageDef/ReportDataMessage.h>
 #include <app/ReadHandler.h>
+#include <app/reporting/DirtySet.h>
+#include <app/reporting/ReadHandlerInterestIndex.h>
 #include <app/util/basic-types.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CodeUtils.h>
@@ -95,6 +97,18 @@ public:
      */
     CHIP_ERROR SetDirty(AttributePathParams & aAttributePathParams);
 
+    /**
+     * Index the attribute paths of the given ReadHandler so SetDirty can find it without scanning every handler.
+     * Must be called once the handler's attribute path list is final.
+     */
+    void AddReadHandlerInterest(ReadHandler & aReadHandler);
+
+    /**
+     * Drop the attribute paths of the given ReadHandler from the interest index. Must be called before the handler's
+     * attribute path list is released.
+     */
+    void RemoveReadHandlerInterest(ReadHandler & aReadHandler);
+
     /**
      * @brief
      *  Schedule the event delivery
@@ -136,8 +150,21 @@ public:
      */
     void ScheduleUrgentEventDeliverySync(Optional<FabricIndex> fabricIndex = NullOptional);
 
+    /**
+     * Returns the high-water mark and merge counters of the global dirty set.
+     */
+    const DirtySet::Stats & GetDirtySetStats() const { return mGlobalDirtySet.GetStats(); }
+    void ResetDirtySetStats() { mGlobalDirtySet.ResetStats(); }
+
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     size_t GetGlobalDirtySetSize() { return mGlobalDirtySet.Allocated(); }
+    size_t GetGlobalDirtySetHighWaterMark() { return mGlobalDirtySet.GetStats().mHighWaterMark; }
+    uint32_t GetGlobalDirtySetMergeCount()
+    {
+        const DirtySet::Stats & stats = mGlobalDirtySet.GetStats();
+        return stats.mClusterMergeCount + stats.mEndpointMergeCount + stats.mFullMergeCount;
+    }
+    size_t GetInterestIndexSize() const { return mInterestIndex.Allocated(); }
 #endif
 
 private:
@@ -151,13 +178,6 @@ private:
 
     bool IsRunScheduled() const { return mRunScheduled; }
 
-    struct AttributePathParamsWithGeneration : public AttributePathParams
-    {
-        AttributePathParamsWithGeneration() {}
-        AttributePathParamsWithGeneration(const AttributePathParams aPath) : AttributePathParams(aPath) {}
-        uint64_t mGeneration = 0;
-    };
-
     /**
      * Build Single Report Data including attribute changes and event data stream, and send out
      *
@@ -204,29 +224,6 @@ private:
      */
     bool MergeOverlappedAttributePath(const AttributePathParams & aAttributePath);
 
-    /**
-     * If we are running out of ObjectPool for the global dirty set, we will try to merge the existing items by clusters.
-     *
-     * Returns whether we have released any paths.
-     */
-    bool MergeDirtyPathsUnderSameCluster();
-
-    /**
-     * If we are running out of ObjectPool for the global dirty set and we cannot find a slot after merging the existing items by
-     * clusters, we will try to merge the existing items by endpoints.
-     *
-     * Returns whether we have released any paths.
-     */
-    bool MergeDirtyPathsUnderSameEndpoint();
-
-    /**
-     * During the iterating of the paths, releasing the object in the inner loop will cause undefined behavior of the ObjectPool, so
-     * we replace the items to be cleared by a tomb first, then clear all the tombs after the iteration.
-     *
-     * Returns whether we have released any paths.
-     */
-    bool ClearTombPaths();
-
     CHIP_ERROR InsertPathIntoDirtySet(const AttributePathParams & aAttributePath);
 
     inline void BumpDirtySetGeneration() { mDirtyGeneration++; }
@@ -256,16 +253,25 @@ private:
     ReadHandler * mRunningReadHandler = nullptr;
 
     /**
-     *  mGlobalDirtySet is used to track the set of attribute/event paths marked dirty for reporting purposes.
+     *  mGlobalDirtySet is used to track the set of attribute paths marked dirty for reporting purposes.
      *
      */
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     // For unit tests, always use inline allocation for code coverage.
-    ObjectPool<AttributePathParamsWithGeneration, CHIP_IM_SERVER_MAX_NUM_DIRTY_SET, ObjectPoolMem::kInline> mGlobalDirtySet;
+    DirtySet mGlobalDirtySet{ ObjectPoolMem::kInline };
 #else
-    ObjectPool<AttributePathParamsWithGeneration, CHIP_IM_SERVER_MAX_NUM_DIRTY_SET> mGlobalDirtySet;
+    DirtySet mGlobalDirtySet;
 #endif
 
+    /**
+     * mInterestIndex maps (endpoint, cluster) to the attribute paths ReadHandlers are interested in.
+     *
+     * ReadHandlers which could not be indexed (index pool exhausted) are flagged with ReadHandlerFlags::UnindexedInterest
+     * and counted in mNumUnindexedReadHandlers; while any exist, SetDirty falls back to scanning every ReadHandler.
+     */
+    ReadHandlerInterestIndex mInterestIndex;
+    uint32_t mNumUnindexedReadHandlers = 0;
+
     /**
      * A generation counter for the dirty attrbute set.
      * ReadHandlers can save the generation value when generating reports.
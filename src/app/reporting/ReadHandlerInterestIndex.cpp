@@ -0,0 +1,72 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/ReadHandler.h>
+#include <app/reporting/ReadHandlerInterestIndex.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+CHIP_ERROR ReadHandlerInterestIndex::AddReadHandler(ReadHandler & aReadHandler)
+{
+    for (auto path = aReadHandler.GetAttributePathList(); path != nullptr; path = path->mpNext)
+    {
+        Entry * entry = mEntryPool.CreateObject(&aReadHandler, &path->mValue);
+        if (entry == nullptr)
+        {
+            RemoveReadHandler(aReadHandler);
+            return CHIP_ERROR_NO_MEMORY;
+        }
+
+        Entry *& bucket = BucketFor(path->mValue);
+        entry->mpNext   = bucket;
+        bucket          = entry;
+    }
+    return CHIP_NO_ERROR;
+}
+
+void ReadHandlerInterestIndex::RemoveReadHandler(const ReadHandler & aReadHandler)
+{
+    for (auto path = aReadHandler.GetAttributePathList(); path != nullptr; path = path->mpNext)
+    {
+        RemoveFromBucket(BucketFor(path->mValue), aReadHandler);
+    }
+}
+
+void ReadHandlerInterestIndex::RemoveFromBucket(Entry *& aBucket, const ReadHandler & aReadHandler)
+{
+    Entry ** link = &aBucket;
+    while (*link != nullptr)
+    {
+        Entry * entry = *link;
+        if (entry->mpReadHandler == &aReadHandler)
+        {
+            *link = entry->mpNext;
+            mEntryPool.ReleaseObject(entry);
+        }
+        else
+        {
+            link = &entry->mpNext;
+        }
+    }
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
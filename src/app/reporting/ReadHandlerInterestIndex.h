@@ -0,0 +1,158 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines an index from (endpoint, cluster) to the ReadHandlers whose attribute
+ *      interest paths can intersect a change on that cluster.
+ *
+ */
+
+#pragma once
+
+#include <app/AttributePathParams.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/Iterators.h>
+#include <lib/support/Pool.h>
+
+namespace chip {
+namespace app {
+
+class ReadHandler;
+
+namespace reporting {
+
+/**
+ *  @class ReadHandlerInterestIndex
+ *
+ *  @brief Tracks the attribute paths every ReadHandler is interested in, bucketed by (endpoint, cluster).
+ *
+ *  Paths with a concrete endpoint and cluster are stored in a hash bucket for that pair, paths with a
+ *  wildcard endpoint or cluster are stored in a single wildcard bucket. A change on a concrete cluster then
+ *  only needs to look at one hash bucket and the wildcard bucket instead of every path of every ReadHandler.
+ *
+ *  The index does not own the paths, it keeps pointers to the nodes of the ReadHandler's attribute path list,
+ *  so a ReadHandler must be removed from the index before its path list is released.
+ */
+class ReadHandlerInterestIndex
+{
+public:
+    /**
+     * Index every attribute path of the given ReadHandler. On failure, nothing is indexed for the handler.
+     *
+     * @retval #CHIP_NO_ERROR On success.
+     * @retval #CHIP_ERROR_NO_MEMORY If the index ran out of entries.
+     */
+    CHIP_ERROR AddReadHandler(ReadHandler & aReadHandler);
+
+    /**
+     * Remove every entry of the given ReadHandler from the index. It is safe to call this for a handler which was
+     * never added.
+     */
+    void RemoveReadHandler(const ReadHandler & aReadHandler);
+
+    /**
+     * Invoke aFunction(ReadHandler *, const AttributePathParams &) for every indexed interest path which may intersect
+     * with aChangedPath. The same ReadHandler may be visited more than once if several of its paths match, and the
+     * visited paths are not guaranteed to intersect with aChangedPath: callers still need to call Intersects().
+     *
+     * A change on a concrete endpoint and cluster only visits one hash bucket and the wildcard bucket, a change with a
+     * wildcard endpoint or cluster visits every entry.
+     */
+    template <typename Function>
+    Loop ForEachCandidate(const AttributePathParams & aChangedPath, Function && aFunction) const
+    {
+        if (!IsConcreteCluster(aChangedPath))
+        {
+            for (const Entry * bucket : mBuckets)
+            {
+                VerifyOrReturnValue(ForEachInBucket(bucket, aFunction) != Loop::Break, Loop::Break);
+            }
+            return ForEachInBucket(mWildcardBucket, aFunction);
+        }
+
+        for (const Entry * entry = mBuckets[BucketIndex(aChangedPath.mEndpointId, aChangedPath.mClusterId)]; entry != nullptr;
+             entry               = entry->mpNext)
+        {
+            if (entry->mpPath->mEndpointId != aChangedPath.mEndpointId || entry->mpPath->mClusterId != aChangedPath.mClusterId)
+            {
+                continue;
+            }
+            VerifyOrReturnValue(aFunction(entry->mpReadHandler, *entry->mpPath) != Loop::Break, Loop::Break);
+        }
+        return ForEachInBucket(mWildcardBucket, aFunction);
+    }
+
+    size_t Allocated() const { return mEntryPool.Allocated(); }
+
+private:
+    struct Entry
+    {
+        Entry(ReadHandler * apReadHandler, const AttributePathParams * apPath) : mpReadHandler(apReadHandler), mpPath(apPath) {}
+
+        ReadHandler * mpReadHandler;
+        const AttributePathParams * mpPath;
+        Entry * mpNext = nullptr;
+    };
+
+    static constexpr size_t kBucketCount = CHIP_IM_SERVER_INTEREST_INDEX_BUCKET_COUNT;
+    static_assert(kBucketCount > 0 && (kBucketCount & (kBucketCount - 1)) == 0,
+                  "CHIP_IM_SERVER_INTEREST_INDEX_BUCKET_COUNT must be a power of two");
+
+    static size_t BucketIndex(EndpointId aEndpointId, ClusterId aClusterId)
+    {
+        // Cluster ids are sparse (vendor prefix in the upper half), fold the upper bits down before mixing.
+        uint32_t key = (aClusterId ^ (aClusterId >> 16)) * 0x9E3779B1u;
+        key ^= static_cast<uint32_t>(aEndpointId) * 0x85EBCA6Bu;
+        return (key >> 16) & (kBucketCount - 1);
+    }
+
+    static bool IsConcreteCluster(const AttributePathParams & aPath)
+    {
+        return !aPath.HasWildcardEndpointId() && !aPath.HasWildcardClusterId();
+    }
+
+    template <typename Function>
+    static Loop ForEachInBucket(const Entry * aBucket, Function & aFunction)
+    {
+        for (const Entry * entry = aBucket; entry != nullptr; entry = entry->mpNext)
+        {
+            VerifyOrReturnValue(aFunction(entry->mpReadHandler, *entry->mpPath) != Loop::Break, Loop::Break);
+        }
+        return Loop::Finish;
+    }
+
+    Entry *& BucketFor(const AttributePathParams & aPath)
+    {
+        return IsConcreteCluster(aPath) ? mBuckets[BucketIndex(aPath.mEndpointId, aPath.mClusterId)] : mWildcardBucket;
+    }
+
+    void RemoveFromBucket(Entry *& aBucket, const ReadHandler & aReadHandler);
+
+    Entry * mBuckets[kBucketCount] = {};
+    Entry * mWildcardBucket        = nullptr;
+
+    ObjectPool<Entry, CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS + CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS>
+        mEntryPool;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
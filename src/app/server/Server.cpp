@@ -99,6 +99,9 @@ static uint8_t sDebugEventBuffer[CHIP_DEVICE_CONFIG_EVENT_LOGGING_DEBUG_BUFFER_S
 static uint8_t sCritEventBuffer[CHIP_DEVICE_CONFIG_EVENT_LOGGING_CRIT_BUFFER_SIZE];
 static ::chip::PersistedCounter<chip::EventNumber> sGlobalEventIdCounter;
 static ::chip::app::CircularEventBuffer sLoggingBuffer[CHIP_NUM_EVENT_LOGGING_BUFFERS];
+#if CHIP_DEVICE_CONFIG_EVENT_LOGGING_INDEX_SIZE
+static ::chip::app::EventIndexEntry sEventIndex[CHIP_NUM_EVENT_LOGGING_BUFFERS][CHIP_DEVICE_CONFIG_EVENT_LOGGING_INDEX_SIZE];
+#endif // CHIP_DEVICE_CONFIG_EVENT_LOGGING_INDEX_SIZE
 #endif // CHIP_CONFIG_ENABLE_SERVER_IM_EVENT
 
 CHIP_ERROR Server::Init(const ServerInitParams & initParams)
@@ -129,6 +132,16 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
     // TODO(16969): Remove chip::Platform::MemoryInit() call from Server class, it belongs to outer code
     chip::Platform::MemoryInit();
 
+    if (initParams.cryptoWorkerCount > 0)
+    {
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+        SuccessOrExit(err = mCryptoWorkQueue.Init(initParams.cryptoWorkerCount));
+        SetCryptoWorkQueue(&mCryptoWorkQueue);
+#else
+        ExitNow(err = CHIP_ERROR_NOT_IMPLEMENTED);
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    }
+
     // Initialize PersistentStorageDelegate-based storage
     mDeviceStorage                 = initParams.persistentStorageDelegate;
     mSessionResumptionStorage      = initParams.sessionResumptionStorage;
@@ -259,10 +272,18 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
             { &sInfoEventBuffer[0], sizeof(sInfoEventBuffer), ::chip::app::PriorityLevel::Info },
             { &sCritEventBuffer[0], sizeof(sCritEventBuffer), ::chip::app::PriorityLevel::Critical }
         };
+#if CHIP_DEVICE_CONFIG_EVENT_LOGGING_INDEX_SIZE
+        for (size_t i = 0; i < ArraySize(logStorageResources); i++)
+        {
+            logStorageResources[i].mpIndex    = sEventIndex[i];
+            logStorageResources[i].mIndexSize = CHIP_DEVICE_CONFIG_EVENT_LOGGING_INDEX_SIZE;
+        }
+#endif // CHIP_DEVICE_CONFIG_EVENT_LOGGING_INDEX_SIZE
 
         chip::app::EventManagement::GetInstance().Init(&mExchangeMgr, CHIP_NUM_EVENT_LOGGING_BUFFERS, &sLoggingBuffer[0],
                                                        &logStorageResources[0], &sGlobalEventIdCounter,
                                                        std::chrono::duration_cast<System::Clock::Milliseconds64>(mInitTimestamp));
+        chip::app::EventManagement::GetInstance().SetEventLogStore(initParams.eventLogStore);
     }
 #endif // CHIP_CONFIG_ENABLE_SERVER_IM_EVENT
 
@@ -597,6 +618,14 @@ void Server::Shutdown()
     app::InteractionModelEngine::GetInstance()->SetICDManager(nullptr);
 #endif // CHIP_CONFIG_ENABLE_ICD_SERVER
     mCommissioningWindowManager.Shutdown();
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    // The CASE and PASE sessions are shut down by now, so the work still queued for them is canceled and is only drained.
+    if (GetCryptoWorkQueue() == &mCryptoWorkQueue)
+    {
+        SetCryptoWorkQueue(nullptr);
+    }
+    mCryptoWorkQueue.Shutdown();
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
     mMessageCounterManager.Shutdown();
     mExchangeMgr.Shutdown();
     mSessions.Shutdown();
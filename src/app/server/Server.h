@@ -25,6 +25,7 @@
 #include <app/CASEClientPool.h>
 #include <app/CASESessionManager.h>
 #include <app/DefaultAttributePersistenceProvider.h>
+#include <app/EventLogStore.h>
 #include <app/FailSafeContext.h>
 #include <app/OperationalSessionSetupPool.h>
 #include <app/SimpleSubscriptionResumptionStorage.h>
@@ -50,6 +51,7 @@
 #include <platform/KeyValueStoreManager.h>
 #include <platform/KvsPersistentStorageDelegate.h>
 #include <protocols/secure_channel/CASEServer.h>
+#include <protocols/secure_channel/CryptoWorkQueue.h>
 #include <protocols/secure_channel/MessageCounterManager.h>
 #include <protocols/secure_channel/PASESession.h>
 #include <protocols/secure_channel/RendezvousParameters.h>
@@ -164,6 +166,13 @@ struct ServerInitParams
     Credentials::OperationalCertificateStore * opCertStore = nullptr;
     // Required, if not provided, the Server::Init() WILL fail.
     app::reporting::ReportScheduler * reportScheduler = nullptr;
+    // Event log store: Optional. Keeps a copy of the logged events, so that readers can catch up on
+    // more events than the event buffers hold. Must be initialized before being provided.
+    app::EventLogStore * eventLogStore = nullptr;
+    // Crypto worker count: Optional. Number of threads running the heavy cryptographic steps of CASE
+    // and PASE session establishment off the CHIP event loop, at most CHIP_CONFIG_CRYPTO_WORKER_MAX.
+    // 0 keeps running them as before. Requires CHIP_SYSTEM_CONFIG_POSIX_LOCKING.
+    uint8_t cryptoWorkerCount = 0;
 };
 
 /**
@@ -621,6 +630,9 @@ private:
     ServerTransportMgr mTransports;
     SessionManager mSessions;
     CASEServer mCASEServer;
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    ThreadPoolCryptoWorkQueue mCryptoWorkQueue;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 
     CASESessionManager mCASESessionManager;
     CASEClientPool<CHIP_CONFIG_DEVICE_MAX_ACTIVE_CASE_CLIENTS> mCASEClientPool;
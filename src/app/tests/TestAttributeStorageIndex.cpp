@@ -0,0 +1,424 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app-common/zap-generated/attribute-type.h>
+#include <app/util/att-storage.h>
+#include <app/util/attribute-storage-index.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <chrono>
+#include <nlunit-test.h>
+#include <vector>
+
+namespace {
+
+using namespace chip;
+using namespace chip::app;
+
+// A bridge-like layout: two fixed endpoints followed by many dynamic endpoints sharing a few endpoint types.
+constexpr uint16_t kFixedEndpointCount     = 2;
+constexpr uint16_t kEndpointCount          = 256;
+constexpr uint8_t kClustersPerType         = 12;
+constexpr uint16_t kAttributesPerCluster   = 16;
+constexpr size_t kEndpointTypeCount        = 3;
+constexpr EndpointId kFirstDynamicEndpoint = 3;
+
+std::vector<EmberAfAttributeMetadata> sAttributes;
+EmberAfCluster sClusters[kEndpointTypeCount][kClustersPerType];
+EmberAfEndpointType sEndpointTypes[kEndpointTypeCount];
+EmberAfDefinedEndpoint sEndpoints[kEndpointCount];
+
+void InitEndpoints()
+{
+    // Reserved up front so that the clusters can point into the vector.
+    sAttributes.clear();
+    sAttributes.reserve(kEndpointTypeCount * kClustersPerType * kAttributesPerCluster);
+
+    for (size_t type = 0; type < kEndpointTypeCount; type++)
+    {
+        uint16_t endpointSize = 0;
+        for (uint8_t c = 0; c < kClustersPerType; c++)
+        {
+            const EmberAfAttributeMetadata * attributes = sAttributes.data() + sAttributes.size();
+            uint16_t clusterSize                        = 0;
+            for (uint16_t a = 0; a < kAttributesPerCluster; a++)
+            {
+                // Every third attribute is external, it does not take space in the cluster storage.
+                const bool external = (a % 3 == 2);
+                sAttributes.push_back(EmberAfAttributeMetadata{
+                    .defaultValue  = EmberAfDefaultOrMinMaxAttributeValue(static_cast<uint32_t>(0)),
+                    .attributeId   = (a == kAttributesPerCluster - 1) ? AttributeId(0xFFFD) : AttributeId(a),
+                    .size          = static_cast<uint16_t>(1 + (a % 4)),
+                    .attributeType = ZCL_INT8U_ATTRIBUTE_TYPE,
+                    .mask          = static_cast<EmberAfAttributeMask>(external ? ATTRIBUTE_MASK_EXTERNAL_STORAGE : 0),
+                });
+                if (!external)
+                {
+                    clusterSize = static_cast<uint16_t>(clusterSize + sAttributes.back().size);
+                }
+            }
+
+            EmberAfCluster & cluster = sClusters[type][c];
+            cluster                  = EmberAfCluster{};
+            cluster.clusterId        = static_cast<ClusterId>(0x0003 + c + type);
+            cluster.attributes       = attributes;
+            cluster.attributeCount   = kAttributesPerCluster;
+            cluster.clusterSize      = clusterSize;
+            // Some client clusters sit in between the server clusters and must be skipped.
+            cluster.mask = (c % 5 == 4) ? CLUSTER_MASK_CLIENT : CLUSTER_MASK_SERVER;
+            endpointSize = static_cast<uint16_t>(endpointSize + clusterSize);
+        }
+        sEndpointTypes[type] = EmberAfEndpointType{ sClusters[type], kClustersPerType, endpointSize };
+    }
+
+    for (uint16_t i = 0; i < kEndpointCount; i++)
+    {
+        sEndpoints[i]              = EmberAfDefinedEndpoint();
+        sEndpoints[i].endpoint     = (i < kFixedEndpointCount) ? i : static_cast<EndpointId>(kFirstDynamicEndpoint + i);
+        sEndpoints[i].endpointType = &sEndpointTypes[i % kEndpointTypeCount];
+        sEndpoints[i].bitmask.Set(EmberAfEndpointOptions::isEnabled);
+    }
+}
+
+// Reference lookup, doing the same scans as attribute-storage.cpp does without the index.
+struct LinearLookupResult
+{
+    uint16_t endpointIndex                     = AttributeStorageIndex::kInvalidEndpointIndex;
+    const EmberAfCluster * cluster             = nullptr;
+    const EmberAfAttributeMetadata * attribute = nullptr;
+    uint8_t serverClusterIndex                 = 0;
+    uint16_t storageOffset                     = 0;
+};
+
+LinearLookupResult LinearLookup(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId)
+{
+    LinearLookupResult result;
+    uint16_t offset = 0;
+    for (uint16_t ep = 0; ep < kEndpointCount; ep++)
+    {
+        const EmberAfEndpointType * type = sEndpoints[ep].endpointType;
+        if (sEndpoints[ep].endpoint != endpoint)
+        {
+            if (ep < kFixedEndpointCount)
+            {
+                offset = static_cast<uint16_t>(offset + type->endpointSize);
+            }
+            continue;
+        }
+
+        result.endpointIndex = ep;
+        uint8_t serverIndex  = 0;
+        for (uint8_t c = 0; c < type->clusterCount; c++)
+        {
+            const EmberAfCluster * cluster = &type->cluster[c];
+            if ((cluster->mask & CLUSTER_MASK_SERVER) == 0 || cluster->clusterId != clusterId)
+            {
+                serverIndex = static_cast<uint8_t>(serverIndex + ((cluster->mask & CLUSTER_MASK_SERVER) ? 1 : 0));
+                offset      = static_cast<uint16_t>(offset + cluster->clusterSize);
+                continue;
+            }
+
+            result.cluster            = cluster;
+            result.serverClusterIndex = serverIndex;
+            for (uint16_t a = 0; a < cluster->attributeCount; a++)
+            {
+                const EmberAfAttributeMetadata * attribute = &cluster->attributes[a];
+                if (attribute->attributeId == attributeId)
+                {
+                    result.attribute     = attribute;
+                    result.storageOffset = offset;
+                    return result;
+                }
+                if (!attribute->IsExternal() && !attribute->IsSingleton())
+                {
+                    offset = static_cast<uint16_t>(offset + attribute->size);
+                }
+            }
+            return result;
+        }
+        return result;
+    }
+    return result;
+}
+
+LinearLookupResult IndexedLookup(const AttributeStorageIndex & index, EndpointId endpoint, ClusterId clusterId,
+                                 AttributeId attributeId)
+{
+    LinearLookupResult result;
+    uint16_t endpointOffset = 0;
+    result.endpointIndex    = index.FindEndpointIndex(endpoint, &endpointOffset);
+    if (result.endpointIndex == AttributeStorageIndex::kInvalidEndpointIndex)
+    {
+        return result;
+    }
+
+    AttributeStorageIndex::ClusterLocation clusterLocation;
+    result.cluster = index.FindServerCluster(sEndpoints[result.endpointIndex].endpointType, clusterId, &clusterLocation);
+    if (result.cluster == nullptr)
+    {
+        return result;
+    }
+    result.serverClusterIndex = clusterLocation.serverClusterIndex;
+
+    AttributeStorageIndex::AttributeLocation attributeLocation;
+    result.attribute = index.FindAttribute(result.cluster, attributeId, &attributeLocation);
+    if (result.attribute != nullptr)
+    {
+        result.storageOffset =
+            static_cast<uint16_t>(endpointOffset + clusterLocation.storageOffset + attributeLocation.storageOffset);
+    }
+    return result;
+}
+
+bool SameResult(const LinearLookupResult & a, const LinearLookupResult & b)
+{
+    if (a.endpointIndex != b.endpointIndex || a.cluster != b.cluster || a.attribute != b.attribute)
+    {
+        return false;
+    }
+    if (a.cluster != nullptr && a.serverClusterIndex != b.serverClusterIndex)
+    {
+        return false;
+    }
+    return a.attribute == nullptr || a.storageOffset == b.storageOffset;
+}
+
+// Looks up a range of endpoint, cluster and attribute ids through the index and through LinearLookup(), and returns the
+// number of lookups with different results. aFound is set to the number of attributes found.
+size_t CountMismatches(const AttributeStorageIndex & index, size_t & aFound)
+{
+    size_t mismatches = 0;
+    aFound            = 0;
+    for (uint16_t ep = 0; ep < kEndpointCount + 4; ep++)
+    {
+        const EndpointId endpoint = (ep < kFixedEndpointCount) ? ep : static_cast<EndpointId>(kFirstDynamicEndpoint + ep);
+        // Cluster ids one past either end are never present, and client clusters must not be found.
+        for (ClusterId clusterId = 0x0002; clusterId <= 0x0003 + kClustersPerType + kEndpointTypeCount; clusterId++)
+        {
+            for (AttributeId attributeId : { AttributeId(0), AttributeId(5), AttributeId(kAttributesPerCluster - 2),
+                                             AttributeId(kAttributesPerCluster - 1), AttributeId(0xFFFD) })
+            {
+                LinearLookupResult expected = LinearLookup(endpoint, clusterId, attributeId);
+                if (!SameResult(expected, IndexedLookup(index, endpoint, clusterId, attributeId)))
+                {
+                    mismatches++;
+                }
+                if (expected.attribute != nullptr)
+                {
+                    aFound++;
+                }
+            }
+        }
+    }
+    return mismatches;
+}
+
+void TestLookupMatchesLinearScan(nlTestSuite * apSuite, void * apContext)
+{
+    InitEndpoints();
+
+    AttributeStorageIndex index;
+    NL_TEST_ASSERT(apSuite, index.NeedsBuild());
+    NL_TEST_ASSERT(apSuite, index.Build(Span<const EmberAfDefinedEndpoint>(sEndpoints), kFixedEndpointCount) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, index.IsBuilt());
+
+    for (size_t type = 0; type < kEndpointTypeCount; type++)
+    {
+        NL_TEST_ASSERT(apSuite, index.ContainsEndpointType(&sEndpointTypes[type]));
+    }
+    EmberAfEndpointType unusedType = sEndpointTypes[0];
+    NL_TEST_ASSERT(apSuite, !index.ContainsEndpointType(&unusedType));
+
+    size_t found = 0;
+    NL_TEST_ASSERT(apSuite, CountMismatches(index, found) == 0);
+    NL_TEST_ASSERT(apSuite, found > 0);
+    NL_TEST_ASSERT(apSuite, index.FindEndpointIndex(kInvalidEndpointId) == AttributeStorageIndex::kInvalidEndpointIndex);
+}
+
+void TestRebuildAfterEndpointChange(nlTestSuite * apSuite, void * apContext)
+{
+    InitEndpoints();
+
+    AttributeStorageIndex index;
+    NL_TEST_ASSERT(apSuite, index.Build(Span<const EmberAfDefinedEndpoint>(sEndpoints), kFixedEndpointCount) == CHIP_NO_ERROR);
+
+    const uint16_t clearedIndex = kEndpointCount / 2;
+    const EndpointId cleared    = sEndpoints[clearedIndex].endpoint;
+    NL_TEST_ASSERT(apSuite, index.FindEndpointIndex(cleared) == clearedIndex);
+
+    // Clearing a dynamic endpoint, as emberAfClearDynamicEndpoint does, is only seen once the index is rebuilt.
+    sEndpoints[clearedIndex].endpoint = kInvalidEndpointId;
+    index.Invalidate();
+    NL_TEST_ASSERT(apSuite, index.NeedsBuild());
+    NL_TEST_ASSERT(apSuite, index.FindEndpointIndex(cleared) == AttributeStorageIndex::kInvalidEndpointIndex);
+
+    NL_TEST_ASSERT(apSuite, index.Build(Span<const EmberAfDefinedEndpoint>(sEndpoints), kFixedEndpointCount) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, index.FindEndpointIndex(cleared) == AttributeStorageIndex::kInvalidEndpointIndex);
+
+    // Reusing the slot for a new endpoint id, as emberAfSetDynamicEndpoint does.
+    const EndpointId added                = 0x4000;
+    sEndpoints[clearedIndex].endpoint     = added;
+    sEndpoints[clearedIndex].endpointType = &sEndpointTypes[0];
+    index.Invalidate();
+    NL_TEST_ASSERT(apSuite, index.Build(Span<const EmberAfDefinedEndpoint>(sEndpoints), kFixedEndpointCount) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, index.FindEndpointIndex(added) == clearedIndex);
+    NL_TEST_ASSERT(apSuite,
+                   index.FindServerCluster(&sEndpointTypes[0], sClusters[0][0].clusterId) == &sClusters[0][0]);
+}
+
+void TestIncrementalEndpointChanges(nlTestSuite * apSuite, void * apContext)
+{
+    InitEndpoints();
+    for (uint16_t i = kFixedEndpointCount; i < kEndpointCount; i++)
+    {
+        sEndpoints[i].endpoint = kInvalidEndpointId;
+    }
+
+    AttributeStorageIndex index;
+    size_t builds = 0;
+    size_t found  = 0;
+
+    // Rebuilds the index when needed, as attribute-storage.cpp does on lookups.
+    auto ensureBuilt = [&]() {
+        if (index.NeedsBuild())
+        {
+            builds++;
+            NL_TEST_ASSERT(apSuite,
+                           index.Build(Span<const EmberAfDefinedEndpoint>(sEndpoints), kFixedEndpointCount) == CHIP_NO_ERROR);
+        }
+    };
+
+    // Setting up dynamic endpoints one at a time, as emberAfSetDynamicEndpoint does, with a lookup after each of them. The
+    // index only needs rebuilding when it runs out of room, which happens less and less often.
+    for (uint16_t i = kFixedEndpointCount; i < kEndpointCount; i++)
+    {
+        ensureBuilt();
+        sEndpoints[i].endpoint = static_cast<EndpointId>(kFirstDynamicEndpoint + i);
+        index.AddEndpoint(Span<const EmberAfDefinedEndpoint>(sEndpoints), i);
+        ensureBuilt();
+        NL_TEST_ASSERT(apSuite, index.FindEndpointIndex(sEndpoints[i].endpoint) == i);
+    }
+    NL_TEST_ASSERT(apSuite, builds <= 8);
+    NL_TEST_ASSERT(apSuite, CountMismatches(index, found) == 0);
+    NL_TEST_ASSERT(apSuite, found > 0);
+
+    // Clearing every other dynamic endpoint, as emberAfClearDynamicEndpoint does, keeps the index as long as every endpoint
+    // type is still in use.
+    builds = 0;
+    for (uint16_t i = kFixedEndpointCount; i < kEndpointCount; i += 2)
+    {
+        index.RemoveEndpoint(Span<const EmberAfDefinedEndpoint>(sEndpoints), i);
+        sEndpoints[i].endpoint = kInvalidEndpointId;
+        ensureBuilt();
+    }
+    NL_TEST_ASSERT(apSuite, builds == 0);
+    NL_TEST_ASSERT(apSuite, CountMismatches(index, found) == 0);
+
+    // An endpoint with an endpoint type of its own brings in its clusters, and takes them away when it is cleared.
+    EmberAfEndpointType ownType         = sEndpointTypes[0];
+    const uint16_t ownIndex             = kFixedEndpointCount;
+    const EmberAfEndpointType * oldType = sEndpoints[ownIndex].endpointType;
+    sEndpoints[ownIndex].endpoint       = static_cast<EndpointId>(kFirstDynamicEndpoint + ownIndex);
+    sEndpoints[ownIndex].endpointType   = &ownType;
+    index.AddEndpoint(Span<const EmberAfDefinedEndpoint>(sEndpoints), ownIndex);
+    ensureBuilt();
+    NL_TEST_ASSERT(apSuite, index.ContainsEndpointType(&ownType));
+    NL_TEST_ASSERT(apSuite, CountMismatches(index, found) == 0);
+
+    index.RemoveEndpoint(Span<const EmberAfDefinedEndpoint>(sEndpoints), ownIndex);
+    NL_TEST_ASSERT(apSuite, index.NeedsBuild());
+    sEndpoints[ownIndex].endpoint     = kInvalidEndpointId;
+    sEndpoints[ownIndex].endpointType = oldType;
+    ensureBuilt();
+    NL_TEST_ASSERT(apSuite, !index.ContainsEndpointType(&ownType));
+    NL_TEST_ASSERT(apSuite, CountMismatches(index, found) == 0);
+}
+
+void TestLookupBenchmark(nlTestSuite * apSuite, void * apContext)
+{
+    InitEndpoints();
+
+    AttributeStorageIndex index;
+    NL_TEST_ASSERT(apSuite, index.Build(Span<const EmberAfDefinedEndpoint>(sEndpoints), kFixedEndpointCount) == CHIP_NO_ERROR);
+
+    constexpr size_t kRounds = 20;
+    size_t lookups           = 0;
+    size_t linearHits        = 0;
+    size_t indexedHits       = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < kRounds; round++)
+    {
+        for (uint16_t ep = kFixedEndpointCount; ep < kEndpointCount; ep++)
+        {
+            const EmberAfCluster & cluster = sClusters[ep % kEndpointTypeCount][kClustersPerType - 1];
+            linearHits += LinearLookup(sEndpoints[ep].endpoint, cluster.clusterId, 0xFFFD).attribute != nullptr;
+            lookups++;
+        }
+    }
+    auto linear = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < kRounds; round++)
+    {
+        for (uint16_t ep = kFixedEndpointCount; ep < kEndpointCount; ep++)
+        {
+            const EmberAfCluster & cluster = sClusters[ep % kEndpointTypeCount][kClustersPerType - 1];
+            indexedHits += IndexedLookup(index, sEndpoints[ep].endpoint, cluster.clusterId, 0xFFFD).attribute != nullptr;
+        }
+    }
+    auto indexed = std::chrono::steady_clock::now() - start;
+
+    NL_TEST_ASSERT(apSuite, linearHits == indexedHits);
+    ChipLogProgress(DataManagement, "%u endpoints, %u lookups: linear scan %u ns/lookup, index %u ns/lookup",
+                    static_cast<unsigned>(kEndpointCount), static_cast<unsigned>(lookups),
+                    static_cast<unsigned>(std::chrono::duration_cast<std::chrono::nanoseconds>(linear).count() / lookups),
+                    static_cast<unsigned>(std::chrono::duration_cast<std::chrono::nanoseconds>(indexed).count() / lookups));
+}
+
+int TestSetup(void * inContext)
+{
+    return (Platform::MemoryInit() == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+int TestTeardown(void * inContext)
+{
+    Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = { NL_TEST_DEF("TestLookupMatchesLinearScan", TestLookupMatchesLinearScan),
+                                 NL_TEST_DEF("TestRebuildAfterEndpointChange", TestRebuildAfterEndpointChange),
+                                 NL_TEST_DEF("TestIncrementalEndpointChanges", TestIncrementalEndpointChanges),
+                                 NL_TEST_DEF("TestLookupBenchmark", TestLookupBenchmark), NL_TEST_SENTINEL() };
+
+int TestAttributeStorageIndex()
+{
+    nlTestSuite theSuite = { "AttributeStorageIndex", &sTests[0], TestSetup, TestTeardown };
+
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestAttributeStorageIndex)
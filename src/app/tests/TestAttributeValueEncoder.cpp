@@ -31,8 +31,10 @@
 #include <lib/core/TLVWriter.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
 #include <nlunit-test.h>
 
+#include <chrono>
 #include <optional>
 
 using namespace chip;
@@ -866,6 +868,111 @@ void TestEncodeFabricFilteredListOfPreEncoded(nlTestSuite * aSuite, void * aCont
 
 #undef VERIFY_BUFFER_STATE
 
+// Counts the list items encoded in the AttributeReportIBs of a chunk: the items of the initial list, then one per report.
+size_t CountEncodedListItems(nlTestSuite * aSuite, const uint8_t * aBuf, uint32_t aLength)
+{
+    TLVReader reader;
+    TLVType outerType;
+    reader.Init(aBuf, aLength);
+    NL_TEST_ASSERT(aSuite, reader.Next() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, reader.EnterContainer(outerType) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, reader.Next() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, reader.EnterContainer(outerType) == CHIP_NO_ERROR);
+
+    size_t count = 0;
+    // The containers opened by the test setup are not closed, so the reports end with the buffer.
+    while (reader.Next() == CHIP_NO_ERROR)
+    {
+        AttributeReportIB::Parser report;
+        AttributeDataIB::Parser data;
+        TLVReader dataReader;
+        NL_TEST_ASSERT(aSuite, report.Init(reader) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(aSuite, report.GetAttributeData(&data) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(aSuite, data.GetData(&dataReader) == CHIP_NO_ERROR);
+
+        if (dataReader.GetType() != kTLVType_Array)
+        {
+            count++;
+            continue;
+        }
+
+        TLVType listType;
+        NL_TEST_ASSERT(aSuite, dataReader.EnterContainer(listType) == CHIP_NO_ERROR);
+        while (dataReader.Next() == CHIP_NO_ERROR)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+void TestEncodeLargeListChunkingBenchmark(nlTestSuite * aSuite, void * aContext)
+{
+    constexpr size_t kEntries    = 64;
+    constexpr size_t kChunkSize  = 600;
+    constexpr size_t kIterations = 2000;
+
+    using Clusters::AccessControl::AccessControlEntryAuthModeEnum;
+    using Clusters::AccessControl::AccessControlEntryPrivilegeEnum;
+    using Clusters::AccessControl::Structs::AccessControlEntryStruct::Type;
+    using Target = Clusters::AccessControl::Structs::AccessControlTargetStruct::Type;
+
+    const uint64_t subjects[] = { 0x0123456789abcdef, 0x1123456789abcdef, 0x2123456789abcdef, 0x3123456789abcdef };
+    Target targets[3];
+    for (size_t i = 0; i < ArraySize(targets); i++)
+    {
+        targets[i].cluster.SetNonNull(static_cast<ClusterId>(0x0101 + i));
+        targets[i].endpoint.SetNonNull(static_cast<EndpointId>(1 + i));
+    }
+
+    Type entries[kEntries];
+    for (auto & entry : entries)
+    {
+        entry.privilege = AccessControlEntryPrivilegeEnum::kOperate;
+        entry.authMode  = AccessControlEntryAuthModeEnum::kCase;
+        entry.subjects.SetNonNull(subjects);
+        entry.targets.SetNonNull(targets);
+        entry.fabricIndex = kTestFabricIndex;
+    }
+
+    auto listEncoder = [&entries](const auto & encoder) -> CHIP_ERROR {
+        for (auto & entry : entries)
+        {
+            ReturnErrorOnFailure(encoder.Encode(entry));
+        }
+        return CHIP_NO_ERROR;
+    };
+
+    // Generate the reports of the whole list, as the reporting engine does, chunk after chunk.
+    size_t chunks         = 0;
+    size_t encodedEntries = 0;
+    const auto start      = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kIterations; i++)
+    {
+        AttributeEncodeState state;
+        CHIP_ERROR err;
+        do
+        {
+            LimitedTestSetup<kChunkSize> test(aSuite, kTestFabricIndex, state);
+            err   = test.encoder.EncodeList(listEncoder);
+            state = test.encoder.GetState();
+            chunks++;
+            if (i == 0)
+            {
+                encodedEntries += CountEncodedListItems(aSuite, test.buf, test.writer.GetLengthWritten());
+            }
+        } while (err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL);
+        NL_TEST_ASSERT(aSuite, err == CHIP_NO_ERROR);
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    // Every entry is reported exactly once.
+    NL_TEST_ASSERT(aSuite, encodedEntries == kEntries);
+
+    ChipLogProgress(DataManagement, "%u entries in %u chunks: %u us per report", static_cast<unsigned>(kEntries),
+                    static_cast<unsigned>(chunks / kIterations), static_cast<unsigned>(elapsed.count() / kIterations));
+}
+
 } // anonymous namespace
 
 namespace {
@@ -885,6 +992,7 @@ const nlTest sTests[] = {
     NL_TEST_DEF("TestEncodeListFabricScopedPreEncoded", TestEncodeListOfPreEncoded),
     NL_TEST_DEF("TestEncodeListOfFabricScopedPreEncoded", TestEncodeListOfFabricScopedPreEncoded),
     NL_TEST_DEF("TestEncodeFabricFilteredListOfPreEncoded", TestEncodeFabricFilteredListOfPreEncoded),
+    NL_TEST_DEF("TestEncodeLargeListChunkingBenchmark", TestEncodeLargeListChunkingBenchmark),
     NL_TEST_SENTINEL()
     // clang-format on
 };
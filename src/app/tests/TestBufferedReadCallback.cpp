@@ -29,8 +29,15 @@
 #include <lib/support/UnitTestContext.h>
 #include <lib/support/UnitTestRegistration.h>
 #include <nlunit-test.h>
+
+#include <chrono>
 #include <vector>
 
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define TEST_HAVE_MALLINFO2 1
+#endif
+
 using TestContext = chip::Test::AppContext;
 using namespace chip::app;
 using namespace chip;
@@ -39,6 +46,11 @@ namespace {
 
 nlTestSuite * gSuite = nullptr;
 
+//
+// Whether the sequences are run through a BufferedReadCallback in streaming mode.
+//
+bool gStreaming = false;
+
 struct ValidationInstruction
 {
     enum ProcessingType
@@ -67,7 +79,7 @@ struct ValidationInstruction
 
 using InstructionListType = std::vector<ValidationInstruction>;
 
-class DataSeriesValidator : public BufferedReadCallback::Callback
+class DataSeriesValidator : public BufferedReadCallback::Callback, public BufferedReadCallback::ListCallback
 {
 public:
     DataSeriesValidator(std::vector<ValidationInstruction> validationInstructionList)
@@ -84,10 +96,30 @@ public:
     void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override;
     void OnDone(ReadClient *) override {}
 
+    //
+    // BufferedReadCallback::ListCallback
+    //
+
+    void OnListData(const ConcreteDataAttributePath & aPath, BufferedReadCallback::ListIterator & aIterator) override;
+
     std::vector<ValidationInstruction> mInstructionList;
     uint32_t mCurrentInstruction = 0;
+
+private:
+    bool SkipDiscardedChunks();
 };
 
+bool DataSeriesValidator::SkipDiscardedChunks()
+{
+    while ((mCurrentInstruction < mInstructionList.size()) &&
+           (mInstructionList[mCurrentInstruction].mProcessingType == ValidationInstruction::kDiscardedChunk))
+    {
+        mCurrentInstruction++;
+    }
+
+    return mCurrentInstruction < mInstructionList.size();
+}
+
 void DataSeriesValidator::OnReportBegin()
 {
     mCurrentInstruction = 0;
@@ -100,13 +132,7 @@ void DataSeriesValidator::OnAttributeData(const ConcreteDataAttributePath & aPat
 {
     uint32_t expectedListLength;
 
-    while ((mCurrentInstruction < mInstructionList.size()) &&
-           (mInstructionList[mCurrentInstruction].mProcessingType == ValidationInstruction::kDiscardedChunk))
-    {
-        mCurrentInstruction++;
-    }
-
-    if (mCurrentInstruction >= mInstructionList.size())
+    if (!SkipDiscardedChunks())
     {
         return;
     }
@@ -279,6 +305,78 @@ void DataSeriesValidator::OnAttributeData(const ConcreteDataAttributePath & aPat
     mCurrentInstruction++;
 }
 
+void DataSeriesValidator::OnListData(const ConcreteDataAttributePath & aPath, BufferedReadCallback::ListIterator & aIterator)
+{
+    uint32_t expectedListLength = 0;
+    uint32_t index              = 0;
+
+    if (!SkipDiscardedChunks())
+    {
+        return;
+    }
+
+    NL_TEST_ASSERT(gSuite,
+                   aPath.mEndpointId == 0 && aPath.mClusterId == Clusters::UnitTesting::Id &&
+                       aPath.mListOp == ConcreteDataAttributePath::ListOperation::ReplaceAll);
+
+    switch (mInstructionList[mCurrentInstruction].mValidationType)
+    {
+    case ValidationInstruction::kListAttributeC_NotEmpty_Chunked:
+        expectedListLength = 512;
+        [[fallthrough]];
+    case ValidationInstruction::kListAttributeC_NotEmpty:
+        expectedListLength = (expectedListLength != 0) ? expectedListLength : 2;
+        [[fallthrough]];
+    case ValidationInstruction::kListAttributeC_Empty: {
+        ChipLogProgress(DataManagement, "\t\t -- Streaming C[%" PRIu32 "]", expectedListLength);
+
+        NL_TEST_ASSERT(gSuite, aPath.mAttributeId == Clusters::UnitTesting::Attributes::ListStructOctetString::Id);
+
+        while (aIterator.Next())
+        {
+            Clusters::UnitTesting::Structs::TestListStructOctet::DecodableType item;
+            NL_TEST_ASSERT(gSuite, DataModel::Decode(aIterator.GetReader(), item) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(gSuite, item.member1 == index);
+            index++;
+        }
+        break;
+    }
+
+    case ValidationInstruction::kListAttributeD_NotEmpty_Chunked:
+        expectedListLength = 512;
+        [[fallthrough]];
+    case ValidationInstruction::kListAttributeD_NotEmpty:
+        expectedListLength = (expectedListLength != 0) ? expectedListLength : 2;
+        [[fallthrough]];
+    case ValidationInstruction::kListAttributeD_Empty: {
+        ChipLogProgress(DataManagement, "\t\t -- Streaming D[%" PRIu32 "]", expectedListLength);
+
+        NL_TEST_ASSERT(gSuite, aPath.mAttributeId == Clusters::UnitTesting::Attributes::ListInt8u::Id);
+
+        while (aIterator.Next())
+        {
+            uint8_t item;
+            NL_TEST_ASSERT(gSuite, DataModel::Decode(aIterator.GetReader(), item) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(gSuite, item == static_cast<uint8_t>(index));
+            index++;
+        }
+        break;
+    }
+
+    default:
+        //
+        // Only successfully buffered lists are streamed.
+        //
+        NL_TEST_ASSERT(gSuite, false);
+        break;
+    }
+
+    NL_TEST_ASSERT(gSuite, aIterator.GetStatus() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(gSuite, index == expectedListLength);
+
+    mCurrentInstruction++;
+}
+
 class DataSeriesGenerator
 {
 public:
@@ -521,16 +619,15 @@ void RunAndValidateSequence(std::vector<ValidationInstruction> instructionList)
 {
     DataSeriesValidator validator(instructionList);
     BufferedReadCallback bufferedCallback(validator);
-    DataSeriesGenerator generator(bufferedCallback, instructionList);
+    BufferedReadCallback streamingCallback(validator, validator);
+    DataSeriesGenerator generator(gStreaming ? streamingCallback : bufferedCallback, instructionList);
     generator.Generate();
 
     NL_TEST_ASSERT(gSuite, validator.mCurrentInstruction == instructionList.size());
 }
 
-void TestBufferedSequences(nlTestSuite * apSuite, void * apContext)
+void RunBufferedSequences()
 {
-    ChipLogProgress(DataManagement, "Validating various sequences of attribute data IBs...");
-
     ChipLogProgress(DataManagement, "A --> A");
     RunAndValidateSequence({ { ValidationInstruction::kSimpleAttributeA } });
 
@@ -599,10 +696,189 @@ void TestBufferedSequences(nlTestSuite * apSuite, void * apContext)
     });
 }
 
+void TestBufferedSequences(nlTestSuite * apSuite, void * apContext)
+{
+    ChipLogProgress(DataManagement, "Validating various sequences of attribute data IBs...");
+    gStreaming = false;
+    RunBufferedSequences();
+}
+
+void TestStreamedSequences(nlTestSuite * apSuite, void * apContext)
+{
+    ChipLogProgress(DataManagement, "Validating various sequences of attribute data IBs in streaming mode...");
+    gStreaming = true;
+    RunBufferedSequences();
+    gStreaming = false;
+}
+
+size_t HeapInUse()
+{
+#if TEST_HAVE_MALLINFO2
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+size_t HeapGrowth(size_t baseline, size_t current)
+{
+    return current > baseline ? current - baseline : 0;
+}
+
+//
+// Receives a large chunked list either reconstituted (legacy mode) or streamed, decodes every item and records the
+// heap in use at delivery time.
+//
+class LargeListReceiver : public BufferedReadCallback::Callback, public BufferedReadCallback::ListCallback
+{
+public:
+    void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override
+    {
+        Clusters::UnitTesting::Attributes::ListStructOctetString::TypeInfo::DecodableType value;
+
+        mHeapAtDelivery = HeapInUse();
+        NL_TEST_ASSERT(gSuite, DataModel::Decode(*apData, value) == CHIP_NO_ERROR);
+
+        auto iter = value.begin();
+        while (iter.Next())
+        {
+            NL_TEST_ASSERT(gSuite, iter.GetValue().member1 == mItemCount);
+            mItemCount++;
+        }
+        NL_TEST_ASSERT(gSuite, iter.GetStatus() == CHIP_NO_ERROR);
+    }
+
+    void OnListData(const ConcreteDataAttributePath & aPath, BufferedReadCallback::ListIterator & aIterator) override
+    {
+        mHeapAtDelivery = HeapInUse();
+        while (aIterator.Next())
+        {
+            Clusters::UnitTesting::Structs::TestListStructOctet::DecodableType item;
+            NL_TEST_ASSERT(gSuite, DataModel::Decode(aIterator.GetReader(), item) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(gSuite, item.member1 == mItemCount);
+            mItemCount++;
+        }
+        NL_TEST_ASSERT(gSuite, aIterator.GetStatus() == CHIP_NO_ERROR);
+    }
+
+    void OnDone(ReadClient *) override {}
+
+    uint32_t mItemCount    = 0;
+    size_t mHeapAtDelivery = 0;
+};
+
+struct LargeListMeasurement
+{
+    size_t mBufferedBytes;
+    size_t mDeliveryBytes;
+    std::chrono::steady_clock::duration mLatency;
+};
+
+LargeListMeasurement ReceiveLargeList(bool streaming, uint32_t listLength)
+{
+    LargeListReceiver receiver;
+    BufferedReadCallback bufferedCallback(receiver);
+    BufferedReadCallback streamingCallback(receiver, receiver);
+    ReadClient::Callback * callback = streaming ? &streamingCallback : &bufferedCallback;
+    ConcreteDataAttributePath path(0, Clusters::UnitTesting::Id, Clusters::UnitTesting::Attributes::ListStructOctetString::Id);
+    LargeListMeasurement measurement;
+
+    size_t baseline = HeapInUse();
+    auto start      = std::chrono::steady_clock::now();
+
+    callback->OnReportBegin();
+
+    for (uint32_t i = 0; i <= listLength; i++)
+    {
+        System::PacketBufferHandle handle = System::PacketBufferHandle::New(1000);
+        System::PacketBufferTLVWriter writer;
+        System::PacketBufferTLVReader reader;
+
+        writer.Init(std::move(handle), true);
+
+        if (i == 0)
+        {
+            Clusters::UnitTesting::Attributes::ListStructOctetString::TypeInfo::Type value;
+            path.mListOp = ConcreteDataAttributePath::ListOperation::ReplaceAll;
+            NL_TEST_ASSERT(gSuite, DataModel::Encode(writer, TLV::AnonymousTag(), value) == CHIP_NO_ERROR);
+        }
+        else
+        {
+            Clusters::UnitTesting::Structs::TestListStructOctet::Type listItem;
+            listItem.member1 = i - 1;
+            path.mListOp     = ConcreteDataAttributePath::ListOperation::AppendItem;
+            NL_TEST_ASSERT(gSuite, DataModel::Encode(writer, TLV::AnonymousTag(), listItem) == CHIP_NO_ERROR);
+        }
+
+        writer.Finalize(&handle);
+        reader.Init(std::move(handle));
+        NL_TEST_ASSERT(gSuite, reader.Next() == CHIP_NO_ERROR);
+        callback->OnAttributeData(path, &reader, StatusIB());
+    }
+
+    //
+    // Only the buffered chunks are left allocated at this point.
+    //
+    measurement.mBufferedBytes = HeapGrowth(baseline, HeapInUse());
+
+    callback->OnReportEnd();
+
+    measurement.mLatency       = std::chrono::steady_clock::now() - start;
+    measurement.mDeliveryBytes = HeapGrowth(baseline, receiver.mHeapAtDelivery);
+
+    NL_TEST_ASSERT(gSuite, receiver.mItemCount == listLength);
+
+    return measurement;
+}
+
+void TestLargeListBenchmark(nlTestSuite * apSuite, void * apContext)
+{
+    constexpr uint32_t kListLength = 1000;
+    constexpr int kIterations      = 20;
+
+    for (bool streaming : { false, true })
+    {
+        LargeListMeasurement worst = {};
+        std::chrono::steady_clock::duration total{};
+
+        for (int i = 0; i < kIterations; i++)
+        {
+            LargeListMeasurement measurement = ReceiveLargeList(streaming, kListLength);
+            worst.mBufferedBytes             = std::max(worst.mBufferedBytes, measurement.mBufferedBytes);
+            worst.mDeliveryBytes             = std::max(worst.mDeliveryBytes, measurement.mDeliveryBytes);
+            total += measurement.mLatency;
+        }
+
+        auto averageUs = std::chrono::duration_cast<std::chrono::microseconds>(total).count() / kIterations;
+
+        //
+        // In legacy mode, the contiguous copy of the list is allocated while all the buffered chunks are still held.
+        //
+        size_t peakBytes = streaming ? std::max(worst.mBufferedBytes, worst.mDeliveryBytes)
+                                     : worst.mBufferedBytes + worst.mDeliveryBytes;
+
+        ChipLogProgress(DataManagement,
+                        "%s mode, %" PRIu32 "-element list: %u bytes buffered, %u bytes peak, %u us per report",
+                        streaming ? "Streaming" : "Legacy", kListLength, static_cast<unsigned>(worst.mBufferedBytes),
+                        static_cast<unsigned>(peakBytes), static_cast<unsigned>(averageUs));
+#if TEST_HAVE_MALLINFO2
+        if (streaming)
+        {
+            //
+            // Streaming never needs more than the buffered chunks themselves.
+            //
+            NL_TEST_ASSERT(apSuite, worst.mDeliveryBytes <= worst.mBufferedBytes);
+        }
+#endif
+    }
+}
+
 // clang-format off
 const nlTest sTests[] =
 {
     NL_TEST_DEF("TestBufferedSequences", TestBufferedSequences),
+    NL_TEST_DEF("TestStreamedSequences", TestStreamedSequences),
+    NL_TEST_DEF("TestLargeListBenchmark", TestLargeListBenchmark),
     NL_TEST_SENTINEL()
 };
 
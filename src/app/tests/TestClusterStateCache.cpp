@@ -33,9 +33,16 @@
 #include <lib/support/UnitTestContext.h>
 #include <lib/support/UnitTestRegistration.h>
 #include <nlunit-test.h>
+
+#include <chrono>
+#include <memory>
 #include <string.h>
 #include <vector>
 
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
 using TestContext = chip::Test::AppContext;
 using namespace chip::app;
 using namespace chip;
@@ -273,7 +280,8 @@ void DataSeriesGenerator::Generate(ForwardedDataCallbackValidator & dataCallback
     callback->OnReportEnd();
 }
 
-class CacheValidator : public ClusterStateCache::Callback
+template <typename CacheT>
+class CacheValidator : public CacheT::Callback
 {
 public:
     CacheValidator(AttributeInstructionListType & instructionList, ForwardedDataCallbackValidator & dataCallbackValidator);
@@ -304,7 +312,7 @@ private:
         }
     }
 
-    void DecodeAttribute(const AttributeInstruction & instruction, const ConcreteAttributePath & path, ClusterStateCache * cache)
+    void DecodeAttribute(const AttributeInstruction & instruction, const ConcreteAttributePath & path, CacheT * cache)
     {
         CHIP_ERROR err;
         bool gotStatus = false;
@@ -317,7 +325,7 @@ private:
             ChipLogProgress(DataManagement, "\t\t -- Validating A");
 
             Clusters::UnitTesting::Attributes::Int16u::TypeInfo::DecodableType v = 0;
-            err = cache->Get<Clusters::UnitTesting::Attributes::Int16u::TypeInfo>(path, v);
+            err = cache->template Get<Clusters::UnitTesting::Attributes::Int16u::TypeInfo>(path, v);
             if (err == CHIP_ERROR_IM_STATUS_CODE_RECEIVED)
             {
                 gotStatus = true;
@@ -336,7 +344,7 @@ private:
             ChipLogProgress(DataManagement, "\t\t -- Validating B");
 
             Clusters::UnitTesting::Attributes::OctetString::TypeInfo::DecodableType v;
-            err = cache->Get<Clusters::UnitTesting::Attributes::OctetString::TypeInfo>(path, v);
+            err = cache->template Get<Clusters::UnitTesting::Attributes::OctetString::TypeInfo>(path, v);
             if (err == CHIP_ERROR_IM_STATUS_CODE_RECEIVED)
             {
                 gotStatus = true;
@@ -355,7 +363,7 @@ private:
             ChipLogProgress(DataManagement, "\t\t -- Validating C");
 
             Clusters::UnitTesting::Attributes::StructAttr::TypeInfo::DecodableType v;
-            err = cache->Get<Clusters::UnitTesting::Attributes::StructAttr::TypeInfo>(path, v);
+            err = cache->template Get<Clusters::UnitTesting::Attributes::StructAttr::TypeInfo>(path, v);
             if (err == CHIP_ERROR_IM_STATUS_CODE_RECEIVED)
             {
                 gotStatus = true;
@@ -374,7 +382,7 @@ private:
             ChipLogProgress(DataManagement, "\t\t -- Validating D");
 
             Clusters::UnitTesting::Attributes::ListStructOctetString::TypeInfo::DecodableType v;
-            err = cache->Get<Clusters::UnitTesting::Attributes::ListStructOctetString::TypeInfo>(path, v);
+            err = cache->template Get<Clusters::UnitTesting::Attributes::ListStructOctetString::TypeInfo>(path, v);
             if (err == CHIP_ERROR_IM_STATUS_CODE_RECEIVED)
             {
                 gotStatus = true;
@@ -404,10 +412,9 @@ private:
         }
     }
 
-    void DecodeClusterObject(const AttributeInstruction & instruction, const ConcreteAttributePath & path,
-                             ClusterStateCache * cache)
+    void DecodeClusterObject(const AttributeInstruction & instruction, const ConcreteAttributePath & path, CacheT * cache)
     {
-        std::list<ClusterStateCache::AttributeStatus> statusList;
+        std::list<typename CacheT::AttributeStatus> statusList;
         NL_TEST_ASSERT(gSuite, cache->Get(path.mEndpointId, path.mClusterId, clusterValue, statusList) == CHIP_NO_ERROR);
 
         if (instruction.mValueType == AttributeInstruction::kData)
@@ -458,7 +465,7 @@ private:
         }
     }
 
-    void OnAttributeChanged(ClusterStateCache * cache, const ConcreteAttributePath & path) override
+    void OnAttributeChanged(CacheT * cache, const ConcreteAttributePath & path) override
     {
         StatusIB status;
 
@@ -486,14 +493,14 @@ private:
         }
     }
 
-    void OnClusterChanged(ClusterStateCache * cache, EndpointId endpointId, ClusterId clusterId) override
+    void OnClusterChanged(CacheT * cache, EndpointId endpointId, ClusterId clusterId) override
     {
         auto iter = mExpectedClusters.find(std::make_tuple(endpointId, clusterId));
         NL_TEST_ASSERT(gSuite, iter != mExpectedClusters.end());
         mExpectedClusters.erase(iter);
     }
 
-    void OnEndpointAdded(ClusterStateCache * cache, EndpointId endpointId) override
+    void OnEndpointAdded(CacheT * cache, EndpointId endpointId) override
     {
         auto iter = mExpectedEndpoints.find(endpointId);
         NL_TEST_ASSERT(gSuite, iter != mExpectedEndpoints.end());
@@ -519,8 +526,9 @@ private:
     ForwardedDataCallbackValidator & mDataCallbackValidator;
 };
 
-CacheValidator::CacheValidator(AttributeInstructionListType & instructionList,
-                               ForwardedDataCallbackValidator & dataCallbackValidator) :
+template <typename CacheT>
+CacheValidator<CacheT>::CacheValidator(AttributeInstructionListType & instructionList,
+                                       ForwardedDataCallbackValidator & dataCallbackValidator) :
     mDataCallbackValidator(dataCallbackValidator)
 {
     for (auto & instruction : instructionList)
@@ -538,11 +546,12 @@ CacheValidator::CacheValidator(AttributeInstructionListType & instructionList,
     }
 }
 
+template <typename CacheT>
 void RunAndValidateSequence(AttributeInstructionListType list)
 {
     ForwardedDataCallbackValidator dataCallbackValidator;
-    CacheValidator client(list, dataCallbackValidator);
-    ClusterStateCache cache(client);
+    CacheValidator<CacheT> client(list, dataCallbackValidator);
+    CacheT cache(client);
 
     // In order for the cache to track our data versions, we need to claim to it
     // that we are dealing with a wildcard path.  And we need to do that before
@@ -625,7 +634,8 @@ void RunAndValidateSequence(AttributeInstructionListType list)
  * E1:A1 --- Endpoint 1, Attribute A, Version 1
  *
  */
-void TestCache(nlTestSuite * apSuite, void * apContext)
+template <typename CacheT>
+void RunCacheSequences()
 {
     ChipLogProgress(DataManagement, "Validating various sequences of attribute data IBs...");
 
@@ -633,61 +643,199 @@ void TestCache(nlTestSuite * apSuite, void * apContext)
     // Validate a range of types and ensure that they can be successfully decoded.
     //
     ChipLogProgress(DataManagement, "E1:A1 --> E1:A1");
-    RunAndValidateSequence({ AttributeInstruction(
+    RunAndValidateSequence<CacheT>({ AttributeInstruction(
 
         AttributeInstruction::kAttributeA, 1, AttributeInstruction::kData) });
 
     ChipLogProgress(DataManagement, "E1:B1 --> E1:B1");
-    RunAndValidateSequence({ AttributeInstruction(
+    RunAndValidateSequence<CacheT>({ AttributeInstruction(
 
         AttributeInstruction::kAttributeB, 1, AttributeInstruction::kData) });
 
     ChipLogProgress(DataManagement, "E1:C1 --> E1:C1");
-    RunAndValidateSequence({ AttributeInstruction(AttributeInstruction::kAttributeC, 1, AttributeInstruction::kData) });
+    RunAndValidateSequence<CacheT>({ AttributeInstruction(AttributeInstruction::kAttributeC, 1, AttributeInstruction::kData) });
 
     ChipLogProgress(DataManagement, "E1:D1 --> E1:D1");
-    RunAndValidateSequence({ AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kData) });
+    RunAndValidateSequence<CacheT>({ AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kData) });
 
     //
     // Validate that a newer version of a data item over-rides the
     // previous copy.
     //
     ChipLogProgress(DataManagement, "E1:D1 E1:D2 --> E1:D2");
-    RunAndValidateSequence({ AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kData),
-                             AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kData) });
+    RunAndValidateSequence<CacheT>({ AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kData),
+                                     AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kData) });
 
     //
     // Validate that a newer StatusIB over-rides a previous data value.
     //
     ChipLogProgress(DataManagement, "E1:D1 E1:D2s --> E1:D2s");
-    RunAndValidateSequence({ AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kData),
-                             AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kStatus) });
+    RunAndValidateSequence<CacheT>({ AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kData),
+                                     AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kStatus) });
 
     //
     // Validate that a newer data value over-rides a previous status value.
     //
     ChipLogProgress(DataManagement, "E1:D1s E1:D2 --> E1:D2");
-    RunAndValidateSequence({ AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kStatus),
-                             AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kData) });
+    RunAndValidateSequence<CacheT>({ AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kStatus),
+                                     AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kData) });
 
     //
     // Validate data across different endpoints.
     //
     ChipLogProgress(DataManagement, "E0:D1 E1:D2 --> E0:D1 E1:D2");
-    RunAndValidateSequence({ AttributeInstruction(AttributeInstruction::kAttributeD, 0, AttributeInstruction::kData),
-                             AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kData) });
+    RunAndValidateSequence<CacheT>({ AttributeInstruction(AttributeInstruction::kAttributeD, 0, AttributeInstruction::kData),
+                                     AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kData) });
 
     ChipLogProgress(DataManagement, "E0:A1 E0:B2 E0:A3 E0:B4 --> E0:A3 E0:B4");
-    RunAndValidateSequence({ AttributeInstruction(AttributeInstruction::kAttributeA, 0, AttributeInstruction::kData),
-                             AttributeInstruction(AttributeInstruction::kAttributeB, 0, AttributeInstruction::kData),
-                             AttributeInstruction(AttributeInstruction::kAttributeA, 0, AttributeInstruction::kData),
-                             AttributeInstruction(AttributeInstruction::kAttributeB, 0, AttributeInstruction::kData) });
+    RunAndValidateSequence<CacheT>({ AttributeInstruction(AttributeInstruction::kAttributeA, 0, AttributeInstruction::kData),
+                                     AttributeInstruction(AttributeInstruction::kAttributeB, 0, AttributeInstruction::kData),
+                                     AttributeInstruction(AttributeInstruction::kAttributeA, 0, AttributeInstruction::kData),
+                                     AttributeInstruction(AttributeInstruction::kAttributeB, 0, AttributeInstruction::kData) });
+}
+
+void TestCache(nlTestSuite * apSuite, void * apContext)
+{
+    RunCacheSequences<ClusterStateCache>();
+}
+
+void TestFlatCache(nlTestSuite * apSuite, void * apContext)
+{
+    RunCacheSequences<FlatClusterStateCache>();
+}
+
+// Shape of the data cached for each node by the layout benchmark, roughly that of a wildcard subscription to a
+// light or a plug.
+constexpr EndpointId kBenchmarkEndpoints   = 3;
+constexpr ClusterId kBenchmarkClusters     = 12;
+constexpr AttributeId kBenchmarkAttributes = 16;
+constexpr size_t kBenchmarkNodes           = 200;
+constexpr unsigned kBenchmarkLookupRounds  = 20;
+
+size_t GetHeapInUse()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+template <typename CacheT>
+class BenchmarkCallback : public CacheT::Callback
+{
+    void OnDone(ReadClient *) override {}
+};
+
+template <typename CacheT>
+void PopulateBenchmarkCache(CacheT & cache)
+{
+    ReadClient::Callback & callback = cache.GetBufferedCallback();
+    callback.OnReportBegin();
+    for (EndpointId endpoint = 0; endpoint < kBenchmarkEndpoints; endpoint++)
+    {
+        for (ClusterId cluster = 0; cluster < kBenchmarkClusters; cluster++)
+        {
+            for (AttributeId attribute = 0; attribute < kBenchmarkAttributes; attribute++)
+            {
+                uint8_t buf[64];
+                TLV::TLVWriter writer;
+                writer.Init(buf);
+                if (attribute % 4 == 0)
+                {
+                    NL_TEST_ASSERT(gSuite, writer.PutString(TLV::AnonymousTag(), "a short label") == CHIP_NO_ERROR);
+                }
+                else
+                {
+                    NL_TEST_ASSERT(gSuite, writer.Put(TLV::AnonymousTag(), attribute) == CHIP_NO_ERROR);
+                }
+
+                TLV::TLVReader reader;
+                reader.Init(buf, writer.GetLengthWritten());
+                NL_TEST_ASSERT(gSuite, reader.Next() == CHIP_NO_ERROR);
+
+                ConcreteDataAttributePath path(endpoint, cluster, attribute);
+                path.mDataVersion.SetValue(1);
+                callback.OnAttributeData(path, &reader, StatusIB());
+            }
+        }
+    }
+    callback.OnReportEnd();
+}
+
+struct LayoutBenchmarkResult
+{
+    size_t mBytesPerNode;
+    double mNanosecondsPerLookup;
+};
+
+template <typename CacheT>
+LayoutBenchmarkResult RunLayoutBenchmark()
+{
+    LayoutBenchmarkResult result = {};
+    BenchmarkCallback<CacheT> callback;
+    std::vector<std::unique_ptr<CacheT>> caches;
+
+    const size_t heapBefore = GetHeapInUse();
+    for (size_t i = 0; i < kBenchmarkNodes; i++)
+    {
+        caches.push_back(std::make_unique<CacheT>(callback));
+        PopulateBenchmarkCache(*caches.back());
+    }
+    result.mBytesPerNode = (GetHeapInUse() - heapBefore) / kBenchmarkNodes;
+
+    unsigned lookups = 0;
+    auto start       = std::chrono::steady_clock::now();
+    for (unsigned round = 0; round < kBenchmarkLookupRounds; round++)
+    {
+        for (auto & cache : caches)
+        {
+            for (AttributeId attribute = 1; attribute < kBenchmarkAttributes; attribute += 4)
+            {
+                const ConcreteAttributePath path(static_cast<EndpointId>(round % kBenchmarkEndpoints),
+                                                 static_cast<ClusterId>(round % kBenchmarkClusters), attribute);
+                TLV::TLVReader reader;
+                uint32_t value = 0;
+                NL_TEST_ASSERT(gSuite, cache->Get(path, reader) == CHIP_NO_ERROR);
+                NL_TEST_ASSERT(gSuite, reader.Get(value) == CHIP_NO_ERROR && value == attribute);
+                lookups++;
+            }
+        }
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    result.mNanosecondsPerLookup                     = elapsed.count() / lookups;
+
+    return result;
+}
+
+/*
+ * Compare the memory footprint and lookup latency of the map and flat layouts, for a controller caching the
+ * attributes of many nodes.
+ */
+void TestCacheLayoutBenchmark(nlTestSuite * apSuite, void * apContext)
+{
+    LayoutBenchmarkResult map  = RunLayoutBenchmark<ClusterStateCache>();
+    LayoutBenchmarkResult flat = RunLayoutBenchmark<FlatClusterStateCache>();
+
+    ChipLogProgress(DataManagement, "%u attributes per node, map layout: %u bytes/node, %.0f ns/lookup",
+                    static_cast<unsigned>(kBenchmarkEndpoints * kBenchmarkClusters * kBenchmarkAttributes),
+                    static_cast<unsigned>(map.mBytesPerNode), map.mNanosecondsPerLookup);
+    ChipLogProgress(DataManagement, "%u attributes per node, flat layout: %u bytes/node, %.0f ns/lookup",
+                    static_cast<unsigned>(kBenchmarkEndpoints * kBenchmarkClusters * kBenchmarkAttributes),
+                    static_cast<unsigned>(flat.mBytesPerNode), flat.mNanosecondsPerLookup);
+
+    if (map.mBytesPerNode != 0)
+    {
+        NL_TEST_ASSERT(apSuite, flat.mBytesPerNode < map.mBytesPerNode);
+    }
 }
 
 // clang-format off
 const nlTest sTests[] =
 {
     NL_TEST_DEF("TestCache", TestCache),
+    NL_TEST_DEF("TestFlatCache", TestFlatCache),
+    NL_TEST_DEF("TestCacheLayoutBenchmark", TestCacheLayoutBenchmark),
     NL_TEST_SENTINEL()
 };
 
@@ -0,0 +1,669 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a test for the event index of EventManagement: fetching events through the index must return
+ *      the same events as scanning the event buffers, and the benchmark compares the two for several buffer sizes and
+ *      subscriber counts.  It also checks that readers catch up through an EventLogStore on the events evicted from the
+ *      event buffers.
+ */
+
+#include <access/SubjectDescriptor.h>
+#include <app/EventLogStore.h>
+#include <app/EventLoggingDelegate.h>
+#include <app/EventLoggingTypes.h>
+#include <app/EventManagement.h>
+#include <app/MessageDef/EventReportIB.h>
+#include <app/tests/AppTestContext.h>
+#include <lib/core/CHIPCore.h>
+#include <lib/core/TLV.h>
+#include <lib/support/CHIPCounter.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/LinkedList.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/UnitTestContext.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <nlunit-test.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+constexpr ClusterId kTestClusterIds[]   = { 0x00000022, 0x00000028, 0x00000101 };
+constexpr EndpointId kTestEndpointIds[] = { 1, 2, 3, 4 };
+constexpr EventId kTestEventId          = 1;
+constexpr FabricIndex kTestFabricIndex  = 1;
+constexpr FabricIndex kOtherFabricIndex = 2;
+
+using TestContext = Test::AppContext;
+
+class TestEventGenerator : public EventLoggingDelegate
+{
+public:
+    CHIP_ERROR WriteEvent(TLV::TLVWriter & aWriter) override
+    {
+        TLV::TLVType dataContainerType;
+        ReturnErrorOnFailure(aWriter.StartContainer(TLV::ContextTag(EventDataIB::Tag::kData), TLV::kTLVType_Structure,
+                                                    dataContainerType));
+        ReturnErrorOnFailure(aWriter.Put(TLV::ContextTag(1), mStatus));
+        return aWriter.EndContainer(dataContainerType);
+    }
+
+    void SetStatus(uint32_t aStatus) { mStatus = aStatus; }
+
+private:
+    uint32_t mStatus = 0;
+};
+
+/**
+ * Event buffers for the three priority levels, with or without an index, and the EventManagement using them.
+ */
+class EventStorage
+{
+public:
+    void Init(uint32_t aBufferSize, uint32_t aIndexSize, System::Clock::Milliseconds64 aStartupTime,
+              EventNumber aFirstEventNumber = 0)
+    {
+        LogStorageResources resources[ArraySize(mCircularEventBuffer)];
+        const PriorityLevel priorities[] = { PriorityLevel::Debug, PriorityLevel::Info, PriorityLevel::Critical };
+
+        for (size_t i = 0; i < ArraySize(resources); i++)
+        {
+            VerifyOrDie(mBuffers[i].Calloc(aBufferSize));
+            resources[i].mpBuffer     = mBuffers[i].Get();
+            resources[i].mBufferSize  = aBufferSize;
+            resources[i].mPriority    = priorities[i];
+            if (aIndexSize != 0)
+            {
+                VerifyOrDie(mIndexes[i].Calloc(aIndexSize));
+                resources[i].mpIndex    = mIndexes[i].Get();
+                resources[i].mIndexSize = aIndexSize;
+            }
+        }
+
+        VerifyOrDie(mEventCounter.Init(aFirstEventNumber) == CHIP_NO_ERROR);
+        mEventManagement.Init(nullptr, ArraySize(resources), mCircularEventBuffer, resources, &mEventCounter, aStartupTime);
+    }
+
+    EventManagement & Get() { return mEventManagement; }
+
+private:
+    Platform::ScopedMemoryBuffer<uint8_t> mBuffers[3];
+    Platform::ScopedMemoryBuffer<EventIndexEntry> mIndexes[3];
+    CircularEventBuffer mCircularEventBuffer[3];
+    MonotonicallyIncreasingCounter<EventNumber> mEventCounter;
+    EventManagement mEventManagement;
+};
+
+struct ReportedTimestamp
+{
+    bool mIsDelta   = false;
+    uint64_t mValue = 0;
+};
+
+struct FetchResult
+{
+    CHIP_ERROR mError       = CHIP_NO_ERROR;
+    EventNumber mNextEvent  = 0;
+    size_t mEventCount      = 0;
+    std::vector<EventNumber> mEventNumbers;
+    std::vector<ReportedTimestamp> mSystemTimestamps;
+};
+
+FetchResult FetchEvents(EventManagement & aEventManagement, EventNumber aStartingEventNumber,
+                        const SingleLinkedListNode<EventPathParams> * apPaths, FabricIndex aFabricIndex, size_t aOutputSize)
+{
+    FetchResult result;
+    Platform::ScopedMemoryBuffer<uint8_t> output;
+    VerifyOrDie(output.Alloc(aOutputSize));
+
+    Access::SubjectDescriptor subjectDescriptor;
+    subjectDescriptor.fabricIndex = aFabricIndex;
+
+    TLV::TLVWriter writer;
+    writer.Init(output.Get(), aOutputSize);
+    result.mNextEvent = aStartingEventNumber;
+    result.mError =
+        aEventManagement.FetchEventsSince(writer, apPaths, result.mNextEvent, result.mEventCount, subjectDescriptor);
+
+    TLV::TLVReader reader;
+    reader.Init(output.Get(), writer.GetLengthWritten());
+    while (reader.Next() == CHIP_NO_ERROR)
+    {
+        EventReportIB::Parser report;
+        EventDataIB::Parser data;
+        uint64_t eventNumber = 0;
+        VerifyOrDie(report.Init(reader) == CHIP_NO_ERROR);
+        VerifyOrDie(report.GetEventData(&data) == CHIP_NO_ERROR);
+        VerifyOrDie(data.GetEventNumber(&eventNumber) == CHIP_NO_ERROR);
+        result.mEventNumbers.push_back(eventNumber);
+
+        ReportedTimestamp timestamp;
+        if (data.GetDeltaSystemTimestamp(&timestamp.mValue) == CHIP_NO_ERROR)
+        {
+            timestamp.mIsDelta = true;
+            result.mSystemTimestamps.push_back(timestamp);
+        }
+        else if (data.GetSystemTimestamp(&timestamp.mValue) == CHIP_NO_ERROR)
+        {
+            result.mSystemTimestamps.push_back(timestamp);
+        }
+    }
+    return result;
+}
+
+bool operator==(const FetchResult & aLeft, const FetchResult & aRight)
+{
+    return aLeft.mError == aRight.mError && aLeft.mNextEvent == aRight.mNextEvent && aLeft.mEventCount == aRight.mEventCount &&
+        aLeft.mEventNumbers == aRight.mEventNumbers;
+}
+
+void LogTestEvent(nlTestSuite * apSuite, EventManagement & aEventManagement, uint32_t aSequence)
+{
+    TestEventGenerator generator;
+    EventOptions options;
+    EventNumber eventNumber;
+    const PriorityLevel priorities[] = { PriorityLevel::Debug, PriorityLevel::Info, PriorityLevel::Critical };
+    const FabricIndex fabrics[]      = { kUndefinedFabricIndex, kTestFabricIndex, kUndefinedFabricIndex, kOtherFabricIndex };
+
+    options.mPath        = { kTestEndpointIds[aSequence % ArraySize(kTestEndpointIds)],
+                             kTestClusterIds[(aSequence / 2) % ArraySize(kTestClusterIds)], kTestEventId };
+    options.mPriority    = priorities[(aSequence / 3) % ArraySize(priorities)];
+    options.mFabricIndex = fabrics[(aSequence / 5) % ArraySize(fabrics)];
+    generator.SetStatus(aSequence);
+    NL_TEST_ASSERT(apSuite, aEventManagement.LogEvent(&generator, options, eventNumber) == CHIP_NO_ERROR);
+}
+
+void CheckIndexedFetchMatchesScan(nlTestSuite * apSuite, void * apContext)
+{
+    // Small buffers, so that events get evicted to the next buffers and wrap around, and an index that is large enough to
+    // never limit the number of events stored in a buffer.
+    constexpr uint32_t kBufferSize  = 256;
+    constexpr uint32_t kIndexSize   = 32;
+    constexpr uint32_t kEventsCount = 60;
+
+    const auto startupTime = System::SystemClock().GetMonotonicMilliseconds64();
+    EventStorage scanned;
+    EventStorage indexed;
+    scanned.Init(kBufferSize, 0, startupTime);
+    indexed.Init(kBufferSize, kIndexSize, startupTime);
+
+    SingleLinkedListNode<EventPathParams> wildcard[1];
+    SingleLinkedListNode<EventPathParams> endpoint[1];
+    SingleLinkedListNode<EventPathParams> clusters[2];
+    SingleLinkedListNode<EventPathParams> unknown[1];
+    endpoint[0].mValue.mEndpointId = kTestEndpointIds[1];
+    clusters[0].mValue.mEndpointId = kTestEndpointIds[0];
+    clusters[0].mValue.mClusterId  = kTestClusterIds[0];
+    clusters[0].mpNext             = &clusters[1];
+    clusters[1].mValue.mClusterId  = kTestClusterIds[2];
+    clusters[1].mValue.mEventId    = kTestEventId;
+    unknown[0].mValue.mEndpointId  = kTestEndpointIds[0];
+    unknown[0].mValue.mClusterId   = kTestClusterIds[0];
+    unknown[0].mValue.mEventId     = kTestEventId + 1;
+    const SingleLinkedListNode<EventPathParams> * pathLists[] = { wildcard, endpoint, clusters, unknown };
+
+    NL_TEST_ASSERT(apSuite,
+                   FetchEvents(indexed.Get(), 0, wildcard, kTestFabricIndex, 1024) ==
+                       FetchEvents(scanned.Get(), 0, wildcard, kTestFabricIndex, 1024));
+
+    for (uint32_t sequence = 0; sequence < kEventsCount; sequence++)
+    {
+        LogTestEvent(apSuite, scanned.Get(), sequence);
+        LogTestEvent(apSuite, indexed.Get(), sequence);
+
+        for (auto * paths : pathLists)
+        {
+            for (FabricIndex fabricIndex : { kTestFabricIndex, kOtherFabricIndex })
+            {
+                for (EventNumber start = 0; start <= sequence + 1; start++)
+                {
+                    FetchResult expected = FetchEvents(scanned.Get(), start, paths, fabricIndex, 1024);
+                    FetchResult actual   = FetchEvents(indexed.Get(), start, paths, fabricIndex, 1024);
+                    NL_TEST_ASSERT(apSuite, actual == expected);
+
+                    // Running out of space in the report must stop at the same event.
+                    expected = FetchEvents(scanned.Get(), start, paths, fabricIndex, 64);
+                    actual   = FetchEvents(indexed.Get(), start, paths, fabricIndex, 64);
+                    NL_TEST_ASSERT(apSuite, actual == expected);
+                }
+            }
+        }
+    }
+
+    // Events of a removed fabric are not reported anymore.
+    NL_TEST_ASSERT(apSuite, scanned.Get().FabricRemoved(kTestFabricIndex) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, indexed.Get().FabricRemoved(kTestFabricIndex) == CHIP_NO_ERROR);
+    FetchResult expected = FetchEvents(scanned.Get(), 0, wildcard, kTestFabricIndex, 1024);
+    FetchResult actual   = FetchEvents(indexed.Get(), 0, wildcard, kTestFabricIndex, 1024);
+    NL_TEST_ASSERT(apSuite, actual == expected);
+    NL_TEST_ASSERT(apSuite, !actual.mEventNumbers.empty());
+}
+
+std::vector<EventNumber> ReadStoredEventNumbers(EventManagement & aEventManagement, PriorityLevel aPriority)
+{
+    std::vector<EventNumber> eventNumbers;
+    TLV::TLVReader reader;
+    CircularEventBufferWrapper bufWrapper;
+    VerifyOrDie(aEventManagement.GetEventReader(reader, aPriority, &bufWrapper) == CHIP_NO_ERROR);
+    while (reader.Next() == CHIP_NO_ERROR)
+    {
+        EventReportIB::Parser report;
+        EventDataIB::Parser data;
+        uint64_t eventNumber = 0;
+        VerifyOrDie(report.Init(reader) == CHIP_NO_ERROR);
+        VerifyOrDie(report.GetEventData(&data) == CHIP_NO_ERROR);
+        VerifyOrDie(data.GetEventNumber(&eventNumber) == CHIP_NO_ERROR);
+        eventNumbers.push_back(eventNumber);
+    }
+    return eventNumbers;
+}
+
+void CheckIndexLimitsStoredEvents(nlTestSuite * apSuite, void * apContext)
+{
+    // An index smaller than the number of events fitting in a buffer evicts events on its own.
+    constexpr uint32_t kBufferSize  = 256;
+    constexpr uint32_t kIndexSize   = 3;
+    constexpr uint32_t kEventsCount = 40;
+
+    EventStorage indexed;
+    indexed.Init(kBufferSize, kIndexSize, System::SystemClock().GetMonotonicMilliseconds64());
+
+    SingleLinkedListNode<EventPathParams> wildcard[1];
+    TestEventGenerator generator;
+    EventOptions options;
+    EventNumber eventNumber;
+    const PriorityLevel priorities[] = { PriorityLevel::Critical, PriorityLevel::Info, PriorityLevel::Debug, PriorityLevel::Info };
+
+    for (uint32_t sequence = 0; sequence < kEventsCount; sequence++)
+    {
+        options.mPath     = { kTestEndpointIds[0], kTestClusterIds[0], kTestEventId };
+        options.mPriority = priorities[sequence % ArraySize(priorities)];
+        generator.SetStatus(sequence);
+        NL_TEST_ASSERT(apSuite, indexed.Get().LogEvent(&generator, options, eventNumber) == CHIP_NO_ERROR);
+
+        NL_TEST_ASSERT(apSuite, ReadStoredEventNumbers(indexed.Get(), PriorityLevel::Debug).size() <= kIndexSize);
+        NL_TEST_ASSERT(apSuite, ReadStoredEventNumbers(indexed.Get(), PriorityLevel::Info).size() <= 2 * kIndexSize);
+
+        std::vector<EventNumber> stored = ReadStoredEventNumbers(indexed.Get(), PriorityLevel::Critical);
+        NL_TEST_ASSERT(apSuite, stored.size() <= 3 * kIndexSize);
+        NL_TEST_ASSERT(apSuite, !stored.empty() && stored.back() == eventNumber);
+
+        for (EventNumber start = 0; start <= eventNumber + 1; start++)
+        {
+            std::vector<EventNumber> expected;
+            for (EventNumber storedNumber : stored)
+            {
+                if (storedNumber >= start)
+                {
+                    expected.push_back(storedNumber);
+                }
+            }
+            FetchResult actual = FetchEvents(indexed.Get(), start, wildcard, kTestFabricIndex, 1024);
+            NL_TEST_ASSERT(apSuite, actual.mError == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(apSuite, actual.mEventNumbers == expected);
+        }
+    }
+}
+
+/**
+ * An EventLogStore keeping the events in memory.
+ */
+class TestEventLogStore : public EventLogStore
+{
+public:
+    CHIP_ERROR Append(const EventIndexEntry & aEntry, const ByteSpan & aEvent) override
+    {
+        if (std::find(mFailingEventNumbers.begin(), mFailingEventNumbers.end(), aEntry.mEventNumber) !=
+            mFailingEventNumbers.end())
+        {
+            return CHIP_ERROR_WRITE_FAILED;
+        }
+        if (!mEvents.empty() && aEntry.mEventNumber <= mEvents.back().mEntry.mEventNumber)
+        {
+            mEvents.clear();
+        }
+        mEvents.push_back({ aEntry, std::vector<uint8_t>(aEvent.data(), aEvent.data() + aEvent.size()) });
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR ForEachEventSince(EventNumber aEventNumber, Visitor & aVisitor) override
+    {
+        mVisitedCount = 0;
+        for (const StoredEvent & event : mEvents)
+        {
+            if (event.mEntry.mEventNumber >= aEventNumber)
+            {
+                mVisitedCount++;
+                ReturnErrorOnFailure(aVisitor.OnEvent(event.mEntry, ByteSpan(event.mData.data(), event.mData.size())));
+            }
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR RemoveFabric(FabricIndex aFabricIndex) override
+    {
+        for (StoredEvent & event : mEvents)
+        {
+            if (event.mEntry.mHasFabricIndex && event.mEntry.mFabricIndex == aFabricIndex)
+            {
+                event.mEntry.mFabricIndex = kUndefinedFabricIndex;
+            }
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    struct StoredEvent
+    {
+        EventIndexEntry mEntry;
+        std::vector<uint8_t> mData;
+    };
+
+    std::vector<StoredEvent> mEvents;
+    std::vector<EventNumber> mFailingEventNumbers;
+    size_t mVisitedCount = 0;
+};
+
+// Fetch all the events since aStartingEventNumber, aOutputSize bytes at a time.
+std::vector<EventNumber> FetchAllEvents(EventManagement & aEventManagement, EventNumber aStartingEventNumber,
+                                        const SingleLinkedListNode<EventPathParams> * apPaths, FabricIndex aFabricIndex,
+                                        size_t aOutputSize)
+{
+    std::vector<EventNumber> eventNumbers;
+    FetchResult result;
+    result.mNextEvent = aStartingEventNumber;
+    do
+    {
+        // Every fetch must make progress.
+        const EventNumber previousNextEvent = result.mNextEvent;
+        result                              = FetchEvents(aEventManagement, result.mNextEvent, apPaths, aFabricIndex, aOutputSize);
+        eventNumbers.insert(eventNumbers.end(), result.mEventNumbers.begin(), result.mEventNumbers.end());
+        VerifyOrDie(result.mNextEvent > previousNextEvent || result.mError == CHIP_NO_ERROR);
+    } while (result.mError == CHIP_ERROR_BUFFER_TOO_SMALL || result.mError == CHIP_ERROR_NO_MEMORY);
+    VerifyOrDie(result.mError == CHIP_NO_ERROR);
+    return eventNumbers;
+}
+
+void CheckCatchUpFromEventLogStore(nlTestSuite * apSuite, void * apContext)
+{
+    // The small buffers only hold the last few events, the large ones all of them: with a store, fetching from the small
+    // buffers must return the same events as fetching from the large ones.
+    constexpr uint32_t kSmallBufferSize = 256;
+    constexpr uint32_t kLargeBufferSize = 8192;
+    constexpr uint32_t kIndexSize       = 32;
+    constexpr uint32_t kEventsCount     = 60;
+    constexpr System::Clock::Milliseconds64 kUptime(3600 * 1000);
+
+    // Log the events of the first run an hour after it started, so that their system timestamps are larger than the ones of
+    // the events logged after the restart.
+    const auto startupTime = System::SystemClock().GetMonotonicMilliseconds64() - kUptime;
+    TestEventLogStore scannedStore;
+    TestEventLogStore store;
+    EventStorage reference;
+    EventStorage scanned;
+    EventStorage indexed;
+    reference.Init(kLargeBufferSize, 0, startupTime);
+    scanned.Init(kSmallBufferSize, 0, startupTime);
+    indexed.Init(kSmallBufferSize, kIndexSize, startupTime);
+    scanned.Get().SetEventLogStore(&scannedStore);
+    indexed.Get().SetEventLogStore(&store);
+
+    SingleLinkedListNode<EventPathParams> wildcard[1];
+    SingleLinkedListNode<EventPathParams> endpoint[1];
+    endpoint[0].mValue.mEndpointId = kTestEndpointIds[1];
+    const SingleLinkedListNode<EventPathParams> * pathLists[] = { wildcard, endpoint };
+
+    for (uint32_t sequence = 0; sequence < kEventsCount; sequence++)
+    {
+        LogTestEvent(apSuite, reference.Get(), sequence);
+        LogTestEvent(apSuite, scanned.Get(), sequence);
+        LogTestEvent(apSuite, indexed.Get(), sequence);
+    }
+    NL_TEST_ASSERT(apSuite, store.mEvents.size() == kEventsCount);
+    NL_TEST_ASSERT(apSuite, ReadStoredEventNumbers(indexed.Get(), PriorityLevel::Critical).size() < kEventsCount);
+
+    for (auto * paths : pathLists)
+    {
+        for (FabricIndex fabricIndex : { kTestFabricIndex, kOtherFabricIndex })
+        {
+            for (EventNumber start = 0; start <= kEventsCount; start++)
+            {
+                for (size_t outputSize : { 1024u, 64u })
+                {
+                    std::vector<EventNumber> expected = FetchAllEvents(reference.Get(), start, paths, fabricIndex, outputSize);
+                    NL_TEST_ASSERT(apSuite, FetchAllEvents(scanned.Get(), start, paths, fabricIndex, outputSize) == expected);
+                    NL_TEST_ASSERT(apSuite, FetchAllEvents(indexed.Get(), start, paths, fabricIndex, outputSize) == expected);
+                }
+            }
+        }
+    }
+
+    // Readers that are up to date only seek in the store.
+    store.mVisitedCount = 0;
+    FetchEvents(indexed.Get(), kEventsCount, wildcard, kTestFabricIndex, 1024);
+    NL_TEST_ASSERT(apSuite, store.mVisitedCount == 0);
+
+    // Events of a removed fabric are not reported from the store either.
+    NL_TEST_ASSERT(apSuite, reference.Get().FabricRemoved(kTestFabricIndex) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, indexed.Get().FabricRemoved(kTestFabricIndex) == CHIP_NO_ERROR);
+    std::vector<EventNumber> expected = FetchAllEvents(reference.Get(), 0, wildcard, kTestFabricIndex, 1024);
+    NL_TEST_ASSERT(apSuite, FetchAllEvents(indexed.Get(), 0, wildcard, kTestFabricIndex, 1024) == expected);
+    NL_TEST_ASSERT(apSuite, !expected.empty());
+
+    // After a restart, the events of the previous run are only available from the store, and their system timestamps count
+    // from a boot that is gone: only the events logged since the restart are reported, with system timestamps of this boot.
+    EventStorage restarted;
+    restarted.Init(kSmallBufferSize, kIndexSize, System::SystemClock().GetMonotonicMilliseconds64(), kEventsCount);
+    restarted.Get().SetEventLogStore(&store);
+    NL_TEST_ASSERT(apSuite, FetchAllEvents(restarted.Get(), 0, wildcard, kTestFabricIndex, 1024).empty());
+    LogTestEvent(apSuite, restarted.Get(), kEventsCount);
+    LogTestEvent(apSuite, restarted.Get(), kEventsCount + 1);
+
+    FetchResult result = FetchEvents(restarted.Get(), 0, wildcard, kOtherFabricIndex, 1024);
+    NL_TEST_ASSERT(apSuite, result.mError == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, result.mEventNumbers == std::vector<EventNumber>({ kEventsCount, kEventsCount + 1 }));
+    NL_TEST_ASSERT(apSuite, result.mSystemTimestamps.size() == 2);
+    if (result.mSystemTimestamps.size() == 2)
+    {
+        NL_TEST_ASSERT(apSuite, !result.mSystemTimestamps[0].mIsDelta);
+        NL_TEST_ASSERT(apSuite, result.mSystemTimestamps[0].mValue < kUptime.count());
+        NL_TEST_ASSERT(apSuite, result.mSystemTimestamps[1].mIsDelta);
+        NL_TEST_ASSERT(apSuite, result.mSystemTimestamps[1].mValue < kUptime.count());
+    }
+}
+
+void CheckCatchUpAfterStoreFailures(nlTestSuite * apSuite, void * apContext)
+{
+    constexpr uint32_t kSmallBufferSize = 256;
+    constexpr uint32_t kLargeBufferSize = 8192;
+    constexpr uint32_t kIndexSize       = 32;
+    constexpr uint32_t kEventsCount     = 60;
+
+    const auto startupTime = System::SystemClock().GetMonotonicMilliseconds64();
+    EventStorage reference;
+    EventStorage probe;
+    reference.Init(kLargeBufferSize, 0, startupTime);
+    probe.Init(kSmallBufferSize, 0, startupTime);
+    for (uint32_t sequence = 0; sequence < kEventsCount; sequence++)
+    {
+        LogTestEvent(apSuite, reference.Get(), sequence);
+        LogTestEvent(apSuite, probe.Get(), sequence);
+    }
+
+    // Fail to store events that are still in the small buffers: the oldest one, one in the middle and the newest one.
+    std::vector<EventNumber> buffered = ReadStoredEventNumbers(probe.Get(), PriorityLevel::Critical);
+    std::sort(buffered.begin(), buffered.end());
+    NL_TEST_ASSERT(apSuite, buffered.size() >= 3 && buffered.front() > 0);
+    const std::vector<EventNumber> failing = { buffered.front(), buffered[buffered.size() / 2], buffered.back() };
+
+    TestEventLogStore scannedStore;
+    TestEventLogStore store;
+    scannedStore.mFailingEventNumbers = failing;
+    store.mFailingEventNumbers        = failing;
+    EventStorage scanned;
+    EventStorage indexed;
+    scanned.Init(kSmallBufferSize, 0, startupTime);
+    indexed.Init(kSmallBufferSize, kIndexSize, startupTime);
+    scanned.Get().SetEventLogStore(&scannedStore);
+    indexed.Get().SetEventLogStore(&store);
+    for (uint32_t sequence = 0; sequence < kEventsCount; sequence++)
+    {
+        LogTestEvent(apSuite, scanned.Get(), sequence);
+        LogTestEvent(apSuite, indexed.Get(), sequence);
+    }
+    NL_TEST_ASSERT(apSuite, store.mEvents.size() == kEventsCount - failing.size());
+
+    // The events missing from the store are fetched from the buffers, in order.  The events older than the first of them
+    // are all fetched from the store, while the newer ones only come from the buffers.
+    SingleLinkedListNode<EventPathParams> wildcard[1];
+    for (EventNumber start = 0; start <= kEventsCount; start++)
+    {
+        for (size_t outputSize : { 1024u, 64u })
+        {
+            std::vector<EventNumber> expected = FetchAllEvents(reference.Get(), start, wildcard, kTestFabricIndex, outputSize);
+            for (EventManagement * eventManagement : { &scanned.Get(), &indexed.Get() })
+            {
+                std::vector<EventNumber> events = FetchAllEvents(*eventManagement, start, wildcard, kTestFabricIndex, outputSize);
+                NL_TEST_ASSERT(apSuite, std::adjacent_find(events.begin(), events.end(), std::greater_equal<EventNumber>()) ==
+                                   events.end());
+                NL_TEST_ASSERT(apSuite, std::includes(expected.begin(), expected.end(), events.begin(), events.end()));
+                for (EventNumber eventNumber : failing)
+                {
+                    const bool isExpected = std::binary_search(expected.begin(), expected.end(), eventNumber);
+                    NL_TEST_ASSERT(apSuite, std::binary_search(events.begin(), events.end(), eventNumber) == isExpected);
+                }
+                const auto expectedFromStore = std::lower_bound(expected.begin(), expected.end(), failing.front());
+                NL_TEST_ASSERT(apSuite,
+                               events.size() >= static_cast<size_t>(expectedFromStore - expected.begin()) &&
+                                   std::equal(expected.begin(), expectedFromStore, events.begin()));
+            }
+        }
+    }
+
+    // The same holds when the very first event handed to the store fails, and the store holds no older event.
+    TestEventLogStore firstFailingStore;
+    firstFailingStore.mFailingEventNumbers = { 0 };
+    EventStorage large;
+    large.Init(kLargeBufferSize, kIndexSize, startupTime);
+    large.Get().SetEventLogStore(&firstFailingStore);
+    for (uint32_t sequence = 0; sequence < kIndexSize; sequence++)
+    {
+        LogTestEvent(apSuite, large.Get(), sequence);
+    }
+    std::vector<EventNumber> expected = FetchAllEvents(reference.Get(), 0, wildcard, kTestFabricIndex, 1024);
+    expected.erase(std::lower_bound(expected.begin(), expected.end(), kIndexSize), expected.end());
+    NL_TEST_ASSERT(apSuite, !expected.empty() && expected.front() == 0);
+    NL_TEST_ASSERT(apSuite, FetchAllEvents(large.Get(), 0, wildcard, kTestFabricIndex, 1024) == expected);
+}
+
+/**
+ * Fill the event buffers with events spread over 32 clusters, then have every subscriber fetch the events of its own cluster,
+ * with and without the index.
+ */
+void BenchmarkIndexedFetch(nlTestSuite * apSuite, void * apContext)
+{
+    constexpr uint32_t kPathsCount = 32;
+    constexpr size_t kOutputSize   = 16 * 1024;
+
+    for (uint32_t bufferSize : { 2048u, 16384u })
+    {
+        // Events are about 30 bytes long, so this index never limits the number of stored events.
+        const uint32_t indexSize = bufferSize / 16;
+        const auto startupTime   = System::SystemClock().GetMonotonicMilliseconds64();
+        EventStorage scanned;
+        EventStorage indexed;
+        scanned.Init(bufferSize, 0, startupTime);
+        indexed.Init(bufferSize, indexSize, startupTime);
+
+        TestEventGenerator generator;
+        EventOptions options;
+        EventNumber eventNumber;
+        options.mPriority = PriorityLevel::Critical;
+        for (uint32_t i = 0; i < bufferSize / 4; i++)
+        {
+            options.mPath = { static_cast<EndpointId>(1 + i % kPathsCount), kTestClusterIds[0], kTestEventId };
+            generator.SetStatus(i);
+            NL_TEST_ASSERT(apSuite, scanned.Get().LogEvent(&generator, options, eventNumber) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(apSuite, indexed.Get().LogEvent(&generator, options, eventNumber) == CHIP_NO_ERROR);
+        }
+
+        for (uint32_t subscribers : { 1u, 8u, 32u })
+        {
+            size_t scannedEvents = 0;
+            size_t indexedEvents = 0;
+            SingleLinkedListNode<EventPathParams> path[1];
+            path[0].mValue.mClusterId = kTestClusterIds[0];
+
+            auto start = std::chrono::steady_clock::now();
+            for (uint32_t subscriber = 0; subscriber < subscribers; subscriber++)
+            {
+                path[0].mValue.mEndpointId = static_cast<EndpointId>(1 + subscriber % kPathsCount);
+                scannedEvents += FetchEvents(scanned.Get(), 0, path, kTestFabricIndex, kOutputSize).mEventCount;
+            }
+            std::chrono::duration<double, std::micro> scanTime = std::chrono::steady_clock::now() - start;
+
+            start = std::chrono::steady_clock::now();
+            for (uint32_t subscriber = 0; subscriber < subscribers; subscriber++)
+            {
+                path[0].mValue.mEndpointId = static_cast<EndpointId>(1 + subscriber % kPathsCount);
+                indexedEvents += FetchEvents(indexed.Get(), 0, path, kTestFabricIndex, kOutputSize).mEventCount;
+            }
+            std::chrono::duration<double, std::micro> indexTime = std::chrono::steady_clock::now() - start;
+
+            NL_TEST_ASSERT(apSuite, scannedEvents == indexedEvents);
+            ChipLogProgress(EventLogging, "%u-byte buffers, %u subscribers: scan %.0f us, index %.0f us (%u events)",
+                            static_cast<unsigned>(bufferSize), static_cast<unsigned>(subscribers), scanTime.count(),
+                            indexTime.count(), static_cast<unsigned>(indexedEvents));
+        }
+    }
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("CheckIndexedFetchMatchesScan", CheckIndexedFetchMatchesScan),
+    NL_TEST_DEF("CheckIndexLimitsStoredEvents", CheckIndexLimitsStoredEvents),
+    NL_TEST_DEF("CheckCatchUpFromEventLogStore", CheckCatchUpFromEventLogStore),
+    NL_TEST_DEF("CheckCatchUpAfterStoreFailures", CheckCatchUpAfterStoreFailures),
+    NL_TEST_DEF("BenchmarkIndexedFetch", BenchmarkIndexedFetch),
+    NL_TEST_SENTINEL(),
+};
+
+nlTestSuite sSuite = {
+    "EventIndex",
+    &sTests[0],
+    NL_TEST_WRAP_FUNCTION(TestContext::SetUpTestSuite),
+    NL_TEST_WRAP_FUNCTION(TestContext::TearDownTestSuite),
+    NL_TEST_WRAP_METHOD(TestContext, SetUp),
+    NL_TEST_WRAP_METHOD(TestContext, TearDown),
+};
+
+} // namespace
+
+int TestEventIndex()
+{
+    return ExecuteTestsWithContext<TestContext>(&sSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestEventIndex)
@@ -37,6 +37,7 @@
 #include <messaging/ExchangeContext.h>
 #include <messaging/Flags.h>
 
+#include <chrono>
 #include <cinttypes>
 #include <nlunit-test.h>
 
@@ -57,9 +58,14 @@ public:
     static void TestBuildAndSendSingleReportData(nlTestSuite * apSuite, void * apContext);
     static void TestMergeOverlappedAttributePath(nlTestSuite * apSuite, void * apContext);
     static void TestMergeAttributePathWhenDirtySetPoolExhausted(nlTestSuite * apSuite, void * apContext);
+    static void TestDirtySetGeneration(nlTestSuite * apSuite, void * apContext);
+    static void TestDirtySetStorage(nlTestSuite * apSuite, void * apContext);
+    static void TestSetDirtyWithInterestIndex(nlTestSuite * apSuite, void * apContext);
 
 private:
     static bool InsertToDirtySet(const AttributePathParams & aPath);
+    static System::PacketBufferHandle BuildReadRequest(nlTestSuite * apSuite, EndpointId aEndpointId, ClusterId aFirstClusterId,
+                                                       size_t aNumClusters);
 
     struct ExpectedDirtySetContent : public AttributePathParams
     {
@@ -73,19 +79,21 @@ private:
         const int size                        = sizeof...(args);
         ExpectedDirtySetContent content[size] = { ExpectedDirtySetContent(args)... };
 
-        if (InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ForEachActiveObject([&](auto * path) {
-                for (int i = 0; i < size; i++)
-                {
-                    if (static_cast<AttributePathParams>(content[i]) == static_cast<AttributePathParams>(*path))
+        if (InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ForEachPath(
+                [&](const AttributePathParams & path, uint64_t generation) {
+                    for (int i = 0; i < size; i++)
                     {
-                        content[i].verified = true;
-                        return Loop::Continue;
+                        if (static_cast<AttributePathParams>(content[i]) == path)
+                        {
+                            content[i].verified = true;
+                            return Loop::Continue;
+                        }
                     }
-                }
-                ChipLogDetail(DataManagement, "Dirty path Endpoint %x Cluster %" PRIx32 ", Attribute %" PRIx32 " is not expected",
-                              path->mEndpointId, path->mClusterId, path->mAttributeId);
-                return Loop::Break;
-            }) == Loop::Break)
+                    ChipLogDetail(DataManagement,
+                                  "Dirty path Endpoint %x Cluster %" PRIx32 ", Attribute %" PRIx32 " is not expected",
+                                  path.mEndpointId, path.mClusterId, path.mAttributeId);
+                    return Loop::Break;
+                }) == Loop::Break)
         {
             return false;
         }
@@ -180,10 +188,8 @@ void TestReportingEngine::TestMergeOverlappedAttributePath(nlTestSuite * apSuite
                                                                     app::reporting::GetDefaultReportScheduler());
     NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
 
-    AttributePathParams * clusterInfo = InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.CreateObject();
-    clusterInfo->mEndpointId          = 1;
-    clusterInfo->mClusterId           = 1;
-    clusterInfo->mAttributeId         = 1;
+    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+    NL_TEST_ASSERT(apSuite, InsertToDirtySet(AttributePathParams(1, 1, 1)));
 
     {
         AttributePathParams testClusterInfo;
@@ -218,7 +224,7 @@ void TestReportingEngine::TestMergeOverlappedAttributePath(nlTestSuite * apSuite
         testClusterInfo.mAttributeId = kInvalidAttributeId;
         NL_TEST_ASSERT(apSuite,
                        InteractionModelEngine::GetInstance()->GetReportingEngine().MergeOverlappedAttributePath(testClusterInfo));
-        NL_TEST_ASSERT(apSuite, clusterInfo->mClusterId == kInvalidClusterId && clusterInfo->mAttributeId == kInvalidAttributeId);
+        NL_TEST_ASSERT(apSuite, VerifyDirtySetContent(testClusterInfo));
     }
 
     {
@@ -228,20 +234,104 @@ void TestReportingEngine::TestMergeOverlappedAttributePath(nlTestSuite * apSuite
         testClusterInfo.mAttributeId = kInvalidAttributeId;
         NL_TEST_ASSERT(apSuite,
                        InteractionModelEngine::GetInstance()->GetReportingEngine().MergeOverlappedAttributePath(testClusterInfo));
+        NL_TEST_ASSERT(apSuite, VerifyDirtySetContent(testClusterInfo));
+    }
+    InteractionModelEngine::GetInstance()->GetReportingEngine().Shutdown();
+}
+
+void TestReportingEngine::TestDirtySetGeneration(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    CHIP_ERROR err    = InteractionModelEngine::GetInstance()->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(),
+                                                                    app::reporting::GetDefaultReportScheduler());
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    engine.mGlobalDirtySet.ReleaseAll();
+
+    engine.BumpDirtySetGeneration();
+    uint64_t firstGeneration = engine.GetDirtySetGeneration();
+    NL_TEST_ASSERT(apSuite, engine.InsertPathIntoDirtySet(AttributePathParams(kTestEndpointId, kTestClusterId, 1)) == CHIP_NO_ERROR);
+
+    engine.BumpDirtySetGeneration();
+    NL_TEST_ASSERT(apSuite, engine.InsertPathIntoDirtySet(AttributePathParams(kTestEndpointId, kTestClusterId + 1)) == CHIP_NO_ERROR);
+
+    ConcreteAttributePath concretePath1(kTestEndpointId, kTestClusterId, 1);
+    ConcreteAttributePath concretePath2(kTestEndpointId, kTestClusterId, 2);
+    ConcreteAttributePath concretePath3(kTestEndpointId, kTestClusterId + 1, 3);
+
+    NL_TEST_ASSERT(apSuite, engine.mGlobalDirtySet.IsDirtySince(concretePath1, firstGeneration - 1));
+    NL_TEST_ASSERT(apSuite, !engine.mGlobalDirtySet.IsDirtySince(concretePath1, firstGeneration));
+    NL_TEST_ASSERT(apSuite, !engine.mGlobalDirtySet.IsDirtySince(concretePath2, firstGeneration - 1));
+    NL_TEST_ASSERT(apSuite, engine.mGlobalDirtySet.IsDirtySince(concretePath3, firstGeneration));
+
+    // Marking a covered path dirty again bumps the generation of the path covering it.
+    engine.BumpDirtySetGeneration();
+    NL_TEST_ASSERT(apSuite, engine.InsertPathIntoDirtySet(AttributePathParams(kTestEndpointId, kTestClusterId, 1)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, engine.mGlobalDirtySet.IsDirtySince(concretePath1, firstGeneration));
+    NL_TEST_ASSERT(apSuite, engine.GetGlobalDirtySetSize() == 2);
+
+    // A burst of writes to the same attributes does not grow the set.
+    for (uint32_t i = 0; i < 10 * CHIP_IM_SERVER_MAX_NUM_DIRTY_SET; i++)
+    {
+        engine.BumpDirtySetGeneration();
         NL_TEST_ASSERT(apSuite,
-                       clusterInfo->mEndpointId == kInvalidEndpointId && clusterInfo->mClusterId == kInvalidClusterId &&
-                           clusterInfo->mAttributeId == kInvalidAttributeId);
+                       engine.InsertPathIntoDirtySet(AttributePathParams(kTestEndpointId, kTestClusterId, 1 + (i % 2))) ==
+                           CHIP_NO_ERROR);
     }
+    NL_TEST_ASSERT(apSuite,
+                   VerifyDirtySetContent(AttributePathParams(kTestEndpointId, kTestClusterId, 1),
+                                         AttributePathParams(kTestEndpointId, kTestClusterId, 2),
+                                         AttributePathParams(kTestEndpointId, kTestClusterId + 1)));
+
     InteractionModelEngine::GetInstance()->GetReportingEngine().Shutdown();
 }
 
+void TestReportingEngine::TestDirtySetStorage(nlTestSuite * apSuite, void * apContext)
+{
+    // An inline set coalesces the paths once it holds CHIP_IM_SERVER_MAX_NUM_DIRTY_SET of them.
+    DirtySet inlineSet(ObjectPoolMem::kInline);
+    for (AttributeId i = 1; i <= CHIP_IM_SERVER_MAX_NUM_DIRTY_SET + 1; i++)
+    {
+        NL_TEST_ASSERT(apSuite, inlineSet.Insert(AttributePathParams(kTestEndpointId, kTestClusterId, i), 1) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(apSuite, inlineSet.Allocated() == 1);
+    NL_TEST_ASSERT(apSuite, inlineSet.GetStats().mClusterMergeCount == 1);
+    NL_TEST_ASSERT(apSuite, inlineSet.GetStats().mHighWaterMark == CHIP_IM_SERVER_MAX_NUM_DIRTY_SET);
+
+    NL_TEST_ASSERT(apSuite, inlineSet.Insert(AttributePathParams(kTestEndpointId, kTestClusterId, 1), 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, inlineSet.GetStats().mDedupCount == 1);
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    // A heap set grows instead, and never merges paths.
+    constexpr uint32_t kPathCount = 10 * CHIP_IM_SERVER_MAX_NUM_DIRTY_SET;
+    DirtySet heapSet(ObjectPoolMem::kHeap);
+    for (uint32_t i = 0; i < kPathCount; i++)
+    {
+        AttributePathParams path(static_cast<EndpointId>(i), ClusterId(i), AttributeId(i));
+        NL_TEST_ASSERT(apSuite, heapSet.Insert(path, i + 1) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(apSuite, heapSet.Allocated() == kPathCount);
+    NL_TEST_ASSERT(apSuite, heapSet.GetStats().mHighWaterMark == kPathCount);
+    NL_TEST_ASSERT(apSuite,
+                   heapSet.GetStats().mClusterMergeCount + heapSet.GetStats().mEndpointMergeCount +
+                           heapSet.GetStats().mFullMergeCount ==
+                       0);
+    for (uint32_t i = 0; i < kPathCount; i++)
+    {
+        ConcreteAttributePath path(static_cast<EndpointId>(i), ClusterId(i), AttributeId(i));
+        NL_TEST_ASSERT(apSuite, heapSet.IsDirtySince(path, i));
+        NL_TEST_ASSERT(apSuite, !heapSet.IsDirtySince(path, i + 1));
+    }
+    heapSet.ReleaseAll();
+    NL_TEST_ASSERT(apSuite, heapSet.Allocated() == 0);
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+}
+
 bool TestReportingEngine::InsertToDirtySet(const AttributePathParams & aPath)
 {
-    auto path = InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.CreateObject();
-    VerifyOrReturnError(path != nullptr, false);
-    *path             = aPath;
-    path->mGeneration = InteractionModelEngine::GetInstance()->GetReportingEngine().GetDirtySetGeneration();
-    return true;
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    return engine.mGlobalDirtySet.Insert(aPath, engine.GetDirtySetGeneration()) == CHIP_NO_ERROR;
 }
 
 void TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted(nlTestSuite * apSuite, void * apContext)
@@ -330,6 +420,95 @@ void TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted(nlTest
     InteractionModelEngine::GetInstance()->GetReportingEngine().Shutdown();
 }
 
+System::PacketBufferHandle TestReportingEngine::BuildReadRequest(nlTestSuite * apSuite, EndpointId aEndpointId,
+                                                                 ClusterId aFirstClusterId, size_t aNumClusters)
+{
+    System::PacketBufferTLVWriter writer;
+    System::PacketBufferHandle readRequestbuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    ReadRequestMessage::Builder readRequestBuilder;
+
+    writer.Init(std::move(readRequestbuf));
+    NL_TEST_ASSERT(apSuite, readRequestBuilder.Init(&writer) == CHIP_NO_ERROR);
+    AttributePathIBs::Builder & attributePathListBuilder = readRequestBuilder.CreateAttributeRequests();
+    for (size_t i = 0; i < aNumClusters; i++)
+    {
+        AttributePathIB::Builder & attributePathBuilder = attributePathListBuilder.CreatePath();
+        attributePathBuilder.Node(1)
+            .Endpoint(aEndpointId)
+            .Cluster(static_cast<ClusterId>(aFirstClusterId + i))
+            .Attribute(kTestFieldId1)
+            .EndOfAttributePathIB();
+        NL_TEST_ASSERT(apSuite, attributePathBuilder.GetError() == CHIP_NO_ERROR);
+    }
+    attributePathListBuilder.EndOfAttributePathIBs();
+    readRequestBuilder.IsFabricFiltered(false).EndOfReadRequestMessage();
+    NL_TEST_ASSERT(apSuite, readRequestBuilder.GetError() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, writer.Finalize(&readRequestbuf) == CHIP_NO_ERROR);
+    return readRequestbuf;
+}
+
+void TestReportingEngine::TestSetDirtyWithInterestIndex(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    constexpr size_t kNumHandlers          = 8;
+    constexpr size_t kClustersPerHandler   = 2;
+    constexpr uint32_t kIterationsPerRound = 1000;
+    DummyDelegate dummy;
+    TestExchangeDelegate delegate;
+    ReadHandler * handlers[kNumHandlers] = {};
+
+    CHIP_ERROR err = InteractionModelEngine::GetInstance()->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(),
+                                                                 app::reporting::GetDefaultReportScheduler());
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+
+    // Every handler is interested in its own set of clusters, so a change on one cluster must only reach one handler,
+    // and the cost of SetDirty must not grow with the number of handlers.
+    for (size_t i = 0; i < kNumHandlers; i++)
+    {
+        handlers[i] = Platform::New<ReadHandler>(dummy, ctx.NewExchangeToAlice(&delegate), ReadHandler::InteractionType::Read,
+                                                 app::reporting::GetDefaultReportScheduler());
+        NL_TEST_ASSERT(apSuite, handlers[i] != nullptr);
+        handlers[i]->OnInitialRequest(
+            BuildReadRequest(apSuite, kTestEndpointId, static_cast<ClusterId>(i * kClustersPerHandler + 1), kClustersPerHandler));
+        NL_TEST_ASSERT(apSuite, engine.GetInterestIndexSize() == (i + 1) * kClustersPerHandler);
+
+        AttributePathParams dirtyPath(kTestEndpointId, static_cast<ClusterId>(i * kClustersPerHandler + 1), kTestFieldId1);
+        NL_TEST_ASSERT(apSuite, engine.SetDirty(dirtyPath) == CHIP_NO_ERROR);
+        for (size_t j = 0; j <= i; j++)
+        {
+            NL_TEST_ASSERT(apSuite, (handlers[j]->mDirtyGeneration == engine.GetDirtySetGeneration()) == (i == j));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t k = 0; k < kIterationsPerRound; k++)
+        {
+            engine.SetDirty(dirtyPath);
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        ChipLogProgress(DataManagement, "SetDirty with %u handlers, %u interest paths: %u ns per call",
+                        static_cast<unsigned>(i + 1), static_cast<unsigned>(engine.GetInterestIndexSize()),
+                        static_cast<unsigned>(elapsed.count() / kIterationsPerRound));
+    }
+
+    // Wildcard changes can not be looked up in the index and must still reach every interested handler.
+    AttributePathParams wildcardPath(kTestEndpointId, kInvalidClusterId);
+    NL_TEST_ASSERT(apSuite, engine.SetDirty(wildcardPath) == CHIP_NO_ERROR);
+    for (auto * handler : handlers)
+    {
+        NL_TEST_ASSERT(apSuite, handler->mDirtyGeneration == engine.GetDirtySetGeneration());
+    }
+
+    for (auto * handler : handlers)
+    {
+        Platform::Delete(handler);
+    }
+    NL_TEST_ASSERT(apSuite, engine.GetInterestIndexSize() == 0);
+
+    ctx.DrainAndServiceIO();
+    engine.Shutdown();
+}
+
 } // namespace reporting
 } // namespace app
 } // namespace chip
@@ -341,6 +520,9 @@ const nlTest sTests[] =
     NL_TEST_DEF("CheckBuildAndSendSingleReportData", chip::app::reporting::TestReportingEngine::TestBuildAndSendSingleReportData),
     NL_TEST_DEF("TestMergeOverlappedAttributePath", chip::app::reporting::TestReportingEngine::TestMergeOverlappedAttributePath),
     NL_TEST_DEF("TestMergeAttributePathWhenDirtySetPoolExhausted", chip::app::reporting::TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted),
+    NL_TEST_DEF("TestDirtySetGeneration", chip::app::reporting::TestReportingEngine::TestDirtySetGeneration),
+    NL_TEST_DEF("TestDirtySetStorage", chip::app::reporting::TestReportingEngine::TestDirtySetStorage),
+    NL_TEST_DEF("TestSetDirtyWithInterestIndex", chip::app::reporting::TestReportingEngine::TestSetDirtyWithInterestIndex),
     NL_TEST_SENTINEL()
 };
 // clang-format on
@@ -0,0 +1,376 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/util/attribute-storage-index.h>
+
+#include <app/util/att-storage.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+namespace chip {
+namespace app {
+
+size_t AttributeStorageIndex::Hash(uintptr_t aPointer, uint32_t aId)
+{
+    // Pointers are aligned, fold their low bits away before mixing.
+    uint32_t hash = static_cast<uint32_t>(aPointer >> 3) * 0x85EBCA6Bu;
+    hash ^= (aId ^ (aId >> 16)) * 0x9E3779B1u;
+    hash ^= hash >> 15;
+    return hash;
+}
+
+size_t AttributeStorageIndex::SlotCountFor(size_t aEntryCount)
+{
+    // Keep the load factor at or below 1/2 so that probe sequences stay short and always end on a free slot.
+    size_t slotCount = 1;
+    while (slotCount < 2 * aEntryCount)
+    {
+        slotCount *= 2;
+    }
+    return slotCount;
+}
+
+bool AttributeStorageIndex::IsIndexed(const EmberAfDefinedEndpoint & aEndpoint)
+{
+    return aEndpoint.endpoint != kInvalidEndpointId && aEndpoint.endpointType != nullptr;
+}
+
+void AttributeStorageIndex::CountServerClusters(const EmberAfEndpointType * aEndpointType, size_t & aClusterCount,
+                                                size_t & aAttributeCount)
+{
+    for (uint8_t clusterIndex = 0; clusterIndex < aEndpointType->clusterCount; clusterIndex++)
+    {
+        const EmberAfCluster & cluster = aEndpointType->cluster[clusterIndex];
+        if ((cluster.mask & CLUSTER_MASK_SERVER) != 0)
+        {
+            aClusterCount++;
+            aAttributeCount += cluster.attributeCount;
+        }
+    }
+}
+
+AttributeStorageIndex::EndpointSlot * AttributeStorageIndex::FindEndpointSlot(EndpointId aEndpointId) const
+{
+    return Probe(mEndpoints, Hash(0, aEndpointId), [aEndpointId](const EndpointSlot & s) { return s.mEndpointId == aEndpointId; });
+}
+
+AttributeStorageIndex::EndpointTypeSlot *
+AttributeStorageIndex::FindEndpointTypeSlot(const EmberAfEndpointType * aEndpointType) const
+{
+    return Probe(mEndpointTypes, Hash(reinterpret_cast<uintptr_t>(aEndpointType), 0),
+                 [aEndpointType](const EndpointTypeSlot & s) { return s.mpEndpointType == aEndpointType; });
+}
+
+void AttributeStorageIndex::EraseEndpointSlot(EndpointSlot * aSlot)
+{
+    // Without tombstones, the entries following aSlot in its probe sequence are shifted back over the hole, unless their
+    // own probe sequence starts after the hole.
+    const size_t mask    = mEndpoints.AllocatedSize() - 1;
+    EndpointSlot * slots = mEndpoints.Get();
+    size_t hole          = static_cast<size_t>(aSlot - slots);
+    for (size_t index = (hole + 1) & mask; !IsFree(slots[index]); index = (index + 1) & mask)
+    {
+        const size_t home = Hash(0, slots[index].mEndpointId) & mask;
+        if (((index - home) & mask) >= ((index - hole) & mask))
+        {
+            slots[hole] = slots[index];
+            hole        = index;
+        }
+    }
+    slots[hole] = EndpointSlot{};
+    mEndpointCount--;
+}
+
+void AttributeStorageIndex::IndexEndpointType(const EmberAfEndpointType * aEndpointType)
+{
+    uint8_t serverClusterIndex = 0;
+    uint16_t clusterOffset     = 0;
+    for (uint8_t clusterIndex = 0; clusterIndex < aEndpointType->clusterCount; clusterIndex++)
+    {
+        const EmberAfCluster * cluster = &aEndpointType->cluster[clusterIndex];
+        if ((cluster->mask & CLUSTER_MASK_SERVER) != 0)
+        {
+            ClusterSlot * clusterSlot = Probe(mClusters, Hash(reinterpret_cast<uintptr_t>(aEndpointType), cluster->clusterId),
+                                              [aEndpointType, cluster](const ClusterSlot & slot) {
+                                                  return slot.mpEndpointType == aEndpointType &&
+                                                      slot.mpCluster->clusterId == cluster->clusterId;
+                                              });
+            // Only the first server cluster with a given id is reachable, as with a linear search.
+            if (IsFree(*clusterSlot))
+            {
+                clusterSlot->mpEndpointType               = aEndpointType;
+                clusterSlot->mpCluster                    = cluster;
+                clusterSlot->mLocation.serverClusterIndex = serverClusterIndex;
+                clusterSlot->mLocation.storageOffset      = clusterOffset;
+            }
+            serverClusterIndex++;
+
+            uint16_t attributeOffset = 0;
+            for (uint16_t attributeIndex = 0; attributeIndex < cluster->attributeCount; attributeIndex++)
+            {
+                const EmberAfAttributeMetadata * attribute = &cluster->attributes[attributeIndex];
+                AttributeSlot * attributeSlot =
+                    Probe(mAttributes, Hash(reinterpret_cast<uintptr_t>(cluster), attribute->attributeId),
+                          [cluster, attribute](const AttributeSlot & slot) {
+                              return slot.mpCluster == cluster && slot.mpAttribute->attributeId == attribute->attributeId;
+                          });
+                if (IsFree(*attributeSlot))
+                {
+                    attributeSlot->mpCluster                = cluster;
+                    attributeSlot->mpAttribute              = attribute;
+                    attributeSlot->mLocation.attributeIndex = attributeIndex;
+                    attributeSlot->mLocation.storageOffset  = attributeOffset;
+                }
+                if (!attribute->IsExternal() && !attribute->IsSingleton())
+                {
+                    attributeOffset = static_cast<uint16_t>(attributeOffset + attribute->size);
+                }
+            }
+        }
+        clusterOffset = static_cast<uint16_t>(clusterOffset + cluster->clusterSize);
+    }
+}
+
+CHIP_ERROR AttributeStorageIndex::Build(Span<const EmberAfDefinedEndpoint> aEndpoints, uint16_t aFixedEndpointCount)
+{
+    Invalidate();
+
+    size_t endpointCount = 0;
+    for (const EmberAfDefinedEndpoint & endpoint : aEndpoints)
+    {
+        endpointCount += IsIndexed(endpoint) ? 1 : 0;
+    }
+
+    // The endpoint types are counted through their own table, which is sized for one type per endpoint since their number
+    // is not known yet.
+    mEndpoints.Calloc(SlotCountFor(endpointCount));
+    mEndpointTypes.Calloc(SlotCountFor(endpointCount));
+    if (mEndpoints.Get() != nullptr && mEndpointTypes.Get() != nullptr)
+    {
+        for (const EmberAfDefinedEndpoint & endpoint : aEndpoints)
+        {
+            if (IsIndexed(endpoint))
+            {
+                EndpointTypeSlot * slot = FindEndpointTypeSlot(endpoint.endpointType);
+                if (IsFree(*slot))
+                {
+                    slot->mpEndpointType = endpoint.endpointType;
+                    mEndpointTypeCount++;
+                    CountServerClusters(endpoint.endpointType, mClusterCount, mAttributeCount);
+                }
+                slot->mEndpointCount++;
+            }
+        }
+        mClusters.Calloc(SlotCountFor(mClusterCount));
+        mAttributes.Calloc(SlotCountFor(mAttributeCount));
+    }
+    if (mEndpoints.Get() == nullptr || mEndpointTypes.Get() == nullptr || mClusters.Get() == nullptr ||
+        mAttributes.Get() == nullptr)
+    {
+        ChipLogError(Zcl, "Could not allocate the attribute storage index");
+        Invalidate();
+        mState = State::kFailed;
+        return CHIP_ERROR_NO_MEMORY;
+    }
+
+    uint16_t storageOffset = 0;
+    for (size_t i = 0; i < aEndpoints.size(); i++)
+    {
+        const EmberAfDefinedEndpoint & endpoint = aEndpoints[i];
+        if (IsIndexed(endpoint))
+        {
+            EndpointSlot * slot = FindEndpointSlot(endpoint.endpoint);
+            if (IsFree(*slot))
+            {
+                slot->mUsed          = true;
+                slot->mEndpointId    = endpoint.endpoint;
+                slot->mEndpointIndex = static_cast<uint16_t>(i);
+                slot->mStorageOffset = storageOffset;
+                mEndpointCount++;
+            }
+        }
+
+        // Only fixed endpoints use the built-in attribute storage.
+        if (i < aFixedEndpointCount && endpoint.endpointType != nullptr)
+        {
+            storageOffset = static_cast<uint16_t>(storageOffset + endpoint.endpointType->endpointSize);
+        }
+    }
+    mFixedEndpointCount   = aFixedEndpointCount;
+    mDynamicStorageOffset = storageOffset;
+
+    for (size_t i = 0; i < mEndpointTypes.AllocatedSize(); i++)
+    {
+        if (!IsFree(mEndpointTypes[i]))
+        {
+            IndexEndpointType(mEndpointTypes[i].mpEndpointType);
+        }
+    }
+
+    mState = State::kBuilt;
+    return CHIP_NO_ERROR;
+}
+
+void AttributeStorageIndex::Invalidate()
+{
+    mEndpoints.Free();
+    mEndpointTypes.Free();
+    mClusters.Free();
+    mAttributes.Free();
+    mEndpointCount     = 0;
+    mEndpointTypeCount = 0;
+    mClusterCount      = 0;
+    mAttributeCount    = 0;
+    mState             = State::kStale;
+}
+
+void AttributeStorageIndex::AddEndpoint(Span<const EmberAfDefinedEndpoint> aEndpoints, size_t aEndpointIndex)
+{
+    VerifyOrReturn(aEndpointIndex < aEndpoints.size() && IsIndexed(aEndpoints[aEndpointIndex]));
+    if (!IsBuilt() || aEndpointIndex < mFixedEndpointCount)
+    {
+        Invalidate();
+        return;
+    }
+
+    const EmberAfDefinedEndpoint & endpoint = aEndpoints[aEndpointIndex];
+    EndpointSlot * slot                     = FindEndpointSlot(endpoint.endpoint);
+    EndpointTypeSlot * typeSlot             = FindEndpointTypeSlot(endpoint.endpointType);
+    if (IsFree(*typeSlot))
+    {
+        size_t clusterCount   = mClusterCount;
+        size_t attributeCount = mAttributeCount;
+        CountServerClusters(endpoint.endpointType, clusterCount, attributeCount);
+        // Running out of room triggers a rebuild, which sizes the tables for at least twice as many entries.
+        if (!HasRoomFor(mEndpointTypes, mEndpointTypeCount + 1) || !HasRoomFor(mClusters, clusterCount) ||
+            !HasRoomFor(mAttributes, attributeCount) || (IsFree(*slot) && !HasRoomFor(mEndpoints, mEndpointCount + 1)))
+        {
+            Invalidate();
+            return;
+        }
+        typeSlot->mpEndpointType = endpoint.endpointType;
+        mEndpointTypeCount++;
+        mClusterCount   = clusterCount;
+        mAttributeCount = attributeCount;
+        IndexEndpointType(endpoint.endpointType);
+    }
+    else if (IsFree(*slot) && !HasRoomFor(mEndpoints, mEndpointCount + 1))
+    {
+        Invalidate();
+        return;
+    }
+    typeSlot->mEndpointCount++;
+
+    // As with a linear search, the first endpoint with a given id in the table is the one found.
+    if (IsFree(*slot) || slot->mEndpointIndex > aEndpointIndex)
+    {
+        mEndpointCount += IsFree(*slot) ? 1 : 0;
+        slot->mUsed          = true;
+        slot->mEndpointId    = endpoint.endpoint;
+        slot->mEndpointIndex = static_cast<uint16_t>(aEndpointIndex);
+        slot->mStorageOffset = mDynamicStorageOffset;
+    }
+}
+
+void AttributeStorageIndex::RemoveEndpoint(Span<const EmberAfDefinedEndpoint> aEndpoints, size_t aEndpointIndex)
+{
+    VerifyOrReturn(aEndpointIndex < aEndpoints.size() && IsIndexed(aEndpoints[aEndpointIndex]));
+    if (!IsBuilt() || aEndpointIndex < mFixedEndpointCount)
+    {
+        Invalidate();
+        return;
+    }
+
+    const EmberAfDefinedEndpoint & endpoint = aEndpoints[aEndpointIndex];
+    EndpointTypeSlot * typeSlot             = FindEndpointTypeSlot(endpoint.endpointType);
+    if (IsFree(*typeSlot) || typeSlot->mEndpointCount <= 1)
+    {
+        Invalidate();
+        return;
+    }
+    typeSlot->mEndpointCount--;
+
+    // Dynamic endpoint ids are unique among dynamic endpoints, and fixed endpoints come first in the table, so no other
+    // endpoint takes over the id.
+    EndpointSlot * slot = FindEndpointSlot(endpoint.endpoint);
+    if (!IsFree(*slot) && slot->mEndpointIndex == aEndpointIndex)
+    {
+        EraseEndpointSlot(slot);
+    }
+}
+
+uint16_t AttributeStorageIndex::FindEndpointIndex(EndpointId aEndpointId, uint16_t * aStorageOffset) const
+{
+    VerifyOrReturnValue(IsBuilt() && aEndpointId != kInvalidEndpointId, kInvalidEndpointIndex);
+
+    const EndpointSlot * slot = FindEndpointSlot(aEndpointId);
+    VerifyOrReturnValue(!IsFree(*slot), kInvalidEndpointIndex);
+
+    if (aStorageOffset != nullptr)
+    {
+        *aStorageOffset = slot->mStorageOffset;
+    }
+    return slot->mEndpointIndex;
+}
+
+bool AttributeStorageIndex::ContainsEndpointType(const EmberAfEndpointType * aEndpointType) const
+{
+    VerifyOrReturnValue(IsBuilt() && aEndpointType != nullptr, false);
+
+    return !IsFree(*FindEndpointTypeSlot(aEndpointType));
+}
+
+const EmberAfCluster * AttributeStorageIndex::FindServerCluster(const EmberAfEndpointType * aEndpointType, ClusterId aClusterId,
+                                                                ClusterLocation * aLocation) const
+{
+    VerifyOrReturnValue(IsBuilt(), nullptr);
+
+    const ClusterSlot * slot =
+        Probe(mClusters, Hash(reinterpret_cast<uintptr_t>(aEndpointType), aClusterId),
+              [aEndpointType, aClusterId](const ClusterSlot & s) {
+                  return s.mpEndpointType == aEndpointType && s.mpCluster->clusterId == aClusterId;
+              });
+    VerifyOrReturnValue(!IsFree(*slot), nullptr);
+
+    if (aLocation != nullptr)
+    {
+        *aLocation = slot->mLocation;
+    }
+    return slot->mpCluster;
+}
+
+const EmberAfAttributeMetadata * AttributeStorageIndex::FindAttribute(const EmberAfCluster * aCluster, AttributeId aAttributeId,
+                                                                      AttributeLocation * aLocation) const
+{
+    VerifyOrReturnValue(IsBuilt(), nullptr);
+
+    const AttributeSlot * slot =
+        Probe(mAttributes, Hash(reinterpret_cast<uintptr_t>(aCluster), aAttributeId),
+              [aCluster, aAttributeId](const AttributeSlot & s) {
+                  return s.mpCluster == aCluster && s.mpAttribute->attributeId == aAttributeId;
+              });
+    VerifyOrReturnValue(!IsFree(*slot), nullptr);
+
+    if (aLocation != nullptr)
+    {
+        *aLocation = slot->mLocation;
+    }
+    return slot->mpAttribute;
+}
+
+} // namespace app
+} // namespace chip
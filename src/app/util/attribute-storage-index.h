@@ -0,0 +1,213 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/util/af-types.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/Span.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * Hash index over the endpoint table of attribute-storage.cpp, mapping an endpoint id to its index in the table, a
+ * (endpoint type, cluster id) pair to its server cluster and a (cluster, attribute id) pair to its metadata, together
+ * with the offsets needed to locate the attribute in the built-in attribute storage.
+ *
+ * Endpoint types and clusters are shared by every endpoint using them, so the cluster and attribute entries only grow
+ * with the number of distinct endpoint types, not with the number of (dynamic) endpoints.
+ *
+ * The index keeps pointers into the endpoint table. Dynamic endpoints being set up or cleared are reported through
+ * AddEndpoint() and RemoveEndpoint(); any other change of the id or type of an entry of that table, or of the number of
+ * endpoints, requires invalidating the index. The enabled state of the endpoints is not part of the index.
+ */
+class AttributeStorageIndex
+{
+public:
+    static constexpr uint16_t kInvalidEndpointIndex = 0xFFFF;
+
+    struct ClusterLocation
+    {
+        /// Index of the cluster among the server clusters of its endpoint type.
+        uint8_t serverClusterIndex = 0;
+        /// Offset of the cluster storage from the start of its endpoint storage.
+        uint16_t storageOffset = 0;
+    };
+
+    struct AttributeLocation
+    {
+        /// Index of the attribute in its cluster.
+        uint16_t attributeIndex = 0;
+        /// Offset of the attribute storage from the start of its cluster storage.
+        uint16_t storageOffset = 0;
+    };
+
+    /**
+     * Build the index for the given endpoint table. The first aFixedEndpointCount endpoints are fixed endpoints, whose
+     * attributes may use the built-in attribute storage.
+     *
+     * @retval #CHIP_NO_ERROR On success.
+     * @retval #CHIP_ERROR_NO_MEMORY If the index could not be allocated. The index stays unusable until invalidated.
+     */
+    CHIP_ERROR Build(Span<const EmberAfDefinedEndpoint> aEndpoints, uint16_t aFixedEndpointCount);
+
+    /**
+     * Release the index. The next lookup through NeedsBuild()/Build() rebuilds it.
+     */
+    void Invalidate();
+
+    /**
+     * Add the dynamic endpoint at aEndpointIndex of aEndpoints, which has just been set up there, to the index. Invalidates
+     * the index instead if it is not built or has no room left for the endpoint.
+     */
+    void AddEndpoint(Span<const EmberAfDefinedEndpoint> aEndpoints, size_t aEndpointIndex);
+
+    /**
+     * Remove the dynamic endpoint at aEndpointIndex of aEndpoints from the index, before that entry is cleared. Invalidates
+     * the index instead if it is not built or if that endpoint is the last one using its endpoint type, so that the
+     * clusters of the type are dropped as well.
+     */
+    void RemoveEndpoint(Span<const EmberAfDefinedEndpoint> aEndpoints, size_t aEndpointIndex);
+
+    bool NeedsBuild() const { return mState == State::kStale; }
+    bool IsBuilt() const { return mState == State::kBuilt; }
+
+    /**
+     * Returns the index in the endpoint table of the first endpoint with the given id, or kInvalidEndpointIndex.
+     * Disabled endpoints are included. If found and aStorageOffset is not null, it is set to the offset of the
+     * endpoint storage in the built-in attribute storage.
+     */
+    uint16_t FindEndpointIndex(EndpointId aEndpointId, uint16_t * aStorageOffset = nullptr) const;
+
+    /**
+     * Returns whether the clusters of aEndpointType are indexed, i.e. whether FindServerCluster() can be trusted for it.
+     */
+    bool ContainsEndpointType(const EmberAfEndpointType * aEndpointType) const;
+
+    /**
+     * Returns the first server cluster with the given id in aEndpointType, or nullptr. aEndpointType must be indexed.
+     */
+    const EmberAfCluster * FindServerCluster(const EmberAfEndpointType * aEndpointType, ClusterId aClusterId,
+                                             ClusterLocation * aLocation = nullptr) const;
+
+    /**
+     * Returns the metadata of the given attribute of aCluster, or nullptr. aCluster must have been returned by
+     * FindServerCluster().
+     */
+    const EmberAfAttributeMetadata * FindAttribute(const EmberAfCluster * aCluster, AttributeId aAttributeId,
+                                                   AttributeLocation * aLocation = nullptr) const;
+
+private:
+    enum class State : uint8_t
+    {
+        kStale,
+        kBuilt,
+        kFailed,
+    };
+
+    // Slots are calloc'ed: a slot with a null (or false) first member is free.
+    struct EndpointSlot
+    {
+        bool mUsed;
+        EndpointId mEndpointId;
+        uint16_t mEndpointIndex;
+        uint16_t mStorageOffset;
+    };
+
+    struct EndpointTypeSlot
+    {
+        const EmberAfEndpointType * mpEndpointType;
+        // Number of indexed endpoints using the endpoint type.
+        size_t mEndpointCount;
+    };
+
+    struct ClusterSlot
+    {
+        const EmberAfEndpointType * mpEndpointType;
+        const EmberAfCluster * mpCluster;
+        ClusterLocation mLocation;
+    };
+
+    struct AttributeSlot
+    {
+        const EmberAfCluster * mpCluster;
+        const EmberAfAttributeMetadata * mpAttribute;
+        AttributeLocation mLocation;
+    };
+
+    template <typename Slot>
+    using Table = Platform::ScopedMemoryBufferWithSize<Slot>;
+
+    // Finds the slot for which aMatches() holds, or the free slot ending the probe sequence starting at aHash.
+    template <typename Slot, typename Matches>
+    static Slot * Probe(const Table<Slot> & aTable, size_t aHash, Matches && aMatches)
+    {
+        const size_t mask = aTable.AllocatedSize() - 1;
+        Slot * slots      = const_cast<Slot *>(aTable.Get());
+        for (size_t index = aHash & mask;; index = (index + 1) & mask)
+        {
+            if (IsFree(slots[index]) || aMatches(slots[index]))
+            {
+                return &slots[index];
+            }
+        }
+    }
+
+    static bool IsFree(const EndpointSlot & aSlot) { return !aSlot.mUsed; }
+    static bool IsFree(const EndpointTypeSlot & aSlot) { return aSlot.mpEndpointType == nullptr; }
+    static bool IsFree(const ClusterSlot & aSlot) { return aSlot.mpEndpointType == nullptr; }
+    static bool IsFree(const AttributeSlot & aSlot) { return aSlot.mpCluster == nullptr; }
+
+    template <typename Slot>
+    static bool HasRoomFor(const Table<Slot> & aTable, size_t aEntryCount)
+    {
+        return 2 * aEntryCount <= aTable.AllocatedSize();
+    }
+
+    static size_t Hash(uintptr_t aPointer, uint32_t aId);
+    static size_t SlotCountFor(size_t aEntryCount);
+
+    static bool IsIndexed(const EmberAfDefinedEndpoint & aEndpoint);
+    static void CountServerClusters(const EmberAfEndpointType * aEndpointType, size_t & aClusterCount, size_t & aAttributeCount);
+
+    EndpointSlot * FindEndpointSlot(EndpointId aEndpointId) const;
+    EndpointTypeSlot * FindEndpointTypeSlot(const EmberAfEndpointType * aEndpointType) const;
+    void EraseEndpointSlot(EndpointSlot * aSlot);
+    void IndexEndpointType(const EmberAfEndpointType * aEndpointType);
+
+    Table<EndpointSlot> mEndpoints;
+    Table<EndpointTypeSlot> mEndpointTypes;
+    Table<ClusterSlot> mClusters;
+    Table<AttributeSlot> mAttributes;
+    // Number of entries of each table; cluster and attribute entries are counted before dropping duplicate ids.
+    size_t mEndpointCount          = 0;
+    size_t mEndpointTypeCount      = 0;
+    size_t mClusterCount           = 0;
+    size_t mAttributeCount         = 0;
+    uint16_t mFixedEndpointCount   = 0;
+    uint16_t mDynamicStorageOffset = 0;
+    State mState                   = State::kStale;
+};
+
+} // namespace app
+} // namespace chip
@@ -18,6 +18,7 @@
 #include <app/util/attribute-storage.h>
 
 #include <app/util/attribute-storage-detail.h>
+#include <app/util/attribute-storage-index.h>
 
 #include <app/AttributeAccessInterfaceRegistry.h>
 #include <app/AttributePersistenceProvider.h>
@@ -92,6 +93,52 @@ uint8_t singletonAttributeData[ACTUAL_SINGLETONS_SIZE];
 
 uint16_t emberEndpointCount = 0;
 
+#if CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX
+static_assert(AttributeStorageIndex::kInvalidEndpointIndex == kEmberInvalidEndpointIndex,
+              "The attribute storage index must use the same invalid endpoint index");
+
+AttributeStorageIndex attributeStorageIndex;
+
+// Returns the index over emAfEndpoints, building it if emAfEndpoints changed since it was last built, or nullptr if it
+// could not be built, in which case callers fall back to scanning emAfEndpoints.
+const AttributeStorageIndex * getAttributeStorageIndex()
+{
+    if (attributeStorageIndex.NeedsBuild())
+    {
+        // On failure, the index stays unusable until emAfEndpoints changes again.
+        LogErrorOnFailure(
+            attributeStorageIndex.Build(Span<const EmberAfDefinedEndpoint>(emAfEndpoints, emberEndpointCount), FIXED_ENDPOINT_COUNT));
+    }
+    return attributeStorageIndex.IsBuilt() ? &attributeStorageIndex : nullptr;
+}
+#endif // CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX
+
+// Must be called whenever the id or type of an entry of emAfEndpoints, or the endpoint count, changes, unless the change
+// is reported through addToAttributeStorageIndex() or removeFromAttributeStorageIndex().
+void invalidateAttributeStorageIndex()
+{
+#if CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX
+    attributeStorageIndex.Invalidate();
+#endif // CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX
+}
+
+// Updates the index for the dynamic endpoint just set up at the given index of emAfEndpoints, so that setting up many
+// dynamic endpoints does not rebuild the index every time.
+void addToAttributeStorageIndex(uint16_t endpointIndex)
+{
+#if CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX
+    attributeStorageIndex.AddEndpoint(Span<const EmberAfDefinedEndpoint>(emAfEndpoints, emberEndpointCount), endpointIndex);
+#endif // CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX
+}
+
+// Updates the index for the dynamic endpoint at the given index of emAfEndpoints, which is about to be cleared.
+void removeFromAttributeStorageIndex(uint16_t endpointIndex)
+{
+#if CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX
+    attributeStorageIndex.RemoveEndpoint(Span<const EmberAfDefinedEndpoint>(emAfEndpoints, emberEndpointCount), endpointIndex);
+#endif // CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX
+}
+
 // If we have attributes that are more than 4 bytes, then
 // we need this data block for the defaults
 #if (defined(GENERATED_DEFAULTS) && GENERATED_DEFAULTS_COUNT)
@@ -152,8 +199,22 @@ uint16_t findIndexFromEndpoint(EndpointId endpoint, bool ignoreDisabledEndpoints
         return kEmberInvalidEndpointIndex;
     }
 
-    uint16_t epi;
-    for (epi = 0; epi < emberAfEndpointCount(); epi++)
+    uint16_t epi = 0;
+#if CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX
+    if (const AttributeStorageIndex * storageIndex = getAttributeStorageIndex())
+    {
+        epi = storageIndex->FindEndpointIndex(endpoint);
+        if (epi == kEmberInvalidEndpointIndex || !ignoreDisabledEndpoints ||
+            emAfEndpoints[epi].bitmask.Has(EmberAfEndpointOptions::isEnabled))
+        {
+            return epi;
+        }
+        // The first endpoint with that id is disabled, only a reused id can still match.
+        epi++;
+    }
+#endif // CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX
+
+    for (; epi < emberAfEndpointCount(); epi++)
     {
         if (emAfEndpoints[epi].endpoint == endpoint &&
             (!ignoreDisabledEndpoints || emAfEndpoints[epi].bitmask.Has(EmberAfEndpointOptions::isEnabled)))
@@ -235,11 +296,18 @@ void emberAfEndpointConfigure()
         }
     }
 #endif
+
+    invalidateAttributeStorageIndex();
 }
 
 void emberAfSetDynamicEndpointCount(uint16_t dynamicEndpointCount)
 {
-    emberEndpointCount = static_cast<uint16_t>(FIXED_ENDPOINT_COUNT + dynamicEndpointCount);
+    const uint16_t endpointCount = static_cast<uint16_t>(FIXED_ENDPOINT_COUNT + dynamicEndpointCount);
+    if (endpointCount != emberEndpointCount)
+    {
+        emberEndpointCount = endpointCount;
+        invalidateAttributeStorageIndex();
+    }
 }
 
 uint16_t emberAfGetDynamicIndexFromEndpoint(EndpointId id)
@@ -290,6 +358,10 @@ CHIP_ERROR emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const EmberA
         }
     }
 
+    emberAfSetDynamicEndpointCount(MAX_ENDPOINT_COUNT - FIXED_ENDPOINT_COUNT);
+
+    // An endpoint still set up at this index is replaced.
+    removeFromAttributeStorageIndex(index);
     emAfEndpoints[index].endpoint       = id;
     emAfEndpoints[index].deviceTypeList = deviceTypeList;
     emAfEndpoints[index].endpointType   = ep;
@@ -297,8 +369,7 @@ CHIP_ERROR emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const EmberA
     // Start the endpoint off as disabled.
     emAfEndpoints[index].bitmask.Clear(EmberAfEndpointOptions::isEnabled);
     emAfEndpoints[index].parentEndpointId = parentEndpointId;
-
-    emberAfSetDynamicEndpointCount(MAX_ENDPOINT_COUNT - FIXED_ENDPOINT_COUNT);
+    addToAttributeStorageIndex(index);
 
     // Initialize the data versions.
     size_t dataSize = sizeof(DataVersion) * serverClusterCount;
@@ -328,6 +399,7 @@ EndpointId emberAfClearDynamicEndpoint(uint16_t index)
     {
         ep = emAfEndpoints[index].endpoint;
         emberAfEndpointEnableDisable(ep, false);
+        removeFromAttributeStorageIndex(index);
         emAfEndpoints[index].endpoint = kInvalidEndpointId;
     }
 
@@ -557,6 +629,91 @@ bool emAfMatchAttribute(const EmberAfCluster * cluster, const EmberAfAttributeMe
     return (am->attributeId == attRecord->attributeId);
 }
 
+// Reads or writes the attribute described by am, whose built-in storage (if any) is at attributeOffsetIndex in
+// attributeData.  See emAfReadOrWriteAttribute for the semantics of the other arguments.
+static Status readOrWriteAttributeAt(const EmberAfAttributeSearchRecord * attRecord, const EmberAfAttributeMetadata * am,
+                                     uint16_t attributeOffsetIndex, bool isDynamicEndpoint,
+                                     const EmberAfAttributeMetadata ** metadata, uint8_t * buffer, uint16_t readLength, bool write)
+{
+    // If passed metadata location is not null, populate
+    if (metadata != nullptr)
+    {
+        *metadata = am;
+    }
+
+    uint8_t * attributeLocation =
+        (am->mask & ATTRIBUTE_MASK_SINGLETON ? singletonAttributeLocation(am) : attributeData + attributeOffsetIndex);
+    uint8_t *src, *dst;
+    if (write)
+    {
+        src = buffer;
+        dst = attributeLocation;
+        if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId, am->attributeId))
+        {
+            return Status::UnsupportedAccess;
+        }
+    }
+    else
+    {
+        if (buffer == nullptr)
+        {
+            return Status::Success;
+        }
+
+        src = attributeLocation;
+        dst = buffer;
+        if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId, am->attributeId))
+        {
+            return Status::UnsupportedAccess;
+        }
+    }
+
+    // Is the attribute externally stored?
+    if (am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE)
+    {
+        return (write ? emberAfExternalAttributeWriteCallback(attRecord->endpoint, attRecord->clusterId, am, buffer)
+                      : emberAfExternalAttributeReadCallback(attRecord->endpoint, attRecord->clusterId, am, buffer,
+                                                             emberAfAttributeSize(am)));
+    }
+
+    // Internal storage is only supported for fixed endpoints
+    if (!isDynamicEndpoint)
+    {
+        return typeSensitiveMemCopy(attRecord->clusterId, dst, src, am, write, readLength);
+    }
+
+    return Status::Failure;
+}
+
+#if CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX
+// Same as the scan in emAfReadOrWriteAttribute for the enabled endpoint at index ep, using the index to find the
+// cluster and attribute and their storage offsets.
+static Status readOrWriteIndexedAttribute(const AttributeStorageIndex & storageIndex, uint16_t ep, uint16_t endpointOffsetIndex,
+                                          const EmberAfAttributeSearchRecord * attRecord, const EmberAfAttributeMetadata ** metadata,
+                                          uint8_t * buffer, uint16_t readLength, bool write)
+{
+    AttributeStorageIndex::ClusterLocation clusterLocation;
+    const EmberAfCluster * cluster =
+        storageIndex.FindServerCluster(emAfEndpoints[ep].endpointType, attRecord->clusterId, &clusterLocation);
+    if (cluster == nullptr)
+    {
+        return Status::UnsupportedCluster;
+    }
+
+    AttributeStorageIndex::AttributeLocation attributeLocation;
+    const EmberAfAttributeMetadata * am = storageIndex.FindAttribute(cluster, attRecord->attributeId, &attributeLocation);
+    if (am == nullptr)
+    {
+        return Status::UnsupportedAttribute;
+    }
+
+    uint16_t attributeOffsetIndex =
+        static_cast<uint16_t>(endpointOffsetIndex + clusterLocation.storageOffset + attributeLocation.storageOffset);
+    return readOrWriteAttributeAt(attRecord, am, attributeOffsetIndex, ep >= emberAfFixedEndpointCount(), metadata, buffer,
+                                  readLength, write);
+}
+#endif // CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX
+
 // When reading non-string attributes, this function returns an error when destination
 // buffer isn't large enough to accommodate the attribute type.  For strings, the
 // function will copy at most readLength bytes.  This means the resulting string
@@ -575,6 +732,24 @@ Status emAfReadOrWriteAttribute(const EmberAfAttributeSearchRecord * attRecord,
 {
     assertChipStackLockedByCurrentThread();
 
+#if CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX
+    if (const AttributeStorageIndex * storageIndex = getAttributeStorageIndex())
+    {
+        uint16_t endpointOffsetIndex = 0;
+        uint16_t ep                  = storageIndex->FindEndpointIndex(attRecord->endpoint, &endpointOffsetIndex);
+        if (ep == kEmberInvalidEndpointIndex)
+        {
+            return Status::UnsupportedEndpoint;
+        }
+        // If the first endpoint with that id is disabled, only a reused id can still match: leave that to the scan below.
+        if (emberAfEndpointIndexIsEnabled(ep))
+        {
+            return readOrWriteIndexedAttribute(*storageIndex, ep, endpointOffsetIndex, attRecord, metadata, buffer, readLength,
+                                               write);
+        }
+    }
+#endif // CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX
+
     uint16_t attributeOffsetIndex = 0;
 
     for (uint16_t ep = 0; ep < emberAfEndpointCount(); ep++)
@@ -601,68 +776,15 @@ Status emAfReadOrWriteAttribute(const EmberAfAttributeSearchRecord * attRecord,
                         const EmberAfAttributeMetadata * am = &(cluster->attributes[attrIndex]);
                         if (emAfMatchAttribute(cluster, am, attRecord))
                         { // Got the attribute
-                            // If passed metadata location is not null, populate
-                            if (metadata != nullptr)
-                            {
-                                *metadata = am;
-                            }
-
-                            {
-                                uint8_t * attributeLocation =
-                                    (am->mask & ATTRIBUTE_MASK_SINGLETON ? singletonAttributeLocation(am)
-                                                                         : attributeData + attributeOffsetIndex);
-                                uint8_t *src, *dst;
-                                if (write)
-                                {
-                                    src = buffer;
-                                    dst = attributeLocation;
-                                    if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                             am->attributeId))
-                                    {
-                                        return Status::UnsupportedAccess;
-                                    }
-                                }
-                                else
-                                {
-                                    if (buffer == nullptr)
-                                    {
-                                        return Status::Success;
-                                    }
-
-                                    src = attributeLocation;
-                                    dst = buffer;
-                                    if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                            am->attributeId))
-                                    {
-                                        return Status::UnsupportedAccess;
-                                    }
-                                }
-
-                                // Is the attribute externally stored?
-                                if (am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE)
-                                {
-                                    return (write ? emberAfExternalAttributeWriteCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                                          am, buffer)
-                                                  : emberAfExternalAttributeReadCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                                         am, buffer, emberAfAttributeSize(am)));
-                                }
-
-                                // Internal storage is only supported for fixed endpoints
-                                if (!isDynamicEndpoint)
-                                {
-                                    return typeSensitiveMemCopy(attRecord->clusterId, dst, src, am, write, readLength);
-                                }
-
-                                return Status::Failure;
-                            }
+                            return readOrWriteAttributeAt(attRecord, am, attributeOffsetIndex, isDynamicEndpoint, metadata, buffer,
+                                                          readLength, write);
                         }
-                        else
-                        { // Not the attribute we are looking for
-                            // Increase the index if attribute is not externally stored
-                            if (!(am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE) && !(am->mask & ATTRIBUTE_MASK_SINGLETON))
-                            {
-                                attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + emberAfAttributeSize(am));
-                            }
+
+                        // Not the attribute we are looking for
+                        // Increase the index if attribute is not externally stored
+                        if (!(am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE) && !(am->mask & ATTRIBUTE_MASK_SINGLETON))
+                        {
+                            attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + emberAfAttributeSize(am));
                         }
                     }
 
@@ -701,6 +823,21 @@ const EmberAfEndpointType * emberAfFindEndpointType(chip::EndpointId endpointId)
 const EmberAfCluster * emberAfFindClusterInType(const EmberAfEndpointType * endpointType, ClusterId clusterId,
                                                 EmberAfClusterMask mask, uint8_t * index)
 {
+#if CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX
+    // Only server clusters are indexed, and only for the endpoint types currently in use.
+    const AttributeStorageIndex * storageIndex = (mask == CLUSTER_MASK_SERVER) ? getAttributeStorageIndex() : nullptr;
+    if (storageIndex != nullptr && storageIndex->ContainsEndpointType(endpointType))
+    {
+        AttributeStorageIndex::ClusterLocation location;
+        const EmberAfCluster * cluster = storageIndex->FindServerCluster(endpointType, clusterId, &location);
+        if (cluster != nullptr && index != nullptr)
+        {
+            *index = location.serverClusterIndex;
+        }
+        return cluster;
+    }
+#endif // CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX
+
     uint8_t i;
     uint8_t scopedIndex = 0;
 
@@ -729,7 +866,16 @@ const EmberAfCluster * emberAfFindClusterInType(const EmberAfEndpointType * endp
 
 uint8_t emberAfClusterIndex(EndpointId endpoint, ClusterId clusterId, EmberAfClusterMask mask)
 {
-    for (uint16_t ep = 0; ep < emberAfEndpointCount(); ep++)
+    uint16_t firstEp = 0;
+#if CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX
+    if (const AttributeStorageIndex * storageIndex = getAttributeStorageIndex())
+    {
+        // Endpoints before the first one with that id cannot match.
+        firstEp = storageIndex->FindEndpointIndex(endpoint);
+    }
+#endif // CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX
+
+    for (uint16_t ep = firstEp; ep < emberAfEndpointCount(); ep++)
     {
         // Check the endpoint id first, because that way we avoid examining the
         // endpoint type for endpoints that are not actually defined.
@@ -1453,10 +1599,8 @@ DataVersion * emberAfDataVersionStorage(const chip::app::ConcreteClusterPath & a
         return nullptr;
     }
 
-    // This does a second walk over endpoints to find the right one, but
-    // probably worth it to avoid duplicating code.
-    auto clusterIndex = emberAfClusterIndex(aConcreteClusterPath.mEndpointId, aConcreteClusterPath.mClusterId, CLUSTER_MASK_SERVER);
-    if (clusterIndex == 0xFF)
+    uint8_t clusterIndex;
+    if (emberAfFindClusterInType(ep.endpointType, aConcreteClusterPath.mClusterId, CLUSTER_MASK_SERVER, &clusterIndex) == nullptr)
     {
         // No such cluster on this endpoint.
         return nullptr;
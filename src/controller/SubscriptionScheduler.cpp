@@ -0,0 +1,425 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <controller/SubscriptionScheduler.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/TypeTraits.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+
+namespace chip {
+namespace Controller {
+
+void SubscriptionScheduler::Stage::TimerFired()
+{
+    mBackingOff = false;
+    mScheduler.Dispatch();
+}
+
+bool SubscriptionScheduler::Stage::HasQueued() const
+{
+    for (const auto & queue : mQueues)
+    {
+        if (!queue.empty())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t SubscriptionScheduler::Stage::QueuedCount() const
+{
+    size_t count = 0;
+    for (const auto & queue : mQueues)
+    {
+        count += queue.size();
+    }
+    return count;
+}
+
+NodeId SubscriptionScheduler::Stage::PopQueued()
+{
+    for (auto & queue : mQueues)
+    {
+        if (!queue.empty())
+        {
+            NodeId nodeId = queue.front();
+            queue.pop_front();
+            return nodeId;
+        }
+    }
+    return kUndefinedNodeId;
+}
+
+void SubscriptionScheduler::Stage::Clear()
+{
+    for (auto & queue : mQueues)
+    {
+        queue.clear();
+    }
+    mInFlight       = 0;
+    mBackingOff     = false;
+    mAwaitingCaller = false;
+}
+
+CHIP_ERROR SubscriptionScheduler::Init(Delegate * apDelegate, TimerDelegate * apTimerDelegate)
+{
+    return Init(apDelegate, apTimerDelegate, Config());
+}
+
+CHIP_ERROR SubscriptionScheduler::Init(Delegate * apDelegate, TimerDelegate * apTimerDelegate, const Config & aConfig)
+{
+    VerifyOrReturnError(mpDelegate == nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(apDelegate != nullptr && apTimerDelegate != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aConfig.mMaxSessionSetups > 0 && aConfig.mMaxSubscribeRequests > 0 && aConfig.mMaxAttempts > 0,
+                        CHIP_ERROR_INVALID_ARGUMENT);
+
+    mpDelegate      = apDelegate;
+    mpTimerDelegate = apTimerDelegate;
+    mConfig         = aConfig;
+
+    mSessionStage.mMaxWindow   = mConfig.mMaxSessionSetups;
+    mSubscribeStage.mMaxWindow = mConfig.mMaxSubscribeRequests;
+
+    for (Stage * stage : { &mSessionStage, &mSubscribeStage })
+    {
+        stage->Clear();
+        stage->mWindow  = stage->mMaxWindow;
+        stage->mBackoff = mConfig.mInitialBackoff;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void SubscriptionScheduler::Shutdown()
+{
+    VerifyOrReturn(mpDelegate != nullptr);
+
+    for (Stage * stage : { &mSessionStage, &mSubscribeStage })
+    {
+        mpTimerDelegate->CancelTimer(stage);
+        stage->Clear();
+    }
+
+    mNodes.clear();
+    mSubscribed = 0;
+    mFailed     = 0;
+    mBackoffs   = 0;
+
+    mpDelegate      = nullptr;
+    mpTimerDelegate = nullptr;
+}
+
+CHIP_ERROR SubscriptionScheduler::ScheduleSubscription(NodeId aNodeId, Priority aPriority)
+{
+    VerifyOrReturnError(mpDelegate != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(to_underlying(aPriority) < kPriorityCount, CHIP_ERROR_INVALID_ARGUMENT);
+
+    Node node = { aPriority, State::kQueued, 0 };
+
+    auto it = mNodes.find(aNodeId);
+    if (it == mNodes.end())
+    {
+        mNodes.emplace(aNodeId, node);
+    }
+    else
+    {
+        State state = it->second.mState;
+        VerifyOrReturnError(state == State::kSubscribed || state == State::kFailed, CHIP_ERROR_DUPLICATE_KEY_ID);
+        if (state == State::kSubscribed)
+        {
+            mSubscribed--;
+        }
+        else
+        {
+            mFailed--;
+        }
+        it->second = node;
+    }
+
+    Enqueue(mSessionStage, aNodeId, node, false);
+    Dispatch();
+
+    return CHIP_NO_ERROR;
+}
+
+void SubscriptionScheduler::OnSessionEstablished(NodeId aNodeId)
+{
+    Node * node = FindNode(aNodeId, State::kSettingUpSession);
+    VerifyOrReturn(node != nullptr);
+
+    mSessionStage.mInFlight--;
+    StageSucceeded(mSessionStage);
+
+    node->mState = State::kAwaitingSubscribe;
+    Enqueue(mSubscribeStage, aNodeId, *node, false);
+
+    NotifyProgress();
+    Dispatch();
+}
+
+void SubscriptionScheduler::OnSessionFailure(NodeId aNodeId, CHIP_ERROR aError)
+{
+    Node * node = FindNode(aNodeId, State::kSettingUpSession);
+    VerifyOrReturn(node != nullptr);
+
+    mSessionStage.mInFlight--;
+    StageFailed(mSessionStage, aNodeId, *node, aError);
+
+    NotifyProgress();
+    Dispatch();
+}
+
+void SubscriptionScheduler::OnSubscriptionEstablished(NodeId aNodeId)
+{
+    Node * node = FindNode(aNodeId, State::kSubscribing);
+    VerifyOrReturn(node != nullptr);
+
+    mSubscribeStage.mInFlight--;
+    StageSucceeded(mSubscribeStage);
+
+    node->mState = State::kSubscribed;
+    mSubscribed++;
+
+    NotifyProgress();
+    Dispatch();
+}
+
+void SubscriptionScheduler::OnSubscriptionFailure(NodeId aNodeId, CHIP_ERROR aError)
+{
+    Node * node = FindNode(aNodeId, State::kSubscribing);
+    VerifyOrReturn(node != nullptr);
+
+    mSubscribeStage.mInFlight--;
+    StageFailed(mSubscribeStage, aNodeId, *node, aError);
+
+    NotifyProgress();
+    Dispatch();
+}
+
+SubscriptionScheduler::Progress SubscriptionScheduler::GetProgress() const
+{
+    Progress progress;
+
+    progress.mQueued            = mSessionStage.QueuedCount();
+    progress.mSettingUpSessions = mSessionStage.mInFlight;
+    progress.mAwaitingSubscribe = mSubscribeStage.QueuedCount();
+    progress.mSubscribing       = mSubscribeStage.mInFlight;
+    progress.mSubscribed        = mSubscribed;
+    progress.mFailed            = mFailed;
+    progress.mBackoffs          = mBackoffs;
+
+    return progress;
+}
+
+void SubscriptionScheduler::Dispatch()
+{
+    //
+    // Dispatch is re-entered when the delegate reports an outcome synchronously; the outer loop picks up whatever that
+    // outcome made possible.
+    //
+    VerifyOrReturn(mpDelegate != nullptr && !mDispatching);
+    mDispatching = true;
+
+    for (Stage * stage : { &mSessionStage, &mSubscribeStage })
+    {
+        if (stage->mAwaitingCaller)
+        {
+            stage->mAwaitingCaller = false;
+            stage->mBackingOff     = false;
+        }
+    }
+
+    bool dispatched = true;
+    while (dispatched && mpDelegate != nullptr)
+    {
+        dispatched = false;
+
+        //
+        // Subscriptions go first: they are what the nodes with an established session are waiting for.
+        //
+        if (!mSubscribeStage.mBackingOff && mSubscribeStage.mInFlight < mSubscribeStage.mWindow && mSubscribeStage.HasQueued())
+        {
+            NodeId nodeId = mSubscribeStage.PopQueued();
+
+            mNodes[nodeId].mState = State::kSubscribing;
+            mSubscribeStage.mInFlight++;
+
+            CHIP_ERROR err = mpDelegate->Subscribe(nodeId);
+            if (err != CHIP_NO_ERROR)
+            {
+                OnDispatchFailed(mSubscribeStage, nodeId, State::kSubscribing, err);
+            }
+
+            dispatched = true;
+            continue;
+        }
+
+        //
+        // Nodes waiting for a subscription slot hold on to their session, so they count against the session setups.
+        //
+        if (!mSessionStage.mBackingOff && mSessionStage.mInFlight + mSubscribeStage.QueuedCount() < mSessionStage.mWindow &&
+            mSessionStage.HasQueued())
+        {
+            NodeId nodeId = mSessionStage.PopQueued();
+            Node & node   = mNodes[nodeId];
+
+            node.mState = State::kSettingUpSession;
+            node.mAttempts++;
+            mSessionStage.mInFlight++;
+
+            CHIP_ERROR err = mpDelegate->EstablishSession(nodeId);
+            if (err != CHIP_NO_ERROR)
+            {
+                OnDispatchFailed(mSessionStage, nodeId, State::kSettingUpSession, err);
+            }
+
+            dispatched = true;
+        }
+    }
+
+    mDispatching = false;
+}
+
+void SubscriptionScheduler::OnDispatchFailed(Stage & aStage, NodeId aNodeId, State aDispatchedState, CHIP_ERROR aError)
+{
+    //
+    // The delegate may have shut the scheduler down (and even initialized it again) before returning, which drops the
+    // node: look it up again rather than holding on to it across the call.
+    //
+    VerifyOrReturn(mpDelegate != nullptr);
+    Node * node = FindNode(aNodeId, aDispatchedState);
+    VerifyOrReturn(node != nullptr);
+
+    aStage.mInFlight--;
+    StageFailed(aStage, aNodeId, *node, aError);
+}
+
+void SubscriptionScheduler::Enqueue(Stage & aStage, NodeId aNodeId, const Node & aNode, bool aAtHead)
+{
+    auto & queue = aStage.mQueues[to_underlying(aNode.mPriority)];
+
+    if (aAtHead)
+    {
+        queue.push_front(aNodeId);
+    }
+    else
+    {
+        queue.push_back(aNodeId);
+    }
+}
+
+void SubscriptionScheduler::StageSucceeded(Stage & aStage)
+{
+    aStage.mWindow  = std::min<uint16_t>(static_cast<uint16_t>(aStage.mWindow + 1), aStage.mMaxWindow);
+    aStage.mBackoff = mConfig.mInitialBackoff;
+}
+
+void SubscriptionScheduler::StageFailed(Stage & aStage, NodeId aNodeId, Node & aNode, CHIP_ERROR aError)
+{
+    const bool sessionStage = (&aStage == &mSessionStage);
+
+    if (aError == CHIP_ERROR_NO_MEMORY)
+    {
+        //
+        // Out of pool resources: retry the same stage for the same node once the stage has backed off. This does not
+        // count as an attempt.
+        //
+        if (sessionStage)
+        {
+            aNode.mState = State::kQueued;
+            aNode.mAttempts--;
+        }
+        else
+        {
+            aNode.mState = State::kAwaitingSubscribe;
+        }
+
+        Enqueue(aStage, aNodeId, aNode, true);
+        StageOutOfResources(aStage);
+        return;
+    }
+
+    ChipLogProgress(Controller, "Subscription to node " ChipLogFormatX64 " failed (attempt %u): %" CHIP_ERROR_FORMAT,
+                    ChipLogValueX64(aNodeId), aNode.mAttempts, aError.Format());
+
+    if (aNode.mAttempts >= mConfig.mMaxAttempts)
+    {
+        aNode.mState = State::kFailed;
+        mFailed++;
+        // The delegate may shut the scheduler down from OnNodeFailed: neither aNode nor the delegate are used after it.
+        mpDelegate->OnNodeFailed(aNodeId, aError);
+        return;
+    }
+
+    //
+    // Start over from a new session.
+    //
+    aNode.mState = State::kQueued;
+    Enqueue(mSessionStage, aNodeId, aNode, false);
+}
+
+void SubscriptionScheduler::StageOutOfResources(Stage & aStage)
+{
+    //
+    // Requests that were already in flight when the stage ran out of resources may run out as well: only back off once.
+    //
+    VerifyOrReturn(!aStage.mBackingOff);
+
+    aStage.mWindow = std::max<uint16_t>(static_cast<uint16_t>(std::min<size_t>(aStage.mWindow, aStage.mInFlight) / 2), 1);
+    mBackoffs++;
+
+    CHIP_ERROR err = mpTimerDelegate->StartTimer(&aStage, aStage.mBackoff);
+    if (err != CHIP_NO_ERROR)
+    {
+        //
+        // Without a timer, hold the stage until the next call into the scheduler instead: retrying right away would spin
+        // for as long as the delegate keeps running out of resources synchronously.
+        //
+        ChipLogError(Controller, "Failed to start subscription scheduler backoff timer: %" CHIP_ERROR_FORMAT, err.Format());
+        aStage.mAwaitingCaller = true;
+    }
+    aStage.mBackingOff = true;
+
+    aStage.mBackoff = std::min(System::Clock::Milliseconds32(aStage.mBackoff.count() * 2), mConfig.mMaxBackoff);
+
+    NotifyProgress();
+}
+
+SubscriptionScheduler::Node * SubscriptionScheduler::FindNode(NodeId aNodeId, State aExpectedState)
+{
+    auto it = mNodes.find(aNodeId);
+    if (it == mNodes.end() || it->second.mState != aExpectedState)
+    {
+        ChipLogError(Controller, "Unexpected subscription scheduler outcome for node " ChipLogFormatX64, ChipLogValueX64(aNodeId));
+        return nullptr;
+    }
+    return &it->second;
+}
+
+void SubscriptionScheduler::NotifyProgress()
+{
+    VerifyOrReturn(mpDelegate != nullptr);
+    mpDelegate->OnProgress(GetProgress());
+}
+
+} // namespace Controller
+} // namespace chip
@@ -0,0 +1,216 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/reporting/ReportScheduler.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/NodeId.h>
+#include <system/SystemClock.h>
+
+#include <deque>
+#include <unordered_map>
+
+namespace chip {
+namespace Controller {
+
+/**
+ * @brief
+ *   Sets up subscriptions to a large number of nodes (for example all the nodes of a fabric, after a controller restart)
+ *   with admission control, instead of establishing CASE sessions to all of them at once.
+ *
+ * Every scheduled node goes through two stages, each with its own bounded number of concurrent requests:
+ *
+ *   1. Session setup: Delegate::EstablishSession, bounded by Config::mMaxSessionSetups (the CASE client and
+ *      OperationalSessionSetup pools).
+ *   2. Subscription: Delegate::Subscribe, bounded by Config::mMaxSubscribeRequests (the exchange context pool).
+ *
+ * Nodes are taken from three priority classes, highest first, in the order they were scheduled within a class.
+ *
+ * When a stage runs out of pool resources (CHIP_ERROR_NO_MEMORY, either returned by the delegate or reported as the
+ * outcome of a request), the node goes back to the head of its queue, the number of concurrent requests of the stage is
+ * halved, and the stage stops issuing requests for an exponentially increasing backoff delay.  If the backoff timer cannot
+ * be started, the stage instead retries once per call into the scheduler (scheduled node or reported outcome).  Every
+ * successful request lets the stage issue one more concurrent request again, up to its configured maximum.  Other failures
+ * are retried, from the session setup stage, up to Config::mMaxAttempts times.
+ *
+ * All the methods must be called from the Matter stack thread.  The delegate may report outcomes synchronously, from within
+ * EstablishSession or Subscribe.
+ */
+class SubscriptionScheduler
+{
+public:
+    using TimerDelegate = app::reporting::ReportScheduler::TimerDelegate;
+
+    enum class Priority : uint8_t
+    {
+        kHigh = 0,
+        kNormal,
+        kLow,
+    };
+
+    static constexpr size_t kPriorityCount = 3;
+
+    struct Config
+    {
+        uint16_t mMaxSessionSetups     = CHIP_CONFIG_CONTROLLER_SUBSCRIPTION_SCHEDULER_MAX_SESSION_SETUPS;
+        uint16_t mMaxSubscribeRequests = CHIP_CONFIG_CONTROLLER_SUBSCRIPTION_SCHEDULER_MAX_SUBSCRIBE_REQUESTS;
+        // Number of times a node is attempted before it is given up on.  Running out of pool resources does not count.
+        uint8_t mMaxAttempts                          = 3;
+        System::Clock::Milliseconds32 mInitialBackoff = System::Clock::Milliseconds32(100);
+        System::Clock::Milliseconds32 mMaxBackoff     = System::Clock::Milliseconds32(10000);
+    };
+
+    struct Progress
+    {
+        // Nodes waiting for a session setup slot.
+        size_t mQueued = 0;
+        // Nodes whose session is being set up.
+        size_t mSettingUpSessions = 0;
+        // Nodes with a session, waiting for a subscription slot.
+        size_t mAwaitingSubscribe = 0;
+        // Nodes whose Subscribe Request is outstanding.
+        size_t mSubscribing = 0;
+        size_t mSubscribed  = 0;
+        size_t mFailed      = 0;
+        // Number of times a stage backed off after running out of pool resources.
+        uint32_t mBackoffs = 0;
+    };
+
+    class Delegate
+    {
+    public:
+        virtual ~Delegate() = default;
+
+        /**
+         * Set up (or look up) a CASE session to aNodeId, typically through DeviceController::GetConnectedDevice.
+         *
+         * If CHIP_NO_ERROR is returned, the outcome must be reported through OnSessionEstablished or OnSessionFailure.
+         */
+        virtual CHIP_ERROR EstablishSession(NodeId aNodeId) = 0;
+
+        /**
+         * Subscribe to aNodeId over the session set up by EstablishSession, typically with a ReadClient.
+         *
+         * If CHIP_NO_ERROR is returned, the outcome must be reported through OnSubscriptionEstablished or
+         * OnSubscriptionFailure.
+         */
+        virtual CHIP_ERROR Subscribe(NodeId aNodeId) = 0;
+
+        /**
+         * Called when aNodeId is given up on, after Config::mMaxAttempts attempts.
+         */
+        virtual void OnNodeFailed(NodeId aNodeId, CHIP_ERROR aError) {}
+
+        /**
+         * Called whenever a node completes a stage or a stage backs off.
+         */
+        virtual void OnProgress(const Progress & aProgress) {}
+    };
+
+    SubscriptionScheduler() : mSessionStage(*this), mSubscribeStage(*this) {}
+    ~SubscriptionScheduler() { Shutdown(); }
+
+    CHIP_ERROR Init(Delegate * apDelegate, TimerDelegate * apTimerDelegate);
+    CHIP_ERROR Init(Delegate * apDelegate, TimerDelegate * apTimerDelegate, const Config & aConfig);
+    void Shutdown();
+
+    /**
+     * Schedule a subscription to aNodeId.  A node that is already subscribed, or that was given up on, is scheduled again
+     * (for example after its subscription dropped).
+     *
+     * @retval CHIP_ERROR_DUPLICATE_KEY_ID if aNodeId is already queued or in progress.
+     */
+    CHIP_ERROR ScheduleSubscription(NodeId aNodeId, Priority aPriority = Priority::kNormal);
+
+    void OnSessionEstablished(NodeId aNodeId);
+    void OnSessionFailure(NodeId aNodeId, CHIP_ERROR aError);
+    void OnSubscriptionEstablished(NodeId aNodeId);
+    void OnSubscriptionFailure(NodeId aNodeId, CHIP_ERROR aError);
+
+    Progress GetProgress() const;
+
+private:
+    enum class State : uint8_t
+    {
+        kQueued,
+        kSettingUpSession,
+        kAwaitingSubscribe,
+        kSubscribing,
+        kSubscribed,
+        kFailed,
+    };
+
+    struct Node
+    {
+        Priority mPriority;
+        State mState;
+        uint8_t mAttempts;
+    };
+
+    /*
+     * Admission control state of a stage.  The stage is its own backoff timer context.
+     */
+    struct Stage : public app::reporting::TimerContext
+    {
+        Stage(SubscriptionScheduler & aScheduler) : mScheduler(aScheduler) {}
+
+        void TimerFired() override;
+
+        bool HasQueued() const;
+        size_t QueuedCount() const;
+        NodeId PopQueued();
+        void Clear();
+
+        SubscriptionScheduler & mScheduler;
+        std::deque<NodeId> mQueues[kPriorityCount];
+        size_t mInFlight = 0;
+        // Current number of concurrent requests allowed, adapted between 1 and mMaxWindow.
+        uint16_t mWindow    = 0;
+        uint16_t mMaxWindow = 0;
+        System::Clock::Milliseconds32 mBackoff;
+        bool mBackingOff = false;
+        // Backing off without a timer: the next call into the scheduler ends the backoff.
+        bool mAwaitingCaller = false;
+    };
+
+    void Dispatch();
+    void OnDispatchFailed(Stage & aStage, NodeId aNodeId, State aDispatchedState, CHIP_ERROR aError);
+    void Enqueue(Stage & aStage, NodeId aNodeId, const Node & aNode, bool aAtHead);
+    void StageSucceeded(Stage & aStage);
+    void StageOutOfResources(Stage & aStage);
+    void StageFailed(Stage & aStage, NodeId aNodeId, Node & aNode, CHIP_ERROR aError);
+    Node * FindNode(NodeId aNodeId, State aExpectedState);
+    void NotifyProgress();
+
+    Delegate * mpDelegate           = nullptr;
+    TimerDelegate * mpTimerDelegate = nullptr;
+    Config mConfig;
+
+    std::unordered_map<NodeId, Node> mNodes;
+    Stage mSessionStage;
+    Stage mSubscribeStage;
+    size_t mSubscribed = 0;
+    size_t mFailed     = 0;
+    uint32_t mBackoffs = 0;
+    bool mDispatching  = false;
+};
+
+} // namespace Controller
+} // namespace chip
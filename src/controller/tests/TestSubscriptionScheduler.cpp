@@ -0,0 +1,564 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <controller/SubscriptionScheduler.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <vector>
+
+using namespace chip;
+using namespace chip::Controller;
+
+namespace {
+
+using Priority = SubscriptionScheduler::Priority;
+
+/*
+ * Discrete event simulation of the controller's event loop: events run in simulated time order, and the scheduler's
+ * backoff timers are events as well.
+ */
+class Simulation : public SubscriptionScheduler::TimerDelegate
+{
+public:
+    using TimerContext = app::reporting::TimerContext;
+
+    void After(System::Clock::Milliseconds64 aDelay, std::function<void()> aEvent) { mEvents.emplace(mNow + aDelay, aEvent); }
+
+    void Run()
+    {
+        while (!mEvents.empty())
+        {
+            auto it = mEvents.begin();
+            mNow    = it->first;
+
+            std::function<void()> event = std::move(it->second);
+            mEvents.erase(it);
+            event();
+        }
+    }
+
+    System::Clock::Timestamp Now() const { return mNow; }
+
+    //
+    // SubscriptionScheduler::TimerDelegate
+    //
+
+    CHIP_ERROR StartTimer(TimerContext * context, System::Clock::Timeout aTimeout) override
+    {
+        VerifyOrReturnError(!mFailTimers, CHIP_ERROR_NO_MEMORY);
+        CancelTimer(context);
+        mTimers[context] = mEvents.emplace(mNow + aTimeout, [this, context]() {
+            mTimers.erase(context);
+            context->TimerFired();
+        });
+        mTimersStarted++;
+        return CHIP_NO_ERROR;
+    }
+
+    void CancelTimer(TimerContext * context) override
+    {
+        auto it = mTimers.find(context);
+        if (it != mTimers.end())
+        {
+            mEvents.erase(it->second);
+            mTimers.erase(it);
+        }
+    }
+
+    bool IsTimerActive(TimerContext * context) override { return mTimers.find(context) != mTimers.end(); }
+
+    System::Clock::Timestamp GetCurrentMonotonicTimestamp() override { return mNow; }
+
+    uint32_t mTimersStarted = 0;
+    bool mFailTimers        = false;
+
+private:
+    using EventQueue = std::multimap<System::Clock::Timestamp, std::function<void()>>;
+
+    System::Clock::Timestamp mNow = System::Clock::kZero;
+    EventQueue mEvents;
+    std::map<TimerContext *, EventQueue::iterator> mTimers;
+};
+
+/*
+ * Models the controller pools and the network the subscriptions are set up over:
+ *
+ *  - EstablishSession allocates an OperationalSessionSetup synchronously (CHIP_ERROR_NO_MEMORY when that pool is
+ *    exhausted), then resolves the node and allocates a CASE client, reporting CHIP_ERROR_NO_MEMORY asynchronously when
+ *    the CASE client pool is exhausted.
+ *  - CASE handshakes share the controller CPU, so they get slower the more of them run concurrently, and time out past
+ *    kCaseTimeout.
+ *  - Subscribe allocates an exchange context (CHIP_ERROR_NO_MEMORY when exhausted) for the Subscribe Request.
+ */
+class MockNetwork : public SubscriptionScheduler::Delegate
+{
+public:
+    static constexpr uint32_t kResolveMs          = 20;
+    static constexpr uint32_t kCaseBaseMs         = 150;
+    static constexpr uint32_t kCasePerHandshakeMs = 20;
+    static constexpr uint32_t kCaseTimeoutMs      = 5000;
+    static constexpr uint32_t kSubscribeBaseMs    = 40;
+    static constexpr uint32_t kSubscribePerPendMs = 2;
+
+    MockNetwork(Simulation & aSimulation, SubscriptionScheduler & aScheduler) : mSimulation(aSimulation), mScheduler(aScheduler)
+    {}
+
+    CHIP_ERROR EstablishSession(NodeId aNodeId) override
+    {
+        VerifyOrReturnError(aNodeId != mRejectSessionNode, Reject());
+        VerifyOrReturnError(mSessionSetupsInUse < mSessionSetupPoolSize, RefuseSession());
+
+        mSessionSetupsInUse++;
+        mMaxSessionSetupsInUse = std::max(mMaxSessionSetupsInUse, mSessionSetupsInUse);
+        mEstablishOrder.push_back(aNodeId);
+        uint32_t attempt = ++mAttempts[aNodeId];
+
+        if (mSynchronous)
+        {
+            mSessionSetupsInUse--;
+            mScheduler.OnSessionEstablished(aNodeId);
+            return CHIP_NO_ERROR;
+        }
+
+        mSimulation.After(System::Clock::Milliseconds64(kResolveMs), [this, aNodeId, attempt]() { StartCase(aNodeId, attempt); });
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR Subscribe(NodeId aNodeId) override
+    {
+        VerifyOrReturnError(aNodeId != mRejectSubscribeNode, Reject());
+        VerifyOrReturnError(mExchangesInUse < mExchangePoolSize, CHIP_ERROR_NO_MEMORY);
+
+        mExchangesInUse++;
+        mMaxExchangesInUse = std::max(mMaxExchangesInUse, mExchangesInUse);
+
+        if (mSynchronous)
+        {
+            mExchangesInUse--;
+            mScheduler.OnSubscriptionEstablished(aNodeId);
+            return CHIP_NO_ERROR;
+        }
+
+        uint32_t latency = kSubscribeBaseMs + kSubscribePerPendMs * static_cast<uint32_t>(mExchangesInUse);
+        mSimulation.After(System::Clock::Milliseconds64(latency), [this, aNodeId]() {
+            mExchangesInUse--;
+            mScheduler.OnSubscriptionEstablished(aNodeId);
+        });
+        return CHIP_NO_ERROR;
+    }
+
+    void OnNodeFailed(NodeId aNodeId, CHIP_ERROR aError) override
+    {
+        mFailedNodes.push_back(aNodeId);
+        if (mShutDownOnNodeFailed)
+        {
+            mScheduler.Shutdown();
+        }
+    }
+
+    void OnProgress(const SubscriptionScheduler::Progress & aProgress) override
+    {
+        mProgressReports++;
+        if (aProgress.mSubscribed + aProgress.mFailed == mExpectedNodes && mAllDoneAt == System::Clock::kZero)
+        {
+            mAllDoneAt = mSimulation.Now();
+        }
+    }
+
+    bool IsOffline(NodeId aNodeId) const { return mOfflineEvery != 0 && (aNodeId % mOfflineEvery) == 0; }
+    bool IsFlaky(NodeId aNodeId) const { return mFlakyEvery != 0 && (aNodeId % mFlakyEvery) == 0; }
+
+    size_t mSessionSetupPoolSize = CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_DEVICES;
+    size_t mCaseClientPoolSize   = CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_CASE_CLIENTS;
+    size_t mExchangePoolSize     = CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS;
+    NodeId mOfflineEvery         = 0;
+    NodeId mFlakyEvery           = 0;
+    bool mSynchronous            = false;
+    size_t mExpectedNodes        = 0;
+
+    // EstablishSession or Subscribe fail these nodes synchronously, after shutting the scheduler down if mShutDownOnReject.
+    NodeId mRejectSessionNode   = kUndefinedNodeId;
+    NodeId mRejectSubscribeNode = kUndefinedNodeId;
+    bool mShutDownOnReject      = false;
+    bool mShutDownOnNodeFailed  = false;
+
+    size_t mSessionSetupsInUse    = 0;
+    size_t mCaseClientsInUse      = 0;
+    size_t mExchangesInUse        = 0;
+    size_t mMaxSessionSetupsInUse = 0;
+    size_t mMaxExchangesInUse     = 0;
+
+    std::vector<NodeId> mEstablishOrder;
+    std::vector<NodeId> mFailedNodes;
+    std::map<NodeId, uint32_t> mAttempts;
+    uint32_t mProgressReports           = 0;
+    uint32_t mSessionRefusals           = 0;
+    System::Clock::Timestamp mAllDoneAt = System::Clock::kZero;
+
+private:
+    static constexpr uint32_t kMaxSessionRefusals = 10000;
+
+    CHIP_ERROR RefuseSession()
+    {
+        // A scheduler retrying without bound would otherwise hang the test.
+        if (++mSessionRefusals >= kMaxSessionRefusals)
+        {
+            mScheduler.Shutdown();
+        }
+        return CHIP_ERROR_NO_MEMORY;
+    }
+
+    CHIP_ERROR Reject()
+    {
+        if (mShutDownOnReject)
+        {
+            mScheduler.Shutdown();
+        }
+        return CHIP_ERROR_TIMEOUT;
+    }
+
+    void StartCase(NodeId aNodeId, uint32_t aAttempt)
+    {
+        if (mCaseClientsInUse >= mCaseClientPoolSize)
+        {
+            mSessionSetupsInUse--;
+            mScheduler.OnSessionFailure(aNodeId, CHIP_ERROR_NO_MEMORY);
+            return;
+        }
+
+        mCaseClientsInUse++;
+
+        uint32_t latency = kCaseBaseMs + kCasePerHandshakeMs * static_cast<uint32_t>(mCaseClientsInUse) +
+            static_cast<uint32_t>((aNodeId * 7919) % 100);
+        bool fails = IsOffline(aNodeId) || (IsFlaky(aNodeId) && aAttempt == 1) || latency > kCaseTimeoutMs;
+
+        mSimulation.After(System::Clock::Milliseconds64(fails ? kCaseTimeoutMs : latency), [this, aNodeId, fails]() {
+            mCaseClientsInUse--;
+            mSessionSetupsInUse--;
+            if (fails)
+            {
+                mScheduler.OnSessionFailure(aNodeId, CHIP_ERROR_TIMEOUT);
+            }
+            else
+            {
+                mScheduler.OnSessionEstablished(aNodeId);
+            }
+        });
+    }
+
+    Simulation & mSimulation;
+    SubscriptionScheduler & mScheduler;
+};
+
+class TestSubscriptionScheduler : public ::testing::Test
+{
+protected:
+    void SetUp() override { mNetwork.mExpectedNodes = 0; }
+    void TearDown() override { mScheduler.Shutdown(); }
+
+    Simulation mSimulation;
+    SubscriptionScheduler mScheduler;
+    MockNetwork mNetwork{ mSimulation, mScheduler };
+};
+
+TEST_F(TestSubscriptionScheduler, TestInitArguments)
+{
+    SubscriptionScheduler::Config config;
+
+    EXPECT_EQ(mScheduler.ScheduleSubscription(1), CHIP_ERROR_INCORRECT_STATE);
+    EXPECT_EQ(mScheduler.Init(nullptr, &mSimulation), CHIP_ERROR_INVALID_ARGUMENT);
+
+    config.mMaxSessionSetups = 0;
+    EXPECT_EQ(mScheduler.Init(&mNetwork, &mSimulation, config), CHIP_ERROR_INVALID_ARGUMENT);
+
+    EXPECT_EQ(mScheduler.Init(&mNetwork, &mSimulation), CHIP_NO_ERROR);
+    EXPECT_EQ(mScheduler.Init(&mNetwork, &mSimulation), CHIP_ERROR_INCORRECT_STATE);
+}
+
+TEST_F(TestSubscriptionScheduler, TestSynchronousOutcomes)
+{
+    constexpr NodeId kNodeCount = 100;
+
+    mNetwork.mSynchronous = true;
+    ASSERT_EQ(mScheduler.Init(&mNetwork, &mSimulation), CHIP_NO_ERROR);
+
+    for (NodeId nodeId = 1; nodeId <= kNodeCount; nodeId++)
+    {
+        EXPECT_EQ(mScheduler.ScheduleSubscription(nodeId), CHIP_NO_ERROR);
+    }
+
+    SubscriptionScheduler::Progress progress = mScheduler.GetProgress();
+    EXPECT_EQ(progress.mSubscribed, kNodeCount);
+    EXPECT_EQ(progress.mQueued + progress.mSettingUpSessions + progress.mAwaitingSubscribe + progress.mSubscribing, 0u);
+    EXPECT_EQ(mNetwork.mProgressReports, 2 * kNodeCount);
+}
+
+TEST_F(TestSubscriptionScheduler, TestShutdownFromDelegate)
+{
+    SubscriptionScheduler::Config config;
+    config.mMaxAttempts = 1;
+
+    mNetwork.mSynchronous         = true;
+    mNetwork.mRejectSessionNode   = 2;
+    mNetwork.mRejectSubscribeNode = 3;
+
+    // Shut down while failing a session setup.
+    mNetwork.mShutDownOnReject = true;
+    ASSERT_EQ(mScheduler.Init(&mNetwork, &mSimulation, config), CHIP_NO_ERROR);
+    EXPECT_EQ(mScheduler.ScheduleSubscription(1), CHIP_NO_ERROR);
+    EXPECT_EQ(mScheduler.ScheduleSubscription(2), CHIP_NO_ERROR);
+    EXPECT_EQ(mScheduler.ScheduleSubscription(4), CHIP_ERROR_INCORRECT_STATE);
+    EXPECT_TRUE(mNetwork.mFailedNodes.empty());
+
+    // Shut down while failing a Subscribe Request.
+    ASSERT_EQ(mScheduler.Init(&mNetwork, &mSimulation, config), CHIP_NO_ERROR);
+    EXPECT_EQ(mScheduler.ScheduleSubscription(3), CHIP_NO_ERROR);
+    EXPECT_EQ(mScheduler.ScheduleSubscription(4), CHIP_ERROR_INCORRECT_STATE);
+    EXPECT_TRUE(mNetwork.mFailedNodes.empty());
+
+    // Shut down when told that a node was given up on.
+    mNetwork.mShutDownOnReject     = false;
+    mNetwork.mShutDownOnNodeFailed = true;
+    ASSERT_EQ(mScheduler.Init(&mNetwork, &mSimulation, config), CHIP_NO_ERROR);
+    EXPECT_EQ(mScheduler.ScheduleSubscription(2), CHIP_NO_ERROR);
+    EXPECT_EQ(mScheduler.ScheduleSubscription(4), CHIP_ERROR_INCORRECT_STATE);
+    EXPECT_EQ(mNetwork.mFailedNodes, std::vector<NodeId>{ 2 });
+}
+
+TEST_F(TestSubscriptionScheduler, TestPriorityClasses)
+{
+    SubscriptionScheduler::Config config;
+    config.mMaxSessionSetups     = 1;
+    config.mMaxSubscribeRequests = 1;
+    ASSERT_EQ(mScheduler.Init(&mNetwork, &mSimulation, config), CHIP_NO_ERROR);
+
+    for (NodeId nodeId = 1; nodeId <= 4; nodeId++)
+    {
+        EXPECT_EQ(mScheduler.ScheduleSubscription(nodeId, Priority::kLow), CHIP_NO_ERROR);
+    }
+    for (NodeId nodeId = 11; nodeId <= 13; nodeId++)
+    {
+        EXPECT_EQ(mScheduler.ScheduleSubscription(nodeId, Priority::kNormal), CHIP_NO_ERROR);
+    }
+    for (NodeId nodeId = 21; nodeId <= 22; nodeId++)
+    {
+        EXPECT_EQ(mScheduler.ScheduleSubscription(nodeId, Priority::kHigh), CHIP_NO_ERROR);
+    }
+
+    // Node 1 was dispatched as soon as it was scheduled, the others wait for their turn by priority.
+    EXPECT_EQ(mScheduler.ScheduleSubscription(1), CHIP_ERROR_DUPLICATE_KEY_ID);
+    EXPECT_EQ(mScheduler.ScheduleSubscription(21), CHIP_ERROR_DUPLICATE_KEY_ID);
+
+    mSimulation.Run();
+
+    std::vector<NodeId> expectedOrder = { 1, 21, 22, 11, 12, 13, 2, 3, 4 };
+    EXPECT_EQ(mNetwork.mEstablishOrder, expectedOrder);
+    EXPECT_EQ(mScheduler.GetProgress().mSubscribed, 9u);
+    EXPECT_EQ(mNetwork.mMaxSessionSetupsInUse, 1u);
+    EXPECT_EQ(mNetwork.mMaxExchangesInUse, 1u);
+
+    // Subscribed nodes can be scheduled again, for example after their subscription dropped.
+    EXPECT_EQ(mScheduler.ScheduleSubscription(1), CHIP_NO_ERROR);
+    EXPECT_EQ(mScheduler.GetProgress().mSubscribed, 8u);
+    mSimulation.Run();
+    EXPECT_EQ(mScheduler.GetProgress().mSubscribed, 9u);
+}
+
+TEST_F(TestSubscriptionScheduler, TestBackoffOnNoMemory)
+{
+    SubscriptionScheduler::Config config;
+    config.mMaxSessionSetups     = 32;
+    config.mMaxSubscribeRequests = 32;
+    config.mMaxAttempts          = 1;
+
+    mNetwork.mSessionSetupPoolSize = 8;
+    mNetwork.mCaseClientPoolSize   = 4;
+    mNetwork.mExchangePoolSize     = 2;
+    mNetwork.mExpectedNodes        = 200;
+    ASSERT_EQ(mScheduler.Init(&mNetwork, &mSimulation, config), CHIP_NO_ERROR);
+
+    for (NodeId nodeId = 1; nodeId <= 200; nodeId++)
+    {
+        EXPECT_EQ(mScheduler.ScheduleSubscription(nodeId), CHIP_NO_ERROR);
+    }
+
+    // The first session setups ran the pool out: the session stage is backing off already.
+    EXPECT_EQ(mNetwork.mSessionSetupsInUse, 8u);
+    EXPECT_GE(mScheduler.GetProgress().mBackoffs, 1u);
+
+    mSimulation.Run();
+
+    SubscriptionScheduler::Progress progress = mScheduler.GetProgress();
+    EXPECT_EQ(progress.mSubscribed, 200u);
+    EXPECT_EQ(progress.mFailed, 0u);
+    EXPECT_GE(mSimulation.mTimersStarted, progress.mBackoffs);
+    EXPECT_LE(mNetwork.mMaxExchangesInUse, 2u);
+
+    // Running out of CASE clients fails session setups asynchronously, but that never counts as a failed attempt.
+    auto mostAttempts = std::max_element(mNetwork.mAttempts.begin(), mNetwork.mAttempts.end(),
+                                         [](const auto & a, const auto & b) { return a.second < b.second; });
+    EXPECT_GT(mostAttempts->second, config.mMaxAttempts);
+}
+
+TEST_F(TestSubscriptionScheduler, TestBackoffWithoutTimer)
+{
+    // Nothing is in flight, so every retry the scheduler makes runs straight into the exhausted pool again.
+    mSimulation.mFailTimers        = true;
+    mNetwork.mSessionSetupPoolSize = 0;
+    ASSERT_EQ(mScheduler.Init(&mNetwork, &mSimulation), CHIP_NO_ERROR);
+
+    EXPECT_EQ(mScheduler.ScheduleSubscription(1), CHIP_NO_ERROR);
+    EXPECT_EQ(mNetwork.mSessionRefusals, 1u);
+    EXPECT_EQ(mScheduler.GetProgress().mQueued, 1u);
+    EXPECT_EQ(mScheduler.GetProgress().mBackoffs, 1u);
+
+    // The next call into the scheduler ends the backoff.
+    mNetwork.mSessionSetupPoolSize = 1;
+    EXPECT_EQ(mScheduler.ScheduleSubscription(2), CHIP_NO_ERROR);
+    EXPECT_EQ(mNetwork.mSessionSetupsInUse, 1u);
+    EXPECT_EQ(mNetwork.mSessionRefusals, 1u);
+
+    mSimulation.Run();
+
+    EXPECT_EQ(mScheduler.GetProgress().mSubscribed, 2u);
+    EXPECT_EQ(mSimulation.mTimersStarted, 0u);
+}
+
+TEST_F(TestSubscriptionScheduler, TestRetriesThenGivesUp)
+{
+    SubscriptionScheduler::Config config;
+    config.mMaxAttempts = 3;
+
+    mNetwork.mOfflineEvery = 5;
+    mNetwork.mFlakyEvery   = 3;
+    ASSERT_EQ(mScheduler.Init(&mNetwork, &mSimulation, config), CHIP_NO_ERROR);
+
+    for (NodeId nodeId = 1; nodeId <= 10; nodeId++)
+    {
+        EXPECT_EQ(mScheduler.ScheduleSubscription(nodeId), CHIP_NO_ERROR);
+    }
+
+    mSimulation.Run();
+
+    std::vector<NodeId> expectedFailures = { 5, 10 };
+    std::sort(mNetwork.mFailedNodes.begin(), mNetwork.mFailedNodes.end());
+    EXPECT_EQ(mNetwork.mFailedNodes, expectedFailures);
+    EXPECT_EQ(mNetwork.mAttempts[5], 3u);
+    EXPECT_EQ(mNetwork.mAttempts[3], 2u);
+    EXPECT_EQ(mNetwork.mAttempts[1], 1u);
+
+    SubscriptionScheduler::Progress progress = mScheduler.GetProgress();
+    EXPECT_EQ(progress.mSubscribed, 8u);
+    EXPECT_EQ(progress.mFailed, 2u);
+
+    // Failed nodes can be scheduled again.
+    mNetwork.mOfflineEvery = 0;
+    EXPECT_EQ(mScheduler.ScheduleSubscription(5), CHIP_NO_ERROR);
+    mSimulation.Run();
+    EXPECT_EQ(mScheduler.GetProgress().mSubscribed, 9u);
+    EXPECT_EQ(mScheduler.GetProgress().mFailed, 1u);
+}
+
+struct FleetResult
+{
+    System::Clock::Timestamp mTimeToAllSubscribed;
+    SubscriptionScheduler::Progress mProgress;
+    size_t mMaxSessionSetupsInUse;
+    size_t mMaxExchangesInUse;
+    size_t mFailedNodes;
+};
+
+FleetResult SubscribeToFleet(const SubscriptionScheduler::Config & aConfig, NodeId aNodeCount)
+{
+    Simulation simulation;
+    SubscriptionScheduler scheduler;
+    MockNetwork network(simulation, scheduler);
+    FleetResult result;
+
+    network.mOfflineEvery  = 500;
+    network.mFlakyEvery    = 50;
+    network.mExpectedNodes = static_cast<size_t>(aNodeCount);
+    EXPECT_EQ(scheduler.Init(&network, &simulation, aConfig), CHIP_NO_ERROR);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (NodeId nodeId = 1; nodeId <= aNodeCount; nodeId++)
+    {
+        // A few nodes the controller needs first (for example locks), most nodes at normal priority, sensors last.
+        Priority priority = (nodeId % 100 == 1) ? Priority::kHigh : ((nodeId % 4 == 0) ? Priority::kLow : Priority::kNormal);
+        EXPECT_EQ(scheduler.ScheduleSubscription(nodeId, priority), CHIP_NO_ERROR);
+    }
+
+    simulation.Run();
+
+    auto wallUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    result.mTimeToAllSubscribed   = network.mAllDoneAt;
+    result.mProgress              = scheduler.GetProgress();
+    result.mMaxSessionSetupsInUse = network.mMaxSessionSetupsInUse;
+    result.mMaxExchangesInUse     = network.mMaxExchangesInUse;
+    result.mFailedNodes           = network.mFailedNodes.size();
+
+    ChipLogProgress(Controller,
+                    "%u nodes, up to %u session setups and %u subscribe requests: all done after %u ms of simulated time "
+                    "(%u subscribed, %u failed, %u backoffs, %u progress reports), %u us of wall time",
+                    static_cast<unsigned>(aNodeCount), aConfig.mMaxSessionSetups, aConfig.mMaxSubscribeRequests,
+                    static_cast<unsigned>(result.mTimeToAllSubscribed.count()), static_cast<unsigned>(result.mProgress.mSubscribed),
+                    static_cast<unsigned>(result.mProgress.mFailed), static_cast<unsigned>(result.mProgress.mBackoffs),
+                    static_cast<unsigned>(network.mProgressReports), static_cast<unsigned>(wallUs));
+
+    scheduler.Shutdown();
+    return result;
+}
+
+TEST_F(TestSubscriptionScheduler, TestTimeToAllSubscribed)
+{
+    constexpr NodeId kNodeCount      = 5000;
+    constexpr size_t kOfflineNodes   = kNodeCount / 500;
+    constexpr size_t kReachableNodes = kNodeCount - kOfflineNodes;
+
+    // Default admission control, sized after the controller pools.
+    SubscriptionScheduler::Config config;
+    FleetResult bounded = SubscribeToFleet(config, kNodeCount);
+
+    EXPECT_EQ(bounded.mProgress.mSubscribed, kReachableNodes);
+    EXPECT_EQ(bounded.mProgress.mFailed, kOfflineNodes);
+    EXPECT_EQ(bounded.mFailedNodes, kOfflineNodes);
+    EXPECT_EQ(bounded.mProgress.mBackoffs, 0u);
+    EXPECT_LE(bounded.mMaxSessionSetupsInUse, config.mMaxSessionSetups);
+    EXPECT_LE(bounded.mMaxExchangesInUse, config.mMaxSubscribeRequests);
+    EXPECT_GT(bounded.mTimeToAllSubscribed, System::Clock::kZero);
+
+    // Effectively no admission control: every node is let through until the pools run out, and the scheduler only relies
+    // on backing off.
+    config.mMaxSessionSetups     = static_cast<uint16_t>(kNodeCount);
+    config.mMaxSubscribeRequests = static_cast<uint16_t>(kNodeCount);
+    FleetResult unbounded        = SubscribeToFleet(config, kNodeCount);
+
+    EXPECT_EQ(unbounded.mProgress.mSubscribed, kReachableNodes);
+    EXPECT_EQ(unbounded.mProgress.mFailed, kOfflineNodes);
+    EXPECT_GT(unbounded.mProgress.mBackoffs, 0u);
+}
+
+} // namespace
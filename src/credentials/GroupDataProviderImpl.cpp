@@ -832,12 +832,14 @@ void GroupDataProviderImpl::Finish()
     mKeySetIterators.ReleaseAll();
     mGroupSessionsIterator.ReleaseAll();
     mGroupKeyContexPool.ReleaseAll();
+    InvalidateGroupSessionCache();
 }
 
 void GroupDataProviderImpl::SetStorageDelegate(PersistentStorageDelegate * storage)
 {
     VerifyOrDie(storage != nullptr);
     mStorage = storage;
+    InvalidateGroupSessionCache();
 }
 
 //
@@ -1349,6 +1351,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveEndpoints(chip::FabricIndex fabric_index
 CHIP_ERROR GroupDataProviderImpl::SetGroupKeyAt(chip::FabricIndex fabric_index, size_t index, const GroupKey & in_map)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     KeyMapData map(fabric_index);
@@ -1415,6 +1418,7 @@ CHIP_ERROR GroupDataProviderImpl::GetGroupKeyAt(chip::FabricIndex fabric_index,
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_index, size_t index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     KeyMapData map;
@@ -1447,6 +1451,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_inde
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeys(chip::FabricIndex fabric_index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     VerifyOrReturnError(CHIP_NO_ERROR == fabric.Load(mStorage), CHIP_ERROR_INVALID_FABRIC_INDEX);
@@ -1523,6 +1528,7 @@ CHIP_ERROR GroupDataProviderImpl::SetKeySet(chip::FabricIndex fabric_index, cons
                                             const KeySet & in_keyset)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
@@ -1594,6 +1600,7 @@ CHIP_ERROR GroupDataProviderImpl::GetKeySet(chip::FabricIndex fabric_index, uint
 CHIP_ERROR GroupDataProviderImpl::RemoveKeySet(chip::FabricIndex fabric_index, uint16_t target_id)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
@@ -1695,6 +1702,8 @@ void GroupDataProviderImpl::KeySetIteratorImpl::Release()
 
 CHIP_ERROR GroupDataProviderImpl::RemoveFabric(chip::FabricIndex fabric_index)
 {
+    InvalidateGroupSessionCache();
+
     FabricData fabric(fabric_index);
 
     // Fabric data defaults to zero, so if not entry is found, no mappings, or keys are removed
@@ -1842,9 +1851,108 @@ GroupDataProviderImpl::GroupSessionIterator * GroupDataProviderImpl::IterateGrou
     return mGroupSessionsIterator.CreateObject(*this, session_id);
 }
 
+bool GroupDataProviderImpl::LoadGroupSessionCache()
+{
+    if (GroupSessionCache::State::kStale == mGroupSessionCache.state)
+    {
+        CHIP_ERROR err = LoadGroupSessionCacheEntries();
+        if (CHIP_NO_ERROR != err)
+        {
+            // Look the group sessions up in storage until the next change
+            InvalidateGroupSessionCache();
+            mGroupSessionCache.state = GroupSessionCache::State::kUnavailable;
+            return false;
+        }
+        mGroupSessionCache.state = GroupSessionCache::State::kLoaded;
+    }
+    return GroupSessionCache::State::kLoaded == mGroupSessionCache.state;
+}
+
+CHIP_ERROR GroupDataProviderImpl::LoadGroupSessionCacheEntries()
+{
+    GroupSessionCache & cache = mGroupSessionCache;
+
+    FabricList fabric_list;
+    CHIP_ERROR err = fabric_list.Load(mStorage);
+    if (CHIP_ERROR_NOT_FOUND == err)
+    {
+        // No fabric, no group session
+        return CHIP_NO_ERROR;
+    }
+    ReturnErrorOnFailure(err);
+
+    // Same walk as the storage iteration of GroupSessionIteratorImpl
+    FabricData fabric(fabric_list.first_entry);
+    for (size_t i = 0; i < fabric_list.entry_count; i++, fabric.fabric_index = fabric.next)
+    {
+        ReturnErrorOnFailure(fabric.Load(mStorage));
+
+        KeyMapData mapping(fabric.fabric_index, fabric.first_map);
+        for (uint16_t j = 0; j < fabric.map_count; ++j, mapping.id = mapping.next)
+        {
+            ReturnErrorOnFailure(mapping.Load(mStorage));
+            VerifyOrReturnError(cache.mapping_count < cache.mappings.size(), CHIP_ERROR_NO_MEMORY);
+
+            GroupSessionCache::Mapping & entry = cache.mappings[cache.mapping_count++];
+            entry.fabric_index                 = fabric.fabric_index;
+            entry.group_id                     = mapping.group_id;
+            entry.keyset                       = GroupSessionCache::kNoKeyset;
+
+            // Key sets are shared by the groups they are mapped to
+            for (size_t k = 0; k < cache.keyset_count; ++k)
+            {
+                if ((cache.keysets[k].fabric_index == fabric.fabric_index) && (cache.keysets[k].keyset_id == mapping.keyset_id))
+                {
+                    entry.keyset = static_cast<uint8_t>(k);
+                    break;
+                }
+            }
+            if (GroupSessionCache::kNoKeyset != entry.keyset)
+            {
+                continue;
+            }
+
+            KeySetData keyset;
+            VerifyOrReturnError(keyset.Find(mStorage, fabric, mapping.keyset_id), CHIP_ERROR_KEY_NOT_FOUND);
+            VerifyOrReturnError(cache.keyset_count < cache.keysets.size(), CHIP_ERROR_NO_MEMORY);
+
+            GroupSessionCache::Keyset & cached = cache.keysets[cache.keyset_count];
+            cached.fabric_index                = fabric.fabric_index;
+            cached.keyset_id                   = mapping.keyset_id;
+            cached.policy                      = keyset.policy;
+            cached.keys_count                  = keyset.keys_count;
+            memcpy(cached.keys, keyset.operational_keys, sizeof(cached.keys));
+            entry.keyset = static_cast<uint8_t>(cache.keyset_count++);
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void GroupDataProviderImpl::InvalidateGroupSessionCache()
+{
+    GroupSessionCache & cache = mGroupSessionCache;
+
+    for (size_t k = 0; k < cache.keyset_count; ++k)
+    {
+        Crypto::ClearSecretData(reinterpret_cast<uint8_t *>(cache.keysets[k].keys), sizeof(cache.keysets[k].keys));
+    }
+    cache.keyset_count  = 0;
+    cache.mapping_count = 0;
+    cache.state         = GroupSessionCache::State::kStale;
+    cache.generation++;
+}
+
 GroupDataProviderImpl::GroupSessionIteratorImpl::GroupSessionIteratorImpl(GroupDataProviderImpl & provider, uint16_t session_id) :
     mProvider(provider), mSessionId(session_id), mGroupKeyContext(provider)
 {
+    if (provider.LoadGroupSessionCache())
+    {
+        mCached     = true;
+        mGeneration = provider.mGroupSessionCache.generation;
+        return;
+    }
+
     FabricList fabric_list;
     ReturnOnFailure(fabric_list.Load(provider.mStorage));
     mFirstFabric = fabric_list.first_entry;
@@ -1857,9 +1965,29 @@ GroupDataProviderImpl::GroupSessionIteratorImpl::GroupSessionIteratorImpl(GroupD
 
 size_t GroupDataProviderImpl::GroupSessionIteratorImpl::Count()
 {
-    FabricData fabric(mFirstFabric);
     size_t count = 0;
 
+    if (mCached)
+    {
+        const GroupSessionCache & cache = mProvider.mGroupSessionCache;
+        VerifyOrReturnValue(cache.generation == mGeneration, 0);
+
+        for (size_t i = 0; i < cache.mapping_count; ++i)
+        {
+            const GroupSessionCache::Keyset & keyset = cache.keysets[cache.mappings[i].keyset];
+            for (uint16_t k = 0; k < keyset.keys_count; ++k)
+            {
+                if (keyset.keys[k].hash == mSessionId)
+                {
+                    count++;
+                }
+            }
+        }
+        return count;
+    }
+
+    FabricData fabric(mFirstFabric);
+
     for (size_t i = 0; i < mFabricTotal; i++, fabric.fabric_index = fabric.next)
     {
         if (CHIP_NO_ERROR != fabric.Load(mProvider.mStorage))
@@ -1898,6 +2026,39 @@ size_t GroupDataProviderImpl::GroupSessionIteratorImpl::Count()
 
 bool GroupDataProviderImpl::GroupSessionIteratorImpl::Next(GroupSession & output)
 {
+    if (mCached)
+    {
+        const GroupSessionCache & cache = mProvider.mGroupSessionCache;
+        // Stop if the keys changed since the iteration started
+        VerifyOrReturnValue(cache.generation == mGeneration, false);
+
+        while (mMapCount < cache.mapping_count)
+        {
+            const GroupSessionCache::Mapping & mapping = cache.mappings[mMapCount];
+            const GroupSessionCache::Keyset & keyset   = cache.keysets[mapping.keyset];
+
+            if (mKeyIndex >= keyset.keys_count)
+            {
+                // No more keys in current keyset, try next mapping
+                mMapCount++;
+                mKeyIndex = 0;
+                continue;
+            }
+
+            const Crypto::GroupOperationalCredentials & creds = keyset.keys[mKeyIndex++];
+            if (creds.hash == mSessionId)
+            {
+                mGroupKeyContext.Initialize(creds.encryption_key, mSessionId, creds.privacy_key);
+                output.fabric_index    = mapping.fabric_index;
+                output.group_id        = mapping.group_id;
+                output.security_policy = keyset.policy;
+                output.keyContext      = &mGroupKeyContext;
+                return true;
+            }
+        }
+        return false;
+    }
+
     while (mFabricCount < mFabricTotal)
     {
         FabricData fabric(mFabric);
@@ -21,6 +21,8 @@
 #include <lib/core/CHIPPersistentStorageDelegate.h>
 #include <lib/support/Pool.h>
 
+#include <array>
+
 namespace chip {
 namespace Credentials {
 
@@ -241,10 +243,59 @@ protected:
         uint16_t mKeyIndex       = 0;
         uint16_t mKeyCount       = 0;
         bool mFirstMap           = true;
+        // Set when iterating the group session cache instead of the persistent storage
+        bool mCached         = false;
+        uint32_t mGeneration = 0;
         GroupKeyContext mGroupKeyContext;
     };
+
+    // RAM copy of the keyset-group mappings and of the key sets they use, in persistent storage order,
+    // so that received group messages are matched to their keys without reading the persistent storage.
+    struct GroupSessionCache
+    {
+        static constexpr uint8_t kNoKeyset = UINT8_MAX;
+
+        enum class State : uint8_t
+        {
+            kStale,      // To be loaded on the next group session lookup
+            kLoaded,     // Mirrors the persistent storage
+            kUnavailable // Does not fit (or failed to load), group sessions are looked up in storage
+        };
+
+        struct Keyset
+        {
+            FabricIndex fabric_index = kUndefinedFabricIndex;
+            KeysetId keyset_id       = kInvalidKeysetId;
+            SecurityPolicy policy    = SecurityPolicy::kCacheAndSync;
+            uint8_t keys_count       = 0;
+            Crypto::GroupOperationalCredentials keys[KeySet::kEpochKeysMax];
+        };
+
+        struct Mapping
+        {
+            FabricIndex fabric_index = kUndefinedFabricIndex;
+            GroupId group_id         = kUndefinedGroupId;
+            uint8_t keyset           = kNoKeyset; // Index in keysets
+        };
+
+        State state = State::kStale;
+        // Incremented on every invalidation, so that iterators notice changes
+        uint32_t generation  = 0;
+        size_t keyset_count  = 0;
+        size_t mapping_count = 0;
+        std::array<Keyset, CHIP_CONFIG_GROUP_SESSION_CACHE_MAX_KEYSETS> keysets;
+        std::array<Mapping, CHIP_CONFIG_GROUP_SESSION_CACHE_MAX_MAPPINGS> mappings;
+    };
+
+    static_assert(CHIP_CONFIG_GROUP_SESSION_CACHE_MAX_KEYSETS < GroupSessionCache::kNoKeyset,
+                  "Group session cache keysets must be indexable with a uint8_t");
+
     bool IsInitialized() { return (mStorage != nullptr); }
     CHIP_ERROR RemoveEndpoints(FabricIndex fabric_index, GroupId group_id);
+    // Returns true if the group session cache mirrors the persistent storage, loading it if needed.
+    bool LoadGroupSessionCache();
+    CHIP_ERROR LoadGroupSessionCacheEntries();
+    void InvalidateGroupSessionCache();
 
     PersistentStorageDelegate * mStorage       = nullptr;
     Crypto::SessionKeystore * mSessionKeystore = nullptr;
@@ -254,6 +305,7 @@ protected:
     ObjectPool<KeySetIteratorImpl, kIteratorsMax> mKeySetIterators;
     ObjectPool<GroupSessionIteratorImpl, kIteratorsMax> mGroupSessionsIterator;
     ObjectPool<GroupKeyContext, kIteratorsMax> mGroupKeyContexPool;
+    GroupSessionCache mGroupSessionCache;
 };
 
 } // namespace Credentials
@@ -21,8 +21,11 @@
 #include <gtest/gtest.h>
 #include <lib/core/TLV.h>
 #include <lib/support/CHIPMem.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
 #include <lib/support/TestPersistentStorageDelegate.h>
+#include <lib/support/logging/CHIPLogging.h>
 #include <platform/KeyValueStoreManager.h>
+#include <chrono>
 #include <set>
 #include <string.h>
 #include <tuple>
@@ -1219,6 +1222,151 @@ TEST_F(TestGroupDataProvider, TestGroupDecryption)
     it->Release();
 }
 
+size_t CountGroupSessions(GroupDataProvider * provider, uint16_t session_id, FabricIndex fabric_index, GroupId group_id)
+{
+    GroupSession session;
+    size_t count = 0;
+
+    auto it = provider->IterateGroupSessions(session_id);
+    VerifyOrReturnValue(it != nullptr, 0);
+    while (it->Next(session))
+    {
+        EXPECT_NE(session.keyContext, nullptr);
+        if ((session.fabric_index == fabric_index) && (session.group_id == group_id))
+        {
+            count++;
+        }
+    }
+    it->Release();
+    return count;
+}
+
+TEST_F(TestGroupDataProvider, TestGroupSessionCache)
+{
+    GroupDataProvider * provider = GetGroupDataProvider();
+    EXPECT_TRUE(provider);
+
+    // Reset test
+    ResetProvider(provider);
+
+    EXPECT_EQ(provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet2), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet1), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric1, 0, kGroup1Keyset2), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric2, 0, kGroup2Keyset1), CHIP_NO_ERROR);
+
+    Crypto::SymmetricKeyContext * key_context = provider->GetKeyContext(kFabric2, kGroup2);
+    ASSERT_NE(nullptr, key_context);
+    const uint16_t session_id = key_context->GetKeyHash();
+    key_context->Release();
+
+    // First lookup loads the cache
+    EXPECT_EQ(1u, CountGroupSessions(provider, session_id, kFabric2, kGroup2));
+
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_MAX_KEYSETS > 0
+    // Further lookups do not read the storage
+    const std::string keyset_key = DefaultStorageKeyAllocator::FabricKeyset(kFabric2, kKeysetId1).KeyName();
+    sDelegate.AddPoisonKey(keyset_key);
+    EXPECT_EQ(1u, CountGroupSessions(provider, session_id, kFabric2, kGroup2));
+
+    // Changes to the keys invalidate the cache: the storage is read again
+    EXPECT_EQ(provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet4), CHIP_NO_ERROR);
+    EXPECT_EQ(0u, CountGroupSessions(provider, session_id, kFabric2, kGroup2));
+    sDelegate.ClearPoisonKeys();
+#endif
+    EXPECT_EQ(1u, CountGroupSessions(provider, session_id, kFabric2, kGroup2));
+
+    // New mappings are found
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric2, 1, kGroup3Keyset1), CHIP_NO_ERROR);
+    EXPECT_EQ(1u, CountGroupSessions(provider, session_id, kFabric2, kGroup2));
+    EXPECT_EQ(1u, CountGroupSessions(provider, session_id, kFabric2, kGroup3));
+
+    // Changes during an iteration end it
+    GroupSession session;
+    auto it = provider->IterateGroupSessions(session_id);
+    ASSERT_NE(it, nullptr);
+    EXPECT_EQ(2u, it->Count());
+    EXPECT_TRUE(it->Next(session));
+    EXPECT_EQ(provider->RemoveGroupKeyAt(kFabric2, 1), CHIP_NO_ERROR);
+    EXPECT_FALSE(it->Next(session));
+    it->Release();
+    EXPECT_EQ(0u, CountGroupSessions(provider, session_id, kFabric2, kGroup3));
+
+    // Removed keys are no longer found (along with their mappings)
+    EXPECT_EQ(provider->RemoveKeySet(kFabric2, kKeysetId1), CHIP_NO_ERROR);
+    EXPECT_EQ(0u, CountGroupSessions(provider, session_id, kFabric2, kGroup2));
+
+    // Re-created keys are found again, and removed with their fabric
+    EXPECT_EQ(provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet1), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric2, 0, kGroup2Keyset1), CHIP_NO_ERROR);
+    EXPECT_EQ(1u, CountGroupSessions(provider, session_id, kFabric2, kGroup2));
+    EXPECT_EQ(provider->RemoveFabric(kFabric2), CHIP_NO_ERROR);
+    EXPECT_EQ(0u, CountGroupSessions(provider, session_id, kFabric2, kGroup2));
+}
+
+TEST_F(TestGroupDataProvider, TestGroupReceiveBenchmark)
+{
+    constexpr size_t kMessages = 2000;
+
+    GroupDataProvider * provider = GetGroupDataProvider();
+    EXPECT_TRUE(provider);
+
+    // Reset test
+    ResetProvider(provider);
+
+    // Groups of both fabrics, sharing their fabric's key sets
+    EXPECT_EQ(provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet2), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet3), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet1), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric1, 0, kGroup1Keyset2), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric1, 1, kGroup2Keyset3), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric1, 2, kGroup3Keyset2), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric2, 0, kGroup1Keyset1), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric2, 1, kGroup2Keyset1), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric2, 2, kGroup3Keyset1), CHIP_NO_ERROR);
+
+    const uint8_t kMessage[] = { 0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9 };
+    const uint8_t nonce[13]  = { 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x18, 0x1a, 0x1b, 0x1c };
+    const uint8_t aad[8]     = { 0x0a, 0x1a, 0x2a, 0x3a, 0x4a, 0x5a, 0x6a, 0x7a };
+    uint8_t mic[16];
+    uint8_t ciphertext_buffer[sizeof(kMessage)];
+    uint8_t plaintext_buffer[sizeof(kMessage)];
+    MutableByteSpan ciphertext(ciphertext_buffer);
+    MutableByteSpan tag(mic);
+
+    // Message sent to the last group of the last fabric
+    Crypto::SymmetricKeyContext * key_context = provider->GetKeyContext(kFabric2, kGroup3);
+    ASSERT_NE(nullptr, key_context);
+    const uint16_t session_id = key_context->GetKeyHash();
+    EXPECT_EQ(key_context->MessageEncrypt(ByteSpan(kMessage), ByteSpan(aad), ByteSpan(nonce), tag, ciphertext), CHIP_NO_ERROR);
+    key_context->Release();
+
+    // Same lookup as SessionManager::SecureGroupMessageDispatch()
+    size_t decrypted = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kMessages; i++)
+    {
+        GroupSession session;
+        auto it = provider->IterateGroupSessions(session_id);
+        ASSERT_NE(it, nullptr);
+        while (it->Next(session))
+        {
+            MutableByteSpan plaintext(plaintext_buffer);
+            if ((CHIP_NO_ERROR == session.keyContext->MessageDecrypt(ciphertext, ByteSpan(aad), ByteSpan(nonce), tag, plaintext)) &&
+                (session.fabric_index == kFabric2) && (session.group_id == kGroup3))
+            {
+                decrypted++;
+                break;
+            }
+        }
+        it->Release();
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    ChipLogProgress(Test, "Group receive: %u messages, %u ns per message", static_cast<unsigned>(kMessages),
+                    static_cast<unsigned>(elapsed.count() / static_cast<long long>(kMessages)));
+    EXPECT_EQ(decrypted, kMessages);
+}
+
 } // namespace TestGroups
 } // namespace app
 } // namespace chip
@@ -775,6 +775,46 @@ CHIP_ERROR EcdsaAsn1SignatureToRaw(size_t fe_length_bytes, const ByteSpan & asn1
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR Aes128CcmContext::Init(const Aes128KeyHandle & key)
+{
+    Clear();
+    mKey = &key;
+    return CHIP_NO_ERROR;
+}
+
+void Aes128CcmContext::Clear()
+{
+    ReleaseCipherState(mEncryptState);
+    ReleaseCipherState(mDecryptState);
+    mKey = nullptr;
+}
+
+#if !(CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL || CHIP_CRYPTO_MBEDTLS)
+// Backends without a cipher context to cache run every message through the one-shot functions.
+
+void Aes128CcmContext::ReleaseCipherState(CipherState & state)
+{
+    state = CipherState();
+}
+
+CHIP_ERROR Aes128CcmContext::Encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
+                                     const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext, uint8_t * tag,
+                                     size_t tag_length)
+{
+    VerifyOrReturnError(mKey != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    return AES_CCM_encrypt(plaintext, plaintext_length, aad, aad_length, *mKey, nonce, nonce_length, ciphertext, tag, tag_length);
+}
+
+CHIP_ERROR Aes128CcmContext::Decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad, size_t aad_length,
+                                     const uint8_t * tag, size_t tag_length, const uint8_t * nonce, size_t nonce_length,
+                                     uint8_t * plaintext)
+{
+    VerifyOrReturnError(mKey != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    return AES_CCM_decrypt(ciphertext, ciphertext_length, aad, aad_length, tag, tag_length, *mKey, nonce, nonce_length, plaintext);
+}
+
+#endif // !(CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL || CHIP_CRYPTO_MBEDTLS)
+
 CHIP_ERROR AES_CTR_crypt(const uint8_t * input, size_t input_length, const Aes128KeyHandle & key, const uint8_t * nonce,
                          size_t nonce_length, uint8_t * output)
 {
@@ -786,6 +786,67 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
                            const uint8_t * tag, size_t tag_length, const Aes128KeyHandle & key, const uint8_t * nonce,
                            size_t nonce_length, uint8_t * plaintext);
 
+/**
+ * @brief AES-CCM cipher bound to a single key, for encrypting or decrypting many messages under that key.
+ *
+ * Unlike AES_CCM_encrypt() and AES_CCM_decrypt(), which set up a cipher context and expand the key on every call,
+ * the OpenSSL, BoringSSL and mbedTLS backends keep one cipher context per direction, set up on its first use, so
+ * that every following message only pays for its nonce. Other backends forward each call to AES_CCM_encrypt() and
+ * AES_CCM_decrypt().
+ *
+ * The key handle given to Init() is referenced, not copied: it must outlive the context, or the context must be
+ * cleared before the key is destroyed.
+ */
+class Aes128CcmContext
+{
+public:
+    Aes128CcmContext() = default;
+    ~Aes128CcmContext() { Clear(); }
+
+    Aes128CcmContext(const Aes128CcmContext &)             = delete;
+    Aes128CcmContext & operator=(const Aes128CcmContext &) = delete;
+
+    /**
+     * @brief Bind the context to a key, releasing any cipher state set up for a previous key.
+     */
+    CHIP_ERROR Init(const Aes128KeyHandle & key);
+
+    /**
+     * @brief Release the cipher state and unbind the key.
+     */
+    void Clear();
+
+    bool IsInitialized() const { return mKey != nullptr; }
+
+    /**
+     * @brief Same as AES_CCM_encrypt(), with the key given to Init().
+     */
+    CHIP_ERROR Encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
+                       const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext, uint8_t * tag, size_t tag_length);
+
+    /**
+     * @brief Same as AES_CCM_decrypt(), with the key given to Init().
+     */
+    CHIP_ERROR Decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad, size_t aad_length,
+                       const uint8_t * tag, size_t tag_length, const uint8_t * nonce, size_t nonce_length, uint8_t * plaintext);
+
+private:
+    // Backend cipher context for one direction, along with the nonce and tag lengths it was set up for.
+    struct CipherState
+    {
+        void * mPalContext  = nullptr;
+        size_t mNonceLength = 0;
+        size_t mTagLength   = 0;
+    };
+
+    CHIP_ERROR SetUpCipherState(CipherState & state, bool encrypt, size_t nonce_length, size_t tag_length);
+    static void ReleaseCipherState(CipherState & state);
+
+    const Aes128KeyHandle * mKey = nullptr;
+    CipherState mEncryptState;
+    CipherState mDecryptState;
+};
+
 /**
  * @brief A function that implements AES-CTR encryption/decryption
  *
@@ -45,6 +45,7 @@
 #include <lib/support/BufferWriter.h>
 #include <lib/support/BytesToHex.h>
 #include <lib/support/CHIPArgParser.hpp>
+#include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/SafeInt.h>
 #include <lib/support/SafePointerCast.h>
@@ -150,6 +151,106 @@ exit:
     return error;
 }
 
+CHIP_ERROR Aes128CcmContext::SetUpCipherState(CipherState & state, bool encrypt, size_t nonce_length, size_t tag_length)
+{
+    // mbedTLS takes the nonce and tag lengths with every message, only the key is bound to the context.
+    (void) encrypt;
+    (void) nonce_length;
+    (void) tag_length;
+
+    VerifyOrReturnError(mKey != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    if (state.mPalContext != nullptr)
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    mbedtls_ccm_context * context = Platform::New<mbedtls_ccm_context>();
+    VerifyOrReturnError(context != nullptr, CHIP_ERROR_NO_MEMORY);
+    mbedtls_ccm_init(context);
+
+    // Size of key is expressed in bits, hence the multiplication by 8.
+    int result = mbedtls_ccm_setkey(context, MBEDTLS_CIPHER_ID_AES, mKey->As<Symmetric128BitsKeyByteArray>(),
+                                    sizeof(Symmetric128BitsKeyByteArray) * 8);
+    if (result != 0)
+    {
+        mbedtls_ccm_free(context);
+        Platform::Delete(context);
+        return CHIP_ERROR_INTERNAL;
+    }
+
+    state.mPalContext = context;
+    return CHIP_NO_ERROR;
+}
+
+void Aes128CcmContext::ReleaseCipherState(CipherState & state)
+{
+    if (state.mPalContext != nullptr)
+    {
+        mbedtls_ccm_context * context = static_cast<mbedtls_ccm_context *>(state.mPalContext);
+        mbedtls_ccm_free(context);
+        Platform::Delete(context);
+    }
+    state = CipherState();
+}
+
+CHIP_ERROR Aes128CcmContext::Encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
+                                     const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext, uint8_t * tag,
+                                     size_t tag_length)
+{
+    VerifyOrReturnError(mKey != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(plaintext != nullptr || plaintext_length == 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(ciphertext != nullptr || plaintext_length == 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(nonce != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(nonce_length > 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(tag != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(_isValidTagLength(tag_length), CHIP_ERROR_INVALID_ARGUMENT);
+    if (aad_length > 0)
+    {
+        VerifyOrReturnError(aad != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    ReturnErrorOnFailure(SetUpCipherState(mEncryptState, true, nonce_length, tag_length));
+
+    // Encrypt
+    int result = mbedtls_ccm_encrypt_and_tag(static_cast<mbedtls_ccm_context *>(mEncryptState.mPalContext), plaintext_length,
+                                             Uint8::to_const_uchar(nonce), nonce_length, Uint8::to_const_uchar(aad), aad_length,
+                                             Uint8::to_const_uchar(plaintext), Uint8::to_uchar(ciphertext), Uint8::to_uchar(tag),
+                                             tag_length);
+    _log_mbedTLS_error(result);
+    VerifyOrReturnError(result == 0, CHIP_ERROR_INTERNAL);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR Aes128CcmContext::Decrypt(const uint8_t * ciphertext, size_t ciphertext_len, const uint8_t * aad, size_t aad_len,
+                                     const uint8_t * tag, size_t tag_length, const uint8_t * nonce, size_t nonce_length,
+                                     uint8_t * plaintext)
+{
+    VerifyOrReturnError(mKey != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(plaintext != nullptr || ciphertext_len == 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(ciphertext != nullptr || ciphertext_len == 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(tag != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(_isValidTagLength(tag_length), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(nonce != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(nonce_length > 0, CHIP_ERROR_INVALID_ARGUMENT);
+    if (aad_len > 0)
+    {
+        VerifyOrReturnError(aad != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    ReturnErrorOnFailure(SetUpCipherState(mDecryptState, false, nonce_length, tag_length));
+
+    // Decrypt
+    int result = mbedtls_ccm_auth_decrypt(static_cast<mbedtls_ccm_context *>(mDecryptState.mPalContext), ciphertext_len,
+                                          Uint8::to_const_uchar(nonce), nonce_length, Uint8::to_const_uchar(aad), aad_len,
+                                          Uint8::to_const_uchar(ciphertext), Uint8::to_uchar(plaintext),
+                                          Uint8::to_const_uchar(tag), tag_length);
+    _log_mbedTLS_error(result);
+    VerifyOrReturnError(result == 0, CHIP_ERROR_INTERNAL);
+
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR Hash_SHA256(const uint8_t * data, const size_t data_length, uint8_t * out_buffer)
 {
     // zero data length hash is supported.
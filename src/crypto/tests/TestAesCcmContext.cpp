@@ -0,0 +1,255 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a unit test suite for <tt>chip::Crypto::Aes128CcmContext</tt>, which also compares its throughput with
+ *      the one-shot AES_CCM_encrypt() and AES_CCM_decrypt().
+ */
+
+#include "AES_CCM_128_test_vectors.h"
+
+#include <crypto/CHIPCryptoPAL.h>
+#include <crypto/DefaultSessionKeystore.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string.h>
+
+#if CHIP_CRYPTO_PSA
+#include <psa/crypto.h>
+#endif
+
+using namespace chip;
+using namespace chip::Crypto;
+
+namespace {
+
+struct TestAesKey
+{
+    TestAesKey(const uint8_t * keyBytes)
+    {
+        Symmetric128BitsKeyByteArray keyMaterial;
+        memcpy(&keyMaterial, keyBytes, sizeof(keyMaterial));
+        EXPECT_EQ(keystore.CreateKey(keyMaterial, key), CHIP_NO_ERROR);
+    }
+
+    ~TestAesKey() { keystore.DestroyKey(key); }
+
+    DefaultSessionKeystore keystore;
+    Aes128KeyHandle key;
+};
+
+constexpr uint8_t kTestKey[] = { 0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+                                 0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf };
+
+class TestAesCcmContext : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite()
+    {
+        ASSERT_EQ(Platform::MemoryInit(), CHIP_NO_ERROR);
+#if CHIP_CRYPTO_PSA
+        psa_crypto_init();
+#endif
+    }
+    static void TearDownTestSuite() { Platform::MemoryShutdown(); }
+};
+
+TEST_F(TestAesCcmContext, TestUninitialized)
+{
+    Aes128CcmContext context;
+    uint8_t nonce[kAES_CCM128_Nonce_Length] = {};
+    uint8_t buffer[16]                      = {};
+    uint8_t tag[kAES_CCM128_Tag_Length];
+
+    EXPECT_FALSE(context.IsInitialized());
+    EXPECT_EQ(context.Encrypt(buffer, sizeof(buffer), nullptr, 0, nonce, sizeof(nonce), buffer, tag, sizeof(tag)),
+              CHIP_ERROR_INCORRECT_STATE);
+    EXPECT_EQ(context.Decrypt(buffer, sizeof(buffer), nullptr, 0, tag, sizeof(tag), nonce, sizeof(nonce), buffer),
+              CHIP_ERROR_INCORRECT_STATE);
+
+    TestAesKey key(kTestKey);
+    EXPECT_EQ(context.Init(key.key), CHIP_NO_ERROR);
+    EXPECT_TRUE(context.IsInitialized());
+    context.Clear();
+    EXPECT_FALSE(context.IsInitialized());
+}
+
+TEST_F(TestAesCcmContext, TestTestVectors)
+{
+    int numOfTestsRan = 0;
+    for (const ccm_128_test_vector * vector : ccm_128_test_vectors)
+    {
+        if (vector->pt_len == 0)
+        {
+            continue;
+        }
+        numOfTestsRan++;
+
+        Platform::ScopedMemoryBuffer<uint8_t> out_ct;
+        Platform::ScopedMemoryBuffer<uint8_t> out_tag;
+        Platform::ScopedMemoryBuffer<uint8_t> out_pt;
+        ASSERT_TRUE(out_ct.Alloc(vector->ct_len));
+        ASSERT_TRUE(out_tag.Alloc(vector->tag_len));
+        ASSERT_TRUE(out_pt.Alloc(vector->pt_len));
+
+        TestAesKey key(vector->key);
+        Aes128CcmContext context;
+        ASSERT_EQ(context.Init(key.key), CHIP_NO_ERROR);
+
+        // Run every vector twice through the same context, alternating directions, to exercise the cached state.
+        for (int round = 0; round < 2; round++)
+        {
+            CHIP_ERROR err = context.Encrypt(vector->pt, vector->pt_len, vector->aad, vector->aad_len, vector->nonce,
+                                             vector->nonce_len, out_ct.Get(), out_tag.Get(), vector->tag_len);
+            EXPECT_EQ(err, vector->result);
+            if (vector->result == CHIP_NO_ERROR)
+            {
+                EXPECT_EQ(memcmp(out_ct.Get(), vector->ct, vector->ct_len), 0) << "test " << vector->tcId;
+                EXPECT_EQ(memcmp(out_tag.Get(), vector->tag, vector->tag_len), 0) << "test " << vector->tcId;
+            }
+
+            err = context.Decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, vector->tag, vector->tag_len,
+                                  vector->nonce, vector->nonce_len, out_pt.Get());
+            EXPECT_EQ(err, vector->result);
+            if (vector->result == CHIP_NO_ERROR)
+            {
+                EXPECT_EQ(memcmp(out_pt.Get(), vector->pt, vector->pt_len), 0) << "test " << vector->tcId;
+            }
+        }
+    }
+    EXPECT_GT(numOfTestsRan, 0);
+}
+
+TEST_F(TestAesCcmContext, TestMatchesOneShot)
+{
+    TestAesKey key(kTestKey);
+    Aes128CcmContext context;
+    ASSERT_EQ(context.Init(key.key), CHIP_NO_ERROR);
+
+    uint8_t plaintext[100];
+    uint8_t aad[20];
+    uint8_t nonce[kAES_CCM128_Nonce_Length] = {};
+    for (size_t i = 0; i < sizeof(plaintext); i++)
+    {
+        plaintext[i] = static_cast<uint8_t>(i);
+    }
+    memset(aad, 0xaa, sizeof(aad));
+
+    // Vary the message, the tag length and the nonce length from one message to the next.
+    const size_t tagLengths[]   = { 16, 8, 12, 16 };
+    const size_t nonceLengths[] = { 13, 13, 12, 13 };
+    for (uint8_t i = 0; i < 40; i++)
+    {
+        const size_t tagLength   = tagLengths[i % ArraySize(tagLengths)];
+        const size_t nonceLength = nonceLengths[i % ArraySize(nonceLengths)];
+        const size_t length      = sizeof(plaintext) - i;
+        nonce[0]                 = i;
+        aad[0]                   = i;
+
+        uint8_t expectedCiphertext[sizeof(plaintext)];
+        uint8_t expectedTag[kAES_CCM128_Tag_Length];
+        ASSERT_EQ(AES_CCM_encrypt(plaintext, length, aad, sizeof(aad), key.key, nonce, nonceLength, expectedCiphertext, expectedTag,
+                                  tagLength),
+                  CHIP_NO_ERROR);
+
+        uint8_t ciphertext[sizeof(plaintext)];
+        uint8_t tag[kAES_CCM128_Tag_Length];
+        ASSERT_EQ(context.Encrypt(plaintext, length, aad, sizeof(aad), nonce, nonceLength, ciphertext, tag, tagLength),
+                  CHIP_NO_ERROR);
+        EXPECT_EQ(memcmp(ciphertext, expectedCiphertext, length), 0);
+        EXPECT_EQ(memcmp(tag, expectedTag, tagLength), 0);
+
+        uint8_t decrypted[sizeof(plaintext)];
+        ASSERT_EQ(context.Decrypt(ciphertext, length, aad, sizeof(aad), tag, tagLength, nonce, nonceLength, decrypted),
+                  CHIP_NO_ERROR);
+        EXPECT_EQ(memcmp(decrypted, plaintext, length), 0);
+
+        // A failed authentication must not break the following messages.
+        tag[0] ^= 1;
+        EXPECT_NE(context.Decrypt(ciphertext, length, aad, sizeof(aad), tag, tagLength, nonce, nonceLength, decrypted),
+                  CHIP_NO_ERROR);
+    }
+}
+
+struct BenchmarkResult
+{
+    double mOneShotPerSecond;
+    double mContextPerSecond;
+};
+
+// Measure how many messages of the given length can be encrypted and then decrypted per second, with a cipher set up for
+// every message and with a single Aes128CcmContext.
+BenchmarkResult RunBenchmark(size_t length)
+{
+    constexpr unsigned kIterations = 20000;
+    BenchmarkResult result         = {};
+
+    TestAesKey key(kTestKey);
+    Aes128CcmContext context;
+    EXPECT_EQ(context.Init(key.key), CHIP_NO_ERROR);
+
+    uint8_t plaintext[1024] = {};
+    uint8_t ciphertext[sizeof(plaintext)];
+    uint8_t aad[24]                         = {};
+    uint8_t nonce[kAES_CCM128_Nonce_Length] = {};
+    uint8_t tag[kAES_CCM128_Tag_Length];
+    VerifyOrDie(length <= sizeof(plaintext));
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < kIterations; i++)
+    {
+        memcpy(nonce, &i, sizeof(i));
+        EXPECT_EQ(AES_CCM_encrypt(plaintext, length, aad, sizeof(aad), key.key, nonce, sizeof(nonce), ciphertext, tag, sizeof(tag)),
+                  CHIP_NO_ERROR);
+        EXPECT_EQ(AES_CCM_decrypt(ciphertext, length, aad, sizeof(aad), tag, sizeof(tag), key.key, nonce, sizeof(nonce), plaintext),
+                  CHIP_NO_ERROR);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    result.mOneShotPerSecond              = kIterations / elapsed.count();
+
+    start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < kIterations; i++)
+    {
+        memcpy(nonce, &i, sizeof(i));
+        EXPECT_EQ(context.Encrypt(plaintext, length, aad, sizeof(aad), nonce, sizeof(nonce), ciphertext, tag, sizeof(tag)),
+                  CHIP_NO_ERROR);
+        EXPECT_EQ(context.Decrypt(ciphertext, length, aad, sizeof(aad), tag, sizeof(tag), nonce, sizeof(nonce), plaintext),
+                  CHIP_NO_ERROR);
+    }
+    elapsed                  = std::chrono::steady_clock::now() - start;
+    result.mContextPerSecond = kIterations / elapsed.count();
+
+    return result;
+}
+
+TEST_F(TestAesCcmContext, BenchmarkAgainstOneShot)
+{
+    for (size_t length : { 64u, 1024u })
+    {
+        BenchmarkResult result = RunBenchmark(length);
+        ChipLogProgress(Test, "AES-CCM %u-byte messages, one-shot: %.0f round trips/s, cached context: %.0f round trips/s",
+                        static_cast<unsigned>(length), result.mOneShotPerSecond, result.mContextPerSecond);
+    }
+}
+
+} // namespace
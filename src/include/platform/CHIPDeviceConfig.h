@@ -1317,6 +1317,21 @@ static_assert(CHIP_DEVICE_CONFIG_BLE_EXT_ADVERTISING_INTERVAL_MIN <= CHIP_DEVICE
 #define CHIP_DEVICE_CONFIG_EVENT_LOGGING_DEBUG_BUFFER_SIZE (512)
 #endif
 
+/**
+ * @def CHIP_DEVICE_CONFIG_EVENT_LOGGING_INDEX_SIZE
+ *
+ * @brief
+ *   The number of entries of the index kept alongside each event logging
+ *   buffer, which is also the maximum number of events each buffer holds.
+ *   The index lets reads and subscriptions skip the events they are not
+ *   interested in without decoding them, at the cost of 24 bytes per entry.
+ *
+ *   Note: set to 0 to disable the index.
+ */
+#ifndef CHIP_DEVICE_CONFIG_EVENT_LOGGING_INDEX_SIZE
+#define CHIP_DEVICE_CONFIG_EVENT_LOGGING_INDEX_SIZE 0
+#endif
+
 /**
  *  @def CHIP_DEVICE_CONFIG_EVENT_ID_COUNTER_EPOCH
  *
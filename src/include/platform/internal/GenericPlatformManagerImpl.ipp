@@ -37,6 +37,7 @@
 #include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemPacketBuffer.h>
 
 namespace chip {
 namespace DeviceLayer {
@@ -153,6 +154,11 @@ void GenericPlatformManagerImpl<ImplClass>::_Shutdown()
 
     ChipLogProgress(DeviceLayer, "System Layer shutdown");
     SystemLayer().Shutdown();
+
+    // Return the packet buffers kept for reuse to the heap, so that they do not outlive Platform::MemoryShutdown(). This only
+    // covers the calling thread and the threads that already exited: an event loop running on threads that outlive the
+    // shutdown (e.g. dispatch queue workers) keeps its per-thread packet buffer cache until those threads exit.
+    System::PacketBuffer::ReleaseHeapCache();
 }
 
 template <class ImplClass>
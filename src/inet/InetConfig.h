@@ -272,6 +272,48 @@
 #endif
 #endif // INET_CONFIG_UDP_SOCKET_PKTINFO
 
+/**
+ *  @def INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE
+ *
+ *  @brief
+ *    Maximum number of datagrams the socket-based implementation of UDP
+ *    endpoints reads with a single system call when its socket is readable.
+ *
+ *  @details
+ *    A value greater than 1 requires recvmmsg() and costs one packet buffer
+ *    per batch slot while the batch is being received; unused buffers are
+ *    released right after the call. A value of 1 reads one datagram per
+ *    readiness event with recvmsg().
+ */
+#ifndef INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE
+#if defined(__linux__) && !defined(__ZEPHYR__)
+#define INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE 8
+#else
+#define INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE 1
+#endif
+#endif // INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE
+
+/**
+ *  @def INET_CONFIG_UDP_SOCKET_SEND_BATCH_SIZE
+ *
+ *  @brief
+ *    Maximum number of datagrams the socket-based implementation of UDP
+ *    endpoints hands to the network stack with a single system call when
+ *    sending a batch of messages with UDPEndPoint::SendMsgs().
+ *
+ *  @details
+ *    A value greater than 1 requires sendmmsg(). A value of 1 sends each
+ *    message of a batch with its own sendmsg() call. Messages sent with
+ *    UDPEndPoint::SendMsg() or UDPEndPoint::SendTo() always use sendmsg().
+ */
+#ifndef INET_CONFIG_UDP_SOCKET_SEND_BATCH_SIZE
+#if defined(__linux__) && !defined(__ZEPHYR__)
+#define INET_CONFIG_UDP_SOCKET_SEND_BATCH_SIZE 8
+#else
+#define INET_CONFIG_UDP_SOCKET_SEND_BATCH_SIZE 1
+#endif
+#endif // INET_CONFIG_UDP_SOCKET_SEND_BATCH_SIZE
+
 /**
  *  @def HAVE_SO_BINDTODEVICE
  *
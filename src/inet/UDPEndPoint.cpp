@@ -121,6 +121,35 @@ CHIP_ERROR UDPEndPoint::SendMsg(const IPPacketInfo * pktInfo, System::PacketBuff
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR UDPEndPoint::SendMsgs(const IPPacketInfo * pktInfos, System::PacketBufferHandle * msgs, CHIP_ERROR * errors,
+                                 size_t count)
+{
+    SendMsgsImpl(pktInfos, msgs, errors, count);
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    for (size_t i = 0; i < count; i++)
+    {
+        msgs[i] = nullptr;
+        if (err == CHIP_NO_ERROR)
+        {
+            err = errors[i];
+        }
+    }
+
+    CHIP_SYSTEM_FAULT_INJECT_ASYNC_EVENT();
+
+    return err;
+}
+
+void UDPEndPoint::SendMsgsImpl(const IPPacketInfo * pktInfos, System::PacketBufferHandle * msgs, CHIP_ERROR * errors,
+                               size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        errors[i] = SendMsgImpl(&pktInfos[i], std::move(msgs[i]));
+    }
+}
+
 void UDPEndPoint::Close()
 {
     if (mState != State::kClosed)
@@ -227,6 +227,23 @@ public:
      */
     CHIP_ERROR SendMsg(const IPPacketInfo * pktInfo, chip::System::PacketBufferHandle && msg);
 
+    /**
+     * Send a batch of UDP messages.
+     *
+     *  Send each message of \c msgs as SendMsg() would, to the destination given by the matching entry of \c pktInfos, in
+     *  order. Implementations may hand several messages to the network stack at once (see
+     *  INET_CONFIG_UDP_SOCKET_SEND_BATCH_SIZE). A message that fails to send does not stop the others.
+     *
+     * @param[in]   pktInfos    Source and destination information for each UDP message.
+     * @param[in]   msgs        Packet buffers containing the UDP messages; all of them are released.
+     * @param[out]  errors      The result of sending each message, as SendMsg() would return it.
+     * @param[in]   count       Number of messages in \c pktInfos, \c msgs and \c errors.
+     *
+     * @retval  CHIP_NO_ERROR   Success: every message is queued for transmit.
+     * @retval  other           The first error stored in \c errors.
+     */
+    CHIP_ERROR SendMsgs(const IPPacketInfo * pktInfos, chip::System::PacketBufferHandle * msgs, CHIP_ERROR * errors, size_t count);
+
     /**
      * Close the endpoint.
      *
@@ -296,6 +313,10 @@ protected:
     virtual CHIP_ERROR ListenImpl()                                                                                           = 0;
     virtual CHIP_ERROR SendMsgImpl(const IPPacketInfo * pktInfo, chip::System::PacketBufferHandle && msg)                     = 0;
     virtual void CloseImpl()                                                                                                  = 0;
+
+    // Sends each message with SendMsgImpl(); implementations able to send several messages at once override it.
+    virtual void SendMsgsImpl(const IPPacketInfo * pktInfos, chip::System::PacketBufferHandle * msgs, CHIP_ERROR * errors,
+                              size_t count);
 };
 
 template <>
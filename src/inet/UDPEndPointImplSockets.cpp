@@ -278,6 +278,33 @@ CHIP_ERROR UDPEndPointImplSockets::ListenImpl()
 }
 
 CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, System::PacketBufferHandle && msg)
+{
+    struct iovec msgIOV;
+    SockAddr peerSockAddr;
+    uint8_t controlData[kSendControlDataSize];
+    struct msghdr msgHeader;
+
+    ReturnErrorOnFailure(InitSendHeader(aPktInfo, msg, msgHeader, msgIOV, peerSockAddr, controlData, sizeof(controlData)));
+
+    // Send IP packet.
+    const ssize_t lenSent = sendmsg(mSocket, &msgHeader, 0);
+    if (lenSent == -1)
+    {
+        return CHIP_ERROR_POSIX(errno);
+    }
+
+    size_t len = static_cast<size_t>(lenSent);
+
+    if (len != msg->DataLength())
+    {
+        return CHIP_ERROR_OUTBOUND_MESSAGE_TOO_BIG;
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR UDPEndPointImplSockets::InitSendHeader(const IPPacketInfo * aPktInfo, const System::PacketBufferHandle & msg,
+                                                  struct msghdr & msgHeader, struct iovec & msgIOV, SockAddr & peerSockAddr,
+                                                  uint8_t * controlData, size_t controlDataLen)
 {
     // Ensure packet buffer is not null
     VerifyOrReturnError(!msg.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
@@ -292,22 +319,16 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
     // For now the entire message must fit within a single buffer.
     VerifyOrReturnError(!msg->HasChainedBuffer(), CHIP_ERROR_MESSAGE_TOO_LONG);
 
-    struct iovec msgIOV;
     msgIOV.iov_base = msg->Start();
     msgIOV.iov_len  = msg->DataLength();
 
-#if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
-    uint8_t controlData[256];
-    memset(controlData, 0, sizeof(controlData));
-#endif // defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
+    memset(controlData, 0, controlDataLen);
 
-    struct msghdr msgHeader;
     memset(&msgHeader, 0, sizeof(msgHeader));
     msgHeader.msg_iov    = &msgIOV;
     msgHeader.msg_iovlen = 1;
 
     // Construct a sockaddr_in/sockaddr_in6 structure containing the destination information.
-    SockAddr peerSockAddr;
     memset(&peerSockAddr, 0, sizeof(peerSockAddr));
     msgHeader.msg_name = &peerSockAddr;
     if (mAddrType == IPAddressType::kIPv6)
@@ -351,7 +372,7 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
     {
 #if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
         msgHeader.msg_control    = controlData;
-        msgHeader.msg_controllen = sizeof(controlData);
+        msgHeader.msg_controllen = controlDataLen;
 
         struct cmsghdr * controlHdr      = CMSG_FIRSTHDR(&msgHeader);
         InterfaceId::PlatformType intfId = intf.GetPlatformInterface();
@@ -409,21 +430,60 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
     }
 #endif // INET_CONFIG_UDP_SOCKET_PKTINFO
 
-    // Send IP packet.
-    const ssize_t lenSent = sendmsg(mSocket, &msgHeader, 0);
-    if (lenSent == -1)
-    {
-        return CHIP_ERROR_POSIX(errno);
-    }
+    return CHIP_NO_ERROR;
+}
 
-    size_t len = static_cast<size_t>(lenSent);
+#if INET_CONFIG_UDP_SOCKET_SEND_BATCH_SIZE > 1
+void UDPEndPointImplSockets::SendMsgsImpl(const IPPacketInfo * aPktInfos, System::PacketBufferHandle * aMsgs, CHIP_ERROR * aErrors,
+                                          size_t aCount)
+{
+    constexpr unsigned int kBatchSize = INET_CONFIG_UDP_SOCKET_SEND_BATCH_SIZE;
 
-    if (len != msg->DataLength())
+    struct iovec msgIOV[kBatchSize];
+    SockAddr lPeerSockAddrs[kBatchSize];
+    uint8_t controlData[kBatchSize][kSendControlDataSize];
+    struct mmsghdr msgHeaders[kBatchSize];
+    size_t lIndices[kBatchSize];
+
+    size_t lNext = 0;
+    while (lNext < aCount)
     {
-        return CHIP_ERROR_OUTBOUND_MESSAGE_TOO_BIG;
+        // Fill a batch with the next messages; the ones that cannot be sent get their error right away.
+        unsigned int lSlots = 0;
+        for (; lNext < aCount && lSlots < kBatchSize; lNext++)
+        {
+            aErrors[lNext] = InitSendHeader(&aPktInfos[lNext], aMsgs[lNext], msgHeaders[lSlots].msg_hdr, msgIOV[lSlots],
+                                            lPeerSockAddrs[lSlots], controlData[lSlots], sizeof(controlData[lSlots]));
+            if (aErrors[lNext] == CHIP_NO_ERROR)
+            {
+                msgHeaders[lSlots].msg_len = 0;
+                lIndices[lSlots++]         = lNext;
+            }
+        }
+
+        // sendmmsg() stops at the first message it fails to send, and only reports the error when that message comes first:
+        // resume after it.
+        unsigned int lSent = 0;
+        while (lSent < lSlots)
+        {
+            const int lResult = sendmmsg(mSocket, msgHeaders + lSent, lSlots - lSent, 0);
+            if (lResult <= 0)
+            {
+                aErrors[lIndices[lSent++]] = (lResult == 0) ? CHIP_ERROR_INTERNAL : CHIP_ERROR_POSIX(errno);
+                continue;
+            }
+
+            for (unsigned int i = 0; i < static_cast<unsigned int>(lResult); i++, lSent++)
+            {
+                if (msgHeaders[lSent].msg_len != aMsgs[lIndices[lSent]]->DataLength())
+                {
+                    aErrors[lIndices[lSent]] = CHIP_ERROR_OUTBOUND_MESSAGE_TOO_BIG;
+                }
+            }
+        }
     }
-    return CHIP_NO_ERROR;
 }
+#endif // INET_CONFIG_UDP_SOCKET_SEND_BATCH_SIZE > 1
 
 void UDPEndPointImplSockets::CloseImpl()
 {
@@ -577,13 +637,118 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
         return;
     }
 
+#if INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+    ReceiveMessageBatch();
+#else
+    ReceiveMessage();
+#endif // INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+}
+
+static void InitReceiveHeader(struct msghdr & msgHeader, struct iovec & msgIOV, SockAddr & peerSockAddr, uint8_t * controlData,
+                              size_t controlDataLen, const System::PacketBufferHandle & buffer)
+{
+    msgIOV.iov_base = buffer->Start();
+    msgIOV.iov_len  = buffer->AvailableDataLength();
+
+    memset(&peerSockAddr, 0, sizeof(peerSockAddr));
+
+    memset(&msgHeader, 0, sizeof(msgHeader));
+
+    msgHeader.msg_name       = &peerSockAddr;
+    msgHeader.msg_namelen    = sizeof(peerSockAddr);
+    msgHeader.msg_iov        = &msgIOV;
+    msgHeader.msg_iovlen     = 1;
+    msgHeader.msg_control    = controlData;
+    msgHeader.msg_controllen = controlDataLen;
+}
+
+// Sets the data length of a received datagram's buffer and fills in the packet info from its source address and control messages.
+static CHIP_ERROR ReadReceivedMessage(struct msghdr & msgHeader, size_t rcvLen, const SockAddr & peerSockAddr,
+                                      const System::PacketBufferHandle & buffer, IPPacketInfo & packetInfo)
+{
+    VerifyOrReturnError(rcvLen <= buffer->AvailableDataLength(), CHIP_ERROR_INBOUND_MESSAGE_TOO_BIG);
+
+    buffer->SetDataLength(static_cast<uint16_t>(rcvLen));
+
+    if (peerSockAddr.any.sa_family == AF_INET6)
+    {
+        packetInfo.SrcAddress = IPAddress(peerSockAddr.in6.sin6_addr);
+        packetInfo.SrcPort    = ntohs(peerSockAddr.in6.sin6_port);
+    }
+#if INET_CONFIG_ENABLE_IPV4
+    else if (peerSockAddr.any.sa_family == AF_INET)
+    {
+        packetInfo.SrcAddress = IPAddress(peerSockAddr.in.sin_addr);
+        packetInfo.SrcPort    = ntohs(peerSockAddr.in.sin_port);
+    }
+#endif // INET_CONFIG_ENABLE_IPV4
+    else
+    {
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
+
+    for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
+         controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
+    {
+#if INET_CONFIG_ENABLE_IPV4
+#ifdef IP_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
+        {
+            auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
+            VerifyOrReturnError(CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex), CHIP_ERROR_INCORRECT_STATE);
+            packetInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
+            packetInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
+            continue;
+        }
+#endif // defined(IP_PKTINFO)
+#endif // INET_CONFIG_ENABLE_IPV4
+
+#ifdef IPV6_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
+        {
+            auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
+            VerifyOrReturnError(CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex), CHIP_ERROR_INCORRECT_STATE);
+            packetInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
+            packetInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
+            continue;
+        }
+#endif // defined(IPV6_PKTINFO)
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void UDPEndPointImplSockets::InitPacketInfo(IPPacketInfo & packetInfo) const
+{
+    packetInfo.Clear();
+    packetInfo.DestPort  = mBoundPort;
+    packetInfo.Interface = mBoundIntfId;
+}
+
+void UDPEndPointImplSockets::DeliverMessage(CHIP_ERROR status, System::PacketBufferHandle && buffer,
+                                            const IPPacketInfo & packetInfo)
+{
+    if (status == CHIP_NO_ERROR)
+    {
+        buffer.RightSize();
+        OnMessageReceived(this, std::move(buffer), &packetInfo);
+    }
+    else
+    {
+        if (OnReceiveError != nullptr && status != CHIP_ERROR_POSIX(EAGAIN))
+        {
+            OnReceiveError(this, status, nullptr);
+        }
+    }
+}
+
+void UDPEndPointImplSockets::ReceiveMessage()
+{
     CHIP_ERROR lStatus = CHIP_NO_ERROR;
     IPPacketInfo lPacketInfo;
     System::PacketBufferHandle lBuffer;
 
-    lPacketInfo.Clear();
-    lPacketInfo.DestPort  = mBoundPort;
-    lPacketInfo.Interface = mBoundIntfId;
+    InitPacketInfo(lPacketInfo);
 
     lBuffer = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
 
@@ -591,22 +756,10 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
     {
         struct iovec msgIOV;
         SockAddr lPeerSockAddr;
-        uint8_t controlData[256];
+        uint8_t controlData[kReceiveControlDataSize];
         struct msghdr msgHeader;
 
-        msgIOV.iov_base = lBuffer->Start();
-        msgIOV.iov_len  = lBuffer->AvailableDataLength();
-
-        memset(&lPeerSockAddr, 0, sizeof(lPeerSockAddr));
-
-        memset(&msgHeader, 0, sizeof(msgHeader));
-
-        msgHeader.msg_name       = &lPeerSockAddr;
-        msgHeader.msg_namelen    = sizeof(lPeerSockAddr);
-        msgHeader.msg_iov        = &msgIOV;
-        msgHeader.msg_iovlen     = 1;
-        msgHeader.msg_control    = controlData;
-        msgHeader.msg_controllen = sizeof(controlData);
+        InitReceiveHeader(msgHeader, msgIOV, lPeerSockAddr, controlData, sizeof(controlData), lBuffer);
 
         ssize_t rcvLen = recvmsg(mSocket, &msgHeader, MSG_DONTWAIT);
 
@@ -614,89 +767,80 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
         {
             lStatus = CHIP_ERROR_POSIX(errno);
         }
-        else if (lBuffer->AvailableDataLength() < static_cast<size_t>(rcvLen))
-        {
-            lStatus = CHIP_ERROR_INBOUND_MESSAGE_TOO_BIG;
-        }
         else
         {
-            lBuffer->SetDataLength(static_cast<uint16_t>(rcvLen));
-
-            if (lPeerSockAddr.any.sa_family == AF_INET6)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in6.sin6_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in6.sin6_port);
-            }
-#if INET_CONFIG_ENABLE_IPV4
-            else if (lPeerSockAddr.any.sa_family == AF_INET)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in.sin_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in.sin_port);
-            }
-#endif // INET_CONFIG_ENABLE_IPV4
-            else
-            {
-                lStatus = CHIP_ERROR_INCORRECT_STATE;
-            }
+            lStatus = ReadReceivedMessage(msgHeader, static_cast<size_t>(rcvLen), lPeerSockAddr, lBuffer, lPacketInfo);
         }
+    }
+    else
+    {
+        lStatus = CHIP_ERROR_NO_MEMORY;
+    }
 
-        if (lStatus == CHIP_NO_ERROR)
-        {
-            for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
-                 controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
-            {
-#if INET_CONFIG_ENABLE_IPV4
-#ifdef IP_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
-                {
-                    auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
-                    continue;
-                }
-#endif // defined(IP_PKTINFO)
-#endif // INET_CONFIG_ENABLE_IPV4
+    DeliverMessage(lStatus, std::move(lBuffer), lPacketInfo);
+}
 
-#ifdef IPV6_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
-                {
-                    auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
-                    continue;
-                }
-#endif // defined(IPV6_PKTINFO)
-            }
+#if INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+void UDPEndPointImplSockets::ReceiveMessageBatch()
+{
+    constexpr unsigned int kBatchSize = INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE;
+
+    System::PacketBufferHandle lBuffers[kBatchSize];
+    struct iovec msgIOV[kBatchSize];
+    SockAddr lPeerSockAddrs[kBatchSize];
+    uint8_t controlData[kBatchSize][kReceiveControlDataSize];
+    struct mmsghdr msgHeaders[kBatchSize];
+
+    // Use as many slots as there are buffers available; a single buffer still makes a (one datagram) batch.
+    unsigned int lSlots = 0;
+    for (; lSlots < kBatchSize; lSlots++)
+    {
+        lBuffers[lSlots] = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+        if (lBuffers[lSlots].IsNull())
+        {
+            break;
         }
+
+        InitReceiveHeader(msgHeaders[lSlots].msg_hdr, msgIOV[lSlots], lPeerSockAddrs[lSlots], controlData[lSlots],
+                          sizeof(controlData[lSlots]), lBuffers[lSlots]);
+        msgHeaders[lSlots].msg_len = 0;
     }
-    else
+
+    if (lSlots == 0)
     {
-        lStatus = CHIP_ERROR_NO_MEMORY;
+        IPPacketInfo lPacketInfo;
+        InitPacketInfo(lPacketInfo);
+        DeliverMessage(CHIP_ERROR_NO_MEMORY, System::PacketBufferHandle(), lPacketInfo);
+        return;
     }
 
-    if (lStatus == CHIP_NO_ERROR)
+    int lReceived = recvmmsg(mSocket, msgHeaders, lSlots, MSG_DONTWAIT, nullptr);
+
+    if (lReceived == -1)
     {
-        lBuffer.RightSize();
-        OnMessageReceived(this, std::move(lBuffer), &lPacketInfo);
+        IPPacketInfo lPacketInfo;
+        InitPacketInfo(lPacketInfo);
+        DeliverMessage(CHIP_ERROR_POSIX(errno), System::PacketBufferHandle(), lPacketInfo);
+        return;
     }
-    else
+
+    // A receive callback may close or free this end point, so hold a reference until the batch is done and stop
+    // delivering as soon as the end point is no longer listening.
+    Retain();
+
+    for (int i = 0; i < lReceived && mState == State::kListening && OnMessageReceived != nullptr; i++)
     {
-        if (OnReceiveError != nullptr && lStatus != CHIP_ERROR_POSIX(EAGAIN))
-        {
-            OnReceiveError(this, lStatus, nullptr);
-        }
+        IPPacketInfo lPacketInfo;
+        InitPacketInfo(lPacketInfo);
+
+        CHIP_ERROR lStatus =
+            ReadReceivedMessage(msgHeaders[i].msg_hdr, msgHeaders[i].msg_len, lPeerSockAddrs[i], lBuffers[i], lPacketInfo);
+        DeliverMessage(lStatus, std::move(lBuffers[i]), lPacketInfo);
     }
+
+    Release();
 }
+#endif // INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
 
 #ifdef IPV6_MULTICAST_LOOP
 static CHIP_ERROR SocketsSetMulticastLoopback(int aSocket, bool aLoopback, int aProtocol, int aOption)
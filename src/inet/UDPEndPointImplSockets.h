@@ -52,11 +52,26 @@ private:
     CHIP_ERROR BindInterfaceImpl(IPAddressType addressType, InterfaceId interfaceId) override;
     CHIP_ERROR ListenImpl() override;
     CHIP_ERROR SendMsgImpl(const IPPacketInfo * pktInfo, chip::System::PacketBufferHandle && msg) override;
+#if INET_CONFIG_UDP_SOCKET_SEND_BATCH_SIZE > 1
+    void SendMsgsImpl(const IPPacketInfo * pktInfos, chip::System::PacketBufferHandle * msgs, CHIP_ERROR * errors,
+                      size_t count) override;
+#endif // INET_CONFIG_UDP_SOCKET_SEND_BATCH_SIZE > 1
     void CloseImpl() override;
 
     CHIP_ERROR GetSocket(IPAddressType addressType);
     void HandlePendingIO(System::SocketEvents events);
     static void HandlePendingIO(System::SocketEvents events, intptr_t data);
+    CHIP_ERROR InitSendHeader(const IPPacketInfo * pktInfo, const System::PacketBufferHandle & msg, struct msghdr & msgHeader,
+                              struct iovec & msgIOV, SockAddr & peerSockAddr, uint8_t * controlData, size_t controlDataLen);
+    void InitPacketInfo(IPPacketInfo & packetInfo) const;
+    void DeliverMessage(CHIP_ERROR status, System::PacketBufferHandle && buffer, const IPPacketInfo & packetInfo);
+    void ReceiveMessage();
+#if INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+    void ReceiveMessageBatch();
+#endif // INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+
+    static constexpr size_t kReceiveControlDataSize = 256;
+    static constexpr size_t kSendControlDataSize    = 256;
 
     InterfaceId mBoundIntfId;
     uint16_t mBoundPort;
@@ -363,6 +363,142 @@ TEST_F(TestInetEndPoint, TestInetEndPointInternal)
     EXPECT_TRUE(SYSTEM_STATS_TEST_HIGH_WATER_MARK(System::Stats::kInetLayer_NumTCPEps, 1));
 }
 
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT
+namespace {
+
+struct UDPBurstState
+{
+    uint32_t mReceived = 0;
+    bool mInOrder      = true;
+};
+
+void HandleBurstMessage(UDPEndPoint * endPoint, PacketBufferHandle && buffer, const IPPacketInfo * pktInfo)
+{
+    auto * state = static_cast<UDPBurstState *>(endPoint->mAppState);
+    uint32_t sequence;
+
+    if (buffer->DataLength() != sizeof(sequence))
+    {
+        state->mInOrder = false;
+        return;
+    }
+    memcpy(&sequence, buffer->Start(), sizeof(sequence));
+    state->mInOrder = state->mInOrder && (sequence == state->mReceived);
+    state->mReceived++;
+}
+
+} // namespace
+
+// Send bursts of datagrams over loopback and check that each one is delivered, in order, through the receive callback.
+TEST_F(TestInetEndPoint, TestInetUDPBurstReceive)
+{
+    constexpr uint32_t kBurstSize = 32;
+    constexpr uint32_t kBursts    = 4;
+
+    UDPEndPoint * receiver = nullptr;
+    UDPEndPoint * sender   = nullptr;
+    UDPBurstState state;
+    IPAddress loopback;
+
+    ASSERT_TRUE(IPAddress::FromString("::1", loopback));
+    ASSERT_EQ(gUDP.NewEndPoint(&receiver), CHIP_NO_ERROR);
+    ASSERT_EQ(gUDP.NewEndPoint(&sender), CHIP_NO_ERROR);
+
+    ASSERT_EQ(receiver->Bind(IPAddressType::kIPv6, loopback, 0), CHIP_NO_ERROR);
+    ASSERT_EQ(receiver->Listen(HandleBurstMessage, nullptr, &state), CHIP_NO_ERROR);
+    ASSERT_EQ(sender->Bind(IPAddressType::kIPv6, loopback, 0), CHIP_NO_ERROR);
+
+    const uint16_t port = receiver->GetBoundPort();
+
+    for (uint32_t burst = 0; burst < kBursts; burst++)
+    {
+        for (uint32_t i = 0; i < kBurstSize; i++)
+        {
+            uint32_t sequence         = burst * kBurstSize + i;
+            PacketBufferHandle buffer = PacketBufferHandle::NewWithData(&sequence, sizeof(sequence));
+            ASSERT_FALSE(buffer.IsNull());
+            ASSERT_EQ(sender->SendTo(loopback, port, std::move(buffer)), CHIP_NO_ERROR);
+        }
+
+        for (int attempts = 0; state.mReceived < (burst + 1) * kBurstSize && attempts < 100; attempts++)
+        {
+            ServiceEvents(10);
+        }
+
+        ASSERT_EQ(state.mReceived, (burst + 1) * kBurstSize);
+    }
+    EXPECT_TRUE(state.mInOrder);
+
+    sender->Free();
+    receiver->Free();
+}
+
+// Send a batch of datagrams spanning several system calls, including messages that cannot be sent, and check the result
+// reported for each message and that the others are all delivered, in order.
+TEST_F(TestInetEndPoint, TestInetUDPSendBatch)
+{
+    // One in five messages is left out and another one is chained: this leaves more messages to send than fit in a batch.
+    constexpr size_t kMessages = INET_CONFIG_UDP_SOCKET_SEND_BATCH_SIZE + 5;
+
+    UDPEndPoint * receiver = nullptr;
+    UDPEndPoint * sender   = nullptr;
+    UDPBurstState state;
+    IPAddress loopback;
+
+    ASSERT_TRUE(IPAddress::FromString("::1", loopback));
+    ASSERT_EQ(gUDP.NewEndPoint(&receiver), CHIP_NO_ERROR);
+    ASSERT_EQ(gUDP.NewEndPoint(&sender), CHIP_NO_ERROR);
+
+    ASSERT_EQ(receiver->Bind(IPAddressType::kIPv6, loopback, 0), CHIP_NO_ERROR);
+    ASSERT_EQ(receiver->Listen(HandleBurstMessage, nullptr, &state), CHIP_NO_ERROR);
+    ASSERT_EQ(sender->Bind(IPAddressType::kIPv6, loopback, 0), CHIP_NO_ERROR);
+
+    IPPacketInfo pktInfos[kMessages];
+    PacketBufferHandle msgs[kMessages];
+    CHIP_ERROR errors[kMessages];
+    uint32_t sent = 0;
+
+    for (size_t i = 0; i < kMessages; i++)
+    {
+        pktInfos[i].Clear();
+        pktInfos[i].DestAddress = loopback;
+        pktInfos[i].DestPort    = receiver->GetBoundPort();
+        if (i % 5 == 2)
+        {
+            // Leave the message out: sending it fails.
+            continue;
+        }
+        msgs[i] = PacketBufferHandle::NewWithData(&sent, sizeof(sent));
+        ASSERT_FALSE(msgs[i].IsNull());
+        if (i % 5 == 4)
+        {
+            // A message must fit in a single buffer.
+            msgs[i]->AddToEnd(PacketBufferHandle::NewWithData(&sent, sizeof(sent)));
+            continue;
+        }
+        sent++;
+    }
+
+    EXPECT_EQ(sender->SendMsgs(pktInfos, msgs, errors, kMessages), CHIP_ERROR_INVALID_ARGUMENT);
+    for (size_t i = 0; i < kMessages; i++)
+    {
+        EXPECT_EQ(errors[i],
+                  (i % 5 == 2) ? CHIP_ERROR_INVALID_ARGUMENT : ((i % 5 == 4) ? CHIP_ERROR_MESSAGE_TOO_LONG : CHIP_NO_ERROR));
+        EXPECT_TRUE(msgs[i].IsNull());
+    }
+
+    for (int attempts = 0; state.mReceived < sent && attempts < 100; attempts++)
+    {
+        ServiceEvents(10);
+    }
+    EXPECT_EQ(state.mReceived, sent);
+    EXPECT_TRUE(state.mInOrder);
+
+    sender->Free();
+    receiver->Free();
+}
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
+
 #if !CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 // Test the Inet resource limitations.
 TEST_F(TestInetEndPoint, TestInetEndPointLimit)
@@ -240,6 +240,14 @@ public:
     /// a clear decision if the callback should or should not be invoked.
     virtual CHIP_ERROR CancelLookup(Impl::NodeLookupHandle & handle, FailureCallback cancel_method) = 0;
 
+    /// Drops any lookup result cached for the given node, so that the next
+    /// lookup of that node goes out on the network again instead of reusing
+    /// a result that is known (or suspected) to be stale, e.g. because
+    /// messages sent to the cached address went unanswered.
+    ///
+    /// Implementations that do not cache lookup results have nothing to do.
+    virtual void InvalidateCachedResults(const PeerId & peerId) {}
+
     /// Shut down any active resolves
     ///
     /// Will immediately fail any scheduled resolve calls and will refuse to register
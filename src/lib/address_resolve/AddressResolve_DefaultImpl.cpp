@@ -27,6 +27,40 @@ namespace {
 
 static constexpr System::Clock::Timeout kInvalidTimeout{ System::Clock::Timeout::max() };
 
+// TTL assumed for resolved data when the DNS-SD backend does not report record TTLs: the TTL that
+// Matter nodes advertise their SRV and AAAA records with.
+static constexpr System::Clock::Seconds32 kDefaultRecordTtl{ 120 };
+
+/// Fills in the parts of a resolve result that are common to all the addresses of a node.
+ResolveResult MakeResolveResult(const Dnssd::ResolvedNodeData & nodeData)
+{
+    ResolveResult result;
+
+    result.address.SetPort(nodeData.resolutionData.port);
+    result.address.SetInterface(nodeData.resolutionData.interfaceId);
+    result.mrpRemoteConfig = nodeData.resolutionData.GetRemoteMRPConfig();
+    result.supportsTcp     = nodeData.resolutionData.supportsTcp;
+
+    if (nodeData.resolutionData.isICDOperatingAsLIT.has_value())
+    {
+        result.isICDOperatingAsLIT = *(nodeData.resolutionData.isICDOperatingAsLIT);
+    }
+
+    return result;
+}
+
+bool IsUsableAddress(const Inet::IPAddress & address)
+{
+#if !INET_CONFIG_ENABLE_IPV4
+    if (!address.IsIPv6())
+    {
+        ChipLogError(Discovery, "Skipping IPv4 address during operational resolve.");
+        return false;
+    }
+#endif
+    return true;
+}
+
 } // namespace
 
 void NodeLookupHandle::ResetForLookup(System::Clock::Timestamp now, const NodeLookupRequest & request)
@@ -34,6 +68,16 @@ void NodeLookupHandle::ResetForLookup(System::Clock::Timestamp now, const NodeLo
     mRequestStartTime = now;
     mRequest          = request;
     mResults          = NodeLookupResults();
+    mServedFromCache  = false;
+}
+
+void NodeLookupHandle::ResetForCachedLookup(System::Clock::Timestamp now, const NodeLookupRequest & request,
+                                            const NodeLookupResults & results)
+{
+    mRequestStartTime = now;
+    mRequest          = request;
+    mResults          = results;
+    mServedFromCache  = true;
 }
 
 void NodeLookupHandle::LookupResult(const ResolveResult & result)
@@ -62,6 +106,12 @@ System::Clock::Timeout NodeLookupHandle::NextEventTimeout(System::Clock::Timesta
 {
     const System::Clock::Timestamp elapsed = now - mRequestStartTime;
 
+    if (mServedFromCache && HasLookupResult())
+    {
+        // Cached results are already known to be good: no need to wait for more.
+        return System::Clock::Timeout::zero();
+    }
+
     if (elapsed < mRequest.GetMinLookupTime())
     {
         return mRequest.GetMinLookupTime() - elapsed;
@@ -100,6 +150,12 @@ NodeLookupAction NodeLookupHandle::NextAction(System::Clock::Timestamp now)
     ChipLogProgress(Discovery, "Checking node lookup status for " ChipLogFormatPeerId " after %lu ms",
                     ChipLogValuePeerId(mRequest.GetPeerId()), static_cast<unsigned long>(elapsed.count()));
 
+    if (mServedFromCache && HasLookupResult())
+    {
+        auto result = TakeLookupResult();
+        return NodeLookupAction::Success(result);
+    }
+
     // We are still within the minimal search time. Wait for more results.
     if (elapsed < mRequest.GetMinLookupTime())
     {
@@ -180,14 +236,148 @@ bool NodeLookupResults::UpdateResults(const ResolveResult & result, const Dnssd:
     return true;
 }
 
+NodeLookupCache::Entry * NodeLookupCache::Find(const PeerId & peerId)
+{
+    for (auto & entry : mEntries)
+    {
+        if (entry.lastUse != 0 && entry.peerId == peerId)
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+CHIP_ERROR NodeLookupCache::Lookup(const PeerId & peerId, System::Clock::Timestamp now, NodeLookupResults & results,
+                                   bool & needsRefresh)
+{
+    Entry * entry = Find(peerId);
+
+    if (entry != nullptr && now >= entry->expiryTime)
+    {
+        *entry = Entry();
+        entry  = nullptr;
+    }
+
+    if (entry == nullptr)
+    {
+        mStats.misses++;
+        return CHIP_ERROR_NOT_FOUND;
+    }
+
+    mStats.hits++;
+    entry->lastUse = ++mUseCounter;
+
+    results          = entry->results;
+    results.consumed = 0;
+
+    needsRefresh = !entry->refreshing && (now >= entry->refreshTime);
+    if (needsRefresh)
+    {
+        entry->refreshing = true;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+bool NodeLookupCache::Update(const PeerId & peerId, const NodeLookupResults & results, System::Clock::Timestamp now,
+                             System::Clock::Seconds32 ttl)
+{
+    Entry * entry = Find(peerId);
+
+    if (results.count == 0)
+    {
+        // Nothing usable to keep: do not serve older results either.
+        const bool wasRefreshing = (entry != nullptr) && entry->refreshing;
+        Invalidate(peerId);
+        return wasRefreshing;
+    }
+
+    if (entry == nullptr)
+    {
+        // Take an unused entry if any, or else evict the least recently used one.
+        for (auto & candidate : mEntries)
+        {
+            if (entry == nullptr || candidate.lastUse < entry->lastUse)
+            {
+                entry = &candidate;
+            }
+        }
+        VerifyOrReturnValue(entry != nullptr, false);
+        *entry = Entry();
+    }
+
+    const bool wasRefreshing = entry->refreshing;
+
+    entry->peerId      = peerId;
+    entry->results     = results;
+    entry->refreshTime = now + System::Clock::Timestamp(ttl) / 2;
+    entry->expiryTime  = now + System::Clock::Timestamp(ttl);
+    entry->lastUse     = ++mUseCounter;
+    entry->refreshing  = false;
+
+    return wasRefreshing;
+}
+
+void NodeLookupCache::RefreshFailed(const PeerId & peerId)
+{
+    Entry * entry = Find(peerId);
+    if (entry != nullptr)
+    {
+        entry->refreshing = false;
+    }
+}
+
+void NodeLookupCache::Invalidate(const PeerId & peerId)
+{
+    Entry * entry = Find(peerId);
+    if (entry != nullptr)
+    {
+        *entry = Entry();
+    }
+}
+
+void NodeLookupCache::Clear()
+{
+    for (auto & entry : mEntries)
+    {
+        entry = Entry();
+    }
+}
+
 CHIP_ERROR Resolver::LookupNode(const NodeLookupRequest & request, Impl::NodeLookupHandle & handle)
 {
     MATTER_LOG_NODE_LOOKUP(&request);
 
     VerifyOrReturnError(mSystemLayer != nullptr, CHIP_ERROR_INCORRECT_STATE);
 
-    handle.ResetForLookup(mTimeSource.GetMonotonicTimestamp(), request);
-    auto & peerId = request.GetPeerId();
+    const System::Clock::Timestamp now = mTimeSource.GetMonotonicTimestamp();
+    auto & peerId                      = request.GetPeerId();
+
+    NodeLookupResults cachedResults;
+    bool needsRefresh = false;
+    if (mCache.Lookup(peerId, now, cachedResults, needsRefresh) == CHIP_NO_ERROR)
+    {
+        if (needsRefresh)
+        {
+            // The cached results are still served right away, while a fresh
+            // resolve updates the cache in the background.
+            CHIP_ERROR err = Dnssd::Resolver::Instance().ResolveNodeId(peerId);
+            if (err != CHIP_NO_ERROR)
+            {
+                ChipLogError(Discovery, "Failed to refresh cached lookup results: %" CHIP_ERROR_FORMAT, err.Format());
+                mCache.RefreshFailed(peerId);
+            }
+        }
+
+        handle.ResetForCachedLookup(now, request, cachedResults);
+        mActiveLookups.PushBack(&handle);
+        ReArmTimer();
+        ChipLogProgress(Discovery, "Lookup served from cache for " ChipLogFormatPeerId, ChipLogValuePeerId(peerId));
+        return CHIP_NO_ERROR;
+    }
+
+    handle.ResetForLookup(now, request);
     ReturnErrorOnFailure(Dnssd::Resolver::Instance().ResolveNodeId(peerId));
     mActiveLookups.PushBack(&handle);
     ReArmTimer();
@@ -214,7 +404,10 @@ CHIP_ERROR Resolver::CancelLookup(Impl::NodeLookupHandle & handle, FailureCallba
 {
     VerifyOrReturnError(handle.IsActive(), CHIP_ERROR_INVALID_ARGUMENT);
     mActiveLookups.Remove(&handle);
-    Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(handle.GetRequest().GetPeerId());
+    if (!handle.IsServedFromCache())
+    {
+        Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(handle.GetRequest().GetPeerId());
+    }
 
     // Adjust any timing updates.
     ReArmTimer();
@@ -236,6 +429,11 @@ CHIP_ERROR Resolver::CancelLookup(Impl::NodeLookupHandle & handle, FailureCallba
     return CHIP_NO_ERROR;
 }
 
+void Resolver::InvalidateCachedResults(const PeerId & peerId)
+{
+    mCache.Invalidate(peerId);
+}
+
 CHIP_ERROR Resolver::Init(System::Layer * systemLayer)
 {
     mSystemLayer = systemLayer;
@@ -267,12 +465,15 @@ void Resolver::Shutdown()
     // internal list of active lookups is empty at this point.
     ReArmTimer();
 
+    mCache.Clear();
     mSystemLayer = nullptr;
     Dnssd::Resolver::Instance().SetOperationalDelegate(nullptr);
 }
 
 void Resolver::OnOperationalNodeResolved(const Dnssd::ResolvedNodeData & nodeData)
 {
+    UpdateCache(nodeData);
+
     auto it = mActiveLookups.begin();
     while (it != mActiveLookups.end())
     {
@@ -283,27 +484,14 @@ void Resolver::OnOperationalNodeResolved(const Dnssd::ResolvedNodeData & nodeDat
             continue;
         }
 
-        ResolveResult result;
-
-        result.address.SetPort(nodeData.resolutionData.port);
-        result.address.SetInterface(nodeData.resolutionData.interfaceId);
-        result.mrpRemoteConfig = nodeData.resolutionData.GetRemoteMRPConfig();
-        result.supportsTcp     = nodeData.resolutionData.supportsTcp;
-
-        if (nodeData.resolutionData.isICDOperatingAsLIT.has_value())
-        {
-            result.isICDOperatingAsLIT = *(nodeData.resolutionData.isICDOperatingAsLIT);
-        }
+        ResolveResult result = MakeResolveResult(nodeData);
 
         for (size_t i = 0; i < nodeData.resolutionData.numIPs; i++)
         {
-#if !INET_CONFIG_ENABLE_IPV4
-            if (!nodeData.resolutionData.ipAddress[i].IsIPv6())
+            if (!IsUsableAddress(nodeData.resolutionData.ipAddress[i]))
             {
-                ChipLogError(Discovery, "Skipping IPv4 address during operational resolve.");
                 continue;
             }
-#endif
             result.address.SetIPAddress(nodeData.resolutionData.ipAddress[i]);
             current->LookupResult(result);
         }
@@ -314,6 +502,51 @@ void Resolver::OnOperationalNodeResolved(const Dnssd::ResolvedNodeData & nodeDat
     ReArmTimer();
 }
 
+void Resolver::UpdateCache(const Dnssd::ResolvedNodeData & nodeData)
+{
+    const PeerId & peerId = nodeData.operationalData.peerId;
+
+    if (nodeData.operationalData.hasZeroTTL)
+    {
+        // The node withdrew its records.
+        mCache.Invalidate(peerId);
+        return;
+    }
+
+    NodeLookupResults results;
+    ResolveResult result = MakeResolveResult(nodeData);
+
+    for (size_t i = 0; i < nodeData.resolutionData.numIPs; i++)
+    {
+        const Inet::IPAddress & address = nodeData.resolutionData.ipAddress[i];
+        if (!IsUsableAddress(address))
+        {
+            continue;
+        }
+        result.address.SetIPAddress(address);
+        results.UpdateResults(result, Dnssd::IPAddressSorter::ScoreIpAddress(address, result.address.GetInterface()));
+    }
+
+    const System::Clock::Seconds32 ttl = nodeData.operationalData.ttl.value_or(kDefaultRecordTtl);
+    if (mCache.Update(peerId, results, mTimeSource.GetMonotonicTimestamp(), ttl) && !IsResolving(peerId))
+    {
+        // This completes a background refresh that no lookup is waiting for.
+        Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(peerId);
+    }
+}
+
+bool Resolver::IsResolving(const PeerId & peerId)
+{
+    for (auto & activeLookup : mActiveLookups)
+    {
+        if (!activeLookup.IsServedFromCache() && activeLookup.GetRequest().GetPeerId() == peerId)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 void Resolver::HandleAction(IntrusiveList<NodeLookupHandle>::Iterator & current)
 {
     const NodeLookupAction action = current->NextAction(mTimeSource.GetMonotonicTimestamp());
@@ -325,11 +558,17 @@ void Resolver::HandleAction(IntrusiveList<NodeLookupHandle>::Iterator & current)
     }
 
     // final result, handle either success or failure
-    const PeerId peerId     = current->GetRequest().GetPeerId();
-    NodeListener * listener = current->GetListener();
+    const PeerId peerId        = current->GetRequest().GetPeerId();
+    NodeListener * listener    = current->GetListener();
+    const bool servedFromCache = current->IsServedFromCache();
     mActiveLookups.Erase(current);
 
-    Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(peerId);
+    if (!servedFromCache)
+    {
+        // Cached results did not start a resolve of their own. Leave alone
+        // any background refresh of them.
+        Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(peerId);
+    }
 
     // ensure action is taken AFTER the current current lookup is marked complete
     // This allows failure handlers to deallocate structures that may
@@ -366,6 +605,9 @@ void Resolver::HandleTimer()
 
 void Resolver::OnOperationalNodeResolutionFailed(const PeerId & peerId, CHIP_ERROR error)
 {
+    // Whatever was cached for the node could not be confirmed.
+    mCache.Invalidate(peerId);
+
     auto it = mActiveLookups.begin();
     while (it != mActiveLookups.end())
     {
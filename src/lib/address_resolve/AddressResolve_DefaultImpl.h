@@ -22,11 +22,14 @@
 #include <system/TimeSource.h>
 #include <transport/raw/PeerAddress.h>
 
+#include <array>
+
 namespace chip {
 namespace AddressResolve {
 namespace Impl {
 
 inline constexpr uint8_t kNodeLookupResultsLen = CHIP_CONFIG_MDNS_RESOLVE_LOOKUP_RESULTS;
+inline constexpr size_t kNodeLookupCacheSize   = CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE;
 
 enum class NodeLookupResult
 {
@@ -133,6 +136,14 @@ public:
     /// Resets internal state (i.e. best address so far)
     void ResetForLookup(System::Clock::Timestamp now, const NodeLookupRequest & request);
 
+    /// Sets up a request for a new lookup that is served from previously
+    /// cached results: the results are reported as soon as possible,
+    /// regardless of the min lookup time of the request.
+    void ResetForCachedLookup(System::Clock::Timestamp now, const NodeLookupRequest & request, const NodeLookupResults & results);
+
+    /// Was the current lookup served from cached results?
+    bool IsServedFromCache() const { return mServedFromCache; }
+
     /// Mark that a specific IP address has been found
     void LookupResult(const ResolveResult & result);
 
@@ -161,6 +172,67 @@ private:
     NodeLookupResults mResults;
     NodeLookupRequest mRequest; // active request to process
     System::Clock::Timestamp mRequestStartTime;
+    bool mServedFromCache = false;
+};
+
+/// A bounded cache of the results of operational node lookups, so that
+/// nodes that were resolved recently do not need to be looked up on the
+/// network again.
+///
+/// Entries expire once the TTL of the DNS-SD records they were resolved from
+/// has elapsed, and become due for a refresh after half of it. When the cache
+/// is full, the least recently used entry is evicted.
+class NodeLookupCache
+{
+public:
+    struct Stats
+    {
+        uint32_t hits   = 0; // lookups served from the cache
+        uint32_t misses = 0; // lookups that had to go out on the network
+    };
+
+    /// Looks up the unexpired cached results for a node and counts the
+    /// outcome as a hit or a miss.
+    ///
+    /// `needsRefresh` is set if the results are past half of their TTL and
+    /// no refresh was requested for them yet: the caller is then expected to
+    /// refresh them in the background and report back through Update.
+    ///
+    /// Returns CHIP_ERROR_NOT_FOUND on a miss.
+    CHIP_ERROR Lookup(const PeerId & peerId, System::Clock::Timestamp now, NodeLookupResults & results, bool & needsRefresh);
+
+    /// Stores the latest results for a node, replacing any results cached
+    /// for it.
+    ///
+    /// Returns true if a background refresh of the node was pending.
+    bool Update(const PeerId & peerId, const NodeLookupResults & results, System::Clock::Timestamp now,
+                System::Clock::Seconds32 ttl);
+
+    /// Lets the next lookup of a node ask for a refresh again, after the
+    /// background refresh that was requested for it could not be started.
+    void RefreshFailed(const PeerId & peerId);
+
+    void Invalidate(const PeerId & peerId);
+    void Clear();
+
+    const Stats & GetStats() const { return mStats; }
+
+private:
+    struct Entry
+    {
+        PeerId peerId;
+        NodeLookupResults results;
+        System::Clock::Timestamp refreshTime; // results are due for a refresh after this
+        System::Clock::Timestamp expiryTime;  // results are not used anymore after this
+        uint32_t lastUse = 0;                 // 0 for unused entries
+        bool refreshing  = false;
+    };
+
+    Entry * Find(const PeerId & peerId);
+
+    std::array<Entry, kNodeLookupCacheSize> mEntries;
+    uint32_t mUseCounter = 0;
+    Stats mStats;
 };
 
 class Resolver : public ::chip::AddressResolve::Resolver, public Dnssd::OperationalResolveDelegate
@@ -174,8 +246,12 @@ public:
     CHIP_ERROR LookupNode(const NodeLookupRequest & request, Impl::NodeLookupHandle & handle) override;
     CHIP_ERROR TryNextResult(Impl::NodeLookupHandle & handle) override;
     CHIP_ERROR CancelLookup(Impl::NodeLookupHandle & handle, FailureCallback cancel_method) override;
+    void InvalidateCachedResults(const PeerId & peerId) override;
     void Shutdown() override;
 
+    /// Hit and miss counters of the lookup results cache.
+    const NodeLookupCache::Stats & GetCacheStats() const { return mCache.GetStats(); }
+
     // Dnssd::OperationalResolveDelegate
 
     void OnOperationalNodeResolved(const Dnssd::ResolvedNodeData & nodeData) override;
@@ -200,9 +276,16 @@ private:
     /// be used after calling this method.
     void HandleAction(IntrusiveList<NodeLookupHandle>::Iterator & current);
 
+    /// Stores resolved node data in the lookup results cache.
+    void UpdateCache(const Dnssd::ResolvedNodeData & nodeData);
+
+    /// Is any lookup still waiting for DNS-SD resolution of the given peer?
+    bool IsResolving(const PeerId & peerId);
+
     System::Layer * mSystemLayer = nullptr;
     Time::TimeSource<Time::Source::kSystem> mTimeSource;
     IntrusiveList<NodeLookupHandle> mActiveLookups;
+    NodeLookupCache mCache;
 };
 
 } // namespace Impl
@@ -26,6 +26,7 @@ using chip::Dnssd::IPAddressSorter::IpScore;
 using chip::Dnssd::IPAddressSorter::ScoreIpAddress;
 
 constexpr uint8_t kNumberOfAvailableSlots = CHIP_CONFIG_MDNS_RESOLVE_LOOKUP_RESULTS;
+constexpr size_t kCacheSize               = CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE;
 
 Transport::PeerAddress GetAddressWithLowScore(uint16_t port = CHIP_PORT, Inet::InterfaceId interfaceId = Inet::InterfaceId::Null())
 {
@@ -197,4 +198,124 @@ TEST(TestAddressResolveDefaultImpl, TestLookupResult)
     // Check that the results has been consumed properly.
     EXPECT_FALSE(handle.HasLookupResult());
 }
+
+Impl::NodeLookupResults MakeResults(const Transport::PeerAddress & address)
+{
+    ResolveResult result;
+    result.address = address;
+
+    Impl::NodeLookupResults results;
+    results.UpdateResults(result, ScoreIpAddress(address.GetIPAddress(), address.GetInterface()));
+    return results;
+}
+
+TEST(TestAddressResolveDefaultImpl, TestCachedLookupResult)
+{
+    AddressResolve::NodeLookupHandle handle;
+
+    auto now     = System::SystemClock().GetMonotonicTimestamp();
+    auto request = NodeLookupRequest(chip::PeerId(1, 2));
+    request.SetMinLookupTime(System::Clock::Milliseconds32(200));
+
+    // Cached results are reported right away, without waiting for the min lookup time.
+    handle.ResetForCachedLookup(now, request, MakeResults(GetAddressWithMediumScore()));
+    EXPECT_TRUE(handle.IsServedFromCache());
+    EXPECT_EQ(handle.NextEventTimeout(now), System::Clock::Timeout::zero());
+
+    Impl::NodeLookupAction action = handle.NextAction(now);
+    EXPECT_EQ(action.Type(), Impl::NodeLookupResult::kLookupSuccess);
+    EXPECT_EQ(action.ResolveResult().address, GetAddressWithMediumScore());
+
+    // Network lookups keep waiting for the min lookup time.
+    handle.ResetForLookup(now, request);
+    EXPECT_FALSE(handle.IsServedFromCache());
+    handle.LookupResult(ResolveResult());
+    EXPECT_EQ(handle.NextAction(now).Type(), Impl::NodeLookupResult::kKeepSearching);
+}
+
+TEST(TestAddressResolveDefaultImpl, TestLookupCache)
+{
+    if (kCacheSize == 0)
+    {
+        return;
+    }
+
+    using namespace System::Clock::Literals;
+
+    Impl::NodeLookupCache cache;
+    Impl::NodeLookupResults results;
+    bool needsRefresh = false;
+
+    const PeerId peer(1, 2);
+    const System::Clock::Timestamp start = 1000_ms64;
+    const System::Clock::Seconds32 ttl(120);
+
+    EXPECT_EQ(cache.Lookup(peer, start, results, needsRefresh), CHIP_ERROR_NOT_FOUND);
+    EXPECT_EQ(cache.GetStats().misses, 1u);
+
+    EXPECT_FALSE(cache.Update(peer, MakeResults(GetAddressWithHighScore()), start, ttl));
+
+    EXPECT_EQ(cache.Lookup(peer, start + 1_ms64, results, needsRefresh), CHIP_NO_ERROR);
+    EXPECT_EQ(cache.GetStats().hits, 1u);
+    EXPECT_FALSE(needsRefresh);
+    ASSERT_TRUE(results.HasValidResult());
+    EXPECT_EQ(results.ConsumeResult().address.GetIPAddress(), GetAddressWithHighScore().GetIPAddress());
+
+    // Past half of the TTL, the results are still served but need a refresh, which is only asked for once.
+    EXPECT_EQ(cache.Lookup(peer, start + 61_s, results, needsRefresh), CHIP_NO_ERROR);
+    EXPECT_TRUE(needsRefresh);
+    EXPECT_EQ(cache.Lookup(peer, start + 62_s, results, needsRefresh), CHIP_NO_ERROR);
+    EXPECT_FALSE(needsRefresh);
+
+    // A refresh that could not be started is asked for again.
+    cache.RefreshFailed(peer);
+    EXPECT_EQ(cache.Lookup(peer, start + 62_s, results, needsRefresh), CHIP_NO_ERROR);
+    EXPECT_TRUE(needsRefresh);
+
+    // The refresh restarts the TTL.
+    EXPECT_TRUE(cache.Update(peer, MakeResults(GetAddressWithMediumScore()), start + 63_s, ttl));
+    EXPECT_EQ(cache.Lookup(peer, start + 100_s, results, needsRefresh), CHIP_NO_ERROR);
+    EXPECT_FALSE(needsRefresh);
+    EXPECT_EQ(results.ConsumeResult().address.GetIPAddress(), GetAddressWithMediumScore().GetIPAddress());
+
+    // Expired results are not used.
+    EXPECT_EQ(cache.Lookup(peer, start + 183_s, results, needsRefresh), CHIP_ERROR_NOT_FOUND);
+
+    // Invalidated results are not used either.
+    cache.Update(peer, MakeResults(GetAddressWithHighScore()), start, ttl);
+    cache.Invalidate(peer);
+    EXPECT_EQ(cache.Lookup(peer, start, results, needsRefresh), CHIP_ERROR_NOT_FOUND);
+
+    EXPECT_EQ(cache.GetStats().hits, 5u);
+    EXPECT_EQ(cache.GetStats().misses, 3u);
+}
+
+TEST(TestAddressResolveDefaultImpl, TestLookupCacheEviction)
+{
+    if (kCacheSize < 2)
+    {
+        return;
+    }
+
+    Impl::NodeLookupCache cache;
+    Impl::NodeLookupResults results;
+    bool needsRefresh = false;
+
+    const System::Clock::Timestamp now = System::Clock::kZero;
+    const System::Clock::Seconds32 ttl(120);
+
+    for (NodeId node = 1; node <= kCacheSize; node++)
+    {
+        cache.Update(PeerId(1, node), MakeResults(GetAddressWithHighScore()), now, ttl);
+    }
+
+    // Using the first node makes the second one the least recently used.
+    EXPECT_EQ(cache.Lookup(PeerId(1, 1), now, results, needsRefresh), CHIP_NO_ERROR);
+
+    cache.Update(PeerId(1, kCacheSize + 1), MakeResults(GetAddressWithHighScore()), now, ttl);
+
+    EXPECT_EQ(cache.Lookup(PeerId(1, 1), now, results, needsRefresh), CHIP_NO_ERROR);
+    EXPECT_EQ(cache.Lookup(PeerId(1, kCacheSize + 1), now, results, needsRefresh), CHIP_NO_ERROR);
+    EXPECT_EQ(cache.Lookup(PeerId(1, 2), now, results, needsRefresh), CHIP_ERROR_NOT_FOUND);
+}
 } // namespace
@@ -854,6 +854,7 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
  *      * #CHIP_IM_MAX_REPORTS_IN_FLIGHT
  *      * #CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS
  *      * #CHIP_IM_SERVER_MAX_NUM_DIRTY_SET
+ *      * #CHIP_IM_SERVER_INTEREST_INDEX_BUCKET_COUNT
  *      * #CHIP_IM_MAX_NUM_WRITE_HANDLER
  *      * #CHIP_IM_MAX_NUM_WRITE_CLIENT
  *      * #CHIP_IM_MAX_NUM_TIMED_HANDLER
@@ -931,6 +932,16 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_IM_SERVER_MAX_NUM_DIRTY_SET 8
 #endif
 
+/**
+ * @def CHIP_IM_SERVER_INTEREST_INDEX_BUCKET_COUNT
+ *
+ * @brief Defines the number of (endpoint, cluster) hash buckets used by the reporting engine to find the read handlers
+ *        interested in a dirty attribute path. Must be a power of two.
+ */
+#ifndef CHIP_IM_SERVER_INTEREST_INDEX_BUCKET_COUNT
+#define CHIP_IM_SERVER_INTEREST_INDEX_BUCKET_COUNT 16
+#endif
+
 /**
  * @def CHIP_IM_MAX_NUM_WRITE_HANDLER
  *
@@ -1032,6 +1043,26 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_CASE_CLIENTS 16
 #endif
 
+/**
+ * @def CHIP_CONFIG_CONTROLLER_SUBSCRIPTION_SCHEDULER_MAX_SESSION_SETUPS
+ *
+ * @brief Default number of CASE sessions the controller SubscriptionScheduler sets up concurrently.
+ *        Matches the CASE client pool so that the scheduler does not run it out of clients on its own.
+ */
+#ifndef CHIP_CONFIG_CONTROLLER_SUBSCRIPTION_SCHEDULER_MAX_SESSION_SETUPS
+#define CHIP_CONFIG_CONTROLLER_SUBSCRIPTION_SCHEDULER_MAX_SESSION_SETUPS CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_CASE_CLIENTS
+#endif
+
+/**
+ * @def CHIP_CONFIG_CONTROLLER_SUBSCRIPTION_SCHEDULER_MAX_SUBSCRIBE_REQUESTS
+ *
+ * @brief Default number of Subscribe Requests the controller SubscriptionScheduler keeps outstanding concurrently.
+ *        Leaves half of the exchange contexts to the rest of the controller.
+ */
+#ifndef CHIP_CONFIG_CONTROLLER_SUBSCRIPTION_SCHEDULER_MAX_SUBSCRIBE_REQUESTS
+#define CHIP_CONFIG_CONTROLLER_SUBSCRIPTION_SCHEDULER_MAX_SUBSCRIBE_REQUESTS (CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS / 2)
+#endif
+
 /**
  * @def CHIP_CONFIG_DEVICE_MAX_ACTIVE_CASE_CLIENTS
  *
@@ -1107,6 +1138,34 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_GROUP_CONCURRENT_ITERATORS 2
 #endif
 
+/**
+ * @def CHIP_CONFIG_GROUP_SESSION_CACHE_MAX_KEYSETS
+ *
+ * @brief Defines the number of key sets kept in RAM for the decryption of group messages
+ *
+ * The group data provider keeps the key sets mapped to groups, along with the
+ * keyset-group mappings, in RAM so that received group messages are matched to
+ * their keys without reading the persistent storage. When the mapped key sets or
+ * the mappings (see CHIP_CONFIG_GROUP_SESSION_CACHE_MAX_MAPPINGS) do not fit,
+ * the group sessions are looked up in the persistent storage instead.
+ *
+ * Set to 0 to disable the cache.
+ */
+#ifndef CHIP_CONFIG_GROUP_SESSION_CACHE_MAX_KEYSETS
+#define CHIP_CONFIG_GROUP_SESSION_CACHE_MAX_KEYSETS 4
+#endif
+
+/**
+ * @def CHIP_CONFIG_GROUP_SESSION_CACHE_MAX_MAPPINGS
+ *
+ * @brief Defines the number of keyset-group mappings kept in RAM for the decryption of group messages
+ *
+ * See CHIP_CONFIG_GROUP_SESSION_CACHE_MAX_KEYSETS.
+ */
+#ifndef CHIP_CONFIG_GROUP_SESSION_CACHE_MAX_MAPPINGS
+#define CHIP_CONFIG_GROUP_SESSION_CACHE_MAX_MAPPINGS 16
+#endif
+
 /**
  * @def CHIP_CONFIG_MAX_GROUP_NAME_LENGTH
  *
@@ -1201,6 +1260,57 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_FLEXIBLE_COPY_SUPPORT 0
 #endif
 
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_COMPILED_ENTRIES
+ *
+ * Number of access control entries kept decoded in RAM by access control checks.
+ *
+ * Checks use a decoded copy of the access control list instead of iterating the
+ * entries through the access control delegate. When the entries, their subjects
+ * (see CHIP_CONFIG_ACCESS_CONTROL_COMPILED_SUBJECTS) or their targets (see
+ * CHIP_CONFIG_ACCESS_CONTROL_COMPILED_TARGETS) do not fit, checks iterate the
+ * entries instead.
+ *
+ * Set to 0 to always iterate the entries.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_COMPILED_ENTRIES
+#define CHIP_CONFIG_ACCESS_CONTROL_COMPILED_ENTRIES 16
+#endif
+
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_COMPILED_SUBJECTS
+ *
+ * Number of subjects, over all entries, kept decoded in RAM by access control checks.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_COMPILED_SUBJECTS
+#define CHIP_CONFIG_ACCESS_CONTROL_COMPILED_SUBJECTS 16
+#endif
+
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_COMPILED_TARGETS
+ *
+ * Number of targets, over all entries, kept decoded in RAM by access control checks.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_COMPILED_TARGETS
+#define CHIP_CONFIG_ACCESS_CONTROL_COMPILED_TARGETS 48
+#endif
+
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE
+ *
+ * Number of recent access control decisions remembered, by subject descriptor,
+ * request path and privilege, when checking against decoded entries (see
+ * CHIP_CONFIG_ACCESS_CONTROL_COMPILED_ENTRIES).
+ *
+ * Decisions are forgotten when the access control list changes. Decisions which
+ * depend on device type targets are not remembered.
+ *
+ * Set to 0 to disable the cache.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE
+#define CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE 8
+#endif
+
 #if !CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_FAST_COPY_SUPPORT && !CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_FLEXIBLE_COPY_SUPPORT
 #error                                                                                                                             \
     "Please enable at least one of CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_FAST_COPY_SUPPORT or CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_FLEXIBLE_COPY_SUPPORT"
@@ -1216,6 +1326,40 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE (3 * CHIP_CONFIG_MAX_FABRICS)
 #endif
 
+/**
+ * @def CHIP_CONFIG_CRYPTO_WORKER_MAX
+ *
+ * @brief
+ *   Maximum number of worker threads of a ThreadPoolCryptoWorkQueue, which runs the heavy steps of CASE and
+ *   PASE session establishment off the CHIP event loop.
+ */
+#ifndef CHIP_CONFIG_CRYPTO_WORKER_MAX
+#define CHIP_CONFIG_CRYPTO_WORKER_MAX 8
+#endif // CHIP_CONFIG_CRYPTO_WORKER_MAX
+
+/**
+ * @def CHIP_CONFIG_CRYPTO_WORK_QUEUE_SIZE
+ *
+ * @brief
+ *   Maximum number of session establishment steps waiting for a worker of a ThreadPoolCryptoWorkQueue.  Scheduling
+ *   more fails with CHIP_ERROR_NO_MEMORY.
+ */
+#ifndef CHIP_CONFIG_CRYPTO_WORK_QUEUE_SIZE
+#define CHIP_CONFIG_CRYPTO_WORK_QUEUE_SIZE 16
+#endif // CHIP_CONFIG_CRYPTO_WORK_QUEUE_SIZE
+
+/**
+ * @def CHIP_CONFIG_SESSION_CIPHER_CONTEXT_CACHE
+ *
+ * @brief
+ *   Enable (1) or disable (0) keeping, for each secure session, AES-CCM cipher contexts bound to its encryption
+ *   and decryption keys, so that every message does not set up a cipher context and expand the key again.  This
+ *   costs two Crypto::Aes128CcmContext per session, plus the cipher state the crypto backend allocates on first use.
+ */
+#ifndef CHIP_CONFIG_SESSION_CIPHER_CONTEXT_CACHE
+#define CHIP_CONFIG_SESSION_CIPHER_CONTEXT_CACHE 0
+#endif // CHIP_CONFIG_SESSION_CIPHER_CONTEXT_CACHE
+
 /**
  * @def CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD
  *
@@ -1332,6 +1476,21 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_ATTRIBUTE_STORE_ELEMENT_SIZE 1003
 #endif // CHIP_CONFIG_MAX_ATTRIBUTE_STORE_ELEMENT_SIZE
 
+/*
+ * @def CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX
+ *
+ * @brief Enables a hash index over the endpoint, cluster and attribute
+ * metadata of the attribute storage, so that looking up an endpoint, server
+ * cluster or attribute does not scan every endpoint, cluster and attribute.
+ * The index is allocated from the heap the first time it is needed and rebuilt
+ * after dynamic endpoints change.  Its size grows with the number of endpoints
+ * and with the number of clusters and attributes of the distinct endpoint
+ * types, so it is mostly worth it on devices with many (dynamic) endpoints.
+ */
+#ifndef CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX
+#define CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX 0
+#endif // CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX
+
 /*
  * @def CHIP_CONFIG_MINMDNS_DYNAMIC_OPERATIONAL_RESPONDER_LIST
  *
@@ -1359,6 +1518,36 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES 2
 #endif // CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES
 
+/*
+ * @def CHIP_CONFIG_MINMDNS_MAX_KNOWN_ANSWERS
+ *
+ * @brief Determines the maximum number of known answers (RFC 6762 section 7.1)
+ *        that minmdns tracks:
+ *          - when replying, the number of known answers of a received query
+ *            packet that are used to suppress replies
+ *          - when querying, the number of received PTR records that are
+ *            remembered and listed as known answers of browse queries
+ *
+ *        Setting this to 0 disables known-answer suppression.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_MAX_KNOWN_ANSWERS
+#define CHIP_CONFIG_MINMDNS_MAX_KNOWN_ANSWERS 8
+#endif // CHIP_CONFIG_MINMDNS_MAX_KNOWN_ANSWERS
+
+/*
+ * @def CHIP_CONFIG_MINMDNS_MULTICAST_THROTTLE_INTERFACES
+ *
+ * @brief Determines the number of interface/address type pairs for which
+ *        minmdns tracks when every record was last multicast.
+ *
+ *        Multicast replies are rate limited to once a second per record
+ *        (RFC 6762 section 6) on each interface and address type independently.
+ *        When more pairs are in use, the least recently used one is forgotten.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_MULTICAST_THROTTLE_INTERFACES
+#define CHIP_CONFIG_MINMDNS_MULTICAST_THROTTLE_INTERFACES 2
+#endif // CHIP_CONFIG_MINMDNS_MULTICAST_THROTTLE_INTERFACES
+
 /**
  * def CHIP_CONFIG_MDNS_RESOLVE_LOOKUP_RESULTS
  *
@@ -1370,6 +1559,20 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MDNS_RESOLVE_LOOKUP_RESULTS 1
 #endif // CHIP_CONFIG_MDNS_RESOLVE_LOOKUP_RESULTS
 
+/**
+ * @def CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE
+ *
+ * @brief Maximum number of nodes whose operational address resolve results are cached
+ *        by the default address resolver, so that they can be reused (within the TTL of
+ *        the DNS-SD records they come from) instead of looking the node up again.
+ *
+ *        The least recently used node is evicted when the cache is full. Setting this
+ *        to 0 disables the cache.
+ */
+#ifndef CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE
+#define CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE 8
+#endif // CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE
+
 /*
  * @def CHIP_CONFIG_NETWORK_COMMISSIONING_DEBUG_TEXT_BUFFER_SIZE
  *
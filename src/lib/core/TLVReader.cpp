@@ -20,6 +20,9 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <array>
+#include <utility>
+
 #include <lib/core/CHIPConfig.h>
 #include <lib/core/CHIPEncoding.h>
 #include <lib/core/CHIPError.h>
@@ -47,7 +50,88 @@ namespace TLV {
 
 using namespace chip::Encoding;
 
-static const uint8_t sTagSizes[] = { 0, 1, 2, 4, 2, 4, 6, 8 };
+static constexpr uint8_t sTagSizes[] = { 0, 1, 2, 4, 2, 4, 6, 8 };
+
+namespace {
+
+/*
+ * What a control byte tells about the element it starts, used to skip over elements without
+ * decoding them.
+ */
+struct ControlByteInfo
+{
+    uint8_t headLength;  // Control byte, tag and length/value bytes; 0 if the control byte is invalid.
+    uint8_t lengthBytes; // Size of the length field of strings, 0 for other elements.
+    int8_t nesting;      // 1 for the start of a container, -1 for an end of container, 0 otherwise.
+};
+
+constexpr ControlByteInfo MakeControlByteInfo(uint8_t controlByte)
+{
+    const uint8_t type    = controlByte & kTLVTypeMask;
+    const uint8_t tagSize = sTagSizes[controlByte >> kTLVTagControlShift];
+
+    if (type > static_cast<uint8_t>(TLVElementType::EndOfContainer))
+    {
+        return ControlByteInfo{ 0, 0, 0 };
+    }
+
+    if (type >= static_cast<uint8_t>(TLVElementType::Structure) && type <= static_cast<uint8_t>(TLVElementType::List))
+    {
+        return ControlByteInfo{ static_cast<uint8_t>(1 + tagSize), 0, 1 };
+    }
+
+    if (type == static_cast<uint8_t>(TLVElementType::EndOfContainer))
+    {
+        return ControlByteInfo{ static_cast<uint8_t>(1 + tagSize), 0, -1 };
+    }
+
+    const bool hasValue   = (type <= static_cast<uint8_t>(TLVElementType::UInt64)) ||
+        (type >= static_cast<uint8_t>(TLVElementType::FloatingPointNumber32) &&
+         type <= static_cast<uint8_t>(TLVElementType::ByteString_8ByteLength));
+    const bool hasLength  = type >= static_cast<uint8_t>(TLVElementType::UTF8String_1ByteLength) &&
+        type <= static_cast<uint8_t>(TLVElementType::ByteString_8ByteLength);
+    const uint8_t valSize = hasValue ? static_cast<uint8_t>(1 << (type & kTLVTypeSizeMask)) : static_cast<uint8_t>(0);
+
+    return ControlByteInfo{ static_cast<uint8_t>(1 + tagSize + valSize), hasLength ? valSize : static_cast<uint8_t>(0), 0 };
+}
+
+template <size_t... ControlBytes>
+constexpr std::array<ControlByteInfo, sizeof...(ControlBytes)> MakeControlByteTable(std::index_sequence<ControlBytes...>)
+{
+    return { { MakeControlByteInfo(static_cast<uint8_t>(ControlBytes))... } };
+}
+
+constexpr std::array<ControlByteInfo, 256> sControlByteInfo = MakeControlByteTable(std::make_index_sequence<256>());
+
+/*
+ * Whether an element with the given tag control passes the tag checks of VerifyElement, in a container of
+ * the given type.
+ */
+bool IsValidTagControl(TLVTagControl tagControl, TLVType containerType, uint32_t implicitProfileId)
+{
+    if ((tagControl == TLVTagControl::ImplicitProfile_2Bytes || tagControl == TLVTagControl::ImplicitProfile_4Bytes) &&
+        implicitProfileId == kProfileIdNotSpecified)
+    {
+        return false;
+    }
+
+    switch (containerType)
+    {
+    case kTLVType_NotSpecified:
+        return tagControl != TLVTagControl::ContextSpecific;
+    case kTLVType_Structure:
+        return tagControl != TLVTagControl::Anonymous;
+    case kTLVType_Array:
+        return tagControl == TLVTagControl::Anonymous;
+    case kTLVType_UnknownContainer:
+    case kTLVType_List:
+        return true;
+    default:
+        return false;
+    }
+}
+
+} // namespace
 
 TLVReader::TLVReader() :
     ImplicitProfileId(kProfileIdNotSpecified), AppData(nullptr), mElemLenOrVal(0), mBackingStore(nullptr), mReadPoint(nullptr),
@@ -747,12 +831,101 @@ CHIP_ERROR TLVReader::SkipToEndOfContainer()
         if (err != CHIP_NO_ERROR)
             return err;
 
+        // Go over the elements available in the current buffer in bulk, ReadElement only
+        // has to handle the elements at buffer boundaries and the end of the container.
+        SkipBufferedElements(nestLevel, outerContainerType);
+
         err = ReadElement();
         if (err != CHIP_NO_ERROR)
             return err;
     }
 }
 
+/**
+ * Skip over the elements that are entirely within the current buffer, using only their control byte
+ * and length field, on behalf of SkipToEndOfContainer.
+ *
+ * Stops before the end of the container being skipped (at @p nestLevel 0), before an element that
+ * extends past the buffer and before an element that VerifyElement would reject, so that ReadElement
+ * reads those the regular way.  @p nestLevel and the container type are updated as SkipToEndOfContainer
+ * would have.
+ */
+void TLVReader::SkipBufferedElements(uint32_t & nestLevel, TLVType outerContainerType)
+{
+    const uint8_t * p = mReadPoint;
+    if (p == nullptr)
+        return;
+
+    // Even if the buffer is larger, do not read past mMaxLen.
+    const uint8_t * end = mBufEnd;
+    if (static_cast<size_t>(end - p) > mMaxLen - mLenRead)
+        end = p + (mMaxLen - mLenRead);
+
+    TLVType containerType = mContainerType;
+    while (p < end)
+    {
+        const uint8_t controlByte    = *p;
+        const ControlByteInfo & info = sControlByteInfo[controlByte];
+        const auto tagControl        = static_cast<TLVTagControl>(controlByte & kTLVTagControlMask);
+
+        if (info.headLength == 0 || info.headLength > end - p)
+            break;
+
+        if (info.nesting < 0)
+        {
+            if (nestLevel == 0 || tagControl != TLVTagControl::Anonymous)
+                break;
+        }
+        else if (!IsValidTagControl(tagControl, containerType, ImplicitProfileId))
+        {
+            break;
+        }
+
+        size_t elemLen = info.headLength;
+        if (info.lengthBytes != 0)
+        {
+            const uint8_t * lengthField = p + info.headLength - info.lengthBytes;
+            uint64_t dataLen            = 0;
+            switch (info.lengthBytes)
+            {
+            case 1:
+                dataLen = Read8(lengthField);
+                break;
+            case 2:
+                dataLen = LittleEndian::Read16(lengthField);
+                break;
+            case 4:
+                dataLen = LittleEndian::Read32(lengthField);
+                break;
+            default:
+                dataLen = LittleEndian::Read64(lengthField);
+                break;
+            }
+
+            if (dataLen > static_cast<uint64_t>(end - p - info.headLength))
+                break;
+            elemLen += static_cast<size_t>(dataLen);
+        }
+
+        if (info.nesting > 0)
+        {
+            nestLevel++;
+            containerType = static_cast<TLVType>(controlByte & kTLVTypeMask);
+        }
+        else if (info.nesting < 0)
+        {
+            nestLevel--;
+            containerType = (nestLevel == 0) ? outerContainerType : kTLVType_UnknownContainer;
+        }
+
+        p += elemLen;
+    }
+
+    mLenRead += static_cast<uint32_t>(p - mReadPoint);
+    mReadPoint     = p;
+    mContainerType = containerType;
+}
+
 CHIP_ERROR TLVReader::ReadElement()
 {
     CHIP_ERROR err;
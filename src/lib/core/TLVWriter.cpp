@@ -17,6 +17,7 @@
  */
 #include <lib/core/TLVWriter.h>
 
+#include <algorithm>
 #include <stdarg.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -144,6 +145,18 @@ CHIP_ERROR TLVWriter::ReserveBuffer(uint32_t aBufferSize)
     return CHIP_NO_ERROR;
 }
 
+uint32_t TLVWriter::GetWritableLength() const
+{
+    uint32_t writableLength = mMaxLen - mLenWritten;
+
+    if (mBackingStore == nullptr || mBackingStore->GetNewBufferWillAlwaysFail())
+    {
+        writableLength = std::min(writableLength, mRemainingLen);
+    }
+
+    return writableLength;
+}
+
 CHIP_ERROR TLVWriter::PutBoolean(Tag tag, bool v)
 {
     return WriteElementHead((v) ? TLVElementType::BooleanTrue : TLVElementType::BooleanFalse, tag, 0);
@@ -798,6 +811,15 @@ CHIP_ERROR TLVWriter::WriteData(const uint8_t * p, uint32_t len)
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
     VerifyOrReturnError((mLenWritten + len) <= mMaxLen, CHIP_ERROR_BUFFER_TOO_SMALL);
 
+    if (mBufStart == nullptr && mBackingStore == nullptr)
+    {
+        // No buffer to write to (see SizeCalculator): just account for the data.
+        VerifyOrReturnError(len <= mRemainingLen, CHIP_ERROR_NO_MEMORY);
+        mRemainingLen -= len;
+        mLenWritten += len;
+        return CHIP_NO_ERROR;
+    }
+
     while (len > 0)
     {
         if (mRemainingLen == 0)
@@ -1212,6 +1212,17 @@ public:
      */
     uint32_t GetRemainingFreeLength() const { return mRemainingLen; }
 
+    /**
+     * Returns the maximum number of bytes that can still be written.
+     *
+     * Unlike GetRemainingFreeLength(), this accounts for the additional buffers a backing store may
+     * provide.  Writing an element larger than this is known to fail, so callers can check whether an
+     * element fits before encoding it (see SizeCalculator).
+     *
+     * @return the maximum number of bytes that can still be written.
+     */
+    uint32_t GetWritableLength() const;
+
     /**
      * @brief Returns true if this TLVWriter was properly initialized.
      */
@@ -1320,5 +1331,27 @@ private:
     Platform::ScopedMemoryBuffer<uint8_t> mBuffer;
 };
 
+/*
+ * A TLVWriter that does not store the encoding, and only computes its size.
+ *
+ * This allows knowing whether some data fits in the space left in a buffer before spending the
+ * work of encoding it there.
+ */
+class SizeCalculator : public TLVWriter
+{
+public:
+    /*
+     * Construct and initialize the calculator.  Writes fail with CHIP_ERROR_BUFFER_TOO_SMALL once
+     * the encoding is larger than maxLen, so that the computation stops as soon as the data is known
+     * not to fit.
+     */
+    SizeCalculator(uint32_t maxLen = UINT32_MAX) { Init(static_cast<uint8_t *>(nullptr), maxLen); }
+
+    /*
+     * Returns the size of the encoding of everything written so far.
+     */
+    uint32_t GetEncodedSize() const { return GetLengthWritten(); }
+};
+
 } // namespace TLV
 } // namespace chip
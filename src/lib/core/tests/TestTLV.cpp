@@ -46,6 +46,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
+
 using namespace chip;
 using namespace chip::TLV;
 
@@ -3349,6 +3351,48 @@ TEST_F(TestTLV, CheckTLVWriter)
     TestTLVEmptyString();
 }
 
+TEST_F(TestTLV, CheckSizeCalculator)
+{
+    for (auto write : { WriteEncoding1, WriteEncoding5 })
+    {
+        uint8_t buf[2048];
+        TLVWriter writer;
+        writer.Init(buf);
+        writer.ImplicitProfileId = TestProfile_2;
+        write(writer);
+        EXPECT_EQ(writer.Finalize(), CHIP_NO_ERROR);
+
+        // The size is the one of the actual encoding
+        SizeCalculator calculator;
+        calculator.ImplicitProfileId = TestProfile_2;
+        write(calculator);
+        EXPECT_EQ(calculator.Finalize(), CHIP_NO_ERROR);
+        EXPECT_EQ(calculator.GetEncodedSize(), writer.GetLengthWritten());
+
+        // Computing the size stops as soon as the encoding does not fit
+        SizeCalculator limitedCalculator(writer.GetLengthWritten() - 1);
+        TLVType outerContainerType;
+        EXPECT_EQ(limitedCalculator.StartContainer(AnonymousTag(), kTLVType_Array, outerContainerType), CHIP_NO_ERROR);
+        EXPECT_EQ(limitedCalculator.PutPreEncodedContainer(AnonymousTag(), kTLVType_Structure, buf, writer.GetLengthWritten()),
+                  CHIP_ERROR_BUFFER_TOO_SMALL);
+    }
+
+    uint8_t buf[16];
+    TLVWriter writer;
+    writer.Init(buf);
+    EXPECT_EQ(writer.GetWritableLength(), sizeof(buf));
+    EXPECT_EQ(writer.ReserveBuffer(3), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.Put(AnonymousTag(), static_cast<uint32_t>(0x12345678)), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.GetWritableLength(), sizeof(buf) - 3 - 5);
+
+    // What does not fit in the writable length fails to be written
+    uint8_t data[sizeof(buf)] = {};
+    TLVWriter checkpoint      = writer;
+    EXPECT_EQ(checkpoint.PutBytes(AnonymousTag(), data, writer.GetWritableLength() - 1), CHIP_ERROR_NO_MEMORY);
+    EXPECT_EQ(writer.PutBytes(AnonymousTag(), data, writer.GetWritableLength() - 2), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.GetWritableLength(), 0u);
+}
+
 void SkipNonContainer()
 {
     TLVReader reader;
@@ -4922,3 +4966,235 @@ TEST_F(TestTLV, TestUninitializedWriter)
         EXPECT_EQ(writer.CopyContainer(ContextTag(1), buf, static_cast<uint16_t>(sizeof(buf))), CHIP_ERROR_INCORRECT_STATE);
     }
 }
+
+/**
+ *  Hands out a contiguous encoding in fixed size chunks, so that elements straddle buffers.
+ */
+class ChunkedBackingStore : public TLVBackingStore
+{
+public:
+    ChunkedBackingStore(const uint8_t * data, uint32_t dataLen, uint32_t chunkSize) :
+        mData(data), mDataLen(dataLen), mChunkSize(chunkSize)
+    {}
+
+    CHIP_ERROR OnInit(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        mOffset = 0;
+        return GetNextBuffer(reader, bufStart, bufLen);
+    }
+
+    CHIP_ERROR GetNextBuffer(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        bufStart = mData + mOffset;
+        bufLen   = std::min(mChunkSize, mDataLen - mOffset);
+        mOffset += bufLen;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR OnInit(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override { return CHIP_ERROR_NOT_IMPLEMENTED; }
+    CHIP_ERROR GetNewBuffer(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+    CHIP_ERROR FinalizeBuffer(TLVWriter & writer, uint8_t * bufStart, uint32_t bufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
+private:
+    const uint8_t * mData;
+    uint32_t mDataLen;
+    uint32_t mChunkSize;
+    uint32_t mOffset = 0;
+};
+
+/**
+ *  Encodes a ReportData-like payload: a structure with an array of attribute reports, each
+ *  holding a path and a list of structures, followed by a sentinel element.
+ */
+CHIP_ERROR EncodeLargeReport(TLVWriter & writer, uint32_t reportCount, uint32_t itemCount)
+{
+    TLVType reportData, reports, report, dataIB, path, list, item;
+
+    ReturnErrorOnFailure(writer.StartContainer(AnonymousTag(), kTLVType_Structure, reportData));
+    ReturnErrorOnFailure(writer.StartContainer(ContextTag(1), kTLVType_Array, reports));
+    for (uint32_t i = 0; i < reportCount; i++)
+    {
+        ReturnErrorOnFailure(writer.StartContainer(AnonymousTag(), kTLVType_Structure, report));
+        ReturnErrorOnFailure(writer.StartContainer(ContextTag(1), kTLVType_Structure, dataIB));
+        ReturnErrorOnFailure(writer.Put(ContextTag(0), i));
+        ReturnErrorOnFailure(writer.StartContainer(ContextTag(1), kTLVType_List, path));
+        ReturnErrorOnFailure(writer.Put(ContextTag(2), static_cast<uint16_t>(1)));
+        ReturnErrorOnFailure(writer.Put(ContextTag(3), static_cast<uint32_t>(0x0028)));
+        ReturnErrorOnFailure(writer.Put(ContextTag(4), i));
+        ReturnErrorOnFailure(writer.EndContainer(path));
+        ReturnErrorOnFailure(writer.StartContainer(ContextTag(2), kTLVType_Array, list));
+        for (uint32_t j = 0; j < itemCount; j++)
+        {
+            ReturnErrorOnFailure(writer.StartContainer(AnonymousTag(), kTLVType_Structure, item));
+            ReturnErrorOnFailure(writer.Put(ContextTag(0), static_cast<uint64_t>(j) << 33));
+            ReturnErrorOnFailure(writer.PutString(ContextTag(1), "a label of some length"));
+            ReturnErrorOnFailure(writer.PutBoolean(ContextTag(2), (j % 2) == 0));
+            ReturnErrorOnFailure(writer.PutNull(ContextTag(3)));
+            ReturnErrorOnFailure(writer.Put(ContextTag(4), 1.5f));
+            ReturnErrorOnFailure(writer.EndContainer(item));
+        }
+        ReturnErrorOnFailure(writer.EndContainer(list));
+        ReturnErrorOnFailure(writer.EndContainer(dataIB));
+        ReturnErrorOnFailure(writer.EndContainer(report));
+    }
+    ReturnErrorOnFailure(writer.EndContainer(reports));
+    ReturnErrorOnFailure(writer.EndContainer(reportData));
+
+    return writer.Put(AnonymousTag(), static_cast<uint8_t>(42));
+}
+
+/**
+ *  Skips the current element by reading every element it contains, as Skip did before skipping
+ *  the elements of the current buffer in bulk.
+ */
+CHIP_ERROR SkipElementByElement(TLVReader & reader)
+{
+    if (!TLVTypeIsContainer(reader.GetType()))
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    TLVType outerContainerType;
+    CHIP_ERROR err;
+    ReturnErrorOnFailure(reader.EnterContainer(outerContainerType));
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        ReturnErrorOnFailure(SkipElementByElement(reader));
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+    return reader.ExitContainer(outerContainerType);
+}
+
+/**
+ *  Checks that skipping the first element and reading the next one gives the same outcome in bulk, with
+ *  any buffer boundaries, as element by element.  Returns that outcome.
+ */
+CHIP_ERROR CheckSkipOutcome(const uint8_t * data, uint32_t dataLen)
+{
+    TLVReader reference;
+    reference.Init(data, dataLen);
+    EXPECT_EQ(reference.Next(), CHIP_NO_ERROR);
+    CHIP_ERROR expected = SkipElementByElement(reference);
+    if (expected == CHIP_NO_ERROR)
+    {
+        expected = reference.Next();
+    }
+
+    for (uint32_t chunkSize : { dataLen, 1u, 3u, 7u })
+    {
+        ChunkedBackingStore store(data, dataLen, chunkSize);
+        TLVReader reader;
+        EXPECT_EQ(reader.Init(store, dataLen), CHIP_NO_ERROR);
+        EXPECT_EQ(reader.Next(), CHIP_NO_ERROR);
+
+        // Next skips the container in bulk before reading the element following it
+        EXPECT_EQ(reader.Next(), expected);
+        if (expected == CHIP_NO_ERROR)
+        {
+            EXPECT_EQ(reader.GetLengthRead(), reference.GetLengthRead());
+            EXPECT_EQ(reader.GetTag(), reference.GetTag());
+        }
+    }
+
+    return expected;
+}
+
+TEST_F(TestTLV, CheckBulkSkip)
+{
+    uint8_t buf[4096];
+    TLVWriter writer;
+    writer.Init(buf);
+    ASSERT_EQ(EncodeLargeReport(writer, 4, 8), CHIP_NO_ERROR);
+    ASSERT_EQ(writer.Finalize(), CHIP_NO_ERROR);
+    const uint32_t encodedLen = writer.GetLengthWritten();
+
+    EXPECT_EQ(CheckSkipOutcome(buf, encodedLen), CHIP_NO_ERROR);
+
+    // The element after the skipped container is read as usual
+    TLVReader reader;
+    reader.Init(buf, encodedLen);
+    ASSERT_EQ(reader.Next(), CHIP_NO_ERROR);
+    ASSERT_EQ(reader.Next(), CHIP_NO_ERROR);
+    uint8_t sentinel = 0;
+    EXPECT_EQ(reader.Get(sentinel), CHIP_NO_ERROR);
+    EXPECT_EQ(sentinel, 42);
+    EXPECT_EQ(reader.Next(), CHIP_END_OF_TLV);
+
+    // Truncated encodings
+    for (uint32_t truncatedLen = encodedLen / 2; truncatedLen < encodedLen; truncatedLen += 37)
+    {
+        EXPECT_NE(CheckSkipOutcome(buf, truncatedLen), CHIP_NO_ERROR);
+    }
+
+    // clang-format off
+    const uint8_t anonymousInStructure[] = { 0x15, 0x24, 0x01, 0x05, 0x04, 0x05, 0x18, 0x04, 0x00 };
+    const uint8_t taggedInArray[]        = { 0x16, 0x15, 0x24, 0x01, 0x05, 0x18, 0x24, 0x01, 0x05, 0x18, 0x04, 0x00 };
+    const uint8_t taggedEndOfContainer[] = { 0x15, 0x35, 0x01, 0x38, 0x01, 0x18, 0x04, 0x00 };
+    const uint8_t stringPastEnd[]        = { 0x17, 0x17, 0x0C, 0x10, 0x61, 0x18, 0x18, 0x04, 0x00 };
+    const uint8_t invalidType[]          = { 0x17, 0x17, 0x1F, 0x18, 0x18, 0x04, 0x00 };
+    const uint8_t implicitProfileTag[]   = { 0x17, 0x17, 0x84, 0x01, 0x00, 0x05, 0x18, 0x18, 0x04, 0x00 };
+    const uint8_t nested[]               = { 0x17, 0x17, 0x17, 0x0C, 0x02, 0x61, 0x62, 0x18, 0x18, 0x18, 0x04, 0x00 };
+    const uint8_t anonymousInNested[]    = { 0x17, 0x15, 0x04, 0x05, 0x18, 0x18, 0x04, 0x00 };
+    const uint8_t taggedInNestedArray[]  = { 0x17, 0x17, 0x16, 0x24, 0x01, 0x05, 0x18, 0x18, 0x18, 0x04, 0x00 };
+    // clang-format on
+
+    EXPECT_EQ(CheckSkipOutcome(anonymousInStructure, sizeof(anonymousInStructure)), CHIP_ERROR_INVALID_TLV_TAG);
+    EXPECT_EQ(CheckSkipOutcome(taggedInArray, sizeof(taggedInArray)), CHIP_ERROR_INVALID_TLV_TAG);
+    EXPECT_EQ(CheckSkipOutcome(taggedEndOfContainer, sizeof(taggedEndOfContainer)), CHIP_ERROR_INVALID_TLV_TAG);
+    EXPECT_EQ(CheckSkipOutcome(stringPastEnd, sizeof(stringPastEnd)), CHIP_ERROR_TLV_UNDERRUN);
+    EXPECT_EQ(CheckSkipOutcome(invalidType, sizeof(invalidType)), CHIP_ERROR_INVALID_TLV_ELEMENT);
+    EXPECT_EQ(CheckSkipOutcome(implicitProfileTag, sizeof(implicitProfileTag)), CHIP_ERROR_UNKNOWN_IMPLICIT_TLV_TAG);
+    EXPECT_EQ(CheckSkipOutcome(nested, sizeof(nested)), CHIP_NO_ERROR);
+    EXPECT_EQ(CheckSkipOutcome(anonymousInNested, sizeof(anonymousInNested)), CHIP_ERROR_INVALID_TLV_TAG);
+    EXPECT_EQ(CheckSkipOutcome(taggedInNestedArray, sizeof(taggedInNestedArray)), CHIP_ERROR_INVALID_TLV_TAG);
+}
+
+TEST_F(TestTLV, BenchmarkSkipReportData)
+{
+    constexpr uint32_t kReports    = 64;
+    constexpr uint32_t kItems      = 64;
+    constexpr uint32_t kIterations = 20;
+    constexpr size_t kBufferSize   = 512 * 1024;
+
+    chip::Platform::ScopedMemoryBuffer<uint8_t> buf;
+    ASSERT_TRUE(buf.Alloc(kBufferSize));
+
+    TLVWriter writer;
+    writer.Init(buf.Get(), kBufferSize);
+    ASSERT_EQ(EncodeLargeReport(writer, kReports, kItems), CHIP_NO_ERROR);
+    ASSERT_EQ(writer.Finalize(), CHIP_NO_ERROR);
+    const uint32_t encodedLen = writer.GetLengthWritten();
+
+    auto measure = [&](bool bulk) {
+        const uint64_t start = System::SystemClock().GetMonotonicMicroseconds64().count();
+        for (uint32_t i = 0; i < kIterations; i++)
+        {
+            TLVReader reader;
+            reader.Init(buf.Get(), encodedLen);
+            EXPECT_EQ(reader.Next(), CHIP_NO_ERROR);
+            if (bulk)
+            {
+                EXPECT_EQ(reader.Skip(), CHIP_NO_ERROR);
+            }
+            else
+            {
+                EXPECT_EQ(SkipElementByElement(reader), CHIP_NO_ERROR);
+            }
+            EXPECT_EQ(reader.Next(), CHIP_NO_ERROR);
+            EXPECT_EQ(reader.GetLengthRead(), encodedLen);
+        }
+        return (System::SystemClock().GetMonotonicMicroseconds64().count() - start) / kIterations;
+    };
+
+    const uint64_t elementByElement = measure(false);
+    const uint64_t bulk             = measure(true);
+
+    ChipLogProgress(DataManagement, "Skipping a %u byte report: %u us element by element, %u us in bulk",
+                    static_cast<unsigned>(encodedLen), static_cast<unsigned>(elementByElement), static_cast<unsigned>(bulk));
+}
@@ -27,6 +27,7 @@
 #include <crypto/RandUtils.h>
 #include <lib/dnssd/Advertiser_ImplMinimalMdnsAllocator.h>
 #include <lib/dnssd/minimal_mdns/AddressPolicy.h>
+#include <lib/dnssd/minimal_mdns/KnownAnswers.h>
 #include <lib/dnssd/minimal_mdns/ResponseSender.h>
 #include <lib/dnssd/minimal_mdns/Server.h>
 #include <lib/dnssd/minimal_mdns/core/FlatAllocatedQName.h>
@@ -195,8 +196,8 @@ public:
     void OnMdnsPacketData(const BytesRange & data, const chip::Inet::IPPacketInfo * info) override;
 
     // ParserDelegate
-    void OnHeader(ConstHeaderRef & header) override { mMessageId = header.GetMessageId(); }
-    void OnResource(ResourceType type, const ResourceData & data) override {}
+    void OnHeader(ConstHeaderRef & header) override;
+    void OnResource(ResourceType type, const ResourceData & data) override;
     void OnQuery(const QueryData & data) override;
 
 private:
@@ -317,8 +318,20 @@ private:
     bool mIsInitialized = false;
 
     // current request handling
+    //
+    // Query packets are parsed twice: first to collect the known answers
+    // listed by the querier, then to reply to the queries.
+    enum class ParseStage
+    {
+        kCollectKnownAnswers,
+        kReplyToQueries,
+    };
+
     const chip::Inet::IPPacketInfo * mCurrentSource = nullptr;
     uint16_t mMessageId                             = 0;
+    bool mIsQuery                                   = false;
+    ParseStage mParseStage                          = ParseStage::kCollectKnownAnswers;
+    KnownAnswerList mKnownAnswers;
 
     const char * mEmptyTextEntries[1] = {
         "=",
@@ -334,15 +347,59 @@ void AdvertiserMinMdns::OnMdnsPacketData(const BytesRange & data, const chip::In
 #endif
 
     mCurrentSource = info;
+    mKnownAnswers.Reset(data);
+
+    mParseStage = ParseStage::kCollectKnownAnswers;
     if (!ParsePacket(data, this))
     {
         ChipLogError(Discovery, "Failed to parse mDNS query");
+        mCurrentSource = nullptr;
+        return;
     }
+
+    // All the queries of the packet are replied to together
+    const ResponseConfiguration defaultResponseConfiguration;
+    mResponseSender.StartReply(mMessageId, mCurrentSource, defaultResponseConfiguration, &mKnownAnswers);
+
+    mParseStage = ParseStage::kReplyToQueries;
+    if (!ParsePacket(data, this))
+    {
+        ChipLogError(Discovery, "Failed to parse mDNS query");
+    }
+
+    CHIP_ERROR err = mResponseSender.FinishReply();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Discovery, "Failed to reply to query: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+
     mCurrentSource = nullptr;
 }
 
+void AdvertiserMinMdns::OnHeader(ConstHeaderRef & header)
+{
+    mMessageId = header.GetMessageId();
+    mIsQuery   = header.GetFlags().IsQuery();
+}
+
+void AdvertiserMinMdns::OnResource(ResourceType type, const ResourceData & data)
+{
+    if ((mParseStage != ParseStage::kCollectKnownAnswers) || !mIsQuery || (type != ResourceType::kAnswer))
+    {
+        return;
+    }
+
+    // Known answers beyond the supported number are just not suppressed
+    mKnownAnswers.Add(data);
+}
+
 void AdvertiserMinMdns::OnQuery(const QueryData & data)
 {
+    if (mParseStage != ParseStage::kReplyToQueries)
+    {
+        return;
+    }
+
     if (mCurrentSource == nullptr)
     {
         ChipLogError(Discovery, "INTERNAL CONSISTENCY ERROR: missing query source");
@@ -351,12 +408,8 @@ void AdvertiserMinMdns::OnQuery(const QueryData & data)
 
     LogQuery(data);
 
-    const ResponseConfiguration defaultResponseConfiguration;
-    CHIP_ERROR err = mResponseSender.Respond(mMessageId, data, mCurrentSource, defaultResponseConfiguration);
-    if (err != CHIP_NO_ERROR)
-    {
-        ChipLogError(Discovery, "Failed to reply to query: %" CHIP_ERROR_FORMAT, err.Format());
-    }
+    // A failure stops the reply and is reported by FinishReply
+    mResponseSender.AddQueryReply(data);
 }
 
 CHIP_ERROR AdvertiserMinMdns::Init(chip::Inet::EndPointManager<chip::Inet::UDPEndPoint> * udpEndPointManager)
@@ -16,6 +16,8 @@
  */
 #include <lib/dnssd/IncrementalResolve.h>
 
+#include <algorithm>
+
 #include <lib/dnssd/IPAddressSorter.h>
 #include <lib/dnssd/ServiceNaming.h>
 #include <lib/dnssd/TxtFields.h>
@@ -37,6 +39,17 @@ ByteSpan GetSpan(const mdns::Minimal::BytesRange & range)
     return ByteSpan(range.Start(), range.Size());
 }
 
+/// Lowers the remembered TTL of resolved data to the TTL (in seconds) of one more of its records.
+void UpdateMinimumTtl(std::optional<System::Clock::Seconds32> & minimumTtl, uint64_t ttl)
+{
+    const System::Clock::Seconds32 recordTtl(static_cast<uint32_t>(std::min<uint64_t>(ttl, UINT32_MAX)));
+
+    if (!minimumTtl.has_value() || (recordTtl < *minimumTtl))
+    {
+        minimumTtl = recordTtl;
+    }
+}
+
 /// Handles filling record data from TXT records.
 ///
 /// Supported records are whatever `FillNodeDataFromTxt` supports.
@@ -185,6 +198,7 @@ CHIP_ERROR IncrementalResolver::InitializeParsing(mdns::Minimal::SerializedQName
                 return err;
             }
             mSpecificResolutionData.Get<OperationalNodeData>().hasZeroTTL = (ttl == 0);
+            UpdateMinimumTtl(mSpecificResolutionData.Get<OperationalNodeData>().ttl, ttl);
         }
 
         LogFoundOperationalSrvRecord(mSpecificResolutionData.Get<OperationalNodeData>().peerId, mTargetHostName.Get());
@@ -263,7 +277,7 @@ CHIP_ERROR IncrementalResolver::OnRecord(Inet::InterfaceId interface, const Reso
             return CHIP_ERROR_INVALID_ARGUMENT;
         }
 
-        return OnIpAddress(interface, addr);
+        return OnIpAddress(interface, addr, data.GetTtlSeconds());
 #else
 #if CHIP_MINMDNS_HIGH_VERBOSITY
         ChipLogProgress(Discovery, "Ignoring A record: IPv4 not supported");
@@ -285,7 +299,7 @@ CHIP_ERROR IncrementalResolver::OnRecord(Inet::InterfaceId interface, const Reso
             return CHIP_ERROR_INVALID_ARGUMENT;
         }
 
-        return OnIpAddress(interface, addr);
+        return OnIpAddress(interface, addr, data.GetTtlSeconds());
     }
     case QType::SRV: // SRV handled on creation, ignored for 'additional data'
     default:
@@ -318,7 +332,7 @@ CHIP_ERROR IncrementalResolver::OnTxtRecord(const ResourceData & data, BytesRang
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR IncrementalResolver::OnIpAddress(Inet::InterfaceId interface, const Inet::IPAddress & addr)
+CHIP_ERROR IncrementalResolver::OnIpAddress(Inet::InterfaceId interface, const Inet::IPAddress & addr, uint64_t ttl)
 {
     if (mCommonResolutionData.numIPs >= ArraySize(mCommonResolutionData.ipAddress))
     {
@@ -338,6 +352,11 @@ CHIP_ERROR IncrementalResolver::OnIpAddress(Inet::InterfaceId interface, const I
 
     mCommonResolutionData.ipAddress[mCommonResolutionData.numIPs++] = addr;
 
+    if (IsActiveOperationalParse())
+    {
+        UpdateMinimumTtl(mSpecificResolutionData.Get<OperationalNodeData>().ttl, ttl);
+    }
+
     LogFoundIPAddress(mTargetHostName.Get(), addr);
 
     return CHIP_NO_ERROR;
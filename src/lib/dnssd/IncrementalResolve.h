@@ -184,7 +184,7 @@ private:
     /// addresses.
     ///
     /// Prerequisite: IP address belongs to the right nost name
-    CHIP_ERROR OnIpAddress(Inet::InterfaceId interface, const Inet::IPAddress & addr);
+    CHIP_ERROR OnIpAddress(Inet::InterfaceId interface, const Inet::IPAddress & addr, uint64_t ttl);
 
     using ParsedRecordSpecificData = Variant<OperationalNodeData, CommissionNodeData>;
 
@@ -22,6 +22,7 @@
 #include <lib/dnssd/IncrementalResolve.h>
 #include <lib/dnssd/MinimalMdnsServer.h>
 #include <lib/dnssd/ServiceNaming.h>
+#include <lib/dnssd/minimal_mdns/KnownAnswers.h>
 #include <lib/dnssd/minimal_mdns/Logging.h>
 #include <lib/dnssd/minimal_mdns/Parser.h>
 #include <lib/dnssd/minimal_mdns/QueryBuilder.h>
@@ -45,6 +46,36 @@ constexpr uint16_t kMdnsPort        = 5353;
 
 using namespace mdns::Minimal;
 
+/// Checks if the given name is the name of a matter service (or service subtype),
+/// i.e. the name of the PTR records that browsing returns.
+bool IsMatterServiceName(SerializedQNameIterator name)
+{
+    size_t labelCount = 0;
+    for (SerializedQNameIterator it = name; it.Next();)
+    {
+        labelCount++;
+    }
+    VerifyOrReturnValue(labelCount >= 3, false);
+
+    // Skip to the <service>.<protocol>.local suffix
+    SerializedQNameIterator it = name;
+    for (size_t i = 0; i < labelCount - 3; i++)
+    {
+        it.Next();
+    }
+
+    VerifyOrReturnValue(it.Next(), false);
+    const bool isOperational = (strcasecmp(it.Value(), kOperationalServiceName) == 0);
+    VerifyOrReturnValue(isOperational || (strcasecmp(it.Value(), kCommissionableServiceName) == 0) ||
+                            (strcasecmp(it.Value(), kCommissionerServiceName) == 0),
+                        false);
+
+    VerifyOrReturnValue(it.Next(), false);
+    VerifyOrReturnValue(strcasecmp(it.Value(), isOperational ? kOperationalProtocol : kCommissionProtocol) == 0, false);
+
+    return it.Next() && (strcasecmp(it.Value(), kLocalDomain) == 0);
+}
+
 /// Handles processing of minmdns packet data.
 ///
 /// Can process multiple incremental resolves based on SRV data and allows
@@ -53,7 +84,9 @@ using namespace mdns::Minimal;
 class PacketParser : private ParserDelegate
 {
 public:
-    PacketParser(ActiveResolveAttempts & activeResolves) : mActiveResolves(activeResolves) {}
+    PacketParser(ActiveResolveAttempts & activeResolves, KnownAnswerCache & knownAnswers) :
+        mActiveResolves(activeResolves), mKnownAnswers(knownAnswers)
+    {}
 
     /// Goes through the given SRV records within a response packet
     /// and sets up data resolution
@@ -83,7 +116,10 @@ private:
     /// Called IFF parsing state is in RecordParsing
     ///
     /// Forwards the resource to all active resolvers.
-    void ParseResource(const ResourceData & data);
+    void ParseResource(ResourceType type, const ResourceData & data);
+
+    /// Remembers a browse result, to be listed as a known answer when browsing again.
+    void RecordKnownAnswer(const ResourceData & data);
 
     enum class RecordParsingState
     {
@@ -102,6 +138,7 @@ private:
 
     // resolvers kept between parse steps
     ActiveResolveAttempts & mActiveResolves;
+    KnownAnswerCache & mKnownAnswers;
     IncrementalResolver mResolvers[kMinMdnsNumParallelResolvers];
 };
 
@@ -149,7 +186,7 @@ void PacketParser::OnResource(ResourceType type, const ResourceData & data)
             // SRV packets logged during 'SrvInitialization' phase
             mdns::Minimal::Logging::LogReceivedResource(data);
         }
-        ParseResource(data);
+        ParseResource(type, data);
         break;
     case RecordParsingState::kIdle:
         ChipLogError(Discovery, "Illegal state: received DNSSD resource while IDLE");
@@ -157,8 +194,13 @@ void PacketParser::OnResource(ResourceType type, const ResourceData & data)
     }
 }
 
-void PacketParser::ParseResource(const ResourceData & data)
+void PacketParser::ParseResource(ResourceType type, const ResourceData & data)
 {
+    if ((type == ResourceType::kAnswer) && (data.GetType() == QType::PTR))
+    {
+        RecordKnownAnswer(data);
+    }
+
     for (auto & resolver : mResolvers)
     {
         if (resolver.IsActive())
@@ -188,6 +230,25 @@ void PacketParser::ParseResource(const ResourceData & data)
     }
 }
 
+void PacketParser::RecordKnownAnswer(const ResourceData & data)
+{
+    VerifyOrReturn(IsMatterServiceName(data.GetName()));
+
+    SerializedQNameIterator target;
+    VerifyOrReturn(ParsePtrRecord(data.GetData(), mPacketRange, &target));
+
+    // Only remember services whose SRV record is being processed: if it is not (e.g. out of
+    // parallel resolvers), the service has to reply again for the browse to find it.
+    for (auto & resolver : mResolvers)
+    {
+        if (resolver.IsActive() && (resolver.GetRecordName() == target))
+        {
+            mKnownAnswers.Record(data, mPacketRange, System::SystemClock().GetMonotonicTimestamp());
+            return;
+        }
+    }
+}
+
 void PacketParser::ParseSRVResource(const ResourceData & data)
 {
     SrvRecord srv;
@@ -267,7 +328,7 @@ void PacketParser::ParseNonSrvRecords(Inet::InterfaceId interface, const BytesRa
 class MinMdnsResolver : public Resolver, public MdnsPacketDelegate
 {
 public:
-    MinMdnsResolver() : mActiveResolves(&chip::System::SystemClock()), mPacketParser(mActiveResolves)
+    MinMdnsResolver() : mActiveResolves(&chip::System::SystemClock()), mPacketParser(mActiveResolves, mKnownAnswers)
     {
         GlobalMinimalMdnsServer::Instance().SetResponseDelegate(this);
     }
@@ -292,6 +353,7 @@ private:
     DiscoveryContext * mDiscoveryContext              = nullptr;
     System::Layer * mSystemLayer                      = nullptr;
     ActiveResolveAttempts mActiveResolves;
+    KnownAnswerCache mKnownAnswers;
     PacketParser mPacketParser;
 
     void SetDiscoveryContext(DiscoveryContext * context);
@@ -594,6 +656,13 @@ CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResol
     mdns::Minimal::Logging::LogSendingQuery(query);
     builder.AddQuery(query);
 
+    if (!firstSend)
+    {
+        // Retries list the nodes found so far, so that they do not reply again
+        // (https://tools.ietf.org/html/rfc6762#section-7.1)
+        mKnownAnswers.AddKnownAnswers(builder, qname, System::SystemClock().GetMonotonicTimestamp());
+    }
+
     return CHIP_NO_ERROR;
 }
 
@@ -741,6 +810,8 @@ CHIP_ERROR MinMdnsResolver::ReconfirmRecord(const char * hostname, Inet::IPAddre
 
 CHIP_ERROR MinMdnsResolver::BrowseNodes(DiscoveryType type, DiscoveryFilter filter)
 {
+    // A new discovery reports all the nodes again, so they must not be suppressed as known answers
+    mKnownAnswers.Clear();
     mActiveResolves.MarkPending(filter, type);
 
     return SendAllPendingQueries();
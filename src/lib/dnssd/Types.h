@@ -198,7 +198,13 @@ struct OperationalNodeData
 {
     PeerId peerId;
     bool hasZeroTTL;
-    void Reset() { peerId = PeerId(); }
+    // Smallest TTL of the SRV and address records the data was resolved from, if known.
+    std::optional<System::Clock::Seconds32> ttl;
+    void Reset()
+    {
+        peerId = PeerId();
+        ttl    = std::nullopt;
+    }
 };
 
 struct OperationalNodeBrowseData : public OperationalNodeData
@@ -0,0 +1,260 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "KnownAnswers.h"
+
+#include <lib/dnssd/minimal_mdns/RecordData.h>
+#include <lib/dnssd/minimal_mdns/records/IP.h>
+#include <lib/dnssd/minimal_mdns/records/Ptr.h>
+#include <lib/dnssd/minimal_mdns/records/Srv.h>
+#include <lib/dnssd/minimal_mdns/records/Txt.h>
+
+#include <lib/support/CodeUtils.h>
+
+#include <algorithm>
+#include <string.h>
+
+namespace mdns {
+namespace Minimal {
+
+namespace {
+
+using chip::System::Clock::Seconds32;
+using chip::System::Clock::Timestamp;
+
+bool SameClass(QClass a, QClass b)
+{
+    // The cache flush bit is not part of the record identity
+    return (static_cast<uint16_t>(a) | kQClassResponseFlushBit) == (static_cast<uint16_t>(b) | kQClassResponseFlushBit);
+}
+
+bool SameTxtEntries(const BytesRange & data, const TxtResourceRecord & record)
+{
+    const uint8_t * p = data.Start();
+
+    for (size_t i = 0; i < record.GetNumEntries(); i++)
+    {
+        const char * entry = record.GetEntries()[i];
+        size_t len         = strlen(entry);
+
+        if ((p >= data.End()) || (*p != len) || (static_cast<size_t>(data.End() - p - 1) < len))
+        {
+            return false;
+        }
+        if (memcmp(p + 1, entry, len) != 0)
+        {
+            return false;
+        }
+        p += len + 1;
+    }
+
+    return p == data.End();
+}
+
+} // namespace
+
+bool KnownAnswerList::Add(const ResourceData & answer)
+{
+    if (mCount >= kMaxAnswers)
+    {
+        return false;
+    }
+
+    mAnswers[mCount++] = answer;
+    return true;
+}
+
+bool KnownAnswerList::Contains(const ResourceRecord & record) const
+{
+    for (size_t i = 0; i < mCount; i++)
+    {
+        const ResourceData & answer = mAnswers[i];
+
+        if ((answer.GetType() != record.GetType()) || !SameClass(answer.GetClass(), record.GetClass()))
+        {
+            continue;
+        }
+
+        // https://tools.ietf.org/html/rfc6762#section-7.1: the known answer TTL
+        // has to be at least half of the correct TTL for the answer to be suppressed
+        if (answer.GetTtlSeconds() * 2 < record.GetTtl())
+        {
+            continue;
+        }
+
+        if ((answer.GetName() == record.GetName()) && SameData(answer, record))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool KnownAnswerList::SameData(const ResourceData & answer, const ResourceRecord & record) const
+{
+    switch (record.GetType())
+    {
+    case QType::PTR: {
+        SerializedQNameIterator target;
+        return ParsePtrRecord(answer.GetData(), mPacket, &target) &&
+            (target == static_cast<const PtrResourceRecord &>(record).GetPtr());
+    }
+    case QType::SRV: {
+        const SrvResourceRecord & srvRecord = static_cast<const SrvResourceRecord &>(record);
+        SrvRecord srv;
+
+        return srv.Parse(answer.GetData(), mPacket) && (srv.GetPort() == srvRecord.GetPort()) &&
+            (srv.GetPriority() == srvRecord.GetPriority()) && (srv.GetWeight() == srvRecord.GetWeight()) &&
+            (srv.GetName() == srvRecord.GetServerName());
+    }
+    case QType::TXT:
+        return SameTxtEntries(answer.GetData(), static_cast<const TxtResourceRecord &>(record));
+    case QType::A: {
+        chip::Inet::IPAddress address;
+        return ParseARecord(answer.GetData(), &address) &&
+            (address == static_cast<const IPResourceRecord &>(record).GetIPAddress());
+    }
+    case QType::AAAA: {
+        chip::Inet::IPAddress address;
+        return ParseAAAARecord(answer.GetData(), &address) &&
+            (address == static_cast<const IPResourceRecord &>(record).GetIPAddress());
+    }
+    default:
+        // Not a record type minmdns replies with
+        return false;
+    }
+}
+
+void KnownAnswerCache::Record(const ResourceData & record, const BytesRange & packet, Timestamp now)
+{
+    if (record.GetType() != QType::PTR)
+    {
+        return;
+    }
+
+    SerializedQNameIterator target;
+    if (!ParsePtrRecord(record.GetData(), packet, &target))
+    {
+        return;
+    }
+
+    Entry * slot = nullptr;
+    for (auto & entry : mEntries)
+    {
+        if (entry.IsValid() && (record.GetName() == entry.name.Content()) && (target == entry.target.Content()))
+        {
+            slot = &entry;
+            break;
+        }
+    }
+
+    if (record.GetTtlSeconds() == 0)
+    {
+        // Goodbye packet: the record is no longer valid
+        if (slot != nullptr)
+        {
+            *slot = Entry();
+        }
+        return;
+    }
+
+    uint32_t ttlSeconds = static_cast<uint32_t>(std::min<uint64_t>(record.GetTtlSeconds(), UINT32_MAX));
+    Timestamp expiry    = now + Seconds32(ttlSeconds);
+
+    if (slot == nullptr)
+    {
+        // Use a free (or expired) entry, otherwise replace the one expiring first
+        for (auto & entry : mEntries)
+        {
+            if (!entry.IsValid() || (entry.expiry <= now))
+            {
+                slot = &entry;
+                break;
+            }
+            if ((slot == nullptr) || (entry.expiry < slot->expiry))
+            {
+                slot = &entry;
+            }
+        }
+
+        VerifyOrReturn(slot != nullptr);
+        VerifyOrReturn(!slot->IsValid() || (slot->expiry <= now) || (slot->expiry < expiry));
+
+        slot->name   = HeapQName(record.GetName());
+        slot->target = HeapQName(target);
+        if (!slot->IsValid())
+        {
+            *slot = Entry();
+            return;
+        }
+    }
+
+    slot->ttlSeconds = ttlSeconds;
+    slot->expiry     = expiry;
+}
+
+size_t KnownAnswerCache::AddKnownAnswers(QueryBuilder & builder, const FullQName & name, Timestamp now) const
+{
+    size_t added = 0;
+
+    for (auto & entry : mEntries)
+    {
+        if (!entry.IsValid() || (entry.expiry <= now) || (entry.name.Content() != name))
+        {
+            continue;
+        }
+
+        uint32_t remainingSeconds = std::chrono::duration_cast<Seconds32>(entry.expiry - now).count();
+        if (static_cast<uint64_t>(remainingSeconds) * 2 < entry.ttlSeconds)
+        {
+            // Past half of its lifetime: let responders refresh it
+            continue;
+        }
+
+        PtrResourceRecord answer(entry.name.Content(), entry.target.Content());
+        answer.SetTtl(remainingSeconds);
+
+        if (builder.AddAnswer(answer))
+        {
+            added++;
+        }
+    }
+
+    return added;
+}
+
+void KnownAnswerCache::Clear()
+{
+    for (auto & entry : mEntries)
+    {
+        entry = Entry();
+    }
+}
+
+size_t KnownAnswerCache::Count() const
+{
+    size_t count = 0;
+    for (auto & entry : mEntries)
+    {
+        count += entry.IsValid() ? 1 : 0;
+    }
+    return count;
+}
+
+} // namespace Minimal
+} // namespace mdns
@@ -0,0 +1,114 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/dnssd/minimal_mdns/Parser.h>
+#include <lib/dnssd/minimal_mdns/QueryBuilder.h>
+#include <lib/dnssd/minimal_mdns/core/BytesRange.h>
+#include <lib/dnssd/minimal_mdns/core/HeapQName.h>
+#include <lib/dnssd/minimal_mdns/records/ResourceRecord.h>
+
+#include <system/SystemClock.h>
+
+#include <array>
+
+namespace mdns {
+namespace Minimal {
+
+/// Known answers listed in a received query packet.
+///
+/// Used by responders to implement known-answer suppression
+/// (https://tools.ietf.org/html/rfc6762#section-7.1): a record is not sent
+/// back if the querier listed it with at least half of its correct TTL.
+///
+/// Answers reference the packet data, so they are only valid while the
+/// packet is.
+class KnownAnswerList
+{
+public:
+    static constexpr size_t kMaxAnswers = CHIP_CONFIG_MINMDNS_MAX_KNOWN_ANSWERS;
+
+    /// Forgets any known answer and starts collecting answers of the given packet.
+    void Reset(const BytesRange & packet)
+    {
+        mPacket = packet;
+        mCount  = 0;
+    }
+
+    /// Adds a known answer. Answers over kMaxAnswers are ignored (the
+    /// corresponding records are then just not suppressed).
+    ///
+    /// Returns true if the answer was added.
+    bool Add(const ResourceData & answer);
+
+    size_t Count() const { return mCount; }
+
+    /// Checks if the given record, about to be sent, is known by the querier.
+    bool Contains(const ResourceRecord & record) const;
+
+private:
+    bool SameData(const ResourceData & answer, const ResourceRecord & record) const;
+
+    BytesRange mPacket;
+    std::array<ResourceData, kMaxAnswers> mAnswers;
+    size_t mCount = 0;
+};
+
+/// Remembers PTR records received in replies, so that they can be listed as
+/// known answers when the same query is sent again
+/// (https://tools.ietf.org/html/rfc6762#section-7.1).
+///
+/// Records are listed as long as less than half of their TTL has elapsed.
+class KnownAnswerCache
+{
+public:
+    static constexpr size_t kMaxEntries = CHIP_CONFIG_MINMDNS_MAX_KNOWN_ANSWERS;
+
+    /// Records a PTR record received in a reply. Other record types are
+    /// ignored and a record with a TTL of 0 is forgotten.
+    ///
+    /// When the cache is full, the record that expires first is replaced.
+    void Record(const ResourceData & record, const BytesRange & packet, chip::System::Clock::Timestamp now);
+
+    /// Adds known answers to a query for the given name.
+    ///
+    /// Returns the number of answers added.
+    size_t AddKnownAnswers(QueryBuilder & builder, const FullQName & name, chip::System::Clock::Timestamp now) const;
+
+    /// Forgets all the records.
+    void Clear();
+
+    size_t Count() const;
+
+private:
+    struct Entry
+    {
+        HeapQName name;
+        HeapQName target;
+        uint32_t ttlSeconds                   = 0;
+        chip::System::Clock::Timestamp expiry = chip::System::Clock::kZero;
+
+        bool IsValid() const { return name.IsOk() && target.IsOk(); }
+    };
+
+    std::array<Entry, kMaxEntries> mEntries;
+};
+
+} // namespace Minimal
+} // namespace mdns
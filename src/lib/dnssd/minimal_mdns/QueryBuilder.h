@@ -21,6 +21,7 @@
 
 #include <lib/dnssd/minimal_mdns/Query.h>
 #include <lib/dnssd/minimal_mdns/core/DnsHeader.h>
+#include <lib/dnssd/minimal_mdns/records/ResourceRecord.h>
 
 namespace mdns {
 namespace Minimal {
@@ -28,8 +29,12 @@ namespace Minimal {
 class QueryBuilder
 {
 public:
-    QueryBuilder() : mHeader(nullptr) {}
-    QueryBuilder(chip::System::PacketBufferHandle && packet) : mHeader(nullptr) { Reset(std::move(packet)); }
+    QueryBuilder() : mHeader(nullptr), mEndianOutput(nullptr, 0), mWriter(&mEndianOutput) {}
+    QueryBuilder(chip::System::PacketBufferHandle && packet) :
+        mHeader(nullptr), mEndianOutput(nullptr, 0), mWriter(&mEndianOutput)
+    {
+        Reset(std::move(packet));
+    }
 
     QueryBuilder & Reset(chip::System::PacketBufferHandle && packet)
     {
@@ -47,6 +52,14 @@ public:
         }
 
         mHeader.SetFlags(mHeader.GetFlags().SetQuery());
+
+        // A single writer for the whole packet, so that names are compressed across queries and answers
+        mEndianOutput =
+            chip::Encoding::BigEndian::BufferWriter(mPacket->Start(), mPacket->DataLength() + mPacket->AvailableDataLength());
+        mEndianOutput.Skip(mPacket->DataLength());
+
+        mWriter.Reset();
+
         return *this;
     }
 
@@ -67,25 +80,61 @@ public:
             return *this;
         }
 
-        chip::Encoding::BigEndian::BufferWriter out(mPacket->Start() + mPacket->DataLength(), mPacket->AvailableDataLength());
-        RecordWriter writer(&out);
+        // queries have to come before any answers
+        if (mHeader.GetAnswerCount() != 0)
+        {
+            mQueryBuildOk = false;
+            return *this;
+        }
 
-        if (!query.Append(mHeader, writer))
+        if (!query.Append(mHeader, mWriter))
         {
             mQueryBuildOk = false;
         }
         else
         {
-            mPacket->SetDataLength(static_cast<uint16_t>(mPacket->DataLength() + out.Needed()));
+            mPacket->SetDataLength(static_cast<uint16_t>(mEndianOutput.Needed()));
         }
         return *this;
     }
 
+    /// Lists the given record as a known answer of the queries in the packet
+    /// (https://tools.ietf.org/html/rfc6762#section-7.1).
+    ///
+    /// Must be called after all the queries were added. Known answers are
+    /// optional, so a record that does not fit is skipped and leaves the
+    /// packet unchanged.
+    ///
+    /// Returns true if the record was added.
+    bool AddAnswer(const ResourceRecord & record)
+    {
+        if (!mQueryBuildOk)
+        {
+            return false;
+        }
+
+        chip::Encoding::BigEndian::BufferWriter savedOutput = mEndianOutput;
+        RecordWriter savedWriter                            = mWriter;
+
+        if (!record.Append(mHeader, ResourceType::kAnswer, mWriter))
+        {
+            // Append leaves the header unchanged on failure, roll back the partially written record
+            mEndianOutput = savedOutput;
+            mWriter       = savedWriter;
+            return false;
+        }
+
+        mPacket->SetDataLength(static_cast<uint16_t>(mEndianOutput.Needed()));
+        return true;
+    }
+
     bool Ok() const { return mQueryBuildOk; }
 
 private:
     chip::System::PacketBufferHandle mPacket;
     HeaderRef mHeader;
+    chip::Encoding::BigEndian::BufferWriter mEndianOutput;
+    RecordWriter mWriter;
     bool mQueryBuildOk = true;
 };
 
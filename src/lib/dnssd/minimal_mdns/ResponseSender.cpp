@@ -40,9 +40,9 @@ constexpr uint16_t kPacketSizeBytes = 512;
 } // namespace
 namespace Internal {
 
-bool ResponseSendingState::SendUnicast() const
+bool ResponseSendingState::SendUnicast(const QueryData & query) const
 {
-    return mQuery->RequestedUnicastAnswer() || (mSource->SrcPort != kMdnsStandardPort);
+    return query.RequestedUnicastAnswer() || (mSource->SrcPort != kMdnsStandardPort);
 }
 
 bool ResponseSendingState::IncludeQuery() const
@@ -105,82 +105,139 @@ bool ResponseSender::HasQueryResponders() const
 CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query, const chip::Inet::IPPacketInfo * querySource,
                                    const ResponseConfiguration & configuration)
 {
-    mSendState.Reset(messageId, query, querySource);
+    StartReply(messageId, querySource, configuration);
+    mSendState.SetError(AddQueryReply(query));
+    return FinishReply();
+}
 
-    if (query.IsAnnounceBroadcast())
+void ResponseSender::StartReply(uint16_t messageId, const chip::Inet::IPPacketInfo * querySource,
+                                const ResponseConfiguration & configuration, const KnownAnswerList * knownAnswers)
+{
+    if (mResponseBuilder.HasPacketBuffer())
     {
-        // Deny listing large amount of data
-        mSendState.MarkWasSent(ResponseItemsSent::kServiceListingData);
+        // Left over by a reply that failed, never to be sent.
+        chip::System::PacketBufferHandle unused = mResponseBuilder.ReleasePacket();
     }
 
-    // Responder has a stateful 'additional replies required' that is used within the response
-    // loop. 'no additionals required' is set at the start and additionals are marked as the query
-    // reply is built.
-    for (auto & responder : mResponders)
+    mSendState.Reset(messageId, querySource, &configuration, knownAnswers);
+    ResetResponders();
+}
+
+CHIP_ERROR ResponseSender::AddQueryReply(const QueryData & query)
+{
+    ReturnErrorOnFailure(mSendState.GetError());
+
+    // Answers to all the queries of a packet are aggregated into the same reply,
+    // except for legacy replies that repeat the query they answer, or when the
+    // destination of the reply changes (unicast vs multicast).
+    if (mSendState.HasQuery() && (mSendState.IncludeQuery() || (mSendState.SendUnicast() != mSendState.SendUnicast(query))))
     {
-        {
-            if (responder != nullptr)
-            {
-                responder->ResetAdditionals();
-            }
-        }
+        ReturnErrorOnFailure(mSendState.SetError(FinishReplyGroup()));
     }
 
-    // send all 'Answer' replies
+    mSendState.SetQuery(query);
+
+    if (query.IsAnnounceBroadcast())
     {
-        const chip::System::Clock::Timestamp kTimeNow = chip::System::SystemClock().GetMonotonicTimestamp();
+        // Deny listing large amount of data
+        mSendState.MarkWasSent(ResponseItemsSent::kServiceListingData);
+    }
 
-        QueryReplyFilter queryReplyFilter(query);
-        QueryResponderRecordFilter responseFilter;
+    // send all 'Answer' replies
+    const chip::System::Clock::Timestamp kTimeNow = chip::System::SystemClock().GetMonotonicTimestamp();
+
+    QueryReplyFilter queryReplyFilter(*mSendState.GetQuery());
+    QueryResponderRecordFilter responseFilter;
+
+    responseFilter
+        .SetReplyFilter(&queryReplyFilter) //
+        .SetExcludeReportedNow(true);
 
-        responseFilter.SetReplyFilter(&queryReplyFilter);
+    if (!mSendState.SendUnicast())
+    {
+        // According to https://tools.ietf.org/html/rfc6762#section-6  we should multicast at most 1/sec
+        responseFilter.SetIncludeOnlyMulticastBeforeMS(kTimeNow - chip::System::Clock::Seconds32(1),
+                                                       mSendState.GetSourceInterfaceId(), mSendState.GetSourceAddress().Type());
+    }
 
-        if (!mSendState.SendUnicast())
+    // Announce broadcasts match every name, other queries only need the records indexed under the query name
+    const bool lookupByName  = !query.IsAnnounceBroadcast();
+    const uint32_t qnameHash = lookupByName ? HashQName(query.GetName()) : 0;
+
+    for (auto & responder : mResponders)
+    {
+        if (responder == nullptr)
         {
-            // According to https://tools.ietf.org/html/rfc6762#section-6  we should multicast at most 1/sec
-            //
-            // TODO: the 'last sent' value does NOT track the interface we used to send, so this may cause
-            //       broadcasts on one interface to throttle broadcasts on another interface.
-            responseFilter.SetIncludeOnlyMulticastBeforeMS(kTimeNow - chip::System::Clock::Seconds32(1));
+            continue;
         }
-        for (auto & responder : mResponders)
+        auto it = lookupByName ? responder->begin(&responseFilter, qnameHash) : responder->begin(&responseFilter);
+        for (; it != responder->end(); it++)
         {
-            if (responder == nullptr)
+            const size_t addedBefore = mSendState.GetAddedRecords();
+            const size_t knownBefore = mSendState.GetKnownAnswersFound();
+
+            it->responder->AddAllResponses(mSendState.GetSource(), this, mSendState.GetConfiguration());
+            ReturnErrorOnFailure(mSendState.GetError());
+
+            it.GetInternal()->reportedNow = true;
+
+            if ((mSendState.GetAddedRecords() == addedBefore) && (mSendState.GetKnownAnswersFound() != knownBefore))
             {
+                // The querier already knows the answer, so it does not need related data either.
                 continue;
             }
-            for (auto it = responder->begin(&responseFilter); it != responder->end(); it++)
-            {
-                it->responder->AddAllResponses(querySource, this, configuration);
-                ReturnErrorOnFailure(mSendState.GetError());
 
-                responder->MarkAdditionalRepliesFor(it);
+            responder->MarkAdditionalRepliesFor(it);
 
-                if (!mSendState.SendUnicast())
-                {
-                    it->lastMulticastTime = kTimeNow;
-                }
+            if (!mSendState.SendUnicast())
+            {
+                it->multicastThrottle.MarkMulticast(mSendState.GetSourceInterfaceId(), mSendState.GetSourceAddress().Type(),
+                                                    kTimeNow);
             }
         }
     }
 
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ResponseSender::FinishReply()
+{
+    CHIP_ERROR err = mSendState.GetError();
+
+    if (err == CHIP_NO_ERROR)
+    {
+        err = FinishReplyGroup();
+    }
+
+    if ((err != CHIP_NO_ERROR) && mResponseBuilder.HasPacketBuffer())
+    {
+        chip::System::PacketBufferHandle unused = mResponseBuilder.ReleasePacket();
+    }
+
+    return err;
+}
+
+CHIP_ERROR ResponseSender::FinishReplyGroup()
+{
     // send all 'Additional' replies
+    if (mSendState.HasQuery())
     {
-        if (!query.IsAnnounceBroadcast())
+        if (!mSendState.GetQuery()->IsAnnounceBroadcast())
         {
             // Initial service broadcast should keep adding data as 'Answers' rather
             // than addtional data (https://datatracker.ietf.org/doc/html/rfc6762#section-8.3)
             mSendState.SetResourceType(ResourceType::kAdditional);
         }
 
-        QueryReplyFilter queryReplyFilter(query);
+        QueryReplyFilter queryReplyFilter(*mSendState.GetQuery());
 
         queryReplyFilter.SetIgnoreNameMatch(true).SetSendingAdditionalItems(true);
 
         QueryResponderRecordFilter responseFilter;
         responseFilter
-            .SetReplyFilter(&queryReplyFilter) //
-            .SetIncludeAdditionalRepliesOnly(true);
+            .SetReplyFilter(&queryReplyFilter)     //
+            .SetIncludeAdditionalRepliesOnly(true) //
+            .SetExcludeReportedNow(true);
         for (auto & responder : mResponders)
         {
             if (responder == nullptr)
@@ -189,13 +246,34 @@ CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query,
             }
             for (auto it = responder->begin(&responseFilter); it != responder->end(); it++)
             {
-                it->responder->AddAllResponses(querySource, this, configuration);
+                it->responder->AddAllResponses(mSendState.GetSource(), this, mSendState.GetConfiguration());
                 ReturnErrorOnFailure(mSendState.GetError());
+
+                it.GetInternal()->reportedNow = true;
             }
         }
     }
 
-    return FlushReply();
+    ReturnErrorOnFailure(FlushReply());
+
+    mSendState.ResetReplyGroup();
+    ResetResponders();
+
+    return CHIP_NO_ERROR;
+}
+
+void ResponseSender::ResetResponders()
+{
+    // Responder has a stateful 'additional replies required' that is used within the response
+    // loop. 'no additionals required' is set at the start and additionals are marked as the query
+    // reply is built.
+    for (auto & responder : mResponders)
+    {
+        if (responder != nullptr)
+        {
+            responder->ResetAdditionals();
+        }
+    }
 }
 
 CHIP_ERROR ResponseSender::FlushReply()
@@ -288,6 +366,13 @@ void ResponseSender::AddResponse(const ResourceRecord & record)
 {
     ReturnOnFailure(mSendState.GetError());
 
+    if (mSendState.IsKnownAnswer(record))
+    {
+        // Known-answer suppression: https://tools.ietf.org/html/rfc6762#section-7.1
+        mSendState.MarkKnownAnswerFound();
+        return;
+    }
+
     if (!mResponseBuilder.HasPacketBuffer())
     {
         mSendState.SetError(PrepareNewReplyPacket());
@@ -318,8 +403,11 @@ void ResponseSender::AddResponse(const ResourceRecord & record)
             // Very much unexpected: single record addition should fit (our records should not be that big).
             ChipLogError(Discovery, "Failed to add single record to mDNS response.");
             mSendState.SetError(CHIP_ERROR_INTERNAL);
+            return;
         }
     }
+
+    mSendState.MarkRecordAdded();
 }
 
 } // namespace Minimal
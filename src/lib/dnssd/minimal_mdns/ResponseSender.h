@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "KnownAnswers.h"
 #include "Parser.h"
 #include "ResponseBuilder.h"
 #include "Server.h"
@@ -71,13 +72,24 @@ class ResponseSendingState
 public:
     ResponseSendingState() {}
 
-    void Reset(uint16_t messageId, const QueryData & query, const chip::Inet::IPPacketInfo * packet)
+    void Reset(uint16_t messageId, const chip::Inet::IPPacketInfo * packet, const ResponseConfiguration * configuration,
+               const KnownAnswerList * knownAnswers)
     {
-        mMessageId    = messageId;
-        mQuery        = &query;
-        mSource       = packet;
-        mSendError    = CHIP_NO_ERROR;
-        mResourceType = ResourceType::kAnswer;
+        mMessageId     = messageId;
+        mSource        = packet;
+        mConfiguration = configuration;
+        mKnownAnswers  = knownAnswers;
+        mSendError     = CHIP_NO_ERROR;
+        ResetReplyGroup();
+    }
+
+    /// Starts a new group of queries whose answers are sent together (i.e. in the same packets).
+    void ResetReplyGroup()
+    {
+        mHasQuery          = false;
+        mResourceType      = ResourceType::kAnswer;
+        mAddedRecords      = 0;
+        mKnownAnswersFound = 0;
         mSentItems.ClearAll();
     }
 
@@ -93,10 +105,21 @@ public:
 
     uint16_t GetMessageId() const { return mMessageId; }
 
-    const QueryData * GetQuery() const { return mQuery; }
+    void SetQuery(const QueryData & query)
+    {
+        mQuery    = query;
+        mHasQuery = true;
+    }
+    bool HasQuery() const { return mHasQuery; }
+    const QueryData * GetQuery() const { return &mQuery; }
+
+    const ResponseConfiguration & GetConfiguration() const { return *mConfiguration; }
 
     /// Check if the reply should be sent as a unicast reply
-    bool SendUnicast() const;
+    bool SendUnicast() const { return SendUnicast(mQuery); }
+
+    /// Check if the reply to the given query should be sent as a unicast reply
+    bool SendUnicast(const QueryData & query) const;
 
     /// Check if the original query should be included in the reply
     bool IncludeQuery() const;
@@ -110,12 +133,29 @@ public:
     bool GetWasSent(ResponseItemsSent item) const { return mSentItems.Has(item); }
     void MarkWasSent(ResponseItemsSent item) { mSentItems.Set(item); }
 
+    /// Check if the querier listed the given record as a known answer
+    bool IsKnownAnswer(const ResourceRecord & record) const
+    {
+        return (mKnownAnswers != nullptr) && mKnownAnswers->Contains(record);
+    }
+
+    /// Counts of records added to the reply and of records left out as they were known answers
+    size_t GetAddedRecords() const { return mAddedRecords; }
+    void MarkRecordAdded() { mAddedRecords++; }
+    size_t GetKnownAnswersFound() const { return mKnownAnswersFound; }
+    void MarkKnownAnswerFound() { mKnownAnswersFound++; }
+
 private:
-    const QueryData * mQuery                 = nullptr;               // query being replied to
-    const chip::Inet::IPPacketInfo * mSource = nullptr;               // Where to send the reply (if unicast)
-    uint16_t mMessageId                      = 0;                     // message id for the reply
-    ResourceType mResourceType               = ResourceType::kAnswer; // what is being sent right now
-    CHIP_ERROR mSendError                    = CHIP_NO_ERROR;
+    QueryData mQuery;                                                     // query being replied to
+    const chip::Inet::IPPacketInfo * mSource     = nullptr;               // Where to send the reply (if unicast)
+    const ResponseConfiguration * mConfiguration = nullptr;               // how to adjust the sent records
+    const KnownAnswerList * mKnownAnswers        = nullptr;               // records the querier already knows
+    uint16_t mMessageId                          = 0;                     // message id for the reply
+    ResourceType mResourceType                   = ResourceType::kAnswer; // what is being sent right now
+    CHIP_ERROR mSendError                        = CHIP_NO_ERROR;
+    bool mHasQuery                               = false;
+    size_t mAddedRecords                         = 0;
+    size_t mKnownAnswersFound                    = 0;
     chip::BitFlags<ResponseItemsSent> mSentItems;
 };
 
@@ -138,6 +178,20 @@ public:
     CHIP_ERROR Respond(uint16_t messageId, const QueryData & query, const chip::Inet::IPPacketInfo * querySource,
                        const ResponseConfiguration & configuration);
 
+    /// Reply to all the queries of a received packet at once.
+    ///
+    /// Queries are added through AddQueryReply after StartReply and the reply
+    /// is sent by FinishReply. Answers to all the queries share reply packets
+    /// as long as they go to the same destination, and records listed in
+    /// knownAnswers are not sent back (https://tools.ietf.org/html/rfc6762#section-7.1).
+    ///
+    /// querySource, configuration and knownAnswers (as well as the packet the
+    /// queries were parsed from) must remain valid until FinishReply returns.
+    void StartReply(uint16_t messageId, const chip::Inet::IPPacketInfo * querySource, const ResponseConfiguration & configuration,
+                    const KnownAnswerList * knownAnswers = nullptr);
+    CHIP_ERROR AddQueryReply(const QueryData & query);
+    CHIP_ERROR FinishReply();
+
     // Implementation of ResponderDelegate
     void AddResponse(const ResourceRecord & record) override;
     bool ShouldSend(const Responder &) const override;
@@ -146,6 +200,10 @@ public:
     void SetServer(ServerBase * server) { mServer = server; }
 
 private:
+    /// Adds the additional records of the current reply group and sends it out.
+    CHIP_ERROR FinishReplyGroup();
+    void ResetResponders();
+
     CHIP_ERROR FlushReply();
     CHIP_ERROR PrepareNewReplyPacket();
 
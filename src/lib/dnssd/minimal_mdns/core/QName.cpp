@@ -22,6 +22,29 @@
 namespace mdns {
 namespace Minimal {
 
+namespace {
+
+// 32-bit FNV-1a over the lowercased labels, each label followed by a 0 byte
+// so that label boundaries are part of the hash
+constexpr uint32_t kFnvOffsetBasis = 2166136261u;
+constexpr uint32_t kFnvPrime       = 16777619u;
+
+uint32_t HashLabel(uint32_t hash, const char * label)
+{
+    for (; *label != '\0'; label++)
+    {
+        char c = *label;
+        if ((c >= 'A') && (c <= 'Z'))
+        {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+        hash = (hash ^ static_cast<uint8_t>(c)) * kFnvPrime;
+    }
+    return hash * kFnvPrime;
+}
+
+} // namespace
+
 bool SerializedQNameIterator::Next()
 {
     return mIsValid && Next(true);
@@ -210,5 +233,25 @@ bool FullQName::operator==(const FullQName & other) const
     return true;
 }
 
+uint32_t HashQName(const FullQName & name)
+{
+    uint32_t hash = kFnvOffsetBasis;
+    for (size_t i = 0; i < name.nameCount; i++)
+    {
+        hash = HashLabel(hash, name.names[i]);
+    }
+    return hash;
+}
+
+uint32_t HashQName(SerializedQNameIterator name)
+{
+    uint32_t hash = kFnvOffsetBasis;
+    while (name.Next())
+    {
+        hash = HashLabel(hash, name.Value());
+    }
+    return hash;
+}
+
 } // namespace Minimal
 } // namespace mdns
@@ -117,5 +117,13 @@ private:
     bool Next(bool followIndirectPointers);
 };
 
+/// Case-insensitive hash of a QName.
+///
+/// Names that compare equal (comparisons ignore ASCII case) hash to the same
+/// value, so the hash can be used to look up records by name. Different names
+/// may share a hash, so matches still have to be compared.
+uint32_t HashQName(const FullQName & name);
+uint32_t HashQName(SerializedQNameIterator name);
+
 } // namespace Minimal
 } // namespace mdns
@@ -31,6 +31,12 @@ QueryResponderBase::QueryResponderBase(Internal::QueryResponderInfo * infos, siz
     Responder(QType::PTR, FullQName(kDnsSdQueryPath)), mResponderInfos(infos), mResponderInfoSize(infoSizes)
 {}
 
+QueryResponderBase::QueryResponderBase(Internal::QueryResponderInfo * infos, size_t infoSizes,
+                                       Internal::QueryResponderInfo ** nameBuckets, size_t nameBucketCount) :
+    Responder(QType::PTR, FullQName(kDnsSdQueryPath)), mResponderInfos(infos), mResponderInfoSize(infoSizes),
+    mNameBuckets(nameBuckets), mNameBucketCount(nameBucketCount)
+{}
+
 void QueryResponderBase::Init()
 {
     for (size_t i = 0; i < mResponderInfoSize; i++)
@@ -38,10 +44,16 @@ void QueryResponderBase::Init()
         mResponderInfos[i].Clear();
     }
 
+    for (size_t i = 0; i < mNameBucketCount; i++)
+    {
+        mNameBuckets[i] = nullptr;
+    }
+
     if (mResponderInfoSize > 0)
     {
         // reply to queries about services available
         mResponderInfos[0].responder = this;
+        IndexByName(&mResponderInfos[0]);
     }
 
     if (mResponderInfoSize < 2)
@@ -65,6 +77,7 @@ QueryResponderSettings QueryResponderBase::AddResponder(RecordResponder * respon
         {
             mResponderInfos[i].Clear();
             mResponderInfos[i].responder = responder;
+            IndexByName(&mResponderInfos[i]);
 
             return QueryResponderSettings(&mResponderInfos[i]);
         }
@@ -78,27 +91,27 @@ void QueryResponderBase::ResetAdditionals()
     for (size_t i = 0; i < mResponderInfoSize; i++)
     {
         mResponderInfos[i].reportNowAsAdditional = false;
+        mResponderInfos[i].reportedNow           = false;
     }
 }
 
 size_t QueryResponderBase::MarkAdditional(const FullQName & qname)
 {
+    QueryResponderRecordFilter filter;
     size_t count = 0;
-    for (size_t i = 0; i < mResponderInfoSize; i++)
+
+    for (auto it = begin(&filter, HashQName(qname)); it != end(); it++)
     {
-        if (mResponderInfos[i].responder == nullptr)
-        {
-            continue; // not a valid entry
-        }
+        Internal::QueryResponderInfo * info = it.GetInternal();
 
-        if (mResponderInfos[i].reportNowAsAdditional)
+        if (info->reportNowAsAdditional)
         {
             continue; // already marked
         }
 
-        if (mResponderInfos[i].responder->GetQName() == qname)
+        if (info->responder->GetQName() == qname)
         {
-            mResponderInfos[i].reportNowAsAdditional = true;
+            info->reportNowAsAdditional = true;
             count++;
         }
     }
@@ -168,11 +181,31 @@ void QueryResponderBase::AddAllResponses(const chip::Inet::IPPacketInfo * source
     delegate->ResponsesAdded(*this);
 }
 
+void QueryResponderBase::IndexByName(Internal::QueryResponderInfo * info)
+{
+    info->qnameHash        = HashQName(info->responder->GetQName());
+    info->nextInNameBucket = nullptr;
+
+    if (mNameBucketCount == 0)
+    {
+        return;
+    }
+
+    // Appending keeps records of a bucket in the order they were added, so
+    // replies list records in the same order with or without the index
+    Internal::QueryResponderInfo ** slot = &mNameBuckets[info->qnameHash % mNameBucketCount];
+    while (*slot != nullptr)
+    {
+        slot = &(*slot)->nextInNameBucket;
+    }
+    *slot = info;
+}
+
 void QueryResponderBase::ClearBroadcastThrottle()
 {
     for (size_t i = 0; i < mResponderInfoSize; i++)
     {
-        mResponderInfos[i].lastMulticastTime = chip::System::Clock::kZero;
+        mResponderInfos[i].multicastThrottle.Clear();
     }
 }
 
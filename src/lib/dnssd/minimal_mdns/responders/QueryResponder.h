@@ -21,17 +21,85 @@
 #include "ReplyFilter.h"
 #include "Responder.h"
 
+#include <inet/IPAddress.h>
+#include <inet/InetInterface.h>
+#include <lib/core/CHIPConfig.h>
 #include <system/SystemClock.h>
 
 namespace mdns {
 namespace Minimal {
 
+/// Keeps track of when a record was last multicast, separately for every
+/// interface and address type it was multicast on.
+///
+/// Used to rate limit multicast replies (https://tools.ietf.org/html/rfc6762#section-6)
+/// without multicasts on one interface throttling replies on another.
+class MulticastThrottle
+{
+public:
+    /// Checks if the record was multicast on the given interface and address type at or after `since`.
+    bool WasMulticastSince(chip::Inet::InterfaceId interface, chip::Inet::IPAddressType addressType,
+                           chip::System::Clock::Timestamp since) const
+    {
+        for (auto & slot : mSlots)
+        {
+            if ((slot.time > chip::System::Clock::kZero) && (slot.interface == interface) && (slot.addressType == addressType))
+            {
+                return slot.time >= since;
+            }
+        }
+        return false;
+    }
+
+    /// Records a multicast of the record. If all the slots are in use, the least recently used one is reused.
+    void MarkMulticast(chip::Inet::InterfaceId interface, chip::Inet::IPAddressType addressType,
+                       chip::System::Clock::Timestamp now)
+    {
+        Slot * target = &mSlots[0];
+        for (auto & slot : mSlots)
+        {
+            if ((slot.time > chip::System::Clock::kZero) && (slot.interface == interface) && (slot.addressType == addressType))
+            {
+                target = &slot;
+                break;
+            }
+            if (slot.time < target->time)
+            {
+                target = &slot;
+            }
+        }
+
+        target->interface   = interface;
+        target->addressType = addressType;
+        target->time        = now;
+    }
+
+    void Clear()
+    {
+        for (auto & slot : mSlots)
+        {
+            slot.time = chip::System::Clock::kZero;
+        }
+    }
+
+private:
+    struct Slot
+    {
+        chip::Inet::InterfaceId interface     = chip::Inet::InterfaceId::Null();
+        chip::Inet::IPAddressType addressType = chip::Inet::IPAddressType::kAny;
+        chip::System::Clock::Timestamp time   = chip::System::Clock::kZero; // kZero if unused
+    };
+
+    static_assert(CHIP_CONFIG_MINMDNS_MULTICAST_THROTTLE_INTERFACES > 0, "At least one interface has to be tracked");
+    Slot mSlots[CHIP_CONFIG_MINMDNS_MULTICAST_THROTTLE_INTERFACES];
+};
+
 /// Represents available data (replies) for mDNS queries.
 struct QueryResponderRecord
 {
-    Responder * responder                            = nullptr; // what response/data is available
-    bool reportService                               = false;   // report as a service when listing dnssd services
-    chip::System::Clock::Timestamp lastMulticastTime = chip::System::Clock::kZero; // last time this record was multicast
+    Responder * responder = nullptr;     // what response/data is available
+    bool reportService    = false;       // report as a service when listing dnssd services
+    MulticastThrottle multicastThrottle; // when this record was last multicast
 };
 
 namespace Internal {
@@ -40,16 +108,23 @@ namespace Internal {
 struct QueryResponderInfo : public QueryResponderRecord
 {
     bool reportNowAsAdditional; // report as additional data required
+    bool reportedNow = false;   // already part of the reply being built
 
     bool alsoReportAdditionalQName = false; // report more data when this record is listed
     FullQName additionalQName;              // if alsoReportAdditionalQName is set, send this extra data
 
+    uint32_t qnameHash                    = 0;       // HashQName of the responder qname
+    QueryResponderInfo * nextInNameBucket = nullptr; // next record of the same name index bucket
+
     void Clear()
     {
         responder                 = nullptr;
         reportService             = false;
         reportNowAsAdditional     = false;
+        reportedNow               = false;
         alsoReportAdditionalQName = false;
+        qnameHash                 = 0;
+        nextInNameBucket          = nullptr;
     }
 };
 
@@ -120,11 +195,22 @@ public:
         return *this;
     }
 
-    /// Filter out anything that was multicast past ms.
+    /// Filter out anything that was already added to the reply being built.
+    QueryResponderRecordFilter & SetExcludeReportedNow(bool excludeReportedNow)
+    {
+        mExcludeReportedNow = excludeReportedNow;
+        return *this;
+    }
+
+    /// Filter out anything that was multicast past ms on the given interface and address type.
     /// If ms is 0, no filtering is done
-    QueryResponderRecordFilter & SetIncludeOnlyMulticastBeforeMS(chip::System::Clock::Timestamp time)
+    QueryResponderRecordFilter & SetIncludeOnlyMulticastBeforeMS(chip::System::Clock::Timestamp time,
+                                                                chip::Inet::InterfaceId interface,
+                                                                chip::Inet::IPAddressType addressType)
     {
         mIncludeOnlyMulticastBefore = time;
+        mMulticastInterface         = interface;
+        mMulticastAddressType       = addressType;
         return *this;
     }
 
@@ -140,8 +226,13 @@ public:
             return false;
         }
 
+        if (mExcludeReportedNow && record->reportedNow)
+        {
+            return false;
+        }
+
         if ((mIncludeOnlyMulticastBefore > chip::System::Clock::kZero) &&
-            (record->lastMulticastTime >= mIncludeOnlyMulticastBefore))
+            record->multicastThrottle.WasMulticastSince(mMulticastInterface, mMulticastAddressType, mIncludeOnlyMulticastBefore))
         {
             return false;
         }
@@ -156,12 +247,18 @@ public:
 
 private:
     bool mIncludeAdditionalRepliesOnly                         = false;
+    bool mExcludeReportedNow                                   = false;
     ReplyFilter * mReplyFilter                                 = nullptr;
     chip::System::Clock::Timestamp mIncludeOnlyMulticastBefore = chip::System::Clock::kZero;
+    chip::Inet::InterfaceId mMulticastInterface                = chip::Inet::InterfaceId::Null();
+    chip::Inet::IPAddressType mMulticastAddressType            = chip::Inet::IPAddressType::kAny;
 };
 
 /// Iterates over an array of QueryResponderRecord items, providing only 'valid' ones, where
 /// valid is based on the provided filter.
+///
+/// Can alternatively follow a name index bucket, providing only records whose
+/// qname has the given hash.
 class QueryResponderIterator
 {
 public:
@@ -175,12 +272,24 @@ public:
     {
         SkipInvalid();
     }
+    QueryResponderIterator(QueryResponderRecordFilter * recordFilter, Internal::QueryResponderInfo * bucket, uint32_t qnameHash) :
+        mFilter(recordFilter), mCurrent(bucket), mRemaining(0), mFollowNameBucket(true), mQNameHash(qnameHash)
+    {
+        SkipInvalid();
+    }
     QueryResponderIterator(const QueryResponderIterator & other)             = default;
     QueryResponderIterator & operator=(const QueryResponderIterator & other) = default;
 
     QueryResponderIterator & operator++()
     {
-        if (mRemaining != 0)
+        if (mFollowNameBucket)
+        {
+            if (mCurrent != nullptr)
+            {
+                mCurrent = mCurrent->nextInNameBucket;
+            }
+        }
+        else if (mRemaining != 0)
         {
             mCurrent++;
             mRemaining--;
@@ -210,6 +319,15 @@ private:
     /// ensures that if mRemaining is 0, mCurrent is nullptr;
     void SkipInvalid()
     {
+        if (mFollowNameBucket)
+        {
+            while ((mCurrent != nullptr) && ((mCurrent->qnameHash != mQNameHash) || !mFilter->Accept(mCurrent)))
+            {
+                mCurrent = mCurrent->nextInNameBucket;
+            }
+            return;
+        }
+
         while ((mRemaining > 0) && !mFilter->Accept(mCurrent))
         {
             mRemaining--;
@@ -224,6 +342,8 @@ private:
     QueryResponderRecordFilter * mFilter;
     Internal::QueryResponderInfo * mCurrent;
     size_t mRemaining;
+    bool mFollowNameBucket = false;
+    uint32_t mQNameHash    = 0;
 };
 
 /// Responds to mDNS queries.
@@ -239,6 +359,12 @@ class QueryResponderBase : public Responder // "_services._dns-sd._udp.local"
 public:
     /// Builds a new responder with the given storage for the response infos
     QueryResponderBase(Internal::QueryResponderInfo * infos, size_t infoSizes);
+
+    /// Builds a new responder with the given storage for the response infos
+    /// and for an index of the infos by name, used to look up query replies
+    /// without going through every record.
+    QueryResponderBase(Internal::QueryResponderInfo * infos, size_t infoSizes, Internal::QueryResponderInfo ** nameBuckets,
+                       size_t nameBucketCount);
     ~QueryResponderBase() override {}
 
     /// Setup initial settings (clears all infos and sets up dns-sd query replies)
@@ -259,9 +385,22 @@ public:
     {
         return QueryResponderIterator(filter, mResponderInfos, mResponderInfoSize);
     }
+    /// Iterates over the records whose qname has the given HashQName.
+    ///
+    /// Only goes through the records sharing a name index bucket (or through
+    /// all of them if this responder has no name index). The filter still has
+    /// to compare names, as different names may share a hash.
+    QueryResponderIterator begin(QueryResponderRecordFilter * filter, uint32_t qnameHash)
+    {
+        if (mNameBucketCount == 0)
+        {
+            return begin(filter);
+        }
+        return QueryResponderIterator(filter, mNameBuckets[qnameHash % mNameBucketCount], qnameHash);
+    }
     QueryResponderIterator end() { return QueryResponderIterator(); }
 
-    /// Clear any items marked as 'additional'.
+    /// Clear any items marked as 'additional' or as part of the reply being built.
     void ResetAdditionals();
 
     /// Marks queries matching this qname as 'to be additionally reported'
@@ -276,18 +415,25 @@ public:
     void ClearBroadcastThrottle();
 
 private:
+    /// Adds the info to the name index, after the infos already in its bucket
+    void IndexByName(Internal::QueryResponderInfo * info);
+
     Internal::QueryResponderInfo * mResponderInfos;
     size_t mResponderInfoSize;
+    Internal::QueryResponderInfo ** mNameBuckets = nullptr;
+    size_t mNameBucketCount                      = 0;
 };
 
 template <size_t kSize>
 class QueryResponder : public QueryResponderBase
 {
 public:
-    QueryResponder() : QueryResponderBase(mData, kSize) { Init(); }
+    QueryResponder() : QueryResponderBase(mData, kSize, mNameBuckets, kSize) { Init(); }
 
 private:
     Internal::QueryResponderInfo mData[kSize];
+    // One bucket per record keeps buckets short without a dynamic allocation
+    Internal::QueryResponderInfo * mNameBuckets[kSize];
 };
 
 } // namespace Minimal
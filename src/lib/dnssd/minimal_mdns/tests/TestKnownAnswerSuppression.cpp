@@ -0,0 +1,413 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <lib/dnssd/minimal_mdns/KnownAnswers.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <lib/dnssd/minimal_mdns/QueryBuilder.h>
+#include <lib/dnssd/minimal_mdns/ResponseSender.h>
+#include <lib/dnssd/minimal_mdns/core/FlatAllocatedQName.h>
+#include <lib/dnssd/minimal_mdns/responders/Ptr.h>
+#include <lib/dnssd/minimal_mdns/responders/Srv.h>
+#include <lib/dnssd/minimal_mdns/responders/Txt.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
+#include <system/SystemPacketBuffer.h>
+
+namespace {
+
+using namespace chip;
+using namespace mdns::Minimal;
+
+constexpr size_t kMdnsMaxPacketSize = 1024;
+constexpr uint16_t kMdnsPort        = 5353;
+
+const QNamePart kServiceName[] = { "_matter", "_tcp", "local" };
+
+/// Collects every packet sent by the advertisers, standing for the
+/// multicast group all the simulated nodes are members of.
+class SimulatedNetwork : private chip::PoolImpl<ServerBase::EndpointInfo, 0, chip::ObjectPoolMem::kInline,
+                                                ServerBase::EndpointInfoPoolType::Interface>,
+                         public ServerBase
+{
+public:
+    SimulatedNetwork() : ServerBase(*static_cast<ServerBase::EndpointInfoPoolType *>(this)) {}
+
+    CHIP_ERROR DirectSend(System::PacketBufferHandle && data, const Inet::IPAddress & addr, uint16_t port,
+                          Inet::InterfaceId interface) override
+    {
+        return Deliver(std::move(data));
+    }
+
+    CHIP_ERROR BroadcastSend(System::PacketBufferHandle && data, uint16_t port) override { return Deliver(std::move(data)); }
+
+    CHIP_ERROR BroadcastSend(System::PacketBufferHandle && data, uint16_t port, Inet::InterfaceId interface,
+                             Inet::IPAddressType addressType) override
+    {
+        return Deliver(std::move(data));
+    }
+
+    /// Returns the packets sent since the last call.
+    std::vector<std::vector<uint8_t>> TakePackets() { return std::move(mPackets); }
+
+    size_t GetSentCount() const { return mSentCount; }
+
+private:
+    CHIP_ERROR Deliver(System::PacketBufferHandle && data)
+    {
+        mPackets.emplace_back(data->Start(), data->Start() + data->DataLength());
+        mSentCount++;
+        return CHIP_NO_ERROR;
+    }
+
+    std::vector<std::vector<uint8_t>> mPackets;
+    size_t mSentCount = 0;
+};
+
+/// A node advertising an operational instance, replying to queries the way
+/// the minimal mDNS advertiser does.
+class AdvertiserNode : public ParserDelegate
+{
+public:
+    AdvertiserNode(SimulatedNetwork & network, const char * tag) :
+        mInstance(FlatAllocatedQName::Build(mInstanceStorage, tag, "_matter", "_tcp", "local")),
+        mHost(FlatAllocatedQName::Build(mHostStorage, tag, "local")),
+        mTxt(FlatAllocatedQName::Build(mTxtStorage, "SII=5000", "SAI=300")), mPtrResponder(FullQName(kServiceName), mInstance),
+        mSrvResponder(SrvResourceRecord(mInstance, mHost, 5540)), mTxtResponder(TxtResourceRecord(mInstance, mTxt)),
+        mSender(&network)
+    {
+        mQueryResponder.Init();
+        mQueryResponder.AddResponder(&mPtrResponder).SetReportInServiceListing(true).SetReportAdditional(mInstance);
+        mQueryResponder.AddResponder(&mSrvResponder);
+        mQueryResponder.AddResponder(&mTxtResponder);
+        EXPECT_EQ(mSender.AddQueryResponder(&mQueryResponder), CHIP_NO_ERROR);
+    }
+
+    void OnPacket(const BytesRange & packet, const Inet::IPPacketInfo & info)
+    {
+        mKnownAnswers.Reset(packet);
+
+        mReplying = false;
+        ASSERT_TRUE(ParsePacket(packet, this));
+        VerifyOrReturn(mIsQuery);
+
+        mSender.StartReply(mMessageId, &info, mConfiguration, &mKnownAnswers);
+        mReplying = true;
+        ASSERT_TRUE(ParsePacket(packet, this));
+        EXPECT_EQ(mSender.FinishReply(), CHIP_NO_ERROR);
+    }
+
+    void OnHeader(ConstHeaderRef & header) override
+    {
+        mIsQuery   = header.GetFlags().IsQuery();
+        mMessageId = header.GetMessageId();
+    }
+
+    void OnQuery(const QueryData & data) override
+    {
+        if (mReplying)
+        {
+            EXPECT_EQ(mSender.AddQueryReply(data), CHIP_NO_ERROR);
+        }
+    }
+
+    void OnResource(ResourceType type, const ResourceData & data) override
+    {
+        if (!mReplying && mIsQuery && (type == ResourceType::kAnswer))
+        {
+            mKnownAnswers.Add(data);
+        }
+    }
+
+private:
+    uint8_t mInstanceStorage[128];
+    uint8_t mHostStorage[64];
+    uint8_t mTxtStorage[64];
+    FullQName mInstance;
+    FullQName mHost;
+    FullQName mTxt;
+    PtrResponder mPtrResponder;
+    SrvResponder mSrvResponder;
+    TxtResponder mTxtResponder;
+    QueryResponder<10> mQueryResponder;
+    ResponseSender mSender;
+    ResponseConfiguration mConfiguration;
+    KnownAnswerList mKnownAnswers;
+    uint16_t mMessageId = 0;
+    bool mIsQuery       = false;
+    bool mReplying      = false;
+};
+
+/// A node browsing for operational instances, listing the instances it
+/// already knows about as known answers.
+class ResolverNode : public ParserDelegate
+{
+public:
+    System::PacketBufferHandle BuildBrowseQuery(bool listKnownAnswers)
+    {
+        QueryBuilder builder(System::PacketBufferHandle::New(kMdnsMaxPacketSize));
+        // Multicast replies, so that every resolver sees them and replies are rate limited
+        builder.AddQuery(Query(kServiceName).SetType(QType::PTR).SetClass(QClass::IN).SetAnswerViaUnicast(false));
+        if (listKnownAnswers)
+        {
+            mCache.AddKnownAnswers(builder, kServiceName, System::SystemClock().GetMonotonicTimestamp());
+        }
+        EXPECT_TRUE(builder.Ok());
+        return builder.ReleasePacket();
+    }
+
+    void OnPacket(const BytesRange & packet)
+    {
+        mPacket = packet;
+        ParsePacket(packet, this);
+    }
+
+    void OnHeader(ConstHeaderRef & header) override { mIsResponse = !header.GetFlags().IsQuery(); }
+
+    void OnQuery(const QueryData & data) override {}
+
+    void OnResource(ResourceType type, const ResourceData & data) override
+    {
+        if (mIsResponse && (type == ResourceType::kAnswer))
+        {
+            mCache.Record(data, mPacket, System::SystemClock().GetMonotonicTimestamp());
+        }
+    }
+
+    const KnownAnswerCache & GetCache() const { return mCache; }
+
+private:
+    KnownAnswerCache mCache;
+    BytesRange mPacket;
+    bool mIsResponse = false;
+};
+
+Inet::IPPacketInfo MulticastSource(Inet::InterfaceId interface)
+{
+    Inet::IPPacketInfo info;
+    info.Clear();
+    info.SrcPort   = kMdnsPort;
+    info.DestPort  = kMdnsPort;
+    info.Interface = interface;
+    Inet::IPAddress::FromString("fe80::1", info.SrcAddress);
+    return info;
+}
+
+class TestKnownAnswerSuppression : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+
+    void SetUp() override
+    {
+        mRealClock = &System::SystemClock();
+        System::Clock::Internal::SetSystemClockForTesting(&mMockClock);
+        mMockClock.SetMonotonic(System::Clock::Seconds64(1000));
+    }
+
+    void TearDown() override { System::Clock::Internal::SetSystemClockForTesting(mRealClock); }
+
+protected:
+    /// Runs a network of advertisers and resolvers, each resolver sending a
+    /// browse query every simulated second, and returns the number of reply
+    /// packets the advertisers sent.
+    size_t RunBrowseSimulation(bool listKnownAnswers, size_t advertiserCount, size_t resolverCount, unsigned seconds)
+    {
+        SimulatedNetwork network;
+        std::vector<std::unique_ptr<AdvertiserNode>> advertisers;
+        std::vector<std::unique_ptr<ResolverNode>> resolvers(resolverCount);
+        std::vector<std::string> tags;
+
+        for (size_t i = 0; i < advertiserCount; i++)
+        {
+            tags.push_back("node" + std::to_string(i));
+        }
+        for (size_t i = 0; i < advertiserCount; i++)
+        {
+            advertisers.push_back(std::make_unique<AdvertiserNode>(network, tags[i].c_str()));
+        }
+        for (auto & resolver : resolvers)
+        {
+            resolver = std::make_unique<ResolverNode>();
+        }
+
+        const Inet::IPPacketInfo source = MulticastSource(Inet::InterfaceId(1));
+        const auto start                = std::chrono::steady_clock::now();
+
+        for (unsigned second = 0; second < seconds; second++)
+        {
+            for (auto & resolver : resolvers)
+            {
+                System::PacketBufferHandle query = resolver->BuildBrowseQuery(listKnownAnswers);
+                BytesRange queryRange(query->Start(), query->Start() + query->DataLength());
+
+                for (auto & advertiser : advertisers)
+                {
+                    advertiser->OnPacket(queryRange, source);
+                }
+
+                // Replies are multicast, every resolver sees them
+                for (auto & reply : network.TakePackets())
+                {
+                    for (auto & listener : resolvers)
+                    {
+                        listener->OnPacket(BytesRange(reply.data(), reply.data() + reply.size()));
+                    }
+                }
+            }
+            mMockClock.AdvanceMonotonic(System::Clock::Seconds64(1));
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        ChipLogProgress(Discovery, "Known answers %s: %u reply packets for %u queries (%.2f replies/s), %u us",
+                        listKnownAnswers ? "on" : "off", static_cast<unsigned>(network.GetSentCount()),
+                        static_cast<unsigned>(resolverCount * seconds),
+                        static_cast<double>(network.GetSentCount()) / static_cast<double>(seconds),
+                        static_cast<unsigned>(elapsed.count()));
+
+        for (auto & resolver : resolvers)
+        {
+            EXPECT_EQ(resolver->GetCache().Count(), std::min(advertiserCount, KnownAnswerCache::kMaxEntries));
+        }
+
+        return network.GetSentCount();
+    }
+
+    System::Clock::Internal::MockClock mMockClock;
+    System::Clock::ClockBase * mRealClock = nullptr;
+};
+
+TEST_F(TestKnownAnswerSuppression, ReplyRateWithKnownAnswers)
+{
+    constexpr size_t kAdvertisers = 6;
+    constexpr size_t kResolvers   = 4;
+    constexpr unsigned kSeconds   = 10;
+
+    static_assert(kAdvertisers <= CHIP_CONFIG_MINMDNS_MAX_KNOWN_ANSWERS, "All the instances have to fit in a query");
+
+    const size_t withoutKnownAnswers = RunBrowseSimulation(false, kAdvertisers, kResolvers, kSeconds);
+    const size_t withKnownAnswers    = RunBrowseSimulation(true, kAdvertisers, kResolvers, kSeconds);
+
+    // A record multicast on an interface is not multicast there again for a
+    // second, so with one query round per second every advertiser replies
+    // every other second without known answers ...
+    EXPECT_EQ(withoutKnownAnswers, kAdvertisers * kSeconds / 2);
+    // ... and only to the first query with them: PTR records live for 120
+    // seconds, which outlasts the simulation.
+    EXPECT_EQ(withKnownAnswers, kAdvertisers);
+}
+
+TEST_F(TestKnownAnswerSuppression, MulticastThrottleIsPerInterface)
+{
+    SimulatedNetwork network;
+    AdvertiserNode advertiser(network, "node");
+    ResolverNode resolver;
+
+    System::PacketBufferHandle query = resolver.BuildBrowseQuery(false);
+    BytesRange queryRange(query->Start(), query->Start() + query->DataLength());
+
+    advertiser.OnPacket(queryRange, MulticastSource(Inet::InterfaceId(1)));
+    EXPECT_EQ(network.GetSentCount(), 1u);
+
+    // Same interface within a second: throttled
+    advertiser.OnPacket(queryRange, MulticastSource(Inet::InterfaceId(1)));
+    EXPECT_EQ(network.GetSentCount(), 1u);
+
+    // Nodes on another interface did not get the reply yet
+    advertiser.OnPacket(queryRange, MulticastSource(Inet::InterfaceId(2)));
+    EXPECT_EQ(network.GetSentCount(), 2u);
+
+    mMockClock.AdvanceMonotonic(System::Clock::Milliseconds64(1500));
+    advertiser.OnPacket(queryRange, MulticastSource(Inet::InterfaceId(1)));
+    EXPECT_EQ(network.GetSentCount(), 3u);
+}
+
+TEST_F(TestKnownAnswerSuppression, RepliesToQueriesOfAPacketAreAggregated)
+{
+    SimulatedNetwork network;
+    AdvertiserNode advertiser(network, "node");
+
+    const QNamePart instanceName[] = { "node", "_matter", "_tcp", "local" };
+
+    QueryBuilder builder(System::PacketBufferHandle::New(kMdnsMaxPacketSize));
+    builder.AddQuery(Query(kServiceName).SetType(QType::PTR).SetClass(QClass::IN));
+    builder.AddQuery(Query(instanceName).SetType(QType::SRV).SetClass(QClass::IN));
+    builder.AddQuery(Query(instanceName).SetType(QType::TXT).SetClass(QClass::IN));
+    ASSERT_TRUE(builder.Ok());
+
+    System::PacketBufferHandle query = builder.ReleasePacket();
+    advertiser.OnPacket(BytesRange(query->Start(), query->Start() + query->DataLength()), MulticastSource(Inet::InterfaceId(1)));
+
+    auto replies = network.TakePackets();
+    ASSERT_EQ(replies.size(), 1u);
+
+    // PTR, SRV and TXT are answers and are not repeated as additionals
+    ConstHeaderRef header(replies[0].data());
+    EXPECT_EQ(header.GetAnswerCount(), 3u);
+    EXPECT_EQ(header.GetAdditionalCount(), 0u);
+}
+
+TEST_F(TestKnownAnswerSuppression, KnownAnswerTtlMustBeAtLeastHalf)
+{
+    uint8_t instanceStorage[64];
+    FullQName instance = FlatAllocatedQName::Build(instanceStorage, "node", "_matter", "_tcp", "local");
+    PtrResourceRecord record(kServiceName, instance);
+
+    for (uint32_t ttl : { 60u, 59u })
+    {
+        PtrResourceRecord knownAnswer(kServiceName, instance);
+        knownAnswer.SetTtl(ttl);
+
+        QueryBuilder builder(System::PacketBufferHandle::New(kMdnsMaxPacketSize));
+        builder.AddQuery(Query(kServiceName).SetType(QType::PTR).SetClass(QClass::IN));
+        ASSERT_TRUE(builder.AddAnswer(knownAnswer));
+
+        // Queries cannot follow answers
+        builder.AddQuery(Query(instance).SetType(QType::SRV).SetClass(QClass::IN));
+        EXPECT_FALSE(builder.Ok());
+
+        System::PacketBufferHandle packet = builder.ReleasePacket();
+        BytesRange packetRange(packet->Start(), packet->Start() + packet->DataLength());
+
+        struct Collector : public ParserDelegate
+        {
+            KnownAnswerList * list;
+            void OnHeader(ConstHeaderRef & header) override {}
+            void OnQuery(const QueryData & data) override {}
+            void OnResource(ResourceType type, const ResourceData & data) override { EXPECT_TRUE(list->Add(data)); }
+        } collector;
+
+        KnownAnswerList knownAnswers;
+        knownAnswers.Reset(packetRange);
+        collector.list = &knownAnswers;
+        ASSERT_TRUE(ParsePacket(packetRange, &collector));
+        ASSERT_EQ(knownAnswers.Count(), 1u);
+
+        // The default TTL is 120 seconds
+        EXPECT_EQ(knownAnswers.Contains(record), ttl >= 60u);
+    }
+}
+
+} // namespace
@@ -0,0 +1,272 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <lib/dnssd/minimal_mdns/responders/QueryResponder.h>
+
+#include <chrono>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <lib/dnssd/minimal_mdns/QueryReplyFilter.h>
+#include <lib/dnssd/minimal_mdns/ResponseSender.h>
+#include <lib/dnssd/minimal_mdns/core/FlatAllocatedQName.h>
+#include <lib/dnssd/minimal_mdns/core/RecordWriter.h>
+#include <lib/dnssd/minimal_mdns/responders/Ptr.h>
+#include <lib/dnssd/minimal_mdns/responders/Srv.h>
+#include <lib/dnssd/minimal_mdns/responders/Txt.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+namespace {
+
+using namespace chip;
+using namespace mdns::Minimal;
+
+constexpr size_t kInstances = 16;
+// PTR, subtype PTR, SRV and TXT for every instance, plus the dns-sd listing
+constexpr size_t kRecords = 4 * kInstances + 1;
+
+const QNamePart kServiceName[] = { "_matter", "_tcp", "local" };
+
+/// Counts the reply packets instead of sending them.
+class CountingServer : private chip::PoolImpl<ServerBase::EndpointInfo, 0, chip::ObjectPoolMem::kInline,
+                                              ServerBase::EndpointInfoPoolType::Interface>,
+                       public ServerBase
+{
+public:
+    CountingServer() : ServerBase(*static_cast<ServerBase::EndpointInfoPoolType *>(this)) {}
+
+    CHIP_ERROR DirectSend(System::PacketBufferHandle && data, const Inet::IPAddress & addr, uint16_t port,
+                          Inet::InterfaceId interface) override
+    {
+        mSentCount++;
+        return CHIP_NO_ERROR;
+    }
+
+    size_t GetSentCount() const { return mSentCount; }
+
+private:
+    size_t mSentCount = 0;
+};
+
+/// A query responder without a name index, going through all the records
+/// for every query.
+template <size_t kSize>
+class UnindexedQueryResponder : public QueryResponderBase
+{
+public:
+    UnindexedQueryResponder() : QueryResponderBase(mData, kSize) { Init(); }
+
+private:
+    Internal::QueryResponderInfo mData[kSize];
+};
+
+/// The records of an advertiser publishing kInstances operational instances.
+class Records
+{
+public:
+    Records()
+    {
+        for (size_t i = 0; i < kInstances; i++)
+        {
+            Instance & instance = mInstances[i];
+            std::string tag     = "8765432112345" + std::to_string(i);
+
+            instance.instanceName = FlatAllocatedQName::Build(instance.instanceStorage, tag.c_str(), "_matter", "_tcp", "local");
+            instance.subtypeName =
+                FlatAllocatedQName::Build(instance.subtypeStorage, tag.c_str(), "_sub", "_matter", "_tcp", "local");
+            instance.hostName   = FlatAllocatedQName::Build(instance.hostStorage, tag.c_str(), "local");
+            instance.txtEntries = FlatAllocatedQName::Build(instance.txtStorage, "SII=5000", "SAI=300");
+
+            instance.ptr    = std::make_unique<PtrResponder>(kServiceName, instance.instanceName);
+            instance.subPtr = std::make_unique<PtrResponder>(instance.subtypeName, instance.instanceName);
+            instance.srv    = std::make_unique<SrvResponder>(SrvResourceRecord(instance.instanceName, instance.hostName, 5540));
+            instance.txt    = std::make_unique<TxtResponder>(TxtResourceRecord(instance.instanceName, instance.txtEntries));
+        }
+    }
+
+    void AddTo(QueryResponderBase & responder)
+    {
+        responder.Init();
+        for (auto & instance : mInstances)
+        {
+            responder.AddResponder(instance.ptr.get()).SetReportInServiceListing(true).SetReportAdditional(instance.instanceName);
+            responder.AddResponder(instance.subPtr.get()).SetReportAdditional(instance.instanceName);
+            responder.AddResponder(instance.srv.get());
+            responder.AddResponder(instance.txt.get());
+        }
+    }
+
+    const FullQName & InstanceName(size_t i) const { return mInstances[i].instanceName; }
+    const FullQName & SubtypeName(size_t i) const { return mInstances[i].subtypeName; }
+
+private:
+    struct Instance
+    {
+        uint8_t instanceStorage[128];
+        uint8_t subtypeStorage[128];
+        uint8_t hostStorage[64];
+        uint8_t txtStorage[64];
+        FullQName instanceName;
+        FullQName subtypeName;
+        FullQName hostName;
+        FullQName txtEntries;
+        std::unique_ptr<PtrResponder> ptr;
+        std::unique_ptr<PtrResponder> subPtr;
+        std::unique_ptr<SrvResponder> srv;
+        std::unique_ptr<TxtResponder> txt;
+    };
+
+    Instance mInstances[kInstances];
+};
+
+/// A serialized query name, as found in a received packet.
+class SerializedName
+{
+public:
+    SerializedName(const FullQName & name)
+    {
+        Encoding::BigEndian::BufferWriter output(mStorage, sizeof(mStorage));
+        RecordWriter writer(&output);
+        writer.WriteQName(name);
+    }
+
+    QueryData Query(QType type) const
+    {
+        return QueryData(type, QClass::IN, true, mStorage, BytesRange(mStorage, mStorage + sizeof(mStorage)));
+    }
+
+private:
+    uint8_t mStorage[256];
+};
+
+std::set<Responder *> Lookup(QueryResponderBase & responder, const QueryData & query, bool useIndex)
+{
+    QueryReplyFilter replyFilter(query);
+    QueryResponderRecordFilter filter;
+    filter.SetReplyFilter(&replyFilter);
+
+    std::set<Responder *> found;
+    auto it = useIndex ? responder.begin(&filter, HashQName(query.GetName())) : responder.begin(&filter);
+    for (; it != responder.end(); it++)
+    {
+        EXPECT_TRUE(found.insert(it->responder).second);
+    }
+    return found;
+}
+
+class TestResponderLookup : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+};
+
+TEST_F(TestResponderLookup, HashIgnoresCase)
+{
+    const QNamePart lower[] = { "node", "_matter", "_tcp", "local" };
+    const QNamePart mixed[] = { "NoDe", "_MATTER", "_tcp", "Local" };
+    const QNamePart other[] = { "node", "_matterc", "_udp", "local" };
+    const QNamePart split[] = { "node_", "matter", "_tcp", "local" };
+
+    EXPECT_EQ(HashQName(FullQName(lower)), HashQName(FullQName(mixed)));
+    EXPECT_EQ(HashQName(FullQName(lower)), HashQName(SerializedName(FullQName(mixed)).Query(QType::ANY).GetName()));
+    EXPECT_NE(HashQName(FullQName(lower)), HashQName(FullQName(other)));
+    EXPECT_NE(HashQName(FullQName(lower)), HashQName(FullQName(split)));
+}
+
+TEST_F(TestResponderLookup, IndexFindsTheSameRecordsAsAScan)
+{
+    Records records;
+    QueryResponder<kRecords> responder;
+    records.AddTo(responder);
+
+    const QNamePart dnsSdName[] = { "_services", "_dns-sd", "_udp", "local" };
+    std::vector<SerializedName> names;
+    names.emplace_back(FullQName(kServiceName));
+    names.emplace_back(FullQName(dnsSdName));
+    for (size_t i = 0; i < kInstances; i++)
+    {
+        names.emplace_back(records.InstanceName(i));
+        names.emplace_back(records.SubtypeName(i));
+    }
+
+    for (auto & name : names)
+    {
+        for (QType type : { QType::ANY, QType::PTR, QType::SRV, QType::TXT })
+        {
+            QueryData query = name.Query(type);
+            EXPECT_EQ(Lookup(responder, query, true), Lookup(responder, query, false));
+        }
+    }
+
+    // All the instances are listed under the service name
+    EXPECT_EQ(Lookup(responder, names[0].Query(QType::PTR), true).size(), kInstances);
+
+    // Records are found again after the responder is set up again
+    records.AddTo(responder);
+    EXPECT_EQ(Lookup(responder, names[2].Query(QType::ANY), true).size(), 2u);
+}
+
+TEST_F(TestResponderLookup, QueryHandlingBenchmark)
+{
+    constexpr size_t kQueries = 5000;
+
+    Records records;
+    std::vector<SerializedName> names;
+    for (size_t i = 0; i < kInstances; i++)
+    {
+        names.emplace_back(records.InstanceName(i));
+    }
+
+    auto runQueries = [&](QueryResponderBase & responder, const char * label) {
+        CountingServer server;
+        ResponseSender sender(&server);
+        Inet::IPPacketInfo packetInfo;
+        packetInfo.Clear();
+        packetInfo.SrcPort = 5353;
+        EXPECT_EQ(sender.AddQueryResponder(&responder), CHIP_NO_ERROR);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < kQueries; i++)
+        {
+            EXPECT_EQ(sender.Respond(1, names[i % kInstances].Query(QType::SRV), &packetInfo, ResponseConfiguration()),
+                      CHIP_NO_ERROR);
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+        ChipLogProgress(Discovery, "%s: %u records, %u ns per query", label, static_cast<unsigned>(kRecords),
+                        static_cast<unsigned>(elapsed.count() / static_cast<long long>(kQueries)));
+        return server.GetSentCount();
+    };
+
+    UnindexedQueryResponder<kRecords> unindexed;
+    records.AddTo(unindexed);
+    const size_t unindexedReplies = runQueries(unindexed, "Scan");
+
+    QueryResponder<kRecords> indexed;
+    records.AddTo(indexed);
+    const size_t indexedReplies = runQueries(indexed, "Name index");
+
+    EXPECT_EQ(unindexedReplies, kQueries);
+    EXPECT_EQ(indexedReplies, kQueries);
+}
+
+} // namespace
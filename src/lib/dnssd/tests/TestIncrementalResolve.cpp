@@ -306,6 +306,8 @@ TEST(TestIncrementalResolve, TestParseOperational)
     EXPECT_EQ(nodeData.operationalData.peerId,
               PeerId().SetCompressedFabricId(0x1234567898765432LL).SetNodeId(0xABCDEFEDCBAABCDELL));
     EXPECT_FALSE(nodeData.operationalData.hasZeroTTL);
+    // Smallest of the SRV (1s) and AAAA (default 120s) record TTLs
+    EXPECT_EQ(nodeData.operationalData.ttl, std::make_optional(chip::System::Clock::Seconds32(1)));
     EXPECT_EQ(nodeData.resolutionData.numIPs, 1u);
     EXPECT_EQ(nodeData.resolutionData.port, 0x1234);
     EXPECT_FALSE(nodeData.resolutionData.supportsTcp);
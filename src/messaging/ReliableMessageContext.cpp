@@ -41,7 +41,7 @@ using namespace chip::DeviceLayer;
 namespace chip {
 namespace Messaging {
 
-ReliableMessageContext::ReliableMessageContext() : mNextAckTime(0), mPendingPeerAckMessageCounter(0) {}
+ReliableMessageContext::ReliableMessageContext() : mNextAckTime(0), mPendingPeerAckMessageCounter(0), mRetransHeapIndex(0) {}
 
 ExchangeContext * ReliableMessageContext::GetExchangeContext()
 {
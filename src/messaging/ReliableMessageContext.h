@@ -216,6 +216,7 @@ private:
 
     System::Clock::Timestamp mNextAckTime; // Next time for triggering Solo Ack
     uint32_t mPendingPeerAckMessageCounter;
+    uint16_t mRetransHeapIndex; // Position of our retransmission table entry in the ReliableMessageMgr heap, while waiting for ack
 };
 
 inline bool ReliableMessageContext::AutoRequestAck() const
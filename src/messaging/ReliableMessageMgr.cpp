@@ -76,10 +76,10 @@ void ReliableMessageMgr::Shutdown()
     StopTimer();
 
     // Clear the retransmit table
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        mRetransTable.ReleaseObject(entry);
-        return Loop::Continue;
-    });
+    while (mRetransHeapCount > 0)
+    {
+        ReleaseRetransTableEntry(*mRetransHeap[mRetransHeapCount - 1]);
+    }
 
     mSystemLayer = nullptr;
 }
@@ -121,10 +121,13 @@ void ReliableMessageMgr::ExecuteActions()
         }
     });
 
-    // Retransmit / cancel anything in the retrans table whose retrans timeout has expired
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
+    // Retransmit / cancel anything in the retrans table whose retrans timeout has expired, earliest first.  Entries
+    // are rescheduled as they are retransmitted, so bound the work to one pass over the table in case a backoff is zero.
+    for (size_t remaining = mRetransHeapCount; remaining > 0 && mRetransHeapCount > 0; remaining--)
+    {
+        RetransTableEntry * entry = mRetransHeap[0];
         if (entry->nextRetransTime > now)
-            return Loop::Continue;
+            break;
 
         VerifyOrDie(!entry->retainedBuf.IsNull());
 
@@ -160,9 +163,9 @@ void ReliableMessageMgr::ExecuteActions()
             }
 
             // Do not StartTimer, we will schedule the timer at the end of the timer handler.
-            mRetransTable.ReleaseObject(entry);
+            ReleaseRetransTableEntry(*entry);
 
-            return Loop::Continue;
+            continue;
         }
 
         entry->sendCount++;
@@ -173,9 +176,7 @@ void ReliableMessageMgr::ExecuteActions()
 
         CalculateNextRetransTime(*entry);
         SendFromRetransTable(entry);
-
-        return Loop::Continue;
-    });
+    }
 
     TicklessDebugDumpRetransTable("ReliableMessageMgr::ExecuteActions Dumping mRetransTable entries after processing");
 }
@@ -202,6 +203,11 @@ CHIP_ERROR ReliableMessageMgr::AddToRetransTable(ReliableMessageContext * rc, Re
     VerifyOrReturnError(!rc->IsWaitingForAck(), CHIP_ERROR_INCORRECT_STATE);
 
     *rEntry = mRetransTable.CreateObject(rc);
+    if (*rEntry != nullptr && !AddToRetransHeap(**rEntry))
+    {
+        mRetransTable.ReleaseObject(*rEntry);
+        *rEntry = nullptr;
+    }
     if (*rEntry == nullptr)
     {
         ChipLogError(ExchangeManager, "mRetransTable Already Full");
@@ -280,24 +286,20 @@ void ReliableMessageMgr::StartRetransmision(RetransTableEntry * entry)
 
 bool ReliableMessageMgr::CheckAndRemRetransTable(ReliableMessageContext * rc, uint32_t ackMessageCounter)
 {
-    bool removed = false;
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->ec->GetReliableMessageContext() == rc && entry->retainedBuf.GetMessageCounter() == ackMessageCounter)
-        {
-            // Clear the entry from the retransmision table.
-            ClearRetransTable(*entry);
-
-            ChipLogDetail(ExchangeManager,
-                          "Rxd Ack; Removing MessageCounter:" ChipLogFormatMessageCounter
-                          " from Retrans Table on exchange " ChipLogFormatExchange,
-                          ackMessageCounter, ChipLogValueExchange(rc->GetExchangeContext()));
-            removed = true;
-            return Loop::Break;
-        }
-        return Loop::Continue;
-    });
+    // An exchange has at most one message waiting for an ack.
+    VerifyOrReturnValue(rc->IsWaitingForAck(), false);
+
+    RetransTableEntry * entry = mRetransHeap[rc->mRetransHeapIndex];
+    VerifyOrReturnValue(entry->retainedBuf.GetMessageCounter() == ackMessageCounter, false);
+
+    // Clear the entry from the retransmision table.
+    ClearRetransTable(*entry);
 
-    return removed;
+    ChipLogDetail(ExchangeManager,
+                  "Rxd Ack; Removing MessageCounter:" ChipLogFormatMessageCounter
+                  " from Retrans Table on exchange " ChipLogFormatExchange,
+                  ackMessageCounter, ChipLogValueExchange(rc->GetExchangeContext()));
+    return true;
 }
 
 CHIP_ERROR ReliableMessageMgr::SendFromRetransTable(RetransTableEntry * entry)
@@ -356,19 +358,15 @@ CHIP_ERROR ReliableMessageMgr::SendFromRetransTable(RetransTableEntry * entry)
 
 void ReliableMessageMgr::ClearRetransTable(ReliableMessageContext * rc)
 {
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->ec->GetReliableMessageContext() == rc)
-        {
-            ClearRetransTable(*entry);
-            return Loop::Break;
-        }
-        return Loop::Continue;
-    });
+    if (rc->IsWaitingForAck())
+    {
+        ClearRetransTable(*mRetransHeap[rc->mRetransHeapIndex]);
+    }
 }
 
 void ReliableMessageMgr::ClearRetransTable(RetransTableEntry & entry)
 {
-    mRetransTable.ReleaseObject(&entry);
+    ReleaseRetransTableEntry(entry);
     // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
     StartTimer();
 }
@@ -386,13 +384,10 @@ void ReliableMessageMgr::StartTimer()
     });
 
     // When do we need to next wake up for ReliableMessageProtocol retransmit?
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->nextRetransTime < nextWakeTime)
-        {
-            nextWakeTime = entry->nextRetransTime;
-        }
-        return Loop::Continue;
-    });
+    if (mRetransHeapCount > 0 && mRetransHeap[0]->nextRetransTime < nextWakeTime)
+    {
+        nextWakeTime = mRetransHeap[0]->nextRetransTime;
+    }
 
     StopTimer();
 
@@ -481,17 +476,121 @@ void ReliableMessageMgr::CalculateNextRetransTime(RetransTableEntry & entry)
 
     System::Clock::Timeout backoff = ReliableMessageMgr::GetBackoff(baseTimeout, entry.sendCount);
     entry.nextRetransTime          = System::SystemClock().GetMonotonicTimestamp() + backoff;
+    UpdateRetransHeap(entry);
+}
+
+void ReliableMessageMgr::ReleaseRetransTableEntry(RetransTableEntry & entry)
+{
+    RemoveFromRetransHeap(entry);
+    mRetransTable.ReleaseObject(&entry);
 }
 
+uint16_t & ReliableMessageMgr::RetransHeapIndex(RetransTableEntry & entry)
+{
+    return entry.ec->GetReliableMessageContext()->mRetransHeapIndex;
+}
+
+bool ReliableMessageMgr::AddToRetransHeap(RetransTableEntry & entry)
+{
+    if (mRetransHeapCount == mRetransHeapSize)
+    {
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+        VerifyOrReturnValue(GrowRetransHeap(), false);
+#else
+        return false;
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    }
+
+    SiftUpRetransHeap(entry, mRetransHeapCount++);
+    return true;
+}
+
+void ReliableMessageMgr::RemoveFromRetransHeap(RetransTableEntry & entry)
+{
+    const size_t index       = RetransHeapIndex(entry);
+    RetransTableEntry & last = *mRetransHeap[--mRetransHeapCount];
+    if (&last != &entry)
+    {
+        // Move the last entry into the hole, then wherever its deadline belongs.
+        PlaceInRetransHeap(last, index);
+        UpdateRetransHeap(last);
+    }
+}
+
+void ReliableMessageMgr::UpdateRetransHeap(RetransTableEntry & entry)
+{
+    const size_t index = RetransHeapIndex(entry);
+    if (index > 0 && entry.nextRetransTime < mRetransHeap[(index - 1) / 2]->nextRetransTime)
+    {
+        SiftUpRetransHeap(entry, index);
+    }
+    else
+    {
+        SiftDownRetransHeap(entry, index);
+    }
+}
+
+void ReliableMessageMgr::PlaceInRetransHeap(RetransTableEntry & entry, size_t index)
+{
+    mRetransHeap[index]     = &entry;
+    RetransHeapIndex(entry) = static_cast<uint16_t>(index);
+}
+
+void ReliableMessageMgr::SiftUpRetransHeap(RetransTableEntry & entry, size_t index)
+{
+    while (index > 0)
+    {
+        const size_t parent = (index - 1) / 2;
+        if (!(entry.nextRetransTime < mRetransHeap[parent]->nextRetransTime))
+        {
+            break;
+        }
+        PlaceInRetransHeap(*mRetransHeap[parent], index);
+        index = parent;
+    }
+    PlaceInRetransHeap(entry, index);
+}
+
+void ReliableMessageMgr::SiftDownRetransHeap(RetransTableEntry & entry, size_t index)
+{
+    for (size_t child = 2 * index + 1; child < mRetransHeapCount; child = 2 * index + 1)
+    {
+        if (child + 1 < mRetransHeapCount && mRetransHeap[child + 1]->nextRetransTime < mRetransHeap[child]->nextRetransTime)
+        {
+            child++;
+        }
+        if (!(mRetransHeap[child]->nextRetransTime < entry.nextRetransTime))
+        {
+            break;
+        }
+        PlaceInRetransHeap(*mRetransHeap[child], index);
+        index = child;
+    }
+    PlaceInRetransHeap(entry, index);
+}
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+bool ReliableMessageMgr::GrowRetransHeap()
+{
+    // Heap positions are recorded in 16 bits by the exchanges.
+    const size_t newSize = std::min<size_t>(mRetransHeapSize * 2, UINT16_MAX + 1);
+    VerifyOrReturnValue(newSize > mRetransHeapSize, false);
+
+    Platform::ScopedMemoryBuffer<RetransTableEntry *> newHeap;
+    VerifyOrReturnValue(newHeap.Alloc(newSize), false);
+    memcpy(newHeap.Get(), mRetransHeap, mRetransHeapCount * sizeof(RetransTableEntry *));
+
+    mRetransHeapBuffer = std::move(newHeap);
+    mRetransHeap       = mRetransHeapBuffer.Get();
+    mRetransHeapSize   = newSize;
+    return true;
+}
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
 #if CHIP_CONFIG_TEST
 int ReliableMessageMgr::TestGetCountRetransTable()
 {
-    int count = 0;
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        count++;
-        return Loop::Continue;
-    });
-    return count;
+    return static_cast<int>(mRetransHeapCount);
 }
 #endif // CHIP_CONFIG_TEST
 
@@ -30,6 +30,7 @@
 #include <lib/core/Optional.h>
 #include <lib/support/BitFlags.h>
 #include <lib/support/Pool.h>
+#include <lib/support/ScopedBuffer.h>
 #include <messaging/ExchangeContext.h>
 #include <messaging/ReliableMessageProtocolConfig.h>
 #include <system/SystemLayer.h>
@@ -75,7 +76,7 @@ public:
     void Shutdown();
 
     /**
-     * Iterate through active exchange contexts and retrans table entries.  If an
+     * Iterate through active exchange contexts and the due retrans table entries.  If an
      * action needs to be triggered by ReliableMessageProtocol time facilities,
      * execute that action.
      */
@@ -125,8 +126,7 @@ public:
     void StartRetransmision(RetransTableEntry * entry);
 
     /**
-     *  Iterate through active exchange contexts and retrans table entries. Clear the entry matching
-     *  the specified ExchangeContext and the message ID from the retransmision table.
+     *  Clear the entry matching the specified ExchangeContext and the message ID from the retransmision table.
      *
      *  @param[in]    rc                 A pointer to the ExchangeContext object.
      *  @param[in]    ackMessageCounter  The acknowledged message counter of the received packet.
@@ -161,7 +161,7 @@ public:
     void ClearRetransTable(RetransTableEntry & rEntry);
 
     /**
-     * Iterate through active exchange contexts and retrans table entries.
+     * Iterate through active exchange contexts and look at the earliest retransmission.
      * Determine how many ReliableMessageProtocol ticks we need to sleep before we
      * need to physically wake the CPU to perform an action.  Set a timer to go off
      * when we next need to wake the system.
@@ -230,6 +230,23 @@ private:
      */
     void CalculateNextRetransTime(RetransTableEntry & entry);
 
+    /**
+     * Release an entry of the retransmission table, without rescheduling the timer.
+     */
+    void ReleaseRetransTableEntry(RetransTableEntry & entry);
+
+    // The entries of mRetransTable are also kept in a binary min-heap ordered by nextRetransTime, so that the next
+    // retransmission is known without walking the table.  Each exchange waiting for an ack records the position of its
+    // (single) entry in the heap, so that acks and exchange closures find it directly.
+    static uint16_t & RetransHeapIndex(RetransTableEntry & entry);
+    bool AddToRetransHeap(RetransTableEntry & entry);
+    void RemoveFromRetransHeap(RetransTableEntry & entry);
+    // Restore the heap order after the nextRetransTime of an entry changed.
+    void UpdateRetransHeap(RetransTableEntry & entry);
+    void PlaceInRetransHeap(RetransTableEntry & entry, size_t index);
+    void SiftUpRetransHeap(RetransTableEntry & entry, size_t index);
+    void SiftDownRetransHeap(RetransTableEntry & entry, size_t index);
+
     ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & mContextPool;
     chip::System::Layer * mSystemLayer;
 
@@ -248,6 +265,16 @@ private:
     // ReliableMessageProtocol Global tables for timer context
     ObjectPool<RetransTableEntry, CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE> mRetransTable;
 
+    RetransTableEntry * mRetransHeapInline[CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE];
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    // The table itself is not bounded when pools use the heap, in which case the heap grows as needed.
+    bool GrowRetransHeap();
+    Platform::ScopedMemoryBuffer<RetransTableEntry *> mRetransHeapBuffer;
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    RetransTableEntry ** mRetransHeap = mRetransHeapInline;
+    size_t mRetransHeapSize           = CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE;
+    size_t mRetransHeapCount          = 0;
+
     SessionUpdateDelegate * mSessionUpdateDelegate = nullptr;
 
     static System::Clock::Timeout sAdditionalMRPBackoffTime;
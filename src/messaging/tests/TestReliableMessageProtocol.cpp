@@ -49,6 +49,9 @@
 #include "psa/crypto.h"
 #endif
 
+#include <chrono>
+#include <vector>
+
 namespace {
 
 using namespace chip;
@@ -2044,6 +2047,80 @@ TEST_F(TestReliableMessageProtocol, CheckApplicationResponseNeverComes)
     EXPECT_EQ(err, CHIP_NO_ERROR);
 }
 
+/**
+ * Measures the CPU cost of a ReliableMessageProtocol timer tick, and of processing acks, with many reliable messages in
+ * flight.
+ */
+TEST_F(TestReliableMessageProtocol, BenchmarkRetransmitTick)
+{
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    constexpr size_t kInFlightCount = 1000;
+#else
+    constexpr size_t kInFlightCount = CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE;
+#endif
+    constexpr int kTickCount = 1000;
+
+    MockAppDelegate mockSender(*this);
+    ReliableMessageMgr * rm = GetExchangeManager().GetReliableMessageMgr();
+    ASSERT_NE(rm, nullptr);
+
+    // Nothing gets acked, and nothing becomes due for retransmission while measuring.
+    GetSessionBobToAlice()->AsSecureSession()->SetRemoteSessionParameters(ReliableMessageProtocolConfig(60000_ms32, 60000_ms32));
+    auto & loopback             = GetLoopback();
+    loopback.mNumMessagesToDrop = kInFlightCount;
+
+    std::vector<ExchangeContext *> exchanges;
+    for (size_t i = 0; i < kInFlightCount; i++)
+    {
+        ExchangeContext * exchange = NewExchangeToAlice(&mockSender);
+        ASSERT_NE(exchange, nullptr);
+        exchanges.push_back(exchange);
+
+        chip::System::PacketBufferHandle buffer = chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+        ASSERT_FALSE(buffer.IsNull());
+        EXPECT_EQ(exchange->SendMessage(Echo::MsgType::EchoRequest, std::move(buffer), SendMessageFlags::kExpectResponse),
+                  CHIP_NO_ERROR);
+    }
+    DrainAndServiceIO();
+    EXPECT_EQ(rm->TestGetCountRetransTable(), static_cast<int>(kInFlightCount));
+
+    // What ReliableMessageMgr::Timeout does on every wakeup.
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kTickCount; i++)
+    {
+        rm->ExecuteActions();
+        rm->StartTimer();
+    }
+    std::chrono::duration<double, std::micro> tickTime = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(rm->TestGetCountRetransTable(), static_cast<int>(kInFlightCount));
+
+    std::vector<std::pair<ReliableMessageContext *, uint32_t>> pendingAcks;
+    rm->EnumerateRetransTable([&pendingAcks](auto * entry) {
+        pendingAcks.emplace_back(entry->ec->GetReliableMessageContext(), entry->retainedBuf.GetMessageCounter());
+        return Loop::Continue;
+    });
+
+    start = std::chrono::steady_clock::now();
+    for (auto & pendingAck : pendingAcks)
+    {
+        EXPECT_TRUE(rm->CheckAndRemRetransTable(pendingAck.first, pendingAck.second));
+    }
+    std::chrono::duration<double, std::micro> ackTime = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(rm->TestGetCountRetransTable(), 0);
+
+    ChipLogProgress(Test, "%u messages in flight: %.2f us per retransmit tick, %.2f us per ack",
+                    static_cast<unsigned>(kInFlightCount), tickTime.count() / kTickCount,
+                    ackTime.count() / static_cast<double>(pendingAcks.size()));
+
+    for (auto * exchange : exchanges)
+    {
+        exchange->Close();
+    }
+    loopback.mNumMessagesToDrop   = 0;
+    loopback.mDroppedMessageCount = 0;
+    loopback.mSentMessageCount    = 0;
+}
+
 /**
  * TODO: A test that we should have but can't write with the existing
  * infrastructure we have:
@@ -47,6 +47,11 @@ extern "C" int __cxa_atexit(void (*f)(void *), void * p, void * d);
 #define CHIP_CONFIG_SLOW_CRYPTO 0
 #endif // CHIP_CONFIG_SLOW_CRYPTO
 
+// Keep the session keys expanded in per-session cipher contexts, memory is not scarce on Darwin
+#ifndef CHIP_CONFIG_SESSION_CIPHER_CONTEXT_CACHE
+#define CHIP_CONFIG_SESSION_CIPHER_CONTEXT_CACHE 1
+#endif // CHIP_CONFIG_SESSION_CIPHER_CONTEXT_CACHE
+
 // ==================== General Configuration Overrides ====================
 
 #ifndef CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS
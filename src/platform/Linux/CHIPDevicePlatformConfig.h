@@ -54,6 +54,16 @@
 // These are configuration options that are unique to Linux platforms.
 // These can be overridden by the application as needed.
 
+/**
+ * CHIP_DEVICE_CONFIG_LINUX_KVS_LOG
+ *
+ * Store the key-value store in an append-only log (ChipLinuxStorageLog) instead of an INI file which is rewritten as a
+ * whole on every write. Set by the chip_linux_kvs_log build argument.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_KVS_LOG
+#define CHIP_DEVICE_CONFIG_LINUX_KVS_LOG 0
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG
+
 // ========== Platform-specific Configuration Overrides =========
 
 #ifndef CHIP_DEVICE_CONFIG_CHIP_TASK_STACK_SIZE
@@ -0,0 +1,501 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         This file implements an append-only, write-coalescing key-value store.
+ */
+
+#include <platform/Linux/CHIPLinuxStorageLog.h>
+
+#include <lib/core/CHIPEncoding.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/Linux/Crc32.h>
+#include <system/SystemError.h>
+
+#include <algorithm>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <libgen.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+namespace {
+
+// File layout: the magic, then transactions. Every record is
+//   type (1) | key size (2) | value size (4) | key | value | CRC-32 of the preceding fields (4)
+// with integers in little-endian order. A commit record has no key and stores the number of records it commits as value
+// size.
+constexpr uint8_t kMagic[]          = { 'C', 'H', 'I', 'P', 'K', 'V', 'L', '1' };
+constexpr size_t kHeaderSize        = sizeof(kMagic);
+constexpr size_t kRecordHeaderSize  = 1 + 2 + 4;
+constexpr size_t kRecordTrailerSize = 4;
+
+constexpr uint8_t kRecordPut    = 1;
+constexpr uint8_t kRecordDelete = 2;
+constexpr uint8_t kRecordCommit = 3;
+
+// The log is compacted when it is both larger than this and more than twice the size of the live data.
+constexpr size_t kMinCompactionSize = 32 * 1024;
+
+const char kTempSuffix[] = ".tmp";
+
+CHIP_ERROR WriteAll(int fd, const uint8_t * data, size_t size, off_t offset)
+{
+    while (size > 0)
+    {
+        ssize_t written = pwrite(fd, data, size, offset);
+        if (written < 0)
+        {
+            VerifyOrReturnError(errno == EINTR, CHIP_ERROR_POSIX(errno));
+            continue;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+        offset += written;
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ReadAll(int fd, std::vector<uint8_t> & data)
+{
+    struct stat st;
+    VerifyOrReturnError(fstat(fd, &st) == 0, CHIP_ERROR_POSIX(errno));
+
+    data.resize(static_cast<size_t>(st.st_size));
+    size_t done = 0;
+    while (done < data.size())
+    {
+        ssize_t count = pread(fd, data.data() + done, data.size() - done, static_cast<off_t>(done));
+        if (count < 0)
+        {
+            VerifyOrReturnError(errno == EINTR, CHIP_ERROR_POSIX(errno));
+            continue;
+        }
+        VerifyOrReturnError(count > 0, CHIP_ERROR_POSIX(EIO));
+        done += static_cast<size_t>(count);
+    }
+    return CHIP_NO_ERROR;
+}
+
+// Make a rename in the directory of path durable.
+CHIP_ERROR SyncParentDirectory(const std::string & path)
+{
+    std::string copy = path;
+    int fd           = open(dirname(&copy[0]), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    VerifyOrReturnError(fd >= 0, CHIP_ERROR_POSIX(errno));
+    int result = fsync(fd);
+    int error  = errno;
+    close(fd);
+    VerifyOrReturnError(result == 0, CHIP_ERROR_POSIX(error));
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+ChipLinuxStorageLog::~ChipLinuxStorageLog()
+{
+    Shutdown();
+}
+
+size_t ChipLinuxStorageLog::RecordSize(size_t aKeySize, size_t aValueSize)
+{
+    return kRecordHeaderSize + aKeySize + aValueSize + kRecordTrailerSize;
+}
+
+void ChipLinuxStorageLog::AppendRecord(std::vector<uint8_t> & aOut, uint8_t aType, const std::string & aKey,
+                                       const uint8_t * aValue, size_t aValueSize)
+{
+    const size_t start = aOut.size();
+    aOut.resize(start + RecordSize(aKey.size(), aType == kRecordPut ? aValueSize : 0));
+
+    uint8_t * p = &aOut[start];
+    p[0]        = aType;
+    Encoding::LittleEndian::Put16(p + 1, static_cast<uint16_t>(aKey.size()));
+    Encoding::LittleEndian::Put32(p + 3, static_cast<uint32_t>(aValueSize));
+    p += kRecordHeaderSize;
+    memcpy(p, aKey.data(), aKey.size());
+    p += aKey.size();
+    if (aType == kRecordPut && aValueSize > 0)
+    {
+        memcpy(p, aValue, aValueSize);
+        p += aValueSize;
+    }
+    Encoding::LittleEndian::Put32(p, Crc32(&aOut[start], static_cast<size_t>(p - &aOut[start])));
+}
+
+size_t ChipLinuxStorageLog::LiveSize() const
+{
+    return kHeaderSize + mEntriesRecordSize + RecordSize(0, 0);
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Init(const char * logFile)
+{
+    VerifyOrReturnError(logFile != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+
+    ChipLogDetail(DeviceLayer, "ChipLinuxStorageLog::Init: Using KVS log file: %s", logFile);
+    if (mFd >= 0)
+    {
+        ChipLogError(DeviceLayer, "ChipLinuxStorageLog::Init: Attempt to re-initialize with KVS log file: %s", logFile);
+        return CHIP_NO_ERROR;
+    }
+
+    mPath.assign(logFile);
+    mFd = open(logFile, O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_POSIX(errno));
+
+    CHIP_ERROR err = Load();
+    if (err != CHIP_NO_ERROR)
+    {
+        close(mFd);
+        mFd = -1;
+        mEntries.clear();
+        mEntriesRecordSize = 0;
+        return err;
+    }
+
+    // A compaction interrupted before its rename leaves its output behind.
+    unlink((mPath + kTempSuffix).c_str());
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Load()
+{
+    std::vector<uint8_t> log;
+    ReturnErrorOnFailure(ReadAll(mFd, log));
+
+    mStats = Stats();
+
+    // A crash while creating the log may leave a partial magic behind: start over as with a missing file.
+    if (log.size() < kHeaderSize && (log.empty() || memcmp(log.data(), kMagic, log.size()) == 0))
+    {
+        VerifyOrReturnError(ftruncate(mFd, 0) == 0, CHIP_ERROR_POSIX(errno));
+        ReturnErrorOnFailure(WriteAll(mFd, kMagic, kHeaderSize, 0));
+        VerifyOrReturnError(fdatasync(mFd) == 0, CHIP_ERROR_POSIX(errno));
+        mStats.mLogSize = kHeaderSize;
+        return CHIP_NO_ERROR;
+    }
+    if (log.size() < kHeaderSize || memcmp(log.data(), kMagic, kHeaderSize) != 0)
+    {
+        ChipLogError(DeviceLayer, "ChipLinuxStorageLog: %s is not a KVS log", mPath.c_str());
+        return CHIP_ERROR_INTEGRITY_CHECK_FAILED;
+    }
+
+    // Records of the current transaction, applied once its commit record is read.
+    struct PendingRecord
+    {
+        std::string key;
+        bool deleted;
+        Value value;
+    };
+    std::vector<PendingRecord> pending;
+
+    size_t committedEnd = kHeaderSize;
+    size_t offset       = kHeaderSize;
+    while (log.size() - offset >= RecordSize(0, 0))
+    {
+        const uint8_t * record = &log[offset];
+        const uint8_t type     = record[0];
+        const size_t keySize   = Encoding::LittleEndian::Get16(record + 1);
+        const size_t valueSize = Encoding::LittleEndian::Get32(record + 3);
+        const size_t dataSize  = keySize + (type == kRecordPut ? valueSize : 0);
+        if (log.size() - offset - RecordSize(0, 0) < dataSize)
+        {
+            break;
+        }
+        const size_t crcOffset = kRecordHeaderSize + dataSize;
+        if (Encoding::LittleEndian::Get32(record + crcOffset) != Crc32(record, crcOffset))
+        {
+            break;
+        }
+
+        const uint8_t * key = record + kRecordHeaderSize;
+        if (type == kRecordPut || type == kRecordDelete)
+        {
+            pending.push_back({ std::string(reinterpret_cast<const char *>(key), keySize), type == kRecordDelete,
+                                Value(key + keySize, record + crcOffset) });
+        }
+        else if (type != kRecordCommit || keySize != 0 || valueSize != pending.size())
+        {
+            break;
+        }
+        offset += RecordSize(0, dataSize);
+
+        if (type == kRecordCommit)
+        {
+            for (auto & op : pending)
+            {
+                if (op.deleted)
+                {
+                    mEntries.erase(op.key);
+                }
+                else
+                {
+                    mEntries[op.key] = std::move(op.value);
+                }
+            }
+            pending.clear();
+            committedEnd = offset;
+        }
+    }
+
+    mEntriesRecordSize = 0;
+    for (const auto & entry : mEntries)
+    {
+        mEntriesRecordSize += RecordSize(entry.first.size(), entry.second.size());
+    }
+
+    if (committedEnd < log.size())
+    {
+        // Drop the torn transaction, so that the next one is appended right after the last complete one.
+        ChipLogError(DeviceLayer, "ChipLinuxStorageLog: dropping %u bytes of incomplete transaction from %s",
+                     static_cast<unsigned>(log.size() - committedEnd), mPath.c_str());
+        VerifyOrReturnError(ftruncate(mFd, static_cast<off_t>(committedEnd)) == 0, CHIP_ERROR_POSIX(errno));
+        VerifyOrReturnError(fdatasync(mFd) == 0, CHIP_ERROR_POSIX(errno));
+        mStats.mDiscardedSize = log.size() - committedEnd;
+    }
+    mStats.mLogSize = committedEnd;
+    return CHIP_NO_ERROR;
+}
+
+void ChipLinuxStorageLog::Shutdown()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    VerifyOrReturn(mFd >= 0);
+    LogErrorOnFailure(FlushLocked());
+    close(mFd);
+    mFd = -1;
+    mEntries.clear();
+    mDirtyKeys.clear();
+    mEntriesRecordSize = 0;
+    mBatchDepth        = 0;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Read(const char * key, void * buf, size_t bufSize, size_t * readSize, size_t offset)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    auto entry = mEntries.find(key);
+    VerifyOrReturnError(entry != mEntries.end(), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    const Value & value = entry->second;
+    VerifyOrReturnError(offset <= value.size(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    const size_t available = value.size() - offset;
+    const size_t copySize  = std::min(bufSize, available);
+    if (copySize > 0)
+    {
+        VerifyOrReturnError(buf != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+        memcpy(buf, value.data() + offset, copySize);
+    }
+    if (readSize != nullptr)
+    {
+        *readSize = copySize;
+    }
+    return (bufSize < available) ? CHIP_ERROR_BUFFER_TOO_SMALL : CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Write(const char * key, const void * value, size_t valueSize)
+{
+    VerifyOrReturnError(key != nullptr && strlen(key) <= UINT16_MAX, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(value != nullptr || valueSize == 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(valueSize <= UINT32_MAX, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    const uint8_t * bytes = static_cast<const uint8_t *>(value);
+    auto result           = mEntries.emplace(key, Value());
+    Value & stored        = result.first->second;
+    if (!result.second)
+    {
+        mEntriesRecordSize -= RecordSize(result.first->first.size(), stored.size());
+    }
+    stored.assign(bytes, bytes + valueSize);
+    mEntriesRecordSize += RecordSize(result.first->first.size(), valueSize);
+
+    if (!mDirtyKeys.insert(result.first->first).second)
+    {
+        mStats.mCoalescedCount++;
+    }
+    return (mBatchDepth == 0) ? FlushLocked() : CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Delete(const char * key)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    auto entry = mEntries.find(key);
+    VerifyOrReturnError(entry != mEntries.end(), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    mEntriesRecordSize -= RecordSize(entry->first.size(), entry->second.size());
+    if (!mDirtyKeys.insert(entry->first).second)
+    {
+        mStats.mCoalescedCount++;
+    }
+    mEntries.erase(entry);
+
+    return (mBatchDepth == 0) ? FlushLocked() : CHIP_NO_ERROR;
+}
+
+void ChipLinuxStorageLog::BeginBatch()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    mBatchDepth++;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::EndBatch()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mBatchDepth > 0, CHIP_ERROR_INCORRECT_STATE);
+    return (--mBatchDepth == 0) ? FlushLocked() : CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Flush()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    return FlushLocked();
+}
+
+CHIP_ERROR ChipLinuxStorageLog::FlushLocked()
+{
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(!mDirtyKeys.empty(), CHIP_NO_ERROR);
+
+    std::vector<uint8_t> transaction;
+    for (const auto & key : mDirtyKeys)
+    {
+        auto entry = mEntries.find(key);
+        if (entry == mEntries.end())
+        {
+            AppendRecord(transaction, kRecordDelete, key, nullptr, 0);
+        }
+        else
+        {
+            AppendRecord(transaction, kRecordPut, key, entry->second.data(), entry->second.size());
+        }
+    }
+    AppendRecord(transaction, kRecordCommit, std::string(), nullptr, mDirtyKeys.size());
+
+    ReturnErrorOnFailure(AppendAndSync(transaction));
+    mDirtyKeys.clear();
+    mStats.mFlushCount++;
+
+    if (ShouldCompact())
+    {
+        // The transaction is already durable in the current log: a failed compaction only delays reclaiming space.
+        LogErrorOnFailure(Compact());
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::AppendAndSync(const std::vector<uint8_t> & aTransaction)
+{
+    const off_t end = static_cast<off_t>(mStats.mLogSize);
+
+    CHIP_ERROR err = WriteAll(mFd, aTransaction.data(), aTransaction.size(), end);
+    if (err == CHIP_NO_ERROR && fdatasync(mFd) != 0)
+    {
+        err = CHIP_ERROR_POSIX(errno);
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        // Do not leave a partial transaction in front of the next one, which would hide it on the next load.
+        if (ftruncate(mFd, end) != 0)
+        {
+            ChipLogError(DeviceLayer, "ChipLinuxStorageLog: could not roll back %s", mPath.c_str());
+        }
+        return err;
+    }
+
+    mStats.mLogSize += aTransaction.size();
+    return CHIP_NO_ERROR;
+}
+
+bool ChipLinuxStorageLog::ShouldCompact() const
+{
+    return mStats.mLogSize > kMinCompactionSize && mStats.mLogSize > 2 * LiveSize();
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Compact()
+{
+    std::vector<uint8_t> snapshot(kMagic, kMagic + kHeaderSize);
+    snapshot.reserve(LiveSize());
+    for (const auto & entry : mEntries)
+    {
+        AppendRecord(snapshot, kRecordPut, entry.first, entry.second.data(), entry.second.size());
+    }
+    AppendRecord(snapshot, kRecordCommit, std::string(), nullptr, mEntries.size());
+
+    // Write the snapshot next to the log, then atomically replace the log with it. The descriptor stays valid across
+    // the rename, and becomes the descriptor of the log.
+    const std::string tempPath = mPath + kTempSuffix;
+    int fd                     = open(tempPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    VerifyOrReturnError(fd >= 0, CHIP_ERROR_POSIX(errno));
+
+    CHIP_ERROR err = WriteAll(fd, snapshot.data(), snapshot.size(), 0);
+    if (err == CHIP_NO_ERROR && fsync(fd) != 0)
+    {
+        err = CHIP_ERROR_POSIX(errno);
+    }
+    if (err == CHIP_NO_ERROR && rename(tempPath.c_str(), mPath.c_str()) != 0)
+    {
+        err = CHIP_ERROR_POSIX(errno);
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        close(fd);
+        unlink(tempPath.c_str());
+        return err;
+    }
+
+    close(mFd);
+    mFd             = fd;
+    mStats.mLogSize = snapshot.size();
+    mStats.mCompactionCount++;
+
+    // The new log is complete either way, the rename may just not survive a power loss yet.
+    return SyncParentDirectory(mPath);
+}
+
+ChipLinuxStorageLog::Stats ChipLinuxStorageLog::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    Stats stats     = mStats;
+    stats.mLiveSize = LiveSize();
+    return stats;
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
@@ -0,0 +1,146 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         This file defines an append-only, write-coalescing key-value store.
+ *
+ *         Writes are kept in memory and appended to the log file as a single transaction when flushed, followed by one
+ *         fdatasync(). Writing a key several times before a flush only appends its last value. When the log grows much
+ *         larger than the live data, it is compacted into a new file which atomically replaces the old one.
+ *
+ *         A transaction is a sequence of put/delete records followed by a commit record, each protected by a CRC-32.
+ *         On load, the log is replayed up to the last complete transaction: a transaction torn by a crash or power loss
+ *         is discarded as a whole and truncated away.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+class ChipLinuxStorageLog
+{
+public:
+    struct Stats
+    {
+        /// Size of the log file, in bytes.
+        size_t mLogSize = 0;
+        /// Size the log file would have right after a compaction, in bytes.
+        size_t mLiveSize = 0;
+        /// Number of transactions appended to the log.
+        uint32_t mFlushCount = 0;
+        /// Number of writes which replaced a write of the same key not flushed yet.
+        uint32_t mCoalescedCount = 0;
+        /// Number of times the log was compacted.
+        uint32_t mCompactionCount = 0;
+        /// Number of bytes of incomplete or corrupted transactions dropped when loading the log.
+        size_t mDiscardedSize = 0;
+    };
+
+    ChipLinuxStorageLog() = default;
+    ~ChipLinuxStorageLog();
+
+    ChipLinuxStorageLog(const ChipLinuxStorageLog &)             = delete;
+    ChipLinuxStorageLog & operator=(const ChipLinuxStorageLog &) = delete;
+
+    /**
+     * Open the log at logFile, creating it if needed, and replay it. As with ChipLinuxStorage, a store which is
+     * already open ignores the call.
+     *
+     * @retval #CHIP_NO_ERROR On success.
+     * @retval #CHIP_ERROR_INTEGRITY_CHECK_FAILED If logFile exists but is not a key-value store log.
+     * @retval #CHIP_ERROR_POSIX If the log could not be opened, read or repaired.
+     */
+    CHIP_ERROR Init(const char * logFile);
+
+    /**
+     * Flush pending writes, if any, and close the log.
+     */
+    void Shutdown();
+
+    /**
+     * Read the value of key, starting at offset, with the semantics of KeyValueStoreManager::Get().
+     */
+    CHIP_ERROR Read(const char * key, void * buf, size_t bufSize, size_t * readSize, size_t offset);
+
+    CHIP_ERROR Write(const char * key, const void * value, size_t valueSize);
+    CHIP_ERROR Delete(const char * key);
+
+    /**
+     * Start a batch. Until the matching EndBatch(), writes are only applied in memory and are committed together by
+     * the flush ending the outermost batch. Outside of a batch, every write is flushed before returning.
+     */
+    void BeginBatch();
+
+    /**
+     * End a batch, flushing the pending writes if it is the outermost one.
+     */
+    CHIP_ERROR EndBatch();
+
+    /**
+     * Append the pending writes to the log as one transaction and wait for it to reach the disk. If this fails, the
+     * log is rolled back to its last transaction and the writes stay pending.
+     */
+    CHIP_ERROR Flush();
+
+    Stats GetStats();
+
+private:
+    using Value = std::vector<uint8_t>;
+
+    CHIP_ERROR Load();
+    CHIP_ERROR FlushLocked();
+    CHIP_ERROR AppendAndSync(const std::vector<uint8_t> & aTransaction);
+    CHIP_ERROR Compact();
+    bool ShouldCompact() const;
+
+    size_t LiveSize() const;
+
+    static void AppendRecord(std::vector<uint8_t> & aOut, uint8_t aType, const std::string & aKey, const uint8_t * aValue,
+                             size_t aValueSize);
+    static size_t RecordSize(size_t aKeySize, size_t aValueSize);
+
+    std::mutex mLock;
+    std::string mPath;
+    int mFd = -1;
+
+    std::map<std::string, Value> mEntries;
+    // Keys written since the last flush; a key missing from mEntries was deleted.
+    std::set<std::string> mDirtyKeys;
+    // Sum of the record sizes of mEntries, kept up to date to decide when to compact.
+    size_t mEntriesRecordSize = 0;
+    unsigned mBatchDepth      = 0;
+
+    Stats mStats;
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
@@ -46,6 +46,11 @@ using CHIP_CONFIG_PERSISTED_STORAGE_KEY_TYPE = const char *;
 #define CHIP_CONFIG_SLOW_CRYPTO 0
 #endif // CHIP_CONFIG_SLOW_CRYPTO
 
+// Keep the session keys expanded in per-session cipher contexts, memory is not scarce on Linux
+#ifndef CHIP_CONFIG_SESSION_CIPHER_CONTEXT_CACHE
+#define CHIP_CONFIG_SESSION_CIPHER_CONTEXT_CACHE 1
+#endif // CHIP_CONFIG_SESSION_CIPHER_CONTEXT_CACHE
+
 // ==================== General Configuration Overrides ====================
 
 #ifndef CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS
@@ -64,6 +69,10 @@ using CHIP_CONFIG_PERSISTED_STORAGE_KEY_TYPE = const char *;
 #define CHIP_CONFIG_BDX_MAX_NUM_TRANSFERS 1
 #endif // CHIP_CONFIG_BDX_MAX_NUM_TRANSFERS
 
+#ifndef CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX
+#define CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX 1
+#endif // CHIP_CONFIG_ENABLE_ATTRIBUTE_STORAGE_INDEX
+
 // ==================== Security Configuration Overrides ====================
 
 #ifndef CHIP_CONFIG_KVS_PATH
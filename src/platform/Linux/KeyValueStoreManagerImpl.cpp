@@ -36,6 +36,43 @@ namespace PersistedStorage {
 
 KeyValueStoreManagerImpl KeyValueStoreManagerImpl::sInstance;
 
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_LOG
+
+CHIP_ERROR KeyValueStoreManagerImpl::_Get(const char * key, void * value, size_t value_size, size_t * read_bytes_size,
+                                          size_t offset_bytes)
+{
+    VerifyOrReturnError(value != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    return mStorage.Read(key, value, value_size, read_bytes_size, offset_bytes);
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::_Put(const char * key, const void * value, size_t value_size)
+{
+    return mStorage.Write(key, value, value_size);
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::_Delete(const char * key)
+{
+    return mStorage.Delete(key);
+}
+
+void KeyValueStoreManagerImpl::BeginBatch()
+{
+    mStorage.BeginBatch();
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::EndBatch()
+{
+    return mStorage.EndBatch();
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::Flush()
+{
+    return mStorage.Flush();
+}
+
+#else // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG
+
 CHIP_ERROR KeyValueStoreManagerImpl::_Get(const char * key, void * value, size_t value_size, size_t * read_bytes_size,
                                           size_t offset_bytes)
 {
@@ -84,7 +121,7 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Put(const char * key, const void * value,
     SuccessOrExit(err);
 
     // Commit the value to the persistent store.
-    err = mStorage.Commit();
+    err = CommitUnlessBatching();
     SuccessOrExit(err);
 
 exit:
@@ -103,13 +140,44 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Delete(const char * key)
     SuccessOrExit(err);
 
     // Commit the value to the persistent store.
-    err = mStorage.Commit();
+    err = CommitUnlessBatching();
     SuccessOrExit(err);
 
 exit:
     return err;
 }
 
+CHIP_ERROR KeyValueStoreManagerImpl::CommitUnlessBatching()
+{
+    if (mBatchDepth > 0)
+    {
+        mBatchDirty = true;
+        return CHIP_NO_ERROR;
+    }
+    return mStorage.Commit();
+}
+
+void KeyValueStoreManagerImpl::BeginBatch()
+{
+    mBatchDepth++;
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::EndBatch()
+{
+    VerifyOrReturnError(mBatchDepth > 0, CHIP_ERROR_INCORRECT_STATE);
+    return (--mBatchDepth == 0) ? Flush() : CHIP_NO_ERROR;
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::Flush()
+{
+    VerifyOrReturnError(mBatchDirty, CHIP_NO_ERROR);
+    ReturnErrorOnFailure(mStorage.Commit());
+    mBatchDirty = false;
+    return CHIP_NO_ERROR;
+}
+
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG
+
 } // namespace PersistedStorage
 } // namespace DeviceLayer
 } // namespace chip
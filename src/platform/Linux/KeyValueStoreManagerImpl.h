@@ -23,7 +23,9 @@
 
 #pragma once
 
+#include <platform/CHIPDeviceConfig.h>
 #include <platform/Linux/CHIPLinuxStorage.h>
+#include <platform/Linux/CHIPLinuxStorageLog.h>
 
 namespace chip {
 namespace DeviceLayer {
@@ -42,8 +44,36 @@ public:
     CHIP_ERROR _Delete(const char * key);
     CHIP_ERROR _Put(const char * key, const void * value, size_t value_size);
 
+    /**
+     * @brief
+     * Start a batch of writes. Until the matching EndBatch(), writes are visible to reads but only committed to the
+     * persistent store by the outermost EndBatch() or by Flush(), and a key written several times is only stored once.
+     * Batches may be nested.
+     */
+    void BeginBatch();
+
+    /**
+     * @brief
+     * End a batch of writes, committing them if it is the outermost batch.
+     */
+    CHIP_ERROR EndBatch();
+
+    /**
+     * @brief
+     * Commit the writes of the current batch, if any, to the persistent store.
+     */
+    CHIP_ERROR Flush();
+
 private:
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_LOG
+    DeviceLayer::Internal::ChipLinuxStorageLog mStorage;
+#else
     DeviceLayer::Internal::ChipLinuxStorage mStorage;
+    unsigned mBatchDepth = 0;
+    bool mBatchDirty     = false;
+
+    CHIP_ERROR CommitUnlessBatching();
+#endif
 
     // ===== Members for internal use by the following friends.
     friend KeyValueStoreManager & KeyValueStoreMgr();
@@ -0,0 +1,430 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         This file implements a file-backed EventLogStore made of memory-mapped log segments.
+ */
+
+#include <platform/Linux/MmapEventLogStore.h>
+
+#include <lib/core/CHIPEncoding.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/Linux/Crc32.h>
+#include <system/SystemError.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace chip {
+namespace DeviceLayer {
+
+using app::EventIndexEntry;
+
+namespace {
+
+// Segment layout: a header made of the magic and the segment size (4), padded to kSegmentHeaderSize, then records. Every
+// record is
+//   TLV size (4) | CRC-32 (4) | event number (8) | cluster id (4) | endpoint id (2) | fabric index (1) | flags (1) | TLV
+// padded to a multiple of 8 bytes, with integers in little-endian order. The CRC-32 covers the record from the event
+// number to the end of the TLV. The TLV size is written last, and a zero TLV size marks the end of the segment.
+constexpr uint8_t kMagic[]          = { 'C', 'H', 'I', 'P', 'E', 'V', 'L', '1' };
+constexpr size_t kSegmentHeaderSize = 16;
+constexpr size_t kRecordHeaderSize  = 24;
+constexpr size_t kRecordAlignment   = 8;
+
+constexpr size_t kSizeOffset        = 0;
+constexpr size_t kCrcOffset         = 4;
+constexpr size_t kEventNumberOffset = 8;
+constexpr size_t kClusterIdOffset   = 16;
+constexpr size_t kEndpointIdOffset  = 20;
+constexpr size_t kFabricIndexOffset = 22;
+constexpr size_t kFlagsOffset       = 23;
+
+constexpr uint8_t kFlagHasFabricIndex = 0x01;
+
+// Segment files are named after the number of their first event, so that sorting the names sorts the segments.
+constexpr char kSegmentNameFormat[] = "events-%016" PRIX64 ".log";
+constexpr size_t kSegmentNameLength = sizeof("events-0123456789ABCDEF.log") - 1;
+
+size_t RecordSize(size_t aEventSize)
+{
+    return (kRecordHeaderSize + aEventSize + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+}
+
+uint32_t RecordCrc(const uint8_t * aRecord, size_t aEventSize)
+{
+    return DeviceLayer::Internal::Crc32(aRecord + kEventNumberOffset, kRecordHeaderSize - kEventNumberOffset + aEventSize);
+}
+
+bool ParseSegmentName(const char * aName, EventNumber & aFirstEventNumber)
+{
+    VerifyOrReturnValue(strlen(aName) == kSegmentNameLength, false);
+    char name[kSegmentNameLength + 1];
+    VerifyOrReturnValue(sscanf(aName, "events-%16" SCNx64 ".log", &aFirstEventNumber) == 1, false);
+    snprintf(name, sizeof(name), kSegmentNameFormat, aFirstEventNumber);
+    return strcmp(name, aName) == 0;
+}
+
+} // namespace
+
+MmapEventLogStore::~MmapEventLogStore()
+{
+    Shutdown();
+}
+
+CHIP_ERROR MmapEventLogStore::Init(const char * aDirectory, size_t aSegmentSize, size_t aMaxSegments)
+{
+    VerifyOrReturnError(mDirectory.empty(), CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(aDirectory != nullptr && aDirectory[0] != '\0', CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aSegmentSize >= kSegmentHeaderSize + RecordSize(1) && aSegmentSize <= UINT32_MAX,
+                        CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aMaxSegments >= 2, CHIP_ERROR_INVALID_ARGUMENT);
+
+    VerifyOrReturnError(mkdir(aDirectory, 0700) == 0 || errno == EEXIST, CHIP_ERROR_POSIX(errno));
+    DIR * dir = opendir(aDirectory);
+    VerifyOrReturnError(dir != nullptr, CHIP_ERROR_POSIX(errno));
+
+    std::vector<std::string> names;
+    for (struct dirent * dirEntry = readdir(dir); dirEntry != nullptr; dirEntry = readdir(dir))
+    {
+        EventNumber firstEventNumber;
+        if (ParseSegmentName(dirEntry->d_name, firstEventNumber))
+        {
+            names.push_back(dirEntry->d_name);
+        }
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+
+    mDirectory     = aDirectory;
+    mSegmentSize   = aSegmentSize;
+    mMaxSegments   = aMaxSegments;
+    mDiscardedSize = 0;
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    for (const std::string & name : names)
+    {
+        Segment segment;
+        err = LoadSegment(mDirectory + "/" + name, segment);
+        // The segment may have been mapped before loading it failed.
+        VerifyOrExit(err == CHIP_NO_ERROR, UnmapSegment(segment));
+
+        if (segment.mIndex.empty())
+        {
+            // Nothing worth keeping: an empty or invalid segment.
+            unlink(segment.mPath.c_str());
+            UnmapSegment(segment);
+            continue;
+        }
+        if (!mSegments.empty() && segment.mIndex.front().mEventNumber <= mSegments.back().mIndex.back().mEventNumber)
+        {
+            // Event numbers restarted while writing this segment: only the newest events can be kept.
+            DropAllSegments();
+        }
+        mSegments.push_back(std::move(segment));
+    }
+
+    while (mSegments.size() > mMaxSegments)
+    {
+        DropOldestSegment();
+    }
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "Failed to open event log store %s: %" CHIP_ERROR_FORMAT, aDirectory, err.Format());
+        Shutdown();
+    }
+    return err;
+}
+
+void MmapEventLogStore::Shutdown()
+{
+    for (Segment & segment : mSegments)
+    {
+        if (msync(segment.mpData, segment.mSize, MS_SYNC) != 0)
+        {
+            ChipLogError(DeviceLayer, "Failed to sync event log segment %s: %s", segment.mPath.c_str(), strerror(errno));
+        }
+        UnmapSegment(segment);
+    }
+    mSegments.clear();
+    mDirectory.clear();
+}
+
+CHIP_ERROR MmapEventLogStore::Append(const EventIndexEntry & aEntry, const ByteSpan & aEvent)
+{
+    VerifyOrReturnError(!mDirectory.empty(), CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(!aEvent.empty(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    const size_t recordSize = RecordSize(aEvent.size());
+    VerifyOrReturnError(kSegmentHeaderSize + recordSize <= mSegmentSize, CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    if (!mSegments.empty() && aEntry.mEventNumber <= mSegments.back().mIndex.back().mEventNumber)
+    {
+        ChipLogProgress(DeviceLayer, "Event numbers restarted at 0x" ChipLogFormatX64 ", clearing the event log store",
+                        ChipLogValueX64(aEntry.mEventNumber));
+        DropAllSegments();
+    }
+
+    if (mSegments.empty() || mSegments.back().mUsed + recordSize > mSegments.back().mSize)
+    {
+        ReturnErrorOnFailure(CreateSegment(aEntry.mEventNumber));
+    }
+
+    Segment & segment   = mSegments.back();
+    uint8_t * record    = segment.mpData + segment.mUsed;
+    const uint8_t flags = aEntry.mHasFabricIndex ? kFlagHasFabricIndex : 0;
+
+    Encoding::LittleEndian::Put64(record + kEventNumberOffset, aEntry.mEventNumber);
+    Encoding::LittleEndian::Put32(record + kClusterIdOffset, aEntry.mClusterId);
+    Encoding::LittleEndian::Put16(record + kEndpointIdOffset, aEntry.mEndpointId);
+    record[kFabricIndexOffset] = aEntry.mFabricIndex;
+    record[kFlagsOffset]       = flags;
+    memcpy(record + kRecordHeaderSize, aEvent.data(), aEvent.size());
+    memset(record + kRecordHeaderSize + aEvent.size(), 0, recordSize - kRecordHeaderSize - aEvent.size());
+    Encoding::LittleEndian::Put32(record + kCrcOffset, RecordCrc(record, aEvent.size()));
+    // Only make the record visible once it is complete.
+    std::atomic_thread_fence(std::memory_order_release);
+    Encoding::LittleEndian::Put32(record + kSizeOffset, static_cast<uint32_t>(aEvent.size()));
+
+    EventIndexEntry entry = aEntry;
+    entry.mOffset         = static_cast<uint32_t>(segment.mUsed);
+    entry.mLength         = static_cast<uint32_t>(aEvent.size());
+    segment.mIndex.push_back(entry);
+    segment.mUsed += recordSize;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MmapEventLogStore::ForEachEventSince(EventNumber aEventNumber, Visitor & aVisitor)
+{
+    for (const Segment & segment : mSegments)
+    {
+        if (segment.mIndex.back().mEventNumber < aEventNumber)
+        {
+            continue;
+        }
+
+        auto it = std::lower_bound(
+            segment.mIndex.begin(), segment.mIndex.end(), aEventNumber,
+            [](const EventIndexEntry & entry, EventNumber eventNumber) { return entry.mEventNumber < eventNumber; });
+        for (; it != segment.mIndex.end(); ++it)
+        {
+            ReturnErrorOnFailure(aVisitor.OnEvent(*it, ByteSpan(segment.mpData + it->mOffset + kRecordHeaderSize, it->mLength)));
+        }
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MmapEventLogStore::RemoveFabric(FabricIndex aFabricIndex)
+{
+    for (Segment & segment : mSegments)
+    {
+        for (EventIndexEntry & entry : segment.mIndex)
+        {
+            if (entry.mHasFabricIndex && entry.mFabricIndex == aFabricIndex)
+            {
+                uint8_t * record           = segment.mpData + entry.mOffset;
+                entry.mFabricIndex         = kUndefinedFabricIndex;
+                record[kFabricIndexOffset] = kUndefinedFabricIndex;
+                Encoding::LittleEndian::Put32(record + kCrcOffset, RecordCrc(record, entry.mLength));
+            }
+        }
+    }
+    return CHIP_NO_ERROR;
+}
+
+MmapEventLogStore::Stats MmapEventLogStore::GetStats() const
+{
+    Stats stats;
+    stats.mSegmentCount  = mSegments.size();
+    stats.mDiscardedSize = mDiscardedSize;
+    for (const Segment & segment : mSegments)
+    {
+        stats.mEventCount += segment.mIndex.size();
+        stats.mDiskSize += segment.mSize;
+    }
+    return stats;
+}
+
+CHIP_ERROR MmapEventLogStore::LoadSegment(const std::string & aPath, Segment & aSegment)
+{
+    ReturnErrorOnFailure(MapSegment(aPath, false /* aCreate */, 0, aSegment));
+
+    const uint8_t * data = aSegment.mpData;
+    if (aSegment.mSize < kSegmentHeaderSize || memcmp(data, kMagic, sizeof(kMagic)) != 0 ||
+        Encoding::LittleEndian::Get32(data + sizeof(kMagic)) != aSegment.mSize)
+    {
+        // Not a segment, or one whose creation was interrupted: leave it without events so that it is dropped.
+        ChipLogError(DeviceLayer, "Discarding invalid event log segment %s", aPath.c_str());
+        return CHIP_NO_ERROR;
+    }
+
+    size_t offset = kSegmentHeaderSize;
+    while (offset + kRecordHeaderSize <= aSegment.mSize)
+    {
+        const uint8_t * record = data + offset;
+        const uint32_t size    = Encoding::LittleEndian::Get32(record + kSizeOffset);
+        if (size == 0)
+        {
+            break;
+        }
+
+        EventIndexEntry entry;
+        entry.mEventNumber = Encoding::LittleEndian::Get64(record + kEventNumberOffset);
+        if (size > aSegment.mSize - offset - kRecordHeaderSize ||
+            Encoding::LittleEndian::Get32(record + kCrcOffset) != RecordCrc(record, size) ||
+            (!aSegment.mIndex.empty() && entry.mEventNumber <= aSegment.mIndex.back().mEventNumber))
+        {
+            break;
+        }
+
+        entry.mOffset         = static_cast<uint32_t>(offset);
+        entry.mLength         = size;
+        entry.mClusterId      = Encoding::LittleEndian::Get32(record + kClusterIdOffset);
+        entry.mEndpointId     = Encoding::LittleEndian::Get16(record + kEndpointIdOffset);
+        entry.mFabricIndex    = record[kFabricIndexOffset];
+        entry.mHasFabricIndex = (record[kFlagsOffset] & kFlagHasFabricIndex) != 0;
+        aSegment.mIndex.push_back(entry);
+        offset += RecordSize(size);
+    }
+    aSegment.mUsed = offset;
+
+    // Erase whatever follows the last valid record, so that the next record appended to the segment is not followed by the
+    // remains of a torn one.
+    const uint8_t * end = std::find_if(data + offset, data + aSegment.mSize, [](uint8_t byte) { return byte != 0; });
+    if (end != data + aSegment.mSize)
+    {
+        const uint8_t * last =
+            std::find_if(std::make_reverse_iterator(data + aSegment.mSize), std::make_reverse_iterator(end), [](uint8_t byte) {
+                return byte != 0;
+            }).base();
+        mDiscardedSize += static_cast<size_t>(last - (data + offset));
+        ChipLogError(DeviceLayer, "Erasing %u bytes of incomplete or corrupted events from %s",
+                     static_cast<unsigned>(last - (data + offset)), aPath.c_str());
+        memset(aSegment.mpData + offset, 0, aSegment.mSize - offset);
+        VerifyOrReturnError(msync(aSegment.mpData, aSegment.mSize, MS_SYNC) == 0, CHIP_ERROR_POSIX(errno));
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MmapEventLogStore::CreateSegment(EventNumber aFirstEventNumber)
+{
+    char name[kSegmentNameLength + 1];
+    snprintf(name, sizeof(name), kSegmentNameFormat, aFirstEventNumber);
+
+    Segment segment;
+    ReturnErrorOnFailure(MapSegment(mDirectory + "/" + name, true /* aCreate */, mSegmentSize, segment));
+    memcpy(segment.mpData, kMagic, sizeof(kMagic));
+    Encoding::LittleEndian::Put32(segment.mpData + sizeof(kMagic), static_cast<uint32_t>(mSegmentSize));
+    segment.mUsed = kSegmentHeaderSize;
+
+    // The previous segment is complete: start writing it back to its file.
+    if (!mSegments.empty() && msync(mSegments.back().mpData, mSegments.back().mSize, MS_ASYNC) != 0)
+    {
+        ChipLogError(DeviceLayer, "Failed to sync event log segment %s: %s", mSegments.back().mPath.c_str(), strerror(errno));
+    }
+
+    // Only drop the oldest events once the new segment is there to take their place.
+    if (mSegments.size() >= mMaxSegments)
+    {
+        DropOldestSegment();
+    }
+    mSegments.push_back(std::move(segment));
+    return CHIP_NO_ERROR;
+}
+
+void MmapEventLogStore::DropOldestSegment()
+{
+    Segment & segment = mSegments.front();
+    unlink(segment.mPath.c_str());
+    UnmapSegment(segment);
+    mSegments.pop_front();
+}
+
+void MmapEventLogStore::DropAllSegments()
+{
+    while (!mSegments.empty())
+    {
+        DropOldestSegment();
+    }
+}
+
+CHIP_ERROR MmapEventLogStore::MapSegment(const std::string & aPath, bool aCreate, size_t aSize, Segment & aSegment)
+{
+    const int fd = open(aPath.c_str(), O_RDWR | O_CLOEXEC | (aCreate ? (O_CREAT | O_TRUNC) : 0), 0600);
+    VerifyOrReturnError(fd >= 0, CHIP_ERROR_POSIX(errno));
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    void * data    = MAP_FAILED;
+    if (aCreate)
+    {
+        VerifyOrExit(ftruncate(fd, static_cast<off_t>(aSize)) == 0, err = CHIP_ERROR_POSIX(errno));
+    }
+    else
+    {
+        struct stat st;
+        VerifyOrExit(fstat(fd, &st) == 0, err = CHIP_ERROR_POSIX(errno));
+        aSize = static_cast<size_t>(st.st_size);
+    }
+
+    if (aSize > 0)
+    {
+        data = mmap(nullptr, aSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        VerifyOrExit(data != MAP_FAILED, err = CHIP_ERROR_POSIX(errno));
+    }
+
+    aSegment.mPath  = aPath;
+    aSegment.mpData = (data == MAP_FAILED) ? nullptr : static_cast<uint8_t *>(data);
+    aSegment.mSize  = aSize;
+    aSegment.mUsed  = 0;
+    aSegment.mIndex.clear();
+
+exit:
+    close(fd);
+    if (err != CHIP_NO_ERROR && aCreate)
+    {
+        unlink(aPath.c_str());
+    }
+    return err;
+}
+
+void MmapEventLogStore::UnmapSegment(Segment & aSegment)
+{
+    if (aSegment.mpData != nullptr)
+    {
+        munmap(aSegment.mpData, aSegment.mSize);
+    }
+    aSegment.mpData = nullptr;
+    aSegment.mSize  = 0;
+    aSegment.mIndex.clear();
+}
+
+} // namespace DeviceLayer
+} // namespace chip
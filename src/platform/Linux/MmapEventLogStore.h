@@ -0,0 +1,124 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         This file defines a file-backed EventLogStore made of memory-mapped log segments.
+ *
+ *         Events are appended to fixed-size segment files, mapped into memory, in a directory of their own. When the
+ *         current segment is full a new one is started, and once there are more segments than allowed the oldest one is
+ *         deleted, which bounds the disk usage. Every segment keeps an in-memory index of the event numbers it holds, so
+ *         that catching up from a given event number seeks straight to it.
+ *
+ *         Every record is protected by a CRC-32 and its length is written last. When the store is opened, a segment is
+ *         replayed up to its first incomplete or corrupted record, and whatever follows that record is erased.
+ */
+
+#pragma once
+
+#include <app/EventLogStore.h>
+#include <lib/core/CHIPError.h>
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace DeviceLayer {
+
+class MmapEventLogStore : public app::EventLogStore
+{
+public:
+    static constexpr size_t kDefaultSegmentSize = 64 * 1024;
+    static constexpr size_t kDefaultMaxSegments = 16;
+
+    struct Stats
+    {
+        /// Number of segment files.
+        size_t mSegmentCount = 0;
+        /// Number of events stored in the segments.
+        size_t mEventCount = 0;
+        /// Size of the segment files, in bytes.
+        size_t mDiskSize = 0;
+        /// Number of bytes of incomplete or corrupted records erased when opening the store.
+        size_t mDiscardedSize = 0;
+    };
+
+    MmapEventLogStore() = default;
+    ~MmapEventLogStore() override;
+
+    MmapEventLogStore(const MmapEventLogStore &)             = delete;
+    MmapEventLogStore & operator=(const MmapEventLogStore &) = delete;
+
+    /**
+     * Open the store kept in aDirectory, creating the directory if needed, and index the events it holds.
+     *
+     * @param[in] aDirectory    The directory of the segment files, which should not be used for anything else.
+     * @param[in] aSegmentSize  The size of new segment files.  An event larger than a segment cannot be stored.
+     * @param[in] aMaxSegments  The maximum number of segment files, so the store uses at most
+     *                          aSegmentSize * aMaxSegments bytes of disk.
+     *
+     * @retval #CHIP_NO_ERROR On success.
+     * @retval #CHIP_ERROR_INCORRECT_STATE If the store is already open.
+     * @retval #CHIP_ERROR_INVALID_ARGUMENT If the segment size or count is too small.
+     * @retval #CHIP_ERROR_POSIX If the directory or a segment could not be opened, mapped or repaired.
+     */
+    CHIP_ERROR Init(const char * aDirectory, size_t aSegmentSize = kDefaultSegmentSize,
+                    size_t aMaxSegments = kDefaultMaxSegments);
+
+    /**
+     * Write the segments back to their files and close the store.
+     */
+    void Shutdown();
+
+    CHIP_ERROR Append(const app::EventIndexEntry & aEntry, const ByteSpan & aEvent) override;
+    CHIP_ERROR ForEachEventSince(EventNumber aEventNumber, Visitor & aVisitor) override;
+    CHIP_ERROR RemoveFabric(FabricIndex aFabricIndex) override;
+
+    Stats GetStats() const;
+
+private:
+    struct Segment
+    {
+        std::string mPath;
+        uint8_t * mpData = nullptr;
+        size_t mSize     = 0;
+        size_t mUsed     = 0; ///< Offset of the end of the last record.
+        // mOffset is the offset of the record of the event in mpData.
+        std::vector<app::EventIndexEntry> mIndex;
+    };
+
+    CHIP_ERROR LoadSegment(const std::string & aPath, Segment & aSegment);
+    CHIP_ERROR CreateSegment(EventNumber aFirstEventNumber);
+    void DropOldestSegment();
+    void DropAllSegments();
+
+    static CHIP_ERROR MapSegment(const std::string & aPath, bool aCreate, size_t aSize, Segment & aSegment);
+    static void UnmapSegment(Segment & aSegment);
+
+    std::string mDirectory;
+    size_t mSegmentSize = 0;
+    size_t mMaxSegments = 0;
+    std::deque<Segment> mSegments;
+    size_t mDiscardedSize = 0;
+};
+
+} // namespace DeviceLayer
+} // namespace chip
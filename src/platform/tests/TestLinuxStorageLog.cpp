@@ -0,0 +1,378 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the append-only key-value store log of the Linux platform, including
+ *      its recovery from torn and corrupted writes.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/Linux/CHIPLinuxStorageLog.h>
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+using namespace chip;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+using Contents = std::map<std::string, std::vector<uint8_t>>;
+
+const char * const kKeys[] = { "k0", "k1", "k2", "k3", "k4", "k5", "k6", "k7" };
+
+std::vector<uint8_t> ReadFile(const std::string & path)
+{
+    std::vector<uint8_t> data;
+    FILE * file = fopen(path.c_str(), "rb");
+    if (file == nullptr)
+    {
+        return data;
+    }
+    uint8_t buf[256];
+    size_t count;
+    while ((count = fread(buf, 1, sizeof(buf), file)) > 0)
+    {
+        data.insert(data.end(), buf, buf + count);
+    }
+    fclose(file);
+    return data;
+}
+
+void WriteFile(const std::string & path, const uint8_t * data, size_t size)
+{
+    FILE * file = fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    EXPECT_EQ(fwrite(data, 1, size, file), size);
+    fclose(file);
+}
+
+Contents ReadContents(ChipLinuxStorageLog & storage)
+{
+    Contents contents;
+    for (const char * key : kKeys)
+    {
+        uint8_t buf[64];
+        size_t size    = 0;
+        CHIP_ERROR err = storage.Read(key, buf, sizeof(buf), &size, 0);
+        if (err == CHIP_NO_ERROR)
+        {
+            contents[key].assign(buf, buf + size);
+        }
+        else
+        {
+            EXPECT_EQ(err, CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+        }
+    }
+    return contents;
+}
+
+CHIP_ERROR Write(ChipLinuxStorageLog & storage, Contents & expected, const char * key, const std::string & value)
+{
+    expected[key].assign(value.begin(), value.end());
+    return storage.Write(key, value.data(), value.size());
+}
+
+CHIP_ERROR Delete(ChipLinuxStorageLog & storage, Contents & expected, const char * key)
+{
+    expected.erase(key);
+    return storage.Delete(key);
+}
+
+} // namespace
+
+struct TestLinuxStorageLog : public ::testing::Test
+{
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+
+    void SetUp() override
+    {
+        char path[] = "/tmp/chip_kvs_log_XXXXXX";
+        int fd      = mkstemp(path);
+        ASSERT_GE(fd, 0);
+        close(fd);
+        mPath = path;
+        unlink(mPath.c_str());
+    }
+
+    void TearDown() override
+    {
+        unlink(mPath.c_str());
+        unlink((mPath + ".tmp").c_str());
+    }
+
+    /**
+     * Write a sequence of transactions mixing single writes, batches, overwrites and deletions. Returns the size of
+     * the log after each transaction, mapped to the contents of the store at that point, including the empty log.
+     */
+    std::map<size_t, Contents> WriteHistory()
+    {
+        std::map<size_t, Contents> history;
+        Contents expected;
+        ChipLinuxStorageLog storage;
+        EXPECT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+        history[storage.GetStats().mLogSize] = expected;
+
+        auto commit = [&]() { history[storage.GetStats().mLogSize] = expected; };
+
+        EXPECT_EQ(Write(storage, expected, "k0", "zero"), CHIP_NO_ERROR);
+        commit();
+        EXPECT_EQ(Write(storage, expected, "k1", ""), CHIP_NO_ERROR);
+        commit();
+
+        storage.BeginBatch();
+        EXPECT_EQ(Write(storage, expected, "k2", "two"), CHIP_NO_ERROR);
+        EXPECT_EQ(Write(storage, expected, "k3", "three"), CHIP_NO_ERROR);
+        EXPECT_EQ(Write(storage, expected, "k0", "ZERO"), CHIP_NO_ERROR);
+        EXPECT_EQ(Delete(storage, expected, "k1"), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.EndBatch(), CHIP_NO_ERROR);
+        commit();
+
+        EXPECT_EQ(Delete(storage, expected, "k2"), CHIP_NO_ERROR);
+        commit();
+
+        storage.BeginBatch();
+        for (int i = 0; i < 4; i++)
+        {
+            EXPECT_EQ(Write(storage, expected, kKeys[4 + i], std::string(static_cast<size_t>(10 * (i + 1)), 'a')),
+                      CHIP_NO_ERROR);
+        }
+        EXPECT_EQ(Write(storage, expected, "k3", "THREE"), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.EndBatch(), CHIP_NO_ERROR);
+        commit();
+
+        EXPECT_EQ(Write(storage, expected, "k7", "seven"), CHIP_NO_ERROR);
+        commit();
+
+        storage.Shutdown();
+        return history;
+    }
+
+    std::string mPath;
+};
+
+TEST_F(TestLinuxStorageLog, ReadWriteDelete)
+{
+    ChipLinuxStorageLog storage;
+    EXPECT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+
+    static constexpr char kValue[] = "0123456789";
+    EXPECT_EQ(storage.Write("key", kValue, sizeof(kValue)), CHIP_NO_ERROR);
+
+    char buf[sizeof(kValue)];
+    size_t size = 0;
+    EXPECT_EQ(storage.Read("key", buf, sizeof(buf), &size, 0), CHIP_NO_ERROR);
+    EXPECT_EQ(size, sizeof(kValue));
+    EXPECT_STREQ(buf, kValue);
+
+    // Partial and offset reads behave as KeyValueStoreManager::Get().
+    EXPECT_EQ(storage.Read("key", buf, 4, &size, 0), CHIP_ERROR_BUFFER_TOO_SMALL);
+    EXPECT_EQ(size, 4u);
+    EXPECT_EQ(storage.Read("key", buf, sizeof(buf), &size, 5), CHIP_NO_ERROR);
+    EXPECT_EQ(size, sizeof(kValue) - 5);
+    EXPECT_STREQ(buf, kValue + 5);
+    EXPECT_EQ(storage.Read("key", buf, sizeof(buf), &size, sizeof(kValue) + 1), CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Values survive reopening the store.
+    storage.Shutdown();
+    EXPECT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.Read("key", buf, sizeof(buf), &size, 0), CHIP_NO_ERROR);
+    EXPECT_STREQ(buf, kValue);
+
+    EXPECT_EQ(storage.Delete("key"), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.Delete("key"), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    storage.Shutdown();
+    EXPECT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.Read("key", buf, sizeof(buf), &size, 0), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+}
+
+TEST_F(TestLinuxStorageLog, BatchesCoalesceWrites)
+{
+    ChipLinuxStorageLog storage;
+    EXPECT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+
+    storage.BeginBatch();
+    storage.BeginBatch();
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(storage.Write("counter", &i, sizeof(i)), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(storage.EndBatch(), CHIP_NO_ERROR);
+
+    // Writes are visible before they are flushed, but only the outermost batch flushes them.
+    uint32_t value = 0;
+    EXPECT_EQ(storage.Read("counter", &value, sizeof(value), nullptr, 0), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 99u);
+    EXPECT_EQ(storage.GetStats().mFlushCount, 0u);
+
+    EXPECT_EQ(storage.EndBatch(), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.EndBatch(), CHIP_ERROR_INCORRECT_STATE);
+
+    ChipLinuxStorageLog::Stats stats = storage.GetStats();
+    EXPECT_EQ(stats.mFlushCount, 1u);
+    EXPECT_EQ(stats.mCoalescedCount, 99u);
+    EXPECT_EQ(stats.mLogSize, stats.mLiveSize);
+
+    // An explicit flush commits a batch early.
+    storage.BeginBatch();
+    EXPECT_EQ(storage.Write("other", &value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.Flush(), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.GetStats().mFlushCount, 2u);
+    EXPECT_EQ(storage.EndBatch(), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.GetStats().mFlushCount, 2u);
+
+    storage.Shutdown();
+    EXPECT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    value = 0;
+    EXPECT_EQ(storage.Read("counter", &value, sizeof(value), nullptr, 0), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 99u);
+    EXPECT_EQ(storage.Read("other", &value, sizeof(value), nullptr, 0), CHIP_NO_ERROR);
+}
+
+TEST_F(TestLinuxStorageLog, TornWritesRecoverLastTransaction)
+{
+    std::map<size_t, Contents> history = WriteHistory();
+    const std::vector<uint8_t> log     = ReadFile(mPath);
+    ASSERT_EQ(history.rbegin()->first, log.size());
+
+    // Simulate a crash at every byte of the log: each prefix must load as the last transaction it fully contains.
+    const size_t headerSize = history.begin()->first;
+    for (size_t size = 0; size <= log.size(); size++)
+    {
+        WriteFile(mPath, log.data(), size);
+
+        ChipLinuxStorageLog storage;
+        ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+
+        if (size < headerSize)
+        {
+            EXPECT_TRUE(ReadContents(storage).empty());
+            continue;
+        }
+
+        auto committed = history.upper_bound(size);
+        committed--;
+        EXPECT_EQ(ReadContents(storage), committed->second) << "log truncated to " << size << " bytes";
+        EXPECT_EQ(storage.GetStats().mDiscardedSize, size - committed->first);
+
+        // The torn transaction is gone: a new one is appended right after the last complete one.
+        EXPECT_EQ(storage.Write("k1", "new", 3), CHIP_NO_ERROR);
+        storage.Shutdown();
+        Contents expected = committed->second;
+        expected["k1"].assign({ 'n', 'e', 'w' });
+        ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+        EXPECT_EQ(ReadContents(storage), expected) << "log truncated to " << size << " bytes";
+    }
+}
+
+TEST_F(TestLinuxStorageLog, CorruptedWritesRecoverLastTransaction)
+{
+    std::map<size_t, Contents> history = WriteHistory();
+    const std::vector<uint8_t> log     = ReadFile(mPath);
+    const size_t headerSize            = history.begin()->first;
+
+    // Corrupt every byte of the log in turn: the transaction holding it and all later ones must be dropped.
+    for (size_t offset = 0; offset < log.size(); offset++)
+    {
+        std::vector<uint8_t> corrupted = log;
+        corrupted[offset] ^= 0x20;
+        WriteFile(mPath, corrupted.data(), corrupted.size());
+
+        ChipLinuxStorageLog storage;
+        if (offset < headerSize)
+        {
+            EXPECT_EQ(storage.Init(mPath.c_str()), CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+            continue;
+        }
+        ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+
+        auto committed = history.upper_bound(offset);
+        committed--;
+        EXPECT_EQ(ReadContents(storage), committed->second) << "byte " << offset << " corrupted";
+        EXPECT_EQ(storage.GetStats().mLogSize, committed->first);
+    }
+}
+
+TEST_F(TestLinuxStorageLog, CompactionKeepsLiveData)
+{
+    // A compaction interrupted before its rename leaves a stale temporary file, which must be ignored.
+    const std::string stale = "garbage";
+    WriteFile(mPath + ".tmp", reinterpret_cast<const uint8_t *>(stale.data()), stale.size());
+
+    ChipLinuxStorageLog storage;
+    EXPECT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_TRUE(ReadFile(mPath + ".tmp").empty());
+
+    Contents expected;
+    for (int i = 0; i < 1000; i++)
+    {
+        EXPECT_EQ(Write(storage, expected, kKeys[i % 8], std::string(40, static_cast<char>('a' + i % 26))), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(Delete(storage, expected, "k3"), CHIP_NO_ERROR);
+
+    ChipLinuxStorageLog::Stats stats = storage.GetStats();
+    EXPECT_GT(stats.mCompactionCount, 0u);
+    EXPECT_EQ(stats.mFlushCount, 1001u);
+    EXPECT_LE(stats.mLogSize, 2 * 32 * 1024u);
+    EXPECT_EQ(stats.mLogSize, ReadFile(mPath).size());
+    EXPECT_EQ(ReadContents(storage), expected);
+
+    storage.Shutdown();
+    EXPECT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(ReadContents(storage), expected);
+    EXPECT_EQ(storage.GetStats().mDiscardedSize, 0u);
+}
+
+TEST_F(TestLinuxStorageLog, BatchedWriteBenchmark)
+{
+    constexpr uint32_t kWriteCount = 200;
+
+    ChipLinuxStorageLog storage;
+    EXPECT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < kWriteCount; i++)
+    {
+        EXPECT_EQ(storage.Write(kKeys[i % 8], &i, sizeof(i)), CHIP_NO_ERROR);
+    }
+    auto single = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    storage.BeginBatch();
+    for (uint32_t i = 0; i < kWriteCount; i++)
+    {
+        EXPECT_EQ(storage.Write(kKeys[i % 8], &i, sizeof(i)), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(storage.EndBatch(), CHIP_NO_ERROR);
+    auto batched = std::chrono::steady_clock::now() - start;
+
+    ChipLogProgress(DeviceLayer, "%u writes: %u us flushed one by one, %u us in one batch", static_cast<unsigned>(kWriteCount),
+                    static_cast<unsigned>(std::chrono::duration_cast<std::chrono::microseconds>(single).count()),
+                    static_cast<unsigned>(std::chrono::duration_cast<std::chrono::microseconds>(batched).count()));
+}
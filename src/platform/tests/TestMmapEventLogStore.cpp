@@ -0,0 +1,454 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the memory-mapped event log store of the Linux platform, including its
+ *      recovery from torn writes and the throughput of its appends and catch-up reads.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/Linux/MmapEventLogStore.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::DeviceLayer;
+
+namespace {
+
+struct StoredEvent
+{
+    EventIndexEntry mEntry;
+    std::vector<uint8_t> mData;
+};
+
+// Every event carries its number twice, so that it can be found in the segment files, followed by a few more bytes.
+std::vector<uint8_t> MakeEvent(EventNumber eventNumber, size_t extraSize = 0)
+{
+    std::vector<uint8_t> data(2 * sizeof(eventNumber) + extraSize + eventNumber % 7);
+    memcpy(data.data(), &eventNumber, sizeof(eventNumber));
+    memcpy(data.data() + sizeof(eventNumber), &eventNumber, sizeof(eventNumber));
+    for (size_t i = 2 * sizeof(eventNumber); i < data.size(); i++)
+    {
+        data[i] = static_cast<uint8_t>(i + eventNumber);
+    }
+    return data;
+}
+
+EventIndexEntry MakeEntry(EventNumber eventNumber, FabricIndex fabricIndex = kUndefinedFabricIndex)
+{
+    EventIndexEntry entry;
+    entry.mEventNumber    = eventNumber;
+    entry.mClusterId      = static_cast<ClusterId>(0x28 + eventNumber % 3);
+    entry.mEndpointId     = static_cast<EndpointId>(eventNumber % 2);
+    entry.mFabricIndex    = fabricIndex;
+    entry.mHasFabricIndex = (fabricIndex != kUndefinedFabricIndex);
+    return entry;
+}
+
+CHIP_ERROR AppendEvent(MmapEventLogStore & store, EventNumber eventNumber, FabricIndex fabricIndex = kUndefinedFabricIndex)
+{
+    std::vector<uint8_t> data = MakeEvent(eventNumber);
+    return store.Append(MakeEntry(eventNumber, fabricIndex), ByteSpan(data.data(), data.size()));
+}
+
+class CollectingVisitor : public EventLogStore::Visitor
+{
+public:
+    CHIP_ERROR OnEvent(const EventIndexEntry & aEntry, const ByteSpan & aEvent) override
+    {
+        VerifyOrReturnError(mEvents.size() < mLimit, CHIP_ERROR_SENTINEL);
+        mEvents.push_back({ aEntry, std::vector<uint8_t>(aEvent.data(), aEvent.data() + aEvent.size()) });
+        return CHIP_NO_ERROR;
+    }
+
+    std::vector<StoredEvent> mEvents;
+    size_t mLimit = SIZE_MAX;
+};
+
+std::vector<StoredEvent> ReadEventsSince(MmapEventLogStore & store, EventNumber eventNumber)
+{
+    CollectingVisitor visitor;
+    EXPECT_EQ(store.ForEachEventSince(eventNumber, visitor), CHIP_NO_ERROR);
+    return visitor.mEvents;
+}
+
+// Check that the events are exactly first..last, as appended by AppendEvent.
+void ExpectEvents(const std::vector<StoredEvent> & events, EventNumber first, EventNumber last)
+{
+    ASSERT_EQ(events.size(), static_cast<size_t>(last - first + 1));
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        const EventNumber eventNumber  = first + i;
+        const EventIndexEntry expected = MakeEntry(eventNumber);
+        EXPECT_EQ(events[i].mEntry.mEventNumber, eventNumber);
+        EXPECT_EQ(events[i].mEntry.mClusterId, expected.mClusterId);
+        EXPECT_EQ(events[i].mEntry.mEndpointId, expected.mEndpointId);
+        EXPECT_EQ(events[i].mEntry.mLength, events[i].mData.size());
+        EXPECT_EQ(events[i].mData, MakeEvent(eventNumber));
+    }
+}
+
+} // namespace
+
+struct TestMmapEventLogStore : public ::testing::Test
+{
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+
+    void SetUp() override
+    {
+        char path[] = "/tmp/chip_event_log_XXXXXX";
+        ASSERT_NE(mkdtemp(path), nullptr);
+        mDirectory = path;
+    }
+
+    void TearDown() override
+    {
+        for (const std::string & name : ListSegments())
+        {
+            unlink((mDirectory + "/" + name).c_str());
+        }
+        rmdir(mDirectory.c_str());
+    }
+
+    std::vector<std::string> ListSegments() const
+    {
+        std::vector<std::string> names;
+        DIR * dir = opendir(mDirectory.c_str());
+        if (dir == nullptr)
+        {
+            return names;
+        }
+        for (struct dirent * entry = readdir(dir); entry != nullptr; entry = readdir(dir))
+        {
+            if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0)
+            {
+                names.push_back(entry->d_name);
+            }
+        }
+        closedir(dir);
+        std::sort(names.begin(), names.end());
+        return names;
+    }
+
+    // Flip the first byte of the data of eventNumber in the segment files.  Returns whether the event was found.
+    bool CorruptEvent(EventNumber eventNumber)
+    {
+        const std::vector<uint8_t> data = MakeEvent(eventNumber);
+        for (const std::string & name : ListSegments())
+        {
+            const std::string path = mDirectory + "/" + name;
+            FILE * file            = fopen(path.c_str(), "r+b");
+            if (file == nullptr)
+            {
+                continue;
+            }
+            std::vector<uint8_t> contents;
+            uint8_t buf[4096];
+            size_t count;
+            while ((count = fread(buf, 1, sizeof(buf), file)) > 0)
+            {
+                contents.insert(contents.end(), buf, buf + count);
+            }
+            auto it = std::search(contents.begin(), contents.end(), data.begin(), data.end());
+            if (it != contents.end())
+            {
+                const uint8_t flipped = static_cast<uint8_t>(*it ^ 0xFF);
+                fseek(file, static_cast<long>(it - contents.begin()), SEEK_SET);
+                fwrite(&flipped, 1, 1, file);
+                fclose(file);
+                return true;
+            }
+            fclose(file);
+        }
+        return false;
+    }
+
+    std::string mDirectory;
+};
+
+TEST_F(TestMmapEventLogStore, AppendAndRead)
+{
+    MmapEventLogStore store;
+    EXPECT_EQ(AppendEvent(store, 1), CHIP_ERROR_INCORRECT_STATE);
+    ASSERT_EQ(store.Init(mDirectory.c_str(), 1024, 8), CHIP_NO_ERROR);
+    EXPECT_EQ(store.Init(mDirectory.c_str(), 1024, 8), CHIP_ERROR_INCORRECT_STATE);
+
+    ExpectEvents(ReadEventsSince(store, 0), 1, 0);
+    for (EventNumber eventNumber = 100; eventNumber < 200; eventNumber++)
+    {
+        ASSERT_EQ(AppendEvent(store, eventNumber), CHIP_NO_ERROR);
+    }
+
+    // The events span several segments; reads may start anywhere.
+    EXPECT_GT(store.GetStats().mSegmentCount, 1u);
+    EXPECT_EQ(store.GetStats().mEventCount, 100u);
+    ExpectEvents(ReadEventsSince(store, 0), 100, 199);
+    ExpectEvents(ReadEventsSince(store, 150), 150, 199);
+    ExpectEvents(ReadEventsSince(store, 199), 199, 199);
+    ExpectEvents(ReadEventsSince(store, 200), 1, 0);
+
+    // The visitor can stop the iteration, and its error is returned.
+    CollectingVisitor visitor;
+    visitor.mLimit = 10;
+    EXPECT_EQ(store.ForEachEventSince(120, visitor), CHIP_ERROR_SENTINEL);
+    ExpectEvents(visitor.mEvents, 120, 129);
+
+    // An event larger than a segment cannot be stored.
+    std::vector<uint8_t> large(1024);
+    EXPECT_EQ(store.Append(MakeEntry(200), ByteSpan(large.data(), large.size())), CHIP_ERROR_BUFFER_TOO_SMALL);
+    ExpectEvents(ReadEventsSince(store, 0), 100, 199);
+}
+
+TEST_F(TestMmapEventLogStore, ReopenKeepsEvents)
+{
+    {
+        MmapEventLogStore store;
+        ASSERT_EQ(store.Init(mDirectory.c_str(), 1024, 8), CHIP_NO_ERROR);
+        for (EventNumber eventNumber = 1; eventNumber <= 50; eventNumber++)
+        {
+            ASSERT_EQ(AppendEvent(store, eventNumber), CHIP_NO_ERROR);
+        }
+    }
+
+    MmapEventLogStore store;
+    ASSERT_EQ(store.Init(mDirectory.c_str(), 1024, 8), CHIP_NO_ERROR);
+    EXPECT_EQ(store.GetStats().mDiscardedSize, 0u);
+    ExpectEvents(ReadEventsSince(store, 0), 1, 50);
+
+    // Appends continue where the previous run stopped.
+    for (EventNumber eventNumber = 51; eventNumber <= 60; eventNumber++)
+    {
+        ASSERT_EQ(AppendEvent(store, eventNumber), CHIP_NO_ERROR);
+    }
+    store.Shutdown();
+    ASSERT_EQ(store.Init(mDirectory.c_str(), 1024, 8), CHIP_NO_ERROR);
+    ExpectEvents(ReadEventsSince(store, 0), 1, 60);
+}
+
+TEST_F(TestMmapEventLogStore, DiskUsageIsBounded)
+{
+    constexpr size_t kSegmentSize = 512;
+    constexpr size_t kMaxSegments = 4;
+
+    MmapEventLogStore store;
+    ASSERT_EQ(store.Init(mDirectory.c_str(), kSegmentSize, kMaxSegments), CHIP_NO_ERROR);
+    for (EventNumber eventNumber = 1; eventNumber <= 1000; eventNumber++)
+    {
+        ASSERT_EQ(AppendEvent(store, eventNumber), CHIP_NO_ERROR);
+
+        MmapEventLogStore::Stats stats = store.GetStats();
+        EXPECT_LE(stats.mSegmentCount, kMaxSegments);
+        EXPECT_LE(stats.mDiskSize, kSegmentSize * kMaxSegments);
+    }
+    EXPECT_EQ(ListSegments().size(), kMaxSegments);
+
+    // Only the oldest events were dropped.
+    std::vector<StoredEvent> events = ReadEventsSince(store, 0);
+    ASSERT_FALSE(events.empty());
+    EXPECT_EQ(events.size(), store.GetStats().mEventCount);
+    ExpectEvents(events, events.front().mEntry.mEventNumber, 1000);
+    EXPECT_GT(events.front().mEntry.mEventNumber, 1u);
+
+    // A smaller bound when reopening drops the extra segments.
+    store.Shutdown();
+    ASSERT_EQ(store.Init(mDirectory.c_str(), kSegmentSize, kMaxSegments - 1), CHIP_NO_ERROR);
+    EXPECT_EQ(ListSegments().size(), kMaxSegments - 1);
+    events = ReadEventsSince(store, 0);
+    ASSERT_FALSE(events.empty());
+    ExpectEvents(events, events.front().mEntry.mEventNumber, 1000);
+}
+
+TEST_F(TestMmapEventLogStore, RemoveFabric)
+{
+    MmapEventLogStore store;
+    ASSERT_EQ(store.Init(mDirectory.c_str(), 1024, 8), CHIP_NO_ERROR);
+    for (EventNumber eventNumber = 1; eventNumber <= 60; eventNumber++)
+    {
+        ASSERT_EQ(AppendEvent(store, eventNumber, static_cast<FabricIndex>(eventNumber % 3)), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(store.RemoveFabric(1), CHIP_NO_ERROR);
+
+    auto check = [&]() {
+        std::vector<StoredEvent> events = ReadEventsSince(store, 0);
+        ASSERT_EQ(events.size(), 60u);
+        for (const StoredEvent & event : events)
+        {
+            const FabricIndex fabricIndex = static_cast<FabricIndex>(event.mEntry.mEventNumber % 3);
+            EXPECT_EQ(event.mEntry.mHasFabricIndex, fabricIndex != kUndefinedFabricIndex);
+            EXPECT_EQ(event.mEntry.mFabricIndex, fabricIndex == 1 ? kUndefinedFabricIndex : fabricIndex);
+            EXPECT_EQ(event.mData, MakeEvent(event.mEntry.mEventNumber));
+        }
+    };
+    check();
+
+    // The removal is persisted, and the records stay valid.
+    store.Shutdown();
+    ASSERT_EQ(store.Init(mDirectory.c_str(), 1024, 8), CHIP_NO_ERROR);
+    EXPECT_EQ(store.GetStats().mDiscardedSize, 0u);
+    check();
+}
+
+TEST_F(TestMmapEventLogStore, EventNumbersRestart)
+{
+    MmapEventLogStore store;
+    ASSERT_EQ(store.Init(mDirectory.c_str(), 1024, 8), CHIP_NO_ERROR);
+    for (EventNumber eventNumber = 100; eventNumber < 150; eventNumber++)
+    {
+        ASSERT_EQ(AppendEvent(store, eventNumber), CHIP_NO_ERROR);
+    }
+
+    // Event numbers going backwards, as after a factory reset, invalidate the stored events.
+    ASSERT_EQ(AppendEvent(store, 5), CHIP_NO_ERROR);
+    ASSERT_EQ(AppendEvent(store, 6), CHIP_NO_ERROR);
+    ExpectEvents(ReadEventsSince(store, 0), 5, 6);
+    EXPECT_EQ(ListSegments().size(), 1u);
+
+    store.Shutdown();
+    ASSERT_EQ(store.Init(mDirectory.c_str(), 1024, 8), CHIP_NO_ERROR);
+    ExpectEvents(ReadEventsSince(store, 0), 5, 6);
+}
+
+TEST_F(TestMmapEventLogStore, TornRecordIsDiscarded)
+{
+    {
+        MmapEventLogStore store;
+        ASSERT_EQ(store.Init(mDirectory.c_str(), 1024, 8), CHIP_NO_ERROR);
+        for (EventNumber eventNumber = 1; eventNumber <= 50; eventNumber++)
+        {
+            ASSERT_EQ(AppendEvent(store, eventNumber), CHIP_NO_ERROR);
+        }
+    }
+
+    // A record damaged by a crash cuts its segment short; the events of the other segments are kept.
+    ASSERT_TRUE(CorruptEvent(48));
+    {
+        MmapEventLogStore store;
+        ASSERT_EQ(store.Init(mDirectory.c_str(), 1024, 8), CHIP_NO_ERROR);
+        EXPECT_GT(store.GetStats().mDiscardedSize, 0u);
+        ExpectEvents(ReadEventsSince(store, 0), 1, 47);
+
+        // The damaged tail was erased, so new events are appended in its place.
+        for (EventNumber eventNumber = 48; eventNumber <= 55; eventNumber++)
+        {
+            ASSERT_EQ(AppendEvent(store, eventNumber), CHIP_NO_ERROR);
+        }
+    }
+
+    MmapEventLogStore store;
+    ASSERT_EQ(store.Init(mDirectory.c_str(), 1024, 8), CHIP_NO_ERROR);
+    EXPECT_EQ(store.GetStats().mDiscardedSize, 0u);
+    ExpectEvents(ReadEventsSince(store, 0), 1, 55);
+
+    // Files that are not complete segments are ignored and removed.
+    store.Shutdown();
+    FILE * file = fopen((mDirectory + "/events-00000000000000FF.log").c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    fclose(file);
+    ASSERT_EQ(store.Init(mDirectory.c_str(), 1024, 8), CHIP_NO_ERROR);
+    ExpectEvents(ReadEventsSince(store, 0), 1, 55);
+    const std::vector<std::string> segments = ListSegments();
+    EXPECT_EQ(std::count(segments.begin(), segments.end(), "events-00000000000000FF.log"), 0);
+}
+
+TEST_F(TestMmapEventLogStore, AppendAndCatchUpBenchmark)
+{
+    constexpr EventNumber kEventCount = 20000;
+    constexpr size_t kEventSize       = 64;
+
+    MmapEventLogStore store;
+    ASSERT_EQ(store.Init(mDirectory.c_str()), CHIP_NO_ERROR);
+
+    std::vector<std::vector<uint8_t>> events;
+    for (EventNumber eventNumber = 1; eventNumber <= kEventCount; eventNumber++)
+    {
+        events.push_back(MakeEvent(eventNumber, kEventSize));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (EventNumber eventNumber = 1; eventNumber <= kEventCount; eventNumber++)
+    {
+        const std::vector<uint8_t> & data = events[eventNumber - 1];
+        ASSERT_EQ(store.Append(MakeEntry(eventNumber), ByteSpan(data.data(), data.size())), CHIP_NO_ERROR);
+    }
+    auto appendTime = std::chrono::steady_clock::now() - start;
+
+    MmapEventLogStore::Stats stats = store.GetStats();
+    const EventNumber oldest       = kEventCount - stats.mEventCount + 1;
+
+    // Catching up from the oldest stored event reads everything; from the newest events, a single segment.
+    class CountingVisitor : public EventLogStore::Visitor
+    {
+    public:
+        CHIP_ERROR OnEvent(const EventIndexEntry & aEntry, const ByteSpan & aEvent) override
+        {
+            mCount++;
+            mBytes += aEvent.size();
+            return CHIP_NO_ERROR;
+        }
+        size_t mCount = 0;
+        size_t mBytes = 0;
+    };
+
+    constexpr int kReadCount = 20;
+    CountingVisitor fullVisitor;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kReadCount; i++)
+    {
+        EXPECT_EQ(store.ForEachEventSince(oldest, fullVisitor), CHIP_NO_ERROR);
+    }
+    auto fullReadTime = (std::chrono::steady_clock::now() - start) / kReadCount;
+    EXPECT_EQ(fullVisitor.mCount, stats.mEventCount * kReadCount);
+
+    CountingVisitor tailVisitor;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kReadCount; i++)
+    {
+        EXPECT_EQ(store.ForEachEventSince(kEventCount - 99, tailVisitor), CHIP_NO_ERROR);
+    }
+    auto tailReadTime = (std::chrono::steady_clock::now() - start) / kReadCount;
+    EXPECT_EQ(tailVisitor.mCount, 100u * kReadCount);
+
+    ChipLogProgress(DeviceLayer,
+                    "%u appends of %u-byte events: %u us (%u events/s); %u events in %u segments (%u bytes on disk)",
+                    static_cast<unsigned>(kEventCount), static_cast<unsigned>(kEventSize),
+                    static_cast<unsigned>(std::chrono::duration_cast<std::chrono::microseconds>(appendTime).count()),
+                    static_cast<unsigned>(static_cast<double>(kEventCount) /
+                                          std::chrono::duration<double>(appendTime).count()),
+                    static_cast<unsigned>(stats.mEventCount), static_cast<unsigned>(stats.mSegmentCount),
+                    static_cast<unsigned>(stats.mDiskSize));
+    ChipLogProgress(DeviceLayer, "Catch-up read of %u events: %u us; of the last 100 events: %u us",
+                    static_cast<unsigned>(stats.mEventCount),
+                    static_cast<unsigned>(std::chrono::duration_cast<std::chrono::microseconds>(fullReadTime).count()),
+                    static_cast<unsigned>(std::chrono::duration_cast<std::chrono::microseconds>(tailReadTime).count()));
+}
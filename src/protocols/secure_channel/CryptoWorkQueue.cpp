@@ -0,0 +1,126 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <protocols/secure_channel/CryptoWorkQueue.h>
+
+namespace chip {
+
+namespace {
+
+CryptoWorkQueue * gCryptoWorkQueue = nullptr;
+
+} // namespace
+
+CryptoWorkQueue * GetCryptoWorkQueue()
+{
+    return gCryptoWorkQueue;
+}
+
+void SetCryptoWorkQueue(CryptoWorkQueue * queue)
+{
+    gCryptoWorkQueue = queue;
+}
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+CHIP_ERROR ThreadPoolCryptoWorkQueue::Init(size_t workerCount)
+{
+    VerifyOrReturnError(mWorkerCount == 0, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(workerCount > 0 && workerCount <= CHIP_CONFIG_CRYPTO_WORKER_MAX, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mShuttingDown = false;
+    for (size_t i = 0; i < workerCount; i++)
+    {
+        int res = pthread_create(&mWorkers[i], nullptr, WorkerMain, this);
+        if (res != 0)
+        {
+            Shutdown();
+            return CHIP_ERROR_POSIX(res);
+        }
+        mWorkerCount++;
+    }
+    return CHIP_NO_ERROR;
+}
+
+void ThreadPoolCryptoWorkQueue::Shutdown()
+{
+    VerifyOrReturn(mWorkerCount > 0);
+
+    pthread_mutex_lock(&mLock);
+    mShuttingDown = true;
+    pthread_cond_broadcast(&mWorkAvailable);
+    pthread_mutex_unlock(&mLock);
+
+    for (size_t i = 0; i < mWorkerCount; i++)
+    {
+        pthread_join(mWorkers[i], nullptr);
+    }
+    mWorkerCount = 0;
+}
+
+CHIP_ERROR ThreadPoolCryptoWorkQueue::ScheduleWork(WorkFunct work, intptr_t arg)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    pthread_mutex_lock(&mLock);
+    VerifyOrExit(mWorkerCount > 0 && !mShuttingDown, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(mPendingCount < CHIP_CONFIG_CRYPTO_WORK_QUEUE_SIZE, err = CHIP_ERROR_NO_MEMORY);
+
+    mPending[(mPendingHead + mPendingCount) % CHIP_CONFIG_CRYPTO_WORK_QUEUE_SIZE] = { work, arg };
+    mPendingCount++;
+    pthread_cond_signal(&mWorkAvailable);
+
+exit:
+    pthread_mutex_unlock(&mLock);
+    return err;
+}
+
+void * ThreadPoolCryptoWorkQueue::WorkerMain(void * arg)
+{
+    static_cast<ThreadPoolCryptoWorkQueue *>(arg)->RunWorker();
+    return nullptr;
+}
+
+void ThreadPoolCryptoWorkQueue::RunWorker()
+{
+    pthread_mutex_lock(&mLock);
+    while (true)
+    {
+        while (mPendingCount == 0 && !mShuttingDown)
+        {
+            pthread_cond_wait(&mWorkAvailable, &mLock);
+        }
+        if (mPendingCount == 0)
+        {
+            // Shutting down, with all the work done.
+            break;
+        }
+
+        Work work    = mPending[mPendingHead];
+        mPendingHead = (mPendingHead + 1) % CHIP_CONFIG_CRYPTO_WORK_QUEUE_SIZE;
+        mPendingCount--;
+
+        pthread_mutex_unlock(&mLock);
+        work.mFunct(work.mArg);
+        pthread_mutex_lock(&mLock);
+    }
+    pthread_mutex_unlock(&mLock);
+}
+
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+} // namespace chip
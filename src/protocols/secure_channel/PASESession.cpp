@@ -42,6 +42,7 @@
 #include <messaging/SessionParameters.h>
 #include <protocols/Protocols.h>
 #include <protocols/secure_channel/Constants.h>
+#include <protocols/secure_channel/CryptoWorkQueue.h>
 #include <protocols/secure_channel/StatusReport.h>
 #include <setup_payload/SetupPayload.h>
 #include <system/TLVPacketBufferBackingStore.h>
@@ -68,6 +69,20 @@ const char kSpake2pR2ISessionInfo[] = "Commissioning R2I Key";
 static constexpr ExchangeContext::Timeout kExpectedLowProcessingTime  = System::Clock::Seconds16(2);
 static constexpr ExchangeContext::Timeout kExpectedHighProcessingTime = System::Clock::Seconds16(30);
 
+struct PASESession::ComputeWSData
+{
+    uint32_t iterationCount;
+    uint32_t setupPINCode;
+
+    chip::Platform::ScopedMemoryBuffer<uint8_t> salt;
+    size_t saltLength;
+
+    uint8_t serializedWS[kSpake2p_WS_Length * 2];
+
+    // Whether ComputeWS runs on the crypto work queue, rather than inline in HandlePBKDFParamResponse.
+    bool inBackground;
+};
+
 PASESession::~PASESession()
 {
     // Let's clear out any security state stored in the object, before destroying it.
@@ -90,6 +105,13 @@ void PASESession::Finish()
 void PASESession::Clear()
 {
     MATTER_TRACE_SCOPE("Clear", "PASESession");
+    // Cancel any outstanding work.
+    if (mComputeWSHelper)
+    {
+        mComputeWSHelper->CancelWork();
+        mComputeWSHelper.reset();
+    }
+
     // This function zeroes out and resets the memory used by the object.
     // It's done so that no security related information will be leaked.
     memset(&mPASEVerifier, 0, sizeof(mPASEVerifier));
@@ -453,10 +475,12 @@ CHIP_ERROR PASESession::HandlePBKDFParamResponse(System::PacketBufferHandle && m
 
     uint32_t decodeTagIdSeq = 0;
     ByteSpan salt;
-    uint8_t serializedWS[kSpake2p_WS_Length * 2] = { 0 };
 
     ChipLogDetail(SecureChannel, "Received PBKDF param response");
 
+    auto helper = CryptoWorkHelper<PASESession, ComputeWSData>::Create(*this, &ComputeWS, &PASESession::BeginProverAndSendMsg1);
+    VerifyOrExit(helper, err = CHIP_ERROR_NO_MEMORY);
+
     SuccessOrExit(err = mCommissioningHash.AddData(ByteSpan{ msg->Start(), msg->DataLength() }));
 
     tlvReader.Init(std::move(msg));
@@ -520,20 +544,83 @@ CHIP_ERROR PASESession::HandlePBKDFParamResponse(System::PacketBufferHandle && m
     err = SetupSpake2p();
     SuccessOrExit(err);
 
-    err = Spake2pVerifier::ComputeWS(mIterationCount, salt, mSetupPINCode, serializedWS, sizeof(serializedWS));
-    SuccessOrExit(err);
+    {
+        auto & data = helper->mData;
+
+        data.iterationCount = mIterationCount;
+        data.setupPINCode   = mSetupPINCode;
+        data.saltLength     = salt.size();
+        if (!salt.empty())
+        {
+            VerifyOrExit(data.salt.Alloc(salt.size()), err = CHIP_ERROR_NO_MEMORY);
+            memcpy(data.salt.Get(), salt.data(), salt.size());
+        }
+
+        // Without a crypto work queue, the PBKDF2 computation runs right away, as it always did.
+        data.inBackground = (GetCryptoWorkQueue() != nullptr);
+        if (data.inBackground)
+        {
+            SuccessOrExit(err = helper->ScheduleWork());
+            mComputeWSHelper = helper;
+            mExchangeCtxt.Value()->WillSendMessage();
+            // Nothing is expected from the peer until Msg1 is sent.
+            mNextExpectedMsg.ClearValue();
+        }
+    }
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        SendStatusReport(mExchangeCtxt, kProtocolCodeInvalidParam);
+        return err;
+    }
+
+    if (!helper->mData.inBackground)
+    {
+        // BeginProverAndSendMsg1 sends the status report on failure.
+        return helper->DoWork();
+    }
+
+    return CHIP_NO_ERROR;
+}
 
-    err = mSpake2p.BeginProver(nullptr, 0, nullptr, 0, &serializedWS[0], kSpake2p_WS_Length, &serializedWS[kSpake2p_WS_Length],
-                               kSpake2p_WS_Length);
+CHIP_ERROR PASESession::ComputeWS(ComputeWSData & data, bool & cancel)
+{
+    return Spake2pVerifier::ComputeWS(data.iterationCount, ByteSpan(data.salt.Get(), data.saltLength), data.setupPINCode,
+                                      data.serializedWS, sizeof(data.serializedWS));
+}
+
+CHIP_ERROR PASESession::BeginProverAndSendMsg1(ComputeWSData & data, CHIP_ERROR status)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    SuccessOrExit(err = status);
+
+    err = mSpake2p.BeginProver(nullptr, 0, nullptr, 0, &data.serializedWS[0], kSpake2p_WS_Length,
+                               &data.serializedWS[kSpake2p_WS_Length], kSpake2p_WS_Length);
     SuccessOrExit(err);
 
     err = SendMsg1();
     SuccessOrExit(err);
 
 exit:
+    Crypto::ClearSecretData(data.serializedWS);
+    mComputeWSHelper.reset();
+
     if (err != CHIP_NO_ERROR)
     {
         SendStatusReport(mExchangeCtxt, kProtocolCodeInvalidParam);
+        if (data.inBackground)
+        {
+            // Fail the pairing, which is normally done by PASESession::OnMessageReceived,
+            // but in the background processing case must be done here.
+            DiscardExchange();
+            Clear();
+            ChipLogError(SecureChannel, "Failed during PASE session setup: %" CHIP_ERROR_FORMAT, err.Format());
+            MATTER_TRACE_COUNTER("PASEFail");
+            // Do this last in case the delegate frees us.
+            NotifySessionEstablishmentError(err);
+        }
     }
     return err;
 }
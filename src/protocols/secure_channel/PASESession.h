@@ -31,6 +31,7 @@
 #include <crypto/PSASpake2p.h>
 #endif
 #include <lib/support/Base64.h>
+#include <lib/support/CHIPMem.h>
 #include <messaging/ExchangeContext.h>
 #include <messaging/ExchangeDelegate.h>
 #include <messaging/ExchangeMessageDispatch.h>
@@ -49,6 +50,9 @@ extern const char kSpake2pR2ISessionInfo[];
 
 inline constexpr uint16_t kPBKDFParamRandomNumberSize = 32;
 
+template <class SESSION, class DATA>
+class CryptoWorkHelper;
+
 class DLL_EXPORT PASESession : public Messaging::UnsolicitedMessageHandler,
                                public Messaging::ExchangeDelegate,
                                public PairingSession
@@ -186,6 +190,10 @@ private:
     CHIP_ERROR SendPBKDFParamResponse(ByteSpan initiatorRandom, bool initiatorHasPBKDFParams);
     CHIP_ERROR HandlePBKDFParamResponse(System::PacketBufferHandle && msg);
 
+    struct ComputeWSData;
+    static CHIP_ERROR ComputeWS(ComputeWSData & data, bool & cancel);
+    CHIP_ERROR BeginProverAndSendMsg1(ComputeWSData & data, CHIP_ERROR status);
+
     CHIP_ERROR SendMsg1();
 
     CHIP_ERROR HandleMsg1_and_SendMsg2(System::PacketBufferHandle && msg);
@@ -220,6 +228,9 @@ private:
     uint16_t mSaltLength     = 0;
     uint8_t * mSalt          = nullptr;
 
+    // Outstanding PBKDF2 computation of w0 and w1 on the crypto work queue, see HandlePBKDFParamResponse.
+    Platform::SharedPtr<CryptoWorkHelper<PASESession, ComputeWSData>> mComputeWSHelper;
+
     struct Spake2pErrorMsg
     {
         Spake2pErrorType error;
@@ -63,12 +63,21 @@ CHIP_ERROR StatusReport::Parse(System::PacketBufferHandle buf)
     // Any data that exists after the required fields is considered protocol-specific data.
     if (bufReader.OctetsRead() < buf->DataLength())
     {
-        mProtocolData = System::PacketBufferHandle::NewWithData(buf->Start() + bufReader.OctetsRead(),
-                                                                buf->DataLength() - bufReader.OctetsRead(),
-                                                                /* aAdditionalSize = */ 0, /* aReservedSize = */ 0);
-        if (mProtocolData.IsNull())
+        if (buf.HasSoleOwnership() && !buf->HasChainedBuffer())
         {
-            return CHIP_ERROR_NO_MEMORY;
+            // The buffer is ours alone, so keep the protocol data where it is instead of copying it out.
+            buf->ConsumeHead(bufReader.OctetsRead());
+            mProtocolData = std::move(buf);
+        }
+        else
+        {
+            mProtocolData = System::PacketBufferHandle::NewWithData(buf->Start() + bufReader.OctetsRead(),
+                                                                    buf->DataLength() - bufReader.OctetsRead(),
+                                                                    /* aAdditionalSize = */ 0, /* aReservedSize = */ 0);
+            if (mProtocolData.IsNull())
+            {
+                return CHIP_ERROR_NO_MEMORY;
+            }
         }
     }
     else
@@ -40,8 +40,11 @@
 #include <nlunit-test.h>
 #include <protocols/secure_channel/CASEServer.h>
 #include <protocols/secure_channel/CASESession.h>
+#include <protocols/secure_channel/CryptoWorkQueue.h>
 #include <stdarg.h>
 
+#include <chrono>
+
 #include "credentials/tests/CHIPCert_test_vectors.h"
 
 using namespace chip;
@@ -382,6 +385,9 @@ public:
     static void SimulateUpdateNOCInvalidatePendingEstablishment(nlTestSuite * inSuite, void * inContext);
 #endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
     static void Sigma1BadDestinationIdTest(nlTestSuite * inSuite, void * inContext);
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    static void EstablishmentThroughputTest(nlTestSuite * inSuite, void * inContext);
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 };
 
 void TestCASESession::SecurePairingWaitTest(nlTestSuite * inSuite, void * inContext)
@@ -1212,6 +1218,124 @@ void TestCASESession::Sigma1BadDestinationIdTest(nlTestSuite * inSuite, void * i
     caseSession.Clear();
 }
 
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+namespace {
+
+constexpr size_t kConcurrentEstablishments = 4;
+
+// Hands each incoming Sigma1 to the next of several responder sessions, so that handshakes run concurrently.
+class ConcurrentAccessories : public Messaging::UnsolicitedMessageHandler
+{
+public:
+    CHIP_ERROR OnUnsolicitedMessageReceived(const PayloadHeader & payloadHeader, ExchangeDelegate *& newDelegate) override
+    {
+        VerifyOrReturnError(mNextSession < kConcurrentEstablishments, CHIP_ERROR_NO_MEMORY);
+        newDelegate = &mSessions[mNextSession++];
+        return CHIP_NO_ERROR;
+    }
+
+    CASESession mSessions[kConcurrentEstablishments];
+    TestCASESecurePairingDelegate mDelegates[kConcurrentEstablishments];
+    size_t mNextSession = 0;
+};
+
+// Run rounds of kConcurrentEstablishments concurrent handshakes, with the given number of crypto workers (none meaning that
+// the heavy steps run on the event loop), and return the number of establishments per second.
+double MeasureEstablishmentThroughput(nlTestSuite * inSuite, TestContext & ctx, size_t workerCount)
+{
+    constexpr int kRounds = 5;
+
+    ThreadPoolCryptoWorkQueue workQueue;
+    if (workerCount > 0)
+    {
+        NL_TEST_ASSERT(inSuite, workQueue.Init(workerCount) == CHIP_NO_ERROR);
+        SetCryptoWorkQueue(&workQueue);
+    }
+
+    size_t established = 0;
+    auto start         = std::chrono::steady_clock::now();
+    for (int round = 0; round < kRounds; round++)
+    {
+        TemporarySessionManager sessionManager(inSuite, ctx);
+        ConcurrentAccessories accessories;
+        CASESession commissioners[kConcurrentEstablishments];
+        TestCASESecurePairingDelegate commissionerDelegates[kConcurrentEstablishments];
+
+        NL_TEST_ASSERT(inSuite,
+                       ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(
+                           Protocols::SecureChannel::MsgType::CASE_Sigma1, &accessories) == CHIP_NO_ERROR);
+
+        for (size_t i = 0; i < kConcurrentEstablishments; i++)
+        {
+            accessories.mSessions[i].SetGroupDataProvider(&gDeviceGroupDataProvider);
+            NL_TEST_ASSERT(inSuite,
+                           accessories.mSessions[i].PrepareForSessionEstablishment(
+                               sessionManager, &gDeviceFabrics, nullptr, nullptr, &accessories.mDelegates[i], ScopedNodeId(),
+                               Optional<ReliableMessageProtocolConfig>::Missing()) == CHIP_NO_ERROR);
+
+            commissioners[i].SetGroupDataProvider(&gCommissionerGroupDataProvider);
+            ExchangeContext * context = ctx.NewUnauthenticatedExchangeToBob(&commissioners[i]);
+            NL_TEST_ASSERT(inSuite,
+                           commissioners[i].EstablishSession(sessionManager, &gCommissionerFabrics,
+                                                             ScopedNodeId{ Node01_01, gCommissionerFabricIndex }, context, nullptr,
+                                                             nullptr, &commissionerDelegates[i],
+                                                             Optional<ReliableMessageProtocolConfig>::Missing()) == CHIP_NO_ERROR);
+        }
+
+        // Results of the crypto workers come back to the event loop asynchronously.
+        auto roundStart = std::chrono::steady_clock::now();
+        size_t roundEstablished;
+        do
+        {
+            ServiceEvents(ctx);
+            roundEstablished = 0;
+            for (size_t i = 0; i < kConcurrentEstablishments; i++)
+            {
+                if (accessories.mDelegates[i].mNumPairingComplete == 1 && commissionerDelegates[i].mNumPairingComplete == 1)
+                {
+                    roundEstablished++;
+                }
+            }
+        } while (roundEstablished < kConcurrentEstablishments &&
+                 std::chrono::steady_clock::now() - roundStart < std::chrono::seconds(10));
+
+        for (size_t i = 0; i < kConcurrentEstablishments; i++)
+        {
+            NL_TEST_ASSERT(inSuite, accessories.mDelegates[i].mNumPairingErrors == 0);
+            NL_TEST_ASSERT(inSuite, commissionerDelegates[i].mNumPairingErrors == 0);
+        }
+        NL_TEST_ASSERT(inSuite, roundEstablished == kConcurrentEstablishments);
+        established += roundEstablished;
+
+        ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_Sigma1);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    if (workerCount > 0)
+    {
+        SetCryptoWorkQueue(nullptr);
+        workQueue.Shutdown();
+    }
+    return static_cast<double>(established) / elapsed.count();
+}
+
+} // namespace
+
+void TestCASESession::EstablishmentThroughputTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    for (size_t workerCount : { 0u, 1u, 2u, 4u })
+    {
+        double throughput = MeasureEstablishmentThroughput(inSuite, ctx, workerCount);
+        ChipLogProgress(SecureChannel, "%u concurrent CASE establishments, %u crypto workers: %.1f establishments/s",
+                        static_cast<unsigned>(kConcurrentEstablishments), static_cast<unsigned>(workerCount), throughput);
+    }
+}
+
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
 } // namespace chip
 
 // Test Suite
@@ -1236,6 +1360,9 @@ static const nlTest sTests[] =
     NL_TEST_DEF("InvalidatePendingSessionEstablishment", chip::TestCASESession::SimulateUpdateNOCInvalidatePendingEstablishment),
 #endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
     NL_TEST_DEF("Sigma1BadDestinationId", chip::TestCASESession::Sigma1BadDestinationIdTest),
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    NL_TEST_DEF("EstablishmentThroughput", chip::TestCASESession::EstablishmentThroughputTest),
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 
     NL_TEST_SENTINEL()
 };
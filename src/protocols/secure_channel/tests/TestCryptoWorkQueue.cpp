@@ -0,0 +1,137 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <protocols/secure_channel/CryptoWorkQueue.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+using namespace chip;
+
+namespace {
+
+std::atomic<unsigned> gRunCount{ 0 };
+std::atomic<bool> gBlocked{ false };
+
+void CountWork(intptr_t arg)
+{
+    reinterpret_cast<std::atomic<pthread_t> *>(arg)->store(pthread_self());
+    gRunCount++;
+}
+
+void BlockingWork(intptr_t)
+{
+    while (gBlocked.load())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    gRunCount++;
+}
+
+bool WaitForRunCount(unsigned count)
+{
+    auto start = std::chrono::steady_clock::now();
+    while (gRunCount.load() < count)
+    {
+        if (std::chrono::steady_clock::now() - start > std::chrono::seconds(5))
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+class TestCryptoWorkQueue : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        gRunCount = 0;
+        gBlocked  = false;
+    }
+};
+
+TEST_F(TestCryptoWorkQueue, TestInit)
+{
+    ThreadPoolCryptoWorkQueue queue;
+    std::atomic<pthread_t> thread;
+
+    EXPECT_EQ(queue.ScheduleWork(CountWork, reinterpret_cast<intptr_t>(&thread)), CHIP_ERROR_INCORRECT_STATE);
+    EXPECT_EQ(queue.Init(0), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(queue.Init(CHIP_CONFIG_CRYPTO_WORKER_MAX + 1), CHIP_ERROR_INVALID_ARGUMENT);
+
+    EXPECT_EQ(queue.Init(2), CHIP_NO_ERROR);
+    EXPECT_EQ(queue.GetWorkerCount(), 2u);
+    EXPECT_EQ(queue.Init(2), CHIP_ERROR_INCORRECT_STATE);
+
+    queue.Shutdown();
+    EXPECT_EQ(queue.GetWorkerCount(), 0u);
+    EXPECT_EQ(queue.ScheduleWork(CountWork, reinterpret_cast<intptr_t>(&thread)), CHIP_ERROR_INCORRECT_STATE);
+}
+
+TEST_F(TestCryptoWorkQueue, TestRunsOnWorker)
+{
+    ThreadPoolCryptoWorkQueue queue;
+    std::atomic<pthread_t> thread{ pthread_self() };
+
+    ASSERT_EQ(queue.Init(1), CHIP_NO_ERROR);
+    ASSERT_EQ(queue.ScheduleWork(CountWork, reinterpret_cast<intptr_t>(&thread)), CHIP_NO_ERROR);
+    EXPECT_TRUE(WaitForRunCount(1));
+    EXPECT_FALSE(pthread_equal(thread.load(), pthread_self()));
+    queue.Shutdown();
+}
+
+TEST_F(TestCryptoWorkQueue, TestQueueFull)
+{
+    ThreadPoolCryptoWorkQueue queue;
+    ASSERT_EQ(queue.Init(1), CHIP_NO_ERROR);
+
+    // Keep the single worker busy, then fill the queue.
+    gBlocked = true;
+    ASSERT_EQ(queue.ScheduleWork(BlockingWork, 0), CHIP_NO_ERROR);
+    while (queue.ScheduleWork(BlockingWork, 0) == CHIP_NO_ERROR)
+    {
+    }
+    EXPECT_EQ(queue.ScheduleWork(BlockingWork, 0), CHIP_ERROR_NO_MEMORY);
+
+    // Shutting down runs all the pending work.
+    gBlocked = false;
+    queue.Shutdown();
+    EXPECT_GE(gRunCount.load(), static_cast<unsigned>(CHIP_CONFIG_CRYPTO_WORK_QUEUE_SIZE));
+    EXPECT_LE(gRunCount.load(), static_cast<unsigned>(CHIP_CONFIG_CRYPTO_WORK_QUEUE_SIZE + 1));
+}
+
+TEST_F(TestCryptoWorkQueue, TestSetCryptoWorkQueue)
+{
+    ThreadPoolCryptoWorkQueue queue;
+
+    EXPECT_EQ(GetCryptoWorkQueue(), nullptr);
+    SetCryptoWorkQueue(&queue);
+    EXPECT_EQ(GetCryptoWorkQueue(), &queue);
+    SetCryptoWorkQueue(nullptr);
+    EXPECT_EQ(GetCryptoWorkQueue(), nullptr);
+}
+
+} // namespace
+
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
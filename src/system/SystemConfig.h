@@ -375,6 +375,77 @@
 #define CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE 15
 #endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SMALL_SIZE
+ *
+ *  @brief
+ *      When packet buffers are allocated from the heap (CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE is 0), this is the
+ *      largest allocation size (reserve plus data, excluding the PacketBuffer structure) served from the small size class
+ *      of the packet buffer heap cache.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SMALL_SIZE
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SMALL_SIZE 256
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SMALL_SIZE */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_MEDIUM_SIZE
+ *
+ *  @brief
+ *      The largest allocation size served from the medium size class of the packet buffer heap cache. Larger allocations,
+ *      up to \c PacketBuffer::kMaxSizeWithoutReserve, are served from the large size class.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_MEDIUM_SIZE
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_MEDIUM_SIZE 768
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_MEDIUM_SIZE */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SMALL_COUNT
+ *
+ *  @brief
+ *      The maximum number of freed small packet buffers kept for reuse instead of being returned to the heap.
+ *
+ *      The small, medium and large counts cap the memory held by the packet buffer heap cache. With POSIX locking, each
+ *      thread caches up to this many buffers without locking, and a shared cache holds up to as many more; otherwise only
+ *      the shared cache is used. Setting a count to zero (0) disables its size class, whose allocations then use
+ *      exactly-sized heap blocks; setting all of them to zero disables the cache, which is the default without POSIX
+ *      locking.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SMALL_COUNT
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SMALL_COUNT 8
+#else
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SMALL_COUNT 0
+#endif
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SMALL_COUNT */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_MEDIUM_COUNT
+ *
+ *  @brief
+ *      The maximum number of freed medium packet buffers kept for reuse instead of being returned to the heap.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_MEDIUM_COUNT
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_MEDIUM_COUNT 4
+#else
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_MEDIUM_COUNT 0
+#endif
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_MEDIUM_COUNT */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_LARGE_COUNT
+ *
+ *  @brief
+ *      The maximum number of freed large packet buffers kept for reuse instead of being returned to the heap.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_LARGE_COUNT
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_LARGE_COUNT 8
+#else
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_LARGE_COUNT 0
+#endif
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_LARGE_COUNT */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_LWIP_PBUF_RAM
  *
@@ -533,6 +604,20 @@ struct LwIPEvent;
 #define CHIP_SYSTEM_CONFIG_TEST 0
 #endif
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_COPY_STATS
+ *
+ *  @brief
+ *      This defines whether (1) or not (0) packet buffers keep cumulative counts of allocations and payload copies, so that
+ *      message paths that are meant to be zero-copy (e.g. received message dispatch) can be verified.
+ *
+ *      The counters are not synchronized and are only meaningful when read from the thread that owns the CHIP stack, so they
+ *      are only kept by default in builds with testing aids.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_COPY_STATS
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_COPY_STATS CHIP_SYSTEM_CONFIG_TEST
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_COPY_STATS
+
 // clang-format on
 
 // Configuration parameters with header inclusion dependencies
@@ -788,3 +873,15 @@ struct LwIPEvent;
 #define CHIP_SYSTEM_CONFIG_USE_ZEPHYR_EVENTFD 0
 #endif
 #endif // CHIP_SYSTEM_CONFIG_USE_ZEPHYR_EVENTFD
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_USE_EPOLL
+ *
+ *  @brief
+ *      Use LayerImplEpoll, built on epoll and timerfd, as System::LayerImpl instead of LayerImplSelect.
+ *
+ *  Set by the build when chip_system_config_event_loop is "Epoll". Only available on Linux with POSIX sockets.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_USE_EPOLL
+#define CHIP_SYSTEM_CONFIG_USE_EPOLL 0
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
@@ -0,0 +1,545 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements Layer using epoll() and timerfd.
+ */
+
+#include <lib/support/CodeUtils.h>
+#include <platform/LockTracker.h>
+#include <system/SystemFaultInjection.h>
+#include <system/SystemLayer.h>
+#include <system/SystemLayerImplEpoll.h>
+
+#include <errno.h>
+#include <poll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+// Choose an approximation of PTHREAD_NULL if pthread.h doesn't define one.
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING && !defined(PTHREAD_NULL)
+#define PTHREAD_NULL 0
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING && !defined(PTHREAD_NULL)
+
+namespace chip {
+namespace System {
+
+namespace {
+
+// Marks the timerfd in epoll events; socket watches are marked by their address.
+constexpr uint64_t kTimerFdTag = UINT64_MAX;
+
+} // namespace
+
+CHIP_ERROR LayerImplEpoll::Init()
+{
+    VerifyOrReturnError(mLayerState.SetInitializing(), CHIP_ERROR_INCORRECT_STATE);
+
+    RegisterPOSIXErrorFormatter();
+
+    for (auto & w : mSocketWatchPool)
+    {
+        w.Clear();
+    }
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleEventsThread = PTHREAD_NULL;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    struct epoll_event event = {};
+
+    mEpollFd = epoll_create1(EPOLL_CLOEXEC);
+    VerifyOrReturnError(mEpollFd >= 0, CHIP_ERROR_POSIX(errno));
+
+    mTimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    VerifyOrExit(mTimerFd >= 0, err = CHIP_ERROR_POSIX(errno));
+    mArmedAwakenTime = Clock::kZero;
+
+    event.events   = EPOLLIN;
+    event.data.u64 = kTimerFdTag;
+    VerifyOrExit(epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mTimerFd, &event) == 0, err = CHIP_ERROR_POSIX(errno));
+
+    // Create an event to allow an arbitrary thread to wake the thread in the event loop.
+    SuccessOrExit(err = mWakeEvent.Open(*this));
+
+    VerifyOrReturnError(mLayerState.SetInitialized(), CHIP_ERROR_INCORRECT_STATE);
+    return CHIP_NO_ERROR;
+
+exit:
+    // Don't leak the descriptors opened so far; Shutdown() is not reachable from the Initializing state.
+    if (mTimerFd >= 0)
+    {
+        close(mTimerFd);
+        mTimerFd = -1;
+    }
+    close(mEpollFd);
+    mEpollFd = -1;
+    return err;
+}
+
+void LayerImplEpoll::Shutdown()
+{
+    VerifyOrReturn(mLayerState.SetShuttingDown());
+
+    mTimerList.Clear();
+    mTimerPool.ReleaseAll();
+
+    mWakeEvent.Close(*this);
+
+    for (auto & w : mSocketWatchPool)
+    {
+        w.Clear();
+    }
+
+    close(mTimerFd);
+    mTimerFd = -1;
+    close(mEpollFd);
+    mEpollFd = -1;
+
+    mLayerState.ResetFromShuttingDown(); // Return to uninitialized state to permit re-initialization.
+}
+
+void LayerImplEpoll::Signal()
+{
+    /*
+     * Wake up the I/O thread through the wake event.
+     *
+     * If this is being called from within an I/O event callback, then notifying the event can be skipped,
+     * since the I/O thread is already awake.
+     */
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    if (pthread_equal(mHandleEventsThread, pthread_self()))
+    {
+        return;
+    }
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    CHIP_ERROR status = mWakeEvent.Notify();
+    if (status != CHIP_NO_ERROR)
+    {
+        ChipLogError(chipSystemLayer, "System wake event notify failed: %" CHIP_ERROR_FORMAT, status.Format());
+    }
+}
+
+CHIP_ERROR LayerImplEpoll::StartTimer(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturnError(mLayerState.IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+
+    CHIP_SYSTEM_FAULT_INJECT(FaultInjection::kFault_TimeoutImmediate, delay = System::Clock::kZero);
+
+    CancelTimer(onComplete, appState);
+
+    TimerList::Node * timer = mTimerPool.Create(*this, SystemClock().GetMonotonicTimestamp() + delay, onComplete, appState);
+    VerifyOrReturnError(timer != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    if (mTimerList.Add(timer) == timer)
+    {
+        // The new timer is the earliest, so the timerfd has to be rearmed.
+        Signal();
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::ExtendTimerTo(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState)
+{
+    VerifyOrReturnError(delay.count() > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    assertChipStackLockedByCurrentThread();
+
+    Clock::Timeout remainingTime = mTimerList.GetRemainingTime(onComplete, appState);
+    if (remainingTime.count() < delay.count())
+    {
+        if (remainingTime == Clock::kZero)
+        {
+            // If remaining time is Clock::kZero, it might possible that our timer is in
+            // the mExpiredTimers list and about to be fired. Remove it from that list, since we are extending it.
+            mExpiredTimers.Remove(onComplete, appState);
+        }
+        return StartTimer(delay, onComplete, appState);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+bool LayerImplEpoll::IsTimerActive(TimerCompleteCallback onComplete, void * appState)
+{
+    bool timerIsActive = (mTimerList.GetRemainingTime(onComplete, appState) > Clock::kZero);
+
+    if (!timerIsActive)
+    {
+        // check if the timer is in the mExpiredTimers list about to be fired.
+        for (TimerList::Node * timer = mExpiredTimers.Earliest(); timer != nullptr; timer = timer->mNextTimer)
+        {
+            if (timer->GetCallback().GetOnComplete() == onComplete && timer->GetCallback().GetAppState() == appState)
+            {
+                return true;
+            }
+        }
+    }
+
+    return timerIsActive;
+}
+
+Clock::Timeout LayerImplEpoll::GetRemainingTime(TimerCompleteCallback onComplete, void * appState)
+{
+    return mTimerList.GetRemainingTime(onComplete, appState);
+}
+
+void LayerImplEpoll::CancelTimer(TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturn(mLayerState.IsInitialized());
+
+    TimerList::Node * timer = mTimerList.Remove(onComplete, appState);
+    if (timer == nullptr)
+    {
+        // The timer was not in our "will fire in the future" list, but it might
+        // be in the "we're about to fire these" chunk we already grabbed from
+        // that list.  Check for it there too, and if found there we still want
+        // to cancel it.
+        timer = mExpiredTimers.Remove(onComplete, appState);
+    }
+    VerifyOrReturn(timer != nullptr);
+
+    mTimerPool.Release(timer);
+    Signal();
+}
+
+CHIP_ERROR LayerImplEpoll::ScheduleWork(TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturnError(mLayerState.IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+
+    // As in LayerImplSelect, use an expires-ASAP timer as the closure, without cancelling existing timers with the same
+    // callback and appState.
+    TimerList::Node * timer = mTimerPool.Create(*this, SystemClock().GetMonotonicTimestamp(), onComplete, appState);
+    VerifyOrReturnError(timer != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    if (mTimerList.Add(timer) == timer)
+    {
+        // The new timer is the earliest, so the time until the next event has probably changed.
+        Signal();
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::StartWatchingSocket(int fd, SocketWatchToken * tokenOut)
+{
+    // Find a free slot.
+    SocketWatch * watch = nullptr;
+    for (auto & w : mSocketWatchPool)
+    {
+        if (w.mFD == kInvalidFd)
+        {
+            watch = &w;
+            break;
+        }
+    }
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_ENDPOINT_POOL_FULL);
+
+    // Register for everything once, so that requesting or clearing callbacks never needs epoll_ctl().
+    struct epoll_event event = {};
+    event.events             = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    event.data.ptr           = watch;
+    if (epoll_ctl(mEpollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+    {
+        // Duplicate registration is an error.
+        return (errno == EEXIST) ? CHIP_ERROR_INVALID_ARGUMENT : CHIP_ERROR_POSIX(errno);
+    }
+
+    watch->mFD = fd;
+
+    *tokenOut = reinterpret_cast<SocketWatchToken>(watch);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::SetCallback(SocketWatchToken token, SocketWatchCallback callback, intptr_t data)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mCallback     = callback;
+    watch->mCallbackData = data;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::RequestCallbackOnPendingRead(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Set(SocketEventFlags::kRead);
+
+    // The edge may have been reported before the callback was requested.
+    MarkReady(*watch);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::RequestCallbackOnPendingWrite(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Set(SocketEventFlags::kWrite);
+
+    // The edge may have been reported before the callback was requested.
+    MarkReady(*watch);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::ClearCallbackOnPendingRead(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Clear(SocketEventFlags::kRead);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::ClearCallbackOnPendingWrite(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Clear(SocketEventFlags::kWrite);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::StopWatchingSocket(SocketWatchToken * tokenInOut)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(*tokenInOut);
+    *tokenInOut         = InvalidSocketWatchToken();
+
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(watch->mFD >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    // The socket may already be closed, in which case epoll already forgot it.
+    (void) epoll_ctl(mEpollFd, EPOLL_CTL_DEL, watch->mFD, nullptr);
+    watch->Clear();
+    return CHIP_NO_ERROR;
+}
+
+SocketEvents LayerImplEpoll::SocketEventsFromEpoll(uint32_t events)
+{
+    SocketEvents res;
+
+    // As with select(), errors and hang-ups make a socket both readable and writable, so that the next operation on it
+    // reports them.
+    if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+    {
+        res.Set(SocketEventFlags::kRead);
+    }
+    if (events & (EPOLLOUT | EPOLLHUP | EPOLLERR))
+    {
+        res.Set(SocketEventFlags::kWrite);
+    }
+    return res;
+}
+
+void LayerImplEpoll::MarkReady(SocketWatch & watch)
+{
+    if (watch.ReadyEvents().HasAny() && !watch.IsInList())
+    {
+        mReadyWatches.PushBack(&watch);
+    }
+}
+
+void LayerImplEpoll::RefreshReadyWatches()
+{
+    // Check which of the sockets whose callbacks were invoked still have data or space: only those are still ready, the
+    // others will get another edge from epoll when they become ready again.
+    struct pollfd fds[kSocketWatchMax];
+    nfds_t count = 0;
+    for (auto & w : mReadyWatches)
+    {
+        fds[count].fd      = w.mFD;
+        fds[count].events  = POLLIN | POLLOUT;
+        fds[count].revents = 0;
+        count++;
+    }
+
+    if (poll(fds, count, 0) < 0)
+    {
+        // Keep every watch ready: at worst, the callbacks are invoked once more for nothing.
+        return;
+    }
+
+    nfds_t index = 0;
+    for (auto it = mReadyWatches.begin(); it != mReadyWatches.end(); index++)
+    {
+        SocketWatch & w = *it;
+        ++it;
+
+        uint32_t events = 0;
+        events |= (fds[index].revents & POLLIN) ? EPOLLIN : 0u;
+        events |= (fds[index].revents & POLLOUT) ? EPOLLOUT : 0u;
+        events |= (fds[index].revents & POLLHUP) ? EPOLLHUP : 0u;
+        events |= (fds[index].revents & (POLLERR | POLLNVAL)) ? EPOLLERR : 0u;
+        w.mReadyIO = SocketEventsFromEpoll(events);
+        if (!w.ReadyEvents().HasAny())
+        {
+            w.Unlink();
+        }
+    }
+}
+
+void LayerImplEpoll::ArmTimer(Clock::Timestamp currentTime)
+{
+    TimerList::Node * timer = mTimerList.Earliest();
+    if (timer == nullptr)
+    {
+        if (mArmedAwakenTime != Clock::kZero)
+        {
+            const struct itimerspec disarm = {};
+            (void) timerfd_settime(mTimerFd, 0, &disarm, nullptr);
+            mArmedAwakenTime = Clock::kZero;
+        }
+        return;
+    }
+
+    if (timer->AwakenTime() <= currentTime)
+    {
+        mWaitTimeout = 0;
+        return;
+    }
+    VerifyOrReturn(timer->AwakenTime() != mArmedAwakenTime);
+
+    // Arm relatively to the system clock rather than absolutely on CLOCK_MONOTONIC, as select() does with its timeout,
+    // so that a mock system clock in tests keeps working.
+    const Clock::Microseconds64 delay = std::chrono::duration_cast<Clock::Microseconds64>(timer->AwakenTime() - currentTime);
+    struct itimerspec spec            = {};
+    spec.it_value.tv_sec              = static_cast<time_t>(delay.count() / 1000000);
+    spec.it_value.tv_nsec             = static_cast<long>((delay.count() % 1000000) * 1000);
+    if (timerfd_settime(mTimerFd, 0, &spec, nullptr) != 0)
+    {
+        ChipLogError(chipSystemLayer, "timerfd_settime failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+        // Fall back on polling the timers.
+        mWaitTimeout     = static_cast<int>(std::chrono::duration_cast<Clock::Milliseconds32>(delay).count());
+        mArmedAwakenTime = Clock::kZero;
+        return;
+    }
+    mArmedAwakenTime = timer->AwakenTime();
+}
+
+void LayerImplEpoll::PrepareEvents()
+{
+    assertChipStackLockedByCurrentThread();
+
+    mWaitTimeout = -1;
+
+    if (!mReadyWatches.Empty())
+    {
+        RefreshReadyWatches();
+        if (!mReadyWatches.Empty())
+        {
+            mWaitTimeout = 0;
+        }
+    }
+
+    ArmTimer(SystemClock().GetMonotonicTimestamp());
+}
+
+void LayerImplEpoll::WaitForEvents()
+{
+    mEventCount = epoll_wait(mEpollFd, mEvents, kMaxEvents, mWaitTimeout);
+    mWaitErrno  = errno;
+}
+
+void LayerImplEpoll::HandleEvents()
+{
+    assertChipStackLockedByCurrentThread();
+
+    if (mEventCount < 0)
+    {
+        if (mWaitErrno != EINTR)
+        {
+            ChipLogError(DeviceLayer, "epoll_wait failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(mWaitErrno).Format());
+        }
+        return;
+    }
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleEventsThread = pthread_self();
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    // Record the readiness reported by epoll before invoking any callback, so that no event refers to a watch stopped
+    // by a callback.
+    for (int i = 0; i < mEventCount; i++)
+    {
+        if (mEvents[i].data.u64 == kTimerFdTag)
+        {
+            uint64_t expirations;
+            (void) read(mTimerFd, &expirations, sizeof(expirations));
+            mArmedAwakenTime = Clock::kZero;
+            continue;
+        }
+
+        SocketWatch & watch = *static_cast<SocketWatch *>(mEvents[i].data.ptr);
+        watch.mReadyIO.Set(SocketEventsFromEpoll(mEvents[i].events));
+        MarkReady(watch);
+    }
+    mEventCount = 0;
+
+    // Obtain the list of currently expired timers. Any new timers added by timer callback are NOT handled on this pass,
+    // since that could result in infinite handling of new timers blocking any other progress.
+    VerifyOrDieWithMsg(mExpiredTimers.Empty(), DeviceLayer, "Re-entry into HandleEvents from a timer callback?");
+    mExpiredTimers          = mTimerList.ExtractEarlier(Clock::Timeout(1) + SystemClock().GetMonotonicTimestamp());
+    TimerList::Node * timer = nullptr;
+    while ((timer = mExpiredTimers.PopEarliest()) != nullptr)
+    {
+        mTimerPool.Invoke(timer);
+    }
+
+    // Callbacks may stop or request callbacks on any watch, so move the watches one by one back to the ready list
+    // before invoking them: a stopped watch unlinks itself from whichever list it is in.
+    SocketWatchList dispatching(std::move(mReadyWatches));
+    while (!dispatching.Empty())
+    {
+        SocketWatch & w = *dispatching.begin();
+        w.Unlink();
+        mReadyWatches.PushBack(&w);
+
+        SocketEvents events = w.ReadyEvents();
+        if (events.HasAny() && w.mCallback != nullptr)
+        {
+            w.mCallback(events, w.mCallbackData);
+        }
+    }
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleEventsThread = PTHREAD_NULL;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+}
+
+void LayerImplEpoll::SocketWatch::Clear()
+{
+    Unlink();
+    mFD = kInvalidFd;
+    mPendingIO.ClearAll();
+    mReadyIO.ClearAll();
+    mCallback     = nullptr;
+    mCallbackData = 0;
+}
+
+} // namespace System
+} // namespace chip
@@ -0,0 +1,154 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file declares an implementation of System::Layer using epoll() and timerfd.
+ */
+
+#pragma once
+
+#include "system/SystemConfig.h"
+
+#if !CHIP_SYSTEM_CONFIG_USE_POSIX_SOCKETS || CHIP_SYSTEM_CONFIG_USE_DISPATCH || CHIP_SYSTEM_CONFIG_USE_LIBEV
+#error "LayerImplEpoll requires POSIX sockets, without dispatch or libev"
+#endif
+
+#include <sys/epoll.h>
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#include <atomic>
+#include <pthread.h>
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+#include <lib/support/IntrusiveList.h>
+#include <lib/support/ObjectLifeCycle.h>
+#include <system/SystemLayer.h>
+#include <system/SystemLayerImplSelect.h>
+#include <system/SystemTimer.h>
+#include <system/WakeEvent.h>
+
+namespace chip {
+namespace System {
+
+/**
+ * System::Layer event loop waiting with epoll_wait() instead of select(), so that the cost of a wakeup depends on the
+ * number of ready sockets rather than on the number of watched ones, and file descriptors are not limited to FD_SETSIZE.
+ *
+ * Sockets are registered once, edge-triggered, for both reads and writes: requesting or clearing callbacks does not
+ * make any system call. The socket endpoints only consume part of the pending data in a callback, so a socket reported
+ * ready stays ready, and its callback keeps being invoked on each loop iteration, until a poll() of the ready sockets
+ * shows it is not anymore.
+ *
+ * The earliest timer arms a timerfd, which epoll_wait() also waits on.
+ */
+class LayerImplEpoll : public LayerSocketsLoop
+{
+public:
+    LayerImplEpoll() = default;
+    ~LayerImplEpoll() override { VerifyOrDie(mLayerState.Destroy()); }
+
+    // Layer overrides.
+    CHIP_ERROR Init() override;
+    void Shutdown() override;
+    bool IsInitialized() const override { return mLayerState.IsInitialized(); }
+    CHIP_ERROR StartTimer(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState) override;
+    CHIP_ERROR ExtendTimerTo(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState) override;
+    bool IsTimerActive(TimerCompleteCallback onComplete, void * appState) override;
+    Clock::Timeout GetRemainingTime(TimerCompleteCallback onComplete, void * appState) override;
+    void CancelTimer(TimerCompleteCallback onComplete, void * appState) override;
+    CHIP_ERROR ScheduleWork(TimerCompleteCallback onComplete, void * appState) override;
+
+    // LayerSocket overrides.
+    CHIP_ERROR StartWatchingSocket(int fd, SocketWatchToken * tokenOut) override;
+    CHIP_ERROR SetCallback(SocketWatchToken token, SocketWatchCallback callback, intptr_t data) override;
+    CHIP_ERROR RequestCallbackOnPendingRead(SocketWatchToken token) override;
+    CHIP_ERROR RequestCallbackOnPendingWrite(SocketWatchToken token) override;
+    CHIP_ERROR ClearCallbackOnPendingRead(SocketWatchToken token) override;
+    CHIP_ERROR ClearCallbackOnPendingWrite(SocketWatchToken token) override;
+    CHIP_ERROR StopWatchingSocket(SocketWatchToken * tokenInOut) override;
+    SocketWatchToken InvalidSocketWatchToken() override { return reinterpret_cast<SocketWatchToken>(nullptr); }
+
+    // LayerSocketLoop overrides.
+    void Signal() override;
+    void EventLoopBegins() override {}
+    void PrepareEvents() override;
+    void WaitForEvents() override;
+    void HandleEvents() override;
+    void EventLoopEnds() override {}
+
+protected:
+    static constexpr int kSocketWatchMax = (INET_CONFIG_ENABLE_TCP_ENDPOINT ? INET_CONFIG_NUM_TCP_ENDPOINTS : 0) +
+        (INET_CONFIG_ENABLE_UDP_ENDPOINT ? INET_CONFIG_NUM_UDP_ENDPOINTS : 0);
+    // Every watched socket and the timerfd can be reported by a single epoll_wait().
+    static constexpr int kMaxEvents = kSocketWatchMax + 1;
+
+    struct SocketWatch : public IntrusiveListNodeBase<IntrusiveMode::AutoUnlink>
+    {
+        void Clear();
+        // Events requested and not known to have been consumed since epoll last reported them.
+        SocketEvents ReadyEvents() const { return SocketEvents(static_cast<uint8_t>(mPendingIO.Raw() & mReadyIO.Raw())); }
+
+        int mFD;
+        SocketEvents mPendingIO;
+        SocketEvents mReadyIO;
+        SocketWatchCallback mCallback;
+        intptr_t mCallbackData;
+    };
+    using SocketWatchList = IntrusiveList<SocketWatch, IntrusiveMode::AutoUnlink>;
+
+    static SocketEvents SocketEventsFromEpoll(uint32_t events);
+    void MarkReady(SocketWatch & watch);
+    void RefreshReadyWatches();
+    void ArmTimer(Clock::Timestamp currentTime);
+
+    SocketWatch mSocketWatchPool[kSocketWatchMax];
+    // Watches with ready events requested, whose callbacks are invoked by the next HandleEvents().
+    SocketWatchList mReadyWatches;
+
+    TimerPool<TimerList::Node> mTimerPool;
+    TimerList mTimerList;
+    // List of expired timers being processed right now.  Stored in a member so
+    // we can cancel them.
+    TimerList mExpiredTimers;
+
+    int mEpollFd = -1;
+    int mTimerFd = -1;
+    // Awaken time the timerfd is armed for, zero if disarmed.
+    Clock::Timestamp mArmedAwakenTime = Clock::kZero;
+    // Timeout of the next epoll_wait(), in milliseconds: 0 when events are already known to be ready, -1 otherwise.
+    int mWaitTimeout = -1;
+
+    // Result of epoll_wait(), carried between WaitForEvents() and HandleEvents().
+    struct epoll_event mEvents[kMaxEvents];
+    int mEventCount = 0;
+    int mWaitErrno  = 0;
+
+    ObjectLifeCycle mLayerState;
+    WakeEvent mWakeEvent;
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    std::atomic<pthread_t> mHandleEventsThread;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+};
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+using LayerImpl = LayerImplEpoll;
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
+} // namespace System
+} // namespace chip
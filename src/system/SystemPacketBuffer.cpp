@@ -61,6 +61,10 @@
 namespace chip {
 namespace System {
 
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_COPY_STATS
+PacketBufferCounters PacketBuffer::sCounters;
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_COPY_STATS
+
 #if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
 //
 // Pool allocation for PacketBuffer objects.
@@ -109,6 +113,261 @@ PacketBuffer * PacketBuffer::BuildFreeList()
 // Heap allocation for PacketBuffer objects.
 //
 
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+//
+// Freed heap packet buffers are kept on per-size-class free lists, so that steady-state message traffic reuses blocks
+// instead of going through the heap allocator for every buffer. Each class serves allocation sizes up to its capacity
+// with blocks of exactly that capacity; alloc_size keeps recording the requested size, so a buffer's class can always be
+// recovered from it.
+//
+// With CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE_PER_THREAD, each thread uses its own lists without locking, in front of the
+// shared lists, which take a thread's overflow and, when the thread exits, as many of its remaining buffers as they have
+// room for. A thread may exit after Platform::MemoryShutdown(), so the rest are set aside rather than freed there. The
+// platform shutdown returns the shared lists, the buffers set aside and the calling thread's lists to the heap (see
+// PacketBuffer::ReleaseHeapCache()), ahead of Platform::MemoryShutdown(); the lists of the threads that are still running
+// then are only handed over when those threads exit.
+//
+
+namespace {
+
+struct HeapCacheClass
+{
+    size_t mCapacity;
+    uint8_t mMaxCount;
+    Stats::count_t mStatsEntry;
+};
+
+constexpr HeapCacheClass kHeapCacheClasses[] = {
+    { CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SMALL_SIZE, CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SMALL_COUNT,
+      Stats::kSystemLayer_NumCachedSmallPacketBufs },
+    { CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_MEDIUM_SIZE, CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_MEDIUM_COUNT,
+      Stats::kSystemLayer_NumCachedMediumPacketBufs },
+    { PacketBuffer::kMaxSizeWithoutReserve, CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_LARGE_COUNT,
+      Stats::kSystemLayer_NumCachedLargePacketBufs },
+};
+
+static_assert(CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SMALL_SIZE < CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_MEDIUM_SIZE &&
+                  CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_MEDIUM_SIZE < PacketBuffer::kMaxSizeWithoutReserve,
+              "Packet buffer heap cache size classes must be increasing");
+static_assert(CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SMALL_COUNT <= CHIP_SYS_STATS_COUNT_MAX &&
+                  CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_MEDIUM_COUNT <= CHIP_SYS_STATS_COUNT_MAX &&
+                  CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_LARGE_COUNT <= CHIP_SYS_STATS_COUNT_MAX,
+              "Packet buffer heap cache counts must fit in a statistics counter");
+
+constexpr size_t kHeapCacheClassCount = ArraySize(kHeapCacheClasses);
+constexpr size_t kNoHeapCacheClass    = kHeapCacheClassCount;
+
+// Returns the index of the size class serving aAllocSize, or kNoHeapCacheClass if it is served by an exactly-sized block.
+size_t HeapCacheClassFor(size_t aAllocSize)
+{
+    for (size_t i = 0; i < kHeapCacheClassCount; i++)
+    {
+        if (kHeapCacheClasses[i].mMaxCount > 0 && aAllocSize <= kHeapCacheClasses[i].mCapacity)
+        {
+            return i;
+        }
+    }
+    return kNoHeapCacheClass;
+}
+
+#if !CHIP_SYSTEM_CONFIG_NO_LOCKING
+Mutex & SharedHeapCacheMutex()
+{
+    static Mutex sMutex;
+    static const bool sInitialized = (Mutex::Init(sMutex) == CHIP_NO_ERROR);
+    VerifyOrDie(sInitialized);
+    return sMutex;
+}
+
+#define LOCK_SHARED_HEAP_CACHE() SharedHeapCacheMutex().Lock()
+#define UNLOCK_SHARED_HEAP_CACHE() SharedHeapCacheMutex().Unlock()
+#else // !CHIP_SYSTEM_CONFIG_NO_LOCKING
+#define LOCK_SHARED_HEAP_CACHE()                                                                                                   \
+    do                                                                                                                             \
+    {                                                                                                                              \
+    } while (0)
+#define UNLOCK_SHARED_HEAP_CACHE()                                                                                                 \
+    do                                                                                                                             \
+    {                                                                                                                              \
+    } while (0)
+#endif // !CHIP_SYSTEM_CONFIG_NO_LOCKING
+
+} // namespace
+
+class PacketBuffer::HeapCache
+{
+public:
+    size_t Count(size_t aClass) const { return mCount[aClass]; }
+
+    // Removes and returns a block of the given class, or returns nullptr if there is none.
+    PacketBuffer * Take(size_t aClass)
+    {
+        PacketBuffer * lPacket = mFreeList[aClass];
+        if (lPacket != nullptr)
+        {
+            mFreeList[aClass] = lPacket->ChainedBuffer();
+            mCount[aClass]--;
+            SYSTEM_STATS_DECREMENT(kHeapCacheClasses[aClass].mStatsEntry);
+        }
+        return lPacket;
+    }
+
+    // Keeps a block of the given class, unless the class already holds its maximum count.
+    bool Keep(PacketBuffer * aPacket, size_t aClass)
+    {
+        if (mCount[aClass] >= kHeapCacheClasses[aClass].mMaxCount)
+        {
+            return false;
+        }
+        Push(aPacket, aClass);
+        SYSTEM_STATS_INCREMENT(kHeapCacheClasses[aClass].mStatsEntry);
+        return true;
+    }
+
+    // Moves every block to aCache, up to its maximum counts, and sets the rest aside in aCache. Never frees: this runs when a
+    // thread exits, which may be after Platform::MemoryShutdown().
+    void MoveTo(HeapCache & aCache)
+    {
+        for (size_t i = 0; i < kHeapCacheClassCount; i++)
+        {
+            PacketBuffer * lPacket;
+            while ((lPacket = Take(i)) != nullptr)
+            {
+                if (!aCache.Keep(lPacket, i))
+                {
+                    lPacket->next    = aCache.mSetAside;
+                    aCache.mSetAside = lPacket;
+                }
+            }
+        }
+    }
+
+    // Returns every block to the heap, including the ones set aside.
+    void Release()
+    {
+        for (size_t i = 0; i < kHeapCacheClassCount; i++)
+        {
+            PacketBuffer * lPacket;
+            while ((lPacket = Take(i)) != nullptr)
+            {
+                chip::Platform::MemoryFree(lPacket);
+            }
+        }
+        while (mSetAside != nullptr)
+        {
+            PacketBuffer * lPacket = mSetAside;
+            mSetAside              = lPacket->ChainedBuffer();
+            chip::Platform::MemoryFree(lPacket);
+        }
+    }
+
+private:
+    void Push(PacketBuffer * aPacket, size_t aClass)
+    {
+        aPacket->next     = mFreeList[aClass];
+        mFreeList[aClass] = aPacket;
+        mCount[aClass]++;
+    }
+
+    PacketBuffer * mFreeList[kHeapCacheClassCount] = {};
+    size_t mCount[kHeapCacheClassCount]            = {};
+    PacketBuffer * mSetAside                       = nullptr; // Blocks that did not fit in MoveTo(), kept until Release().
+};
+
+PacketBuffer::HeapCache PacketBuffer::sSharedHeapCache;
+
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE_PER_THREAD
+class PacketBuffer::ThreadHeapCache : public PacketBuffer::HeapCache
+{
+public:
+    ~ThreadHeapCache()
+    {
+        LOCK_SHARED_HEAP_CACHE();
+        MoveTo(sSharedHeapCache);
+        UNLOCK_SHARED_HEAP_CACHE();
+    }
+};
+
+thread_local PacketBuffer::ThreadHeapCache PacketBuffer::sThreadHeapCache;
+#endif // CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE_PER_THREAD
+
+size_t PacketBuffer::HeapCacheCount(size_t aClass)
+{
+    LOCK_SHARED_HEAP_CACHE();
+    size_t lCount = sSharedHeapCache.Count(aClass);
+    UNLOCK_SHARED_HEAP_CACHE();
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE_PER_THREAD
+    lCount += sThreadHeapCache.Count(aClass);
+#endif
+    return lCount;
+}
+
+#endif // CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+
+/**
+ * Allocate the memory for a packet buffer with aAllocSize bytes of reserve and data space, reusing a cached block of the
+ * matching size class when one is available. The caller sets up the buffer, including alloc_size.
+ */
+PacketBuffer * PacketBuffer::HeapAlloc(size_t aAllocSize)
+{
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+    const size_t lClass = HeapCacheClassFor(aAllocSize);
+    if (lClass != kNoHeapCacheClass)
+    {
+        PacketBuffer * lPacket;
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE_PER_THREAD
+        lPacket = sThreadHeapCache.Take(lClass);
+        if (lPacket != nullptr)
+        {
+            return lPacket;
+        }
+#endif // CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE_PER_THREAD
+
+        LOCK_SHARED_HEAP_CACHE();
+        lPacket = sSharedHeapCache.Take(lClass);
+        UNLOCK_SHARED_HEAP_CACHE();
+        if (lPacket != nullptr)
+        {
+            return lPacket;
+        }
+        aAllocSize = kHeapCacheClasses[lClass].mCapacity;
+    }
+#endif // CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+
+    return reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(kStructureSize + aAllocSize));
+}
+
+/**
+ * Release the memory of a packet buffer whose alloc_size was aAllocSize, keeping it for reuse if its size class is not full.
+ */
+void PacketBuffer::HeapFree(PacketBuffer * aPacket, size_t aAllocSize)
+{
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+    const size_t lClass = HeapCacheClassFor(aAllocSize);
+    if (lClass != kNoHeapCacheClass)
+    {
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE_PER_THREAD
+        if (sThreadHeapCache.Keep(aPacket, lClass))
+        {
+            return;
+        }
+#endif // CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE_PER_THREAD
+
+        LOCK_SHARED_HEAP_CACHE();
+        const bool lKept = sSharedHeapCache.Keep(aPacket, lClass);
+        UNLOCK_SHARED_HEAP_CACHE();
+        if (lKept)
+        {
+            return;
+        }
+    }
+#else
+    IgnoreUnusedVariable(aAllocSize);
+#endif // CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+
+    chip::Platform::MemoryFree(aPacket);
+}
+
 #if CHIP_SYSTEM_PACKETBUFFER_HAS_CHECK
 void PacketBuffer::InternalCheck(const PacketBuffer * buffer)
 {
@@ -142,9 +401,16 @@ void PacketBufferHandle::InternalRightSize()
     {
         return;
     }
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+    // A buffer of the same size class would occupy a block of the same size.
+    const size_t usedClass = HeapCacheClassFor(usedSize);
+    if (usedClass != kNoHeapCacheClass && usedClass == HeapCacheClassFor(mBuffer->alloc_size))
+    {
+        return;
+    }
+#endif // CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
 
-    const size_t blockSize   = usedSize + PacketBuffer::kStructureSize;
-    PacketBuffer * newBuffer = reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(blockSize));
+    PacketBuffer * newBuffer = PacketBuffer::HeapAlloc(usedSize);
     if (newBuffer == nullptr)
     {
         ChipLogError(chipSystemLayer, "PacketBuffer: pool EMPTY.");
@@ -159,6 +425,8 @@ void PacketBufferHandle::InternalRightSize()
     newBuffer->ref           = 1;
     newBuffer->alloc_size    = usedSize;
     memcpy(newStart, start, usedSize);
+    PacketBuffer::CountAllocation();
+    PacketBuffer::CountCopy(usedSize);
 
     PacketBuffer::Free(mBuffer);
     mBuffer = newBuffer;
@@ -336,6 +604,7 @@ void PacketBuffer::CompactHead()
     if (this->payload != kStart)
     {
         memmove(kStart, this->payload, this->len);
+        CountCopy(this->len);
         this->payload = kStart;
     }
 
@@ -351,6 +620,7 @@ void PacketBuffer::CompactHead()
             lMoveLength = lAvailLength;
 
         memcpy(static_cast<uint8_t *>(this->payload) + this->len, lNextPacket.payload, lMoveLength);
+        CountCopy(lMoveLength);
 
         lNextPacket.payload = static_cast<uint8_t *>(lNextPacket.payload) + lMoveLength;
         lAvailLength        = lAvailLength - lMoveLength;
@@ -440,6 +710,7 @@ CHIP_ERROR PacketBuffer::Read(uint8_t * aDestination, size_t aReadLength) const
             lToReadFromCurrentBuf = aReadLength;
         }
         memcpy(aDestination, lPacket->Start(), lToReadFromCurrentBuf);
+        CountCopy(lToReadFromCurrentBuf);
         aDestination += lToReadFromCurrentBuf;
         aReadLength -= lToReadFromCurrentBuf;
         lPacket = lPacket->ChainedBuffer();
@@ -464,6 +735,7 @@ bool PacketBuffer::EnsureReservedSize(uint16_t aReservedSize)
     // Cast is safe because aReservedSize > kCurrentReservedSize.
     const uint16_t kMoveLength = static_cast<uint16_t>(aReservedSize - kCurrentReservedSize);
     memmove(static_cast<uint8_t *>(this->payload) + kMoveLength, this->payload, this->len);
+    CountCopy(this->len);
     payload = static_cast<uint8_t *>(this->payload) + kMoveLength;
 
     return true;
@@ -591,10 +863,9 @@ PacketBufferHandle PacketBufferHandle::New(size_t aAvailableSize, uint16_t aRese
     UNLOCK_BUF_POOL();
 
 #elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
-    // sumOfSizes is essentially (kStructureSize + lAllocSize) which we already
-    // checked to fit in a size_t.
-    const size_t lBlockSize = static_cast<size_t>(sumOfSizes);
-    lPacket                 = reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(lBlockSize));
+    // HeapAlloc() allocates (kStructureSize + lAllocSize), rounded up to the size class capacity,
+    // which fits in a size_t since lAllocSize is no larger than kMaxSizeWithoutReserve.
+    lPacket = PacketBuffer::HeapAlloc(lAllocSize);
     SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
 
 #else
@@ -606,6 +877,7 @@ PacketBufferHandle PacketBufferHandle::New(size_t aAvailableSize, uint16_t aRese
         ChipLogError(chipSystemLayer, "PacketBuffer: pool EMPTY.");
         return PacketBufferHandle();
     }
+    PacketBuffer::CountAllocation();
 
     lPacket->payload = lPacket->ReserveStart() + aReservedSize;
     lPacket->len = lPacket->tot_len = 0;
@@ -632,6 +904,7 @@ PacketBufferHandle PacketBufferHandle::NewWithData(const void * aData, size_t aD
     if (buffer.mBuffer != nullptr)
     {
         memcpy(buffer.mBuffer->payload, aData, aDataSize);
+        PacketBuffer::CountCopy(aDataSize);
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
         buffer.mBuffer->len = buffer.mBuffer->tot_len = static_cast<uint16_t>(aDataSize);
 #else
@@ -676,14 +949,15 @@ void PacketBuffer::Free(PacketBuffer * aPacket)
         {
             SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
 #if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
-            ::chip::Platform::MemoryDebugCheckPointer(aPacket, aPacket->alloc_size + kStructureSize);
+            const size_t lAllocSize = aPacket->alloc_size;
+            ::chip::Platform::MemoryDebugCheckPointer(aPacket, lAllocSize + kStructureSize);
 #endif
             aPacket->Clear();
 #if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
             aPacket->next = sFreeList;
             sFreeList     = aPacket;
 #elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
-            chip::Platform::MemoryFree(aPacket);
+            HeapFree(aPacket, lAllocSize);
 #endif
             aPacket       = lNextPacket;
         }
@@ -700,6 +974,18 @@ void PacketBuffer::Free(PacketBuffer * aPacket)
 #endif
 }
 
+void PacketBuffer::ReleaseHeapCache()
+{
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE_PER_THREAD
+    sThreadHeapCache.Release();
+#endif // CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE_PER_THREAD
+    LOCK_SHARED_HEAP_CACHE();
+    sSharedHeapCache.Release();
+    UNLOCK_SHARED_HEAP_CACHE();
+#endif // CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+}
+
 /**
  * Clear content of the packet buffer.
  *
@@ -776,6 +1062,7 @@ PacketBufferHandle PacketBufferHandle::CloneData() const
         }
         clone.mBuffer->tot_len = clone.mBuffer->len = original->len;
         memcpy(clone->ReserveStart(), original->ReserveStart(), originalDataSize + originalReservedSize);
+        PacketBuffer::CountCopy(originalDataSize + originalReservedSize);
 
         if (cloneHead.IsNull())
         {
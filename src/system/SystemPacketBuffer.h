@@ -63,6 +63,38 @@ struct pbuf
 };
 #endif // !CHIP_SYSTEM_CONFIG_USE_LWIP
 
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_COPY_STATS
+/**
+ * Cumulative counts of packet buffer allocations and payload copies.
+ *
+ * These make it possible to check that a message path keeps its payload in the buffer it was received in: take a snapshot
+ * before running the path and subtract it from a snapshot taken afterwards.
+ */
+struct PacketBufferCounters
+{
+    uint32_t mAllocations = 0; ///< Number of buffers allocated, including by RightSize() and the cloning/copying helpers.
+    uint32_t mCopies      = 0; ///< Number of times payload bytes were copied or moved between or within buffers.
+    size_t mBytesCopied   = 0; ///< Total number of payload bytes copied or moved.
+
+    PacketBufferCounters operator-(const PacketBufferCounters & other) const
+    {
+        PacketBufferCounters result;
+        result.mAllocations = mAllocations - other.mAllocations;
+        result.mCopies      = mCopies - other.mCopies;
+        result.mBytesCopied = mBytesCopied - other.mBytesCopied;
+        return result;
+    }
+
+    PacketBufferCounters & operator+=(const PacketBufferCounters & other)
+    {
+        mAllocations += other.mAllocations;
+        mCopies += other.mCopies;
+        mBytesCopied += other.mBytesCopied;
+        return *this;
+    }
+};
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_COPY_STATS
+
 /**    @class PacketBuffer
  *
  *     @brief
@@ -351,6 +383,29 @@ public:
 #endif
     }
 
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_COPY_STATS
+    /**
+     * Return the cumulative allocation and copy counts for all packet buffers.
+     */
+    static PacketBufferCounters GetCounters() { return sCounters; }
+
+    /**
+     * Reset the cumulative allocation and copy counts to zero.
+     */
+    static void ResetCounters() { sCounters = PacketBufferCounters(); }
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_COPY_STATS
+
+    /**
+     * Return the packet buffers held for reuse by the shared heap cache and the calling thread's heap cache (see
+     * CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SMALL_COUNT) to the heap. Does nothing in configurations without a packet
+     * buffer heap cache.
+     *
+     * The heap caches of other threads are not released: a thread hands its cache over to the shared heap cache when it
+     * exits, so buffers cached by a thread that outlives this call (e.g. a dispatch queue worker thread) are only returned
+     * to the heap by a later call.
+     */
+    static void ReleaseHeapCache();
+
 private:
     // Memory required for a maximum-size PacketBuffer.
     static constexpr uint16_t kBlockSize = PacketBuffer::kStructureSize + PacketBuffer::kMaxSizeWithoutReserve;
@@ -367,10 +422,38 @@ private:
     static PacketBuffer * BuildFreeList();
 #endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL || defined(DOXYGEN)
 
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+    static PacketBuffer * HeapAlloc(size_t aAllocSize);
+    static void HeapFree(PacketBuffer * aPacket, size_t aAllocSize);
+#endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+    class HeapCache;
+    static HeapCache sSharedHeapCache;
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE_PER_THREAD
+    class ThreadHeapCache;
+    static thread_local ThreadHeapCache sThreadHeapCache;
+#endif // CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE_PER_THREAD
+    static size_t HeapCacheCount(size_t aClass);
+#endif // CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+
 #if CHIP_SYSTEM_PACKETBUFFER_HAS_CHECK
     static void InternalCheck(const PacketBuffer * buffer);
 #endif
 
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_COPY_STATS
+    static PacketBufferCounters sCounters;
+    static void CountAllocation() { sCounters.mAllocations++; }
+    static void CountCopy(size_t aLength)
+    {
+        sCounters.mCopies++;
+        sCounters.mBytesCopied += aLength;
+    }
+#else
+    static void CountAllocation() {}
+    static void CountCopy(size_t) {}
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_COPY_STATS
+
     void AddRef();
     bool HasSoleOwnership() const { return (this->ref == 1); }
     static void Free(PacketBuffer * aPacket);
@@ -38,6 +38,31 @@
 #define CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP 0
 #endif
 
+/**
+ * CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+ *
+ * True if freed heap packet buffers are kept on size-classed free lists for reuse.
+ */
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP &&                                                                                     \
+    (CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SMALL_COUNT + CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_MEDIUM_COUNT +            \
+         CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_LARGE_COUNT >                                                                  \
+     0)
+#define CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE 1
+#else
+#define CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE 0
+#endif
+
+/**
+ * CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE_PER_THREAD
+ *
+ * True if each thread keeps its own packet buffer heap cache in front of the shared one.
+ */
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE && CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#define CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE_PER_THREAD 1
+#else
+#define CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE_PER_THREAD 0
+#endif
+
 /**
  * CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
  *
@@ -44,6 +44,11 @@ static const Label sStatsStrings[chip::System::Stats::kNumEntries] = {
 #undef LWIP_PBUF_MEMPOOL
 #else
     "Packet Buffers",
+#endif
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+    "Cached small packet buffers",
+    "Cached medium packet buffers",
+    "Cached large packet buffers",
 #endif
     "Timers",
 #if INET_CONFIG_NUM_TCP_ENDPOINTS
@@ -28,6 +28,7 @@
 #include <inet/InetConfig.h>
 #include <lib/core/CHIPConfig.h>
 #include <system/SystemConfig.h>
+#include <system/SystemPacketBufferInternal.h>
 
 // Include dependent headers
 #include <lib/support/DLLUtil.h>
@@ -54,6 +55,11 @@ enum
 #undef LWIP_PBUF_MEMPOOL
 #else
     kSystemLayer_NumPacketBufs,
+#endif
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+    kSystemLayer_NumCachedSmallPacketBufs,
+    kSystemLayer_NumCachedMediumPacketBufs,
+    kSystemLayer_NumCachedLargePacketBufs,
 #endif
     kSystemLayer_NumTimers,
 #if INET_CONFIG_NUM_TCP_ENDPOINTS
@@ -0,0 +1,332 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a unit test suite for <tt>chip::System::LayerImplEpoll</tt>, which also compares its wakeup latency and
+ *      throughput with <tt>chip::System::LayerImplSelect</tt>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemConfig.h>
+#include <system/SystemLayerImplEpoll.h>
+#include <system/SystemLayerImplSelect.h>
+
+#include <chrono>
+#include <thread>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace chip;
+using namespace chip::System;
+
+namespace {
+
+// A datagram socket pair, the first socket being watched by the layer and read one datagram per callback, as the UDP
+// endpoints do.
+struct WatchedPair
+{
+    CHIP_ERROR Open(LayerSockets & layer)
+    {
+        int fds[2];
+        VerifyOrReturnError(socketpair(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK, 0, fds) == 0, CHIP_ERROR_POSIX(errno));
+        mReadFd  = fds[0];
+        mWriteFd = fds[1];
+        mLayer   = &layer;
+        ReturnErrorOnFailure(layer.StartWatchingSocket(mReadFd, &mToken));
+        ReturnErrorOnFailure(layer.SetCallback(mToken, OnReady, reinterpret_cast<intptr_t>(this)));
+        return layer.RequestCallbackOnPendingRead(mToken);
+    }
+
+    void Close(LayerSockets & layer)
+    {
+        if (mReadFd >= 0)
+        {
+            if (mToken != layer.InvalidSocketWatchToken())
+            {
+                layer.StopWatchingSocket(&mToken);
+            }
+            close(mReadFd);
+            close(mWriteFd);
+        }
+        mReadFd = mWriteFd = -1;
+    }
+
+    void Send(uint64_t value) { EXPECT_EQ(write(mWriteFd, &value, sizeof(value)), static_cast<ssize_t>(sizeof(value))); }
+
+    static void OnReady(SocketEvents events, intptr_t data)
+    {
+        WatchedPair * self = reinterpret_cast<WatchedPair *>(data);
+        self->mCallbackCount++;
+        if (!events.Has(SocketEventFlags::kRead))
+        {
+            return;
+        }
+
+        uint64_t value;
+        if (read(self->mReadFd, &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value)))
+        {
+            self->mLastValue = value;
+            self->mReadCount++;
+            if (self->mOnRead != nullptr)
+            {
+                self->mOnRead(*self);
+            }
+        }
+    }
+
+    LayerSockets * mLayer               = nullptr;
+    int mReadFd                         = -1;
+    int mWriteFd                        = -1;
+    SocketWatchToken mToken             = 0;
+    uint64_t mLastValue                 = 0;
+    unsigned mCallbackCount             = 0;
+    unsigned mReadCount                 = 0;
+    void (*mOnRead)(WatchedPair & pair) = nullptr;
+    void * mContext                     = nullptr;
+};
+
+void ServiceEvents(LayerSocketsLoop & layer)
+{
+    layer.PrepareEvents();
+    layer.WaitForEvents();
+    layer.HandleEvents();
+}
+
+uint64_t NowNs()
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+class TestSystemLayerEpoll : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+
+    void SetUp() override { ASSERT_EQ(mLayer.Init(), CHIP_NO_ERROR); }
+    void TearDown() override { mLayer.Shutdown(); }
+
+    LayerImplEpoll mLayer;
+};
+
+TEST_F(TestSystemLayerEpoll, CheckPartialReads)
+{
+    WatchedPair pair;
+    ASSERT_EQ(pair.Open(mLayer), CHIP_NO_ERROR);
+
+    // epoll reports a single edge for the three datagrams, yet each of them must get its callback.
+    pair.Send(1);
+    pair.Send(2);
+    pair.Send(3);
+    for (int i = 0; i < 3; i++)
+    {
+        ServiceEvents(mLayer);
+    }
+    EXPECT_EQ(pair.mReadCount, 3u);
+    EXPECT_EQ(pair.mLastValue, 3u);
+
+    // Once drained, the socket is not reported anymore, until a new datagram arrives.
+    unsigned callbackCount = pair.mCallbackCount;
+    mLayer.Signal();
+    ServiceEvents(mLayer);
+    mLayer.Signal();
+    ServiceEvents(mLayer);
+    EXPECT_LE(pair.mCallbackCount, callbackCount + 1);
+
+    pair.Send(4);
+    ServiceEvents(mLayer);
+    EXPECT_EQ(pair.mReadCount, 4u);
+    EXPECT_EQ(pair.mLastValue, 4u);
+
+    pair.Close(mLayer);
+}
+
+TEST_F(TestSystemLayerEpoll, CheckRequestAfterEdge)
+{
+    WatchedPair pair;
+    ASSERT_EQ(pair.Open(mLayer), CHIP_NO_ERROR);
+    ASSERT_EQ(mLayer.ClearCallbackOnPendingRead(pair.mToken), CHIP_NO_ERROR);
+
+    // The edge is consumed while reads are not requested...
+    pair.Send(1);
+    ServiceEvents(mLayer);
+    EXPECT_EQ(pair.mCallbackCount, 0u);
+
+    // ...and still results in a callback once they are.
+    ASSERT_EQ(mLayer.RequestCallbackOnPendingRead(pair.mToken), CHIP_NO_ERROR);
+    ServiceEvents(mLayer);
+    EXPECT_EQ(pair.mReadCount, 1u);
+
+    pair.Close(mLayer);
+}
+
+TEST_F(TestSystemLayerEpoll, CheckStopWatchingFromCallback)
+{
+    WatchedPair first;
+    WatchedPair second;
+    ASSERT_EQ(first.Open(mLayer), CHIP_NO_ERROR);
+    ASSERT_EQ(second.Open(mLayer), CHIP_NO_ERROR);
+
+    // Whichever callback runs first stops watching the other socket, whose pending event must then be dropped.
+    first.mContext  = &second;
+    second.mContext = &first;
+    first.mOnRead = second.mOnRead = [](WatchedPair & pair) {
+        WatchedPair & other = *static_cast<WatchedPair *>(pair.mContext);
+        if (other.mToken != pair.mLayer->InvalidSocketWatchToken())
+        {
+            EXPECT_EQ(pair.mLayer->StopWatchingSocket(&other.mToken), CHIP_NO_ERROR);
+        }
+    };
+
+    first.Send(1);
+    second.Send(2);
+    ServiceEvents(mLayer);
+    mLayer.Signal();
+    ServiceEvents(mLayer);
+    EXPECT_EQ(first.mReadCount + second.mReadCount, 1u);
+
+    // The freed watch can be reused right away.
+    WatchedPair third;
+    ASSERT_EQ(third.Open(mLayer), CHIP_NO_ERROR);
+    third.Send(3);
+    ServiceEvents(mLayer);
+    EXPECT_EQ(third.mReadCount, 1u);
+
+    first.Close(mLayer);
+    second.Close(mLayer);
+    third.Close(mLayer);
+}
+
+TEST_F(TestSystemLayerEpoll, CheckTimers)
+{
+    struct TestState
+    {
+        static void Fired(Layer * layer, void * state) { ++*static_cast<int *>(state); }
+    };
+
+    int fired = 0;
+    using namespace Clock::Literals;
+    ASSERT_EQ(mLayer.StartTimer(5_ms, TestState::Fired, &fired), CHIP_NO_ERROR);
+
+    // The timerfd wakes the loop up, without any socket activity.
+    const Clock::Timestamp start = SystemClock().GetMonotonicTimestamp();
+    while (fired == 0 && SystemClock().GetMonotonicTimestamp() - start < 1000_ms)
+    {
+        ServiceEvents(mLayer);
+    }
+    EXPECT_EQ(fired, 1);
+    EXPECT_GE(SystemClock().GetMonotonicTimestamp() - start, 5_ms);
+
+    // Cancelled timers do not fire, even when the timerfd was armed for them.
+    int later = 0;
+    ASSERT_EQ(mLayer.StartTimer(1_ms, TestState::Fired, &fired), CHIP_NO_ERROR);
+    ASSERT_EQ(mLayer.StartTimer(20_ms, TestState::Fired, &later), CHIP_NO_ERROR);
+    ServiceEvents(mLayer);
+    mLayer.CancelTimer(TestState::Fired, &fired);
+    while (later == 0 && SystemClock().GetMonotonicTimestamp() - start < 1000_ms)
+    {
+        ServiceEvents(mLayer);
+    }
+    EXPECT_EQ(later, 1);
+    EXPECT_EQ(fired, 1);
+}
+
+struct BenchmarkResult
+{
+    double mLatencyUs;
+    double mIterationsPerSecond;
+};
+
+constexpr int kIdleSocketCount = 48;
+
+// Measure, with kIdleSocketCount other watched sockets, the time between a datagram being sent from another thread and
+// its callback, and how many one-datagram loop iterations can run per second.
+template <class LayerImplType>
+BenchmarkResult RunBenchmark()
+{
+    BenchmarkResult result = {};
+    LayerImplType layer;
+    EXPECT_EQ(layer.Init(), CHIP_NO_ERROR);
+
+    WatchedPair idle[kIdleSocketCount];
+    for (auto & pair : idle)
+    {
+        EXPECT_EQ(pair.Open(layer), CHIP_NO_ERROR);
+    }
+    WatchedPair active;
+    EXPECT_EQ(active.Open(layer), CHIP_NO_ERROR);
+
+    constexpr unsigned kIterations = 20000;
+    auto start                     = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < kIterations; i++)
+    {
+        active.Send(i);
+        ServiceEvents(layer);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(active.mReadCount, kIterations);
+    result.mIterationsPerSecond = kIterations / elapsed.count();
+
+    constexpr unsigned kSamples = 500;
+    uint64_t totalLatencyNs     = 0;
+    active.mReadCount           = 0;
+    active.mContext             = &totalLatencyNs;
+    active.mOnRead              = [](WatchedPair & pair) {
+        *static_cast<uint64_t *>(pair.mContext) += NowNs() - pair.mLastValue;
+    };
+    std::thread sender([&active] {
+        for (unsigned i = 0; i < kSamples; i++)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            active.Send(NowNs());
+        }
+    });
+    while (active.mReadCount < kSamples)
+    {
+        ServiceEvents(layer);
+    }
+    sender.join();
+    result.mLatencyUs = static_cast<double>(totalLatencyNs) / kSamples / 1000;
+
+    active.Close(layer);
+    for (auto & pair : idle)
+    {
+        pair.Close(layer);
+    }
+    layer.Shutdown();
+    return result;
+}
+
+TEST_F(TestSystemLayerEpoll, BenchmarkAgainstSelect)
+{
+    BenchmarkResult select = RunBenchmark<LayerImplSelect>();
+    BenchmarkResult epoll  = RunBenchmark<LayerImplEpoll>();
+
+    ChipLogProgress(Test, "%d idle sockets, select: wakeup latency %.1f us, %.0f iterations/s", kIdleSocketCount,
+                    select.mLatencyUs, select.mIterationsPerSecond);
+    ChipLogProgress(Test, "%d idle sockets, epoll:  wakeup latency %.1f us, %.0f iterations/s", kIdleSocketCount,
+                    epoll.mLatencyUs, epoll.mIterationsPerSecond);
+}
+
+} // namespace
@@ -23,10 +23,13 @@
  *      structure for network packet buffer management.
  */
 
+#include <chrono>
 #include <errno.h>
+#include <future>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -35,8 +38,10 @@
 #include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/SafeInt.h>
+#include <lib/support/logging/CHIPLogging.h>
 #include <platform/CHIPDeviceLayer.h>
 #include <system/SystemPacketBuffer.h>
+#include <system/SystemStats.h>
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 #include <lwip/init.h>
@@ -183,6 +188,7 @@ public:
     void CheckHandleRelease();
     void CheckHandleRetain();
     void CheckHandleRightSize();
+    void CheckHeapCache();
     void CheckLast();
     void CheckNew();
     void CheckNext();
@@ -1722,6 +1728,171 @@ TEST_F_FROM_FIXTURE(TestSystemPacketBuffer, CheckHandleCloneData)
 #endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
 }
 
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+TEST_F_FROM_FIXTURE(TestSystemPacketBuffer, CheckHeapCache)
+{
+    constexpr size_t kSmall = 0;
+    constexpr size_t kLarge = 2;
+
+    PacketBuffer::ReleaseHeapCache();
+    EXPECT_EQ(PacketBuffer::HeapCacheCount(kSmall), 0u);
+    EXPECT_TRUE(SYSTEM_STATS_TEST_IN_USE(Stats::kSystemLayer_NumCachedSmallPacketBufs, 0));
+
+    // A freed buffer is kept and handed out again for a request of the same size class, with the requested size.
+    PacketBufferHandle handle = PacketBufferHandle::New(10, 0);
+    ASSERT_FALSE(handle.IsNull());
+    const PacketBuffer * const buffer = handle.Get();
+    handle                            = nullptr;
+    EXPECT_EQ(PacketBuffer::HeapCacheCount(kSmall), 1u);
+    EXPECT_TRUE(SYSTEM_STATS_TEST_IN_USE(Stats::kSystemLayer_NumCachedSmallPacketBufs, 1));
+
+    handle = PacketBufferHandle::New(CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SMALL_SIZE - 20, 20);
+    ASSERT_FALSE(handle.IsNull());
+    EXPECT_EQ(handle.Get(), buffer);
+    EXPECT_EQ(handle->AvailableDataLength(), static_cast<size_t>(CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SMALL_SIZE - 20));
+    EXPECT_EQ(PacketBuffer::HeapCacheCount(kSmall), 0u);
+    handle = nullptr;
+
+    // Maximum-size buffers use their own size class.
+    handle = PacketBufferHandle::New(PacketBuffer::kMaxSizeWithoutReserve, 0);
+    ASSERT_FALSE(handle.IsNull());
+    handle = nullptr;
+    EXPECT_EQ(PacketBuffer::HeapCacheCount(kSmall), 1u);
+    EXPECT_EQ(PacketBuffer::HeapCacheCount(kLarge), 1u);
+
+    // The number of buffers kept for a size class is capped, in the thread's cache and in the shared cache; the rest go
+    // back to the heap.
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE_PER_THREAD
+    constexpr size_t kSmallCapacity = 2 * CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SMALL_COUNT;
+#else
+    constexpr size_t kSmallCapacity = CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SMALL_COUNT;
+#endif
+    PacketBuffer::ReleaseHeapCache();
+    SYSTEM_STATS_RESET_HIGH_WATER_MARK_FOR_TESTING(Stats::kSystemLayer_NumCachedSmallPacketBufs);
+    std::vector<PacketBufferHandle> buffers;
+    for (size_t i = 0; i < kSmallCapacity + 2; i++)
+    {
+        buffers.push_back(PacketBufferHandle::New(1));
+        ASSERT_FALSE(buffers.back().IsNull());
+    }
+    buffers.clear();
+    EXPECT_EQ(PacketBuffer::HeapCacheCount(kSmall), kSmallCapacity);
+    EXPECT_TRUE(SYSTEM_STATS_TEST_HIGH_WATER_MARK(Stats::kSystemLayer_NumCachedSmallPacketBufs, kSmallCapacity));
+
+    PacketBuffer::ReleaseHeapCache();
+    EXPECT_EQ(PacketBuffer::HeapCacheCount(kSmall), 0u);
+    EXPECT_TRUE(SYSTEM_STATS_TEST_IN_USE(Stats::kSystemLayer_NumCachedSmallPacketBufs, 0));
+
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE_PER_THREAD
+    // Buffers cached by a thread are handed to the shared cache when the thread exits.
+    const PacketBuffer * threadBuffer = nullptr;
+    std::thread([&threadBuffer] {
+        PacketBufferHandle threadHandle = PacketBufferHandle::New(1);
+        threadBuffer                    = threadHandle.Get();
+    }).join();
+    ASSERT_NE(threadBuffer, nullptr);
+    EXPECT_EQ(PacketBuffer::HeapCacheCount(kSmall), 1u);
+
+    handle = PacketBufferHandle::New(1);
+    EXPECT_EQ(handle.Get(), threadBuffer);
+    handle = nullptr;
+    PacketBuffer::ReleaseHeapCache();
+
+    // The shared cache keeps to its cap when a thread exits; the buffers it has no room for are only set aside, and go back
+    // to the heap with the rest of the cache.
+    std::thread([] {
+        std::vector<PacketBufferHandle> threadBuffers;
+        for (size_t i = 0; i < kSmallCapacity; i++)
+        {
+            threadBuffers.push_back(PacketBufferHandle::New(1));
+        }
+    }).join();
+    EXPECT_EQ(PacketBuffer::HeapCacheCount(kSmall), static_cast<size_t>(CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SMALL_COUNT));
+    EXPECT_TRUE(SYSTEM_STATS_TEST_IN_USE(Stats::kSystemLayer_NumCachedSmallPacketBufs,
+                                         CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SMALL_COUNT));
+    PacketBuffer::ReleaseHeapCache();
+
+    // A thread that exits after Platform::MemoryShutdown() does not return its buffers to the heap then.
+    std::promise<void> cached;
+    std::promise<void> shutDown;
+    std::thread thread([&cached, &shutDown] {
+        {
+            std::vector<PacketBufferHandle> threadBuffers;
+            for (size_t i = 0; i < kSmallCapacity; i++)
+            {
+                threadBuffers.push_back(PacketBufferHandle::New(1));
+            }
+        }
+        cached.set_value();
+        shutDown.get_future().wait();
+    });
+    cached.get_future().wait();
+    chip::Platform::MemoryShutdown();
+    shutDown.set_value();
+    thread.join();
+    ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR);
+    EXPECT_EQ(PacketBuffer::HeapCacheCount(kSmall), static_cast<size_t>(CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SMALL_COUNT));
+    PacketBuffer::ReleaseHeapCache();
+#endif // CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE_PER_THREAD
+}
+#endif // CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+/**
+ *  Compare packet buffer allocation against plain heap allocation of the same blocks, for the buffers used to receive a
+ *  message and send its response. The unit test only runs a few iterations: raise kIterations locally to get meaningful
+ *  timings.
+ */
+TEST_F(TestSystemPacketBuffer, CheckHeapAllocationBenchmark)
+{
+    constexpr unsigned kIterations     = 100;
+    static const uint8_t kResponse[64] = { 1 };
+    uint8_t received[128]              = { 2 };
+    size_t total                       = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < kIterations; i++)
+    {
+        // The receive path reads each datagram into a maximum-size buffer.
+        uint8_t * message =
+            static_cast<uint8_t *>(chip::Platform::MemoryAlloc(kStructureSize + PacketBuffer::kMaxSizeWithoutReserve));
+        // The send path encodes the response behind the default header reserve.
+        uint8_t * response = static_cast<uint8_t *>(
+            chip::Platform::MemoryAlloc(kStructureSize + PacketBuffer::kDefaultHeaderReserve + sizeof(kResponse)));
+        ASSERT_NE(message, nullptr);
+        ASSERT_NE(response, nullptr);
+        memcpy(message + kStructureSize, received, sizeof(received));
+        memcpy(response + kStructureSize + PacketBuffer::kDefaultHeaderReserve, kResponse, sizeof(kResponse));
+        total += sizeof(received) + sizeof(kResponse);
+        chip::Platform::MemoryFree(message);
+        chip::Platform::MemoryFree(response);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    ChipLogProgress(Test, "Heap: %u ns per received and sent message", static_cast<unsigned>(elapsed.count() / kIterations));
+    EXPECT_EQ(total, kIterations * (sizeof(received) + sizeof(kResponse)));
+
+    total = 0;
+    start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < kIterations; i++)
+    {
+        PacketBufferHandle message = PacketBufferHandle::New(PacketBuffer::kMaxSizeWithoutReserve, 0);
+        ASSERT_FALSE(message.IsNull());
+        memcpy(message->Start(), received, sizeof(received));
+        message->SetDataLength(sizeof(received));
+
+        PacketBufferHandle response = PacketBufferHandle::NewWithData(kResponse, sizeof(kResponse));
+        ASSERT_FALSE(response.IsNull());
+        total += message->DataLength() + response->DataLength();
+    }
+    elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    ChipLogProgress(Test, "Packet buffers: %u ns per received and sent message",
+                    static_cast<unsigned>(elapsed.count() / kIterations));
+    EXPECT_EQ(total, kIterations * (sizeof(received) + sizeof(kResponse)));
+
+    PacketBuffer::ReleaseHeapCache();
+}
+#endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+
 TEST_F(TestSystemPacketBuffer, CheckPacketBufferWriter)
 {
     static const char kPayload[] = "Hello, world!";
@@ -1747,5 +1918,38 @@ TEST_F(TestSystemPacketBuffer, CheckPacketBufferWriter)
     EXPECT_EQ(memcmp(yayBuffer->Start(), kPayload, sizeof kPayload), 0);
 }
 
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_COPY_STATS
+TEST_F(TestSystemPacketBuffer, CheckCounters)
+{
+    static const uint8_t kPayload[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+    PacketBuffer::ResetCounters();
+    EXPECT_EQ(PacketBuffer::GetCounters().mAllocations, 0u);
+    EXPECT_EQ(PacketBuffer::GetCounters().mCopies, 0u);
+
+    // Allocating and consuming a buffer does not copy.
+    PacketBufferHandle buffer = PacketBufferHandle::New(sizeof(kPayload));
+    ASSERT_FALSE(buffer.IsNull());
+    buffer->SetDataLength(sizeof(kPayload));
+    buffer->ConsumeHead(2);
+    PacketBufferCounters counters = PacketBuffer::GetCounters();
+    EXPECT_EQ(counters.mAllocations, 1u);
+    EXPECT_EQ(counters.mCopies, 0u);
+
+    // Copying data into or out of a buffer does.
+    PacketBufferHandle withData = PacketBufferHandle::NewWithData(kPayload, sizeof(kPayload));
+    ASSERT_FALSE(withData.IsNull());
+    uint8_t readBack[sizeof(kPayload)];
+    EXPECT_EQ(withData->Read(readBack), CHIP_NO_ERROR);
+    PacketBufferCounters delta = PacketBuffer::GetCounters() - counters;
+    EXPECT_EQ(delta.mAllocations, 1u);
+    EXPECT_EQ(delta.mCopies, 2u);
+    EXPECT_EQ(delta.mBytesCopied, 2 * sizeof(kPayload));
+
+    PacketBuffer::ResetCounters();
+    EXPECT_EQ(PacketBuffer::GetCounters().mBytesCopied, 0u);
+}
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_COPY_STATS
+
 } // namespace System
 } // namespace chip
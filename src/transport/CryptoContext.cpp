@@ -55,6 +55,11 @@ CryptoContext::CryptoContext() : mKeyAvailable(false) {}
 
 CryptoContext::~CryptoContext()
 {
+#if CHIP_CONFIG_SESSION_CIPHER_CONTEXT_CACHE
+    mEncryptionCipher.Clear();
+    mDecryptionCipher.Clear();
+#endif // CHIP_CONFIG_SESSION_CIPHER_CONTEXT_CACHE
+
     if (mKeystore)
     {
         mKeystore->DestroyKey(mEncryptionKey);
@@ -194,6 +199,114 @@ CHIP_ERROR CryptoContext::GetAdditionalAuthData(const PacketHeader & header, uin
 CHIP_ERROR CryptoContext::Encrypt(const uint8_t * input, size_t input_length, uint8_t * output, ConstNonceView nonce,
                                   PacketHeader & header, MessageAuthenticationCode & mac) const
 {
+    return EncryptMessage(GetEncryptionCipher(), input, input_length, output, nonce, header, mac);
+}
+
+CHIP_ERROR CryptoContext::Decrypt(const uint8_t * input, size_t input_length, uint8_t * output, ConstNonceView nonce,
+                                  const PacketHeader & header, const MessageAuthenticationCode & mac) const
+{
+    return DecryptMessage(GetDecryptionCipher(), input, input_length, output, nonce, header, mac);
+}
+
+CHIP_ERROR CryptoContext::EncryptBatch(Span<BatchMessage> messages) const
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    // Without the session cache, the cipher is still set up only once for the whole batch.
+    Aes128CcmContext batchCipher;
+    Aes128CcmContext * cipher = GetEncryptionCipher();
+    if (cipher == nullptr && mKeyContext == nullptr && mKeyAvailable)
+    {
+        ReturnErrorOnFailure(batchCipher.Init(mEncryptionKey));
+        cipher = &batchCipher;
+    }
+
+    for (auto & message : messages)
+    {
+        if (message.mHeader == nullptr || message.mMac == nullptr)
+        {
+            message.mResult = CHIP_ERROR_INVALID_ARGUMENT;
+        }
+        else
+        {
+            message.mResult = EncryptMessage(cipher, message.mInput, message.mInputLength, message.mOutput, message.mNonce,
+                                             *message.mHeader, *message.mMac);
+        }
+
+        if (err == CHIP_NO_ERROR)
+        {
+            err = message.mResult;
+        }
+    }
+
+    return err;
+}
+
+CHIP_ERROR CryptoContext::DecryptBatch(Span<BatchMessage> messages) const
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    // Without the session cache, the cipher is still set up only once for the whole batch.
+    Aes128CcmContext batchCipher;
+    Aes128CcmContext * cipher = GetDecryptionCipher();
+    if (cipher == nullptr && mKeyContext == nullptr && mKeyAvailable)
+    {
+        ReturnErrorOnFailure(batchCipher.Init(mDecryptionKey));
+        cipher = &batchCipher;
+    }
+
+    for (auto & message : messages)
+    {
+        if (message.mHeader == nullptr || message.mMac == nullptr)
+        {
+            message.mResult = CHIP_ERROR_INVALID_ARGUMENT;
+        }
+        else
+        {
+            message.mResult = DecryptMessage(cipher, message.mInput, message.mInputLength, message.mOutput, message.mNonce,
+                                             *message.mHeader, *message.mMac);
+        }
+
+        if (err == CHIP_NO_ERROR)
+        {
+            err = message.mResult;
+        }
+    }
+
+    return err;
+}
+
+Aes128CcmContext * CryptoContext::GetEncryptionCipher() const
+{
+#if CHIP_CONFIG_SESSION_CIPHER_CONTEXT_CACHE
+    VerifyOrReturnValue(mKeyAvailable && mKeyContext == nullptr, nullptr);
+    if (!mEncryptionCipher.IsInitialized())
+    {
+        VerifyOrReturnValue(mEncryptionCipher.Init(mEncryptionKey) == CHIP_NO_ERROR, nullptr);
+    }
+    return &mEncryptionCipher;
+#else
+    return nullptr;
+#endif // CHIP_CONFIG_SESSION_CIPHER_CONTEXT_CACHE
+}
+
+Aes128CcmContext * CryptoContext::GetDecryptionCipher() const
+{
+#if CHIP_CONFIG_SESSION_CIPHER_CONTEXT_CACHE
+    VerifyOrReturnValue(mKeyAvailable && mKeyContext == nullptr, nullptr);
+    if (!mDecryptionCipher.IsInitialized())
+    {
+        VerifyOrReturnValue(mDecryptionCipher.Init(mDecryptionKey) == CHIP_NO_ERROR, nullptr);
+    }
+    return &mDecryptionCipher;
+#else
+    return nullptr;
+#endif // CHIP_CONFIG_SESSION_CIPHER_CONTEXT_CACHE
+}
+
+CHIP_ERROR CryptoContext::EncryptMessage(Aes128CcmContext * cipher, const uint8_t * input, size_t input_length, uint8_t * output,
+                                         ConstNonceView nonce, PacketHeader & header, MessageAuthenticationCode & mac) const
+{
 
     const size_t taglen = header.MICTagLength();
 
@@ -220,8 +333,15 @@ CHIP_ERROR CryptoContext::Encrypt(const uint8_t * input, size_t input_length, ui
     else
     {
         VerifyOrReturnError(mKeyAvailable, CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
-        ReturnErrorOnFailure(
-            AES_CCM_encrypt(input, input_length, AAD, aadLen, mEncryptionKey, nonce.data(), nonce.size(), output, tag, taglen));
+        if (cipher != nullptr)
+        {
+            ReturnErrorOnFailure(cipher->Encrypt(input, input_length, AAD, aadLen, nonce.data(), nonce.size(), output, tag, taglen));
+        }
+        else
+        {
+            ReturnErrorOnFailure(AES_CCM_encrypt(input, input_length, AAD, aadLen, mEncryptionKey, nonce.data(), nonce.size(),
+                                                 output, tag, taglen));
+        }
     }
 
     mac.SetTag(&header, tag, taglen);
@@ -229,8 +349,9 @@ CHIP_ERROR CryptoContext::Encrypt(const uint8_t * input, size_t input_length, ui
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR CryptoContext::Decrypt(const uint8_t * input, size_t input_length, uint8_t * output, ConstNonceView nonce,
-                                  const PacketHeader & header, const MessageAuthenticationCode & mac) const
+CHIP_ERROR CryptoContext::DecryptMessage(Aes128CcmContext * cipher, const uint8_t * input, size_t input_length, uint8_t * output,
+                                         ConstNonceView nonce, const PacketHeader & header,
+                                         const MessageAuthenticationCode & mac) const
 {
     const size_t taglen = header.MICTagLength();
     const uint8_t * tag = mac.GetTag();
@@ -255,8 +376,15 @@ CHIP_ERROR CryptoContext::Decrypt(const uint8_t * input, size_t input_length, ui
     else
     {
         VerifyOrReturnError(mKeyAvailable, CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
-        ReturnErrorOnFailure(
-            AES_CCM_decrypt(input, input_length, AAD, aadLen, tag, taglen, mDecryptionKey, nonce.data(), nonce.size(), output));
+        if (cipher != nullptr)
+        {
+            ReturnErrorOnFailure(cipher->Decrypt(input, input_length, AAD, aadLen, tag, taglen, nonce.data(), nonce.size(), output));
+        }
+        else
+        {
+            ReturnErrorOnFailure(AES_CCM_decrypt(input, input_length, AAD, aadLen, tag, taglen, mDecryptionKey, nonce.data(),
+                                                 nonce.size(), output));
+        }
     }
     return CHIP_NO_ERROR;
 }
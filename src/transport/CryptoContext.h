@@ -146,6 +146,41 @@ public:
     CHIP_ERROR Decrypt(const uint8_t * input, size_t input_length, uint8_t * output, ConstNonceView nonce,
                        const PacketHeader & header, const MessageAuthenticationCode & mac) const;
 
+    /**
+     * A message encrypted or decrypted by EncryptBatch() or DecryptBatch(), with the same arguments as Encrypt() and
+     * Decrypt(), and the result of its own operation.
+     */
+    struct BatchMessage
+    {
+        const uint8_t * mInput = nullptr;
+        size_t mInputLength    = 0;
+        uint8_t * mOutput      = nullptr;
+        NonceStorage mNonce;
+        PacketHeader * mHeader          = nullptr;
+        MessageAuthenticationCode * mMac = nullptr;
+        CHIP_ERROR mResult              = CHIP_NO_ERROR;
+    };
+
+    /**
+     * @brief
+     *   Encrypt several messages with keys established in the secure channel, setting up the cipher once for all of them.
+     *
+     * Every message is processed, and its mResult is set, even if an earlier one failed.
+     *
+     * @return CHIP_NO_ERROR if all messages were encrypted, otherwise the error of the first failed message.
+     */
+    CHIP_ERROR EncryptBatch(Span<BatchMessage> messages) const;
+
+    /**
+     * @brief
+     *   Decrypt several messages with keys established in the secure channel, setting up the cipher once for all of them.
+     *
+     * Every message is processed, and its mResult is set, even if an earlier one failed.
+     *
+     * @return CHIP_NO_ERROR if all messages were decrypted, otherwise the error of the first failed message.
+     */
+    CHIP_ERROR DecryptBatch(Span<BatchMessage> messages) const;
+
     CHIP_ERROR PrivacyEncrypt(const uint8_t * input, size_t input_length, uint8_t * output, PacketHeader & header,
                               MessageAuthenticationCode & mac) const;
 
@@ -170,6 +205,16 @@ public:
 private:
     CHIP_ERROR InitTestMode(Crypto::SessionKeystore & keystore, Crypto::Aes128KeyHandle & i2rKey, Crypto::Aes128KeyHandle & r2iKey);
 
+    // Encrypt or decrypt one message, with the session key through `cipher` when not null, else with a one-shot call.
+    CHIP_ERROR EncryptMessage(Crypto::Aes128CcmContext * cipher, const uint8_t * input, size_t input_length, uint8_t * output,
+                              ConstNonceView nonce, PacketHeader & header, MessageAuthenticationCode & mac) const;
+    CHIP_ERROR DecryptMessage(Crypto::Aes128CcmContext * cipher, const uint8_t * input, size_t input_length, uint8_t * output,
+                              ConstNonceView nonce, const PacketHeader & header, const MessageAuthenticationCode & mac) const;
+
+    // Cached ciphers bound to the session keys, or nullptr when CHIP_CONFIG_SESSION_CIPHER_CONTEXT_CACHE is disabled.
+    Crypto::Aes128CcmContext * GetEncryptionCipher() const;
+    Crypto::Aes128CcmContext * GetDecryptionCipher() const;
+
     SessionRole mSessionRole;
 
     bool mKeyAvailable;
@@ -179,6 +224,12 @@ private:
     Crypto::SessionKeystore * mKeystore       = nullptr;
     Crypto::SymmetricKeyContext * mKeyContext = nullptr;
 
+#if CHIP_CONFIG_SESSION_CIPHER_CONTEXT_CACHE
+    // Bound to mEncryptionKey and mDecryptionKey on first use, and cleared before the keys are destroyed.
+    mutable Crypto::Aes128CcmContext mEncryptionCipher;
+    mutable Crypto::Aes128CcmContext mDecryptionCipher;
+#endif // CHIP_CONFIG_SESSION_CIPHER_CONTEXT_CACHE
+
     // Use unencrypted header as additional authenticated data (AAD) during encryption and decryption.
     // The encryption operations includes AAD when message authentication tag is generated. This tag
     // is used at the time of decryption to integrity check the received data.
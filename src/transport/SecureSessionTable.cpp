@@ -22,6 +22,8 @@
 #include <transport/SecureSession.h>
 #include <transport/SecureSessionTable.h>
 
+#include <algorithm>
+
 namespace chip {
 namespace Transport {
 
@@ -54,7 +56,9 @@ Optional<SessionHandle> SecureSessionTable::CreateNewSecureSessionForTest(Secure
 
     SecureSession * result = mEntries.CreateObject(*this, secureSessionType, localSessionId, localNodeId, peerNodeId, peerCATs,
                                                    peerSessionId, fabricIndex, config);
-    return result != nullptr ? MakeOptional<SessionHandle>(*result) : Optional<SessionHandle>::Missing();
+    VerifyOrReturnValue(result != nullptr, Optional<SessionHandle>::Missing());
+    AddToPeerIndex(result);
+    return MakeOptional<SessionHandle>(*result);
 }
 
 Optional<SessionHandle> SecureSessionTable::CreateNewSecureSession(SecureSession::Type secureSessionType,
@@ -81,6 +85,7 @@ Optional<SessionHandle> SecureSessionTable::CreateNewSecureSession(SecureSession
     }
 
     VerifyOrReturnValue(allocated != nullptr, Optional<SessionHandle>::Missing());
+    AddToPeerIndex(allocated);
 
     rv             = MakeOptional<SessionHandle>(*allocated);
     mNextSessionId = sessionId.Value() == kMaxSessionID ? static_cast<uint16_t>(kUnsecuredSessionId + 1)
@@ -106,7 +111,7 @@ SecureSession * SecureSessionTable::EvictAndAllocate(uint16_t localSessionId, Se
 
     //
     // Create a temporary list of objects each of which points to a session in the existing
-    // session table, but are swappable. This allows them to then be used with a sorting algorithm
+    // session table, but are swappable. This allows them to then be arranged in a heap
     // without affecting the sessions in the table itself.
     //
     // The size of this shouldn't place significant demands on the stack if using the default
@@ -119,81 +124,57 @@ SecureSession * SecureSessionTable::EvictAndAllocate(uint16_t localSessionId, Se
     // Even if the define is set to a large value, it's likely not so bad on the sort of platform setup
     // that would have that sort of pool size.
     //
-    // We need to sort (as opposed to just a linear search for the smallest/largest item)
+    // We need to order candidates (as opposed to just a linear search for the smallest/largest item)
     // since it is possible that the candidate selected for eviction may not actually be
     // released once marked for expiration (see comments below for more details).
     //
     // Consequently, we may need to walk the candidate list till we find one that is.
-    // Sorting provides a better overall performance model in this scheme.
-    //
-    // (#19967): Investigate doing linear search instead.
-    //
     //
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    // Tests may grow the table beyond CHIP_CONFIG_SECURE_SESSION_POOL_SIZE, see SetMaxSessionTableSize().
+    Platform::ScopedMemoryBuffer<SortableSession> sortableSessionBuffer;
+    VerifyOrDie(sortableSessionBuffer.Calloc(mEntries.Allocated()));
+    SortableSession * sortableSessions = sortableSessionBuffer.Get();
+#else
     SortableSession sortableSessions[CHIP_CONFIG_SECURE_SESSION_POOL_SIZE];
+#endif
 
-    unsigned int index = 0;
-
-    //
-    // Compute two key stats for each session - the number of other sessions that
-    // match its fabric, as well as the number of other sessions that match its peer.
-    //
-    // This will be used by the session eviction algorithm later.
-    //
-    ForEachSession([&index, &sortableSessions, this](auto * session) {
-        sortableSessions[index].mSession             = session;
-        sortableSessions[index].mNumMatchingOnFabric = 0;
-        sortableSessions[index].mNumMatchingOnPeer   = 0;
-
-        ForEachSession([session, index, &sortableSessions](auto * otherSession) {
-            if (session != otherSession)
-            {
-                if (session->GetFabricIndex() == otherSession->GetFabricIndex())
-                {
-                    sortableSessions[index].mNumMatchingOnFabric++;
-
-                    if (session->GetPeerNodeId() == otherSession->GetPeerNodeId())
-                    {
-                        sortableSessions[index].mNumMatchingOnPeer++;
-                    }
-                }
-            }
-
-            return Loop::Continue;
-        });
-
-        index++;
+    size_t index = 0;
+    ForEachSession([&index, &sortableSessions](auto * session) {
+        sortableSessions[index++].mSession = session;
         return Loop::Continue;
     });
 
-    auto sortableSessionSpan = Span<SortableSession>(sortableSessions, mEntries.Allocated());
-    EvictionPolicyContext policyContext(sortableSessionSpan, sessionEvictionHint);
-
-    DefaultEvictionPolicy(policyContext);
-    ChipLogProgress(SecureChannel, "Sorted sessions for eviction...");
+    const auto numSessions   = mEntries.Allocated();
+    auto sortableSessionSpan = Span<SortableSession>(sortableSessions, numSessions);
+    CountMatchingSessions(sortableSessionSpan);
 
-    const auto numSessions = mEntries.Allocated();
+    //
+    // Arrange the candidates in a max-heap, the best candidate for eviction being on top.
+    //
+    EvictionPolicyContext policyContext(sessionEvictionHint);
+    auto isWorseCandidate = [&policyContext](const SortableSession & a, const SortableSession & b) {
+        return DefaultEvictionPolicy(policyContext, b, a);
+    };
+    std::make_heap(sortableSessionSpan.begin(), sortableSessionSpan.end(), isWorseCandidate);
 
-#if CHIP_DETAIL_LOGGING
-    ChipLogDetail(SecureChannel, "Sorted Eviction Candidates (ranked from best candidate to worst):");
-    for (auto * session = sortableSessions; session != (sortableSessions + numSessions); session++)
+    for (auto * heapEnd = sortableSessionSpan.end(); heapEnd != sortableSessionSpan.begin(); heapEnd--)
     {
-        ChipLogDetail(SecureChannel,
-                      "\t%ld: [%p] -- Peer: [%u:" ChipLogFormatX64
-                      "] State: '%s', NumMatchingOnFabric: %d NumMatchingOnPeer: %d ActivityTime: %lu",
-                      static_cast<long int>(session - sortableSessions), session->mSession,
-                      session->mSession->GetPeer().GetFabricIndex(), ChipLogValueX64(session->mSession->GetPeer().GetNodeId()),
-                      session->mSession->GetStateStr(), session->mNumMatchingOnFabric, session->mNumMatchingOnPeer,
-                      static_cast<unsigned long>(session->mSession->GetLastActivityTime().count()));
-    }
-#endif
+        std::pop_heap(sortableSessionSpan.begin(), heapEnd, isWorseCandidate);
+        auto * session = heapEnd - 1;
 
-    for (auto * session = sortableSessions; session != (sortableSessions + numSessions); session++)
-    {
         if (session->mSession->IsPendingEviction())
         {
             continue;
         }
 
+        ChipLogDetail(SecureChannel,
+                      "Eviction candidate: [%p] -- Peer: [%u:" ChipLogFormatX64
+                      "] State: '%s', NumMatchingOnFabric: %d NumMatchingOnPeer: %d ActivityTime: %lu",
+                      session->mSession, session->mSession->GetPeer().GetFabricIndex(),
+                      ChipLogValueX64(session->mSession->GetPeer().GetNodeId()), session->mSession->GetStateStr(),
+                      session->mNumMatchingOnFabric, session->mNumMatchingOnPeer,
+                      static_cast<unsigned long>(session->mSession->GetLastActivityTime().count()));
         ChipLogProgress(SecureChannel, "Candidate Session[%p] - Attempting to evict...", session->mSession);
 
         auto prevCount = mEntries.Allocated();
@@ -226,115 +207,188 @@ SecureSession * SecureSessionTable::EvictAndAllocate(uint16_t localSessionId, Se
     return nullptr;
 }
 
-void SecureSessionTable::DefaultEvictionPolicy(EvictionPolicyContext & evictionContext)
+void SecureSessionTable::CountMatchingSessions(Span<SortableSession> sessions)
 {
     //
-    // This implements a spec-compliant sorting policy that ensures both guarantees for sessions per-fabric as
-    // mandated by the spec as well as fairness in terms of selecting the most appropriate session to evict
-    // based on multiple criteria.
+    // Compute two key stats for each session - the number of other sessions that
+    // match its fabric, as well as the number of other sessions that match its peer.
     //
-    // See the description of this function in the header for more details on each sorting key below.
+    // Sessions to the same peer are found through the peer index. Sessions are only spread
+    // over a handful of fabrics, which are counted in a small table; the fabrics which do
+    // not fit in it, if any, are counted by going through the sessions.
     //
-    evictionContext.Sort([&evictionContext](const SortableSession & a, const SortableSession & b) -> bool {
-        //
-        // Sorting on Key1
-        //
-        if (a.mNumMatchingOnFabric != b.mNumMatchingOnFabric)
+    struct FabricSessionCount
+    {
+        FabricIndex mFabricIndex;
+        uint16_t mCount;
+    };
+    FabricSessionCount fabricCounts[CHIP_CONFIG_MAX_FABRICS + 1];
+    size_t fabricCount = 0;
+
+    auto findFabric = [&](FabricIndex fabricIndex) -> FabricSessionCount * {
+        for (size_t i = 0; i < fabricCount; i++)
         {
-            return a.mNumMatchingOnFabric > b.mNumMatchingOnFabric;
+            if (fabricCounts[i].mFabricIndex == fabricIndex)
+            {
+                return &fabricCounts[i];
+            }
         }
+        return nullptr;
+    };
 
-        bool doesAMatchSessionHintFabric =
-            a.mSession->GetPeer().GetFabricIndex() == evictionContext.GetSessionEvictionHint().GetFabricIndex();
-        bool doesBMatchSessionHintFabric =
-            b.mSession->GetPeer().GetFabricIndex() == evictionContext.GetSessionEvictionHint().GetFabricIndex();
-
-        //
-        // Sorting on Key2
-        //
-        if (doesAMatchSessionHintFabric != doesBMatchSessionHintFabric)
+    for (auto & session : sessions)
+    {
+        FabricSessionCount * count = findFabric(session.mSession->GetFabricIndex());
+        if (count == nullptr && fabricCount < ArraySize(fabricCounts))
         {
-            return doesAMatchSessionHintFabric > doesBMatchSessionHintFabric;
+            count = &fabricCounts[fabricCount++];
+            *count = { session.mSession->GetFabricIndex(), 0 };
         }
-
-        //
-        // Sorting on Key3
-        //
-        if (a.mNumMatchingOnPeer != b.mNumMatchingOnPeer)
+        if (count != nullptr)
         {
-            return a.mNumMatchingOnPeer > b.mNumMatchingOnPeer;
+            count->mCount++;
         }
+    }
 
-        // We have an evicton hint in two cases:
-        //
-        // 1) When we just established CASE as a responder, the hint is the node
-        //    we just established CASE to.
-        // 2) When starting to establish CASE as an initiator, the hint is the
-        //    node we are going to establish CASE to.
-        //
-        // In case 2, we should not end up here if there is an active session to
-        // the peer at all (because that session should have been used instead
-        // of establishing a new one).
-        //
-        // In case 1, we know we have a session matching the hint, but we don't
-        // want to pick that one for eviction, because we just established it.
-        // So we should not consider a session as matching a hint if it's active
-        // and is the only session to our peer.
-        //
-        // Checking for the "active" state in addition to the "only session to
-        // peer" state allows us to prioritize evicting defuct sessions that
-        // match the hint against other defunct sessions.
-        auto sessionMatchesEvictionHint = [&evictionContext](const SortableSession & session) -> int {
-            if (session.mSession->GetPeer() != evictionContext.GetSessionEvictionHint())
-            {
-                return false;
-            }
-            bool isOnlyActiveSessionToPeer = session.mSession->IsActiveSession() && session.mNumMatchingOnPeer == 0;
-            return !isOnlyActiveSessionToPeer;
-        };
-        int doesAMatchSessionHint = sessionMatchesEvictionHint(a);
-        int doesBMatchSessionHint = sessionMatchesEvictionHint(b);
-
-        //
-        // Sorting on Key4
-        //
-        if (doesAMatchSessionHint != doesBMatchSessionHint)
+    for (auto & session : sessions)
+    {
+        const FabricSessionCount * count = findFabric(session.mSession->GetFabricIndex());
+        if (count != nullptr)
         {
-            return doesAMatchSessionHint > doesBMatchSessionHint;
+            session.mNumMatchingOnFabric = static_cast<uint16_t>(count->mCount - 1);
         }
-
-        int aStateScore = 0, bStateScore = 0;
-        auto assignStateScore = [](auto & score, const auto & session) {
-            if (session.IsDefunct())
-            {
-                score = 2;
-            }
-            else if (session.IsActiveSession())
+        else
+        {
+            session.mNumMatchingOnFabric = 0;
+            for (auto & otherSession : sessions)
             {
-                score = 1;
+                if (&otherSession != &session && otherSession.mSession->GetFabricIndex() == session.mSession->GetFabricIndex())
+                {
+                    session.mNumMatchingOnFabric++;
+                }
             }
-            else
+        }
+
+        session.mNumMatchingOnPeer = 0;
+        ForEachSessionToPeer(session.mSession->GetPeer(), [&session](SecureSession * otherSession) {
+            if (otherSession != session.mSession)
             {
-                score = 0;
+                session.mNumMatchingOnPeer++;
             }
-        };
+            return Loop::Continue;
+        });
+    }
+}
+
+bool SecureSessionTable::DefaultEvictionPolicy(const EvictionPolicyContext & evictionContext, const SortableSession & a,
+                                               const SortableSession & b)
+{
+    //
+    // This implements a spec-compliant sorting policy that ensures both guarantees for sessions per-fabric as
+    // mandated by the spec as well as fairness in terms of selecting the most appropriate session to evict
+    // based on multiple criteria.
+    //
+    // See the description of this function in the header for more details on each sorting key below.
+    //
 
-        assignStateScore(aStateScore, *a.mSession);
-        assignStateScore(bStateScore, *b.mSession);
+    //
+    // Sorting on Key1
+    //
+    if (a.mNumMatchingOnFabric != b.mNumMatchingOnFabric)
+    {
+        return a.mNumMatchingOnFabric > b.mNumMatchingOnFabric;
+    }
 
-        //
-        // Sorting on Key5
-        //
-        if (aStateScore != bStateScore)
+    bool doesAMatchSessionHintFabric =
+        a.mSession->GetPeer().GetFabricIndex() == evictionContext.GetSessionEvictionHint().GetFabricIndex();
+    bool doesBMatchSessionHintFabric =
+        b.mSession->GetPeer().GetFabricIndex() == evictionContext.GetSessionEvictionHint().GetFabricIndex();
+
+    //
+    // Sorting on Key2
+    //
+    if (doesAMatchSessionHintFabric != doesBMatchSessionHintFabric)
+    {
+        return doesAMatchSessionHintFabric > doesBMatchSessionHintFabric;
+    }
+
+    //
+    // Sorting on Key3
+    //
+    if (a.mNumMatchingOnPeer != b.mNumMatchingOnPeer)
+    {
+        return a.mNumMatchingOnPeer > b.mNumMatchingOnPeer;
+    }
+
+    // We have an evicton hint in two cases:
+    //
+    // 1) When we just established CASE as a responder, the hint is the node
+    //    we just established CASE to.
+    // 2) When starting to establish CASE as an initiator, the hint is the
+    //    node we are going to establish CASE to.
+    //
+    // In case 2, we should not end up here if there is an active session to
+    // the peer at all (because that session should have been used instead
+    // of establishing a new one).
+    //
+    // In case 1, we know we have a session matching the hint, but we don't
+    // want to pick that one for eviction, because we just established it.
+    // So we should not consider a session as matching a hint if it's active
+    // and is the only session to our peer.
+    //
+    // Checking for the "active" state in addition to the "only session to
+    // peer" state allows us to prioritize evicting defuct sessions that
+    // match the hint against other defunct sessions.
+    auto sessionMatchesEvictionHint = [&evictionContext](const SortableSession & session) -> int {
+        if (session.mSession->GetPeer() != evictionContext.GetSessionEvictionHint())
         {
-            return (aStateScore > bStateScore);
+            return false;
         }
+        bool isOnlyActiveSessionToPeer = session.mSession->IsActiveSession() && session.mNumMatchingOnPeer == 0;
+        return !isOnlyActiveSessionToPeer;
+    };
+    int doesAMatchSessionHint = sessionMatchesEvictionHint(a);
+    int doesBMatchSessionHint = sessionMatchesEvictionHint(b);
 
-        //
-        // Sorting on Key6
-        //
-        return (a->GetLastActivityTime() < b->GetLastActivityTime());
-    });
+    //
+    // Sorting on Key4
+    //
+    if (doesAMatchSessionHint != doesBMatchSessionHint)
+    {
+        return doesAMatchSessionHint > doesBMatchSessionHint;
+    }
+
+    int aStateScore = 0, bStateScore = 0;
+    auto assignStateScore = [](auto & score, const auto & session) {
+        if (session.IsDefunct())
+        {
+            score = 2;
+        }
+        else if (session.IsActiveSession())
+        {
+            score = 1;
+        }
+        else
+        {
+            score = 0;
+        }
+    };
+
+    assignStateScore(aStateScore, *a.mSession);
+    assignStateScore(bStateScore, *b.mSession);
+
+    //
+    // Sorting on Key5
+    //
+    if (aStateScore != bStateScore)
+    {
+        return (aStateScore > bStateScore);
+    }
+
+    //
+    // Sorting on Key6
+    //
+    return (a->GetLastActivityTime() < b->GetLastActivityTime());
 }
 
 Optional<SessionHandle> SecureSessionTable::FindSecureSessionByLocalKey(uint16_t localSessionId)
@@ -403,5 +457,69 @@ Optional<uint16_t> SecureSessionTable::FindUnusedSessionId()
     return NullOptional;
 }
 
+size_t SecureSessionTable::PeerIndexHash(const ScopedNodeId & peer)
+{
+    // Fibonacci hashing: node IDs are often allocated sequentially, the multiplication spreads them over the high bits.
+    uint64_t key = peer.GetNodeId() ^ (static_cast<uint64_t>(peer.GetFabricIndex()) << 56);
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+void SecureSessionTable::AddToPeerIndex(SecureSession * session)
+{
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    if (mPeerIndexCount > mPeerIndexMask)
+    {
+        GrowPeerIndex();
+    }
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
+    SecureSession *& bucket   = mPeerIndex[PeerIndexHash(session->GetPeer()) & mPeerIndexMask];
+    session->mNextInPeerIndex = bucket;
+    bucket                    = session;
+    mPeerIndexCount++;
+}
+
+void SecureSessionTable::RemoveFromPeerIndex(SecureSession * session)
+{
+    for (SecureSession ** link = &mPeerIndex[PeerIndexHash(session->GetPeer()) & mPeerIndexMask]; *link != nullptr;
+         link                  = &(*link)->mNextInPeerIndex)
+    {
+        if (*link == session)
+        {
+            *link                     = session->mNextInPeerIndex;
+            session->mNextInPeerIndex = nullptr;
+            mPeerIndexCount--;
+            return;
+        }
+    }
+}
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+void SecureSessionTable::GrowPeerIndex()
+{
+    const size_t newSize = (mPeerIndexMask + 1) * 4;
+    Platform::ScopedMemoryBuffer<SecureSession *> newIndex;
+    // Without memory, the chains just get longer.
+    VerifyOrReturn(newIndex.Calloc(newSize));
+
+    for (size_t i = 0; i <= mPeerIndexMask; i++)
+    {
+        SecureSession * session = mPeerIndex[i];
+        while (session != nullptr)
+        {
+            SecureSession * next      = session->mNextInPeerIndex;
+            SecureSession *& bucket   = newIndex[PeerIndexHash(session->GetPeer()) & (newSize - 1)];
+            session->mNextInPeerIndex = bucket;
+            bucket                    = session;
+            session                   = next;
+        }
+    }
+
+    mPeerIndexHeap = std::move(newIndex);
+    mPeerIndex     = mPeerIndexHeap.Get();
+    mPeerIndexMask = newSize - 1;
+}
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
 } // namespace Transport
 } // namespace chip
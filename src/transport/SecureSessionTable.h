@@ -19,7 +19,7 @@
 #include <lib/core/CHIPError.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/Pool.h>
-#include <lib/support/SortUtils.h>
+#include <lib/support/ScopedBuffer.h>
 #include <system/TimeSource.h>
 #include <transport/SecureSession.h>
 
@@ -29,6 +29,16 @@ namespace Transport {
 inline constexpr uint16_t kMaxSessionID       = UINT16_MAX;
 inline constexpr uint16_t kUnsecuredSessionId = 0;
 
+// Number of buckets of the index of secure sessions by peer: the smallest power of two fitting the session pool.
+inline constexpr size_t kSecureSessionPeerIndexInitialSize = [] {
+    size_t size = 1;
+    while (size < CHIP_CONFIG_SECURE_SESSION_POOL_SIZE)
+    {
+        size <<= 1;
+    }
+    return size;
+}();
+
 /**
  * Handles a set of sessions.
  *
@@ -76,7 +86,11 @@ public:
     CHECK_RETURN_VALUE
     Optional<SessionHandle> CreateNewSecureSession(SecureSession::Type secureSessionType, ScopedNodeId sessionEvictionHint);
 
-    void ReleaseSession(SecureSession * session) { mEntries.ReleaseObject(session); }
+    void ReleaseSession(SecureSession * session)
+    {
+        RemoveFromPeerIndex(session);
+        mEntries.ReleaseObject(session);
+    }
 
     template <typename Function>
     Loop ForEachSession(Function && function)
@@ -84,6 +98,28 @@ public:
         return mEntries.ForEachActiveObject(std::forward<Function>(function));
     }
 
+    /**
+     * Call the provided function on the sessions whose peer is the given node, in no particular order, without going
+     * through the sessions to other peers.
+     *
+     * The function may release the session it is called on, but must not create or release any other session.
+     */
+    template <typename Function>
+    Loop ForEachSessionToPeer(const ScopedNodeId & peer, Function && function)
+    {
+        SecureSession * session = mPeerIndex[PeerIndexHash(peer) & mPeerIndexMask];
+        while (session != nullptr)
+        {
+            SecureSession * next = session->mNextInPeerIndex;
+            if (session->GetPeer() == peer && function(session) == Loop::Break)
+            {
+                return Loop::Break;
+            }
+            session = next;
+        }
+        return Loop::Finish;
+    }
+
     /**
      * Get a secure session given its session ID.
      *
@@ -100,7 +136,7 @@ public:
     void NewerSessionAvailable(SecureSession * session)
     {
         VerifyOrDie(session->GetSecureSessionType() == SecureSession::Type::kCASE);
-        mEntries.ForEachActiveObject([&](SecureSession * oldSession) {
+        ForEachSessionToPeer(session->GetPeer(), [&](SecureSession * oldSession) {
             if (session == oldSession)
                 return Loop::Continue;
 
@@ -110,7 +146,7 @@ public:
             //
             // See documentation for SessionDelegate::GetNewSessionHandlingPolicy about how session auto-shifting works, and how
             // to disable it for a specific SessionHolder in a specific scenario.
-            if (oldSession->GetSecureSessionType() == SecureSession::Type::kCASE && oldSession->GetPeer() == session->GetPeer() &&
+            if (oldSession->GetSecureSessionType() == SecureSession::Type::kCASE &&
                 oldSession->GetPeerCATs() == session->GetPeerCATs())
             {
                 oldSession->NewerSessionAvailable(SessionHandle(*session));
@@ -121,6 +157,7 @@ public:
     }
 
 private:
+    friend class SecureSession;
     friend class TestSecureSessionTable;
 
     /**
@@ -128,7 +165,7 @@ private:
      * isn't directly sortable since it is not swappable (i.e meet criteria for ValueSwappable).
      *
      * However, this wrapper has a stable pointer to a SecureSession while being swappable with
-     * another instance of it.
+     * another instance of it, so that eviction candidates can be arranged in a heap.
      *
      */
     struct SortableSession
@@ -160,50 +197,25 @@ private:
 
     /**
      *
-     * Encapsulates all the necessary context for an eviction policy callback
-     * to implement its specific policy. The context is provided to the callee
-     * with the expectation that it'll call Sort() with a comparator function provided
-     * to get the list of sessions sorted in the desired order.
+     * Encapsulates all the necessary context for an eviction policy to rank two candidate sessions.
      *
      */
     class EvictionPolicyContext
     {
     public:
-        /*
-         * Called by the policy implementor to sort the list of sessions given a comparator
-         * function. The provided function shall have the following signature:
-         *
-         * bool CompareFunc(const SortableSession &a, const SortableSession &b);
-         *
-         * If a is a better candidate than b, true should be returned. Else, return false.
-         *
-         * NOTE: Sort() can be called multiple times.
-         *
-         */
-        template <typename CompareFunc>
-        void Sort(CompareFunc func)
-        {
-            Sorting::InsertionSort(mSessionList.begin(), mSessionList.size(), func);
-        }
-
         const ScopedNodeId & GetSessionEvictionHint() const { return mSessionEvictionHint; }
 
     private:
-        EvictionPolicyContext(Span<SortableSession> sessionList, ScopedNodeId sessionEvictionHint)
-        {
-            mSessionList         = sessionList;
-            mSessionEvictionHint = sessionEvictionHint;
-        }
+        EvictionPolicyContext(ScopedNodeId sessionEvictionHint) : mSessionEvictionHint(sessionEvictionHint) {}
 
         friend class SecureSessionTable;
-        Span<SortableSession> mSessionList;
         ScopedNodeId mSessionEvictionHint;
     };
 
     /**
      *
-     * This implements an eviction policy by sorting sessions using the following sorting keys and selecting
-     * the session that is most ahead as the best candidate for eviction:
+     * This implements an eviction policy by ordering sessions using the following sorting keys, the session that is most
+     * ahead being the best candidate for eviction. Returns whether a is a better candidate than b:
      *
      *  - Key1:  Sessions on fabrics that have more sessions in the table are placed ahead of sessions on fabrics
      *           with fewer sessions. We conclusively know that if a particular fabric has more sessions in the table
@@ -230,12 +242,16 @@ private:
      *           is the canonical sorting criteria for basic LRU.
      *
      */
-    void DefaultEvictionPolicy(EvictionPolicyContext & evictionContext);
+    static bool DefaultEvictionPolicy(const EvictionPolicyContext & evictionContext, const SortableSession & a,
+                                      const SortableSession & b);
 
     /**
      *
      * Evicts a session from the session table using the DefaultEvictionPolicy implementation.
      *
+     * The candidates are arranged in a heap rather than sorted, since the first one or two candidates are normally
+     * enough: this takes O(n) to find the first candidate, and O(log n) for each next one.
+     *
      */
     SecureSession * EvictAndAllocate(uint16_t localSessionId, SecureSession::Type secureSessionType,
                                      const ScopedNodeId & sessionEvictionHint);
@@ -256,9 +272,31 @@ private:
     CHECK_RETURN_VALUE
     Optional<uint16_t> FindUnusedSessionId();
 
+    /**
+     * Count, for each session, the sessions on the same fabric and the sessions to the same peer, for the eviction policy.
+     */
+    void CountMatchingSessions(Span<SortableSession> sessions);
+
+    // Sessions are chained by peer in a hash table, so that the sessions to a node are found without going through the
+    // whole table. SecureSession calls these around any change of its peer.
+    void AddToPeerIndex(SecureSession * session);
+    void RemoveFromPeerIndex(SecureSession * session);
+    static size_t PeerIndexHash(const ScopedNodeId & peer);
+
     bool mRunningEvictionLogic = false;
     ObjectPool<SecureSession, CHIP_CONFIG_SECURE_SESSION_POOL_SIZE> mEntries;
 
+    SecureSession * mPeerIndexInline[kSecureSessionPeerIndexInitialSize] = {};
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    // Heap pools are not bounded by CHIP_CONFIG_SECURE_SESSION_POOL_SIZE, so the index grows into the heap if the table
+    // holds more sessions than it has buckets.
+    void GrowPeerIndex();
+    Platform::ScopedMemoryBuffer<SecureSession *> mPeerIndexHeap;
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    SecureSession ** mPeerIndex = mPeerIndexInline;
+    size_t mPeerIndexMask       = kSecureSessionPeerIndexInitialSize - 1;
+    size_t mPeerIndexCount      = 0;
+
     size_t GetMaxSessionTableSize() const
     {
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
@@ -506,6 +506,25 @@ public:
 
     Crypto::SessionKeystore * GetSessionKeystore() const { return mSessionKeystore; }
 
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_COPY_STATS
+    /**
+     * Packet buffer allocations and copies made while handling received messages.
+     *
+     * A message is measured from the moment it reaches OnMessageReceived() until its synchronous dispatch returns, so work
+     * done by the message delegate (e.g. allocating a response) is included.  A receive path that keeps the decrypted payload
+     * in the buffer it arrived in, and only reads it through TLV readers backed by that buffer, reports no copies.
+     */
+    struct ReceiveStats
+    {
+        uint32_t mMessageCount = 0;
+        System::PacketBufferCounters mLastMessage;
+        System::PacketBufferCounters mTotal;
+    };
+
+    const ReceiveStats & GetReceiveStats() const { return mReceiveStats; }
+    void ResetReceiveStats() { mReceiveStats = ReceiveStats(); }
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_COPY_STATS
+
 private:
     /**
      *    The State of a secure transport object.
@@ -551,6 +570,29 @@ private:
 
     GlobalUnencryptedMessageCounter mGlobalUnencryptedMessageCounter;
 
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_COPY_STATS
+    /**
+     * Records the packet buffer counters accumulated over its lifetime as one received message.
+     */
+    class ReceiveStatsScope
+    {
+    public:
+        ReceiveStatsScope(ReceiveStats & stats) : mStats(stats), mStart(System::PacketBuffer::GetCounters()) {}
+        ~ReceiveStatsScope()
+        {
+            mStats.mLastMessage = System::PacketBuffer::GetCounters() - mStart;
+            mStats.mTotal += mStats.mLastMessage;
+            mStats.mMessageCount++;
+        }
+
+    private:
+        ReceiveStats & mStats;
+        const System::PacketBufferCounters mStart;
+    };
+
+    ReceiveStats mReceiveStats;
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_COPY_STATS
+
     /**
      * @brief Parse, decrypt, validate, and dispatch a secure unicast message.
      *
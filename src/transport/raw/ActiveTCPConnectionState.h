@@ -75,6 +75,11 @@ struct ActiveTCPConnectionState
 
     bool IsConnecting() const { return (mEndPoint != nullptr && mConnectionState == TCPState::kConnecting); }
 
+    bool IsPeer(const Inet::IPAddress & addr, uint16_t port) const
+    {
+        return (mPeerAddr.GetIPAddress() == addr && mPeerAddr.GetPort() == port);
+    }
+
     // Associated endpoint.
     Inet::TCPEndPoint * mEndPoint;
 
@@ -145,19 +145,20 @@ ActiveTCPConnectionState * TCPBase::FindActiveConnection(const PeerAddress & add
         return nullptr;
     }
 
+    // Most sends go to the peer of the connection used last, so try it before scanning.
+    if (mLastActiveConnection != nullptr && mLastActiveConnection->IsConnected() &&
+        mLastActiveConnection->IsPeer(address.GetIPAddress(), address.GetPort()))
+    {
+        return mLastActiveConnection;
+    }
+
     for (size_t i = 0; i < mActiveConnectionsSize; i++)
     {
-        if (!mActiveConnections[i].IsConnected())
+        // Compare against the peer address recorded when the connection was set up, which avoids querying the end point.
+        if (mActiveConnections[i].IsConnected() && mActiveConnections[i].IsPeer(address.GetIPAddress(), address.GetPort()))
         {
-            continue;
-        }
-        Inet::IPAddress addr;
-        uint16_t port;
-        mActiveConnections[i].mEndPoint->GetPeerInfo(&addr, &port);
-
-        if ((addr == address.GetIPAddress()) && (port == address.GetPort()))
-        {
-            return &mActiveConnections[i];
+            mLastActiveConnection = &mActiveConnections[i];
+            return mLastActiveConnection;
         }
     }
 
@@ -167,11 +168,18 @@ ActiveTCPConnectionState * TCPBase::FindActiveConnection(const PeerAddress & add
 // Find the ActiveTCPConnectionState for a given TCPEndPoint
 ActiveTCPConnectionState * TCPBase::FindActiveConnection(const Inet::TCPEndPoint * endPoint)
 {
+    // Received data usually keeps arriving on the same connection, so try the one used last before scanning.
+    if (mLastActiveConnection != nullptr && mLastActiveConnection->mEndPoint == endPoint && mLastActiveConnection->IsConnected())
+    {
+        return mLastActiveConnection;
+    }
+
     for (size_t i = 0; i < mActiveConnectionsSize; i++)
     {
         if (mActiveConnections[i].mEndPoint == endPoint && mActiveConnections[i].IsConnected())
         {
-            return &mActiveConnections[i];
+            mLastActiveConnection = &mActiveConnections[i];
+            return mLastActiveConnection;
         }
     }
     return nullptr;
@@ -317,6 +317,9 @@ private:
     ActiveTCPConnectionState * mActiveConnections;
     const size_t mActiveConnectionsSize;
 
+    // Connection most recently found by FindActiveConnection, checked before scanning mActiveConnections.
+    ActiveTCPConnectionState * mLastActiveConnection = nullptr;
+
     // Data to be sent when connections succeed
     PendingPacketPoolType & mPendingPackets;
 };
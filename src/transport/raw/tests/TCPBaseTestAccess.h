@@ -37,6 +37,10 @@ public:
     {
         return tcp.FindActiveConnection(peerAddress);
     }
+    static void * FindActiveConnection(TCPImpl & tcp, const Inet::TCPEndPoint * endPoint)
+    {
+        return tcp.FindActiveConnection(endPoint);
+    }
     static Inet::TCPEndPoint * GetEndpoint(void * state) { return static_cast<ActiveTCPConnectionState *>(state)->mEndPoint; }
 
     static CHIP_ERROR ProcessReceivedBuffer(TCPImpl & tcp, Inet::TCPEndPoint * endPoint, const PeerAddress & peerAddress,
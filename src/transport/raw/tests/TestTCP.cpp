@@ -200,6 +200,35 @@ public:
         SetCallback(nullptr);
     }
 
+    void LargeMessagesTest(TCPImpl & tcp, const IPAddress & addr)
+    {
+        // Send near-maximum-size messages, so that most of them straddle receive buffers. Messages are sent a window at a
+        // time, to stay within packet buffer pools.
+        constexpr int kMessageCount       = 40;
+        constexpr int kWindowSize         = 4;
+        constexpr size_t kMessageDataSize = 1200;
+
+        PacketHeader header;
+        header.SetSourceNodeId(kSourceNodeId).SetDestinationNodeId(kDestinationNodeId).SetMessageCounter(kMessageCounter);
+
+        for (int sent = 0; sent < kMessageCount;)
+        {
+            for (int i = 0; i < kWindowSize; i++, sent++)
+            {
+                chip::System::PacketBufferHandle buffer = chip::System::PacketBufferHandle::New(kMessageDataSize);
+                ASSERT_FALSE(buffer.IsNull());
+                memset(buffer->Start(), static_cast<uint8_t>(sent), kMessageDataSize);
+                buffer->SetDataLength(kMessageDataSize);
+                ASSERT_EQ(header.EncodeBeforeData(buffer), CHIP_NO_ERROR);
+                ASSERT_EQ(tcp.SendMessage(Transport::PeerAddress::TCP(addr, gChipTCPPort), std::move(buffer)), CHIP_NO_ERROR);
+            }
+
+            mIOContext->DriveIOUntil(chip::System::Clock::Seconds16(5),
+                                     [this, sent]() { return mReceiveHandlerCallCount == sent; });
+            ASSERT_EQ(mReceiveHandlerCallCount, sent);
+        }
+    }
+
     void ConnectTest(TCPImpl & tcp, const IPAddress & addr)
     {
         // Connect and wait for seeing active connection
@@ -464,6 +493,16 @@ protected:
         gMockTransportMgrDelegate.DisconnectTest(tcp, addr);
     }
 
+    void CheckLargeMessagesTest(const IPAddress & addr)
+    {
+        TCPImpl tcp;
+
+        MockTransportMgrDelegate gMockTransportMgrDelegate(mIOContext);
+        gMockTransportMgrDelegate.InitializeMessageTest(tcp, addr);
+        gMockTransportMgrDelegate.LargeMessagesTest(tcp, addr);
+        gMockTransportMgrDelegate.DisconnectTest(tcp, addr);
+    }
+
     void ConnectToSelfTest(const IPAddress & addr)
     {
         TCPImpl tcp;
@@ -557,6 +596,13 @@ TEST_F(TestTCP, CheckMessageTest6)
     CheckMessageTest(addr);
 }
 
+TEST_F(TestTCP, CheckLargeMessagesTest6)
+{
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+    CheckLargeMessagesTest(addr);
+}
+
 #if INET_CONFIG_ENABLE_IPV4
 TEST_F(TestTCP, ConnectToSelfTest4)
 {
@@ -608,6 +654,71 @@ TEST_F(TestTCP, HandleConnCloseCalledTest6)
     HandleConnCloseTest(addr);
 }
 
+TEST_F(TestTCP, CheckConnectionLookupAfterSlotReuse)
+{
+    TCPImpl tcp;
+
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+
+    MockTransportMgrDelegate gMockTransportMgrDelegate(mIOContext);
+    gMockTransportMgrDelegate.InitializeMessageTest(tcp, addr);
+
+    // Connecting to itself sets up two connections: the outgoing one, to the listen port, and the incoming one, from the
+    // local port of the outgoing one.
+    Transport::PeerAddress listenPeer = Transport::PeerAddress::TCP(addr, gChipTCPPort);
+    auto connect = [&](void *& outgoing, void *& incoming, Transport::PeerAddress & incomingPeer) {
+        gMockTransportMgrDelegate.ConnectTest(tcp, addr);
+        outgoing = TestAccess::FindActiveConnection(tcp, listenPeer);
+        ASSERT_NE(outgoing, nullptr);
+
+        IPAddress localAddr;
+        uint16_t localPort = 0;
+        ASSERT_EQ(TestAccess::GetEndpoint(outgoing)->GetLocalInfo(&localAddr, &localPort), CHIP_NO_ERROR);
+        incomingPeer = Transport::PeerAddress::TCP(addr, localPort);
+        mIOContext->DriveIOUntil(chip::System::Clock::Seconds16(5),
+                                 [&]() { return TestAccess::FindActiveConnection(tcp, incomingPeer) != nullptr; });
+        incoming = TestAccess::FindActiveConnection(tcp, incomingPeer);
+        ASSERT_NE(incoming, nullptr);
+        EXPECT_NE(incoming, outgoing);
+    };
+
+    void * firstOutgoing  = nullptr;
+    void * firstIncoming  = nullptr;
+    void * secondOutgoing = nullptr;
+    void * secondIncoming = nullptr;
+    Transport::PeerAddress firstIncomingPeer;
+    Transport::PeerAddress secondIncomingPeer;
+
+    connect(firstOutgoing, firstIncoming, firstIncomingPeer);
+    ASSERT_FALSE(HasFatalFailure());
+    Inet::TCPEndPoint * firstIncomingEndPoint = TestAccess::GetEndpoint(firstIncoming);
+    EXPECT_EQ(TestAccess::FindActiveConnection(tcp, firstIncomingEndPoint), firstIncoming);
+
+    // Closed connections are not found, even the one looked up last.
+    gMockTransportMgrDelegate.DisconnectTest(tcp, addr);
+    EXPECT_EQ(TestAccess::FindActiveConnection(tcp, firstIncomingPeer), nullptr);
+    EXPECT_EQ(TestAccess::FindActiveConnection(tcp, firstIncomingEndPoint), nullptr);
+
+    // New connections reuse the slots of the closed ones; looking them up leaves the last lookup on the reused slot of the
+    // first incoming connection, which must not be returned for that closed connection.
+    connect(secondOutgoing, secondIncoming, secondIncomingPeer);
+    ASSERT_FALSE(HasFatalFailure());
+    EXPECT_EQ(secondOutgoing, firstOutgoing);
+    EXPECT_EQ(secondIncoming, firstIncoming);
+    EXPECT_EQ(TestAccess::FindActiveConnection(tcp, firstIncomingPeer), nullptr);
+    void * state = TestAccess::FindActiveConnection(tcp, firstIncomingEndPoint);
+    EXPECT_TRUE(state == nullptr || TestAccess::GetEndpoint(state) == firstIncomingEndPoint);
+
+    // The new connections are found by their peer address and by their end point.
+    EXPECT_EQ(TestAccess::FindActiveConnection(tcp, secondIncomingPeer), secondIncoming);
+    EXPECT_EQ(TestAccess::FindActiveConnection(tcp, listenPeer), secondOutgoing);
+    EXPECT_EQ(TestAccess::FindActiveConnection(tcp, TestAccess::GetEndpoint(secondIncoming)), secondIncoming);
+    EXPECT_EQ(TestAccess::FindActiveConnection(tcp, TestAccess::GetEndpoint(secondOutgoing)), secondOutgoing);
+
+    gMockTransportMgrDelegate.DisconnectTest(tcp, addr);
+}
+
 TEST_F(TestTCP, CheckProcessReceivedBuffer)
 {
     TCPImpl tcp;
@@ -664,6 +775,31 @@ TEST_F(TestTCP, CheckProcessReceivedBuffer)
     EXPECT_EQ(err, CHIP_NO_ERROR);
     EXPECT_EQ(gMockTransportMgrDelegate.mReceiveHandlerCallCount, 2);
 
+    // Test a message followed by the start of the next one in the same packet buffer, with the rest of the next message
+    // arriving in a later buffer.
+    gMockTransportMgrDelegate.mReceiveHandlerCallCount = 0;
+    EXPECT_TRUE(testData[0].Init((const uint16_t[]){ 301, 0 }));
+    EXPECT_TRUE(testData[1].Init((const uint16_t[]){ 302, 0 }));
+    {
+        constexpr size_t kSplitOffset = 40;
+
+        System::PacketBufferHandle first = System::PacketBufferHandle::New(testData[0].mTotalLength + kSplitOffset, 0);
+        ASSERT_FALSE(first.IsNull());
+        memcpy(first->Start(), testData[0].mPayload, testData[0].mTotalLength);
+        memcpy(first->Start() + testData[0].mTotalLength, testData[1].mPayload, kSplitOffset);
+        first->SetDataLength(testData[0].mTotalLength + kSplitOffset);
+        err = TestAccess::ProcessReceivedBuffer(tcp, lEndPoint, lPeerAddress, std::move(first));
+        EXPECT_EQ(err, CHIP_NO_ERROR);
+        EXPECT_EQ(gMockTransportMgrDelegate.mReceiveHandlerCallCount, 1);
+
+        System::PacketBufferHandle second =
+            System::PacketBufferHandle::NewWithData(testData[1].mPayload + kSplitOffset, testData[1].mTotalLength - kSplitOffset);
+        ASSERT_FALSE(second.IsNull());
+        err = TestAccess::ProcessReceivedBuffer(tcp, lEndPoint, lPeerAddress, std::move(second));
+        EXPECT_EQ(err, CHIP_NO_ERROR);
+        EXPECT_EQ(gMockTransportMgrDelegate.mReceiveHandlerCallCount, 2);
+    }
+
     // Test a message that is too large to coalesce into a single packet buffer.
     gMockTransportMgrDelegate.mReceiveHandlerCallCount = 0;
     gMockTransportMgrDelegate.SetCallback(TestDataCallbackCheck, &testData[1]);
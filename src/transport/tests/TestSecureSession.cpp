@@ -157,3 +157,81 @@ TEST(TestSecureSession, SecureChannelDecryptTest)
 
     EXPECT_EQ(memcmp(plain_text, output, sizeof(plain_text)), 0);
 }
+
+TEST(TestSecureSession, SecureChannelBatchTest)
+{
+    Crypto::DefaultSessionKeystore sessionKeystore;
+    CryptoContext initiator;
+    CryptoContext responder;
+    constexpr size_t kMessageCount  = 8;
+    constexpr size_t kMessageLength = 48;
+    uint8_t plainText[kMessageCount][kMessageLength];
+    uint8_t encrypted[kMessageCount][kMessageLength];
+    uint8_t decrypted[kMessageCount][kMessageLength];
+    PacketHeader headers[kMessageCount];
+    MessageAuthenticationCode macs[kMessageCount];
+    CryptoContext::BatchMessage messages[kMessageCount];
+
+    P256Keypair keypair;
+    EXPECT_EQ(keypair.Initialize(ECPKeyTarget::ECDH), CHIP_NO_ERROR);
+
+    P256Keypair keypair2;
+    EXPECT_EQ(keypair2.Initialize(ECPKeyTarget::ECDH), CHIP_NO_ERROR);
+
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        memset(plainText[i], static_cast<int>(i), kMessageLength);
+        headers[i].SetSessionId(1).SetMessageCounter(static_cast<uint32_t>(i));
+
+        messages[i].mInput       = plainText[i];
+        messages[i].mInputLength = kMessageLength;
+        messages[i].mOutput      = encrypted[i];
+        messages[i].mHeader      = &headers[i];
+        messages[i].mMac         = &macs[i];
+        CryptoContext::BuildNonce(messages[i].mNonce, headers[i].GetSecurityFlags(), headers[i].GetMessageCounter(), 0);
+    }
+
+    // Uninitialized channel
+    EXPECT_EQ(initiator.EncryptBatch(Span<CryptoContext::BatchMessage>(messages)), CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
+    EXPECT_EQ(messages[kMessageCount - 1].mResult, CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
+
+    EXPECT_EQ(initiator.InitFromKeyPair(sessionKeystore, keypair, keypair2.Pubkey(), ByteSpan(),
+                                        CryptoContext::SessionInfoType::kSessionEstablishment,
+                                        CryptoContext::SessionRole::kInitiator),
+              CHIP_NO_ERROR);
+    EXPECT_EQ(responder.InitFromKeyPair(sessionKeystore, keypair2, keypair.Pubkey(), ByteSpan(),
+                                        CryptoContext::SessionInfoType::kSessionEstablishment,
+                                        CryptoContext::SessionRole::kResponder),
+              CHIP_NO_ERROR);
+
+    EXPECT_EQ(initiator.EncryptBatch(Span<CryptoContext::BatchMessage>(messages)), CHIP_NO_ERROR);
+
+    // Every message of the batch must match its one-by-one encryption.
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        uint8_t expected[kMessageLength];
+        MessageAuthenticationCode expectedMac;
+        EXPECT_EQ(messages[i].mResult, CHIP_NO_ERROR);
+        EXPECT_EQ(initiator.Encrypt(plainText[i], kMessageLength, expected, messages[i].mNonce, headers[i], expectedMac),
+                  CHIP_NO_ERROR);
+        EXPECT_EQ(memcmp(expected, encrypted[i], kMessageLength), 0);
+        EXPECT_EQ(memcmp(expectedMac.GetTag(), macs[i].GetTag(), headers[i].MICTagLength()), 0);
+
+        messages[i].mInput  = encrypted[i];
+        messages[i].mOutput = decrypted[i];
+    }
+
+    // A message failing authentication does not prevent the others from being decrypted.
+    encrypted[2][0] ^= 1;
+    EXPECT_NE(responder.DecryptBatch(Span<CryptoContext::BatchMessage>(messages)), CHIP_NO_ERROR);
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        if (i == 2)
+        {
+            EXPECT_NE(messages[i].mResult, CHIP_NO_ERROR);
+            continue;
+        }
+        EXPECT_EQ(messages[i].mResult, CHIP_NO_ERROR);
+        EXPECT_EQ(memcmp(plainText[i], decrypted[i], kMessageLength), 0);
+    }
+}
@@ -21,6 +21,7 @@
  *      This file implements unit tests for the SessionManager implementation.
  */
 
+#include <chrono>
 #include <errno.h>
 #include <vector>
 
@@ -42,6 +43,8 @@ public:
     static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
 
     void ValidateSessionSorting();
+    void ValidatePeerIndex();
+    void BenchmarkScaling();
 
 private:
     struct SessionParameters
@@ -451,6 +454,150 @@ void TestSecureSessionTable::ValidateSessionSorting()
     }
 }
 
+void TestSecureSessionTable::ValidatePeerIndex()
+{
+    const ReliableMessageProtocolConfig config(System::Clock::Milliseconds32(0), System::Clock::Milliseconds32(0),
+                                               System::Clock::Milliseconds16(0));
+    const ScopedNodeId peer(2, kFabric1);
+
+    mSessionTable = Platform::MakeUnique<SecureSessionTable>();
+    ASSERT_NE(mSessionTable.get(), nullptr);
+    mSessionTable->Init();
+
+    auto countSessionsToPeer = [this](const ScopedNodeId & node) {
+        unsigned count = 0;
+        mSessionTable->ForEachSessionToPeer(node, [&count, &node](SecureSession * session) {
+            EXPECT_EQ(session->GetPeer(), node);
+            count++;
+            return Loop::Continue;
+        });
+        return count;
+    };
+
+    // Pending sessions are indexed under their peer once activated.
+    auto session1 = mSessionTable->CreateNewSecureSession(SecureSession::Type::kCASE, peer);
+    auto session2 = mSessionTable->CreateNewSecureSession(SecureSession::Type::kCASE, peer);
+    ASSERT_TRUE(session1.HasValue() && session2.HasValue());
+    EXPECT_EQ(countSessionsToPeer(peer), 0u);
+
+    session1.Value()->AsSecureSession()->Activate(ScopedNodeId(1, kFabric1), peer, CATValues(), 1, config);
+    EXPECT_EQ(countSessionsToPeer(peer), 1u);
+    session2.Value()->AsSecureSession()->Activate(ScopedNodeId(1, kFabric1), peer, CATValues(), 2, config);
+    EXPECT_EQ(countSessionsToPeer(peer), 2u);
+    EXPECT_EQ(countSessionsToPeer(ScopedNodeId(2, kFabric2)), 0u);
+
+    // PASE sessions move to their new fabric when adopting it.
+    auto pase = mSessionTable->CreateNewSecureSession(SecureSession::Type::kPASE, ScopedNodeId());
+    ASSERT_TRUE(pase.HasValue());
+    pase.Value()->AsSecureSession()->Activate(ScopedNodeId(), ScopedNodeId(kUndefinedNodeId, kUndefinedFabricIndex), CATValues(),
+                                              3, config);
+    EXPECT_EQ(pase.Value()->AsSecureSession()->AdoptFabricIndex(kFabric2), CHIP_NO_ERROR);
+    EXPECT_EQ(countSessionsToPeer(ScopedNodeId(kUndefinedNodeId, kFabric2)), 1u);
+    EXPECT_EQ(countSessionsToPeer(ScopedNodeId(kUndefinedNodeId, kUndefinedFabricIndex)), 0u);
+
+    // Released sessions leave the index.
+    session1.Value()->AsSecureSession()->MarkForEviction();
+    session1.ClearValue();
+    EXPECT_EQ(countSessionsToPeer(peer), 1u);
+
+    session2.Value()->AsSecureSession()->MarkForEviction();
+    pase.Value()->AsSecureSession()->MarkForEviction();
+}
+
+void TestSecureSessionTable::BenchmarkScaling()
+{
+    const ReliableMessageProtocolConfig config(System::Clock::Milliseconds32(0), System::Clock::Milliseconds32(0),
+                                               System::Clock::Milliseconds16(0));
+    constexpr unsigned kIterations = 200;
+
+    for (size_t tableSize = 16; tableSize <= 4096; tableSize *= 4)
+    {
+#if !CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+        if (tableSize > CHIP_CONFIG_SECURE_SESSION_POOL_SIZE)
+        {
+            break;
+        }
+#endif // !CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
+        mSessionTable = Platform::MakeUnique<SecureSessionTable>();
+        ASSERT_NE(mSessionTable.get(), nullptr);
+        mSessionTable->Init();
+        mSessionTable->SetMaxSessionTableSize(tableSize);
+
+        // One session per peer, over three fabrics.
+        NodeId nextNodeId  = 1;
+        auto createSession = [&]() {
+            auto session = mSessionTable->CreateNewSecureSession(SecureSession::Type::kCASE, ScopedNodeId());
+            EXPECT_TRUE(session.HasValue());
+            VerifyOrReturn(session.HasValue());
+            FabricIndex fabric = static_cast<FabricIndex>(kFabric1 + nextNodeId % 3);
+            session.Value()->AsSecureSession()->Activate(ScopedNodeId(1, fabric), ScopedNodeId(nextNodeId, fabric), CATValues(),
+                                                         static_cast<uint16_t>(nextNodeId), config);
+            nextNodeId++;
+        };
+        for (size_t i = 0; i < tableSize; i++)
+        {
+            createSession();
+        }
+
+        auto start        = std::chrono::steady_clock::now();
+        unsigned matching = 0;
+        for (unsigned i = 0; i < kIterations; i++)
+        {
+            NodeId nodeId = 1 + (i * 7919) % tableSize;
+            ScopedNodeId peer(nodeId, static_cast<FabricIndex>(kFabric1 + nodeId % 3));
+            mSessionTable->ForEachSessionToPeer(peer, [&matching](SecureSession *) {
+                matching++;
+                return Loop::Continue;
+            });
+        }
+        std::chrono::duration<double, std::micro> indexedLookup = std::chrono::steady_clock::now() - start;
+        EXPECT_EQ(matching, kIterations);
+
+        start    = std::chrono::steady_clock::now();
+        matching = 0;
+        for (unsigned i = 0; i < kIterations; i++)
+        {
+            NodeId nodeId = 1 + (i * 7919) % tableSize;
+            ScopedNodeId peer(nodeId, static_cast<FabricIndex>(kFabric1 + nodeId % 3));
+            mSessionTable->ForEachSession([&matching, &peer](SecureSession * session) {
+                matching += (session->GetPeer() == peer) ? 1 : 0;
+                return Loop::Continue;
+            });
+        }
+        std::chrono::duration<double, std::micro> linearLookup = std::chrono::steady_clock::now() - start;
+        EXPECT_EQ(matching, kIterations);
+
+        // Every new session evicts one, the table staying full.
+        constexpr unsigned kEvictions = 20;
+        start                         = std::chrono::steady_clock::now();
+        for (unsigned i = 0; i < kEvictions; i++)
+        {
+            createSession();
+        }
+        std::chrono::duration<double, std::micro> eviction = std::chrono::steady_clock::now() - start;
+
+        ChipLogProgress(SecureChannel, "%5u sessions: peer lookup %.3f us (linear scan %.3f us), eviction %.1f us",
+                        static_cast<unsigned>(tableSize), indexedLookup.count() / kIterations, linearLookup.count() / kIterations,
+                        eviction.count() / kEvictions);
+
+        mSessionTable->ForEachSession([](SecureSession * session) {
+            session->MarkForEviction();
+            return Loop::Continue;
+        });
+    }
+}
+
+TEST_F(TestSecureSessionTable, ValidatePeerIndex)
+{
+    ValidatePeerIndex();
+}
+
+TEST_F(TestSecureSessionTable, BenchmarkScaling)
+{
+    BenchmarkScaling();
+}
+
 TEST_F(TestSecureSessionTable, ValidateSessionSorting)
 {
     // This calls TestSecureSessionTable::ValidateSessionSorting instead of just doing the
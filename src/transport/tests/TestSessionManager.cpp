@@ -1014,4 +1014,83 @@ TEST_F(TestSessionManager, TestFindSecureSessionForNode)
     sessionManager.Shutdown();
 }
 
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_COPY_STATS
+TEST_F(TestSessionManager, ReceivePathIsCopyFree)
+{
+    TestSessMgrCallback callback;
+
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+
+    FabricTableHolder fabricTableHolder;
+    SessionManager sessionManager;
+    secure_channel::MessageCounterManager gMessageCounterManager;
+    chip::TestPersistentStorageDelegate deviceStorage;
+    chip::Crypto::DefaultSessionKeystore sessionKeystore;
+    FabricTable & fabricTable    = fabricTableHolder.GetFabricTable();
+    FabricIndex aliceFabricIndex = kUndefinedFabricIndex;
+    FabricIndex bobFabricIndex   = kUndefinedFabricIndex;
+
+    EXPECT_EQ(CHIP_NO_ERROR, fabricTableHolder.Init());
+    EXPECT_EQ(CHIP_NO_ERROR,
+              sessionManager.Init(&mContext.GetSystemLayer(), &mContext.GetTransportMgr(), &gMessageCounterManager, &deviceStorage,
+                                  &fabricTableHolder.GetFabricTable(), sessionKeystore));
+
+    sessionManager.SetMessageDelegate(&callback);
+
+    Transport::PeerAddress peer(Transport::PeerAddress::UDP(addr, CHIP_PORT));
+
+    CHIP_ERROR err =
+        fabricTable.AddNewFabricForTestIgnoringCollisions(GetRootACertAsset().mCert, GetIAA1CertAsset().mCert,
+                                                          GetNodeA1CertAsset().mCert, GetNodeA1CertAsset().mKey, &aliceFabricIndex);
+    EXPECT_EQ(CHIP_NO_ERROR, err);
+
+    err = fabricTable.AddNewFabricForTestIgnoringCollisions(GetRootACertAsset().mCert, GetIAA1CertAsset().mCert,
+                                                            GetNodeA2CertAsset().mCert, GetNodeA2CertAsset().mKey, &bobFabricIndex);
+    EXPECT_EQ(CHIP_NO_ERROR, err);
+
+    SessionHolder aliceToBobSession;
+    err = sessionManager.InjectPaseSessionWithTestKey(aliceToBobSession, 2,
+                                                      fabricTable.FindFabricWithIndex(bobFabricIndex)->GetNodeId(), 1,
+                                                      aliceFabricIndex, peer, CryptoContext::SessionRole::kInitiator);
+    EXPECT_EQ(err, CHIP_NO_ERROR);
+
+    SessionHolder bobToAliceSession;
+    err = sessionManager.InjectPaseSessionWithTestKey(bobToAliceSession, 1,
+                                                      fabricTable.FindFabricWithIndex(aliceFabricIndex)->GetNodeId(), 2,
+                                                      bobFabricIndex, peer, CryptoContext::SessionRole::kResponder);
+    EXPECT_EQ(err, CHIP_NO_ERROR);
+
+    PayloadHeader payloadHeader;
+    payloadHeader.SetExchangeID(0);
+    payloadHeader.SetMessageType(chip::Protocols::Echo::MsgType::EchoRequest);
+
+    sessionManager.ResetReceiveStats();
+    for (uint32_t i = 1; i <= 3; i++)
+    {
+        chip::System::PacketBufferHandle buffer = chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+        ASSERT_FALSE(buffer.IsNull());
+
+        EncryptedPacketBufferHandle preparedMessage;
+        err = sessionManager.PrepareMessage(aliceToBobSession.Get().Value(), payloadHeader, std::move(buffer), preparedMessage);
+        EXPECT_EQ(err, CHIP_NO_ERROR);
+        err = sessionManager.SendPreparedMessage(aliceToBobSession.Get().Value(), preparedMessage);
+        EXPECT_EQ(err, CHIP_NO_ERROR);
+
+        mContext.DrainAndServiceIO();
+        EXPECT_EQ(callback.ReceiveHandlerCallCount, static_cast<int>(i));
+
+        // The message is decrypted in place and handed to the delegate in the buffer it was received in.
+        const SessionManager::ReceiveStats & stats = sessionManager.GetReceiveStats();
+        EXPECT_EQ(stats.mMessageCount, i);
+        EXPECT_EQ(stats.mLastMessage.mAllocations, 0u);
+        EXPECT_EQ(stats.mLastMessage.mCopies, 0u);
+        EXPECT_EQ(stats.mLastMessage.mBytesCopied, 0u);
+    }
+    EXPECT_EQ(sessionManager.GetReceiveStats().mTotal.mCopies, 0u);
+
+    sessionManager.Shutdown();
+}
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_COPY_STATS
+
 } // namespace